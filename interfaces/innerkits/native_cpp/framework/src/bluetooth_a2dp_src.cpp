@@ -14,6 +14,8 @@
  */
 
 #include "bluetooth_a2dp_src.h"
+#include <mutex>
+#include "a2dp_pcm_ring.h"
 #include "bluetooth_a2dp_codec.h"
 #include "bluetooth_a2dp_src_proxy.h"
 #include "bluetooth_a2dp_src_observer_stub.h"
@@ -41,6 +43,8 @@ struct A2dpSource::impl {
     sptr<BluetoothA2dpSourceObserverImp> observerImp_ = nullptr;
     class BluetoothA2dpSourceDeathRecipient;
     sptr<BluetoothA2dpSourceDeathRecipient> deathRecipient_ = nullptr;
+    std::mutex pcmRingMutex_ {};
+    std::unique_ptr<A2dpPcmRing> pcmRing_ = nullptr;
 
 private:
     void GetProxy();
@@ -112,6 +116,8 @@ public:
         HILOGI("A2dpSource::impl::BluetoothA2dpSourceDeathRecipient::OnRemoteDied starts");
         a2dpSrcDeath_.proxy_->AsObject()->RemoveDeathRecipient(a2dpSrcDeath_.deathRecipient_);
         a2dpSrcDeath_.proxy_ = nullptr;
+        std::lock_guard<std::mutex> lock(a2dpSrcDeath_.pcmRingMutex_);
+        a2dpSrcDeath_.pcmRing_ = nullptr;
     }
 
 private:
@@ -589,6 +595,14 @@ void A2dpSource::SetAudioConfigure(
 
 int A2dpSource::WriteFrame(const uint8_t *data, uint32_t size)
 {
+    {
+        std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+        if (pimpl->pcmRing_ != nullptr && !pimpl->pcmRing_->IsClosed()) {
+            return pimpl->pcmRing_->Write(data, size) ? RET_NO_ERROR : RET_BAD_STATUS;
+        }
+        // the service closed the ring with the stream, go back to sending pcm to it
+        pimpl->pcmRing_ = nullptr;
+    }
     HILOGI("[A2dpSource] %{public}s\n", __func__);
     if (pimpl->proxy_ != nullptr && IS_BT_ENABLED()) {
         return pimpl->proxy_->WriteFrame(data, size);
@@ -611,5 +625,54 @@ void A2dpSource::GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize,
     return;
 }
 
+int A2dpSource::OpenPcmRing(uint32_t size)
+{
+    HILOGI("[A2dpSource] %{public}s size: %{public}u\n", __func__, size);
+    if (pimpl->proxy_ == nullptr || pimpl->observerImp_ == nullptr || !IS_BT_ENABLED()) {
+        HILOGI("[A2dpSource] proxy or bt disable.");
+        return RET_BAD_STATUS;
+    }
+    int fd = pimpl->proxy_->OpenPcmRing(pimpl->observerImp_, size);
+    if (fd < 0) {
+        HILOGE("[A2dpSource] %{public}s open failed: %{public}d\n", __func__, fd);
+        return fd;
+    }
+    std::unique_ptr<A2dpPcmRing> ring = A2dpPcmRing::Attach(fd);
+    if (ring == nullptr) {
+        HILOGE("[A2dpSource] %{public}s attach failed\n", __func__);
+        pimpl->proxy_->ClosePcmRing();
+        return RET_BAD_STATUS;
+    }
+    std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+    pimpl->pcmRing_ = std::move(ring);
+    return RET_NO_ERROR;
+}
+
+void A2dpSource::ClosePcmRing()
+{
+    HILOGI("[A2dpSource] %{public}s\n", __func__);
+    {
+        std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+        pimpl->pcmRing_ = nullptr;
+    }
+    if (pimpl->proxy_ != nullptr && IS_BT_ENABLED()) {
+        pimpl->proxy_->ClosePcmRing();
+    }
+}
+
+int A2dpSource::GetPcmRingStatus(A2dpPcmRingStatus &status)
+{
+    std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+    if (pimpl->pcmRing_ == nullptr) {
+        return RET_BAD_STATUS;
+    }
+    status.capacity = pimpl->pcmRing_->GetCapacity();
+    status.readPosition = pimpl->pcmRing_->GetReadPosition();
+    status.writePosition = pimpl->pcmRing_->GetWritePosition();
+    status.underrunCount = pimpl->pcmRing_->GetUnderrunCount();
+    status.overrunCount = pimpl->pcmRing_->GetOverrunCount();
+    return RET_NO_ERROR;
+}
+
 }  // namespace Bluetooth
 }  // namespace OHOS
\ No newline at end of file
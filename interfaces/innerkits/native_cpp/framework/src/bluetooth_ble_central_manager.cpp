@@ -194,6 +194,35 @@ void BleCentralManager::StartScan(const BleScanSettings &settings)
     }
 }
 
+void BleCentralManager::ConfigScanFilter(const std::vector<BleScanFilter> &filters)
+{
+    if (pimpl->proxy_ != nullptr) {
+        std::vector<BluetoothBleScanFilter> bleScanFilters;
+        for (auto &filter : filters) {
+            BluetoothBleScanFilter scanFilter;
+            scanFilter.SetDeviceId(filter.GetDeviceId());
+            scanFilter.SetName(filter.GetName());
+            if (filter.HasServiceUuid()) {
+                scanFilter.SetServiceUuid(bluetooth::Uuid::ConvertFromString(filter.GetServiceUuid().ToString()));
+            }
+            if (filter.HasServiceUuidMask()) {
+                scanFilter.SetServiceUuidMask(
+                    bluetooth::Uuid::ConvertFromString(filter.GetServiceUuidMask().ToString()));
+            }
+            scanFilter.SetServiceData(filter.GetServiceData());
+            scanFilter.SetServiceDataMask(filter.GetServiceDataMask());
+            if (filter.HasManufacturerId()) {
+                scanFilter.SetManufacturerId(filter.GetManufacturerId());
+            }
+            scanFilter.SetManufactureData(filter.GetManufactureData());
+            scanFilter.SetManufactureDataMask(filter.GetManufactureDataMask());
+            scanFilter.SetRssiThreshold(filter.GetRssiThreshold());
+            bleScanFilters.push_back(scanFilter);
+        }
+        pimpl->proxy_->ConfigScanFilter(bleScanFilters);
+    }
+}
+
 void BleCentralManager::StopScan()
 {
     if (pimpl->proxy_ != nullptr) {
@@ -337,5 +366,129 @@ int BleScanSettings::GetPhy() const
 {
     return phy_;
 }
+
+BleScanFilter::BleScanFilter()
+{}
+
+BleScanFilter::~BleScanFilter()
+{}
+
+void BleScanFilter::SetDeviceId(const std::string &deviceId)
+{
+    deviceId_ = deviceId;
+}
+
+std::string BleScanFilter::GetDeviceId() const
+{
+    return deviceId_;
+}
+
+void BleScanFilter::SetName(const std::string &name)
+{
+    name_ = name;
+}
+
+std::string BleScanFilter::GetName() const
+{
+    return name_;
+}
+
+void BleScanFilter::SetServiceUuid(const UUID &serviceUuid)
+{
+    serviceUuid_ = serviceUuid;
+    hasServiceUuid_ = true;
+}
+
+bool BleScanFilter::HasServiceUuid() const
+{
+    return hasServiceUuid_;
+}
+
+UUID BleScanFilter::GetServiceUuid() const
+{
+    return serviceUuid_;
+}
+
+void BleScanFilter::SetServiceUuidMask(const UUID &serviceUuidMask)
+{
+    serviceUuidMask_ = serviceUuidMask;
+    hasServiceUuidMask_ = true;
+}
+
+bool BleScanFilter::HasServiceUuidMask() const
+{
+    return hasServiceUuidMask_;
+}
+
+UUID BleScanFilter::GetServiceUuidMask() const
+{
+    return serviceUuidMask_;
+}
+
+void BleScanFilter::SetServiceData(const std::vector<uint8_t> &serviceData)
+{
+    serviceData_ = serviceData;
+}
+
+std::vector<uint8_t> BleScanFilter::GetServiceData() const
+{
+    return serviceData_;
+}
+
+void BleScanFilter::SetServiceDataMask(const std::vector<uint8_t> &serviceDataMask)
+{
+    serviceDataMask_ = serviceDataMask;
+}
+
+std::vector<uint8_t> BleScanFilter::GetServiceDataMask() const
+{
+    return serviceDataMask_;
+}
+
+void BleScanFilter::SetManufacturerId(uint16_t manufacturerId)
+{
+    manufacturerId_ = manufacturerId;
+    hasManufacturerId_ = true;
+}
+
+bool BleScanFilter::HasManufacturerId() const
+{
+    return hasManufacturerId_;
+}
+
+uint16_t BleScanFilter::GetManufacturerId() const
+{
+    return manufacturerId_;
+}
+
+void BleScanFilter::SetManufactureData(const std::vector<uint8_t> &manufactureData)
+{
+    manufactureData_ = manufactureData;
+}
+
+std::vector<uint8_t> BleScanFilter::GetManufactureData() const
+{
+    return manufactureData_;
+}
+
+void BleScanFilter::SetManufactureDataMask(const std::vector<uint8_t> &manufactureDataMask)
+{
+    manufactureDataMask_ = manufactureDataMask;
+}
+
+std::vector<uint8_t> BleScanFilter::GetManufactureDataMask() const
+{
+    return manufactureDataMask_;
+}
+
+void BleScanFilter::SetRssiThreshold(int8_t rssiThreshold)
+{
+    rssiThreshold_ = rssiThreshold;
+}
+
+int8_t BleScanFilter::GetRssiThreshold() const
+{
+    return rssiThreshold_;
+}
 }  // namespace Bluetooth
 }  // namespace OHOS
@@ -80,6 +80,28 @@ public:
     {}
 };
 
+/**
+ * @brief Cursors and error counters of the shared memory pcm ring
+ *
+ * @since 6.0
+ */
+struct A2dpPcmRingStatus {
+    // Ring capacity in bytes
+    uint32_t capacity;
+
+    // Total bytes consumed by the codec, wraps at 2^32
+    uint32_t readPosition;
+
+    // Total bytes written by the application, wraps at 2^32
+    uint32_t writePosition;
+
+    // Codec ticks that found less pcm than one tick needs
+    uint32_t underrunCount;
+
+    // WriteFrame calls rejected because the ring was full
+    uint32_t overrunCount;
+};
+
 /**
  * @brief A2dp source API.
  *
@@ -293,6 +315,34 @@ public:
     
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp);
 
+    /**
+     * @brief Share a pcm ring with the service for the current stream. Once it is open WriteFrame
+     *        only copies pcm into the ring, the codec pulls it from there on its own tick.
+     *
+     * @param size Ring capacity in bytes, rounded up to a power of two between 4 KiB and 1 MiB.
+     * @return Returns <b>RET_NO_ERROR</b> if the ring is open;
+     *         Returns an error code if the service could not set it up.
+     * @since 6.0
+     */
+    int OpenPcmRing(uint32_t size);
+
+    /**
+     * @brief Stop sharing the pcm ring, WriteFrame goes back to sending pcm to the service.
+     *
+     * @since 6.0
+     */
+    void ClosePcmRing();
+
+    /**
+     * @brief Get the cursors and counters of the pcm ring.
+     *
+     * @param status The ring status.
+     * @return Returns <b>RET_NO_ERROR</b> if a ring is open;
+     *         Returns <b>RET_BAD_STATUS</b> if not.
+     * @since 6.0
+     */
+    int GetPcmRingStatus(A2dpPcmRingStatus &status);
+
 private:
     /**
      * @brief A constructor used to create a a2dp source instance.
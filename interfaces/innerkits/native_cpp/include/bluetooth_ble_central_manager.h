@@ -264,6 +264,8 @@ public:
 
     /**
      * @brief Set repport delay time.
+     * If the delay is not 0, the latest result of every device seen in the delay is reported in one batch
+     * at the end of the delay, until the scan stops.
      *
      * @param reportDelayMillis Repport delay time.
      * @since 6
@@ -335,6 +337,225 @@ private:
     int phy_ = PHY_LE_ALL_SUPPORTED;
 };
 
+/**
+ * @brief Represents scan filter. The stack only reports advertisers that meet every field set.
+ *
+ * @since 6
+ */
+class BLUETOOTH_API BleScanFilter {
+public:
+    /**
+     * @brief A constructor used to create a <b>BleScanFilter</b> instance.
+     *
+     * @since 6
+     */
+    BleScanFilter();
+
+    /**
+     * @brief A destructor used to delete the <b>BleScanFilter</b> instance.
+     *
+     * @since 6
+     */
+    ~BleScanFilter();
+
+    /**
+     * @brief Set device address, "XX:XX:XX:XX:XX:XX".
+     *
+     * @param deviceId Device address.
+     * @since 6
+     */
+    void SetDeviceId(const std::string &deviceId);
+
+    /**
+     * @brief Get device address.
+     *
+     * @return Device address.
+     * @since 6
+     */
+    std::string GetDeviceId() const;
+
+    /**
+     * @brief Set name, matched as a prefix of the advertised local name.
+     *
+     * @param name Name.
+     * @since 6
+     */
+    void SetName(const std::string &name);
+
+    /**
+     * @brief Get name.
+     *
+     * @return Name.
+     * @since 6
+     */
+    std::string GetName() const;
+
+    /**
+     * @brief Set service uuid.
+     *
+     * @param serviceUuid Service uuid.
+     * @since 6
+     */
+    void SetServiceUuid(const UUID &serviceUuid);
+
+    /**
+     * @brief Whether the service uuid is set.
+     *
+     * @since 6
+     */
+    bool HasServiceUuid() const;
+
+    /**
+     * @brief Get service uuid.
+     *
+     * @return Service uuid.
+     * @since 6
+     */
+    UUID GetServiceUuid() const;
+
+    /**
+     * @brief Set service uuid mask, a cleared bit matches any value.
+     *
+     * @param serviceUuidMask Service uuid mask.
+     * @since 6
+     */
+    void SetServiceUuidMask(const UUID &serviceUuidMask);
+
+    /**
+     * @brief Whether the service uuid mask is set.
+     *
+     * @since 6
+     */
+    bool HasServiceUuidMask() const;
+
+    /**
+     * @brief Get service uuid mask.
+     *
+     * @return Service uuid mask.
+     * @since 6
+     */
+    UUID GetServiceUuidMask() const;
+
+    /**
+     * @brief Set service data, matched as a prefix of an advertised service data field
+     *        (little endian uuid followed by the data).
+     *
+     * @param serviceData Service data.
+     * @since 6
+     */
+    void SetServiceData(const std::vector<uint8_t> &serviceData);
+
+    /**
+     * @brief Get service data.
+     *
+     * @return Service data.
+     * @since 6
+     */
+    std::vector<uint8_t> GetServiceData() const;
+
+    /**
+     * @brief Set service data mask, a cleared bit matches any value.
+     *
+     * @param serviceDataMask Service data mask.
+     * @since 6
+     */
+    void SetServiceDataMask(const std::vector<uint8_t> &serviceDataMask);
+
+    /**
+     * @brief Get service data mask.
+     *
+     * @return Service data mask.
+     * @since 6
+     */
+    std::vector<uint8_t> GetServiceDataMask() const;
+
+    /**
+     * @brief Set manufacturer id.
+     *
+     * @param manufacturerId Manufacturer id.
+     * @since 6
+     */
+    void SetManufacturerId(uint16_t manufacturerId);
+
+    /**
+     * @brief Whether the manufacturer id is set.
+     *
+     * @since 6
+     */
+    bool HasManufacturerId() const;
+
+    /**
+     * @brief Get manufacturer id.
+     *
+     * @return Manufacturer id.
+     * @since 6
+     */
+    uint16_t GetManufacturerId() const;
+
+    /**
+     * @brief Set manufacture data, matched as a prefix of the data following the manufacturer id.
+     *
+     * @param manufactureData Manufacture data.
+     * @since 6
+     */
+    void SetManufactureData(const std::vector<uint8_t> &manufactureData);
+
+    /**
+     * @brief Get manufacture data.
+     *
+     * @return Manufacture data.
+     * @since 6
+     */
+    std::vector<uint8_t> GetManufactureData() const;
+
+    /**
+     * @brief Set manufacture data mask, a cleared bit matches any value.
+     *
+     * @param manufactureDataMask Manufacture data mask.
+     * @since 6
+     */
+    void SetManufactureDataMask(const std::vector<uint8_t> &manufactureDataMask);
+
+    /**
+     * @brief Get manufacture data mask.
+     *
+     * @return Manufacture data mask.
+     * @since 6
+     */
+    std::vector<uint8_t> GetManufactureDataMask() const;
+
+    /**
+     * @brief Set rssi threshold, weaker reports are dropped.
+     *
+     * @param rssiThreshold Rssi threshold in dBm.
+     * @since 6
+     */
+    void SetRssiThreshold(int8_t rssiThreshold);
+
+    /**
+     * @brief Get rssi threshold.
+     *
+     * @return Rssi threshold.
+     * @since 6
+     */
+    int8_t GetRssiThreshold() const;
+
+private:
+    std::string deviceId_ {};
+    std::string name_ {};
+    UUID serviceUuid_ {};
+    UUID serviceUuidMask_ {};
+    bool hasServiceUuid_ = false;
+    bool hasServiceUuidMask_ = false;
+    std::vector<uint8_t> serviceData_ {};
+    std::vector<uint8_t> serviceDataMask_ {};
+    uint16_t manufacturerId_ = 0;
+    bool hasManufacturerId_ = false;
+    std::vector<uint8_t> manufactureData_ {};
+    std::vector<uint8_t> manufactureDataMask_ {};
+    int8_t rssiThreshold_ = INT8_MIN;
+};
+
 /**
  * @brief Represents central manager.
  *
@@ -372,6 +593,14 @@ public:
      */
     void StartScan(const BleScanSettings &settings);
 
+    /**
+     * @brief Config scan filters, applied in the stack to the next and the running scan.
+     *
+     * @param filters Scan filters, empty to report every advertiser.
+     * @since 6
+     */
+    void ConfigScanFilter(const std::vector<BleScanFilter> &filters);
+
     /**
      * @brief Stop scan.
      *
@@ -344,7 +344,7 @@ static napi_value ParseScanParameters(
     return NapiGetNull(env);
 }
 
-static napi_value ParseScanFilterParameters(const napi_env &env, napi_value &args)
+static napi_value ParseScanFilterParameters(const napi_env &env, napi_value &args, std::vector<BleScanFilter> &filters)
 {
     if (args == nullptr) {
         return NapiGetNull(env);
@@ -363,12 +363,14 @@ static napi_value ParseScanFilterParameters(const napi_env &env, napi_value &arg
             NAPI_CALL(env, napi_typeof(env, scanFilter, &valuetype));
             NAPI_ASSERT(env, valuetype == napi_object, "Wrong argument type. Object expected.");
             bool hasProperty = false;
+            BleScanFilter filter;
             NAPI_CALL(env, napi_has_named_property(env, scanFilter, "deviceId", &hasProperty));
             if (hasProperty) {
                 napi_get_named_property(env, scanFilter, "deviceId", &result);
                 std::string deviceId;
                 ParseString(env, deviceId, result);
                 HILOGD("ParseScanFilterParameters::deviceId = %{public}s", deviceId.c_str());
+                filter.SetDeviceId(deviceId);
             }
 
             NAPI_CALL(env, napi_has_named_property(env, scanFilter, "name", &hasProperty));
@@ -377,6 +379,7 @@ static napi_value ParseScanFilterParameters(const napi_env &env, napi_value &arg
                 std::string name;
                 ParseString(env, name, result);
                 HILOGD("ParseScanFilterParameters::name = %{public}s", name.c_str());
+                filter.SetName(name);
             }
 
             NAPI_CALL(env, napi_has_named_property(env, scanFilter, "serviceUuid", &hasProperty));
@@ -385,7 +388,9 @@ static napi_value ParseScanFilterParameters(const napi_env &env, napi_value &arg
                 std::string serviceUuid;
                 ParseString(env, serviceUuid, result);
                 HILOGD("ParseScanFilterParameters::serviceUuid = %{public}s", serviceUuid.c_str());
+                filter.SetServiceUuid(UUID::FromString(serviceUuid));
             }
+            filters.push_back(filter);
         }
     }
     return NapiGetNull(env);
@@ -402,7 +407,9 @@ napi_value StartBLEScan(napi_env env, napi_callback_info info)
         return NapiGetNull(env);
     }
 
-    ParseScanFilterParameters(env, argv[PARAM0]);
+    std::vector<BleScanFilter> filters;
+    ParseScanFilterParameters(env, argv[PARAM0], filters);
+    bleCentralManager->ConfigScanFilter(filters);
 
     BleScanSettings settinngs;
     if (argv[PARAM1] != nullptr) {
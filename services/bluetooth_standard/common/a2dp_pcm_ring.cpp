@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "a2dp_pcm_ring.h"
+#include <atomic>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "securec.h"
+
+namespace bluetooth {
+namespace {
+const uint32_t RING_MAGIC = 0x50434d52;  // "PCMR"
+const size_t CACHE_LINE_SIZE = 64;
+}  // namespace
+
+// Shared between the two processes; the positions live on separate cache lines so producer and
+// consumer do not bounce each other's line.
+struct A2dpPcmRing::Header {
+    uint32_t magic;
+    uint32_t capacity;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> writePos;
+    std::atomic<uint32_t> overruns;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> readPos;
+    std::atomic<uint32_t> underruns;
+    std::atomic<uint32_t> closed;
+};
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "pcm ring needs address free atomics");
+
+A2dpPcmRing::A2dpPcmRing(int fd, void *map, size_t mapSize, uint32_t capacity)
+    : fd_(fd),
+      map_(map),
+      mapSize_(mapSize),
+      capacity_(capacity),
+      header_(static_cast<Header *>(map)),
+      data_(static_cast<uint8_t *>(map) + sizeof(Header))
+{}
+
+A2dpPcmRing::~A2dpPcmRing()
+{
+    munmap(map_, mapSize_);
+    close(fd_);
+}
+
+std::unique_ptr<A2dpPcmRing> A2dpPcmRing::Create(uint32_t size)
+{
+    uint32_t capacity = MIN_SIZE;
+    while (capacity < size && capacity < MAX_SIZE) {
+        capacity <<= 1;
+    }
+
+    int fd = memfd_create("a2dp_pcm_ring", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        return nullptr;
+    }
+    size_t mapSize = sizeof(Header) + capacity;
+    if (ftruncate(fd, mapSize) != 0 || fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        close(fd);
+        return nullptr;
+    }
+    void *map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    Header *header = new (map) Header();
+    header->magic = RING_MAGIC;
+    header->capacity = capacity;
+    header->writePos.store(0, std::memory_order_relaxed);
+    header->overruns.store(0, std::memory_order_relaxed);
+    header->readPos.store(0, std::memory_order_relaxed);
+    header->underruns.store(0, std::memory_order_relaxed);
+    header->closed.store(0, std::memory_order_relaxed);
+    return std::unique_ptr<A2dpPcmRing>(new A2dpPcmRing(fd, map, mapSize, capacity));
+}
+
+std::unique_ptr<A2dpPcmRing> A2dpPcmRing::Attach(int fd)
+{
+    struct stat st = {};
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header) + MIN_SIZE) ||
+        st.st_size > static_cast<off_t>(sizeof(Header) + MAX_SIZE)) {
+        close(fd);
+        return nullptr;
+    }
+    size_t mapSize = static_cast<size_t>(st.st_size);
+    void *map = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return nullptr;
+    }
+
+    // The capacity is taken from the header once and checked against the mapping, later accesses
+    // never trust the shared copy again.
+    const Header *header = static_cast<const Header *>(map);
+    uint32_t capacity = header->capacity;
+    if (header->magic != RING_MAGIC || (capacity & (capacity - 1)) != 0 ||
+        sizeof(Header) + capacity != mapSize) {
+        munmap(map, mapSize);
+        close(fd);
+        return nullptr;
+    }
+    return std::unique_ptr<A2dpPcmRing>(new A2dpPcmRing(fd, map, mapSize, capacity));
+}
+
+void A2dpPcmRing::Close()
+{
+    header_->closed.store(1, std::memory_order_release);
+}
+
+bool A2dpPcmRing::IsClosed() const
+{
+    return header_->closed.load(std::memory_order_acquire) != 0;
+}
+
+bool A2dpPcmRing::Write(const uint8_t *data, uint32_t size)
+{
+    if (IsClosed()) {
+        return false;
+    }
+    uint32_t writePos = header_->writePos.load(std::memory_order_relaxed);
+    uint32_t used = writePos - header_->readPos.load(std::memory_order_acquire);
+    if (used > capacity_ || size > capacity_ - used) {
+        header_->overruns.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t offset = writePos & (capacity_ - 1);
+    uint32_t first = (size < capacity_ - offset) ? size : (capacity_ - offset);
+    (void)memcpy_s(data_ + offset, capacity_ - offset, data, first);
+    if (first < size) {
+        (void)memcpy_s(data_, capacity_, data + first, size - first);
+    }
+    header_->writePos.store(writePos + size, std::memory_order_release);
+    return true;
+}
+
+uint32_t A2dpPcmRing::Read(uint8_t *buf, uint32_t size)
+{
+    uint32_t readPos = header_->readPos.load(std::memory_order_relaxed);
+    uint32_t readable = header_->writePos.load(std::memory_order_acquire) - readPos;
+    if (readable > capacity_) {
+        readable = capacity_;
+    }
+    if (readable < size) {
+        header_->underruns.fetch_add(1, std::memory_order_relaxed);
+        size = readable;
+    }
+
+    uint32_t offset = readPos & (capacity_ - 1);
+    uint32_t first = (size < capacity_ - offset) ? size : (capacity_ - offset);
+    (void)memcpy_s(buf, size, data_ + offset, first);
+    if (first < size) {
+        (void)memcpy_s(buf + first, size - first, data_, size - first);
+    }
+    header_->readPos.store(readPos + size, std::memory_order_release);
+    return size;
+}
+
+uint32_t A2dpPcmRing::GetReadable() const
+{
+    uint32_t readable =
+        header_->writePos.load(std::memory_order_acquire) - header_->readPos.load(std::memory_order_relaxed);
+    return (readable > capacity_) ? capacity_ : readable;
+}
+
+uint32_t A2dpPcmRing::GetReadPosition() const
+{
+    return header_->readPos.load(std::memory_order_acquire);
+}
+
+uint32_t A2dpPcmRing::GetWritePosition() const
+{
+    return header_->writePos.load(std::memory_order_acquire);
+}
+
+uint32_t A2dpPcmRing::GetUnderrunCount() const
+{
+    return header_->underruns.load(std::memory_order_relaxed);
+}
+
+uint32_t A2dpPcmRing::GetOverrunCount() const
+{
+    return header_->overruns.load(std::memory_order_relaxed);
+}
+}  // namespace bluetooth
\ No newline at end of file
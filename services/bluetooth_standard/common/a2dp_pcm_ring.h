@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef A2DP_PCM_RING_H
+#define A2DP_PCM_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace bluetooth {
+/**
+ * @brief Single producer / single consumer pcm ring living in a sealed memfd.
+ *
+ * The a2dp source service creates the ring and hands its fd to the application once per stream.
+ * The application is the only writer, the codec thread the only reader. Read and write positions
+ * are free running byte counters, so the ring needs no lock and no pcm crosses binder.
+ *
+ * @since 6
+ */
+class A2dpPcmRing {
+public:
+    const static uint32_t MIN_SIZE = 4096;
+    const static uint32_t MAX_SIZE = 1024 * 1024;
+
+    /**
+     * @brief Create a new ring backed by a memfd.
+     *
+     * @param size Data capacity in bytes, rounded up to a power of two in [MIN_SIZE, MAX_SIZE].
+     * @return Returns the ring, or nullptr if the shared memory can not be set up.
+     * @since 6
+     */
+    static std::unique_ptr<A2dpPcmRing> Create(uint32_t size);
+
+    /**
+     * @brief Map a ring created by the peer process.
+     *
+     * @param fd Ring fd; ownership moves to the ring, it is closed on failure too.
+     * @return Returns the ring, or nullptr if fd is not a valid ring.
+     * @since 6
+     */
+    static std::unique_ptr<A2dpPcmRing> Attach(int fd);
+
+    /**
+     * @brief Destroy the ring, unmap it and close its fd.
+     *
+     * @since 6
+     */
+    ~A2dpPcmRing();
+
+    /**
+     * @brief Get the fd to pass to the peer process.
+     *
+     * @since 6
+     */
+    int GetFd() const
+    {
+        return fd_;
+    }
+
+    /**
+     * @brief Get the data capacity in bytes.
+     *
+     * @since 6
+     */
+    uint32_t GetCapacity() const
+    {
+        return capacity_;
+    }
+
+    /**
+     * @brief Consumer side: tell the producer the ring is no longer read, later writes fail.
+     *
+     * @since 6
+     */
+    void Close();
+
+    /**
+     * @brief Whether the consumer has closed the ring.
+     *
+     * @since 6
+     */
+    bool IsClosed() const;
+
+    /**
+     * @brief Producer side: append all of data or nothing.
+     *
+     * @param data Pcm data.
+     * @param size Pcm size in bytes.
+     * @return Returns false when the ring is closed, or counts an overrun when the free space is less than size.
+     * @since 6
+     */
+    bool Write(const uint8_t *data, uint32_t size);
+
+    /**
+     * @brief Consumer side: take up to size bytes.
+     *
+     * @param buf Destination buffer.
+     * @param size Bytes wanted.
+     * @return Returns the bytes read; a short read counts an underrun.
+     * @since 6
+     */
+    uint32_t Read(uint8_t *buf, uint32_t size);
+
+    /**
+     * @brief Bytes that can be read right now.
+     *
+     * @since 6
+     */
+    uint32_t GetReadable() const;
+
+    /**
+     * @brief Total bytes consumed since the ring was created.
+     *
+     * @since 6
+     */
+    uint32_t GetReadPosition() const;
+
+    /**
+     * @brief Total bytes produced since the ring was created.
+     *
+     * @since 6
+     */
+    uint32_t GetWritePosition() const;
+
+    /**
+     * @brief Number of reads that found less pcm than wanted.
+     *
+     * @since 6
+     */
+    uint32_t GetUnderrunCount() const;
+
+    /**
+     * @brief Number of writes rejected because the ring was full.
+     *
+     * @since 6
+     */
+    uint32_t GetOverrunCount() const;
+
+private:
+    struct Header;
+    A2dpPcmRing(int fd, void *map, size_t mapSize, uint32_t capacity);
+
+    int fd_ {-1};
+    void *map_ {nullptr};
+    size_t mapSize_ {0};
+    uint32_t capacity_ {0};
+    Header *header_ {nullptr};
+    uint8_t *data_ {nullptr};
+};
+}  // namespace bluetooth
+
+#endif  // A2DP_PCM_RING_H
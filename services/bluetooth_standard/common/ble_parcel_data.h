@@ -35,6 +35,7 @@
 #define BLE_PARCEL_DATA_H
 
 #include <map>
+#include <string>
 #include <vector>
 
 #include "bt_uuid.h"
@@ -643,6 +644,296 @@ public:
     bool legacy_ = true;
     int phy_ = 255;
 };
+
+/**
+ * @brief Represents scan filter.
+ *
+ * @since 6
+ */
+class ScanFilter {
+public:
+    /**
+     * @brief A constructor used to create a <b>ScanFilter</b> instance.
+     *
+     * @since 6
+     */
+    ScanFilter(){};
+
+    /**
+     * @brief A destructor used to delete the <b>ScanFilter</b> instance.
+     *
+     * @since 6
+     */
+    ~ScanFilter(){};
+
+    /**
+     * @brief Set device id.
+     *
+     * @param deviceId Device id.
+     * @since 6
+     */
+    void SetDeviceId(const std::string &deviceId)
+    {
+        deviceId_ = deviceId;
+    }
+
+    /**
+     * @brief Get device id.
+     *
+     * @return Device id.
+     * @since 6
+     */
+    std::string GetDeviceId() const
+    {
+        return deviceId_;
+    }
+
+    /**
+     * @brief Set name.
+     *
+     * @param name Name.
+     * @since 6
+     */
+    void SetName(const std::string &name)
+    {
+        name_ = name;
+    }
+
+    /**
+     * @brief Get name.
+     *
+     * @return Name.
+     * @since 6
+     */
+    std::string GetName() const
+    {
+        return name_;
+    }
+
+    /**
+     * @brief Set service uuid.
+     *
+     * @param serviceUuid Service uuid.
+     * @since 6
+     */
+    void SetServiceUuid(const Uuid &serviceUuid)
+    {
+        serviceUuid_ = serviceUuid;
+        hasServiceUuid_ = true;
+    }
+
+    /**
+     * @brief Get service uuid.
+     *
+     * @return Service uuid.
+     * @since 6
+     */
+    Uuid GetServiceUuid() const
+    {
+        return serviceUuid_;
+    }
+
+    /**
+     * @brief Whether service uuid is set.
+     *
+     * @since 6
+     */
+    bool HasServiceUuid() const
+    {
+        return hasServiceUuid_;
+    }
+
+    /**
+     * @brief Set service uuid mask.
+     *
+     * @param serviceUuidMask Service uuid mask.
+     * @since 6
+     */
+    void SetServiceUuidMask(const Uuid &serviceUuidMask)
+    {
+        serviceUuidMask_ = serviceUuidMask;
+        hasServiceUuidMask_ = true;
+    }
+
+    /**
+     * @brief Get service uuid mask.
+     *
+     * @return Service uuid mask.
+     * @since 6
+     */
+    Uuid GetServiceUuidMask() const
+    {
+        return serviceUuidMask_;
+    }
+
+    /**
+     * @brief Whether service uuid mask is set.
+     *
+     * @since 6
+     */
+    bool HasServiceUuidMask() const
+    {
+        return hasServiceUuidMask_;
+    }
+
+    /**
+     * @brief Set service data.
+     *
+     * @param serviceData Service data.
+     * @since 6
+     */
+    void SetServiceData(const std::vector<uint8_t> &serviceData)
+    {
+        serviceData_ = serviceData;
+    }
+
+    /**
+     * @brief Get service data.
+     *
+     * @return Service data.
+     * @since 6
+     */
+    std::vector<uint8_t> GetServiceData() const
+    {
+        return serviceData_;
+    }
+
+    /**
+     * @brief Set service data mask.
+     *
+     * @param serviceDataMask Service data mask.
+     * @since 6
+     */
+    void SetServiceDataMask(const std::vector<uint8_t> &serviceDataMask)
+    {
+        serviceDataMask_ = serviceDataMask;
+    }
+
+    /**
+     * @brief Get service data mask.
+     *
+     * @return Service data mask.
+     * @since 6
+     */
+    std::vector<uint8_t> GetServiceDataMask() const
+    {
+        return serviceDataMask_;
+    }
+
+    /**
+     * @brief Set manufacturer id.
+     *
+     * @param manufacturerId Manufacturer id.
+     * @since 6
+     */
+    void SetManufacturerId(uint16_t manufacturerId)
+    {
+        manufacturerId_ = manufacturerId;
+        hasManufacturerId_ = true;
+    }
+
+    /**
+     * @brief Get manufacturer id.
+     *
+     * @return Manufacturer id.
+     * @since 6
+     */
+    uint16_t GetManufacturerId() const
+    {
+        return manufacturerId_;
+    }
+
+    /**
+     * @brief Whether manufacturer id is set.
+     *
+     * @since 6
+     */
+    bool HasManufacturerId() const
+    {
+        return hasManufacturerId_;
+    }
+
+    /**
+     * @brief Set manufacture data.
+     *
+     * @param manufactureData Manufacture data.
+     * @since 6
+     */
+    void SetManufactureData(const std::vector<uint8_t> &manufactureData)
+    {
+        manufactureData_ = manufactureData;
+    }
+
+    /**
+     * @brief Get manufacture data.
+     *
+     * @return Manufacture data.
+     * @since 6
+     */
+    std::vector<uint8_t> GetManufactureData() const
+    {
+        return manufactureData_;
+    }
+
+    /**
+     * @brief Set manufacture data mask.
+     *
+     * @param manufactureDataMask Manufacture data mask.
+     * @since 6
+     */
+    void SetManufactureDataMask(const std::vector<uint8_t> &manufactureDataMask)
+    {
+        manufactureDataMask_ = manufactureDataMask;
+    }
+
+    /**
+     * @brief Get manufacture data mask.
+     *
+     * @return Manufacture data mask.
+     * @since 6
+     */
+    std::vector<uint8_t> GetManufactureDataMask() const
+    {
+        return manufactureDataMask_;
+    }
+
+    /**
+     * @brief Set rssi threshold.
+     *
+     * @param rssiThreshold Rssi threshold.
+     * @since 6
+     */
+    void SetRssiThreshold(int8_t rssiThreshold)
+    {
+        rssiThreshold_ = rssiThreshold;
+    }
+
+    /**
+     * @brief Get rssi threshold.
+     *
+     * @return Rssi threshold.
+     * @since 6
+     */
+    int8_t GetRssiThreshold() const
+    {
+        return rssiThreshold_;
+    }
+
+public:
+    std::string deviceId_ {};
+    std::string name_ {};
+    Uuid serviceUuid_ {};
+    Uuid serviceUuidMask_ {};
+    bool hasServiceUuid_ = false;
+    bool hasServiceUuidMask_ = false;
+    std::vector<uint8_t> serviceData_ {};
+    std::vector<uint8_t> serviceDataMask_ {};
+    uint16_t manufacturerId_ = 0;
+    bool hasManufacturerId_ = false;
+    std::vector<uint8_t> manufactureData_ {};
+    std::vector<uint8_t> manufactureDataMask_ {};
+    int8_t rssiThreshold_ = INT8_MIN;
+};
 }  // namespace bluetooth
 
 #endif  /// BLE_PARCEL_DATA_H
@@ -70,6 +70,124 @@ int BleScanSettingsImpl::GetPhy() const
     return phy_;
 }
 
+void BleScanFilterImpl::SetDeviceId(const std::string &deviceId)
+{
+    deviceId_ = deviceId;
+}
+
+std::string BleScanFilterImpl::GetDeviceId() const
+{
+    return deviceId_;
+}
+
+void BleScanFilterImpl::SetName(const std::string &name)
+{
+    name_ = name;
+}
+
+std::string BleScanFilterImpl::GetName() const
+{
+    return name_;
+}
+
+void BleScanFilterImpl::SetServiceUuid(const Uuid &uuid)
+{
+    serviceUuid_ = uuid;
+    hasServiceUuid_ = true;
+}
+
+Uuid BleScanFilterImpl::GetServiceUuid() const
+{
+    return serviceUuid_;
+}
+
+bool BleScanFilterImpl::HasServiceUuid() const
+{
+    return hasServiceUuid_;
+}
+
+void BleScanFilterImpl::SetServiceUuidMask(const Uuid &serviceUuidMask)
+{
+    serviceUuidMask_ = serviceUuidMask;
+    hasServiceUuidMask_ = true;
+}
+
+Uuid BleScanFilterImpl::GetServiceUuidMask() const
+{
+    return serviceUuidMask_;
+}
+
+bool BleScanFilterImpl::HasServiceUuidMask() const
+{
+    return hasServiceUuidMask_;
+}
+
+void BleScanFilterImpl::SetServiceData(const std::vector<uint8_t> &serviceData)
+{
+    serviceData_ = serviceData;
+}
+
+std::vector<uint8_t> BleScanFilterImpl::GetServiceData() const
+{
+    return serviceData_;
+}
+
+void BleScanFilterImpl::SetServiceDataMask(const std::vector<uint8_t> &serviceDataMask)
+{
+    serviceDataMask_ = serviceDataMask;
+}
+
+std::vector<uint8_t> BleScanFilterImpl::GetServiceDataMask() const
+{
+    return serviceDataMask_;
+}
+
+void BleScanFilterImpl::SetManufacturerId(uint16_t manufacturerId)
+{
+    manufacturerId_ = manufacturerId;
+    hasManufacturerId_ = true;
+}
+
+uint16_t BleScanFilterImpl::GetManufacturerId() const
+{
+    return manufacturerId_;
+}
+
+bool BleScanFilterImpl::HasManufacturerId() const
+{
+    return hasManufacturerId_;
+}
+
+void BleScanFilterImpl::SetManufactureData(const std::vector<uint8_t> &manufactureData)
+{
+    manufactureData_ = manufactureData;
+}
+
+std::vector<uint8_t> BleScanFilterImpl::GetManufactureData() const
+{
+    return manufactureData_;
+}
+
+void BleScanFilterImpl::SetManufactureDataMask(const std::vector<uint8_t> &manufactureDataMask)
+{
+    manufactureDataMask_ = manufactureDataMask;
+}
+
+std::vector<uint8_t> BleScanFilterImpl::GetManufactureDataMask() const
+{
+    return manufactureDataMask_;
+}
+
+void BleScanFilterImpl::SetRssiThreshold(int8_t rssi)
+{
+    rssiThreshold_ = rssi;
+}
+
+int8_t BleScanFilterImpl::GetRssiThreshold() const
+{
+    return rssiThreshold_;
+}
+
 /**
  * @brief Check if the device service is connectable.
  *
@@ -554,6 +672,7 @@ RawAddress BlePeripheralDevice::GetRawAddress() const
  */
 uint16_t BlePeripheralDevice::GetAppearance() const
 {
+    ParseIfNeeded();
     return appearance_;
 }
 
@@ -565,6 +684,7 @@ uint16_t BlePeripheralDevice::GetAppearance() const
  */
 std::map<uint16_t, std::string> BlePeripheralDevice::GetManufacturerData() const
 {
+    ParseIfNeeded();
     return manufacturerData_;
 }
 
@@ -576,6 +696,7 @@ std::map<uint16_t, std::string> BlePeripheralDevice::GetManufacturerData() const
  */
 std::string BlePeripheralDevice::GetName() const
 {
+    ParseIfNeeded();
     return name_;
 }
 
@@ -598,6 +719,7 @@ int8_t BlePeripheralDevice::GetRSSI() const
  */
 std::vector<std::string> BlePeripheralDevice::GetServiceData() const
 {
+    ParseIfNeeded();
     return serviceData_;
 }
 
@@ -610,6 +732,7 @@ std::vector<std::string> BlePeripheralDevice::GetServiceData() const
  */
 std::string BlePeripheralDevice::GetServiceData(int index) const
 {
+    ParseIfNeeded();
     return serviceData_.empty() ? "" : ((size_t)index < serviceData_.size() ? serviceData_[index] : "");
 }
 
@@ -621,6 +744,7 @@ std::string BlePeripheralDevice::GetServiceData(int index) const
  */
 std::vector<Uuid> BlePeripheralDevice::GetServiceDataUUID() const
 {
+    ParseIfNeeded();
     return serviceDataUUIDs_;
 }
 
@@ -633,6 +757,7 @@ std::vector<Uuid> BlePeripheralDevice::GetServiceDataUUID() const
  */
 Uuid BlePeripheralDevice::GetServiceDataUUID(int index) const
 {
+    ParseIfNeeded();
     Uuid uuid {};
     return serviceDataUUIDs_.empty() ? uuid : serviceDataUUIDs_[index];
 }
@@ -645,6 +770,7 @@ Uuid BlePeripheralDevice::GetServiceDataUUID(int index) const
  */
 std::vector<Uuid> BlePeripheralDevice::GetServiceUUID() const
 {
+    ParseIfNeeded();
     return serviceUUIDs_;
 }
 
@@ -657,6 +783,7 @@ std::vector<Uuid> BlePeripheralDevice::GetServiceUUID() const
  */
 Uuid BlePeripheralDevice::GetServiceUUID(int index) const
 {
+    ParseIfNeeded();
     Uuid uuid {};
     return serviceUUIDs_.empty() ? uuid : serviceUUIDs_[index];
 }
@@ -692,6 +819,7 @@ void BlePeripheralDevice::SetAddressType(int type)
  */
 bool BlePeripheralDevice::IsManufacturerData() const
 {
+    ParseIfNeeded();
     return isManufacturerData_;
 }
 
@@ -716,6 +844,7 @@ bool BlePeripheralDevice::IsRSSI() const
  */
 bool BlePeripheralDevice::IsServiceData() const
 {
+    ParseIfNeeded();
     return isServiceData_;
 }
 
@@ -728,6 +857,7 @@ bool BlePeripheralDevice::IsServiceData() const
  */
 bool BlePeripheralDevice::IsServiceUUID() const
 {
+    ParseIfNeeded();
     return isServiceUUID_;
 }
 
@@ -774,7 +904,7 @@ void BlePeripheralDevice::SetConnectable(bool connectable)
     connectable_ = connectable;
 }
 /**
- * @brief Parse advertisement packets.
+ * @brief Keep advertisement packets, they are parsed on first access to a field.
  *
  * @param payload Advertisement packet.
  * @param total_len Advertisement packet length.
@@ -782,11 +912,38 @@ void BlePeripheralDevice::SetConnectable(bool connectable)
  */
 void BlePeripheralDevice::ParseAdvertiserment(BlePeripheralDeviceParseAdvData &parseAdvData)
 {
+    ClearAdvertiserData();
+    // assign keeps the buffer of a device updated by every report
+    payload_.assign(parseAdvData.payload, parseAdvData.payload + parseAdvData.length);
+    parsed_ = payload_.empty();
+
+    // the flags decide whether the device is reported at all, they are looked up right away
+    static const size_t flagLength = 2;
+    for (size_t offset = 0; offset < payload_.size(); offset += payload_[offset] + 1) {
+        if (offset + flagLength < payload_.size() && payload_[offset] == flagLength &&
+            payload_[offset + 1] == BLE_AD_TYPE_FLAG) {
+            adFlag_ = payload_[offset + flagLength];
+            break;
+        }
+    }
+}
+
+void BlePeripheralDevice::ParseIfNeeded() const
+{
+    if (parsed_) {
+        return;
+    }
+
+    // the fields only cache what payload_ holds, filling them in leaves the device logically unchanged
+    auto *device = const_cast<BlePeripheralDevice *>(this);
+    device->parsed_ = true;
+    BlePeripheralDeviceParseAdvData parseAdvData = {
+        .payload = device->payload_.data(),
+        .length = device->payload_.size(),
+    };
     size_t sizeConsumed = 0;
     bool finished = false;
     size_t totalLength = parseAdvData.length;
-    payload_ = parseAdvData.payload;
-    payloadLen_ = parseAdvData.length;
 
     while (!finished) {
         size_t length = *parseAdvData.payload;
@@ -801,7 +958,7 @@ void BlePeripheralDevice::ParseAdvertiserment(BlePeripheralDeviceParseAdvData &p
             parseAdvData.payload++;
             length--;
             parseAdvData.length = length;
-            BuildAdvertiserData(advType, parseAdvData);
+            device->BuildAdvertiserData(advType, parseAdvData);
             parseAdvData.payload += length;
         }
         if (sizeConsumed >= totalLength) {
@@ -810,6 +967,23 @@ void BlePeripheralDevice::ParseAdvertiserment(BlePeripheralDeviceParseAdvData &p
     }
 }
 
+void BlePeripheralDevice::ClearAdvertiserData()
+{
+    isAppearance_ = false;
+    isManufacturerData_ = false;
+    isName_ = false;
+    isServiceData_ = false;
+    isServiceUUID_ = false;
+    isTXPower_ = false;
+    adFlag_ = 0;
+    appearance_ = 0;
+    manufacturerData_.clear();
+    name_.clear();
+    serviceUUIDs_.clear();
+    serviceData_.clear();
+    serviceDataUUIDs_.clear();
+}
+
 void BlePeripheralDevice::BuildAdvertiserData(uint8_t advType, BlePeripheralDeviceParseAdvData &parseAdvData)
 {
     switch (advType) {
@@ -931,6 +1105,7 @@ void BlePeripheralDevice::SetServiceDataUUID128Bits(BlePeripheralDeviceParseAdvD
  */
 void BlePeripheralDevice::SetName(const std::string &name)
 {
+    ParseIfNeeded();
     name_ = name;
     isName_ = true;
 }
@@ -1165,6 +1340,7 @@ void BlePeripheralDevice::SetAppearance(uint16_t appearance)
  */
 void BlePeripheralDevice::SetManufacturerData(std::string manufacturerData)
 {
+    ParseIfNeeded();
     if (manufacturerData.size() > BLE_UUID_LEN_16) {
         uint16_t manufacturerId = uint8_t(manufacturerData[0]) | (uint16_t(manufacturerData[1]) << BLE_ONE_BYTE_LEN);
         auto iter = manufacturerData_.find(manufacturerId);
@@ -1230,6 +1406,17 @@ BlePeripheralDevice BleScanResultImpl::GetPeripheralDevice() const
     return peripheralDevice_;
 }
 
+/**
+ * @brief Get peripheral device to update it in place.
+ *
+ * @return Returns peripheral device reference.
+ * @since 6
+ */
+BlePeripheralDevice &BleScanResultImpl::GetPeripheralDevice()
+{
+    return peripheralDevice_;
+}
+
 /**
  * @brief Set peripheral device.
  *
@@ -1247,9 +1434,9 @@ void BleScanResultImpl::SetPeripheralDevice(const BlePeripheralDevice &dev)
  * @return Returns advertiser data packet.
  * @since 6
  */
-uint8_t *BlePeripheralDevice::GetPayload() const
+const uint8_t *BlePeripheralDevice::GetPayload() const
 {
-    return payload_;
+    return payload_.data();
 }
 
 /**
@@ -1260,6 +1447,6 @@ uint8_t *BlePeripheralDevice::GetPayload() const
  */
 size_t BlePeripheralDevice::GetPayloadLen() const
 {
-    return payloadLen_;
+    return payload_.size();
 }
 }  // namespace bluetooth
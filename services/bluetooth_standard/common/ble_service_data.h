@@ -64,6 +64,8 @@ public:
 
     /**
      * @brief Set report delay time.
+     * If the delay is not 0, the latest result of every device seen in the delay is reported in one batch
+     * at the end of the delay, until the scan stops.
      *
      * @param reportDelayMillis Repport delay time.
      * @since 6
@@ -134,6 +136,93 @@ private:
     int phy_ = PHY_LE_ALL_SUPPORTED;
 };
 
+/**
+ * @brief Represents a scan filter. A report passes when it meets every field that is set.
+ *
+ * @since 6
+ */
+class BleScanFilterImpl {
+public:
+    BleScanFilterImpl(){};
+    ~BleScanFilterImpl(){};
+
+    /**
+     * @brief Only accept reports from this advertiser address ("XX:XX:XX:XX:XX:XX").
+     *
+     * @since 6
+     */
+    void SetDeviceId(const std::string &deviceId);
+    std::string GetDeviceId() const;
+
+    /**
+     * @brief Only accept reports whose local name starts with name.
+     *
+     * @since 6
+     */
+    void SetName(const std::string &name);
+    std::string GetName() const;
+
+    /**
+     * @brief Only accept reports listing this service uuid, compared under the uuid mask if one is set.
+     *
+     * @since 6
+     */
+    void SetServiceUuid(const Uuid &uuid);
+    bool HasServiceUuid() const;
+    Uuid GetServiceUuid() const;
+    void SetServiceUuidMask(const Uuid &serviceUuidMask);
+    bool HasServiceUuidMask() const;
+    Uuid GetServiceUuidMask() const;
+
+    /**
+     * @brief Only accept reports with a service data field starting with serviceData, compared under
+     *        the data mask if one is set. The field is matched as sent: little endian uuid, then data.
+     *
+     * @since 6
+     */
+    void SetServiceData(const std::vector<uint8_t> &serviceData);
+    std::vector<uint8_t> GetServiceData() const;
+    void SetServiceDataMask(const std::vector<uint8_t> &serviceDataMask);
+    std::vector<uint8_t> GetServiceDataMask() const;
+
+    /**
+     * @brief Only accept reports with manufacturer data of this company id, whose data starts with
+     *        manufactureData, compared under the data mask if one is set.
+     *
+     * @since 6
+     */
+    void SetManufacturerId(uint16_t manufacturerId);
+    bool HasManufacturerId() const;
+    uint16_t GetManufacturerId() const;
+    void SetManufactureData(const std::vector<uint8_t> &manufactureData);
+    std::vector<uint8_t> GetManufactureData() const;
+    void SetManufactureDataMask(const std::vector<uint8_t> &manufactureDataMask);
+    std::vector<uint8_t> GetManufactureDataMask() const;
+
+    /**
+     * @brief Only accept reports received at rssi or stronger.
+     *
+     * @since 6
+     */
+    void SetRssiThreshold(int8_t rssi);
+    int8_t GetRssiThreshold() const;
+
+private:
+    std::string deviceId_ {};
+    std::string name_ {};
+    Uuid serviceUuid_ {};
+    Uuid serviceUuidMask_ {};
+    bool hasServiceUuid_ = false;
+    bool hasServiceUuidMask_ = false;
+    std::vector<uint8_t> serviceData_ {};
+    std::vector<uint8_t> serviceDataMask_ {};
+    uint16_t manufacturerId_ = 0;
+    bool hasManufacturerId_ = false;
+    std::vector<uint8_t> manufactureData_ {};
+    std::vector<uint8_t> manufactureDataMask_ {};
+    int8_t rssiThreshold_ = INT8_MIN;
+};
+
 /**
  * @brief Represents advertise settings.
  *
@@ -438,6 +527,9 @@ struct BlePeripheralDeviceParseAdvData {
 /**
  * @brief Represents peripheral device.
  *
+ * The advertising data is kept as received and its fields are parsed on first access, so a device must not be read
+ * from two threads at once.
+ *
  * @since 6
  */
 class BlePeripheralDevice {
@@ -553,7 +645,7 @@ public:
      * @return Returns advertiser data packet.
      * @since 6
      */
-    uint8_t *GetPayload() const;
+    const uint8_t *GetPayload() const;
 
     /**
      * @brief Get advertising packet length.
@@ -645,7 +737,7 @@ public:
     void SetConnectable(bool connectable);
 
     /**
-     * @brief Parse advertisement data.
+     * @brief Keep advertisement data, replacing the fields of the previous one.
      *
      * @param payload Advertisement packet.
      * @param totalLen Advertisement packet total len.
@@ -876,6 +968,20 @@ public:
     void SetManufacturerData(std::string manufacturerData);
 
 private:
+    /**
+     * @brief Parse the kept advertisement data unless it is parsed already.
+     *
+     * @since 6
+     */
+    void ParseIfNeeded() const;
+
+    /**
+     * @brief Clear the fields parsed from advertisement data.
+     *
+     * @since 6
+     */
+    void ClearAdvertiserData();
+
     /**
      * @brief Set advertising flag.
      *
@@ -962,8 +1068,9 @@ private:
     uint8_t ioCapability_ {};
     std::string aliasName_ {};
     bool connectable_ = true;
-    uint8_t* payload_ {};
-    size_t payloadLen_ = 0;
+    /// advertisement data, the fields above are parsed from it on first access
+    std::vector<uint8_t> payload_ {};
+    bool parsed_ = true;
 };
 
 /**
@@ -997,6 +1104,14 @@ public:
      */
     BlePeripheralDevice GetPeripheralDevice() const;
 
+    /**
+     * @brief Get peripheral device to update it in place.
+     *
+     * @return Returns peripheral device reference.
+     * @since 6
+     */
+    BlePeripheralDevice &GetPeripheralDevice();
+
     /**
      * @brief Set peripheral device.
      *
@@ -47,4 +47,7 @@
 #define LOG_ERROR(...) HILOG_ERROR(LOG_CORE, __VA_ARGS__)
 #define LOG_FATAL(...) HILOG_FATAL(LOG_CORE, __VA_ARGS__)
 
+// guards debug logs whose arguments are costly to build
+#define LOG_DEBUG_ENABLED() HiLogIsLoggable(LOG_DOMAIN, LOG_TAG, LOG_DEBUG)
+
 #endif  // LOG_H
\ No newline at end of file
@@ -54,10 +54,13 @@ typedef struct BtHciCallbacks {
 
 int HdiInit(BtHciCallbacks *callbacks);
 int HdiSendHciPacket(BtPacketType type, const BtPacket *packet);
+// Send one hci packet given as consecutive segments, optional for vendor adapters.
+int HdiSendHciPacketV(BtPacketType type, const BtPacket *segments, uint32_t count);
 void HdiClose(void);
 
 typedef int (*HdiInitFunc)(BtHciCallbacks *callbacks);
 typedef int (*HdiSendHciPacketFunc)(BtPacketType type, const BtPacket *packet);
+typedef int (*HdiSendHciPacketVFunc)(BtPacketType type, const BtPacket *segments, uint32_t count);
 typedef void (*HdiCloseFunc)(void);
 
 #ifdef __cplusplus
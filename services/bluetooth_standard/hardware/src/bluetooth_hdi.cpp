@@ -49,14 +49,8 @@ int HdiInit(BtHciCallbacks *callbacks)
     return SUCCESS;
 }
 
-int HdiSendHciPacket(BtPacketType type, const BtPacket *packet)
+static ohos::hardware::bt::v1_0::BtType HdiGetBtType(BtPacketType type)
 {
-    if (packet == nullptr) {
-        return TRANSPORT_ERROR;
-    }
-    if (g_iBtHci == nullptr) {
-        return INITIALIZATION_ERROR;
-    }
     ohos::hardware::bt::v1_0::BtType btType = ohos::hardware::bt::v1_0::BtType::ACL_DATA;
     switch (type) {
         case PACKET_TYPE_CMD:
@@ -71,9 +65,45 @@ int HdiSendHciPacket(BtPacketType type, const BtPacket *packet)
         default:
             break;
     }
+    return btType;
+}
+
+int HdiSendHciPacket(BtPacketType type, const BtPacket *packet)
+{
+    if (packet == nullptr) {
+        return TRANSPORT_ERROR;
+    }
+    if (g_iBtHci == nullptr) {
+        return INITIALIZATION_ERROR;
+    }
     std::vector<uint8_t> data;
     data.assign(packet->data, packet->data + packet->size);
-    int32_t result = g_iBtHci->SendHciPacket(btType, data);
+    int32_t result = g_iBtHci->SendHciPacket(HdiGetBtType(type), data);
+    if (result != ohos::hardware::bt::v1_0::BtStatus::SUCCESS) {
+        return TRANSPORT_ERROR;
+    }
+    return SUCCESS;
+}
+
+int HdiSendHciPacketV(BtPacketType type, const BtPacket *segments, uint32_t count)
+{
+    if (segments == nullptr) {
+        return TRANSPORT_ERROR;
+    }
+    if (g_iBtHci == nullptr) {
+        return INITIALIZATION_ERROR;
+    }
+    size_t size = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        size += segments[i].size;
+    }
+    // Gathered straight into the IPC vector, the only copy on the transmit path.
+    std::vector<uint8_t> data;
+    data.reserve(size);
+    for (uint32_t i = 0; i < count; i++) {
+        data.insert(data.end(), segments[i].data, segments[i].data + segments[i].size);
+    }
+    int32_t result = g_iBtHci->SendHciPacket(HdiGetBtType(type), data);
     if (result != ohos::hardware::bt::v1_0::BtStatus::SUCCESS) {
         return TRANSPORT_ERROR;
     }
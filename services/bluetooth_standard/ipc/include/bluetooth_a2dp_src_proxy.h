@@ -51,6 +51,8 @@ public:
     void SetAudioConfigure(const RawAddress &device, int32_t sampleRate, int32_t bits, int32_t channel) override;
     int WriteFrame(const uint8_t *data, uint32_t size) override;
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) override;
+    int OpenPcmRing(const sptr<IBluetoothA2dpSourceObserver> &observer, uint32_t size) override;
+    void ClosePcmRing() override;
 
 private:
     static inline BrokerDelegator<BluetoothA2dpSrcProxy> delegator_;
@@ -52,6 +52,8 @@ private:
     ErrCode SetAudioConfigureInner(MessageParcel &data, MessageParcel &reply);
     ErrCode WriteFrameInner(MessageParcel &data, MessageParcel &reply);
     ErrCode GetRenderPositionInner(MessageParcel &data, MessageParcel &reply);
+    ErrCode OpenPcmRingInner(MessageParcel &data, MessageParcel &reply);
+    ErrCode ClosePcmRingInner(MessageParcel &data, MessageParcel &reply);
 
     using BluetoothA2dpSrcServerFunc = ErrCode (BluetoothA2dpSrcStub::*)(MessageParcel &data, MessageParcel &reply);
     std::map<uint32_t, BluetoothA2dpSrcServerFunc> memberFuncMap_;
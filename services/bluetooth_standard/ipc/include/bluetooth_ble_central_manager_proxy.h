@@ -34,6 +34,7 @@ public:
     virtual void StartScan() override;
     virtual void StartScan(const BluetoothBleScanSettings &settings) override;
     virtual void StopScan() override;
+    virtual void ConfigScanFilter(const std::vector<BluetoothBleScanFilter> &filters) override;
 
 private:
     ErrCode InnerTransact(uint32_t code, MessageOption &flags, MessageParcel &data, MessageParcel &reply);
@@ -42,6 +42,7 @@ private:
     ErrCode StartScanInner(MessageParcel &data, MessageParcel &reply);
     ErrCode StartScanWithSettingsInner(MessageParcel &data, MessageParcel &reply);
     ErrCode StopScanInner(MessageParcel &data, MessageParcel &reply);
+    ErrCode ConfigScanFilterInner(MessageParcel &data, MessageParcel &reply);
 };
 }  // namespace Bluetooth
 }  // namespace OHOS
@@ -53,6 +53,8 @@ public:
         BT_A2DP_SRC_SET_AUDIO_CONFIGURE,
         BT_A2DP_SRC_WRITE_FRAME,
         BT_A2DP_SRC_GET_RENDER_POSITION,
+        BT_A2DP_SRC_OPEN_PCM_RING,
+        BT_A2DP_SRC_CLOSE_PCM_RING,
     };
 
     virtual int Connect(const RawAddress &device) = 0;
@@ -76,6 +78,8 @@ public:
     virtual void SetAudioConfigure(const RawAddress &device, int32_t sampleRate, int32_t bits, int32_t channel) = 0;
     virtual int WriteFrame(const uint8_t *data, uint32_t size) = 0;
     virtual void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) = 0;
+    virtual int OpenPcmRing(const sptr<IBluetoothA2dpSourceObserver> &observer, uint32_t size) = 0;
+    virtual void ClosePcmRing() = 0;
 };
 }  // namespace Bluetooth
 }  // namespace OHOS
@@ -16,6 +16,7 @@
 #ifndef OHOS_BLUETOOTH_STANDARD_BLE_CENTRAL_MANAGER_INTERFACE_H
 #define OHOS_BLUETOOTH_STANDARD_BLE_CENTRAL_MANAGER_INTERFACE_H
 
+#include "../parcel/bluetooth_ble_scan_filter.h"
 #include "../parcel/bluetooth_ble_scan_settings.h"
 #include "i_bluetooth_ble_central_manager_callback.h"
 #include "iremote_broker.h"
@@ -32,6 +33,7 @@ public:
         BLE_START_SCAN,
         BLE_START_SCAN_WITH_SETTINGS,
         BLE_STOP_SCAN,
+        BLE_CONFIG_SCAN_FILTER,
     };
 
     virtual void RegisterBleCentralManagerCallback(const sptr<IBluetoothBleCentralManagerCallback> &callback) = 0;
@@ -39,6 +41,7 @@ public:
     virtual void StartScan() = 0;
     virtual void StartScan(const BluetoothBleScanSettings &settings) = 0;
     virtual void StopScan() = 0;
+    virtual void ConfigScanFilter(const std::vector<BluetoothBleScanFilter> &filters) = 0;
 };
 }  // namespace Bluetooth
 }  // namespace OHOS
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bluetooth_ble_scan_filter.h"
+
+namespace OHOS {
+namespace Bluetooth {
+bool BluetoothBleScanFilter::Marshalling(Parcel &parcel) const
+{
+    if (!parcel.WriteString(deviceId_)) {
+        return false;
+    }
+    if (!parcel.WriteString(name_)) {
+        return false;
+    }
+    if (!WriteUuid(parcel, hasServiceUuid_, serviceUuid_)) {
+        return false;
+    }
+    if (!WriteUuid(parcel, hasServiceUuidMask_, serviceUuidMask_)) {
+        return false;
+    }
+    if (!parcel.WriteUInt8Vector(serviceData_)) {
+        return false;
+    }
+    if (!parcel.WriteUInt8Vector(serviceDataMask_)) {
+        return false;
+    }
+    if (!parcel.WriteBool(hasManufacturerId_)) {
+        return false;
+    }
+    if (!parcel.WriteUint16(manufacturerId_)) {
+        return false;
+    }
+    if (!parcel.WriteUInt8Vector(manufactureData_)) {
+        return false;
+    }
+    if (!parcel.WriteUInt8Vector(manufactureDataMask_)) {
+        return false;
+    }
+    if (!parcel.WriteInt8(rssiThreshold_)) {
+        return false;
+    }
+    return true;
+}
+
+BluetoothBleScanFilter *BluetoothBleScanFilter::Unmarshalling(Parcel &parcel)
+{
+    BluetoothBleScanFilter *filter = new BluetoothBleScanFilter();
+    if (filter != nullptr && !filter->ReadFromParcel(parcel)) {
+        delete filter;
+        filter = nullptr;
+    }
+    return filter;
+}
+
+bool BluetoothBleScanFilter::WriteToParcel(Parcel &parcel)
+{
+    return Marshalling(parcel);
+}
+
+bool BluetoothBleScanFilter::ReadFromParcel(Parcel &parcel)
+{
+    if (!parcel.ReadString(deviceId_)) {
+        return false;
+    }
+    if (!parcel.ReadString(name_)) {
+        return false;
+    }
+    if (!ReadUuid(parcel, hasServiceUuid_, serviceUuid_)) {
+        return false;
+    }
+    if (!ReadUuid(parcel, hasServiceUuidMask_, serviceUuidMask_)) {
+        return false;
+    }
+    if (!parcel.ReadUInt8Vector(&serviceData_)) {
+        return false;
+    }
+    if (!parcel.ReadUInt8Vector(&serviceDataMask_)) {
+        return false;
+    }
+    if (!parcel.ReadBool(hasManufacturerId_)) {
+        return false;
+    }
+    if (!parcel.ReadUint16(manufacturerId_)) {
+        return false;
+    }
+    if (!parcel.ReadUInt8Vector(&manufactureData_)) {
+        return false;
+    }
+    if (!parcel.ReadUInt8Vector(&manufactureDataMask_)) {
+        return false;
+    }
+    if (!parcel.ReadInt8(rssiThreshold_)) {
+        return false;
+    }
+    return true;
+}
+
+bool BluetoothBleScanFilter::WriteUuid(Parcel &parcel, bool has, const ::bluetooth::Uuid &uuid)
+{
+    if (!parcel.WriteBool(has)) {
+        return false;
+    }
+    std::vector<uint8_t> bytes(::bluetooth::Uuid::UUID128_BYTES_TYPE);
+    uuid.ConvertToBytesLE(bytes.data(), bytes.size());
+    return parcel.WriteUInt8Vector(bytes);
+}
+
+bool BluetoothBleScanFilter::ReadUuid(Parcel &parcel, bool &has, ::bluetooth::Uuid &uuid)
+{
+    if (!parcel.ReadBool(has)) {
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    if (!parcel.ReadUInt8Vector(&bytes) || bytes.size() != ::bluetooth::Uuid::UUID128_BYTES_TYPE) {
+        return false;
+    }
+    uuid = ::bluetooth::Uuid::ConvertFromBytesLE(bytes.data(), bytes.size());
+    return true;
+}
+}  // namespace Bluetooth
+}  // namespace OHOS
@@ -583,6 +583,56 @@ void BluetoothA2dpSrcProxy::GetRenderPosition(uint16_t &delayValue, uint16_t &se
     timeStamp = reply.ReadUint32();
 }
 
+int BluetoothA2dpSrcProxy::OpenPcmRing(const sptr<IBluetoothA2dpSourceObserver> &observer, uint32_t size)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(BluetoothA2dpSrcProxy::GetDescriptor())) {
+        HILOGE("BluetoothA2dpSrcProxy::OpenPcmRing WriteInterfaceToken error");
+        return ERROR;
+    }
+    if (!data.WriteRemoteObject(observer->AsObject())) {
+        HILOGE("BluetoothA2dpSrcProxy::OpenPcmRing write observer error");
+        return ERROR;
+    }
+    if (!data.WriteUint32(size)) {
+        HILOGE("BluetoothA2dpSrcProxy::OpenPcmRing write size error");
+        return ERROR;
+    }
+    MessageParcel reply;
+    MessageOption option {
+        MessageOption::TF_SYNC
+    };
+
+    int error = Remote()->SendRequest(IBluetoothA2dpSrc::Code::BT_A2DP_SRC_OPEN_PCM_RING, data, reply, option);
+    if (error != NO_ERROR) {
+        HILOGE("BluetoothA2dpSrcProxy::OpenPcmRing done fail, error: %{public}d", error);
+        return ERROR;
+    }
+    int ret = reply.ReadInt32();
+    if (ret != NO_ERROR) {
+        return ret;
+    }
+    return reply.ReadFileDescriptor();
+}
+
+void BluetoothA2dpSrcProxy::ClosePcmRing()
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(BluetoothA2dpSrcProxy::GetDescriptor())) {
+        HILOGE("BluetoothA2dpSrcProxy::ClosePcmRing WriteInterfaceToken error");
+        return;
+    }
+    MessageParcel reply;
+    MessageOption option {
+        MessageOption::TF_SYNC
+    };
+
+    int error = Remote()->SendRequest(IBluetoothA2dpSrc::Code::BT_A2DP_SRC_CLOSE_PCM_RING, data, reply, option);
+    if (error != NO_ERROR) {
+        HILOGE("BluetoothA2dpSrcProxy::ClosePcmRing done fail, error: %{public}d", error);
+    }
+}
+
 bool BluetoothA2dpSrcProxy::WriteParcelableInt32Vector(
     const std::vector<int32_t> &parcelableVector, Parcel &reply)
 {
@@ -67,6 +67,10 @@ BluetoothA2dpSrcStub::BluetoothA2dpSrcStub()
         &BluetoothA2dpSrcStub::WriteFrameInner;
     memberFuncMap_[static_cast<uint32_t>(IBluetoothA2dpSrc::Code::BT_A2DP_SRC_GET_RENDER_POSITION)] =
         &BluetoothA2dpSrcStub::GetRenderPositionInner;
+    memberFuncMap_[static_cast<uint32_t>(IBluetoothA2dpSrc::Code::BT_A2DP_SRC_OPEN_PCM_RING)] =
+        &BluetoothA2dpSrcStub::OpenPcmRingInner;
+    memberFuncMap_[static_cast<uint32_t>(IBluetoothA2dpSrc::Code::BT_A2DP_SRC_CLOSE_PCM_RING)] =
+        &BluetoothA2dpSrcStub::ClosePcmRingInner;
 }
 
 BluetoothA2dpSrcStub::~BluetoothA2dpSrcStub()
@@ -396,5 +400,29 @@ ErrCode BluetoothA2dpSrcStub::GetRenderPositionInner(MessageParcel &data, Messag
     return NO_ERROR;
 }
 
+ErrCode BluetoothA2dpSrcStub::OpenPcmRingInner(MessageParcel &data, MessageParcel &reply)
+{
+    sptr<IRemoteObject> remote = data.ReadRemoteObject();
+    const sptr<IBluetoothA2dpSourceObserver> observer = OHOS::iface_cast<IBluetoothA2dpSourceObserver>(remote);
+    uint32_t size = data.ReadUint32();
+    int ret = OpenPcmRing(observer, size);
+    if (!reply.WriteInt32((ret < 0) ? ret : NO_ERROR)) {
+        HILOGE("BluetoothA2dpSrcStub: OpenPcmRingInner reply writing failed in: %{public}s.", __func__);
+        return TRANSACTION_ERR;
+    }
+    // The ring fd stays with the service, the parcel carries a dup of it.
+    if (ret >= 0 && !reply.WriteFileDescriptor(ret)) {
+        HILOGE("BluetoothA2dpSrcStub: OpenPcmRingInner reply writing failed in: %{public}s.", __func__);
+        return TRANSACTION_ERR;
+    }
+    return NO_ERROR;
+}
+
+ErrCode BluetoothA2dpSrcStub::ClosePcmRingInner(MessageParcel &data, MessageParcel &reply)
+{
+    ClosePcmRing();
+    return NO_ERROR;
+}
+
 }  // namespace Bluetooth
 }  // namespace OHOS
\ No newline at end of file
@@ -123,6 +123,33 @@ void BluetoothBleCentralManagerProxy::StopScan()
     }
 }
 
+void BluetoothBleCentralManagerProxy::ConfigScanFilter(const std::vector<BluetoothBleScanFilter> &filters)
+{
+    MessageParcel data;
+    if (!data.WriteInterfaceToken(BluetoothBleCentralManagerProxy::GetDescriptor())) {
+        HILOGW("[ConfigScanFilter] fail: write interface token failed.");
+        return;
+    }
+
+    if (!data.WriteInt32(filters.size())) {
+        HILOGW("[ConfigScanFilter] fail: write filter size failed");
+        return;
+    }
+    for (auto &filter : filters) {
+        if (!data.WriteParcelable(&filter)) {
+            HILOGW("[ConfigScanFilter] fail: write filter failed");
+            return;
+        }
+    }
+
+    MessageParcel reply;
+    MessageOption option = {MessageOption::TF_SYNC};
+    ErrCode result = InnerTransact(BLE_CONFIG_SCAN_FILTER, option, data, reply);
+    if (result != NO_ERROR) {
+        HILOGW("[ConfigScanFilter] fail: transact ErrCode=%{public}d", result);
+    }
+}
+
 ErrCode BluetoothBleCentralManagerProxy::InnerTransact(
     uint32_t code, MessageOption &flags, MessageParcel &data, MessageParcel &reply)
 {
@@ -22,6 +22,10 @@
 
 namespace OHOS {
 namespace Bluetooth {
+namespace {
+const int32_t BLE_SCAN_FILTER_MAX_NUM = 64;
+}  // namespace
+
 const std::map<uint32_t, std::function<ErrCode(BluetoothBleCentralManagerStub *, MessageParcel &, MessageParcel &)>>
     BluetoothBleCentralManagerStub::interfaces_ = {
         {IBluetoothBleCentralManager::Code::BLE_REGISTER_BLE_CENTRAL_MANAGER_CALLBACK,
@@ -39,6 +43,9 @@ const std::map<uint32_t, std::function<ErrCode(BluetoothBleCentralManagerStub *,
         {IBluetoothBleCentralManager::Code::BLE_STOP_SCAN,
             std::bind(&BluetoothBleCentralManagerStub::StopScanInner, std::placeholders::_1, std::placeholders::_2,
                 std::placeholders::_3)},
+        {IBluetoothBleCentralManager::Code::BLE_CONFIG_SCAN_FILTER,
+            std::bind(&BluetoothBleCentralManagerStub::ConfigScanFilterInner, std::placeholders::_1,
+                std::placeholders::_2, std::placeholders::_3)},
 };
 
 BluetoothBleCentralManagerStub::BluetoothBleCentralManagerStub()
@@ -121,5 +128,27 @@ ErrCode BluetoothBleCentralManagerStub::StopScanInner(MessageParcel &data, Messa
     StopScan();
     return NO_ERROR;
 }
+
+ErrCode BluetoothBleCentralManagerStub::ConfigScanFilterInner(MessageParcel &data, MessageParcel &reply)
+{
+    int32_t size = 0;
+    if (!data.ReadInt32(size) || size < 0 || size > BLE_SCAN_FILTER_MAX_NUM) {
+        HILOGW("[ConfigScanFilterInner] fail: read filter size failed");
+        return TRANSACTION_ERR;
+    }
+
+    std::vector<BluetoothBleScanFilter> filters;
+    for (int32_t i = 0; i < size; i++) {
+        std::shared_ptr<BluetoothBleScanFilter> filter(data.ReadParcelable<BluetoothBleScanFilter>());
+        if (filter == nullptr) {
+            HILOGW("[ConfigScanFilterInner] fail: read filter failed");
+            return TRANSACTION_ERR;
+        }
+        filters.push_back(*filter);
+    }
+
+    ConfigScanFilter(filters);
+    return NO_ERROR;
+}
 }  // namespace Bluetooth
 }  // namespace OHOS
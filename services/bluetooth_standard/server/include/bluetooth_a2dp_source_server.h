@@ -53,6 +53,8 @@ public:
     void SetAudioConfigure(const RawAddress &device, int sample, int bits, int channel) override;
     int WriteFrame(const uint8_t *data, uint32_t size) override;
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) override;
+    int OpenPcmRing(const sptr<IBluetoothA2dpSourceObserver> &observer, uint32_t size) override;
+    void ClosePcmRing() override;
 
 private:
     BLUETOOTH_DECLARE_IMPL();
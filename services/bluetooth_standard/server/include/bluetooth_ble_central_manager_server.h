@@ -35,6 +35,7 @@ public:
     virtual void StartScan() override;
     virtual void StartScan(const BluetoothBleScanSettings &settings) override;
     virtual void StopScan() override;
+    virtual void ConfigScanFilter(const std::vector<BluetoothBleScanFilter> &filters) override;
 
 private:
     BLUETOOTH_DECLARE_IMPL();
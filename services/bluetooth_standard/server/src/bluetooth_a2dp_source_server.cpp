@@ -14,9 +14,11 @@
  */
 
 #include "bluetooth_a2dp_source_server.h"
+#include <mutex>
 #include "bluetooth_log.h"
 #include "interface_profile_manager.h"
 #include "interface_profile_a2dp_src.h"
+#include "ipc_skeleton.h"
 #include "remote_observer_list.h"
 #include "interface_adapter_manager.h"
 
@@ -79,6 +81,16 @@ struct BluetoothA2dpSourceServer::impl {
     RemoteObserverList<IBluetoothA2dpSourceObserver> observers_;
     std::unique_ptr<A2dpSourceObserver> observerImp_{std::make_unique<A2dpSourceObserver>()};
     IProfileA2dpSrc *a2dpSrcService_ = nullptr;
+
+    /// pcm ring owner death recipient
+    class PcmRingDeathRecipient;
+    void WatchPcmRingOwner(const sptr<IRemoteObject> &client, int pid);
+    void UnwatchPcmRingOwner();
+    std::mutex pcmRingMutex_ {};
+    /// The client that opened the pcm ring, the ring is closed if it dies
+    sptr<IRemoteObject> pcmRingClient_ = nullptr;
+    sptr<IRemoteObject::DeathRecipient> pcmRingDeathRecipient_ = nullptr;
+    int pcmRingOwner_ = 0;
 };
 
 class BluetoothA2dpSourceServer::impl::SystemStateObserver : public ISystemStateObserver {
@@ -116,6 +128,30 @@ private:
     BluetoothA2dpSourceServer::impl *pimpl_ = nullptr;
 };
 
+class BluetoothA2dpSourceServer::impl::PcmRingDeathRecipient : public IRemoteObject::DeathRecipient {
+public:
+    explicit PcmRingDeathRecipient(BluetoothA2dpSourceServer::impl *pimpl) : pimpl_(pimpl) {};
+    ~PcmRingDeathRecipient() override = default;
+
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+    {
+        HILOGI("BluetoothA2dpSourceServer::impl::PcmRingDeathRecipient::OnRemoteDied starts");
+        std::lock_guard<std::mutex> lock(pimpl_->pcmRingMutex_);
+        if (pimpl_->pcmRingClient_ == nullptr || !(pimpl_->pcmRingClient_ == remote)) {
+            return;
+        }
+        if (pimpl_->a2dpSrcService_ != nullptr) {
+            pimpl_->a2dpSrcService_->ClosePcmRing(pimpl_->pcmRingOwner_);
+        }
+        pimpl_->pcmRingClient_ = nullptr;
+        pimpl_->pcmRingDeathRecipient_ = nullptr;
+        pimpl_->pcmRingOwner_ = 0;
+    }
+
+private:
+    BluetoothA2dpSourceServer::impl *pimpl_ = nullptr;
+};
+
 BluetoothA2dpSourceServer::impl::impl()
 {
     HILOGI("BluetoothA2dpSourceServer::impl::impl() starts");
@@ -124,6 +160,30 @@ BluetoothA2dpSourceServer::impl::impl()
 BluetoothA2dpSourceServer::impl::~impl()
 {
     HILOGI("BluetoothA2dpSourceServer::impl::~impl() starts");
+    std::lock_guard<std::mutex> lock(pcmRingMutex_);
+    UnwatchPcmRingOwner();
+}
+
+void BluetoothA2dpSourceServer::impl::WatchPcmRingOwner(const sptr<IRemoteObject> &client, int pid)
+{
+    UnwatchPcmRingOwner();
+    sptr<IRemoteObject::DeathRecipient> deathRecipient = new PcmRingDeathRecipient(this);
+    if (!client->AddDeathRecipient(deathRecipient)) {
+        HILOGE("Failed to link death recipient to pcm ring client");
+    }
+    pcmRingClient_ = client;
+    pcmRingDeathRecipient_ = deathRecipient;
+    pcmRingOwner_ = pid;
+}
+
+void BluetoothA2dpSourceServer::impl::UnwatchPcmRingOwner()
+{
+    if (pcmRingClient_ != nullptr && !pcmRingClient_->RemoveDeathRecipient(pcmRingDeathRecipient_)) {
+        HILOGE("Failed to unlink death recipient from pcm ring client");
+    }
+    pcmRingClient_ = nullptr;
+    pcmRingDeathRecipient_ = nullptr;
+    pcmRingOwner_ = 0;
 }
 
 BluetoothA2dpSourceServer::BluetoothA2dpSourceServer()
@@ -368,6 +428,34 @@ void BluetoothA2dpSourceServer::GetRenderPosition(uint16_t &delayValue, uint16_t
     HILOGI("delayValue = %{public}hu, sendDataSize = %{public}hu, timeStamp = %{public}u", delayValue, sendDataSize, 
         timeStamp);
 }
+
+int BluetoothA2dpSourceServer::OpenPcmRing(const sptr<IBluetoothA2dpSourceObserver> &observer, uint32_t size)
+{
+    HILOGI("BluetoothA2dpSourceServer::OpenPcmRing starts, size = %{public}u", size);
+    if (observer == nullptr) {
+        HILOGI("BluetoothA2dpSourceServer::OpenPcmRing observer is null");
+        return RET_BAD_STATUS;
+    }
+    // the calling process owns the ring until it closes it or dies
+    int pid = IPCSkeleton::GetCallingPid();
+    std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+    int fd = pimpl->a2dpSrcService_->OpenPcmRing(pid, size);
+    if (fd >= 0) {
+        pimpl->WatchPcmRingOwner(observer->AsObject(), pid);
+    }
+    return fd;
+}
+
+void BluetoothA2dpSourceServer::ClosePcmRing()
+{
+    HILOGI("BluetoothA2dpSourceServer::ClosePcmRing starts");
+    int pid = IPCSkeleton::GetCallingPid();
+    std::lock_guard<std::mutex> lock(pimpl->pcmRingMutex_);
+    pimpl->a2dpSrcService_->ClosePcmRing(pid);
+    if (pimpl->pcmRingOwner_ == pid) {
+        pimpl->UnwatchPcmRingOwner();
+    }
+}
     
 }  // namespace Bluetooth
 }  // namespace OHOS
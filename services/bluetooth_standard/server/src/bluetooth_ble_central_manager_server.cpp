@@ -18,7 +18,12 @@
 #include "bluetooth_log.h"
 #include "interface_adapter_ble.h"
 #include "interface_adapter_manager.h"
+#include "ipc_skeleton.h"
 #include "remote_observer_list.h"
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
 #include <string>
 
 namespace OHOS {
@@ -32,105 +37,42 @@ public:
     void OnScanCallback(const BleScanResultImpl &result) override
     {
         HILOGI("BleCentralManageCallback::OnScanCallback start.");
-
-        observers_->ForEach([result](IBluetoothBleCentralManagerCallback *observer) {
-            HILOGI("BleCentralManageCallback::OnScanCallback:Address= %{public}s",
-                result.GetPeripheralDevice().GetRawAddress().GetAddress().c_str());
-
-            BluetoothBleScanResult bleScanResult;
-            if (result.GetPeripheralDevice().IsRSSI()) {
-                bleScanResult.SetRssi(result.GetPeripheralDevice().GetRSSI());
-            }
-
-            bleScanResult.SetAdvertiseFlag(result.GetPeripheralDevice().GetAdFlag());
-
-            if (result.GetPeripheralDevice().IsManufacturerData()) {
-                std::map<uint16_t, std::string> manuData = result.GetPeripheralDevice().GetManufacturerData();
-                for (auto it = manuData.begin(); it != manuData.end(); it++) {
-                    bleScanResult.AddManufacturerData(it->first, it->second);
-                }
-            }
-
-            bleScanResult.SetConnectable(result.GetPeripheralDevice().IsConnectable());
-
-            if (result.GetPeripheralDevice().IsServiceUUID()) {
-                std::vector<Uuid> uuids = result.GetPeripheralDevice().GetServiceUUID();
-                for (auto iter = uuids.begin(); iter != uuids.end(); iter++) {
-                    bleScanResult.AddServiceUuid(*iter);
-                }
-            }
-
-            if (result.GetPeripheralDevice().IsServiceData()) {
-                std::vector<Uuid> uuids = result.GetPeripheralDevice().GetServiceDataUUID();
-                int index = 0;
-                for (auto iter = uuids.begin(); iter != uuids.end(); iter++) {
-                    bleScanResult.AddServiceData(*iter, result.GetPeripheralDevice().GetServiceData(index));
-                    ++index;
-                }
+        HILOGI("BleCentralManageCallback::OnScanCallback:Address= %{public}s",
+            result.GetPeripheralDevice().GetRawAddress().GetAddress().c_str());
+
+        // converted once, every observer whose filters accept the device gets the same parcelable
+        BlePeripheralDevice device = result.GetPeripheralDevice();
+        BluetoothBleScanResult bleScanResult = ConvertScanResult(device);
+        observers_->ForEach([this, &device, &bleScanResult](sptr<IBluetoothBleCentralManagerCallback> observer) {
+            if (MatchScanFilter(observer, device)) {
+                observer->OnScanCallback(bleScanResult);
             }
-
-            bleScanResult.SetPeripheralDevice(result.GetPeripheralDevice().GetRawAddress());
-
-            bleScanResult.SetPayload(std::string(result.GetPeripheralDevice().GetPayload(),
-                result.GetPeripheralDevice().GetPayload() + result.GetPeripheralDevice().GetPayloadLen()));
-
-            observer->OnScanCallback(bleScanResult);
         });
     }
 
     void OnBleBatchScanResultsEvent(std::vector<BleScanResultImpl> &results) override
     {
-        HILOGI("BleCentralManageCallback::OnBleBatchScanResultsEvent start.");
-
-        observers_->ForEach([results](IBluetoothBleCentralManagerCallback *observer) {
-            std::vector<BluetoothBleScanResult> bleScanResults;
-
-            for (auto iter = results.begin(); iter != results.end(); iter++) {
-                HILOGI("BleCentralManageCallback::OnScanCallback:Address= %{public}s",
-                    iter->GetPeripheralDevice().GetRawAddress().GetAddress().c_str());
-
-                BluetoothBleScanResult bleScanResult;
-
-                if (iter->GetPeripheralDevice().IsRSSI()) {
-                    bleScanResult.SetRssi(iter->GetPeripheralDevice().GetRSSI());
-                }
-
-                bleScanResult.SetAdvertiseFlag(iter->GetPeripheralDevice().GetAdFlag());
-
-                if (iter->GetPeripheralDevice().IsManufacturerData()) {
-                    std::map<uint16_t, std::string> manuData = iter->GetPeripheralDevice().GetManufacturerData();
-                    for (auto manuDataIter = manuData.begin(); manuDataIter != manuData.end(); manuDataIter++) {
-                        bleScanResult.AddManufacturerData(manuDataIter->first, manuDataIter->second);
-                    }
-                }
-
-                bleScanResult.SetConnectable(iter->GetPeripheralDevice().IsConnectable());
-
-                if (iter->GetPeripheralDevice().IsServiceUUID()) {
-                    std::vector<Uuid> uuids = iter->GetPeripheralDevice().GetServiceUUID();
-                    for (auto serviceUuidIter = uuids.begin(); serviceUuidIter != uuids.end(); serviceUuidIter++) {
-                        bleScanResult.AddServiceUuid(*serviceUuidIter);
-                    }
-                }
-
-                if (iter->GetPeripheralDevice().IsServiceData()) {
-                    std::vector<Uuid> uuids = iter->GetPeripheralDevice().GetServiceDataUUID();
-                    int index = 0;
-                    for (auto serviceDataIter = uuids.begin(); serviceDataIter != uuids.end(); serviceDataIter++) {
-                        bleScanResult.AddServiceData(
-                            *serviceDataIter, iter->GetPeripheralDevice().GetServiceData(index));
-                        ++index;
-                    }
+        HILOGI("BleCentralManageCallback::OnBleBatchScanResultsEvent start, size is %{public}zu.", results.size());
+
+        std::vector<BlePeripheralDevice> devices;
+        std::vector<BluetoothBleScanResult> bleScanResults;
+        devices.reserve(results.size());
+        bleScanResults.reserve(results.size());
+        for (auto iter = results.begin(); iter != results.end(); iter++) {
+            devices.push_back(iter->GetPeripheralDevice());
+            bleScanResults.push_back(ConvertScanResult(devices.back()));
+        }
+        observers_->ForEach([this, &devices, &bleScanResults](sptr<IBluetoothBleCentralManagerCallback> observer) {
+            std::vector<BluetoothBleScanResult> accepted;
+            for (size_t i = 0; i < devices.size(); i++) {
+                if (MatchScanFilter(observer, devices[i])) {
+                    accepted.push_back(bleScanResults[i]);
                 }
-
-                bleScanResult.SetPeripheralDevice(iter->GetPeripheralDevice().GetRawAddress());
-
-                bleScanResult.SetPayload(std::string(iter->GetPeripheralDevice().GetPayload(),
-                    iter->GetPeripheralDevice().GetPayload() + iter->GetPeripheralDevice().GetPayloadLen()));
-
-                bleScanResults.push_back(bleScanResult);
             }
-            observer->OnBleBatchScanResultsEvent(bleScanResults);
+            if (accepted.empty() && !bleScanResults.empty()) {
+                return;
+            }
+            observer->OnBleBatchScanResultsEvent(accepted);
         });
     }
 
@@ -146,8 +88,62 @@ public:
         observers_ = observers;
     }
 
+    void SetScanFilter(
+        std::function<bool(const sptr<IBluetoothBleCentralManagerCallback> &, const BlePeripheralDevice &)> scanFilter)
+    {
+        scanFilter_ = scanFilter;
+    }
+
 private:
+    bool MatchScanFilter(
+        const sptr<IBluetoothBleCentralManagerCallback> &observer, const BlePeripheralDevice &device) const
+    {
+        return !scanFilter_ || scanFilter_(observer, device);
+    }
+
+    static BluetoothBleScanResult ConvertScanResult(const BlePeripheralDevice &device)
+    {
+        BluetoothBleScanResult bleScanResult;
+        if (device.IsRSSI()) {
+            bleScanResult.SetRssi(device.GetRSSI());
+        }
+
+        bleScanResult.SetAdvertiseFlag(device.GetAdFlag());
+
+        if (device.IsManufacturerData()) {
+            std::map<uint16_t, std::string> manuData = device.GetManufacturerData();
+            for (auto it = manuData.begin(); it != manuData.end(); it++) {
+                bleScanResult.AddManufacturerData(it->first, it->second);
+            }
+        }
+
+        bleScanResult.SetConnectable(device.IsConnectable());
+
+        if (device.IsServiceUUID()) {
+            std::vector<Uuid> uuids = device.GetServiceUUID();
+            for (auto iter = uuids.begin(); iter != uuids.end(); iter++) {
+                bleScanResult.AddServiceUuid(*iter);
+            }
+        }
+
+        if (device.IsServiceData()) {
+            std::vector<Uuid> uuids = device.GetServiceDataUUID();
+            int index = 0;
+            for (auto iter = uuids.begin(); iter != uuids.end(); iter++) {
+                bleScanResult.AddServiceData(*iter, device.GetServiceData(index));
+                ++index;
+            }
+        }
+
+        bleScanResult.SetPeripheralDevice(device.GetRawAddress());
+
+        bleScanResult.SetPayload(std::string(device.GetPayload(), device.GetPayload() + device.GetPayloadLen()));
+
+        return bleScanResult;
+    }
+
     RemoteObserverList<IBluetoothBleCentralManagerCallback> *observers_;
+    std::function<bool(const sptr<IBluetoothBleCentralManagerCallback> &, const BlePeripheralDevice &)> scanFilter_;
 };
 
 struct BluetoothBleCentralManagerServer::impl {
@@ -157,11 +153,30 @@ struct BluetoothBleCentralManagerServer::impl {
     /// sys state observer
     class SystemStateObserver;
     std::unique_ptr<SystemStateObserver> systemStateObserver_ = nullptr;
+    /// scan callback death recipient
+    class ScanCallbackDeathRecipient;
+
+    void AddScanner(const sptr<IBluetoothBleCentralManagerCallback> &callback, int32_t pid);
+    void RemoveScanner(const wptr<IRemoteObject> &object, bool isDead);
+    void ConfigScanFilter(int32_t pid, const std::vector<BleScanFilterImpl> &filters);
+    void StartScanFilter(int32_t pid);
+    void RemoveScanFilter(int32_t pid);
+    bool MatchScanFilter(const sptr<IBluetoothBleCentralManagerCallback> &observer, const BlePeripheralDevice &device);
 
     RemoteObserverList<IBluetoothBleCentralManagerCallback> observers_;
     std::unique_ptr<BleCentralManagerCallback> observerImp_ = std::make_unique<BleCentralManagerCallback>();
     IAdapterBle *bleService_ = nullptr;
     std::vector<sptr<IBluetoothBleCentralManagerCallback>> scanCallback_;
+
+    struct Scanner {
+        int32_t pid = 0;
+        sptr<IRemoteObject::DeathRecipient> deathRecipient = nullptr;
+    };
+    std::mutex scannerMutex_ {};
+    /// Callback object <-> the process that registered it, results are filtered per process
+    std::map<sptr<IRemoteObject>, Scanner> scanners_ {};
+    /// Processes whose filters are set in the service
+    std::set<int32_t> filteredPids_ {};
 };
 
 class BluetoothBleCentralManagerServer::impl::SystemStateObserver : public ISystemStateObserver {
@@ -177,9 +192,13 @@ public:
                     pimpl_->bleService_->RegisterBleCentralManagerCallback(*pimpl_->observerImp_.get());
                 }
                 break;
-            case BTSystemState::OFF:
+            case BTSystemState::OFF: {
                 pimpl_->bleService_ = nullptr;
+                // the filters go with the service
+                std::lock_guard<std::mutex> lock(pimpl_->scannerMutex_);
+                pimpl_->filteredPids_.clear();
                 break;
+            }
             default:
                 break;
         }
@@ -189,6 +208,19 @@ private:
     BluetoothBleCentralManagerServer::impl *pimpl_ = nullptr;
 };
 
+class BluetoothBleCentralManagerServer::impl::ScanCallbackDeathRecipient : public IRemoteObject::DeathRecipient {
+public:
+    explicit ScanCallbackDeathRecipient(BluetoothBleCentralManagerServer::impl *pimpl) : pimpl_(pimpl){};
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override
+    {
+        HILOGI("BluetoothBleCentralManagerServer::ScanCallbackDeathRecipient::OnRemoteDied.");
+        pimpl_->RemoveScanner(remote, true);
+    };
+
+private:
+    BluetoothBleCentralManagerServer::impl *pimpl_ = nullptr;
+};
+
 BluetoothBleCentralManagerServer::impl::impl()
 {}
 
@@ -198,12 +230,119 @@ BluetoothBleCentralManagerServer::impl::~impl()
     if (bleService_ != nullptr) {
         bleService_->DeregisterBleCentralManagerCallback();
     }
+
+    std::lock_guard<std::mutex> lock(scannerMutex_);
+    for (auto &scanner : scanners_) {
+        if (!scanner.first->RemoveDeathRecipient(scanner.second.deathRecipient)) {
+            HILOGE("Failed to unlink death recipient from scan callback");
+        }
+    }
+    scanners_.clear();
+}
+
+void BluetoothBleCentralManagerServer::impl::AddScanner(
+    const sptr<IBluetoothBleCentralManagerCallback> &callback, int32_t pid)
+{
+    Scanner scanner;
+    scanner.pid = pid;
+    scanner.deathRecipient = new ScanCallbackDeathRecipient(this);
+    if (!callback->AsObject()->AddDeathRecipient(scanner.deathRecipient)) {
+        HILOGE("Failed to link death recipient to scan callback");
+    }
+
+    std::lock_guard<std::mutex> lock(scannerMutex_);
+    scanners_[callback->AsObject()] = scanner;
+}
+
+void BluetoothBleCentralManagerServer::impl::RemoveScanner(const wptr<IRemoteObject> &object, bool isDead)
+{
+    int32_t pid = 0;
+    {
+        std::lock_guard<std::mutex> lock(scannerMutex_);
+        auto it = scanners_.begin();
+        for (; it != scanners_.end(); ++it) {
+            if (it->first == object) {
+                break;
+            }
+        }
+        if (it == scanners_.end()) {
+            return;
+        }
+        if (!isDead && !it->first->RemoveDeathRecipient(it->second.deathRecipient)) {
+            HILOGE("Failed to unlink death recipient from scan callback");
+        }
+        pid = it->second.pid;
+        scanners_.erase(it);
+
+        // the process keeps its filters while it still has a callback
+        for (auto &scanner : scanners_) {
+            if (scanner.second.pid == pid) {
+                return;
+            }
+        }
+    }
+    RemoveScanFilter(pid);
+}
+
+void BluetoothBleCentralManagerServer::impl::ConfigScanFilter(
+    int32_t pid, const std::vector<BleScanFilterImpl> &filters)
+{
+    {
+        std::lock_guard<std::mutex> lock(scannerMutex_);
+        filteredPids_.insert(pid);
+    }
+    bleService_->ConfigScanFilter(pid, filters);
+}
+
+void BluetoothBleCentralManagerServer::impl::StartScanFilter(int32_t pid)
+{
+    {
+        std::lock_guard<std::mutex> lock(scannerMutex_);
+        if (!filteredPids_.insert(pid).second) {
+            return;
+        }
+    }
+    // a process starting a scan without filters wants every report
+    bleService_->ConfigScanFilter(pid, {});
+}
+
+void BluetoothBleCentralManagerServer::impl::RemoveScanFilter(int32_t pid)
+{
+    {
+        std::lock_guard<std::mutex> lock(scannerMutex_);
+        if (filteredPids_.erase(pid) == 0) {
+            return;
+        }
+    }
+    IAdapterBle *bleService = bleService_;
+    if (bleService != nullptr) {
+        bleService->RemoveScanFilter(pid);
+    }
+}
+
+bool BluetoothBleCentralManagerServer::impl::MatchScanFilter(
+    const sptr<IBluetoothBleCentralManagerCallback> &observer, const BlePeripheralDevice &device)
+{
+    int32_t pid = 0;
+    {
+        std::lock_guard<std::mutex> lock(scannerMutex_);
+        auto it = scanners_.find(observer->AsObject());
+        if (it == scanners_.end() || filteredPids_.count(it->second.pid) == 0) {
+            return true;
+        }
+        pid = it->second.pid;
+    }
+    IAdapterBle *bleService = bleService_;
+    return bleService == nullptr || bleService->MatchScanFilter(pid, device);
 }
 
 BluetoothBleCentralManagerServer::BluetoothBleCentralManagerServer()
 {
     pimpl = std::make_unique<impl>();
     pimpl->observerImp_->SetObserver(&(pimpl->observers_));
+    pimpl->observerImp_->SetScanFilter(
+        [impl = pimpl.get()](const sptr<IBluetoothBleCentralManagerCallback> &observer,
+            const BlePeripheralDevice &device) { return impl->MatchScanFilter(observer, device); });
     pimpl->systemStateObserver_ = std::make_unique<impl::SystemStateObserver>(pimpl.get());
     IAdapterManager::GetInstance()->RegisterSystemStateObserver(*(pimpl->systemStateObserver_));
 
@@ -227,6 +366,7 @@ void BluetoothBleCentralManagerServer::StartScan()
         static_cast<IAdapterBle *>(IAdapterManager::GetInstance()->GetAdapter(BTTransport::ADAPTER_BLE));
 
     if (pimpl->bleService_ != nullptr) {
+        pimpl->StartScanFilter(IPCSkeleton::GetCallingPid());
         pimpl->bleService_->StartScan();
     }
 }
@@ -244,6 +384,7 @@ void BluetoothBleCentralManagerServer::StartScan(const BluetoothBleScanSettings
         settingsImpl.SetScanMode(settings.GetScanMode());
         settingsImpl.SetLegacy(settings.GetLegacy());
         settingsImpl.SetPhy(settings.GetPhy());
+        pimpl->StartScanFilter(IPCSkeleton::GetCallingPid());
         pimpl->bleService_->StartScan(settingsImpl);
     }
 }
@@ -257,6 +398,40 @@ void BluetoothBleCentralManagerServer::StopScan()
 
     if (pimpl->bleService_ != nullptr) {
         pimpl->bleService_->StopScan();
+        pimpl->RemoveScanFilter(IPCSkeleton::GetCallingPid());
+    }
+}
+
+void BluetoothBleCentralManagerServer::ConfigScanFilter(const std::vector<BluetoothBleScanFilter> &filters)
+{
+    HILOGI("BluetoothBleCentralManagerServer::ConfigScanFilter start.");
+
+    pimpl->bleService_ =
+        static_cast<IAdapterBle *>(IAdapterManager::GetInstance()->GetAdapter(BTTransport::ADAPTER_BLE));
+
+    if (pimpl->bleService_ != nullptr) {
+        std::vector<BleScanFilterImpl> filterImpls;
+        for (auto &filter : filters) {
+            BleScanFilterImpl filterImpl;
+            filterImpl.SetDeviceId(filter.GetDeviceId());
+            filterImpl.SetName(filter.GetName());
+            if (filter.HasServiceUuid()) {
+                filterImpl.SetServiceUuid(filter.GetServiceUuid());
+            }
+            if (filter.HasServiceUuidMask()) {
+                filterImpl.SetServiceUuidMask(filter.GetServiceUuidMask());
+            }
+            filterImpl.SetServiceData(filter.GetServiceData());
+            filterImpl.SetServiceDataMask(filter.GetServiceDataMask());
+            if (filter.HasManufacturerId()) {
+                filterImpl.SetManufacturerId(filter.GetManufacturerId());
+            }
+            filterImpl.SetManufactureData(filter.GetManufactureData());
+            filterImpl.SetManufactureDataMask(filter.GetManufactureDataMask());
+            filterImpl.SetRssiThreshold(filter.GetRssiThreshold());
+            filterImpls.push_back(filterImpl);
+        }
+        pimpl->ConfigScanFilter(IPCSkeleton::GetCallingPid(), filterImpls);
     }
 }
 
@@ -271,7 +446,9 @@ void BluetoothBleCentralManagerServer::RegisterBleCentralManagerCallback(
         return;
     }
     if (pimpl != nullptr) {
-        pimpl->observers_.Register(callback);
+        if (pimpl->observers_.Register(callback)) {
+            pimpl->AddScanner(callback, IPCSkeleton::GetCallingPid());
+        }
         pimpl->scanCallback_.push_back(callback);
     }
 }
@@ -289,6 +466,7 @@ void BluetoothBleCentralManagerServer::DeregisterBleCentralManagerCallback(
     for (auto iter = pimpl->scanCallback_.begin(); iter != pimpl->scanCallback_.end(); ++iter) {
         if ((*iter)->AsObject() == callback->AsObject()) {
             pimpl->observers_.Deregister(*iter);
+            pimpl->RemoveScanner((*iter)->AsObject(), false);
             pimpl->scanCallback_.erase(iter);
             break;
         }
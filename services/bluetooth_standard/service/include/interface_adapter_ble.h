@@ -405,6 +405,33 @@ public:
      */
     virtual void StartScan(const BleScanSettingsImpl &setting) const = 0;
 
+    /**
+     * @brief Config scan filters of a scanner. The scan session keeps the reports any scanner accepts.
+     *
+     * @param scannerId Scanner id.
+     * @param filters Scan filters, empty to accept every report.
+     * @since 6
+     */
+    virtual void ConfigScanFilter(int32_t scannerId, const std::vector<BleScanFilterImpl> &filters) const = 0;
+
+    /**
+     * @brief Remove scan filters of a scanner.
+     *
+     * @param scannerId Scanner id.
+     * @since 6
+     */
+    virtual void RemoveScanFilter(int32_t scannerId) const = 0;
+
+    /**
+     * @brief Match a scan result against the filters of a scanner.
+     *
+     * @param scannerId Scanner id.
+     * @param device Scanned device.
+     * @return Returns <b>true</b> if the scanner has no filters or one of them accepts the device.
+     * @since 6
+     */
+    virtual bool MatchScanFilter(int32_t scannerId, const BlePeripheralDevice &device) const = 0;
+
     /**
      * @brief Stop scan.
      *
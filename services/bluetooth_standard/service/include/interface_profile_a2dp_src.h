@@ -322,6 +322,22 @@ public:
      * @since 6.0
      */
     virtual void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) = 0;
+
+    /**
+     * @brief Open a shared memory pcm ring for the stream, replacing WriteFrame.
+     * @param[in] owner: The client opening the ring, the ring is refused while another client owns it
+     * @param[in] size: The ring capacity in bytes
+     * @return The ring fd owned by the service, or a negative error code
+     * @since 6.0
+     */
+    virtual int OpenPcmRing(int owner, uint32_t size) = 0;
+
+    /**
+     * @brief Close the shared memory pcm ring and go back to WriteFrame.
+     * @param[in] owner: The client closing the ring, ignored unless it owns the ring
+     * @since 6.0
+     */
+    virtual void ClosePcmRing(int owner) = 0;
 };
 /**
  * @brief This class provides functions called by Framework API for a2dp source.
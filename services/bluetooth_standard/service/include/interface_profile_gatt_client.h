@@ -224,6 +224,26 @@ public:
      *
      */
     virtual int SignedWriteCharacteristic(int appId, Characteristic &characteristic) = 0;
+    /**
+     * @brief The function to read several characteristics with as few requests as the remote device allows.
+     *
+     * @param appId Application id.
+     * @param characteristics Characteristic objects.
+     * @return int api accept status.
+     * @since 6
+     *
+     */
+    virtual int ReadCharacteristics(int appId, const std::vector<Characteristic> &characteristics) = 0;
+    /**
+     * @brief The function to write several characteristics as one reliable write, which commits all values or none.
+     *
+     * @param appId Application id.
+     * @param characteristics Characteristic objects.
+     * @return int api accept status.
+     * @since 6
+     *
+     */
+    virtual int WriteCharacteristics(int appId, std::vector<Characteristic> &characteristics) = 0;
 
     /**
      * @brief The function to read descriptor.
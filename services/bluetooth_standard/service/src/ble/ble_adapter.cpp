@@ -1525,6 +1525,35 @@ void BleAdapter::StartScan(const BleScanSettingsImpl &setting) const
     }
 }
 
+void BleAdapter::ConfigScanFilter(int32_t scannerId, const std::vector<BleScanFilterImpl> &filters) const
+{
+    LOG_DEBUG("[BleAdapter] %{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    if (pimpl->bleCentralManager_ != nullptr) {
+        pimpl->bleCentralManager_->ConfigScanFilter(scannerId, filters);
+    }
+}
+
+void BleAdapter::RemoveScanFilter(int32_t scannerId) const
+{
+    LOG_DEBUG("[BleAdapter] %{public}s", __func__);
+
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    if (pimpl->bleCentralManager_ != nullptr) {
+        pimpl->bleCentralManager_->RemoveScanFilter(scannerId);
+    }
+}
+
+bool BleAdapter::MatchScanFilter(int32_t scannerId, const BlePeripheralDevice &device) const
+{
+    std::lock_guard<std::recursive_mutex> lk(pimpl->syncMutex_);
+    if (pimpl->bleCentralManager_ != nullptr) {
+        return pimpl->bleCentralManager_->MatchScanFilter(scannerId, device);
+    }
+    return true;
+}
+
 void BleAdapter::StopScan() const
 {
     LOG_DEBUG("[BleAdapter] %{public}s", __func__);
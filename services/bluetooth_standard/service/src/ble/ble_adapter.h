@@ -131,6 +131,9 @@ public:
     void Close(uint8_t advHandle) const override;
     void StartScan() const override;
     void StartScan(const BleScanSettingsImpl &setting) const override;
+    void ConfigScanFilter(int32_t scannerId, const std::vector<BleScanFilterImpl> &filters) const override;
+    void RemoveScanFilter(int32_t scannerId) const override;
+    bool MatchScanFilter(int32_t scannerId, const BlePeripheralDevice &device) const override;
     void StopScan() const override;
     int GetAdvertisingStatus() const override;
     bool IsLlPrivacySupported() const override;
@@ -18,6 +18,7 @@
 #include "ble_adapter.h"
 #include "ble_feature.h"
 #include "ble_properties.h"
+#include "ble_scan_filter.h"
 #include "ble_utils.h"
 #include "common/adapter_manager.h"
 #include "securec.h"
@@ -42,6 +43,44 @@ struct BleCentralManagerImpl::impl {
      * @return @c status
      */
     void StartReportDelay();
+    /**
+     * @brief Add scan result to the report batch, replacing the result of the same device.
+     *
+     * @param [in] key device key.
+     * @param [in] result scan result.
+     */
+    void AddReportBatch(uint64_t key, const BleScanResultImpl &result);
+    /**
+     * @brief Take the results of the report batch.
+     *
+     * @return @c results updated since the last report.
+     */
+    std::vector<BleScanResultImpl> TakeReportBatch();
+    /**
+     * @brief Find the scan result of the device.
+     *
+     * @param [in] address device address.
+     * @return @c scan result, nullptr if the device is not found.
+     */
+    BleScanResultImpl *FindScanResult(const std::string &address);
+    /**
+     * @brief Remove the scan result of the device.
+     *
+     * @param [in] key device key.
+     */
+    void RemoveScanResult(uint64_t key);
+    /**
+     * @brief Make the lookup key of a device address.
+     *
+     * @param [in] addr device address.
+     * @param [in] type address type, 0 when the type does not tell devices apart.
+     * @return @c key.
+     */
+    static uint64_t MakeKey(const uint8_t *addr, uint8_t type = 0);
+    /**
+     * @brief Rebuild the session filters from the filters of every scanner, call with scannerFiltersMutex_ held.
+     */
+    void ConfigSessionFilter();
 
     std::recursive_mutex mutex_ {};
     /// callback type
@@ -52,6 +91,10 @@ struct BleCentralManagerImpl::impl {
     STOP_SCAN_TYPE stopScanType_ = STOP_SCAN_TYPE_NOR;
     /// scan result list
     std::vector<BleScanResultImpl> bleScanResult_ {};
+    /// Device key <-> index in bleScanResult_, a result is updated in place by every report of its device
+    std::unordered_map<uint64_t, size_t> bleScanResultIndex_ {};
+    /// Index in bleScanResult_ of the result updated by the last report
+    size_t lastScanResult_ = 0;
     /// Is stop scan
     bool isStopScan_ = false;
     /// scan settings
@@ -60,92 +103,150 @@ struct BleCentralManagerImpl::impl {
     BleScanParams scanParams_ {};
     /// Report delay timer
     std::unique_ptr<utility::Timer> timer_ = nullptr;
-    std::map<std::string, std::vector<uint8_t>> incompleteData_ {};
+    /// Results updated since the last report, one per device
+    std::vector<BleScanResultImpl> reportBatch_ {};
+    /// Device key <-> index in reportBatch_
+    std::unordered_map<uint64_t, size_t> reportBatchIndex_ {};
+    std::unordered_map<uint64_t, std::vector<uint8_t>> incompleteData_ {};
     BleCentralManagerImpl *bleCentralManagerImpl_ = nullptr;
 
     /// Adv data cache
     class BleAdvertisingDataCache {
     public:
         // Set the adv data to cache by device address
-        const std::vector<uint8_t> &SetAdvData(
-            uint8_t addrType, const RawAddress &address, std::vector<uint8_t> advData)
+        const std::vector<uint8_t> &SetAdvData(uint8_t addrType, const uint8_t *addr, const uint8_t *data, size_t len)
         {
-            auto it = SearchByAddress(addrType, address);
-            if (it != itemDatas_.end()) {
-                it->advData_ = std::move(advData);
-                return it->advData_;
-            }
-
-            if (itemDatas_.size() > MAX_CACHE) {
-                itemDatas_.pop_back();
-            }
-
-            itemDatas_.emplace_front(addrType, address, std::move(advData));
-            return itemDatas_.front().advData_;
+            std::vector<uint8_t> &advData = GetItem(addrType, addr).advData_;
+            advData.assign(data, data + len);
+            return advData;
         }
 
         // Append adv data for device address
         const std::vector<uint8_t> &AppendAdvData(
-            uint8_t addrType, const RawAddress &address, std::vector<uint8_t> advData)
+            uint8_t addrType, const uint8_t *addr, const uint8_t *data, size_t len)
         {
-            auto it = SearchByAddress(addrType, address);
-            if (it != itemDatas_.end()) {
-                it->advData_.insert(it->advData_.end(), advData.begin(), advData.end());
-                return it->advData_;
-            }
-
-            if (itemDatas_.size() > MAX_CACHE) {
-                itemDatas_.pop_back();
-            }
-
-            itemDatas_.emplace_front(addrType, address, std::move(advData));
-            return itemDatas_.front().advData_;
+            std::vector<uint8_t> &advData = GetItem(addrType, addr).advData_;
+            advData.insert(advData.end(), data, data + len);
+            return advData;
         }
 
-        // Clear adv data by device addr
-        void ClearAdvData(uint8_t addrType, const RawAddress &address)
+        // Clear adv data by device addr, the item keeps its buffer for the next advertising event
+        void ClearAdvData(uint8_t addrType, const uint8_t *addr)
         {
-            auto it = SearchByAddress(addrType, address);
+            auto it = itemDatas_.find(MakeKey(addr, addrType));
             if (it != itemDatas_.end()) {
-                itemDatas_.erase(it);
+                it->second.advData_.clear();
             }
         }
 
         // Clear all data
         void ClearAllData()
         {
-            for (auto item : itemDatas_) {
-                item.advData_.clear();
-            }
+            itemDatas_.clear();
         }
 
     private:
         struct ItemData {
-            uint8_t addrType_;
-            RawAddress address_;
-            std::vector<uint8_t> advData_;
-
-            ItemData(uint8_t addrType, const RawAddress &address, std::vector<uint8_t> advData)
-                : addrType_(addrType), address_(address), advData_(advData)
-            {}
+            std::vector<uint8_t> advData_ {};
+            std::chrono::steady_clock::time_point time_ {};
         };
 
-        std::list<ItemData>::iterator SearchByAddress(uint8_t addrType, const RawAddress &address)
+        ItemData &GetItem(uint8_t addrType, const uint8_t *addr)
+        {
+            auto now = std::chrono::steady_clock::now();
+            uint64_t key = MakeKey(addr, addrType);
+            auto it = itemDatas_.find(key);
+            if (it == itemDatas_.end()) {
+                auto oldest = itemDatas_.size() >= MAX_CACHE ? Evict(now) : itemDatas_.end();
+                if (oldest != itemDatas_.end()) {
+                    // the oldest item is handed over to the device with its buffer
+                    auto node = itemDatas_.extract(oldest);
+                    node.key() = key;
+                    node.mapped().advData_.clear();
+                    it = itemDatas_.insert(std::move(node)).position;
+                } else {
+                    it = itemDatas_.emplace(key, ItemData()).first;
+                }
+            } else if (now - it->second.time_ > MAX_AGE) {
+                // a scan response this late does not belong to the cached advertising
+                it->second.advData_.clear();
+            }
+            it->second.time_ = now;
+            return it->second;
+        }
+
+        // Drop the aged items, return the oldest one if the cache is still full
+        std::unordered_map<uint64_t, ItemData>::iterator Evict(std::chrono::steady_clock::time_point now)
         {
-            for (auto it = itemDatas_.begin(); it != itemDatas_.end(); it++) {
-                if (it->addrType_ == addrType && it->address_ == address) {
-                    return it;
+            auto oldest = itemDatas_.end();
+            for (auto it = itemDatas_.begin(); it != itemDatas_.end();) {
+                if (now - it->second.time_ > MAX_AGE) {
+                    it = itemDatas_.erase(it);
+                    continue;
                 }
+                if (oldest == itemDatas_.end() || it->second.time_ < oldest->second.time_) {
+                    oldest = it;
+                }
+                it++;
+            }
+            return itemDatas_.size() >= MAX_CACHE ? oldest : itemDatas_.end();
+        }
+
+        // Keep max 32 devices address in the cache, a scan response follows its advertising within milliseconds
+        const size_t MAX_CACHE = 32;
+        const std::chrono::milliseconds MAX_AGE = std::chrono::milliseconds(1000);
+        std::unordered_map<uint64_t, ItemData> itemDatas_ {};
+    };
+
+    /// Report buffers, passed from the stack thread to the dispatcher and back instead of allocated per report
+    class BleReportPool {
+    public:
+        BleReportPool()
+        {
+            buffers_.reserve(MAX_POOL);
+        }
+
+        std::vector<uint8_t> Acquire()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (buffers_.empty()) {
+                std::vector<uint8_t> buffer;
+                // room for legacy advertising data and its scan response
+                buffer.reserve(BLE_LEGACY_ADV_DATA_LEN_MAX + BLE_LEGACY_SCAN_RSP_DATA_LEN_MAX);
+                return buffer;
             }
-            return itemDatas_.end();
+            std::vector<uint8_t> buffer = std::move(buffers_.back());
+            buffers_.pop_back();
+            return buffer;
         }
 
-        // Keep max 7 devices address in the cache
-        const size_t MAX_CACHE = 7;
-        std::list<ItemData> itemDatas_ {};
+        void Release(std::vector<uint8_t> &&buffer)
+        {
+            buffer.clear();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (buffers_.size() < MAX_POOL) {
+                buffers_.push_back(std::move(buffer));
+            }
+        }
+
+    private:
+        // More than the dispatcher queue holds, so a flood does not outgrow the pool
+        const size_t MAX_POOL = 136;
+        std::mutex mutex_ {};
+        std::vector<std::vector<uint8_t>> buffers_ {};
     };
 
     BleAdvertisingDataCache advDataCache_ {};
+    BleReportPool reportPool_ {};
+    /// Scan filters of the session, any scanner's filters, matched on the stack thread
+    BleScanFilterMatcher filterMatcher_ {};
+    struct ScannerFilter {
+        std::vector<BleScanFilterImpl> filters_ {};
+        std::unique_ptr<BleScanFilterMatcher> matcher_ = std::make_unique<BleScanFilterMatcher>();
+    };
+    std::mutex scannerFiltersMutex_ {};
+    /// Scanner id <-> its own filters, matched on delivery
+    std::map<int32_t, ScannerFilter> scannerFilters_ {};
 };
 
 BleCentralManagerImpl::BleCentralManagerImpl(
@@ -224,26 +325,52 @@ void BleCentralManagerImpl::AdvertisingReport(
         bool isScanResp = (advType == SCAN_SCAN_RSP);
         bool isStart = isScannable && !isScanResp;
 
-        RawAddress rawAddress(RawAddress::ConvertToString(peerAddr->addr));
-        std::vector<uint8_t> datas(reportParam.data, reportParam.data + reportParam.dataLen);
-        std::vector<uint8_t> const &advData =
-            isStart ? centralManager->pimpl->advDataCache_.SetAdvData(peerAddr->type, rawAddress, std::move(datas))
-                    : centralManager->pimpl->advDataCache_.AppendAdvData(peerAddr->type, rawAddress, std::move(datas));
+        /// Drop unwanted reports before building anything from them.
+        BleScanFilterMatcher &matcher = centralManager->pimpl->filterMatcher_;
+        if (!matcher.MatchAddress(*peerAddr)) {
+            return;
+        }
+        if (!isScannable && !isScanResp &&
+            !matcher.Match(*peerAddr, reportParam.data, reportParam.dataLen, reportParam.rssi)) {
+            return;
+        }
 
-        if (isScannable && !isScanResp) {
+        /// Scannable advertising waits in the cache for its scan response.
+        impl::BleAdvertisingDataCache &cache = centralManager->pimpl->advDataCache_;
+        if (isStart) {
+            cache.SetAdvData(peerAddr->type, peerAddr->addr, reportParam.data, reportParam.dataLen);
             return;
         }
 
-        std::vector<uint8_t> mergeData(advData);
-        centralManager->pimpl->advDataCache_.ClearAdvData(peerAddr->type, rawAddress);
+        const uint8_t *data = reportParam.data;
+        size_t dataLen = reportParam.dataLen;
+        if (isScanResp) {
+            const std::vector<uint8_t> &advData =
+                cache.AppendAdvData(peerAddr->type, peerAddr->addr, reportParam.data, reportParam.dataLen);
+            if (!matcher.Match(*peerAddr, advData.data(), advData.size(), reportParam.rssi)) {
+                cache.ClearAdvData(peerAddr->type, peerAddr->addr);
+                return;
+            }
+            data = advData.data();
+            dataLen = advData.size();
+        }
+
+        std::vector<uint8_t> mergeData = centralManager->pimpl->reportPool_.Acquire();
+        mergeData.assign(data, data + dataLen);
+        if (isScanResp) {
+            cache.ClearAdvData(peerAddr->type, peerAddr->addr);
+        }
 
         BtAddr addr;
         (void)memset_s(&addr, sizeof(addr), 0x00, sizeof(addr));
         addr.type = peerAddr->type;
         (void)memcpy_s(addr.addr, BT_ADDRESS_SIZE, peerAddr->addr, BT_ADDRESS_SIZE);
-        LOG_INFO("AdvertisingReport Data=%{public}s", BleUtils::ConvertIntToHexString(mergeData).c_str());
-        centralManager->dispatcher_->PostTask(std::bind(
-            &BleCentralManagerImpl::AdvertisingReportTask, centralManager, advType, addr, mergeData, reportParam.rssi));
+        LOG_DEBUG("AdvertisingReport dataLen=%{public}zu", mergeData.size());
+        centralManager->dispatcher_->PostTask(
+            [centralManager, advType, addr, rssi = reportParam.rssi, data = std::move(mergeData)]() mutable {
+                centralManager->AdvertisingReportTask(advType, addr, data, rssi);
+                centralManager->pimpl->reportPool_.Release(std::move(data));
+            });
     }
 }
 
@@ -255,25 +382,43 @@ void BleCentralManagerImpl::ExAdvertisingReport(
     auto *pCentralManager = static_cast<BleCentralManagerImpl *>(context);
     if ((pCentralManager != nullptr) && (pCentralManager->dispatcher_)) {
         bool isLegacy = (advType & (1 << BLE_ADV_EVT_LEGACY_BIT));
-        std::vector<uint8_t> mergeData(reportParam.data, reportParam.data + reportParam.dataLen);
-        if (isLegacy) {
-            bool isScannable = (advType & (1 << BLE_LEGACY_ADV_SCAN_IND));
-            bool isScanResp = (advType & (1 << BLE_LEGACY_SCAN_RESPONSE));
-            bool isStart = isScannable && !isScanResp;
-
-            RawAddress rawAddress(RawAddress::ConvertToString(addr->addr));
-            std::vector<uint8_t> datas(reportParam.data, reportParam.data + reportParam.dataLen);
-            std::vector<uint8_t> const &advData =
-                isStart ? pCentralManager->pimpl->advDataCache_.SetAdvData(addr->type, rawAddress, std::move(datas))
-                        : pCentralManager->pimpl->advDataCache_.AppendAdvData(addr->type, rawAddress, std::move(datas));
-
-            if (isScannable && !isScanResp) {
-                LOG_DEBUG("[BleCentralManagerImpl] Waiting for scan response");
+        /// Extended reports may come in fragments, their data is matched once reassembled in the task.
+        BleScanFilterMatcher &matcher = pCentralManager->pimpl->filterMatcher_;
+        if (!matcher.MatchAddress(*addr)) {
+            return;
+        }
+        bool isScannable = isLegacy && (advType & (1 << BLE_LEGACY_ADV_SCAN_IND));
+        bool isScanResp = isLegacy && (advType & (1 << BLE_LEGACY_SCAN_RESPONSE));
+        if (isLegacy && !isScannable && !isScanResp &&
+            !matcher.Match(*addr, reportParam.data, reportParam.dataLen, reportParam.rssi)) {
+            return;
+        }
+
+        /// Scannable legacy advertising waits in the cache for its scan response.
+        impl::BleAdvertisingDataCache &cache = pCentralManager->pimpl->advDataCache_;
+        if (isScannable && !isScanResp) {
+            cache.SetAdvData(addr->type, addr->addr, reportParam.data, reportParam.dataLen);
+            LOG_DEBUG("[BleCentralManagerImpl] Waiting for scan response");
+            return;
+        }
+
+        const uint8_t *data = reportParam.data;
+        size_t dataLen = reportParam.dataLen;
+        if (isScanResp) {
+            const std::vector<uint8_t> &advData =
+                cache.AppendAdvData(addr->type, addr->addr, reportParam.data, reportParam.dataLen);
+            if (!matcher.Match(*addr, advData.data(), advData.size(), reportParam.rssi)) {
+                cache.ClearAdvData(addr->type, addr->addr);
                 return;
             }
+            data = advData.data();
+            dataLen = advData.size();
+        }
 
-            mergeData = advData;
-            pCentralManager->pimpl->advDataCache_.ClearAdvData(addr->type, rawAddress);
+        std::vector<uint8_t> mergeData = pCentralManager->pimpl->reportPool_.Acquire();
+        mergeData.assign(data, data + dataLen);
+        if (isScanResp) {
+            cache.ClearAdvData(addr->type, addr->addr);
         }
 
         BtAddr peerAddr;
@@ -288,133 +433,115 @@ void BleCentralManagerImpl::ExAdvertisingReport(
             peerCurrentAddr = peerAddr;
         }
 
-        LOG_INFO("ExAdvertisingReport Data=%{public}s", BleUtils::ConvertIntToHexString(mergeData).c_str());
-        pCentralManager->dispatcher_->PostTask(std::bind(&BleCentralManagerImpl::ExAdvertisingReportTask,
-            pCentralManager,
-            advType,
-            peerAddr,
-            mergeData,
-            reportParam.rssi,
-            peerCurrentAddr));
+        LOG_DEBUG("ExAdvertisingReport dataLen=%{public}zu", mergeData.size());
+        pCentralManager->dispatcher_->PostTask([pCentralManager, advType, peerAddr, rssi = reportParam.rssi,
+                                                   peerCurrentAddr, data = std::move(mergeData)]() mutable {
+            pCentralManager->ExAdvertisingReportTask(advType, peerAddr, data, rssi, peerCurrentAddr);
+            pCentralManager->pimpl->reportPool_.Release(std::move(data));
+        });
     }
 }
 
 void BleCentralManagerImpl::AdvertisingReportTask(
     uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi) const
 {
-    LOG_DEBUG("[BleCentralManagerImpl] %{public}s:Data = %{public}s", __func__, BleUtils::ConvertIntToHexString(data).c_str());
+    LOG_DEBUG("[BleCentralManagerImpl] %{public}s:dataLen = %{public}zu", __func__, data.size());
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    RawAddress advertisedAddress(RawAddress::ConvertToString(peerAddr.addr));
-    bool ret = false;
-    BlePeripheralDevice device;
-    if (FindDevice(advertisedAddress.GetAddress(), device)) {
-        ret = AddPeripheralDevice(advType, peerAddr, data, rssi, device);
-        if (ret) {  /// LE General Discoverable Mode LE Limited Discoverable Mode
-            return;
-        }
-        HandleGapEvent(BLE_GAP_SCAN_RESULT_EVT, 0);
-        return;
-    }
-
-    ret = AddPeripheralDevice(advType, peerAddr, data, rssi, device);
+    bool ret = AddPeripheralDevice(advType, peerAddr, data, rssi);
     if (ret) {  /// LE General Discoverable Mode LE Limited Discoverable Mode
         return;
     }
     HandleGapEvent(BLE_GAP_SCAN_RESULT_EVT, 0);
 }
 
-bool BleCentralManagerImpl::ExtractIncompleteData(uint8_t advType, const std::string &advertisedAddress,
-    const std::vector<uint8_t> &data, std::vector<uint8_t> &completeData) const
+bool BleCentralManagerImpl::ExtractIncompleteData(uint8_t advType, uint64_t key, std::vector<uint8_t> &data) const
 {
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
     if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) == BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter == pimpl->incompleteData_.end()) {
-            pimpl->incompleteData_.insert(std::make_pair(advertisedAddress, data));
+            pimpl->incompleteData_.emplace(key, data);
         } else {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
         }
         return true;
     } else if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) == 0 &&
                (advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_MORE) == 0) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter != pimpl->incompleteData_.end()) {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
-            completeData = iter->second;
+            data.swap(iter->second);
         }
     } else if ((advType & BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) == BLE_EX_SCAN_DATE_STATUS_INCOMPLETE_NO_MORE) {
-        auto iter = pimpl->incompleteData_.find(advertisedAddress);
+        auto iter = pimpl->incompleteData_.find(key);
         if (iter != pimpl->incompleteData_.end()) {
             iter->second.insert(iter->second.end(), data.begin(), data.end());
-            completeData = iter->second;
+            data.swap(iter->second);
         }
     }
     return false;
 }
 
 void BleCentralManagerImpl::ExAdvertisingReportTask(uint8_t advType, const BtAddr &peerAddr,
-    const std::vector<uint8_t> &data, int8_t rssi, const BtAddr &peerCurrentAddr) const
+    std::vector<uint8_t> &data, int8_t rssi, const BtAddr &peerCurrentAddr) const
 {
-    LOG_DEBUG("[BleCentralManagerImpl] %{public}s:Data = %{public}s", __func__, BleUtils::ConvertIntToHexString(data).c_str());
+    LOG_DEBUG("[BleCentralManagerImpl] %{public}s:dataLen = %{public}zu", __func__, data.size());
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    RawAddress advAddress(RawAddress::ConvertToString(peerAddr.addr));
     /// Set whether only legacy advertisments should be returned in scan results.
     if (pimpl->settings_.GetLegacy()) {
         if ((advType & BLE_LEGACY_ADV_NONCONN_IND_WITH_EX_ADV) == 0) {
-            LOG_DEBUG("[BleCentralManagerImpl] %{public}s: Excepted addr = %{public}s; advType = %{public}d",
-                __func__,
-                advAddress.GetAddress().c_str(),
-                advType);
+            if (LOG_DEBUG_ENABLED()) {
+                LOG_DEBUG("[BleCentralManagerImpl] %{public}s: Excepted addr = %{public}s; advType = %{public}d",
+                    __func__,
+                    RawAddress::ConvertToString(peerAddr.addr).GetAddress().c_str(),
+                    advType);
+            }
             return;
         }
     }
 
     /// incomplete data
-    RawAddress advCurrentAddress(RawAddress::ConvertToString(peerCurrentAddr.addr));
-    LOG_DEBUG("[BleCentralManagerImpl] %{public}s:peerAddr = %{public}s, peerCurrentAddr = %{public}s",
-        __func__,
-        advAddress.GetAddress().c_str(),
-        advCurrentAddress.GetAddress().c_str());
-    std::vector<uint8_t> incompleteData(data.begin(), data.end());
-    if (ExtractIncompleteData(advType, advCurrentAddress.GetAddress(), data, incompleteData)) {
+    if (LOG_DEBUG_ENABLED()) {
+        LOG_DEBUG("[BleCentralManagerImpl] %{public}s:peerAddr = %{public}s, peerCurrentAddr = %{public}s",
+            __func__,
+            RawAddress::ConvertToString(peerAddr.addr).GetAddress().c_str(),
+            RawAddress::ConvertToString(peerCurrentAddr.addr).GetAddress().c_str());
+    }
+    if (ExtractIncompleteData(advType, impl::MakeKey(peerCurrentAddr.addr), data)) {
         return;
     }
-
-    bool ret = false;
-    BlePeripheralDevice device;
-    if (FindDevice(advAddress.GetAddress(), device)) {
-        ret = AddPeripheralDevice(advType, peerAddr, incompleteData, rssi, device);
-        if (ret) {  /// not discovery
-            pimpl->incompleteData_.clear();
-            return;
-        }
-        HandleGapExScanEvent(BLE_GAP_EX_SCAN_RESULT_EVT, 0);
+    if ((advType & (1 << BLE_ADV_EVT_LEGACY_BIT)) == 0 &&
+        !pimpl->filterMatcher_.Match(peerAddr, data.data(), data.size(), rssi)) {
         pimpl->incompleteData_.clear();
         return;
     }
 
-    ret = AddPeripheralDevice(advType, peerAddr, incompleteData, rssi, device);
+    bool ret = AddPeripheralDevice(advType, peerAddr, data, rssi);
+    pimpl->incompleteData_.clear();
     if (ret) {  /// not discovery
-        pimpl->incompleteData_.clear();
         return;
     }
-    pimpl->incompleteData_.clear();
     HandleGapExScanEvent(BLE_GAP_EX_SCAN_RESULT_EVT, 0);
 }
 
-bool BleCentralManagerImpl::AddPeripheralDevice(uint8_t advType, const BtAddr &peerAddr,
-    const std::vector<uint8_t> &data, int8_t rssi, const BlePeripheralDevice &dev) const
+bool BleCentralManagerImpl::AddPeripheralDevice(
+    uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi) const
 {
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    BlePeripheralDevice device = dev;
-    RawAddress advertisedAddress(RawAddress::ConvertToString(peerAddr.addr));
-    device.SetAddress(advertisedAddress);
-    device.SetManufacturerData("");
+    /// The result of a known device is updated in place, reusing its address and buffers.
+    uint64_t key = impl::MakeKey(peerAddr.addr);
+    auto it = pimpl->bleScanResultIndex_.find(key);
+    if (it == pimpl->bleScanResultIndex_.end()) {
+        it = pimpl->bleScanResultIndex_.emplace(key, pimpl->bleScanResult_.size()).first;
+        pimpl->bleScanResult_.emplace_back();
+        pimpl->bleScanResult_.back().GetPeripheralDevice().SetAddress(RawAddress::ConvertToString(peerAddr.addr));
+    }
+    BlePeripheralDevice &device = pimpl->bleScanResult_[it->second].GetPeripheralDevice();
     device.SetRSSI(rssi);
     if (data.size() > 0) {
         BlePeripheralDeviceParseAdvData parseAdvData = {
@@ -422,15 +549,10 @@ bool BleCentralManagerImpl::AddPeripheralDevice(uint8_t advType, const BtAddr &p
             .length = data.size(),
         };
         device.ParseAdvertiserment(parseAdvData);
-        uint8_t falg = device.GetAdFlag();
-        if (CheckBleScanMode(falg)) {
-            return true;
-        }
-    } else {
-        uint8_t falg = device.GetAdFlag();
-        if (CheckBleScanMode(falg)) {
-            return true;
-        }
+    }
+    if (CheckBleScanMode(device.GetAdFlag())) {
+        pimpl->RemoveScanResult(key);
+        return true;
     }
     device.SetAddressType(peerAddr.type);
     if ((advType == SCAN_ADV_SCAN_IND) || (advType == SCAN_ADV_NONCONN_IND)) {
@@ -439,9 +561,10 @@ bool BleCentralManagerImpl::AddPeripheralDevice(uint8_t advType, const BtAddr &p
         device.SetConnectable(true);
     }
 
-    BleScanResultImpl result;
-    result.SetPeripheralDevice(device);
-    pimpl->bleScanResult_.push_back(result);
+    pimpl->lastScanResult_ = it->second;
+    if (pimpl->callBackType_ == CALLBACK_TYPE_ALL_MATCHES) {
+        pimpl->AddReportBatch(key, pimpl->bleScanResult_[it->second]);
+    }
 
     return false;
 }
@@ -608,6 +731,47 @@ void BleCentralManagerImpl::StartScan(const BleScanSettingsImpl &setting) const
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s:<-- Start scan end", __func__);
 }
 
+void BleCentralManagerImpl::ConfigScanFilter(int32_t scannerId, const std::vector<BleScanFilterImpl> &filters) const
+{
+    LOG_DEBUG("[BleCentralManagerImpl] %{public}s: scannerId = %{public}d", __func__, scannerId);
+
+    std::lock_guard<std::mutex> lock(pimpl->scannerFiltersMutex_);
+    impl::ScannerFilter &scanner = pimpl->scannerFilters_[scannerId];
+    scanner.filters_ = filters;
+    scanner.matcher_->Configure(filters);
+    pimpl->ConfigSessionFilter();
+}
+
+void BleCentralManagerImpl::RemoveScanFilter(int32_t scannerId) const
+{
+    LOG_DEBUG("[BleCentralManagerImpl] %{public}s: scannerId = %{public}d", __func__, scannerId);
+
+    std::lock_guard<std::mutex> lock(pimpl->scannerFiltersMutex_);
+    auto it = pimpl->scannerFilters_.find(scannerId);
+    if (it == pimpl->scannerFilters_.end()) {
+        return;
+    }
+    if (!it->second.matcher_->IsEmpty()) {
+        it->second.matcher_->LogStatistics();
+    }
+    pimpl->scannerFilters_.erase(it);
+    pimpl->ConfigSessionFilter();
+}
+
+bool BleCentralManagerImpl::MatchScanFilter(int32_t scannerId, const BlePeripheralDevice &device) const
+{
+    std::lock_guard<std::mutex> lock(pimpl->scannerFiltersMutex_);
+    auto it = pimpl->scannerFilters_.find(scannerId);
+    if (it == pimpl->scannerFilters_.end() || it->second.matcher_->IsEmpty()) {
+        return true;
+    }
+
+    BtAddr addr;
+    addr.type = static_cast<uint8_t>(device.GetAddressType());
+    device.GetRawAddress().ConvertToUint8(addr.addr, BT_ADDRESS_SIZE);
+    return it->second.matcher_->Match(addr, device.GetPayload(), device.GetPayloadLen(), device.GetRSSI());
+}
+
 void BleCentralManagerImpl::StopScan() const
 {
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s:-> Stop scan start", __func__);
@@ -651,6 +815,7 @@ void BleCentralManagerImpl::StartOrStopScan(const STOP_SCAN_TYPE &scanType, bool
             pimpl->scanStatus_ = SCAN_FAILED_ALREADY_STARTED;
         }
         LOG_DEBUG("stop extend scan successful");
+        pimpl->filterMatcher_.LogStatistics();
     }
 }
 
@@ -685,6 +850,9 @@ void BleCentralManagerImpl::ClearResults() const
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
     pimpl->bleScanResult_.clear();
+    pimpl->bleScanResultIndex_.clear();
+    pimpl->reportBatch_.clear();
+    pimpl->reportBatchIndex_.clear();
 }
 
 void BleCentralManagerImpl::SetScanModeDuration(int scanMode, int type) const
@@ -744,7 +912,6 @@ void BleCentralManagerImpl::TimerCallback(void *context)
     if ((centralManager != nullptr) && (centralManager->dispatcher_ != nullptr)) {
         centralManager->dispatcher_->PostTask(
             std::bind(&BleCentralManagerImpl::HandleGapEvent, centralManager, BLE_GAP_SCAN_DELAY_REPORT_RESULT_EVT, 0));
-        centralManager->dispatcher_->PostTask(std::bind(&BleCentralManagerImpl::StopScan, centralManager));
     }
 }
 
@@ -831,8 +998,85 @@ void BleCentralManagerImpl::impl::StartReportDelay()
         if (timer_ == nullptr) {
             timer_ = std::make_unique<utility::Timer>(std::bind(&TimerCallback, bleCentralManagerImpl_));
         }
-        timer_->Start(settings_.GetReportDelayMillisValue());
+        // the scan keeps running, the batch is reported every delay until the scan stops
+        timer_->Start(settings_.GetReportDelayMillisValue(), true);
+    }
+}
+
+void BleCentralManagerImpl::impl::AddReportBatch(uint64_t key, const BleScanResultImpl &result)
+{
+    auto it = reportBatchIndex_.find(key);
+    if (it != reportBatchIndex_.end()) {
+        reportBatch_[it->second] = result;
+        return;
+    }
+    reportBatchIndex_.emplace(key, reportBatch_.size());
+    reportBatch_.push_back(result);
+}
+
+std::vector<BleScanResultImpl> BleCentralManagerImpl::impl::TakeReportBatch()
+{
+    std::vector<BleScanResultImpl> results;
+    results.swap(reportBatch_);
+    reportBatchIndex_.clear();
+    return results;
+}
+
+BleScanResultImpl *BleCentralManagerImpl::impl::FindScanResult(const std::string &address)
+{
+    uint8_t addr[RawAddress::BT_ADDRESS_BYTE_LEN] = {};
+    RawAddress(address).ConvertToUint8(addr);
+    auto it = bleScanResultIndex_.find(MakeKey(addr));
+    if (it == bleScanResultIndex_.end()) {
+        return nullptr;
+    }
+    return &bleScanResult_[it->second];
+}
+
+void BleCentralManagerImpl::impl::RemoveScanResult(uint64_t key)
+{
+    auto it = bleScanResultIndex_.find(key);
+    if (it == bleScanResultIndex_.end()) {
+        return;
+    }
+
+    /// The last result takes the place of the removed one.
+    size_t index = it->second;
+    bleScanResultIndex_.erase(it);
+    if (index + 1 < bleScanResult_.size()) {
+        uint8_t addr[RawAddress::BT_ADDRESS_BYTE_LEN] = {};
+        bleScanResult_.back().GetPeripheralDevice().GetRawAddress().ConvertToUint8(addr);
+        bleScanResultIndex_[MakeKey(addr)] = index;
+        bleScanResult_[index] = std::move(bleScanResult_.back());
+        if (lastScanResult_ == bleScanResult_.size() - 1) {
+            lastScanResult_ = index;
+        }
+    }
+    bleScanResult_.pop_back();
+}
+
+uint64_t BleCentralManagerImpl::impl::MakeKey(const uint8_t *addr, uint8_t type)
+{
+    static const uint8_t byteBits = 8;
+    uint64_t key = type;
+    for (size_t i = 0; i < RawAddress::BT_ADDRESS_BYTE_LEN; i++) {
+        key = (key << byteBits) | addr[i];
     }
+    return key;
+}
+
+void BleCentralManagerImpl::impl::ConfigSessionFilter()
+{
+    std::vector<BleScanFilterImpl> filters;
+    for (auto &scanner : scannerFilters_) {
+        if (scanner.second.filters_.empty()) {
+            /// A scanner without filters wants every report.
+            filters.clear();
+            break;
+        }
+        filters.insert(filters.end(), scanner.second.filters_.begin(), scanner.second.filters_.end());
+    }
+    filterMatcher_.Configure(filters);
 }
 
 bool BleCentralManagerImpl::SetLegacyScanParamToGap() const
@@ -934,6 +1178,11 @@ void BleCentralManagerImpl::Stop() const
         return;
     } else {
         std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
+        if (pimpl->timer_ != nullptr) {
+            pimpl->timer_->Stop();
+        }
+        // report what the last interval collected before the batch mode ends
+        GapScanDelayReportResultEvt();
         pimpl->stopScanType_ = STOP_SCAN_TYPE_NOR;
         pimpl->isStopScan_ = true;
         pimpl->settings_.SetReportDelay(0);
@@ -945,10 +1194,9 @@ int BleCentralManagerImpl::GetDeviceType(const std::string &address) const
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    for (auto value : pimpl->bleScanResult_) {
-        if (!address.compare(value.GetPeripheralDevice().GetRawAddress().GetAddress())) {
-            return value.GetPeripheralDevice().GetDeviceType();
-        }
+    BleScanResultImpl *result = pimpl->FindScanResult(address);
+    if (result != nullptr) {
+        return result->GetPeripheralDevice().GetDeviceType();
     }
     return BLE_BT_DEVICE_TYPE_UNKNOWN;
 }
@@ -958,10 +1206,9 @@ int BleCentralManagerImpl::GetDeviceAddrType(const std::string &address) const
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    for (auto value : pimpl->bleScanResult_) {
-        if (!address.compare(value.GetPeripheralDevice().GetRawAddress().GetAddress())) {
-            return value.GetPeripheralDevice().GetAddressType();
-        }
+    BleScanResultImpl *result = pimpl->FindScanResult(address);
+    if (result != nullptr) {
+        return result->GetPeripheralDevice().GetAddressType();
     }
     return BLE_ADDR_TYPE_UNKNOWN;
 }
@@ -971,28 +1218,13 @@ std::string BleCentralManagerImpl::GetDeviceName(const std::string &address) con
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
 
     std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-    for (auto value : pimpl->bleScanResult_) {
-        if (!address.compare(value.GetPeripheralDevice().GetRawAddress().GetAddress())) {
-            return value.GetPeripheralDevice().GetName();
-        }
+    BleScanResultImpl *result = pimpl->FindScanResult(address);
+    if (result != nullptr) {
+        return result->GetPeripheralDevice().GetName();
     }
     return std::string("");
 }
 
-bool BleCentralManagerImpl::FindDevice(const std::string &address, BlePeripheralDevice &dev) const
-{
-    LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
-
-    for (auto it = pimpl->bleScanResult_.begin(); it != pimpl->bleScanResult_.end(); it++) {
-        if (!address.compare(it->GetPeripheralDevice().GetRawAddress().GetAddress())) {
-            dev = it->GetPeripheralDevice();
-            pimpl->bleScanResult_.erase(it);
-            return true;
-        }
-    }
-    return false;
-}
-
 int BleCentralManagerImpl::GetScanStatus() const
 {
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s", __func__);
@@ -1043,7 +1275,9 @@ void BleCentralManagerImpl::GapScanResultEvt() const
 
     if ((centralManagerCallbacks_ != nullptr) && (pimpl->callBackType_ == CALLBACK_TYPE_FIRST_MATCH)) {
         std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-        centralManagerCallbacks_->OnScanCallback(pimpl->bleScanResult_.back());
+        if (pimpl->lastScanResult_ < pimpl->bleScanResult_.size()) {
+            centralManagerCallbacks_->OnScanCallback(pimpl->bleScanResult_[pimpl->lastScanResult_]);
+        }
     }
 }
 
@@ -1052,11 +1286,11 @@ void BleCentralManagerImpl::GapScanDelayReportResultEvt() const
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s:Scan batch results", __func__);
 
     if ((centralManagerCallbacks_ != nullptr) && (pimpl->callBackType_ == CALLBACK_TYPE_ALL_MATCHES)) {
-        if (pimpl->timer_ != nullptr) {
-            pimpl->timer_->Stop();
-        }
         std::lock_guard<std::recursive_mutex> legacyLock(pimpl->mutex_);
-        centralManagerCallbacks_->OnBleBatchScanResultsEvent(pimpl->bleScanResult_);
+        std::vector<BleScanResultImpl> results = pimpl->TakeReportBatch();
+        if (!results.empty()) {
+            centralManagerCallbacks_->OnBleBatchScanResultsEvent(results);
+        }
     }
 }
 
@@ -1159,7 +1393,9 @@ void BleCentralManagerImpl::GapExScanResultEvt() const
 
     if ((centralManagerCallbacks_ != nullptr) && (pimpl->callBackType_ == CALLBACK_TYPE_FIRST_MATCH)) {
         std::lock_guard<std::recursive_mutex> lk(pimpl->mutex_);
-        centralManagerCallbacks_->OnScanCallback(pimpl->bleScanResult_.back());
+        if (pimpl->lastScanResult_ < pimpl->bleScanResult_.size()) {
+            centralManagerCallbacks_->OnScanCallback(pimpl->bleScanResult_[pimpl->lastScanResult_]);
+        }
     }
 }
 
@@ -1168,11 +1404,11 @@ void BleCentralManagerImpl::GapExScanDelayReportResultEvt() const
     LOG_DEBUG("[BleCentralManagerImpl] %{public}s:Scan batch results", __func__);
 
     if ((centralManagerCallbacks_ != nullptr) && (pimpl->callBackType_ == CALLBACK_TYPE_ALL_MATCHES)) {
-        if (pimpl->timer_ != nullptr) {
-            pimpl->timer_->Stop();
-        }
         std::lock_guard<std::recursive_mutex> exAdvLock(pimpl->mutex_);
-        centralManagerCallbacks_->OnBleBatchScanResultsEvent(pimpl->bleScanResult_);
+        std::vector<BleScanResultImpl> results = pimpl->TakeReportBatch();
+        if (!results.empty()) {
+            centralManagerCallbacks_->OnBleBatchScanResultsEvent(results);
+        }
     }
 }
 
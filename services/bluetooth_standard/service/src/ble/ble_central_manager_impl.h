@@ -16,7 +16,9 @@
 #ifndef BLE_CENTRAL_MANAGER_IMPL_H
 #define BLE_CENTRAL_MANAGER_IMPL_H
 
+#include <chrono>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 #include "ble_defs.h"
@@ -62,6 +64,30 @@ public:
      */
     void StartScan(const BleScanSettingsImpl &setting) const;
 
+    /**
+     * @brief Set the scan filters of a scanner, reports accepted by no scanner are dropped on the stack thread.
+     *
+     * @param [in] scannerId scanner id.
+     * @param [in] filters scan filters, empty to accept every report.
+     */
+    void ConfigScanFilter(int32_t scannerId, const std::vector<BleScanFilterImpl> &filters) const;
+
+    /**
+     * @brief Remove the scan filters of a scanner.
+     *
+     * @param [in] scannerId scanner id.
+     */
+    void RemoveScanFilter(int32_t scannerId) const;
+
+    /**
+     * @brief Match a scan result against the filters of a scanner.
+     *
+     * @param [in] scannerId scanner id.
+     * @param [in] device scanned device.
+     * @return @c true if the scanner has no filters or one of them accepts the device.
+     */
+    bool MatchScanFilter(int32_t scannerId, const BlePeripheralDevice &device) const;
+
     /**
      * @brief Stops Bluetooth LE scan
      */
@@ -179,10 +205,10 @@ private:
 
     void AdvertisingReportTask(
         uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi) const;
-    void ExAdvertisingReportTask(uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi,
+    void ExAdvertisingReportTask(uint8_t advType, const BtAddr &peerAddr, std::vector<uint8_t> &data, int8_t rssi,
         const BtAddr &peerCurrentAddr) const;
-    bool AddPeripheralDevice(uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi,
-        const BlePeripheralDevice &dev) const;
+    bool AddPeripheralDevice(
+        uint8_t advType, const BtAddr &peerAddr, const std::vector<uint8_t> &data, int8_t rssi) const;
     /**
      * @brief set scan parameters callback from gap
      *
@@ -201,14 +227,6 @@ private:
     static void ScanSetEnableResult(uint8_t status, void *context);
     static void ScanExSetEnableResult(uint8_t status, void *context);
 
-    /**
-     * @brief find scan device
-     *
-     * @param [in] device address
-     * @return @c true: finded, otherwise false
-     */
-    bool FindDevice(const std::string &address, BlePeripheralDevice &dev) const;
-
     /**
      * @brief get scan inteval from scan mode
      *
@@ -267,8 +285,7 @@ private:
     static void DirectedAdvertisingReport(uint8_t advType, const BtAddr *addr, GapDirectedAdvReportParam reportParam,
         const BtAddr *currentAddr, void *context);
     static void ScanTimeoutEvent(void *context);
-    bool ExtractIncompleteData(uint8_t advType, const std::string &advertisedAddress, const std::vector<uint8_t> &data,
-        std::vector<uint8_t> &completeData) const;
+    bool ExtractIncompleteData(uint8_t advType, uint64_t key, std::vector<uint8_t> &data) const;
 
     /// scan callback
     IBleCentralManagerCallback *centralManagerCallbacks_ = nullptr;
@@ -0,0 +1,246 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ble_scan_filter.h"
+
+#include "bt_def.h"
+#include "log.h"
+#include "raw_address.h"
+#include "securec.h"
+
+namespace bluetooth {
+namespace {
+// Bluetooth base uuid 00000000-0000-1000-8000-00805F9B34FB in little endian; 16 and 32 bit uuids
+// go into the last four bytes.
+const uint8_t BASE_UUID_LE[Uuid::UUID128_BYTES_TYPE] = {
+    0xFB, 0x34, 0x9B, 0x5F, 0x80, 0x00, 0x00, 0x80, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+const size_t SHORT_UUID_OFFSET = 12;
+const size_t UUID16_LEN = 2;
+const size_t UUID32_LEN = 4;
+const size_t MANUFACTURER_ID_LEN = 2;
+const uint8_t BYTE_SHIFT = 8;
+}  // namespace
+
+void BleScanFilterMatcher::Configure(const std::vector<BleScanFilterImpl> &filters)
+{
+    if (!IsEmpty()) {
+        LogStatistics();
+    }
+
+    std::vector<CompiledFilter> compiled;
+    compiled.reserve(filters.size());
+    for (auto &filter : filters) {
+        CompiledFilter item;
+        if (!filter.GetDeviceId().empty()) {
+            item.hasAddress = true;
+            RawAddress(filter.GetDeviceId()).ConvertToUint8(item.address, BT_ADDRESS_SIZE);
+        }
+        item.name = filter.GetName();
+        if (filter.HasServiceUuid()) {
+            item.hasServiceUuid = true;
+            filter.GetServiceUuid().ConvertToBytesLE(item.serviceUuid, Uuid::UUID128_BYTES_TYPE);
+            if (filter.HasServiceUuidMask()) {
+                filter.GetServiceUuidMask().ConvertToBytesLE(item.serviceUuidMask, Uuid::UUID128_BYTES_TYPE);
+            } else {
+                (void)memset_s(item.serviceUuidMask, sizeof(item.serviceUuidMask), 0xFF, sizeof(item.serviceUuidMask));
+            }
+        }
+        item.serviceData = filter.GetServiceData();
+        item.serviceDataMask = filter.GetServiceDataMask();
+        if (filter.HasManufacturerId()) {
+            item.hasManufacturerId = true;
+            item.manufacturerId = filter.GetManufacturerId();
+            item.manufactureData = filter.GetManufactureData();
+            item.manufactureDataMask = filter.GetManufactureDataMask();
+        }
+        item.rssiThreshold = filter.GetRssiThreshold();
+        compiled.push_back(std::move(item));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    filters_ = std::move(compiled);
+    dropCount_ = 0;
+    filterCount_.store(filters_.size(), std::memory_order_relaxed);
+    LOG_DEBUG("[BleScanFilterMatcher] %{public}s: %{public}zu filters", __func__, filters_.size());
+}
+
+bool BleScanFilterMatcher::MatchAddress(const BtAddr &addr)
+{
+    if (IsEmpty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &filter : filters_) {
+        if (!filter.hasAddress || memcmp(filter.address, addr.addr, BT_ADDRESS_SIZE) == 0) {
+            return true;
+        }
+    }
+    dropCount_++;
+    return false;
+}
+
+bool BleScanFilterMatcher::Match(const BtAddr &addr, const uint8_t *data, size_t len, int8_t rssi)
+{
+    if (IsEmpty()) {
+        return true;
+    }
+
+    AdField fields[MAX_AD_FIELDS];
+    size_t count = 0;
+    bool parsed = false;
+    bool matched = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &filter : filters_) {
+        if (rssi < filter.rssiThreshold) {
+            continue;
+        }
+        if (filter.hasAddress && memcmp(filter.address, addr.addr, BT_ADDRESS_SIZE) != 0) {
+            continue;
+        }
+        if (!parsed) {
+            count = ParseAdFields(data, len, fields);
+            parsed = true;
+        }
+        if (MatchFilter(filter, fields, count)) {
+            filter.matchCount++;
+            matched = true;
+        }
+    }
+    if (!matched) {
+        dropCount_++;
+    }
+    return matched;
+}
+
+void BleScanFilterMatcher::LogStatistics()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < filters_.size(); i++) {
+        LOG_INFO("[BleScanFilterMatcher] filter %{public}zu matched %{public}llu reports",
+            i,
+            static_cast<unsigned long long>(filters_[i].matchCount));
+    }
+    LOG_INFO("[BleScanFilterMatcher] %{public}llu reports dropped", static_cast<unsigned long long>(dropCount_));
+}
+
+size_t BleScanFilterMatcher::ParseAdFields(const uint8_t *data, size_t len, AdField *fields)
+{
+    size_t count = 0;
+    size_t offset = 0;
+    while (offset < len && count < MAX_AD_FIELDS) {
+        size_t fieldLen = data[offset];
+        /// A zero length field ends the significant part, the rest is padding.
+        if (fieldLen == 0 || fieldLen > len - offset - 1) {
+            break;
+        }
+        fields[count].type = data[offset + 1];
+        fields[count].data = data + offset + 2;
+        fields[count].len = fieldLen - 1;
+        count++;
+        offset += fieldLen + 1;
+    }
+    return count;
+}
+
+bool BleScanFilterMatcher::MatchFilter(const CompiledFilter &filter, const AdField *fields, size_t count)
+{
+    bool nameOk = filter.name.empty();
+    bool uuidOk = !filter.hasServiceUuid;
+    bool serviceDataOk = filter.serviceData.empty();
+    bool manufacturerOk = !filter.hasManufacturerId;
+    for (size_t i = 0; i < count; i++) {
+        const AdField &field = fields[i];
+        switch (field.type) {
+            case BLE_AD_TYPE_NAME_SHORT:
+            case BLE_AD_TYPE_NAME_CMPL:
+                nameOk = nameOk || (field.len >= filter.name.size() &&
+                                       memcmp(field.data, filter.name.data(), filter.name.size()) == 0);
+                break;
+            case BLE_AD_TYPE_16SRV_PART:
+            case BLE_AD_TYPE_16SRV_CMPL:
+            case BLE_AD_TYPE_32SRV_PART:
+            case BLE_AD_TYPE_32SRV_CMPL:
+            case BLE_AD_TYPE_128SRV_PART:
+            case BLE_AD_TYPE_128SRV_CMPL:
+                uuidOk = uuidOk || MatchServiceUuid(filter, field);
+                break;
+            case BLE_AD_TYPE_SERVICE_DATA:
+            case BLE_AD_TYPE_32SERVICE_DATA:
+            case BLE_AD_TYPE_128SERVICE_DATA:
+                serviceDataOk =
+                    serviceDataOk || MaskedPrefixEqual(filter.serviceData, filter.serviceDataMask, field.data, field.len);
+                break;
+            case BLE_AD_MANUFACTURER_SPECIFIC_TYPE:
+                if (!manufacturerOk && field.len >= MANUFACTURER_ID_LEN &&
+                    (field.data[0] | (field.data[1] << BYTE_SHIFT)) == filter.manufacturerId) {
+                    manufacturerOk = MaskedPrefixEqual(filter.manufactureData,
+                        filter.manufactureDataMask,
+                        field.data + MANUFACTURER_ID_LEN,
+                        field.len - MANUFACTURER_ID_LEN);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return nameOk && uuidOk && serviceDataOk && manufacturerOk;
+}
+
+bool BleScanFilterMatcher::MatchServiceUuid(const CompiledFilter &filter, const AdField &field)
+{
+    size_t uuidLen = Uuid::UUID128_BYTES_TYPE;
+    if (field.type == BLE_AD_TYPE_16SRV_PART || field.type == BLE_AD_TYPE_16SRV_CMPL) {
+        uuidLen = UUID16_LEN;
+    } else if (field.type == BLE_AD_TYPE_32SRV_PART || field.type == BLE_AD_TYPE_32SRV_CMPL) {
+        uuidLen = UUID32_LEN;
+    }
+
+    for (size_t offset = 0; offset + uuidLen <= field.len; offset += uuidLen) {
+        const uint8_t *uuid = field.data + offset;
+        bool equal = true;
+        for (size_t i = 0; i < Uuid::UUID128_BYTES_TYPE && equal; i++) {
+            uint8_t byte;
+            if (uuidLen == Uuid::UUID128_BYTES_TYPE) {
+                byte = uuid[i];
+            } else if (i >= SHORT_UUID_OFFSET && i < SHORT_UUID_OFFSET + uuidLen) {
+                byte = uuid[i - SHORT_UUID_OFFSET];
+            } else {
+                byte = BASE_UUID_LE[i];
+            }
+            equal = ((byte ^ filter.serviceUuid[i]) & filter.serviceUuidMask[i]) == 0;
+        }
+        if (equal) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BleScanFilterMatcher::MaskedPrefixEqual(
+    const std::vector<uint8_t> &value, const std::vector<uint8_t> &mask, const uint8_t *data, size_t len)
+{
+    if (len < value.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < value.size(); i++) {
+        uint8_t byteMask = (i < mask.size()) ? mask[i] : 0xFF;
+        if (((value[i] ^ data[i]) & byteMask) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace bluetooth
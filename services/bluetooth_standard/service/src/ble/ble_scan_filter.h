@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BLE_SCAN_FILTER_H
+#define BLE_SCAN_FILTER_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "ble_service_data.h"
+#include "btstack.h"
+
+/*
+ * @brief The bluetooth system.
+ */
+namespace bluetooth {
+/**
+ * @brief Scan filter matcher.
+ *
+ * The filters of the scan session are compiled once into byte arrays, reports are then matched on
+ * the raw advertising data on the stack thread, before anything is copied or posted. A report is
+ * accepted when any filter accepts it; an empty filter list accepts every report.
+ */
+class BleScanFilterMatcher {
+public:
+    /**
+     * @brief Replace the filters of the scan session and reset the counters.
+     *
+     * @param [in] filters scan filters.
+     */
+    void Configure(const std::vector<BleScanFilterImpl> &filters);
+
+    /**
+     * @brief Whether no filter is configured.
+     *
+     * @return @c true no filter; @c false otherwise.
+     */
+    bool IsEmpty() const
+    {
+        return filterCount_.load(std::memory_order_relaxed) == 0;
+    }
+
+    /**
+     * @brief Cheap address pre-check, usable before the advertising data is complete.
+     *
+     * @param [in] addr advertiser address.
+     * @return @c false if no filter can accept a report from addr.
+     */
+    bool MatchAddress(const BtAddr &addr);
+
+    /**
+     * @brief Match a complete advertising report and count the result.
+     *
+     * @param [in] addr advertiser address.
+     * @param [in] data advertising data.
+     * @param [in] len advertising data length.
+     * @param [in] rssi report rssi.
+     * @return @c true if any filter accepts the report.
+     */
+    bool Match(const BtAddr &addr, const uint8_t *data, size_t len, int8_t rssi);
+
+    /**
+     * @brief Log the per filter match counters and the drop counter.
+     */
+    void LogStatistics();
+
+private:
+    struct CompiledFilter {
+        bool hasAddress = false;
+        uint8_t address[BT_ADDRESS_SIZE] = {};
+        std::string name {};
+        bool hasServiceUuid = false;
+        uint8_t serviceUuid[Uuid::UUID128_BYTES_TYPE] = {};
+        uint8_t serviceUuidMask[Uuid::UUID128_BYTES_TYPE] = {};
+        std::vector<uint8_t> serviceData {};
+        std::vector<uint8_t> serviceDataMask {};
+        bool hasManufacturerId = false;
+        uint16_t manufacturerId = 0;
+        std::vector<uint8_t> manufactureData {};
+        std::vector<uint8_t> manufactureDataMask {};
+        int8_t rssiThreshold = INT8_MIN;
+        uint64_t matchCount = 0;
+    };
+    struct AdField {
+        uint8_t type;
+        const uint8_t *data;
+        size_t len;
+    };
+    // 1650 bytes of extended advertising data hold at most 825 fields, real payloads use a handful.
+    static const size_t MAX_AD_FIELDS = 32;
+
+    static size_t ParseAdFields(const uint8_t *data, size_t len, AdField *fields);
+    static bool MatchFilter(const CompiledFilter &filter, const AdField *fields, size_t count);
+    static bool MatchServiceUuid(const CompiledFilter &filter, const AdField &field);
+    static bool MaskedPrefixEqual(const std::vector<uint8_t> &value, const std::vector<uint8_t> &mask,
+        const uint8_t *data, size_t len);
+
+    std::mutex mutex_ {};
+    std::atomic<size_t> filterCount_ {0};
+    std::vector<CompiledFilter> filters_ {};
+    uint64_t dropCount_ = 0;
+};
+}  // namespace bluetooth
+
+#endif  // BLE_SCAN_FILTER_H
@@ -80,6 +80,8 @@ const std::string PROPERTY_BLE_MAX_CONNECTION_INTERVAL = "BleMaxConnectionInterv
 const std::string PROPERTY_BLE_CONNECTION_LATENCY = "BleConnectionLatency";
 const std::string PROPERTY_BLE_CONNECTION_SUPERVISION_TIMEOUT = "BleConnectionSupervisionTimeout";
 const std::string PROPERTY_BLE_GATTSERVER_EXCHANGE_MTU = "BleGattServerExchangeMtu";
+const std::string PROPERTY_BLE_EATT_BEARER_NUM = "BleEattBearerNum";
+const std::string PROPERTY_GATT_SERVER_NOTIFY_COALESCE_WINDOW = "GattServerNotifyCoalesceWindow";
 const std::string PROPERTY_CLASSIC_MAX_CONNECTED_DEVICES = "ClassicMaxConnectedDevices";
 const std::string PROPERTY_CLASSIC_CONNECTION_MTU = "ClassicConnectionMtu";
 const std::string PROPERTY_CLASSIC_CONNECTION_MODE = "ClassicConnectionMode";
@@ -14,8 +14,11 @@
  */
 
 #include "gatt_cache.h"
+#include <cstdio>
 #include "bt_def.h"
+#include "gatt_cache_store.h"
 #include "gatt_defines.h"
+#include "securec.h"
 
 namespace bluetooth {
 using Descriptors = std::pair<std::map<uint16_t, GattCache::Descriptor> *, uint16_t>;
@@ -32,6 +35,28 @@ void GattCache::AddService(const Service &service)
 void GattCache::Clear()
 {
     services_.clear();
+    valueHandleMap_.clear();
+    hasDatabaseHash_ = false;
+}
+
+void GattCache::RemoveServices(uint16_t startHandle, uint16_t endHandle)
+{
+    for (auto it = services_.begin(); it != services_.end();) {
+        if (it->second.handle_ <= endHandle && it->second.endHandle_ >= startHandle) {
+            it = services_.erase(it);
+        } else {
+            it++;
+        }
+    }
+
+    for (auto it = valueHandleMap_.begin(); it != valueHandleMap_.end();) {
+        if (services_.find(it->second.first) == services_.end()) {
+            it = valueHandleMap_.erase(it);
+        } else {
+            it++;
+        }
+    }
+    hasDatabaseHash_ = false;
 }
 
 int GattCache::AddIncludeService(uint16_t serviceHandle, const IncludeService &includeService)
@@ -76,6 +101,59 @@ int GattCache::AddDescriptor(uint16_t cccHandle, const Descriptor &descriptor)
     return GattStatus::INVALID_PARAMETER;
 }
 
+int GattCache::AttachIncludeService(const IncludeService &includeService)
+{
+    auto svc = FindOwnerService(includeService.handle_);
+    if (svc == services_.end()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+    return AddIncludeService(svc->first, includeService);
+}
+
+int GattCache::AttachCharacteristic(const Characteristic &characteristic)
+{
+    auto svc = FindOwnerService(characteristic.handle_);
+    if (svc == services_.end()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+    return AddCharacteristic(svc->first, characteristic);
+}
+
+int GattCache::AttachDescriptor(const Descriptor &descriptor)
+{
+    auto svc = FindOwnerService(descriptor.handle_);
+    if (svc == services_.end()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+
+    auto &characteristics = svc->second.characteristics_;
+    auto ccc = characteristics.upper_bound(descriptor.handle_);
+    if (ccc == characteristics.begin()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+    ccc--;
+    // A sweep over several characteristics also returns their declarations and values.
+    if (descriptor.handle_ <= ccc->second.valueHandle_) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+    ccc->second.descriptors_.emplace(descriptor.handle_, descriptor);
+    valueHandleMap_.emplace(descriptor.handle_, std::make_pair(svc->first, ccc->first));
+    return GattStatus::GATT_SUCCESS;
+}
+
+std::map<uint16_t, GattCache::Service>::iterator GattCache::FindOwnerService(uint16_t handle)
+{
+    auto svc = services_.upper_bound(handle);
+    if (svc == services_.begin()) {
+        return services_.end();
+    }
+    svc--;
+    if (svc->second.endHandle_ < handle) {
+        return services_.end();
+    }
+    return svc;
+}
+
 const GattCache::Characteristic *GattCache::GetCharacteristic(int16_t valueHandle)
 {
     auto it = valueHandleMap_.find(valueHandle);
@@ -131,6 +209,30 @@ uint16_t GattCache::GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t
     return svc->second.endHandle_;
 }
 
+uint16_t GattCache::GetCharacteristicValueHandle(const Uuid &uuid) const
+{
+    for (auto &svc : services_) {
+        for (auto &ccc : svc.second.characteristics_) {
+            if (ccc.second.uuid_ == uuid) {
+                return ccc.second.valueHandle_;
+            }
+        }
+    }
+    return INVALID_ATTRIBUTE_HANDLE;
+}
+
+void GattCache::SetDatabaseHash(const uint8_t *hash)
+{
+    if (memcpy_s(databaseHash_, sizeof(databaseHash_), hash, GATT_DATABASE_HASH_SIZE) == EOK) {
+        hasDatabaseHash_ = true;
+    }
+}
+
+const uint8_t *GattCache::GetDatabaseHash() const
+{
+    return hasDatabaseHash_ ? databaseHash_ : nullptr;
+}
+
 std::map<uint16_t, GattCache::Service> &GattCache::GetServices()
 {
     return services_;
@@ -166,6 +268,13 @@ Descriptors GattCache::GetDescriptors(uint16_t cccHandle)
 }
 
 const std::string GattCache::GATT_STORAGE_PRIFIX = "gatt_storage_cache_";
+const std::string GattCache::GATT_STORAGE_FILE = "gatt_storage_cache.db";
+
+GattCacheStore &GattCache::GetStore()
+{
+    static GattCacheStore store(GATT_STORAGE_FILE);
+    return store;
+}
 
 int GattCache::StoredToFile(const GattDevice& address) const
 {
@@ -208,12 +317,32 @@ int GattCache::StoredToFile(const GattDevice& address) const
         }
     }
 
-    return WriteStorageBlobToFile(address, storage);
+    // Same layout the per-device files used: blob count, blobs, then the optional database hash.
+    uint16_t blobSize = storage.size();
+    size_t blobBytes = blobSize * sizeof(StorageBlob);
+    std::vector<uint8_t> payload(sizeof(uint16_t) + blobBytes + (hasDatabaseHash_ ? sizeof(databaseHash_) : 0));
+    (void)memcpy_s(payload.data(), payload.size(), &blobSize, sizeof(uint16_t));
+    if (blobBytes > 0) {
+        (void)memcpy_s(payload.data() + sizeof(uint16_t), blobBytes, storage.data(), blobBytes);
+    }
+    if (hasDatabaseHash_) {
+        (void)memcpy_s(payload.data() + sizeof(uint16_t) + blobBytes,
+            sizeof(databaseHash_), databaseHash_, sizeof(databaseHash_));
+    }
+
+    return GetStore().Store(address, payload.data(), payload.size());
 }
 
 int GattCache::LoadFromFile(const GattDevice& address)
 {
-    std::vector<StorageBlob> storage = ReadStorageBlobFromFile(address);
+    std::vector<StorageBlob> storage;
+    bool found = GetStore().Load(address, [this, &storage](const uint8_t *payload, size_t length) {
+        storage = ParseStorage(payload, length, hasDatabaseHash_, databaseHash_);
+    });
+    if (!found) {
+        std::vector<uint8_t> legacy = ReadLegacyFile(address);
+        storage = ParseStorage(legacy.data(), legacy.size(), hasDatabaseHash_, databaseHash_);
+    }
 
     uint16_t currentSvcHandle = 0;
     uint16_t currentCccHandle = 0;
@@ -244,6 +373,11 @@ int GattCache::LoadFromFile(const GattDevice& address)
         }
     }
 
+    // Move a cache found in a per-device file into the store, then drop the file.
+    if (!found && !storage.empty() && StoredToFile(address) == GattStatus::GATT_SUCCESS) {
+        (void)remove(GenerateGattCacheFileName(address).c_str());
+    }
+
     return GattStatus::GATT_SUCCESS;
 }
 
@@ -253,49 +387,49 @@ std::string GattCache::GenerateGattCacheFileName(const GattDevice &address)
            ((address.transport_ == GATT_TRANSPORT_TYPE_CLASSIC) ? "CLASSIC" : "LE"));
 }
 
-int GattCache::WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const
+std::vector<GattCache::StorageBlob> GattCache::ParseStorage(
+    const uint8_t *payload, size_t length, bool &hasHash, uint8_t *hash)
 {
-    FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "wb");
-    if (fd == nullptr) {
-        return GattStatus::REQUEST_NOT_SUPPORT;
+    hasHash = false;
+    uint16_t blobSize = 0;
+    if (length < sizeof(uint16_t)) {
+        return std::vector<StorageBlob>();
     }
+    (void)memcpy_s(&blobSize, sizeof(uint16_t), payload, sizeof(uint16_t));
 
-    uint16_t blobSize = blob.size();
-    if (fwrite(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
-        fclose(fd);
-        return GattStatus::INTERNAL_ERROR;
+    size_t blobBytes = blobSize * sizeof(StorageBlob);
+    if (length - sizeof(uint16_t) < blobBytes) {
+        return std::vector<StorageBlob>();
     }
-
-    if (fwrite(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
-        return GattStatus::INTERNAL_ERROR;
+    std::vector<StorageBlob> blob(blobSize, {0, {}, {}});
+    if (blobBytes > 0) {
+        (void)memcpy_s(blob.data(), blobBytes, payload + sizeof(uint16_t), blobBytes);
     }
 
-    fclose(fd);
+    // The hash trails the blobs, so caches written before it existed still load, just without a hash.
+    if (length - sizeof(uint16_t) - blobBytes >= GATT_DATABASE_HASH_SIZE) {
+        (void)memcpy_s(hash, GATT_DATABASE_HASH_SIZE, payload + sizeof(uint16_t) + blobBytes, GATT_DATABASE_HASH_SIZE);
+        hasHash = true;
+    }
 
-    return GattStatus::GATT_SUCCESS;
+    return blob;
 }
 
-std::vector<GattCache::StorageBlob> GattCache::ReadStorageBlobFromFile(const GattDevice &address) const
+std::vector<uint8_t> GattCache::ReadLegacyFile(const GattDevice &address)
 {
     FILE* fd = fopen(GenerateGattCacheFileName(address).c_str(), "rb");
     if (fd == nullptr) {
-        return std::vector<StorageBlob>();
+        return std::vector<uint8_t>();
     }
 
-    uint16_t blobSize = 0;
-    if (fread(&blobSize, sizeof(uint16_t), 1, fd) != 1) {
-        fclose(fd);
-        return std::vector<StorageBlob>();
-    }
-
-    std::vector<StorageBlob> blob(blobSize, {0, {}, {}});
-    if (fread(blob.data(), sizeof(StorageBlob), blobSize, fd) != blobSize) {
-        fclose(fd);
-        return std::vector<StorageBlob>();
+    std::vector<uint8_t> content;
+    uint8_t buffer[BUFSIZ];
+    size_t size = 0;
+    while ((size = fread(buffer, 1, sizeof(buffer), fd)) > 0) {
+        content.insert(content.end(), buffer, buffer + size);
     }
 
     fclose(fd);
-    return blob;
+    return content;
 }
 }  // namespace bluetooth
\ No newline at end of file
@@ -23,8 +23,10 @@
 #include "base_def.h"
 #include "bt_uuid.h"
 #include "gatt_data.h"
+#include "gatt_defines.h"
 
 namespace bluetooth {
+class GattCacheStore;
 class GattCache {
 public:
     struct IncludeService {
@@ -89,9 +91,13 @@ public:
     {}
     void Clear();
     void AddService(const Service &service);
+    void RemoveServices(uint16_t startHandle, uint16_t endHandle);
     int AddIncludeService(uint16_t serviceHandle, const IncludeService &includeService);
     int AddCharacteristic(uint16_t serviceHandle, const Characteristic &characteristic);
     int AddDescriptor(uint16_t cccHandle, const Descriptor &descriptor);
+    int AttachIncludeService(const IncludeService &includeService);
+    int AttachCharacteristic(const Characteristic &characteristic);
+    int AttachDescriptor(const Descriptor &descriptor);
     std::map<uint16_t, Service> &GetServices();
     std::vector<IncludeService> *GetIncludeServices(uint16_t serviceHandle);
     std::map<uint16_t, Characteristic> *GetCharacteristics(uint16_t serviceHandle);
@@ -99,6 +105,9 @@ public:
     const GattCache::Characteristic *GetCharacteristic(int16_t valueHandle);
     const GattCache::Descriptor *GetDescriptor(int16_t valueHandle);
     uint16_t GetCharacteristicEndHandle(uint16_t serviceHandle, uint16_t cccHandle) const;
+    uint16_t GetCharacteristicValueHandle(const Uuid &uuid) const;
+    void SetDatabaseHash(const uint8_t *hash);
+    const uint8_t *GetDatabaseHash() const;
 
     int StoredToFile(const GattDevice& address) const;
     int LoadFromFile(const GattDevice& address);
@@ -132,6 +141,7 @@ private:
     };
 
     static const std::string GATT_STORAGE_PRIFIX;
+    static const std::string GATT_STORAGE_FILE;
 
     // service handle <-> struct Service
     std::map<uint16_t, Service> services_ = {};
@@ -139,10 +149,15 @@ private:
     // if value handle belong to descriptor, parent handle is characteristic handle witch descriptor belong to.
     // else parent handle is characteristic handle.
     std::map<uint16_t, std::pair<uint16_t, uint16_t>> valueHandleMap_ = {};
+    // Database Hash of the server the cache was discovered from, persisted together with the cache.
+    bool hasDatabaseHash_ = false;
+    uint8_t databaseHash_[GATT_DATABASE_HASH_SIZE] = {};
 
+    std::map<uint16_t, Service>::iterator FindOwnerService(uint16_t handle);
+    static GattCacheStore &GetStore();
     static std::string GenerateGattCacheFileName(const GattDevice &address);
-    int WriteStorageBlobToFile(const GattDevice& address, std::vector<StorageBlob> &blob) const;
-    std::vector<StorageBlob> ReadStorageBlobFromFile(const GattDevice &address) const;
+    static std::vector<StorageBlob> ParseStorage(const uint8_t *payload, size_t length, bool &hasHash, uint8_t *hash);
+    static std::vector<uint8_t> ReadLegacyFile(const GattDevice &address);
 
     DISALLOW_COPY_AND_ASSIGN(GattCache);
 };
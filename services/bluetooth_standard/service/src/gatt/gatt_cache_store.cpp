@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gatt_cache_store.h"
+#include <array>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "gatt_defines.h"
+#include "log.h"
+#include "securec.h"
+
+namespace bluetooth {
+const uint32_t GattCacheStore::FILE_MAGIC = 0x54534347;    // "GCST"
+const uint16_t GattCacheStore::FILE_VERSION = 0x0001;
+const uint32_t GattCacheStore::RECORD_MAGIC = 0x44524347;  // "GCRD"
+const size_t GattCacheStore::COMPACT_MIN_SIZE = 0x10000;
+
+GattCacheStore::GattCacheStore(const std::string &path) : path_(path)
+{}
+
+GattCacheStore::~GattCacheStore()
+{
+    Close();
+}
+
+/**
+ * @brief Visit the newest cache record of the device.
+ *
+ * @param device Indicates peer device.
+ * @param visitor Indicates the function called with the payload, which points into the mapping.
+ * @return Returns true if the device has a record.
+ */
+bool GattCacheStore::Load(const GattDevice &device, const Visitor &visitor)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+        return false;
+    }
+
+    uint8_t address[RawAddress::BT_ADDRESS_BYTE_LEN] = {};
+    device.addr_.ConvertToUint8(address);
+    auto it = index_.find(MakeKey(address, device.transport_));
+    if (it == index_.end()) {
+        return false;
+    }
+
+    visitor(map_ + it->second.offset_ + sizeof(RecordHeader), it->second.length_);
+    return true;
+}
+
+/**
+ * @brief Append a cache record of the device, unless it equals the newest one.
+ *
+ * @param device Indicates peer device.
+ * @param payload Indicates the serialized cache.
+ * @param length Indicates size of payload.
+ * @return Returns GATT_SUCCESS if the record is durable.
+ */
+int GattCacheStore::Store(const GattDevice &device, const uint8_t *payload, size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+
+    RecordHeader header = {};
+    header.magic_ = RECORD_MAGIC;
+    header.length_ = length;
+    device.addr_.ConvertToUint8(header.address_);
+    header.transport_ = device.transport_;
+    header.checksum_ = Checksum(header, payload, length);
+
+    uint64_t key = MakeKey(header.address_, header.transport_);
+    auto it = index_.find(key);
+    if (it != index_.end() && it->second.length_ == length &&
+        memcmp(map_ + it->second.offset_ + sizeof(RecordHeader), payload, length) == 0) {
+        return GattStatus::GATT_SUCCESS;
+    }
+
+    std::vector<uint8_t> record(sizeof(RecordHeader) + length);
+    if (memcpy_s(record.data(), record.size(), &header, sizeof(RecordHeader)) != EOK ||
+        (length > 0 && memcpy_s(record.data() + sizeof(RecordHeader), length, payload, length) != EOK)) {
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    if (pwrite(fd_, record.data(), record.size(), end_) != (ssize_t)record.size() || fdatasync(fd_) != 0) {
+        LOG_ERROR("%{public}s: append failed", __FUNCTION__);
+        // drop whatever part of the record made it to the file
+        (void)ftruncate(fd_, end_);
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    if (it != index_.end()) {
+        deadBytes_ += sizeof(RecordHeader) + it->second.length_;
+    }
+    index_[key] = {end_, (uint32_t)length};
+    end_ += record.size();
+    if (!Map(end_)) {
+        Close();
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    if (end_ >= COMPACT_MIN_SIZE && deadBytes_ > end_ / 2) {
+        CompactLocked();
+    }
+
+    return GattStatus::GATT_SUCCESS;
+}
+
+/**
+ * @brief Rewrite the store with the newest record of every device only.
+ *
+ * @return Returns GATT_SUCCESS if the store is compacted.
+ */
+int GattCacheStore::Compact()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!Open()) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+    return CompactLocked();
+}
+
+int GattCacheStore::CompactLocked()
+{
+    LOG_INFO("%{public}s: size is %{public}zu, dead is %{public}zu", __FUNCTION__, end_, deadBytes_);
+    std::string tmpPath = path_ + ".tmp";
+    int fd = open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    FileHeader header = {FILE_MAGIC, FILE_VERSION, 0};
+    std::vector<uint8_t> image(sizeof(FileHeader));
+    (void)memcpy_s(image.data(), image.size(), &header, sizeof(FileHeader));
+    for (auto &record : index_) {
+        const uint8_t *begin = map_ + record.second.offset_;
+        image.insert(image.end(), begin, begin + sizeof(RecordHeader) + record.second.length_);
+    }
+
+    bool result = (write(fd, image.data(), image.size()) == (ssize_t)image.size()) && (fsync(fd) == 0);
+    close(fd);
+    // the rename is atomic, a crash leaves either the old store or the compacted one
+    if (!result || rename(tmpPath.c_str(), path_.c_str()) != 0) {
+        LOG_ERROR("%{public}s: rewrite failed", __FUNCTION__);
+        (void)unlink(tmpPath.c_str());
+        return GattStatus::INTERNAL_ERROR;
+    }
+
+    Close();
+    return Open() ? GattStatus::GATT_SUCCESS : GattStatus::INTERNAL_ERROR;
+}
+
+bool GattCacheStore::Open()
+{
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd_ < 0) {
+        LOG_ERROR("%{public}s: open %{public}s failed", __FUNCTION__, path_.c_str());
+        return false;
+    }
+
+    struct stat st = {};
+    if (fstat(fd_, &st) != 0) {
+        Close();
+        return false;
+    }
+
+    FileHeader header = {};
+    if ((size_t)st.st_size < sizeof(FileHeader) || pread(fd_, &header, sizeof(header), 0) != sizeof(header) ||
+        header.magic_ != FILE_MAGIC || header.version_ != FILE_VERSION) {
+        // an unknown or damaged store is only a cache, start over
+        if (!Reset()) {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    if (!Map(st.st_size)) {
+        Close();
+        return false;
+    }
+    Scan();
+
+    if (end_ < mapSize_) {
+        LOG_WARN("%{public}s: drop %{public}zu bytes of torn tail", __FUNCTION__, mapSize_ - end_);
+        if (ftruncate(fd_, end_) != 0 || !Map(end_)) {
+            Close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void GattCacheStore::Close()
+{
+    if (map_ != nullptr) {
+        munmap(map_, mapSize_);
+        map_ = nullptr;
+    }
+    mapSize_ = 0;
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    end_ = 0;
+    deadBytes_ = 0;
+    index_.clear();
+}
+
+bool GattCacheStore::Reset()
+{
+    FileHeader header = {FILE_MAGIC, FILE_VERSION, 0};
+    if (ftruncate(fd_, 0) != 0 || pwrite(fd_, &header, sizeof(header), 0) != sizeof(header) || fdatasync(fd_) != 0) {
+        return false;
+    }
+
+    index_.clear();
+    end_ = sizeof(FileHeader);
+    deadBytes_ = 0;
+    return Map(end_);
+}
+
+bool GattCacheStore::Map(size_t size)
+{
+    if (map_ != nullptr) {
+        munmap(map_, mapSize_);
+        map_ = nullptr;
+        mapSize_ = 0;
+    }
+
+    void *map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        LOG_ERROR("%{public}s: mmap failed", __FUNCTION__);
+        return false;
+    }
+    map_ = static_cast<uint8_t *>(map);
+    mapSize_ = size;
+    return true;
+}
+
+void GattCacheStore::Scan()
+{
+    size_t offset = sizeof(FileHeader);
+    while (offset + sizeof(RecordHeader) <= mapSize_) {
+        RecordHeader header = {};
+        (void)memcpy_s(&header, sizeof(header), map_ + offset, sizeof(RecordHeader));
+        if (header.magic_ != RECORD_MAGIC || header.length_ > mapSize_ - offset - sizeof(RecordHeader) ||
+            header.checksum_ != Checksum(header, map_ + offset + sizeof(RecordHeader), header.length_)) {
+            break;
+        }
+
+        auto it = index_.find(MakeKey(header.address_, header.transport_));
+        if (it != index_.end()) {
+            deadBytes_ += sizeof(RecordHeader) + it->second.length_;
+            it->second = {offset, header.length_};
+        } else {
+            index_.emplace(MakeKey(header.address_, header.transport_), Record {offset, header.length_});
+        }
+        offset += sizeof(RecordHeader) + header.length_;
+    }
+    end_ = offset;
+}
+
+uint64_t GattCacheStore::MakeKey(const uint8_t *address, uint8_t transport)
+{
+    static const uint8_t byteBits = 8;
+    uint64_t key = transport;
+    for (size_t i = 0; i < RawAddress::BT_ADDRESS_BYTE_LEN; i++) {
+        key = (key << byteBits) | address[i];
+    }
+    return key;
+}
+
+uint32_t GattCacheStore::Checksum(const RecordHeader &header, const uint8_t *payload, size_t length)
+{
+    static const uint32_t polynomial = 0xEDB88320;
+    static const uint8_t byteBits = 8;
+    static const uint32_t byteMask = 0xFF;
+    static const std::array<uint32_t, byteMask + 1> table = []() {
+        std::array<uint32_t, byteMask + 1> crcTable = {};
+        for (uint32_t i = 0; i < crcTable.size(); i++) {
+            uint32_t crc = i;
+            for (uint8_t bit = 0; bit < byteBits; bit++) {
+                crc = (crc >> 1) ^ (polynomial & (0 - (crc & 1)));
+            }
+            crcTable[i] = crc;
+        }
+        return crcTable;
+    }();
+    auto update = [](uint32_t crc, const uint8_t *data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            crc = table[(crc ^ data[i]) & byteMask] ^ (crc >> byteBits);
+        }
+        return crc;
+    };
+
+    uint32_t crc = 0xFFFFFFFF;
+    crc = update(crc, reinterpret_cast<const uint8_t *>(&header.length_), sizeof(header.length_));
+    crc = update(crc, header.address_, sizeof(header.address_));
+    crc = update(crc, &header.transport_, sizeof(header.transport_));
+    crc = update(crc, payload, length);
+    return ~crc;
+}
+}  // namespace bluetooth
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GATT_CACHE_STORE_H
+#define GATT_CACHE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "base_def.h"
+#include "gatt_data.h"
+
+namespace bluetooth {
+/**
+ * @brief Single file holding the GATT caches of all peers.
+ *
+ * The file is a versioned header followed by checksummed records, one per update, appended at the end. The newest
+ * record of a device wins. The file is memory mapped and indexed by device on open, so loading a cache is one lookup,
+ * and a torn or truncated tail left by a crash is cut off at the last valid record. Superseded records are dropped by
+ * compaction, which rewrites the live records to a temporary file and renames it over the store.
+ */
+class GattCacheStore {
+public:
+    using Visitor = std::function<void(const uint8_t *payload, size_t length)>;
+
+    explicit GattCacheStore(const std::string &path);
+    ~GattCacheStore();
+
+    bool Load(const GattDevice &device, const Visitor &visitor);
+    int Store(const GattDevice &device, const uint8_t *payload, size_t length);
+    int Compact();
+
+    DISALLOW_COPY_AND_ASSIGN(GattCacheStore);
+
+private:
+    struct FileHeader {
+        uint32_t magic_;
+        uint16_t version_;
+        uint16_t reserved_;
+    };
+
+    struct RecordHeader {
+        uint32_t magic_;
+        uint32_t length_;
+        uint32_t checksum_;
+        uint8_t address_[RawAddress::BT_ADDRESS_BYTE_LEN];
+        uint8_t transport_;
+        uint8_t reserved_;
+    };
+
+    struct Record {
+        size_t offset_ = 0;
+        uint32_t length_ = 0;
+    };
+
+    static const uint32_t FILE_MAGIC;
+    static const uint16_t FILE_VERSION;
+    static const uint32_t RECORD_MAGIC;
+    static const size_t COMPACT_MIN_SIZE;
+
+    std::mutex mutex_ = {};
+    std::string path_;
+    int fd_ = -1;
+    uint8_t *map_ = nullptr;
+    size_t mapSize_ = 0;
+    // end of the last valid record, where the next one is appended
+    size_t end_ = 0;
+    // bytes taken by records a newer record of the same device supersedes
+    size_t deadBytes_ = 0;
+    // device key <-> newest record of the device
+    std::unordered_map<uint64_t, Record> index_ = {};
+
+    bool Open();
+    void Close();
+    bool Reset();
+    bool Map(size_t size);
+    void Scan();
+    int CompactLocked();
+    static uint64_t MakeKey(const uint8_t *address, uint8_t transport);
+    static uint32_t Checksum(const RecordHeader &header, const uint8_t *payload, size_t length);
+};
+}  // namespace bluetooth
+
+#endif  // GATT_CACHE_STORE_H
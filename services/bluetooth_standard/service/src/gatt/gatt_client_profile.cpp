@@ -14,6 +14,7 @@
  */
 
 #include "gatt_client_profile.h"
+#include <algorithm>
 #include "att.h"
 #include "bt_def.h"
 #include "gatt_connection_manager.h"
@@ -25,14 +26,29 @@
 namespace bluetooth {
 struct GattClientProfile::impl {
     class GattConnectionObserverImplement;
+    struct WriteBatch {
+        int reqId_ = 0;
+        std::vector<WriteValueParam> values_ = {};
+        // prepare write requests still waiting for their response
+        size_t pending_ = 0;
+        int result_ = GATT_SUCCESS;
+        // the server rejected prepared writes, the values are written one by one once the queue is cancelled
+        bool fallback_ = false;
+    };
     GattClientProfileCallback *pClientCallBack_ = nullptr;
     int connectionObserverId_ = 0;
     utility::Dispatcher *dispatcher_;
     std::map<uint16_t, GattCache> cacheMap_ = {};
+    std::map<uint16_t, CacheSyncInfo> cacheSync_ = {};
     std::map<uint16_t, MtuInfo> mtuInfo_ = {};
     std::list<std::pair<uint16_t, GattRequestInfo>> requestList_ = {};
     std::list<std::pair<uint16_t, GattRequestInfo>> responseList_ = {};
     std::list<std::pair<uint16_t, ReadValCache>> readValCache_ = {};
+    // connections whose server answered Request Not Supported to Read Multiple Variable Length or Prepare Write
+    std::set<uint16_t> noReadMultipleVariable_ = {};
+    std::set<uint16_t> noPrepareWrite_ = {};
+    // connection handle <-> reliable write of several values in progress
+    std::map<uint16_t, WriteBatch> writeBatches_ = {};
     std::unique_ptr<GattConnectionObserverImplement> connectionCallBack_ = {};
     GattClientProfile *profile_ = nullptr;
     impl(GattClientProfileCallback *pClientCallbackFunc, utility::Dispatcher *dispatcher, GattClientProfile &profile)
@@ -49,7 +65,7 @@ struct GattClientProfile::impl {
     void RegisterCallbackToConnectManager();
     void DeregisterCallbackToConnectManager();
     void ReceiveRequestResultProcess(uint16_t connectHandle);
-    void IndicateRequestRetToService(int reqId, uint16_t connectHandle, ResponesType reqType, uint8_t errorCode);
+    void IndicateRequestRetToService(uint16_t connectHandle, const GattRequestInfo &info, uint8_t errorCode);
     void ReceiveDataProcess(uint16_t connectHandle, uint16_t event, AttEventData *data, Buffer *buffer,
         std::list<std::pair<uint16_t, GattRequestInfo>>::iterator attResp);
     void SetMtuInformation(uint16_t connectHandle, bool isExchanged, uint16_t mtu);
@@ -61,7 +77,8 @@ struct GattClientProfile::impl {
     void ErrorResponseParsing(uint16_t connectHandle, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void ExchangeMtuParsing(
         uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
-    void DiscoverAllPrimaryServiceParsing(int reqId, uint16_t connectHandle, AttEventData *data);
+    void DiscoverAllPrimaryServiceParsing(
+        uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void DiscoverPrimaryServiceByUuidParsing(
         uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void FindIncludeServicesParsing(
@@ -83,6 +100,19 @@ struct GattClientProfile::impl {
         uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void ReadMultipleCharacteristicParsing(
         uint16_t connectHandle, Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void ReadMultipleVariable(int reqId, uint16_t connectHandle, const std::vector<uint16_t> &handles);
+    void ReadMultipleVariableParsing(
+        uint16_t connectHandle, Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void ReadMultipleVariableErrorParsing(uint16_t connectHandle, const AttEventData *data,
+        std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    static std::vector<uint16_t> GetRequestHandles(const GattRequestInfo &info);
+    void WriteMultiple(int reqId, uint16_t connectHandle, const std::vector<WriteValueParam> &values);
+    void WriteMultiplePrepareParsing(uint16_t connectHandle, AttEventData *data, Buffer *buffer,
+        std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void WriteMultipleErrorParsing(uint16_t connectHandle, const AttEventData *data,
+        std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void WriteMultipleExecute(uint16_t connectHandle, WriteBatch &batch);
+    void WriteMultipleComplete(uint16_t connectHandle, int result);
     void ReadCharacteristicDescriptorsParsing(
         uint16_t connectHandle, Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void ReadLongCharacteristicDescriptorsParsing(
@@ -94,9 +124,17 @@ struct GattClientProfile::impl {
     void WriteLongCharacteristicValueParsing(uint16_t connectHandle, uint16_t handle, uint16_t offset, Buffer *buffer,
         std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
     void ExecuteWriteParsing(uint16_t connectHandle, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void ReadDatabaseHashParsing(
+        uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
+    void CheckDatabaseHash(int reqId, uint16_t connectHandle, const std::vector<uint8_t> &hash);
+    void ServiceChangedParsing(uint16_t connectHandle, uint16_t valueHandle, std::vector<uint8_t> value);
+    void InvalidateCacheSync(uint16_t connectHandle);
+    void EnableRobustCaching(uint16_t connectHandle);
+    void ReadServerFeatures(uint16_t connectHandle);
+    void ServerFeaturesParsing(uint16_t connectHandle, Buffer *buffer);
     void NotificationParsing(uint16_t connectHandle, AttEventData *data, Buffer *buffer);
     void IndicationParsing(uint16_t connectHandle, const AttEventData *data, Buffer *buffer);
-    void GattRequestTimeoutParsing(int reqId, uint16_t connectHandle, ResponesType respType);
+    void GattRequestTimeoutParsing(uint16_t connectHandle, const GattRequestInfo &info);
     static int ConvertResponseErrorCode(uint8_t errorCode);
     void SplitReadByTypeRsp(
         uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter);
@@ -162,6 +200,7 @@ GattClientProfile::~GattClientProfile()
 void GattClientProfile::Enable() const
 {
     pimpl->cacheMap_.clear();
+    pimpl->cacheSync_.clear();
     pimpl->requestList_.clear();
     pimpl->responseList_.clear();
     pimpl->mtuInfo_.clear();
@@ -237,7 +276,8 @@ void bluetooth::GattClientProfile::DiscoverAllPrimaryServices(
 {
     LOG_INFO("%{public}s: connectHandle is %hu, Add requestList_: DISCOVER_ALL_PRIMARY_SERVICE.", __FUNCTION__, connectHandle);
     BtUuid primarySvcUuid = {BT_UUID_16, {UUID_PRIMARY_SERVICE}};
-    pimpl->requestList_.emplace_back(connectHandle, GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, reqId));
+    pimpl->requestList_.emplace_back(
+        connectHandle, GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, startHandle, endHandle, reqId));
     ATT_ReadByGroupTypeRequest(connectHandle, startHandle, endHandle, &primarySvcUuid);
 }
 
@@ -263,7 +303,8 @@ void bluetooth::GattClientProfile::DiscoverAllPrimaryServicesInter(
     pimpl->responseList_.erase(iter);
 
     BtUuid primarySvcUuid = {BT_UUID_16, {UUID_PRIMARY_SERVICE}};
-    pimpl->requestList_.emplace_back(connectHandle, GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, reqId));
+    pimpl->requestList_.emplace_back(
+        connectHandle, GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, startHandle, endHandle, reqId));
     ATT_ReadByGroupTypeRequest(connectHandle, startHandle, endHandle, &primarySvcUuid);
 }
 
@@ -311,7 +352,7 @@ void GattClientProfile::DiscoverPrimaryServicesByServiceUuid(int reqId, uint16_t
 }
 /**
  * @brief This sub-procedure is used by a client to find include service declarations within a service definition
- * on a server.
+ * on a server. The range may span several services, each declaration is added to the service holding it.
  *
  * @param reqId Indicates request id.
  * @param connectHandle Indicates identify a connection.
@@ -325,9 +366,9 @@ void GattClientProfile::FindIncludedServices(
     LOG_INFO("%{public}s Parameter startHandle is %hu, endHandle is %hu", __FUNCTION__, startHandle, endHandle);
     BtUuid includeSvcUuid = {BT_UUID_16, {UUID_INCLUDE_SERVICE}};
 
-    auto iter = pimpl->cacheMap_.find(connectHandle)->second.GetIncludeServices(startHandle);
-    if (iter != nullptr) {
-        iter->clear();
+    auto &services = pimpl->cacheMap_.find(connectHandle)->second.GetServices();
+    for (auto it = services.lower_bound(startHandle); it != services.end() && it->first <= endHandle; it++) {
+        it->second.includeServices_.clear();
     }
     pimpl->requestList_.emplace_back(
         connectHandle, GattRequestInfo(FIND_INCLUDE_SERVICE, startHandle, endHandle, reqId));
@@ -336,7 +377,7 @@ void GattClientProfile::FindIncludedServices(
 }
 /**
  * @brief This sub-procedure is used by a client to find all the characteristic declarations within a service
- * definition on a server.
+ * definition on a server. The range may span several services, each declaration is added to the service holding it.
  *
  * @param reqId Indicates request id.
  * @param connectHandle Indicates identify a connection.
@@ -351,9 +392,9 @@ void GattClientProfile::DiscoverAllCharacteristicOfService(
     Uuid tempUuid;
     BtUuid characteristicUuid = {BT_UUID_16, {UUID_CHARACTERISTIC}};
 
-    auto iter = pimpl->cacheMap_.find(connectHandle)->second.GetCharacteristics(startHandle);
-    if (iter != nullptr) {
-        iter->clear();
+    auto &services = pimpl->cacheMap_.find(connectHandle)->second.GetServices();
+    for (auto it = services.lower_bound(startHandle); it != services.end() && it->first <= endHandle; it++) {
+        it->second.characteristics_.clear();
     }
 
     pimpl->requestList_.emplace_back(connectHandle,
@@ -422,7 +463,8 @@ void GattClientProfile::DiscoverCharacteristicByUuid(
 }
 /**
  * @brief This sub-procedure is used by a client to find all the characteristic descriptor’s
- * Attribute Handles and Attribute Types.
+ * Attribute Handles and Attribute Types. The range may span several characteristics, declarations and values found
+ * in between are skipped.
  *
  * @param reqId Indicates request id.
  * @param connectHandle Indicates identify a connection.
@@ -543,6 +585,22 @@ void GattClientProfile::ReadMultipleCharacteristicValue(
         BufferFree(buffer);
     }
 }
+/**
+ * @brief This sub-procedure is used to read several characteristic values of variable length in one
+ * Read Multiple Variable Length request. Each value is reported on its own, servers that do not support the
+ * request are read one value at a time.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @param handles Indicates value handles to read.
+ * @since 6.0
+ */
+void GattClientProfile::ReadMultipleVariableCharacteristicValue(
+    int reqId, uint16_t connectHandle, const std::vector<uint16_t> &handles) const
+{
+    LOG_INFO("%{public}s: connectHandle is %hu, num is %{public}zu.", __FUNCTION__, connectHandle, handles.size());
+    pimpl->ReadMultipleVariable(reqId, connectHandle, handles);
+}
 /**
  * @brief This sub-procedure is used to read a characteristic descriptor from a server.
  *
@@ -770,6 +828,23 @@ void GattClientProfile::ExecuteWriteRequest(int reqId, uint16_t connectHandle, u
     LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
     ATT_ExecuteWriteRequest(connectHandle, flag);
 }
+/**
+ * @brief This sub-procedure is used to write several characteristic values as one reliable write. The Prepare
+ * Write requests of all values are queued at once, each echoed value is verified, and a single Execute Write
+ * commits them, or cancels them all if any failed. Servers that do not support prepared writes get the values
+ * written one at a time.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @param values Indicates value handles and values to write.
+ * @since 6.0
+ */
+void GattClientProfile::WriteMultipleCharacteristicValue(
+    int reqId, uint16_t connectHandle, const std::vector<WriteValueParam> &values) const
+{
+    LOG_INFO("%{public}s: connectHandle is %hu, num is %{public}zu.", __FUNCTION__, connectHandle, values.size());
+    pimpl->WriteMultiple(reqId, connectHandle, values);
+}
 
 /**
  * @brief This sub-procedure is used when a server is configured to indicate a Characteristic Value to a client
@@ -792,6 +867,29 @@ std::map<uint16_t, GattCache::Service> *GattClientProfile::GetServices(uint16_t
     return nullptr;
 }
 
+/**
+ * @brief This sub-procedure is used by the client to obtain the ATT_MTU of a connection.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @return Returns the ATT_MTU, GATT_DEFAULT_MTU until an exchange completed.
+ * @since 6.0
+ */
+uint16_t GattClientProfile::GetMtu(uint16_t connectHandle) const
+{
+    return pimpl->GetMtuInformation(connectHandle).mtu_;
+}
+/**
+ * @brief This sub-procedure is used by the client to check whether the ATT_MTU has been exchanged.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @return Returns true if the client exchanged the ATT_MTU on this connection.
+ * @since 6.0
+ */
+bool GattClientProfile::IsMtuExchanged(uint16_t connectHandle) const
+{
+    return pimpl->GetMtuInformation(connectHandle).isExchanged_;
+}
+
 uint16_t GattClientProfile::GetCharacteristicEndHandle(
     uint16_t connectHandle, uint16_t svcHandle, uint16_t handle) const
 {
@@ -927,8 +1025,11 @@ void GattClientProfile::impl::ReceiveDataProcess(uint16_t connectHandle, uint16_
         case ATT_READ_MULTIPLE_RESPONSE_ID:
             ReadMultipleCharacteristicParsing(connectHandle, buffer, attResp);
             break;
+        case ATT_READ_MULTIPLE_VARIABLE_RESPONSE_ID:
+            ReadMultipleVariableParsing(connectHandle, buffer, attResp);
+            break;
         case ATT_READ_BY_GROUP_TYPE_RESPONSE_ID:
-            DiscoverAllPrimaryServiceParsing(attResp->second.reqId_, connectHandle, data);
+            DiscoverAllPrimaryServiceParsing(connectHandle, data, attResp);
             break;
         case ATT_WRITE_RESPONSE_ID:
             SplitWriteRsp(connectHandle, attResp);
@@ -940,7 +1041,7 @@ void GattClientProfile::impl::ReceiveDataProcess(uint16_t connectHandle, uint16_
             ExecuteWriteParsing(connectHandle, attResp);
             break;
         case ATT_TRANSACTION_TIME_OUT_ID:
-            GattRequestTimeoutParsing(attResp->second.reqId_, connectHandle, attResp->second.reqType_);
+            GattRequestTimeoutParsing(connectHandle, attResp->second);
             break;
         default:
             LOG_ERROR("GATT client profile: %{public}s. It's invalid opcode.", __FUNCTION__);
@@ -976,7 +1077,7 @@ void GattClientProfile::impl::ReceiveRequestResultProcess(uint16_t connectHandle
 {
     auto iter = FindIteratorByRequestInfor(connectHandle);
     if (iter != requestList_.end()) {
-        IndicateRequestRetToService(iter->second.reqType_, connectHandle, iter->second.reqType_, ATT_OUT_OF_RANGE);
+        IndicateRequestRetToService(connectHandle, iter->second, ATT_OUT_OF_RANGE);
         LOG_INFO("%{public}s: RemoveRequestList iter reqType: %{public}d", __FUNCTION__, iter->second.reqType_);
         RemoveRequestList(iter);
     } else {
@@ -987,17 +1088,18 @@ void GattClientProfile::impl::ReceiveRequestResultProcess(uint16_t connectHandle
  * @brief This sub-procedure is used by the client to process indicating request result to service.
  *
  * @param connectHandle Indicates identify a connection.
- * @param reqType Indicates send request type.
+ * @param info Indicates the failed request information.
  * @param errorCode Indicates error code.
  * @since 6.0
  */
 void GattClientProfile::impl::IndicateRequestRetToService(
-    int reqId, uint16_t connectHandle, ResponesType reqType, uint8_t errorCode)
+    uint16_t connectHandle, const GattRequestInfo &info, uint8_t errorCode)
 {
+    int reqId = info.reqId_;
     int ret = ConvertResponseErrorCode(errorCode);
     auto sharedPtr = GattValue(std::make_shared<std::unique_ptr<uint8_t[]>>(nullptr));
 
-    switch (reqType) {
+    switch (info.reqType_) {
         case DISCOVER_ALL_PRIMARY_SERVICE:
             pClientCallBack_->OnDiscoverAllPrimaryServicesEvent(
                 reqId, ret, connectHandle, std::map<uint16_t, GattCache::Service>());
@@ -1044,6 +1146,20 @@ void GattClientProfile::impl::IndicateRequestRetToService(
             pClientCallBack_->OnExchangeMtuEvent(reqId, connectHandle, GATT_DEFAULT_MTU, false);
             break;
         case WRITE_WITHOUT_RESPONSE:
+        case WRITE_CLIENT_SUPPORTED_FEATURES:
+        case READ_SERVER_SUPPORTED_FEATURES:
+            break;
+        case READ_DATABASE_HASH:
+            dispatcher_->PostTask(
+                std::bind(&impl::CheckDatabaseHash, this, reqId, connectHandle, std::vector<uint8_t>()));
+            break;
+        case READ_MULTIPLE_VARIABLE_CHARACTERISTIC:
+            for (auto handle : GetRequestHandles(info)) {
+                pClientCallBack_->OnReadCharacteristicValueEvent(reqId, handle, sharedPtr, 0, ret);
+            }
+            break;
+        case WRITE_MULTIPLE_CHARACTERISTIC_VALUE:
+            WriteMultipleComplete(connectHandle, ret);
             break;
         default:
             LOG_ERROR("%{public}s: request type is not find!", __FUNCTION__);
@@ -1092,11 +1208,10 @@ MtuInfo GattClientProfile::impl::GetMtuInformation(uint16_t connectHandle)
  */
 void GattClientProfile::impl::AddResponseList(void)
 {
-    auto iter = requestList_.begin();
-    if (iter != requestList_.end()) {
-        responseList_.emplace_back(*iter);
+    // moved right away, with several requests in flight the next result must not see this request again
+    if (!requestList_.empty()) {
+        responseList_.splice(responseList_.end(), requestList_, requestList_.begin());
         LOG_INFO("%{public}s: responseList size: %{public}zu", __FUNCTION__, responseList_.size());
-        dispatcher_->PostTask(std::bind(&impl::RemoveRequestList, this, iter));
     }
 }
 /**
@@ -1125,8 +1240,15 @@ void GattClientProfile::impl::ErrorResponseParsing(
     ResponesType type = iter->second.reqType_;
     auto sharedPtr = GattValue(std::make_shared<std::unique_ptr<uint8_t[]>>(nullptr));
 
-    if (data->attErrorResponse.errorCode != ATT_ATTRIBUTE_NOT_FOUND) {
-        IndicateRequestRetToService(reqId, connectHandle, type, data->attErrorResponse.errorCode);
+    if (data->attErrorResponse.errorCode == ATT_DATABASE_OUT_OF_SYNC) {
+        dispatcher_->PostTask(std::bind(&impl::InvalidateCacheSync, this, connectHandle));
+    }
+    if (type == READ_MULTIPLE_VARIABLE_CHARACTERISTIC) {
+        ReadMultipleVariableErrorParsing(connectHandle, data, iter);
+    } else if (type == WRITE_MULTIPLE_CHARACTERISTIC_VALUE) {
+        WriteMultipleErrorParsing(connectHandle, data, iter);
+    } else if (data->attErrorResponse.errorCode != ATT_ATTRIBUTE_NOT_FOUND) {
+        IndicateRequestRetToService(connectHandle, iter->second, data->attErrorResponse.errorCode);
     } else {
         switch (data->attErrorResponse.reqOpcode) {
             case READ_BY_GROUP_TYPE_REQUEST:
@@ -1225,14 +1347,18 @@ void GattClientProfile::impl::ExchangeMtuParsing(
  *
  * @param connectHandle Indicates identify a connection.
  * @param data Indicates att data.
+ * @param iter Indicates iterator of client request information.
  * @since 6.0
 
  */
-void GattClientProfile::impl::DiscoverAllPrimaryServiceParsing(int reqId, uint16_t connectHandle, AttEventData *data)
+void GattClientProfile::impl::DiscoverAllPrimaryServiceParsing(
+    uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
 {
     LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
     BtUuid primarySvcUuid = {BT_UUID_16, {UUID_PRIMARY_SERVICE}};
     auto cache = cacheMap_.find(connectHandle);
+    int reqId = iter->second.reqId_;
+    uint16_t rangeEndHandle = iter->second.endHandle_;
     uint16_t startHandle = 0;
     uint16_t endHandle = 0;
     uint16_t num = data->attReadByGroupTypeResponse.readGroupResponse.num;
@@ -1253,14 +1379,14 @@ void GattClientProfile::impl::DiscoverAllPrimaryServiceParsing(int reqId, uint16
         dispatcher_->PostTask(std::bind(
             &GattCache::AddService, &cache->second, std::move(GattCache::Service(true, startHandle, endHandle, uuid))));
     }
-    if (endHandle == MAX_ATTRIBUTE_HANDLE) {
+    if (num == 0 || endHandle == MAX_ATTRIBUTE_HANDLE || endHandle >= rangeEndHandle) {
         pClientCallBack_->OnDiscoverAllPrimaryServicesEvent(
             reqId, GATT_SUCCESS, connectHandle, cacheMap_.find(connectHandle)->second.GetServices());
         LOG_DEBUG("%{public}s Call OnDiscoverAllPrimaryServicesEvent", __FUNCTION__);
     } else {
-        requestList_.emplace_back(connectHandle, GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, reqId));
-        ATT_ReadByGroupTypeRequest(
-            connectHandle, endHandle + MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE, &primarySvcUuid);
+        requestList_.emplace_back(connectHandle,
+            GattRequestInfo(DISCOVER_ALL_PRIMARY_SERVICE, iter->second.startHandle_, rangeEndHandle, reqId));
+        ATT_ReadByGroupTypeRequest(connectHandle, endHandle + MIN_ATTRIBUTE_HANDLE, rangeEndHandle, &primarySvcUuid);
     }
 }
 /**
@@ -1336,9 +1462,8 @@ void GattClientProfile::impl::FindIncludeServicesParsing(
         uint16_t uuid16Bit =
             SplitDataPackageToUint16(data->attReadByTypeResponse.readHandleListNum.valueList->attributeValue, &offset);
         Uuid svcUuid16Bit = Uuid::ConvertFrom16Bits(uuid16Bit);
-        dispatcher_->PostTask(std::bind(&GattCache::AddIncludeService,
+        dispatcher_->PostTask(std::bind(&GattCache::AttachIncludeService,
             &cache->second,
-            iter->second.startHandle_,
             std::move(GattCache::IncludeService(isvcHandle, startHandle, endHandle, svcUuid16Bit))));
         dispatcher_->PostTask(std::bind(&GattCache::AddService,
             &cache->second,
@@ -1349,9 +1474,8 @@ void GattClientProfile::impl::FindIncludeServicesParsing(
                 FIND_INCLUDE_SERVICE, iter->second.startHandle_, iter->second.endHandle_, ++isvcHandle, reqId));
         ATT_ReadByTypeRequest(connectHandle, isvcHandle, iter->second.endHandle_, &uuid);
     } else {
-        dispatcher_->PostTask(std::bind(&GattCache::AddIncludeService,
+        dispatcher_->PostTask(std::bind(&GattCache::AttachIncludeService,
             &cache->second,
-            iter->second.startHandle_,
             std::move(GattCache::IncludeService(isvcHandle, startHandle, endHandle))));
         dispatcher_->PostTask(std::bind(&GattCache::AddService,
             &cache->second,
@@ -1437,9 +1561,8 @@ void GattClientProfile::impl::DiscoverAllCharacteristicOfServiceParsing(uint16_t
                     std::move(GattCache::Characteristic(startHandle, properties, valueHandle, uuid))));
             }
         } else {
-            dispatcher_->PostTask(std::bind(&GattCache::AddCharacteristic,
+            dispatcher_->PostTask(std::bind(&GattCache::AttachCharacteristic,
                 &cache->second,
-                iter->second.startHandle_,
                 std::move(GattCache::Characteristic(startHandle, properties, valueHandle, uuid))));
         }
     }
@@ -1531,9 +1654,8 @@ void GattClientProfile::impl::DiscoverAllCharacteristicDescriptorsParsing(
             return;
         }
         attHandle = data->attFindInformationResponse.findInforRsponse.handleUuidPairs[i].attHandle;
-        dispatcher_->PostTask(std::bind(&GattCache::AddDescriptor,
+        dispatcher_->PostTask(std::bind(&GattCache::AttachDescriptor,
             &cache->second,
-            iter->second.startHandle_,
             std::move(GattCache::Descriptor(attHandle, uuid))));
     }
     if (attHandle == iter->second.endHandle_) {
@@ -1649,6 +1771,129 @@ void GattClientProfile::impl::ReadMultipleCharacteristicParsing(
     pClientCallBack_->OnReadCharacteristicValueEvent(
         reqId, iter->second.startHandle_, sharedPtr, BufferGetSize(buffer), GATT_SUCCESS);
 }
+/**
+ * @brief This sub-procedure is used by the client to send read multiple variable length requests, each carrying
+ * as many handles as fit into the mtu. A single handle, or a server that does not support the request, is read
+ * with a read request.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @param handles Indicates value handles to read.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadMultipleVariable(
+    int reqId, uint16_t connectHandle, const std::vector<uint16_t> &handles)
+{
+    static const size_t minHandleNum = 2;
+    static const uint8_t byteBits = 8;
+    size_t maxHandleNum = (GetMtuInformation(connectHandle).mtu_ - sizeof(uint8_t)) / sizeof(uint16_t);
+    bool isSupported = (noReadMultipleVariable_.find(connectHandle) == noReadMultipleVariable_.end());
+
+    for (size_t begin = 0; begin < handles.size(); begin += maxHandleNum) {
+        size_t num = std::min(maxHandleNum, handles.size() - begin);
+        if (!isSupported || num < minHandleNum) {
+            for (size_t i = begin; i < begin + num; i++) {
+                requestList_.emplace_back(
+                    connectHandle, GattRequestInfo(READ_CHARACTERISTIC_VALUE, handles[i], reqId));
+                ATT_ReadRequest(connectHandle, handles[i]);
+            }
+            continue;
+        }
+
+        Buffer *buffer = BufferMalloc(num * sizeof(uint16_t));
+        uint8_t *data = (uint8_t *)BufferPtr(buffer);
+        for (size_t i = 0; i < num; i++) {
+            data[i * sizeof(uint16_t)] = handles[begin + i] & 0xFF;
+            data[i * sizeof(uint16_t) + 1] = handles[begin + i] >> byteBits;
+        }
+        requestList_.emplace_back(connectHandle,
+            GattRequestInfo(READ_MULTIPLE_VARIABLE_CHARACTERISTIC,
+                handles[begin],
+                0,
+                BufferGetSize(buffer),
+                GattServiceBase::BuildGattValue(data, BufferGetSize(buffer)),
+                reqId));
+        LOG_DEBUG("%{public}s: Add requestList_: READ_MULTIPLE_VARIABLE_CHARACTERISTIC", __FUNCTION__);
+        ATT_ReadMultipleVariableRequest(connectHandle, buffer);
+        BufferFree(buffer);
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to process read multiple variable length response. A value
+ * truncated by the end of the response is read on its own, the handles behind it are requested again.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param buffer Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadMultipleVariableParsing(
+    uint16_t connectHandle, Buffer *buffer, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
+    static const uint8_t byteBits = 8;
+    int reqId = iter->second.reqId_;
+    std::vector<uint16_t> handles = GetRequestHandles(iter->second);
+    const uint8_t *data = (const uint8_t *)BufferPtr(buffer);
+    size_t size = BufferGetSize(buffer);
+    size_t offset = 0;
+    size_t index = 0;
+    bool isTruncated = false;
+
+    for (; index < handles.size() && offset + sizeof(uint16_t) <= size; index++) {
+        uint16_t length = data[offset] | (data[offset + 1] << byteBits);
+        offset += sizeof(uint16_t);
+        if (length > size - offset) {
+            isTruncated = true;
+            break;
+        }
+        auto sharedPtr = GattServiceBase::BuildGattValue(data + offset, length);
+        pClientCallBack_->OnReadCharacteristicValueEvent(reqId, handles[index], sharedPtr, length, GATT_SUCCESS);
+        offset += length;
+    }
+
+    if (index == handles.size()) {
+        return;
+    }
+    if (isTruncated || index == 0) {
+        // a read request continues with read blob requests if the value is long
+        ReadMultipleVariable(reqId, connectHandle, std::vector<uint16_t>(1, handles[index++]));
+    }
+    ReadMultipleVariable(reqId, connectHandle, std::vector<uint16_t>(handles.begin() + index, handles.end()));
+}
+/**
+ * @brief This sub-procedure is used by the client to process read multiple variable length error respond. The
+ * values are read one by one, so only the attribute in error fails.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param data Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadMultipleVariableErrorParsing(uint16_t connectHandle, const AttEventData *data,
+    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    LOG_INFO("%{public}s: connectHandle is %hu, error is %{public}hhu.",
+        __FUNCTION__, connectHandle, data->attErrorResponse.errorCode);
+    if (data->attErrorResponse.errorCode == ATT_REQUEST_NOT_SUPPORTED) {
+        noReadMultipleVariable_.insert(connectHandle);
+    }
+
+    for (auto handle : GetRequestHandles(iter->second)) {
+        ReadMultipleVariable(iter->second.reqId_, connectHandle, std::vector<uint16_t>(1, handle));
+    }
+}
+
+std::vector<uint16_t> GattClientProfile::impl::GetRequestHandles(const GattRequestInfo &info)
+{
+    static const uint8_t byteBits = 8;
+    std::vector<uint16_t> handles(info.endHandle_ / sizeof(uint16_t));
+    const uint8_t *data = info.data_->get();
+    for (size_t i = 0; i < handles.size(); i++) {
+        handles[i] = data[i * sizeof(uint16_t)] | (data[i * sizeof(uint16_t) + 1] << byteBits);
+    }
+    return handles;
+}
 /**
  * @brief This sub-procedure is used by the client to process read characteristic descriptors.
  *
@@ -1762,6 +2007,9 @@ void GattClientProfile::impl::SplitReadByTypeRsp(
         case READ_USING_CHARACTERISTIC_UUID:
             ReadUsingCharacteristicByUuidParsing(connectHandle, data, iter);
             break;
+        case READ_DATABASE_HASH:
+            ReadDatabaseHashParsing(connectHandle, data, iter);
+            break;
         default:
             LOG_ERROR("data len is %{public}d.", data->attReadByTypeResponse.readHandleListNum.len);
             break;
@@ -1783,6 +2031,8 @@ void GattClientProfile::impl::SplitReadRsp(
         ReadCharacteristicValueParsing(connectHandle, buffer, iter);
     } else if (iter->second.reqType_ == READ_CHARACTERISTIC_DESCRIPTOR) {
         ReadCharacteristicDescriptorsParsing(connectHandle, buffer, iter);
+    } else if (iter->second.reqType_ == READ_SERVER_SUPPORTED_FEATURES) {
+        ServerFeaturesParsing(connectHandle, buffer);
     } else {
         BtUuid uuid = {BT_UUID_16, {UUID_INCLUDE_SERVICE}};
         FindIncludeServicesParsing(connectHandle, iter->second.startHandle_, buffer);
@@ -1853,6 +2103,8 @@ void GattClientProfile::impl::SplitPrepareWriteRsp(uint16_t connectHandle, AttEv
             data->attWriteResponse.prepareWrite.offset,
             buffer,
             iter);
+    } else if (iter->second.reqType_ == WRITE_MULTIPLE_CHARACTERISTIC_VALUE) {
+        WriteMultiplePrepareParsing(connectHandle, data, buffer, iter);
     } else if (iter->second.reqType_ == RELIABLE_WRITE_VALUE) {
         auto sharedPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(buffer), BufferGetSize(buffer));
         pClientCallBack_->OnReliableWriteCharacteristicValueEvent(iter->second.reqId_,
@@ -1897,6 +2149,10 @@ void GattClientProfile::impl::SplitReadByTypeReqErrorParsing(
                 iter->second.startHandle_,
                 *cacheMap_.find(connectHandle)->second.GetIncludeServices(iter->second.startHandle_));
             break;
+        case READ_DATABASE_HASH:
+            dispatcher_->PostTask(std::bind(
+                &impl::CheckDatabaseHash, this, iter->second.reqId_, connectHandle, std::vector<uint8_t>()));
+            break;
         default:
             LOG_ERROR("%{public}s: Response type is %{public}d. It's invalid type.", __FUNCTION__, iter->second.reqType_);
             break;
@@ -1917,6 +2173,9 @@ void GattClientProfile::impl::SplitReadReqErrorParsing(
         case READ_LONG_CHARACTERISTIC_DESCRIPTOR:
             pClientCallBack_->OnReadDescriptorValueEvent(reqId, handle, sharedPtr, 0, result);
             break;
+        case READ_SERVER_SUPPORTED_FEATURES:
+            LOG_INFO("%{public}s: Server Supported Features is not readable, result: %{public}d", __FUNCTION__, result);
+            break;
         default:
             LOG_ERROR("%{public}s: It's invalid type.", __FUNCTION__);
             break;
@@ -1934,6 +2193,9 @@ void GattClientProfile::impl::SplitWriteReqErrorParsing(
         case WRITE_CHARACTERISTIC_DESCRIPTOR:
             pClientCallBack_->OnWriteDescriptorValueEvent(reqId, connectHandle, handle, result);
             break;
+        case WRITE_CLIENT_SUPPORTED_FEATURES:
+            LOG_INFO("%{public}s: Robust caching is not accepted, result: %{public}d", __FUNCTION__, result);
+            break;
         default:
             LOG_ERROR("%{public}s: It's invalid type.", __FUNCTION__);
             break;
@@ -1998,10 +2260,190 @@ void GattClientProfile::impl::ExecuteWriteParsing(
     if (iter->second.reqType_ == WRITE_LONG_CHARACTERISTIC_VALUE) {
         pClientCallBack_->OnWriteLongCharacteristicValueEvent(
             iter->second.reqId_, connectHandle, iter->second.startHandle_, GATT_SUCCESS);
+    } else if (iter->second.reqType_ == WRITE_MULTIPLE_CHARACTERISTIC_VALUE) {
+        auto batch = writeBatches_.find(connectHandle);
+        WriteMultipleComplete(connectHandle, (batch != writeBatches_.end()) ? batch->second.result_ : GATT_SUCCESS);
     } else {
         pClientCallBack_->OnExecuteWriteValueEvent(iter->second.reqId_, connectHandle, GATT_SUCCESS);
     }
 }
+/**
+ * @brief This sub-procedure is used by the client to queue the prepare write requests of a reliable write of
+ * several values. The att layer sends them back to back, no request waits for the previous response to be
+ * processed here.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @param values Indicates value handles and values to write.
+ * @since 6.0
+ */
+void GattClientProfile::impl::WriteMultiple(
+    int reqId, uint16_t connectHandle, const std::vector<WriteValueParam> &values)
+{
+    uint16_t mtu = GetMtuInformation(connectHandle).mtu_;
+    if (noPrepareWrite_.find(connectHandle) != noPrepareWrite_.end()) {
+        for (auto &value : values) {
+            if (value.length_ > static_cast<size_t>(mtu - 0x03)) {
+                pClientCallBack_->OnWriteCharacteristicValueEvent(
+                    reqId, connectHandle, value.handle_, INVALID_ATTRIBUTE_VALUE_LENGTH);
+                continue;
+            }
+            Buffer *buffer = GattServiceBase::BuildBuffer(value.value_->get(), value.length_);
+            if (buffer != nullptr) {
+                requestList_.emplace_back(
+                    connectHandle, GattRequestInfo(WRITE_CHARACTERISTIC_VALUE, value.handle_, reqId));
+                ATT_WriteRequest(connectHandle, value.handle_, buffer);
+                BufferFree(buffer);
+            }
+        }
+        return;
+    }
+
+    if (writeBatches_.find(connectHandle) != writeBatches_.end()) {
+        // the values would be mixed into the prepare queue of the reliable write in progress
+        for (auto &value : values) {
+            pClientCallBack_->OnWriteCharacteristicValueEvent(reqId, connectHandle, value.handle_, REMOTE_DEVICE_BUSY);
+        }
+        return;
+    }
+
+    WriteBatch &batch = writeBatches_[connectHandle];
+    batch.reqId_ = reqId;
+    batch.values_ = values;
+    uint16_t bufSize = mtu - 0x05;
+    for (auto &value : values) {
+        uint16_t offset = 0;
+        do {
+            uint16_t len = std::min(value.length_ - offset, static_cast<size_t>(bufSize));
+            Buffer *buffer = GattServiceBase::BuildBuffer(value.value_->get(), offset, len);
+            if (buffer == nullptr) {
+                batch.result_ = INTERNAL_ERROR;
+                break;
+            }
+            AttReadBlobReqPrepareWriteValue attReadBlobObj = {value.handle_, offset};
+            requestList_.emplace_back(connectHandle,
+                GattRequestInfo(WRITE_MULTIPLE_CHARACTERISTIC_VALUE, value.handle_, offset, len, value.value_, reqId));
+            ATT_PrepareWriteRequest(connectHandle, attReadBlobObj, buffer);
+            BufferFree(buffer);
+            batch.pending_++;
+            offset += len;
+        } while (offset < value.length_);
+    }
+    LOG_DEBUG("%{public}s: Add requestList_: WRITE_MULTIPLE_CHARACTERISTIC_VALUE * %{public}zu",
+        __FUNCTION__, batch.pending_);
+
+    if (batch.pending_ == 0) {
+        WriteMultipleComplete(connectHandle, batch.result_);
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to process prepare write response of a reliable write of
+ * several values.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param data Indicates att event data.
+ * @param buffer Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::WriteMultiplePrepareParsing(uint16_t connectHandle, AttEventData *data, Buffer *buffer,
+    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    auto batch = writeBatches_.find(connectHandle);
+    if (batch == writeBatches_.end()) {
+        return;
+    }
+
+    // the server echoes what it queued, anything else must not be committed
+    const GattRequestInfo &info = iter->second;
+    if (data->attWriteResponse.prepareWrite.handleValue.attHandle != info.startHandle_ ||
+        data->attWriteResponse.prepareWrite.offset != info.valHandle_ || BufferGetSize(buffer) != info.endHandle_ ||
+        memcmp(BufferPtr(buffer), info.data_->get() + info.valHandle_, info.endHandle_) != 0) {
+        LOG_ERROR("%{public}s: handle %{public}hu offset %{public}hu is not echoed", __FUNCTION__,
+            info.startHandle_, info.valHandle_);
+        batch->second.result_ = GATT_FAILURE;
+    }
+
+    if (--batch->second.pending_ == 0) {
+        WriteMultipleExecute(connectHandle, batch->second);
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to process error respond to a prepare or execute write request
+ * of a reliable write of several values.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param data Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::WriteMultipleErrorParsing(uint16_t connectHandle, const AttEventData *data,
+    std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    LOG_INFO("%{public}s: connectHandle is %hu, error is %{public}hhu.",
+        __FUNCTION__, connectHandle, data->attErrorResponse.errorCode);
+    auto batch = writeBatches_.find(connectHandle);
+    if (batch == writeBatches_.end()) {
+        return;
+    }
+
+    int result = ConvertResponseErrorCode(data->attErrorResponse.errorCode);
+    if (data->attErrorResponse.reqOpcode == EXECUTE_WRITE_REQUEST || batch->second.pending_ == 0) {
+        WriteMultipleComplete(connectHandle, result);
+        return;
+    }
+
+    if (data->attErrorResponse.errorCode == ATT_REQUEST_NOT_SUPPORTED) {
+        noPrepareWrite_.insert(connectHandle);
+        batch->second.fallback_ = true;
+    } else if (batch->second.result_ == GATT_SUCCESS) {
+        batch->second.result_ = result;
+    }
+
+    if (--batch->second.pending_ == 0) {
+        WriteMultipleExecute(connectHandle, batch->second);
+    }
+}
+/**
+ * @brief This sub-procedure is used by the client to commit the prepared values once all were queued, or to
+ * cancel them if any failed.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param batch Indicates the reliable write in progress.
+ * @since 6.0
+ */
+void GattClientProfile::impl::WriteMultipleExecute(uint16_t connectHandle, WriteBatch &batch)
+{
+    uint8_t flag = (batch.result_ == GATT_SUCCESS && !batch.fallback_) ? 0x01 : 0x00;
+    LOG_INFO("%{public}s: connectHandle is %hu, flag is %{public}hhu.", __FUNCTION__, connectHandle, flag);
+    requestList_.emplace_back(connectHandle, GattRequestInfo(WRITE_MULTIPLE_CHARACTERISTIC_VALUE, batch.reqId_));
+    ATT_ExecuteWriteRequest(connectHandle, flag);
+}
+/**
+ * @brief This sub-procedure is used by the client to report a reliable write of several values, or to write the
+ * values one by one if the server does not support prepared writes.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param result Indicates result of the write.
+ * @since 6.0
+ */
+void GattClientProfile::impl::WriteMultipleComplete(uint16_t connectHandle, int result)
+{
+    auto it = writeBatches_.find(connectHandle);
+    if (it == writeBatches_.end()) {
+        return;
+    }
+    WriteBatch batch = std::move(it->second);
+    writeBatches_.erase(it);
+
+    if (batch.fallback_) {
+        WriteMultiple(batch.reqId_, connectHandle, batch.values_);
+        return;
+    }
+    for (auto &value : batch.values_) {
+        pClientCallBack_->OnWriteCharacteristicValueEvent(batch.reqId_, connectHandle, value.handle_, result);
+    }
+}
 /**
  * @brief This sub-procedure is used by the client to process notification.
  *
@@ -2029,19 +2471,237 @@ void GattClientProfile::impl::IndicationParsing(uint16_t connectHandle, const At
 {
     LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
     auto sharedPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(buffer), BufferGetSize(buffer));
+    if (BufferGetSize(buffer) == sizeof(uint16_t) + sizeof(uint16_t)) {
+        const uint8_t *value = (uint8_t *)BufferPtr(buffer);
+        dispatcher_->PostTask(std::bind(&impl::ServiceChangedParsing,
+            this,
+            connectHandle,
+            data->attIndication.attHandle,
+            std::vector<uint8_t>(value, value + BufferGetSize(buffer))));
+    }
     pClientCallBack_->OnCharacteristicNotifyEvent(
         connectHandle, data->attIndication.attHandle, sharedPtr, BufferGetSize(buffer), true);
 }
+/**
+ * @brief This sub-procedure is used by the client to process read database hash.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param data Indicates att data.
+ * @param iter Indicates iterator of client request information.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadDatabaseHashParsing(
+    uint16_t connectHandle, AttEventData *data, std::list<std::pair<uint16_t, GattRequestInfo>>::iterator iter)
+{
+    LOG_INFO("%{public}s: connectHandle is %hu.", __FUNCTION__, connectHandle);
+    std::vector<uint8_t> hash;
+    if (data->attReadByTypeResponse.readHandleListNum.valueNum != 0 &&
+        data->attReadByTypeResponse.readHandleListNum.len == sizeof(uint16_t) + GATT_DATABASE_HASH_SIZE) {
+        uint8_t *value = data->attReadByTypeResponse.readHandleListNum.valueList->attributeValue;
+        hash.assign(value, value + GATT_DATABASE_HASH_SIZE);
+    }
+    dispatcher_->PostTask(std::bind(&impl::CheckDatabaseHash, this, iter->second.reqId_, connectHandle, hash));
+}
+/**
+ * @brief Compare the Database Hash of the server with the cached one.
+ *
+ * A matching hash makes the cache usable as is. Otherwise only the range reported by Service Changed is dropped
+ * when the rest of the cache is known to be good, and the whole cache in any other case.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @param hash Indicates database hash of the server, empty if the server has none.
+ * @since 6.0
+ */
+void GattClientProfile::impl::CheckDatabaseHash(int reqId, uint16_t connectHandle, const std::vector<uint8_t> &hash)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    auto sync = cacheSync_.find(connectHandle);
+    if (cache == cacheMap_.end() || sync == cacheSync_.end()) {
+        LOG_ERROR("%{public}s: Device cache does not exist", __FUNCTION__);
+        return;
+    }
+
+    CacheSyncInfo &info = sync->second;
+    const uint8_t *cachedHash = cache->second.GetDatabaseHash();
+    if (!hash.empty() && cachedHash != nullptr && !cache->second.GetServices().empty() &&
+        memcmp(cachedHash, hash.data(), GATT_DATABASE_HASH_SIZE) == 0) {
+        LOG_INFO("%{public}s: Database Hash matches, connectHandle is %{public}hu.", __FUNCTION__, connectHandle);
+        info.isInSync_ = true;
+        info.isChanged_ = false;
+        info.isRediscovering_ = false;
+        EnableRobustCaching(connectHandle);
+        ReadServerFeatures(connectHandle);
+        pClientCallBack_->OnReadDatabaseHashEvent(reqId, connectHandle, true, 0, 0);
+        return;
+    }
+
+    uint16_t startHandle = MIN_ATTRIBUTE_HANDLE;
+    uint16_t endHandle = MAX_ATTRIBUTE_HANDLE;
+    if (info.isChanged_) {
+        startHandle = info.changedStartHandle_;
+        endHandle = info.changedEndHandle_;
+        cache->second.RemoveServices(startHandle, endHandle);
+    } else {
+        cache->second.Clear();
+    }
+    info.isInSync_ = false;
+    info.isRediscovering_ = true;
+    info.hasPendingHash_ =
+        !hash.empty() && memcpy_s(info.pendingHash_, sizeof(info.pendingHash_), hash.data(), hash.size()) == EOK;
+    LOG_INFO("%{public}s: connectHandle is %{public}hu, rediscover 0x%{public}04x-0x%{public}04x.",
+        __FUNCTION__, connectHandle, startHandle, endHandle);
+    pClientCallBack_->OnReadDatabaseHashEvent(reqId, connectHandle, false, startHandle, endHandle);
+}
+/**
+ * @brief Record the handle range of a Service Changed indication, it is rediscovered on the next discovery.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param valueHandle Indicates attribute handle of the indication.
+ * @param value Indicates indication value.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ServiceChangedParsing(
+    uint16_t connectHandle, uint16_t valueHandle, std::vector<uint8_t> value)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    auto sync = cacheSync_.find(connectHandle);
+    if (cache == cacheMap_.end() || sync == cacheSync_.end()) {
+        return;
+    }
+
+    CacheSyncInfo &info = sync->second;
+    auto ccc = cache->second.GetCharacteristic(valueHandle);
+    if (ccc == nullptr) {
+        // Unknown handle while the cache is being built, it may be a Service Changed the discovery raced with.
+        info.isRediscovering_ = false;
+        return;
+    }
+    if (ccc->uuid_ != Uuid::ConvertFrom16Bits(UUID_SERVICE_CHANGED)) {
+        return;
+    }
+
+    uint8_t offset = 0;
+    uint16_t startHandle = SplitDataPackageToUint16(value.data(), &offset);
+    uint16_t endHandle = SplitDataPackageToUint16(value.data(), &offset);
+    if (info.isChanged_) {
+        info.changedStartHandle_ = std::min(info.changedStartHandle_, startHandle);
+        info.changedEndHandle_ = std::max(info.changedEndHandle_, endHandle);
+    } else if (info.isInSync_) {
+        info.isChanged_ = true;
+        info.changedStartHandle_ = startHandle;
+        info.changedEndHandle_ = endHandle;
+    }
+    info.isInSync_ = false;
+    info.isRediscovering_ = false;
+    info.hasPendingHash_ = false;
+    LOG_INFO("%{public}s: connectHandle is %{public}hu, changed 0x%{public}04x-0x%{public}04x.",
+        __FUNCTION__, connectHandle, startHandle, endHandle);
+}
+/**
+ * @brief The server reported the client as change-unaware, nothing in the cache can be trusted any more.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::impl::InvalidateCacheSync(uint16_t connectHandle)
+{
+    auto sync = cacheSync_.find(connectHandle);
+    if (sync != cacheSync_.end()) {
+        LOG_INFO("%{public}s: connectHandle is %{public}hu.", __FUNCTION__, connectHandle);
+        sync->second.isInSync_ = false;
+        sync->second.isChanged_ = false;
+        sync->second.isRediscovering_ = false;
+        sync->second.hasPendingHash_ = false;
+    }
+}
+/**
+ * @brief Enable robust caching once per connection, so the server reports a changed database with
+ * Database Out Of Sync instead of serving a change-unaware client.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::impl::EnableRobustCaching(uint16_t connectHandle)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    auto sync = cacheSync_.find(connectHandle);
+    if (cache == cacheMap_.end() || sync == cacheSync_.end() || sync->second.isRobustCachingEnabled_) {
+        return;
+    }
+
+    uint16_t handle =
+        cache->second.GetCharacteristicValueHandle(Uuid::ConvertFrom16Bits(UUID_CLIENT_SUPPORTED_FEATURES));
+    if (handle == INVALID_ATTRIBUTE_HANDLE) {
+        return;
+    }
+    uint8_t features = GATT_CLIENT_FEATURE_ROBUST_CACHING;
+    Buffer *buffer = GattServiceBase::BuildBuffer(&features, sizeof(features));
+    if (buffer != nullptr) {
+        sync->second.isRobustCachingEnabled_ = true;
+        requestList_.emplace_back(connectHandle, GattRequestInfo(WRITE_CLIENT_SUPPORTED_FEATURES, handle, 0));
+        LOG_DEBUG("%{public}s: Add requestList_: WRITE_CLIENT_SUPPORTED_FEATURES", __FUNCTION__);
+        ATT_WriteRequest(connectHandle, handle, buffer);
+        BufferFree(buffer);
+    }
+}
+/**
+ * @brief Read Server Supported Features once per connection, enhanced ATT bearers are only opened to a server
+ * that reports EATT support, over an encrypted LE link this device initiated.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ReadServerFeatures(uint16_t connectHandle)
+{
+    auto cache = cacheMap_.find(connectHandle);
+    auto sync = cacheSync_.find(connectHandle);
+    if (cache == cacheMap_.end() || sync == cacheSync_.end() || sync->second.isServerFeaturesRead_ ||
+        GattConnectionManager::GetInstance().GetEattBearerNum(connectHandle) == 0) {
+        return;
+    }
+
+    uint16_t handle =
+        cache->second.GetCharacteristicValueHandle(Uuid::ConvertFrom16Bits(UUID_SERVER_SUPPORTED_FEATURES));
+    if (handle == INVALID_ATTRIBUTE_HANDLE) {
+        return;
+    }
+    sync->second.isServerFeaturesRead_ = true;
+    requestList_.emplace_back(connectHandle, GattRequestInfo(READ_SERVER_SUPPORTED_FEATURES, handle, 0));
+    LOG_DEBUG("%{public}s: Add requestList_: READ_SERVER_SUPPORTED_FEATURES", __FUNCTION__);
+    ATT_ReadRequest(connectHandle, handle);
+}
+/**
+ * @brief Open the enhanced ATT bearers if the server supports EATT.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param buffer Indicates the Server Supported Features value.
+ * @since 6.0
+ */
+void GattClientProfile::impl::ServerFeaturesParsing(uint16_t connectHandle, Buffer *buffer)
+{
+    if (buffer == nullptr || BufferGetSize(buffer) == 0 ||
+        (*static_cast<uint8_t *>(BufferPtr(buffer)) & GATT_SERVER_FEATURE_EATT) == 0) {
+        LOG_INFO("%{public}s: EATT is not supported, connectHandle is %{public}hu.", __FUNCTION__, connectHandle);
+        return;
+    }
+
+    uint8_t bearerNum = GattConnectionManager::GetInstance().GetEattBearerNum(connectHandle);
+    if (bearerNum > 0) {
+        ATT_LeEattConnectRequest(connectHandle, bearerNum);
+    }
+}
 /**
  * @brief This sub-procedure is used by processing request timeout.
  *
  * @param connectHandle Indicates identify a connection.
- * @param reqType Indicates send request type.
+ * @param connectHandle Indicates identify a connection.
+ * @param info Indicates the timed out request information.
  * @since 6.0
  */
-void GattClientProfile::impl::GattRequestTimeoutParsing(int reqId, uint16_t connectHandle, ResponesType respType)
+void GattClientProfile::impl::GattRequestTimeoutParsing(uint16_t connectHandle, const GattRequestInfo &info)
 {
-    IndicateRequestRetToService(reqId, connectHandle, respType, ATT_OUT_OF_RANGE);
+    IndicateRequestRetToService(connectHandle, info, ATT_OUT_OF_RANGE);
 }
 /**
  * @brief Convert the att error code to the service layer error code.
@@ -2200,6 +2860,7 @@ std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::imp
         case ATT_WRITE_RESPONSE_ID:
         case ATT_PREPARE_WRITE_RESPONSE_ID:
         case ATT_EXECUTE_WRITE_RESPONSE_ID:
+        case ATT_READ_MULTIPLE_VARIABLE_RESPONSE_ID:
         default:
             for (iter = responseList_.begin(); iter != responseList_.end(); iter++) {
                 if (handle == iter->first) {
@@ -2247,6 +2908,7 @@ std::list<std::pair<uint16_t, GattRequestInfo>>::iterator GattClientProfile::imp
  */
 void GattClientProfile::impl::CreateCache(uint16_t connectHandle, const GattDevice device)
 {
+    cacheSync_[connectHandle] = CacheSyncInfo();
     auto cache = cacheMap_.emplace(connectHandle, std::move(GattCache()));
     if (device.isEncryption_ == true) {
         cache.first->second.LoadFromFile(device);
@@ -2261,6 +2923,7 @@ void GattClientProfile::impl::CreateCache(uint16_t connectHandle, const GattDevi
  */
 void GattClientProfile::impl::DeleteCache(uint16_t connectHandle, const GattDevice device)
 {
+    cacheSync_.erase(connectHandle);
     auto cache = cacheMap_.find(connectHandle);
     if (cache != cacheMap_.end()) {
         if (device.isEncryption_ == true) {
@@ -2288,6 +2951,56 @@ void GattClientProfile::ClearCacheMap(uint16_t connectHandle) const
         LOG_ERROR("%{public}s:  Device cache does not exist", __FUNCTION__);
     }
 }
+/**
+ * @brief This sub-procedure is used by the client to read the Database Hash of the server, the result decides
+ * whether the cache can be used as is or which handle range has to be rediscovered.
+ *
+ * @param reqId Indicates request id.
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::ReadDatabaseHash(int reqId, uint16_t connectHandle) const
+{
+    LOG_INFO("%{public}s: connectHandle is %{public}hu.", __FUNCTION__, connectHandle);
+    BtUuid hashUuid = {BT_UUID_16, {UUID_DATABASE_HASH}};
+    pimpl->requestList_.emplace_back(connectHandle, GattRequestInfo(READ_DATABASE_HASH, reqId));
+    ATT_ReadByTypeRequest(connectHandle, MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE, &hashUuid);
+}
+/**
+ * @brief Whether the cache is complete and matches the server database on this connection.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+bool GattClientProfile::IsCacheInSync(uint16_t connectHandle) const
+{
+    auto sync = pimpl->cacheSync_.find(connectHandle);
+    return (sync != pimpl->cacheSync_.end() && sync->second.isInSync_);
+}
+/**
+ * @brief Mark the cache in sync after a successful rediscovery and keep the Database Hash read before it.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @since 6.0
+ */
+void GattClientProfile::CommitCache(uint16_t connectHandle) const
+{
+    auto cache = pimpl->cacheMap_.find(connectHandle);
+    auto sync = pimpl->cacheSync_.find(connectHandle);
+    if (cache == pimpl->cacheMap_.end() || sync == pimpl->cacheSync_.end() || !sync->second.isRediscovering_) {
+        return;
+    }
+
+    if (sync->second.hasPendingHash_) {
+        cache->second.SetDatabaseHash(sync->second.pendingHash_);
+        sync->second.hasPendingHash_ = false;
+    }
+    sync->second.isRediscovering_ = false;
+    sync->second.isInSync_ = true;
+    sync->second.isChanged_ = false;
+    pimpl->EnableRobustCaching(connectHandle);
+    pimpl->ReadServerFeatures(connectHandle);
+}
 /**
  * @brief Add data to ReadValueCache.
  *
@@ -2366,6 +3079,10 @@ void GattClientProfile::impl::DeleteList(uint16_t connectHandle)
             respList++;
         }
     }
+
+    noReadMultipleVariable_.erase(connectHandle);
+    noPrepareWrite_.erase(connectHandle);
+    writeBatches_.erase(connectHandle);
 }
 /**
  * @brief Indicates connect or disconnect.
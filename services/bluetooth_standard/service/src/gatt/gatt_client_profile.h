@@ -37,8 +37,10 @@
 #ifndef GATT_CLIENT_PROFILE_H
 #define GATT_CLIENT_PROFILE_H
 
+#include <vector>
 #include "dispatcher.h"
 #include "gatt_client_profile_callback.h"
+#include "gatt_profile_defines.h"
 
 namespace bluetooth {
 class GattClientProfile {
@@ -68,6 +70,8 @@ public:
     void ReadLongCharacteristicDescriptor(int reqId, uint16_t connectHandle, uint16_t handle) const;
     void ReadMultipleCharacteristicValue(
         int reqId, uint16_t connectHandle, const GattValue &value, size_t len) const;
+    void ReadMultipleVariableCharacteristicValue(
+        int reqId, uint16_t connectHandle, const std::vector<uint16_t> &handles) const;
     void WriteWithoutResponse(
         int reqId, uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len) const;
     void SignedWriteWithoutResponse(
@@ -83,9 +87,16 @@ public:
     void ReliableWriteCharacteristicValue(
         int reqId, uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len) const;
     void ExecuteWriteRequest(int reqId, uint16_t connectHandle, uint8_t flag) const;
+    void WriteMultipleCharacteristicValue(
+        int reqId, uint16_t connectHandle, const std::vector<WriteValueParam> &values) const;
     void HandleValueConfirmation(uint16_t connectHandle) const;
     void ClearCacheMap(uint16_t connectHandle) const;
+    void ReadDatabaseHash(int reqId, uint16_t connectHandle) const;
+    bool IsCacheInSync(uint16_t connectHandle) const;
+    void CommitCache(uint16_t connectHandle) const;
     std::map<uint16_t, GattCache::Service> *GetServices(uint16_t connectHandle) const;
+    uint16_t GetMtu(uint16_t connectHandle) const;
+    bool IsMtuExchanged(uint16_t connectHandle) const;
     uint16_t GetCharacteristicEndHandle(uint16_t connectHandle, uint16_t svcHandle, uint16_t handle) const;
     const GattCache::Service *GetService(uint16_t connectHandle, int16_t handle) const;
     const GattCache::Characteristic *GetCharacteristic(uint16_t connectHandle, int16_t valueHandle) const;
@@ -67,6 +67,8 @@ public:
     virtual void OnReliableWriteCharacteristicValueEvent(
         int reqId, uint16_t handle, GattValue &value, size_t len, int result){};
     virtual void OnExecuteWriteValueEvent(int reqId, uint16_t connectHandle, int result){};
+    virtual void OnReadDatabaseHashEvent(
+        int reqId, uint16_t connectHandle, bool isInSync, uint16_t startHandle, uint16_t endHandle){};
     virtual ~GattClientProfileCallback()
     {}
 };
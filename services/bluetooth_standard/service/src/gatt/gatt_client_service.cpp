@@ -14,6 +14,8 @@
  */
 
 #include "gatt_client_service.h"
+#include <algorithm>
+#include <chrono>
 #include <future>
 #include <queue>
 #include <set>
@@ -32,17 +34,32 @@ namespace bluetooth {
 struct ClientApplication {
     struct Discover {
         struct Task {
-            enum Type { SERVICE, INCLUDE_SERVICE, CHARACTERISTICS, DESCRIPTOR };
+            enum Type { EXCHANGE_MTU, DATABASE_HASH, SERVICE, INCLUDE_SERVICE, CHARACTERISTICS, DESCRIPTOR };
+            static const int TYPE_NUM = DESCRIPTOR + 1;
             int type_ = 0;
             uint16_t startHandle_ = 0;
             uint16_t endHandle_ = 0;
         };
         std::queue<Task> tasks_ = {};
         std::set<uint16_t> discovered_ = {};
+        // task waiting for its profile event, the next phase is planned over its handle range
+        bool isRunning_ = false;
+        Task running_ = {};
+        // per phase statistics, logged when the discovery completes
+        std::chrono::steady_clock::time_point begin_ = {};
+        std::chrono::steady_clock::time_point taskBegin_ = {};
+        std::chrono::steady_clock::duration elapsed_[Task::TYPE_NUM] = {};
+        int taskCount_[Task::TYPE_NUM] = {};
         ClientApplication &client_;
         GattClientProfile &profile_;
 
         bool DiscoverNext(int appId);
+        bool IsRunning(int type) const
+        {
+            return isRunning_ && running_.type_ == type;
+        }
+        void FinishTask();
+        void LogStatistics() const;
         void Clear();
         Discover(ClientApplication &client, GattClientProfile &profile) : client_(client), profile_(profile)
         {}
@@ -105,6 +122,8 @@ struct GattClientService::impl : public GattServiceBase {
     void WriteCharacteristic(
         int appId, uint16_t handle, const GattValue &value, int length, bool withoutRespond = false);
     void SignedWriteCharacteristic(int appId, uint16_t handle, const GattValue &value, int length);
+    void ReadCharacteristics(int appId, const std::vector<uint16_t> &handles);
+    void WriteCharacteristics(int appId, const std::vector<WriteValueParam> &values);
     void ReadDescriptor(int appId, uint16_t handle);
     void WriteDescriptor(int appId, uint16_t handle, const GattValue &value, int length);
     void RequestExchangeMtu(int appId, int mtu);
@@ -128,6 +147,8 @@ struct GattClientService::impl : public GattServiceBase {
     void OnCharacteristicNotifyEvent(
         uint16_t connectHandle, uint16_t valueHandle, GattValue &value, size_t length, bool needConfirm);
     void OnExchangeMtuEvent(int requestId, uint16_t connectHandle, uint16_t rxMtu, bool status);
+    void OnReadDatabaseHashEvent(
+        int requestId, uint16_t connectHandle, bool isInSync, uint16_t startHandle, uint16_t endHandle);
     void OnConnect(const GattDevice &device, uint16_t connectionHandle, int ret);
     void OnDisconnect(const GattDevice &device, uint16_t connectionHandle, int ret);
     void OnConnectionChanged(const GattDevice &device, uint16_t connectionHandle, int state);
@@ -140,6 +161,9 @@ struct GattClientService::impl : public GattServiceBase {
     void Enable();
     void Disable();
     void CleanApplication();
+    void CompleteDiscovery(ClientApplication &client, int ret);
+    void PlanIncludedServiceDiscovery(ClientApplication &client, uint16_t startHandle, uint16_t endHandle);
+    void PlanDescriptorDiscovery(ClientApplication &client, uint16_t startHandle, uint16_t endHandle);
     static void BuildService(GattCache::Service &src, Service &dest);
     static void GattUpdatePowerStatus(const RawAddress &addr);
 };
@@ -332,6 +356,52 @@ int GattClientService::SignedWriteCharacteristic(int appId, Characteristic &char
     return GattStatus::GATT_SUCCESS;
 }
 
+int GattClientService::ReadCharacteristics(int appId, const std::vector<Characteristic> &characteristics)
+{
+    if (!pimpl->InRunningState()) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+
+    if (characteristics.empty()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+
+    std::vector<uint16_t> handles;
+    handles.reserve(characteristics.size());
+    for (auto &characteristic : characteristics) {
+        handles.push_back(characteristic.handle_);
+    }
+    GetDispatcher()->PostTask(std::bind(&impl::ReadCharacteristics, pimpl.get(), appId, std::move(handles)));
+
+    return GattStatus::GATT_SUCCESS;
+}
+
+int GattClientService::WriteCharacteristics(int appId, std::vector<Characteristic> &characteristics)
+{
+    if (!pimpl->InRunningState()) {
+        return GattStatus::REQUEST_NOT_SUPPORT;
+    }
+
+    if (characteristics.empty()) {
+        return GattStatus::INVALID_PARAMETER;
+    }
+    for (auto &characteristic : characteristics) {
+        if (characteristic.value_ == nullptr || characteristic.length_ <= 0) {
+            return GattStatus::INVALID_PARAMETER;
+        }
+    }
+
+    std::vector<WriteValueParam> values;
+    values.reserve(characteristics.size());
+    for (auto &characteristic : characteristics) {
+        values.emplace_back(
+            characteristic.handle_, pimpl->MoveToGattValue(characteristic.value_), characteristic.length_);
+    }
+    GetDispatcher()->PostTask(std::bind(&impl::WriteCharacteristics, pimpl.get(), appId, std::move(values)));
+
+    return GattStatus::GATT_SUCCESS;
+}
+
 int GattClientService::ReadDescriptor(int appId, const Descriptor &descriptor)
 {
     if (!pimpl->InRunningState()) {
@@ -549,6 +619,18 @@ public:
             std::bind(&impl::OnExchangeMtuEvent, service_.pimpl.get(), reqId, connectHandle, rxMtu, status));
     }
 
+    void OnReadDatabaseHashEvent(
+        int reqId, uint16_t connectHandle, bool isInSync, uint16_t startHandle, uint16_t endHandle) override
+    {
+        service_.GetDispatcher()->PostTask(std::bind(&impl::OnReadDatabaseHashEvent,
+            service_.pimpl.get(),
+            reqId,
+            connectHandle,
+            isInSync,
+            startHandle,
+            endHandle));
+    }
+
     GattClientProfileCallbackImplement(GattClientService &service) : service_(service)
     {}
     ~GattClientProfileCallbackImplement()
@@ -670,13 +752,21 @@ void GattClientService::impl::DiscoveryServices(int appId)
             return;
         }
 
-        profile_->ClearCacheMap(client.connection_.GetHandle());
+        if (profile_->IsCacheInSync(client.connection_.GetHandle())) {
+            client.callback_.OnServicesDiscovered(GattStatus::GATT_SUCCESS);
+            return;
+        }
+
         client.discover_.Clear();
 
+        // A larger ATT_MTU packs more attributes into every discovery response.
         ClientApplication::Discover::Task task = {};
-        task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
-        task.startHandle_ = MIN_ATTRIBUTE_HANDLE;
-        task.endHandle_ = MAX_ATTRIBUTE_HANDLE;
+        if (client.connection_.GetDevice().transport_ == GATT_TRANSPORT_TYPE_LE &&
+            !profile_->IsMtuExchanged(client.connection_.GetHandle())) {
+            task.type_ = ClientApplication::Discover::Task::Type::EXCHANGE_MTU;
+            client.discover_.tasks_.push(task);
+        }
+        task.type_ = ClientApplication::Discover::Task::Type::DATABASE_HASH;
         client.discover_.tasks_.push(task);
 
         client.discover_.DiscoverNext(appId);
@@ -743,6 +833,48 @@ void GattClientService::impl::SignedWriteCharacteristic(int appId, uint16_t hand
     }
 }
 
+void GattClientService::impl::ReadCharacteristics(int appId, const std::vector<uint16_t> &handles)
+{
+    auto it = GetValidApplication(appId);
+    if (it.has_value()) {
+        auto &client = it.value()->second;
+        if (handleMap_.find(client.connection_.GetHandle()) == handleMap_.end()) {
+            for (auto handle : handles) {
+                client.callback_.OnCharacteristicRead(GattStatus::REQUEST_NOT_SUPPORT, Characteristic(handle));
+            }
+            return;
+        }
+
+        std::vector<uint16_t> valueHandles;
+        valueHandles.reserve(handles.size());
+        for (auto handle : handles) {
+            valueHandles.push_back(handle + 1);
+        }
+        profile_->ReadMultipleVariableCharacteristicValue(appId, client.connection_.GetHandle(), valueHandles);
+    }
+}
+
+void GattClientService::impl::WriteCharacteristics(int appId, const std::vector<WriteValueParam> &values)
+{
+    auto it = GetValidApplication(appId);
+    if (it.has_value()) {
+        auto &client = it.value()->second;
+        if (handleMap_.find(client.connection_.GetHandle()) == handleMap_.end()) {
+            for (auto &value : values) {
+                client.callback_.OnCharacteristicWrite(GattStatus::REQUEST_NOT_SUPPORT, Characteristic(value.handle_));
+            }
+            return;
+        }
+
+        std::vector<WriteValueParam> valueParams;
+        valueParams.reserve(values.size());
+        for (auto &value : values) {
+            valueParams.emplace_back(value.handle_ + 1, value.value_, value.length_);
+        }
+        profile_->WriteMultipleCharacteristicValue(appId, client.connection_.GetHandle(), valueParams);
+    }
+}
+
 void GattClientService::impl::ReadDescriptor(int appId, uint16_t handle)
 {
     auto it = GetValidApplication(appId);
@@ -828,23 +960,29 @@ void GattClientService::impl::OnDiscoverAllPrimaryServicesEvent(
         }
 
         if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &serv : services) {
-                ClientApplication::Discover::Task task = {};
+            // Included services and characteristics are each found by one sweep over all the services just
+            // discovered, instead of one procedure per service.
+            auto &discover = it.value()->second.discover_;
+            auto cache = profile_->GetServices(connectHandle);
+            ClientApplication::Discover::Task task = {};
+            if (cache != nullptr) {
+                for (auto sIt = cache->lower_bound(discover.running_.startHandle_);
+                     sIt != cache->end() && sIt->first <= discover.running_.endHandle_;
+                     sIt++) {
+                    task.startHandle_ = (task.startHandle_ == 0) ? sIt->first : task.startHandle_;
+                    task.endHandle_ = std::max(task.endHandle_, sIt->second.endHandle_);
+                }
+            }
+            if (task.startHandle_ != 0) {
                 task.type_ = ClientApplication::Discover::Task::Type::INCLUDE_SERVICE;
-                task.startHandle_ = serv.second.handle_;
-                task.endHandle_ = serv.second.endHandle_;
-                it.value()->second.discover_.tasks_.push(task);
-
-                task.type_ = ClientApplication::Discover::Task::Type::CHARACTERISTICS;
-                it.value()->second.discover_.tasks_.push(task);
+                discover.tasks_.push(task);
             }
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
+            if (!discover.DiscoverNext(requestId)) {
                 return;
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        CompleteDiscovery(it.value()->second, ret);
     }
 }
 
@@ -858,21 +996,17 @@ void GattClientService::impl::OnFindIncludedServicesEvent(int requestId, int ret
         }
 
         if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &serv : services) {
-                ClientApplication::Discover::Task task = {};
-                task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
-                task.startHandle_ = serv.startHandle_;
-                task.endHandle_ = serv.startHandle_;
-
-                it.value()->second.discover_.tasks_.push(task);
-            }
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
+            auto &discover = it.value()->second.discover_;
+            ClientApplication::Discover::Task task = discover.running_;
+            task.type_ = ClientApplication::Discover::Task::Type::CHARACTERISTICS;
+            discover.tasks_.push(task);
+            PlanIncludedServiceDiscovery(it.value()->second, task.startHandle_, task.endHandle_);
+            if (!discover.DiscoverNext(requestId)) {
                 return;
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        CompleteDiscovery(it.value()->second, ret);
     }
 }
 
@@ -886,23 +1020,15 @@ void GattClientService::impl::OnDiscoverAllCharacteristicOfServiceEvent(int requ
         }
 
         if (GattStatus::GATT_SUCCESS == ret) {
-            for (auto &ccc : characteristics) {
-                ClientApplication::Discover::Task task = {};
-                task.type_ = ClientApplication::Discover::Task::Type::DESCRIPTOR;
-                task.startHandle_ = ccc.second.handle_;
-                task.endHandle_ = profile_->GetCharacteristicEndHandle(
-                    it.value()->second.connection_.GetHandle(), serviceHandle, ccc.second.handle_);
+            auto &discover = it.value()->second.discover_;
+            PlanDescriptorDiscovery(it.value()->second, discover.running_.startHandle_, discover.running_.endHandle_);
 
-                it.value()->second.discover_.tasks_.push(task);
-            }
-
-            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
+            if (!discover.DiscoverNext(requestId)) {
                 return;
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        CompleteDiscovery(it.value()->second, ret);
     }
 }
 
@@ -921,8 +1047,7 @@ void GattClientService::impl::OnDiscoverAllCharacteristicDescriptorsEvent(int re
             }
         }
 
-        it.value()->second.discover_.Clear();
-        it.value()->second.callback_.OnServicesDiscovered(ret);
+        CompleteDiscovery(it.value()->second, ret);
     }
 }
 
@@ -1038,6 +1163,35 @@ void GattClientService::impl::OnExchangeMtuEvent(int requestId, uint16_t connect
         }
 
         it.value()->second.callback_.OnMtuChanged(status ? GattStatus::GATT_SUCCESS : GattStatus::GATT_FAILURE, rxMtu);
+
+        // A failed exchange leaves the default ATT_MTU, discovery goes on with it.
+        if (it.value()->second.discover_.IsRunning(ClientApplication::Discover::Task::Type::EXCHANGE_MTU)) {
+            if (!it.value()->second.discover_.DiscoverNext(requestId)) {
+                return;
+            }
+            CompleteDiscovery(it.value()->second, GattStatus::GATT_SUCCESS);
+        }
+    }
+}
+
+void GattClientService::impl::OnReadDatabaseHashEvent(
+    int requestId, uint16_t connectHandle, bool isInSync, uint16_t startHandle, uint16_t endHandle)
+{
+    auto it = GetValidApplication(requestId);
+    if (it.has_value()) {
+        auto &client = it.value()->second;
+        if (!isInSync) {
+            ClientApplication::Discover::Task task = {};
+            task.type_ = ClientApplication::Discover::Task::Type::SERVICE;
+            task.startHandle_ = startHandle;
+            task.endHandle_ = endHandle;
+            client.discover_.tasks_.push(task);
+            if (!client.discover_.DiscoverNext(requestId)) {
+                return;
+            }
+        }
+
+        CompleteDiscovery(client, GattStatus::GATT_SUCCESS);
     }
 }
 
@@ -1222,6 +1376,86 @@ void GattClientService::impl::CleanApplication()
     clients_.clear();
 }
 
+void GattClientService::impl::CompleteDiscovery(ClientApplication &client, int ret)
+{
+    client.discover_.FinishTask();
+    client.discover_.LogStatistics();
+    client.discover_.Clear();
+    if (GattStatus::GATT_SUCCESS == ret) {
+        profile_->CommitCache(client.connection_.GetHandle());
+    }
+    client.callback_.OnServicesDiscovered(ret);
+}
+
+void GattClientService::impl::PlanIncludedServiceDiscovery(
+    ClientApplication &client, uint16_t startHandle, uint16_t endHandle)
+{
+    auto cache = profile_->GetServices(client.connection_.GetHandle());
+    if (cache == nullptr) {
+        return;
+    }
+
+    // Secondary services included from outside the swept range get a sweep of their own.
+    for (auto sIt = cache->lower_bound(startHandle); sIt != cache->end() && sIt->first <= endHandle; sIt++) {
+        for (auto &isvc : sIt->second.includeServices_) {
+            if ((isvc.startHandle_ < startHandle || isvc.startHandle_ > endHandle) &&
+                cache->find(isvc.startHandle_) != cache->end() &&
+                client.discover_.discovered_.emplace(isvc.startHandle_).second) {
+                ClientApplication::Discover::Task task = {};
+                task.type_ = ClientApplication::Discover::Task::Type::CHARACTERISTICS;
+                task.startHandle_ = isvc.startHandle_;
+                task.endHandle_ = isvc.endHandle_;
+                client.discover_.tasks_.push(task);
+            }
+        }
+    }
+}
+
+void GattClientService::impl::PlanDescriptorDiscovery(
+    ClientApplication &client, uint16_t startHandle, uint16_t endHandle)
+{
+    auto cache = profile_->GetServices(client.connection_.GetHandle());
+    if (cache == nullptr) {
+        return;
+    }
+
+    // Adjacent descriptor ranges are merged into one Find Information sweep as long as the declarations and values
+    // in between cost less than a response holds: they come back as 16 bit pairs and are skipped. A 128 bit type
+    // would end the response early, so no range is merged across one.
+    static const uint16_t FIND_INFORMATION_PAIR_LEN = 4;
+    uint16_t maxGap = (profile_->GetMtu(client.connection_.GetHandle()) - sizeof(uint16_t)) / FIND_INFORMATION_PAIR_LEN;
+    ClientApplication::Discover::Task task = {};
+    task.type_ = ClientApplication::Discover::Task::Type::DESCRIPTOR;
+    bool canMerge = false;
+    for (auto sIt = cache->begin(); sIt != cache->end(); sIt++) {
+        auto &characteristics = sIt->second.characteristics_;
+        for (auto cIt = characteristics.begin(); cIt != characteristics.end(); cIt++) {
+            if (cIt->first < startHandle || cIt->first > endHandle) {
+                continue;
+            }
+            auto next = std::next(cIt);
+            uint16_t cccEndHandle = (next != characteristics.end()) ? (next->first - MIN_ATTRIBUTE_HANDLE)
+                                                                    : sIt->second.endHandle_;
+            canMerge = canMerge && cIt->second.uuid_.GetUuidType() == Uuid::UUID16_BYTES_TYPE &&
+                       cIt->second.valueHandle_ - task.endHandle_ <= maxGap;
+            if (cIt->second.valueHandle_ >= cccEndHandle) {
+                continue;
+            }
+            if (!canMerge) {
+                if (task.startHandle_ != 0) {
+                    client.discover_.tasks_.push(task);
+                }
+                task.startHandle_ = cIt->first;
+            }
+            task.endHandle_ = cccEndHandle;
+            canMerge = true;
+        }
+    }
+    if (task.startHandle_ != 0) {
+        client.discover_.tasks_.push(task);
+    }
+}
+
 void GattClientService::impl::BuildService(GattCache::Service &src, Service &dest)
 {
     for (auto &isvc : src.includeServices_) {
@@ -1245,21 +1479,28 @@ void GattClientService::impl::GattUpdatePowerStatus(const RawAddress &addr)
 
 bool ClientApplication::Discover::DiscoverNext(int appId)
 {
-    bool doOnce = true;
-    do {
-        if (tasks_.empty()) {
-            return true;
+    FinishTask();
+    while (!tasks_.empty()) {
+        Task task = tasks_.front();
+        tasks_.pop();
+        if (task.type_ == Task::Type::SERVICE && !discovered_.emplace(task.startHandle_).second) {
+            continue;
         }
 
-        auto &task = tasks_.front();
+        running_ = task;
+        isRunning_ = true;
+        taskBegin_ = std::chrono::steady_clock::now();
+        taskCount_[task.type_]++;
         switch (task.type_) {
+            case Task::Type::EXCHANGE_MTU:
+                profile_.ExchangeMtu(appId, client_.connection_.GetHandle(), DEFAULT_BLE_GATT_CLIENT_EXCHANGE_MTU);
+                break;
+            case Task::Type::DATABASE_HASH:
+                profile_.ReadDatabaseHash(appId, client_.connection_.GetHandle());
+                break;
             case Task::Type::SERVICE:
-                if (discovered_.emplace(task.startHandle_).second) {
-                    profile_.DiscoverAllPrimaryServices(
-                        appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
-                } else {
-                    doOnce = false;
-                }
+                profile_.DiscoverAllPrimaryServices(
+                    appId, client_.connection_.GetHandle(), task.startHandle_, task.endHandle_);
                 break;
             case Task::Type::INCLUDE_SERVICE:
                 profile_.FindIncludedServices(
@@ -1276,10 +1517,37 @@ bool ClientApplication::Discover::DiscoverNext(int appId)
             default:
                 break;
         }
-        tasks_.pop();
-    } while (!doOnce);
+        return false;
+    }
 
-    return false;
+    return true;
+}
+
+void ClientApplication::Discover::FinishTask()
+{
+    if (isRunning_) {
+        elapsed_[running_.type_] += std::chrono::steady_clock::now() - taskBegin_;
+        isRunning_ = false;
+    }
+}
+
+void ClientApplication::Discover::LogStatistics() const
+{
+    static const char *const PHASE_NAME[Task::TYPE_NUM] = {
+        "mtu", "database hash", "primary service", "include service", "characteristic", "descriptor"};
+    auto total = std::chrono::steady_clock::now() - begin_;
+    LOG_INFO("%{public}s: discovery took %{public}lld ms",
+        __FUNCTION__,
+        static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(total).count()));
+    for (int i = 0; i < Task::TYPE_NUM; i++) {
+        if (taskCount_[i] != 0) {
+            LOG_INFO("%{public}s: %{public}s: %{public}d procedures, %{public}lld ms",
+                __FUNCTION__,
+                PHASE_NAME[i],
+                taskCount_[i],
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed_[i]).count()));
+        }
+    }
 }
 
 void ClientApplication::Discover::Clear()
@@ -1288,6 +1556,13 @@ void ClientApplication::Discover::Clear()
         tasks_.pop();
     }
     discovered_.clear();
+    isRunning_ = false;
+    running_ = {};
+    begin_ = std::chrono::steady_clock::now();
+    for (int i = 0; i < Task::TYPE_NUM; i++) {
+        elapsed_[i] = std::chrono::steady_clock::duration::zero();
+        taskCount_[i] = 0;
+    }
 }
 
 void GattClientService::Enable()
@@ -40,6 +40,8 @@ public:
     int ReadCharacteristicByUuid(int appId, const Uuid &uuid) override;
     int WriteCharacteristic(int appId, Characteristic &characteristic, bool withoutRespond = false) override;
     int SignedWriteCharacteristic(int appId, Characteristic &characteristic) override;
+    int ReadCharacteristics(int appId, const std::vector<Characteristic> &characteristics) override;
+    int WriteCharacteristics(int appId, std::vector<Characteristic> &characteristics) override;
     int ReadDescriptor(int appId, const Descriptor &descriptor) override;
     int WriteDescriptor(int appId, Descriptor &descriptor) override;
     int RequestExchangeMtu(int appId, int mtu) override;
@@ -93,6 +93,7 @@ struct GattConnectionManager::impl : public GattServiceBase {
     static int ConvertConnectionState(const std::string &state);
     void DoShutDown();
     static uint16_t GetBleMaxConnectedDevices();
+    static uint8_t GetBleEattBearerNum();
     static uint16_t GetBleMinConnectionInterval(int connPriority);
     static uint16_t GetBleMaxConnectionInterval(int connPriority);
     static uint16_t GetBleConnectionLatency(int connPriority);
@@ -296,6 +297,24 @@ bool GattConnectionManager::GetEncryptionInfo(const GattDevice &device) const
     return false;
 }
 
+// Number of enhanced ATT bearers to open on the connection, 0 unless it is an encrypted LE link we initiated.
+uint8_t GattConnectionManager::GetEattBearerNum(uint16_t connectHandle) const
+{
+    uint8_t bearerNum = impl::GetBleEattBearerNum();
+    if (bearerNum == 0) {
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> devLock;
+    auto device = pimpl->FindDevice(connectHandle, devLock);
+    if (device == nullptr || device->Info().transport_ != GATT_TRANSPORT_TYPE_LE ||
+        device->Info().role_ != GATT_ROLE_MASTER) {
+        return 0;
+    }
+    device->CheckEncryption();
+    return device->Info().isEncryption_ ? bearerNum : 0;
+}
+
 int GattConnectionManager::SetConnectionType(const GattDevice &device, bool autoConnect) const
 {
     std::unique_lock<std::mutex> devLock;
@@ -799,6 +818,7 @@ int GattConnectionManager::impl::DoConnectComplete(GattConnectionManager::Device
             device.DirectConnect().Stop();
             ChangeConnectionMode(false);
         }
+
         result = GattStatus::GATT_SUCCESS;
     } else {
         device.AutoConnect() = false;
@@ -970,6 +990,13 @@ uint16_t GattConnectionManager::impl::GetBleMaxConnectedDevices()
     return result;
 }
 
+uint8_t GattConnectionManager::impl::GetBleEattBearerNum()
+{
+    int result = DEFAULT_BLE_EATT_BEARER_NUM;
+    AdapterConfig::GetInstance()->GetValue(SECTION_GATT_SERVICE, PROPERTY_BLE_EATT_BEARER_NUM, result);
+    return result;
+}
+
 uint16_t GattConnectionManager::impl::GetBleMinConnectionInterval(int connPriority)
 {
     int result = DEFAULT_BLE_MIN_CONNECTION_INTERVAL;
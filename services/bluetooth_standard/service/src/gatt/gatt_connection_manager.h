@@ -162,6 +162,7 @@ public:
     int RequestConnectionPriority(uint16_t handle, int connPriority) const;
     bool GetEncryptionInfo(uint16_t connectHandle) const;
     bool GetEncryptionInfo(const GattDevice &device) const;
+    uint8_t GetEattBearerNum(uint16_t connectHandle) const;
     int SetConnectionType(const GattDevice &device, bool autoConnect) const;
 
     int StartUp(utility::Dispatcher &dispatcher);
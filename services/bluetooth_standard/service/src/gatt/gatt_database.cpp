@@ -17,6 +17,7 @@
 #include "gatt_database.h"
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <optional>
 #include "bt_def.h"
 #include "gatt_defines.h"
@@ -27,7 +28,7 @@ using GattAttributeEntity = std::optional<std::reference_wrapper<GattDatabase::A
 
 GattDatabase::GattDatabase()
 {
-    availableHandles_.emplace_front(MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE);
+    availableHandles_.emplace(MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE);
 }
 
 int GattDatabase::AddService(bluetooth::Service &service)
@@ -42,11 +43,14 @@ int GattDatabase::AddService(bluetooth::Service &service)
     service.endHandle_ = availableHandlePair.second;
     // copy service
     Service dbService(service);
+    std::vector<AttributeIndex> indexes;
+    indexes.emplace_back(service.handle_, SERVICE, service.handle_, INVALID_ATTRIBUTE_HANDLE);
 
     // copy includeService
     for (auto &includeService : service.includeServices_) {
         includeService.handle_ = currentHandle++;
         dbService.includeServices_.push_back(GattDatabase::IncludeService(includeService));
+        indexes.emplace_back(includeService.handle_, INCLUDE_SERVICE, service.handle_, INVALID_ATTRIBUTE_HANDLE);
     }
 
     for (auto &ccc : service.characteristics_) {
@@ -58,7 +62,8 @@ int GattDatabase::AddService(bluetooth::Service &service)
         cccAttributeValue.SetValue(ccc.value_.get(), ccc.length_);
 
         attributes_.emplace(ccc.valueHandle_, std::move(cccAttributeValue));
-        valueHandleMap_.emplace(ccc.valueHandle_, std::make_pair(service.handle_, ccc.handle_));
+        indexes.emplace_back(ccc.handle_, CHARACTERISTIC, service.handle_, ccc.handle_);
+        indexes.emplace_back(ccc.valueHandle_, CHARACTERISTIC_VALUE, service.handle_, ccc.handle_);
 
         for (auto &descriptor : ccc.descriptors_) {
             descriptor.handle_ = currentHandle++;
@@ -68,7 +73,7 @@ int GattDatabase::AddService(bluetooth::Service &service)
             descAttributeValue.SetValue(descriptor.value_.get(), descriptor.length_);
 
             attributes_.emplace(descriptor.handle_, std::move(descAttributeValue));
-            valueHandleMap_.emplace(descriptor.handle_, std::make_pair(service.handle_, ccc.handle_));
+            indexes.emplace_back(descriptor.handle_, DESCRIPTOR, service.handle_, ccc.handle_);
             dbCharacteristic.descriptors_.emplace(dbDescriptor.handle_, std::move(dbDescriptor));
         }
 
@@ -77,6 +82,7 @@ int GattDatabase::AddService(bluetooth::Service &service)
     }
 
     services_.emplace(dbService.handle_, std::move(dbService));
+    AddAttributeIndexes(indexes);
     return GattStatus::GATT_SUCCESS;
 }
 
@@ -91,15 +97,14 @@ int GattDatabase::DeleteService(uint16_t handle)
     }
     // release handles
     ReleaseHandle(sIt->second);
-    // delete attribute and handle map
+    // delete attribute and handle index
     for (auto &ccc : sIt->second.characteristics_) {
         attributes_.erase(ccc.second.valueHandle_);
-        valueHandleMap_.erase(ccc.second.valueHandle_);
         for (auto &descriptor : ccc.second.descriptors_) {
             attributes_.erase(descriptor.second.handle_);
-            valueHandleMap_.erase(descriptor.second.handle_);
         }
     }
+    DeleteAttributeIndexes(sIt->second.handle_, sIt->second.endHandle_);
     // delete service
     services_.erase(sIt);
     return GattStatus::GATT_SUCCESS;
@@ -108,99 +113,102 @@ int GattDatabase::DeleteService(uint16_t handle)
 void GattDatabase::RemoveAllServices()
 {
     availableHandles_.clear();
-    availableHandles_.emplace_front(MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE);
+    availableHandles_.emplace(MIN_ATTRIBUTE_HANDLE, MAX_ATTRIBUTE_HANDLE);
     services_.clear();
     attributes_.clear();
-    valueHandleMap_.clear();
+    attributeIndexes_.clear();
+    for (auto &typeIndexes : typeIndexes_) {
+        typeIndexes.clear();
+    }
     restrictedGattBasedService_.clear();
 }
 
 void GattDatabase::ReleaseHandle(GattDatabase::Service &service)
 {
-    if (availableHandles_.empty()) {
-        availableHandles_.emplace_front(service.handle_, service.endHandle_);
+    uint16_t startHandle = service.handle_;
+    uint16_t endHandle = service.endHandle_;
+
+    // merge with the available range ending right before the service
+    auto next = availableHandles_.upper_bound(startHandle);
+    if (next != availableHandles_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->second + 1 == startHandle) {
+            startHandle = prev->first;
+            availableHandles_.erase(prev);
+        }
+    }
+    // merge with the available range starting right after the service
+    if (next != availableHandles_.end() && next->first == endHandle + 1) {
+        endHandle = next->second;
+        availableHandles_.erase(next);
+    }
+
+    availableHandles_.emplace(startHandle, endHandle);
+}
+
+void GattDatabase::AddAttributeIndexes(const std::vector<AttributeIndex> &indexes)
+{
+    if (indexes.empty()) {
         return;
     }
-    auto item = availableHandles_.begin();
-    while (item != availableHandles_.end()) {
-        auto currentNode = item;
-        auto nextNode = ++item;
-
-        //     service                  current
-        // [start handle, end handle][first,second]
-        if (currentNode->first > service.endHandle_) {
-            //              release service           current
-            // before   [start handle, end handle][c.first, c.second]
-            // after    [start handle,                      c.second]
-            if (currentNode->first == service.endHandle_ + 1) {
-                availableHandles_.emplace(currentNode, service.handle_, currentNode->second);
-                availableHandles_.erase(currentNode);
-                //              release service           current
-                // before   [start handle, end handle][c.first, c.second]
-                // after    [start handle, end handle][c.first, c.second]
-            } else {
-                availableHandles_.emplace(currentNode, service.handle_, service.endHandle_);
-            }
 
-            break;
-        }
-        //   current           service
-        // [first,second][start handle, end handle]
-        if (nextNode == availableHandles_.end()) {
-            //              current           release service
-            // before   [c.first, c.second][start handle, end handle]
-            // after    [c.first,                         end handle]
-            if (service.handle_ == currentNode->second + 1) {
-                availableHandles_.emplace(currentNode, currentNode->first, service.endHandle_);
-                availableHandles_.erase(currentNode);
-                //              current           release service
-                // before   [c.first, c.second][start handle, end handle]
-                // after    [c.first, c.second][start handle, end handle]
-            } else {
-                availableHandles_.emplace(nextNode, service.handle_, service.endHandle_);
-            }
+    // the handles of a service are contiguous, so its entries are inserted as one block
+    auto compare = [](const AttributeIndex &item, uint16_t handle) { return item.handle_ < handle; };
+    auto it = std::lower_bound(attributeIndexes_.begin(), attributeIndexes_.end(), indexes.front().handle_, compare);
+    attributeIndexes_.insert(it, indexes.begin(), indexes.end());
 
-            break;
-        } else {
-            //   current            Next           service
-            // [first,second][first,second][start handle, end handle]
-            if (service.handle_ > nextNode->second)
-                continue;
-
-            //   current           service                Next
-            // [first,second][start handle, end handle][first,second]
-
-            //              current           release service              Next
-            // before   [c.first, c.second][start handle, end handle][n.first, n.second]
-            // after    [c.first,                         end handle][n.first, n.second]
-            if (service.handle_ == currentNode->second + 1 && service.endHandle_ + 1 != nextNode->first) {
-                availableHandles_.emplace(currentNode, currentNode->first, service.endHandle_);
-                availableHandles_.erase(currentNode);
-                //              current           release service           Next
-                // before   [c.first, c.second][start handle, end handle][n.first, n.second]
-                // after    [c.first, c.second][start handle,                      n.second]
-            } else if (service.handle_ != currentNode->second + 1 && service.endHandle_ + 1 == nextNode->first) {
-                availableHandles_.emplace(nextNode, service.handle_, nextNode->second);
-                availableHandles_.erase(nextNode);
-                //              current           release service            Next
-                // before   [c.first, c.second][start handle, end handle][n.first, n.second]
-                // after    [c.first,                                              n.second]
-            } else if (service.handle_ == currentNode->second + 1 && service.endHandle_ + 1 == nextNode->first) {
-                availableHandles_.emplace(nextNode, currentNode->first, nextNode->second);
-                availableHandles_.erase(currentNode);
-                availableHandles_.erase(nextNode);
-                //              current           release service            Next
-                // before   [c.first, c.second][start handle, end handle][n.first, n.second]
-                // after    [c.first, c.second][start handle, end handle][n.first, n.second]
-            } else {
-                availableHandles_.emplace(nextNode, service.handle_, service.endHandle_);
-            }
+    for (uint8_t type = 0; type < ATTRIBUTE_TYPE_NUM; type++) {
+        auto &typeIndexes = typeIndexes_[type];
+        auto pos = std::lower_bound(typeIndexes.begin(), typeIndexes.end(), indexes.front().handle_, compare);
+        std::vector<AttributeIndex> block;
+        std::copy_if(indexes.begin(), indexes.end(), std::back_inserter(block), [type](auto &item) {
+            return item.type_ == type;
+        });
+        typeIndexes.insert(pos, block.begin(), block.end());
+    }
+}
 
-            break;
-        }
+void GattDatabase::DeleteAttributeIndexes(uint16_t startHandle, uint16_t endHandle)
+{
+    auto range = FindAttributeIndexes(attributeIndexes_, startHandle, endHandle);
+    attributeIndexes_.erase(range.first, range.second);
+
+    for (auto &typeIndexes : typeIndexes_) {
+        range = FindAttributeIndexes(typeIndexes, startHandle, endHandle);
+        typeIndexes.erase(range.first, range.second);
     }
 }
 
+GattDatabase::AttributeIndexRange GattDatabase::FindAttributeIndexes(
+    const std::vector<AttributeIndex> &indexes, uint16_t startHandle, uint16_t endHandle)
+{
+    auto first = std::lower_bound(indexes.begin(), indexes.end(), startHandle,
+        [](const AttributeIndex &item, uint16_t handle) { return item.handle_ < handle; });
+    auto last = std::upper_bound(first, indexes.end(), endHandle,
+        [](uint16_t handle, const AttributeIndex &item) { return handle < item.handle_; });
+    return AttributeIndexRange(first, last);
+}
+
+const GattDatabase::AttributeIndex *GattDatabase::GetAttributeIndex(uint16_t handle) const
+{
+    auto range = FindAttributeIndexes(attributeIndexes_, handle, handle);
+    if (range.first != range.second) {
+        return &*range.first;
+    }
+    return nullptr;
+}
+
+GattDatabase::AttributeIndexRange GattDatabase::GetAttributeIndexes(uint16_t startHandle, uint16_t endHandle) const
+{
+    return FindAttributeIndexes(attributeIndexes_, startHandle, endHandle);
+}
+
+GattDatabase::AttributeIndexRange GattDatabase::GetAttributeIndexes(
+    uint16_t startHandle, uint16_t endHandle, AttributeType type) const
+{
+    return FindAttributeIndexes(typeIndexes_[type], startHandle, endHandle);
+}
+
 bool GattDatabase::IsReferenced(uint16_t handle) const
 {
     return std::any_of(services_.begin(), services_.end(), [&handle](auto &svc) {
@@ -227,12 +235,17 @@ const std::vector<GattDatabase::IncludeService> *GattDatabase::GetIncludeService
 
 const GattDatabase::IncludeService *GattDatabase::GetIncludeService(uint16_t serviceHandle)
 {
-    for (auto &svc : services_) {
-        auto it = std::find_if(svc.second.includeServices_.begin(),
-            svc.second.includeServices_.end(),
+    auto index = GetAttributeIndex(serviceHandle);
+    if (index == nullptr || index->type_ != INCLUDE_SERVICE) {
+        return nullptr;
+    }
+    auto svc = services_.find(index->serviceHandle_);
+    if (svc != services_.end()) {
+        auto it = std::find_if(svc->second.includeServices_.begin(),
+            svc->second.includeServices_.end(),
             [&serviceHandle](auto &iSvc) { return iSvc.handle_ == serviceHandle; });
 
-        if (it != svc.second.includeServices_.end()) {
+        if (it != svc->second.includeServices_.end()) {
             return it.base();
         }
     }
@@ -259,11 +272,11 @@ const GattDatabase::Service *GattDatabase::GetService(uint16_t handle)
 
 GattDatabase::Characteristic *GattDatabase::GetCharacteristic(uint16_t valueHandle)
 {
-    auto it = valueHandleMap_.find(valueHandle);
-    if (it != valueHandleMap_.end() && it->second.second == valueHandle - 1) {
-        auto service = services_.find(it->second.first);
+    auto index = GetAttributeIndex(valueHandle);
+    if (index != nullptr && index->type_ == CHARACTERISTIC_VALUE) {
+        auto service = services_.find(index->serviceHandle_);
         if (service != services_.end()) {
-            auto ccc = service->second.characteristics_.find(it->second.second);
+            auto ccc = service->second.characteristics_.find(index->characteristicHandle_);
             if (ccc != service->second.characteristics_.end()) {
                 return &ccc->second;
             }
@@ -274,15 +287,15 @@ GattDatabase::Characteristic *GattDatabase::GetCharacteristic(uint16_t valueHand
 
 const GattDatabase::Descriptor *GattDatabase::GetDescriptor(uint16_t valueHandle)
 {
-    auto it = valueHandleMap_.find(valueHandle);
-    if (it == valueHandleMap_.end()) {
+    auto index = GetAttributeIndex(valueHandle);
+    if (index == nullptr || index->type_ != DESCRIPTOR) {
         return nullptr;
     }
-    auto service = services_.find(it->second.first);
+    auto service = services_.find(index->serviceHandle_);
     if (service == services_.end()) {
         return nullptr;
     }
-    auto ccc = service->second.characteristics_.find(it->second.second);
+    auto ccc = service->second.characteristics_.find(index->characteristicHandle_);
     if (ccc == service->second.characteristics_.end()) {
         return nullptr;
     }
@@ -295,9 +308,14 @@ const GattDatabase::Descriptor *GattDatabase::GetDescriptor(uint16_t valueHandle
 
 const std::map<uint16_t, GattDatabase::Descriptor> *GattDatabase::GetDescriptors(uint16_t cccHandle)
 {
-    for (auto &service : services_) {
-        auto it = service.second.characteristics_.find(cccHandle);
-        if (it != service.second.characteristics_.end()) {
+    auto index = GetAttributeIndex(cccHandle);
+    if (index == nullptr || index->type_ != CHARACTERISTIC) {
+        return nullptr;
+    }
+    auto service = services_.find(index->serviceHandle_);
+    if (service != services_.end()) {
+        auto it = service->second.characteristics_.find(cccHandle);
+        if (it != service->second.characteristics_.end()) {
             return &(it->second.descriptors_);
         }
     }
@@ -476,15 +494,16 @@ std::pair<uint16_t, uint16_t> GattDatabase::CalculateAndAssignHandle(const bluet
         count += ccc.descriptors_.size();
     }
 
-    // assign handles
+    // assign handles, first fit in handle order
     for (auto item = availableHandles_.begin(); item != availableHandles_.end(); item++) {
         auto availableLength = item->second - item->first + 1;
         if (availableLength >= count) {
             handlePair = std::pair<uint16_t, uint16_t>(item->first, item->first + count - 1);
-            if (handlePair.second < item->second) {
-                availableHandles_.insert(item, std::pair<uint16_t, uint16_t>(handlePair.second + 1, item->second));
-            }
+            uint16_t availableEnd = item->second;
             availableHandles_.erase(item);
+            if (handlePair.second < availableEnd) {
+                availableHandles_.emplace(handlePair.second + 1, availableEnd);
+            }
             break;
         }
     }
@@ -18,7 +18,6 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -189,6 +188,30 @@ public:
         Service &operator=(Service &&) = default;
     };
 
+    enum AttributeType : uint8_t {
+        SERVICE = 0,
+        INCLUDE_SERVICE,
+        CHARACTERISTIC,
+        CHARACTERISTIC_VALUE,
+        DESCRIPTOR,
+        ATTRIBUTE_TYPE_NUM,
+    };
+
+    // one entry per attribute handle, kept in handle order
+    struct AttributeIndex {
+        uint16_t handle_;
+        AttributeType type_;
+        uint16_t serviceHandle_;
+        // characteristic declaration handle for characteristic, value and descriptor entries
+        uint16_t characteristicHandle_;
+
+        AttributeIndex(uint16_t handle, AttributeType type, uint16_t serviceHandle, uint16_t characteristicHandle)
+            : handle_(handle), type_(type), serviceHandle_(serviceHandle), characteristicHandle_(characteristicHandle)
+        {}
+    };
+
+    using AttributeIndexRange =
+        std::pair<std::vector<AttributeIndex>::const_iterator, std::vector<AttributeIndex>::const_iterator>;
     using GattAttributeEntity = std::optional<std::reference_wrapper<GattDatabase::AttributeEntity>>;
 
     GattDatabase();
@@ -207,28 +230,35 @@ public:
     GattDatabase::Characteristic *GetCharacteristic(uint16_t valueHandle);
     const GattDatabase::Descriptor *GetDescriptor(uint16_t valueHandle);
     GattAttributeEntity GetValueByHandle(const uint16_t handle);
+    const GattDatabase::AttributeIndex *GetAttributeIndex(uint16_t handle) const;
+    AttributeIndexRange GetAttributeIndexes(uint16_t startHandle, uint16_t endHandle) const;
+    AttributeIndexRange GetAttributeIndexes(uint16_t startHandle, uint16_t endHandle, AttributeType type) const;
     int CheckLegalityOfServiceDefinition(bluetooth::Service &service);
 
 private:
     static int CountDescriptorByUuid(const std::vector<bluetooth::Descriptor> &descriptors, const Uuid &uuid);
     std::pair<uint16_t, uint16_t> CalculateAndAssignHandle(const bluetooth::Service &service);
     void ReleaseHandle(Service &service);
+    void AddAttributeIndexes(const std::vector<AttributeIndex> &indexes);
+    void DeleteAttributeIndexes(uint16_t startHandle, uint16_t endHandle);
+    static AttributeIndexRange FindAttributeIndexes(
+        const std::vector<AttributeIndex> &indexes, uint16_t startHandle, uint16_t endHandle);
     bool IsReferenced(uint16_t handle) const;
     int CheckIncludeServicesLegality(bluetooth::Service &service) const;
     int CheckCharacteristicsLegality(const bluetooth::Service &service) const;
     int CheckDescriptorsLegality(const bluetooth::Characteristic &characteristic) const;
     bool CheckRestrictedGattBasedService(const bluetooth::Service &service);
 
-    // available handle [handle, handle]
-    std::list<std::pair<uint16_t, uint16_t>> availableHandles_ = {};
+    // available handle start handle <-> end handle
+    std::map<uint16_t, uint16_t> availableHandles_ = {};
     // service handle <-> Service entity
     std::map<uint16_t, Service> services_ = {};
     // value handle <-> Attribute entity
     std::map<uint16_t, AttributeEntity> attributes_ = {};
-    // value handle <-> (service handle, parent handle)
-    // if value handle belong to descriptor, parent handle is characteristic handle witch descriptor belong to.
-    // else parent handle is characteristic handle.
-    std::map<uint16_t, std::pair<uint16_t, uint16_t>> valueHandleMap_ = {};
+    // every attribute in handle order, range requests binary search their start handle
+    std::vector<AttributeIndex> attributeIndexes_ = {};
+    // attributes of one type in handle order
+    std::vector<AttributeIndex> typeIndexes_[ATTRIBUTE_TYPE_NUM] = {};
     std::set<uint16_t> restrictedGattBasedService_ = {};
 
     DISALLOW_COPY_AND_ASSIGN(GattDatabase);
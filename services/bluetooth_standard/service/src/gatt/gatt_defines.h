@@ -31,6 +31,10 @@ constexpr uint8_t GATT_VALUE_LEN_MAX = 0xFF;
 constexpr uint8_t GATT_CCCD_NUM_MAX = 0xFF;
 constexpr uint16_t GATT_NOTIFICATION_VALUE = 0x0001;
 constexpr uint16_t GATT_INDICATION_VALUE = 0x0002;
+constexpr uint8_t GATT_DATABASE_HASH_SIZE = 0x10;
+constexpr uint8_t GATT_CLIENT_FEATURE_ROBUST_CACHING = 0x01;
+constexpr uint8_t GATT_CLIENT_FEATURE_MULTIPLE_HANDLE_VALUE_NOTIFICATION = 0x04;
+constexpr uint8_t GATT_SERVER_FEATURE_EATT = 0x01;
 
 constexpr uint16_t DEFAULT_BLE_MAX_CONNECTED_DEVICES = 0x0007;
 constexpr uint16_t DEFAULT_CLASSIC_MAX_CONNECTED_DEVICES = 0x0007;
@@ -43,6 +47,9 @@ constexpr uint8_t DEFAULT_CLASSIC_CONNECTION_MODE = 0x00;
 constexpr uint16_t DEFAULT_CLASSIC_CONNECTION_FLUSH_TIMEOUT = 0xFFFF;
 constexpr uint8_t DEFAULT_CLASSIC_CONNECTION_SECURITY_MODE = 0x24;
 constexpr uint16_t DEFAULT_BLE_GATT_SERVER_EXCHANGE_MTU = 0x0200;
+constexpr uint16_t DEFAULT_BLE_GATT_CLIENT_EXCHANGE_MTU = 0x0200;
+constexpr uint8_t DEFAULT_BLE_EATT_BEARER_NUM = 0x00;
+constexpr uint16_t DEFAULT_GATT_SERVER_NOTIFY_COALESCE_WINDOW = 0x0000;
 
 constexpr uint8_t CHARACTERISTIC_PROPERTIE_BROADCAST = 0x01;
 constexpr uint8_t CHARACTERISTIC_PROPERTIE_READ = 0x02;
@@ -59,6 +66,9 @@ constexpr uint16_t UUID_INCLUDE_SERVICE = 0x2802;
 constexpr uint16_t UUID_CHARACTERISTIC = 0x2803;
 
 constexpr uint16_t UUID_SERVICE_CHANGED = 0x2A05;
+constexpr uint16_t UUID_CLIENT_SUPPORTED_FEATURES = 0x2B29;
+constexpr uint16_t UUID_DATABASE_HASH = 0x2B2A;
+constexpr uint16_t UUID_SERVER_SUPPORTED_FEATURES = 0x2B3A;
 constexpr uint16_t UUID_CHARACTERISTIC_EXTENDED_PROPERTIES = 0x2900;
 constexpr uint16_t UUID_CHARACTERISTIC_USER_DESCRIPTION = 0x2901;
 constexpr uint16_t UUID_CLIENT_CHARACTERISTIC_CONFIGURATION = 0x2902;
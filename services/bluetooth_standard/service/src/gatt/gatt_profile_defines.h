@@ -43,7 +43,12 @@ enum ResponesType {
     RELIABLE_WRITE_VALUE,
     EXECUTE_WRITE_VALUE,
     EXCHANGE_MTU,
-    SEND_INDICATION
+    SEND_INDICATION,
+    READ_DATABASE_HASH,
+    WRITE_CLIENT_SUPPORTED_FEATURES,
+    READ_MULTIPLE_VARIABLE_CHARACTERISTIC,
+    WRITE_MULTIPLE_CHARACTERISTIC_VALUE,
+    READ_SERVER_SUPPORTED_FEATURES
 };
 
 enum ReadByTypeResponseLen {
@@ -80,6 +85,23 @@ struct MtuInfo {
     {}
 };
 
+struct CacheSyncInfo {
+    // The cache is complete and matches the server database.
+    bool isInSync_ = false;
+    // The cache matches the server database except for the range reported by Service Changed.
+    bool isChanged_ = false;
+    uint16_t changedStartHandle_ = 0;
+    uint16_t changedEndHandle_ = 0;
+    // A rediscovery started by a hash mismatch is running; cleared again if the database changes meanwhile.
+    bool isRediscovering_ = false;
+    // Database Hash read before a rediscovery, committed to the cache once the rediscovery succeeds.
+    bool hasPendingHash_ = false;
+    uint8_t pendingHash_[GATT_DATABASE_HASH_SIZE] = {};
+    bool isRobustCachingEnabled_ = false;
+    // Server Supported Features was read to decide whether enhanced ATT bearers are opened.
+    bool isServerFeaturesRead_ = false;
+};
+
 struct CccdInfo {
     uint16_t valHandle_ = 0;
     uint16_t value_ = 0;
@@ -88,11 +110,28 @@ struct CccdInfo {
 struct DeviceInfo {
     GattDevice device_;
     CccdInfo cccd_[GATT_CCCD_NUM_MAX] = {};
+    uint8_t clientFeatures_ = 0;
 
     explicit DeviceInfo(GattDevice dev) : device_(dev)
     {}
 };
 
+struct PendingNotification {
+    GattValue value_ = nullptr;
+    size_t len_ = 0;
+};
+
+struct ServerTransaction {
+    uint16_t connectHandle_ = 0;
+    uint16_t handle_ = 0;
+    uint8_t opcode_ = 0;
+    uint8_t bearer_ = 0;
+
+    ServerTransaction(uint16_t connectHandle, uint16_t handle, uint8_t opcode, uint8_t bearer)
+        : connectHandle_(connectHandle), handle_(handle), opcode_(opcode), bearer_(bearer)
+    {}
+};
+
 struct GattResponesInfor {
     ResponesType respType_ = NONE;
     uint16_t value_ = 0;
@@ -158,5 +197,14 @@ struct PrepareWriteParam {
     uint16_t handle_ = 0;
     uint16_t offset_ = 0;
 };
+struct WriteValueParam {
+    uint16_t handle_ = 0;
+    GattValue value_ = nullptr;
+    size_t length_ = 0;
+
+    WriteValueParam(uint16_t handle, const GattValue &value, size_t length)
+        : handle_(handle), value_(value), length_(length)
+    {}
+};
 }  // namespace bluetooth
 #endif  // GATT_PROFLIE_DEFINES_H
\ No newline at end of file
@@ -19,18 +19,29 @@
 #include "gatt_connection_manager.h"
 #include "gatt_service_base.h"
 #include "log.h"
+#include "timer.h"
 
 namespace bluetooth {
 struct GattServerProfile::impl {
     class GattConnectionObserverImplement;
     impl(GattServerProfileCallback *pServerCallbackFunc, utility::Dispatcher *dispatcher, uint16_t maxMtu,
-        GattServerProfile &profile)
+        int notifyCoalesceWindow, GattServerProfile &profile)
         : requestList_(),
           connectionCallBack_(std::make_unique<GattConnectionObserverImplement>(profile)),
           pServerCallBack_(pServerCallbackFunc),
           dispatcher_(dispatcher),
           db_(),
-          mtu_(maxMtu)
+          mtu_(maxMtu),
+          profile_(&profile),
+          notifyCoalesceWindow_(notifyCoalesceWindow),
+          notifyTimer_(std::make_unique<utility::Timer>(
+              [this, dispatcher = dispatcher_, alive = std::weak_ptr<bool>(alive_)]() {
+                  dispatcher->PostTask([this, alive]() {
+                      if (alive.lock() != nullptr) {
+                          FlushNotifications();
+                      }
+                  });
+              }))
     {}
     std::map<uint16_t, uint16_t> mtuInfo_ = {};
     std::list<std::pair<uint16_t, GattResponesInfor>> requestList_ = {};
@@ -43,11 +54,25 @@ struct GattServerProfile::impl {
     uint16_t mtu_ = 0;
     GattServerProfile *profile_ = nullptr;
     int connectionObserverId_ = 0;
+    int notifyCoalesceWindow_ = 0;
+    bool notifyTimerRunning_ = false;
+    // expires with impl, so a flush posted by the timer is dropped once the profile is gone
+    std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+    std::unique_ptr<utility::Timer> notifyTimer_ = {nullptr};
+    // (value handle, connection handle) <-> latest value waiting for the coalesce window to close
+    std::map<std::pair<uint16_t, uint16_t>, PendingNotification> pendingNotifications_ = {};
+    // requests handed to the application, answered on the bearer they arrived on
+    std::list<ServerTransaction> transactions_ = {};
+    // bearer of the request whose task is running on the dispatcher
+    uint8_t requestBearer_ = ATT_UNENHANCED_BEARER;
     DISALLOW_COPY_AND_ASSIGN(impl);
 
     static void ReceiveData(uint16_t connectHandle, uint16_t event, void *eventData, Buffer *buffer, void *context);
     static void ReceiveResponseResult(uint16_t connectHandle, int result, void *context);
     void ReceiveResponseResultPostTask(uint16_t connectHandle, int result);
+    void PostRequestTask(uint16_t connectHandle, std::function<void()> task);
+    void AddTransaction(uint16_t connectHandle, uint16_t handle, uint8_t opcode);
+    uint8_t TakeTransaction(uint16_t connectHandle, uint16_t handle, uint8_t opcode);
     void RegisterCallbackToATT();
     static void DeregisterCallbackToATT();
     void RegisterCallbackToConnectManager();
@@ -90,9 +115,8 @@ struct GattServerProfile::impl {
     void HandleValueConfirmationResponse(uint16_t connectHandle, int ret);
     void SendAttReadByTypeResponse(
         uint16_t connectHandle, uint16_t handle, uint8_t len, AttReadByTypeRspDataList *value, uint16_t num);
-    static bool CheckAttHandleParameter(uint16_t connectHandle, uint16_t startHandle, uint16_t endHandle, uint8_t requestId);
+    bool CheckAttHandleParameter(uint16_t connectHandle, uint16_t startHandle, uint16_t endHandle, uint8_t requestId);
     static bool CheckUuidType(uint16_t connectHandle, Uuid *uuid, AttEventData *data);
-    bool FindServiceEndingHandle(uint16_t attHandle);
     bool FindServiceByHandle(uint16_t attHandle, Uuid uuid);
     bool FindCharacteristicDeclarationByHandle(uint16_t attHandle, Uuid uuid);
     bool FindCharacteristicValueByUuid(uint16_t attHandle, Uuid uuid);
@@ -131,15 +155,24 @@ struct GattServerProfile::impl {
     void AddCccdValue(uint16_t connectHandle, uint16_t attHandle, uint16_t value);
     void DeleteCccdValue(uint16_t connectHandle);
     uint16_t GetCccdValue(uint16_t connectHandle, uint16_t attHandle);
+    bool IsClientFeaturesCharacteristic(uint16_t attHandle);
+    uint8_t GetClientFeatures(uint16_t connectHandle);
+    AttError WriteClientFeaturesProcess(uint16_t connectHandle, uint16_t attHandle, Buffer *value);
+    static void NotifyConnections(
+        const std::vector<uint16_t> &connectHandles, uint16_t handle, const GattValue &value, size_t len);
+    void SendMultipleNotification(uint16_t connectHandle, const std::vector<uint16_t> &handles,
+        std::map<std::pair<uint16_t, GattValue>, std::vector<uint16_t>> &singles);
+    void FlushNotifications();
 };
 /**
  * @brief A constructor used to create <pServerCallbackFunc> <dispatcher> and <maxMtu> instance..
  *
  * @since 6.0
  */
-GattServerProfile::GattServerProfile(
-    GattServerProfileCallback *pServerCallbackFunc, utility::Dispatcher *dispatcher, uint16_t maxMtu)
-    : pimpl(new (std::nothrow)GattServerProfile::impl(pServerCallbackFunc, dispatcher, maxMtu, *this))
+GattServerProfile::GattServerProfile(GattServerProfileCallback *pServerCallbackFunc, utility::Dispatcher *dispatcher,
+    uint16_t maxMtu, int notifyCoalesceWindow)
+    : pimpl(new (std::nothrow)GattServerProfile::impl(
+        pServerCallbackFunc, dispatcher, maxMtu, notifyCoalesceWindow, *this))
 {
     if (pimpl == nullptr) {
         LOG_ERROR("GattServerProfile get pimpl error");
@@ -154,6 +187,7 @@ GattServerProfile::GattServerProfile(
  */
 GattServerProfile::~GattServerProfile()
 {
+    pimpl->notifyTimer_->Stop();
     pimpl->DeregisterCallbackToConnectManager();
 }
 /**
@@ -165,6 +199,7 @@ void GattServerProfile::Enable() const
 {
     pimpl->requestList_.clear();
     pimpl->responseList_.clear();
+    pimpl->transactions_.clear();
     pimpl->mtuInfo_.clear();
     pimpl->RegisterCallbackToATT();
 }
@@ -175,6 +210,9 @@ void GattServerProfile::Enable() const
  */
 void GattServerProfile::Disable() const
 {
+    pimpl->notifyTimer_->Stop();
+    pimpl->notifyTimerRunning_ = false;
+    pimpl->pendingNotifications_.clear();
     pimpl->DeregisterCallbackToATT();
     pimpl->db_.RemoveAllServices();
 }
@@ -300,7 +338,7 @@ void GattServerProfile::impl::ReceiveData(
             break;
         default:
             AttError errorData = {*(uint8_t *)eventData, 0, ATT_REQUEST_NOT_SUPPORTED};
-            ATT_ErrorResponse(connectHandle, &errorData);
+            ATT_ErrorResponse(connectHandle, ATT_GetRequestBearer(connectHandle), &errorData);
             LOG_INFO("%{public}s: ATT_REQUEST_NOT_FOUND", __FUNCTION__);
             break;
     }
@@ -342,6 +380,56 @@ void GattServerProfile::impl::ReceiveResponseResultPostTask(uint16_t connectHand
         requestList_.erase(iter);
     }
 }
+/**
+ * @brief Post the task of a received request, the task runs with the bearer the request arrived on.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param task Indicates the task processing the request.
+ * @since 6.0
+ */
+void GattServerProfile::impl::PostRequestTask(uint16_t connectHandle, std::function<void()> task)
+{
+    uint8_t bearer = ATT_GetRequestBearer(connectHandle);
+    dispatcher_->PostTask([this, bearer, task]() {
+        requestBearer_ = bearer;
+        task();
+        requestBearer_ = ATT_UNENHANCED_BEARER;
+    });
+}
+/**
+ * @brief Remember a request handed to the application until it is answered.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param handle Indicates attribute handle of the request.
+ * @param opcode Indicates opcode of the request.
+ * @since 6.0
+ */
+void GattServerProfile::impl::AddTransaction(uint16_t connectHandle, uint16_t handle, uint8_t opcode)
+{
+    transactions_.emplace_back(connectHandle, handle, opcode, requestBearer_);
+}
+/**
+ * @brief Take the oldest request the application answers.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param handle Indicates attribute handle of the request.
+ * @param opcode Indicates opcode of the request.
+ * @return Returns the bearer the request arrived on.
+ * @since 6.0
+ */
+uint8_t GattServerProfile::impl::TakeTransaction(uint16_t connectHandle, uint16_t handle, uint8_t opcode)
+{
+    for (auto it = transactions_.begin(); it != transactions_.end(); it++) {
+        if (it->connectHandle_ == connectHandle && it->handle_ == handle && it->opcode_ == opcode) {
+            uint8_t bearer = it->bearer_;
+            transactions_.erase(it);
+            return bearer;
+        }
+    }
+    LOG_WARN("%{public}s: no request of opcode %hhu on handle %hu", __FUNCTION__, opcode, handle);
+
+    return ATT_UNENHANCED_BEARER;
+}
 /**
  * @brief This sub-procedure is used by the server to set the ATT_MTU to the maximum possible value.
  *
@@ -355,7 +443,7 @@ void GattServerProfile::impl::ExchangeMTUResponse(uint16_t connectHandle, uint16
     AttError errorData = {READ_BY_GROUP_TYPE_REQUEST, 0, ATT_REQUEST_NOT_SUPPORTED};
 
     if (mtu < GATT_DEFAULT_MTU) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, ATT_UNENHANCED_BEARER, &errorData);
         return;
     } else if (mtu > mtu_) {
         mtu = mtu_;
@@ -375,7 +463,7 @@ void GattServerProfile::impl::DiscoverAllPrimaryServiceResponsePostTask(uint16_t
     LOG_INFO("%{public}s", __FUNCTION__);
     uint16_t startHandle = data->attReadByGroupTypeRequest.readGroupRequest.handleRange.startHandle,
              endHandle = data->attReadByGroupTypeRequest.readGroupRequest.handleRange.endHandle;
-    dispatcher_->PostTask(
+    PostRequestTask(connectHandle,
         std::bind(&impl::DiscoverAllPrimaryServiceResponse, this, connectHandle, startHandle, endHandle));
 }
 
@@ -389,7 +477,7 @@ void GattServerProfile::impl::DiscoverAllPrimaryServiceResponse(
     uint16_t serviceNum = 0;
     AttError errorData = {READ_BY_GROUP_TYPE_REQUEST, startHandle, 0};
     AttReadGoupAttributeData serviceList[GATT_VALUE_LEN_MAX] = {{0, 0, nullptr}};
-    auto service = db_.GetServices().begin();
+    auto service = db_.GetServices().lower_bound(startHandle);
 
     if (CheckAttHandleParameter(connectHandle, startHandle, endHandle, READ_BY_GROUP_TYPE_REQUEST)) {
         return;
@@ -415,13 +503,13 @@ void GattServerProfile::impl::DiscoverAllPrimaryServiceResponse(
         }
     }
     if (serviceNum) {
-        ATT_ReadByGroupTypeResponse(connectHandle, dataLen, serviceList, serviceNum);
+        ATT_ReadByGroupTypeResponse(connectHandle, requestBearer_, dataLen, serviceList, serviceNum);
         for (int i = 0; i < serviceNum; i++) {
             free(serviceList[i].attributeValue);
         }
     } else {
         errorData.errorCode = ATT_ATTRIBUTE_NOT_FOUND;
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
 }
 /**
@@ -439,7 +527,7 @@ void GattServerProfile::impl::DiscoverPrimaryServiceByUuidResponsePostTask(
     uint16_t startHandle = data->attFindByTypeValueRequest.findByTypeValueRequest.handleRange.startHandle;
     uint16_t endHandle = data->attFindByTypeValueRequest.findByTypeValueRequest.handleRange.endHandle;
 
-    dispatcher_->PostTask(
+    PostRequestTask(connectHandle,
         std::bind(&impl::DiscoverPrimaryServiceByUuidResponse, this, connectHandle, attData, startHandle, endHandle));
 }
 
@@ -452,7 +540,7 @@ void GattServerProfile::impl::DiscoverPrimaryServiceByUuidResponse(
     uint8_t uuid128Bit[UUID_128BIT_LEN] = {0};
     AttHandleInfo handleInfoList[GATT_VALUE_LEN_MAX] = {{0, 0}};
     AttError errorData = {FIND_BY_TYPE_VALUE_REQUEST, startHandle, ATT_ATTRIBUTE_NOT_FOUND};
-    auto service = db_.GetServices().begin();
+    auto service = db_.GetServices().lower_bound(startHandle);
 
     if (CheckAttHandleParameter(connectHandle, startHandle, endHandle, FIND_BY_TYPE_VALUE_REQUEST)) {
         return;
@@ -468,20 +556,20 @@ void GattServerProfile::impl::DiscoverPrimaryServiceByUuidResponse(
     for (; service != db_.GetServices().end(); service++) {
         if (startHandle <= service->second.handle_ && service->second.uuid_.operator==(uuid) &&
             service->second.isPrimary_) {
-            handleInfoList->attHandle = service->second.handle_;
-            handleInfoList->groupEndHandle = service->second.endHandle_;
             if ((uint16_t)((listNum + sizeof(uint8_t)) * (sizeof(startHandle) + sizeof(endHandle))) >
                 GetMtuInformation(connectHandle) - 1) {
                 break;
             }
+            handleInfoList[listNum].attHandle = service->second.handle_;
+            handleInfoList[listNum].groupEndHandle = service->second.endHandle_;
             listNum++;
         }
     }
     if (listNum) {
-        ATT_FindByTypeValueResponse(connectHandle, handleInfoList, listNum);
+        ATT_FindByTypeValueResponse(connectHandle, requestBearer_, handleInfoList, listNum);
     } else {
     ATT_ERROR_RESPONSE:
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
     BufferFree(value);
 }
@@ -497,7 +585,8 @@ void GattServerProfile::impl::FindIncludedServiceResponsePostTask(uint16_t conne
     uint16_t startHandle = data->attReadByTypeRequest.readHandleRangeUuid.handleRange.startHandle;
     uint16_t endHandle = data->attReadByTypeRequest.readHandleRangeUuid.handleRange.endHandle;
 
-    dispatcher_->PostTask(std::bind(&impl::FindIncludedServiceResponse, this, connectHandle, startHandle, endHandle));
+    PostRequestTask(
+        connectHandle, std::bind(&impl::FindIncludedServiceResponse, this, connectHandle, startHandle, endHandle));
 }
 
 void GattServerProfile::impl::FindIncludedServiceResponse(
@@ -511,8 +600,9 @@ void GattServerProfile::impl::FindIncludedServiceResponse(
     if (CheckAttHandleParameter(connectHandle, startHandle, endHandle, READ_BY_TYPE_REQUEST)) {
         return;
     }
-    for (; startHandle <= endHandle; startHandle++) {
-        auto isvc = db_.GetIncludeService(startHandle);
+    auto range = db_.GetAttributeIndexes(startHandle, endHandle, GattDatabase::INCLUDE_SERVICE);
+    if (range.first != range.second) {
+        auto isvc = db_.GetIncludeService(range.first->handle_);
         if (isvc != nullptr) {
             uint8_t len = sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t);
             valueList[0].attHandle.attHandle = isvc->handle_;
@@ -531,16 +621,13 @@ void GattServerProfile::impl::FindIncludedServiceResponse(
                     valueList[0].attributeValue, len, &offset, (uint8_t *)&(uuid16bit), sizeof(uint16_t));
                 len = len + UUID_16BIT_LEN;
             }
-            ATT_ReadByTypeResponse(connectHandle, len, valueList, sizeof(uint8_t));
+            ATT_ReadByTypeResponse(connectHandle, requestBearer_, len, valueList, sizeof(uint8_t));
             free(valueList[0].attributeValue);
             return;
         }
-        if (FindServiceEndingHandle(startHandle)) {
-            break;
-        }
     }
     errorData.errorCode = ATT_ATTRIBUTE_NOT_FOUND;
-    ATT_ErrorResponse(connectHandle, &errorData);
+    ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
 }
 /**
  * @brief This sub-procedure is used by the server to respond that discover all characteristics.
@@ -554,7 +641,7 @@ void GattServerProfile::impl::DiscoverCharacteristicResponsePostTask(uint16_t co
     uint16_t startHandle = data->attReadByTypeRequest.readHandleRangeUuid.handleRange.startHandle;
     uint16_t endHandle = data->attReadByTypeRequest.readHandleRangeUuid.handleRange.endHandle;
 
-    dispatcher_->PostTask(
+    PostRequestTask(connectHandle,
         std::bind(&impl::DiscoverCharacteristicResponse, this, connectHandle, startHandle, endHandle));
 }
 
@@ -571,9 +658,10 @@ void GattServerProfile::impl::DiscoverCharacteristicResponse(
     if (CheckAttHandleParameter(connectHandle, startHandle, endHandle, READ_BY_TYPE_REQUEST)) {
         return;
     }
-    for (; startHandle <= endHandle; startHandle++) {
+    auto range = db_.GetAttributeIndexes(startHandle, endHandle, GattDatabase::CHARACTERISTIC);
+    for (auto index = range.first; index != range.second; index++) {
         uint8_t offset = 0;
-        auto characteristic = db_.GetCharacteristic(startHandle + MIN_ATTRIBUTE_HANDLE);
+        auto characteristic = db_.GetCharacteristic(index->handle_ + MIN_ATTRIBUTE_HANDLE);
         if (characteristic != nullptr) {
             uint16_t uuidLen = characteristic->uuid_.GetUuidType();
             if (uuidLen != UUID_16BIT_LEN) {
@@ -588,13 +676,11 @@ void GattServerProfile::impl::DiscoverCharacteristicResponse(
             if (characteristic->valueHandle_ <= endHandle &&
                 groupSize <= GetMtuInformation(connectHandle) - sizeof(groupSize)) {
                 AssembleAttReadByTypeRspCharacteristicPackage(
-                    valueList, startHandle + MIN_ATTRIBUTE_HANDLE, valueNum, &offset);
+                    valueList, index->handle_ + MIN_ATTRIBUTE_HANDLE, valueNum, &offset);
                 valueNum++;
             } else {
                 break;
             }
-        } else if (FindServiceEndingHandle(startHandle)) {
-            break;
         }
     }
     SendAttReadByTypeResponse(connectHandle, startHandle, dataLen, valueList, valueNum);
@@ -612,7 +698,7 @@ void GattServerProfile::impl::DiscoverAllCharacteristicDescriptorResponsePostTas
     uint16_t startHandle = data->attFindInformationRequest.findInformationRequest.startHandle;
     uint16_t endHandle = data->attFindInformationRequest.findInformationRequest.endHandle;
 
-    dispatcher_->PostTask(
+    PostRequestTask(connectHandle,
         std::bind(&impl::DiscoverAllCharacteristicDescriptorResponse, this, connectHandle, startHandle, endHandle));
 }
 
@@ -630,19 +716,17 @@ void GattServerProfile::impl::DiscoverAllCharacteristicDescriptorResponse(
     if (CheckAttHandleParameter(connectHandle, attHandle, endHandle, FIND_INFORMATION_REQUEST)) {
         return;
     }
-    for (; attHandle <= endHandle; attHandle++) {
-        if (db_.GetService(attHandle) != nullptr) {
-            AssembleAttFindInforRspSvcPackage(handleUUIDPairs, attHandle, pairNum, &uuidLen);
-        } else if (db_.GetDescriptor(attHandle) != nullptr) {
-            AssembleAttFindInforRspDescPackage(handleUUIDPairs, attHandle, pairNum, &uuidLen);
-        } else if (db_.GetCharacteristic(attHandle) != nullptr) {
-            AssembleAttFindInforRspCharacteristicValPackage(handleUUIDPairs, attHandle, pairNum, &uuidLen);
-        } else if (db_.GetCharacteristic(attHandle + MIN_ATTRIBUTE_HANDLE) != nullptr) {
-            AssembleAttFindInforRspCharacteristicPackage(handleUUIDPairs, attHandle, pairNum, &uuidLen);
+    auto range = db_.GetAttributeIndexes(attHandle, endHandle);
+    for (auto index = range.first; index != range.second; index++) {
+        if (index->type_ == GattDatabase::SERVICE) {
+            AssembleAttFindInforRspSvcPackage(handleUUIDPairs, index->handle_, pairNum, &uuidLen);
+        } else if (index->type_ == GattDatabase::DESCRIPTOR) {
+            AssembleAttFindInforRspDescPackage(handleUUIDPairs, index->handle_, pairNum, &uuidLen);
+        } else if (index->type_ == GattDatabase::CHARACTERISTIC_VALUE) {
+            AssembleAttFindInforRspCharacteristicValPackage(handleUUIDPairs, index->handle_, pairNum, &uuidLen);
+        } else if (index->type_ == GattDatabase::CHARACTERISTIC) {
+            AssembleAttFindInforRspCharacteristicPackage(handleUUIDPairs, index->handle_, pairNum, &uuidLen);
         } else {
-            if (FindServiceEndingHandle(attHandle)) {
-                break;
-            }
             continue;
         }
         if (preUuidLen != 0 && preUuidLen != uuidLen) {
@@ -658,9 +742,10 @@ void GattServerProfile::impl::DiscoverAllCharacteristicDescriptorResponse(
     }
 
     if (pairNum) {
-        ATT_FindInformationResponse(connectHandle, handleUUIDPairs->uuid.type, handleUUIDPairs, pairNum);
+        ATT_FindInformationResponse(
+            connectHandle, requestBearer_, handleUUIDPairs->uuid.type, handleUUIDPairs, pairNum);
     } else {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
 }
 /**
@@ -672,7 +757,7 @@ void GattServerProfile::impl::DiscoverAllCharacteristicDescriptorResponse(
  */
 void GattServerProfile::impl::ReadValueResponsePostTask(uint16_t connectHandle, uint16_t attHandle)
 {
-    dispatcher_->PostTask(std::bind(&impl::ReadValueResponse, this, connectHandle, attHandle));
+    PostRequestTask(connectHandle, std::bind(&impl::ReadValueResponse, this, connectHandle, attHandle));
 }
 
 void GattServerProfile::impl::ReadValueResponse(uint16_t connectHandle, uint16_t attHandle)
@@ -684,7 +769,7 @@ void GattServerProfile::impl::ReadValueResponse(uint16_t connectHandle, uint16_t
     if (db_.GetService(attHandle) != nullptr) {
         value = AssembleServicePackage(attHandle);
         if (value != nullptr) {
-            ATT_ReadResponse(connectHandle, value);
+            ATT_ReadResponse(connectHandle, requestBearer_, value);
             BufferFree(value);
         } else {
             errorData.errorCode = ATT_INVALID_HANDLE;
@@ -693,16 +778,23 @@ void GattServerProfile::impl::ReadValueResponse(uint16_t connectHandle, uint16_t
         if (DescriptorPropertyIsReadable(attHandle)) {
             value = AssembleDescriptorPackage(connectHandle, attHandle);
             if (value != nullptr) {
-                ATT_ReadResponse(connectHandle, value);
+                ATT_ReadResponse(connectHandle, requestBearer_, value);
                 BufferFree(value);
             } else {
+                AddTransaction(connectHandle, attHandle, READ_REQUEST);
                 pServerCallBack_->OnDescriptorReadEvent(connectHandle, attHandle);
             }
         } else {
             errorData.errorCode = ATT_READ_NOT_PERMITTED;
         }
+    } else if (IsClientFeaturesCharacteristic(attHandle)) {
+        uint8_t features = GetClientFeatures(connectHandle);
+        AddTransaction(connectHandle, attHandle, READ_REQUEST);
+        profile_->SendReadCharacteristicValueResp(connectHandle, attHandle,
+            GattServiceBase::BuildGattValue(&features, sizeof(features)), sizeof(features), GATT_SUCCESS);
     } else if (db_.GetCharacteristic(attHandle) != nullptr) {
         if (CharacteristicPropertyIsReadable(attHandle)) {
+            AddTransaction(connectHandle, attHandle, READ_REQUEST);
             pServerCallBack_->OnReadCharacteristicValueEvent(connectHandle, attHandle);
         } else {
             errorData.errorCode = ATT_READ_NOT_PERMITTED;
@@ -710,7 +802,7 @@ void GattServerProfile::impl::ReadValueResponse(uint16_t connectHandle, uint16_t
     } else if (db_.GetCharacteristic(attHandle + MIN_ATTRIBUTE_HANDLE) != nullptr) {
         value = AssembleCharacteristicPackage(attHandle + MIN_ATTRIBUTE_HANDLE);
         if (value != nullptr) {
-            ATT_ReadResponse(connectHandle, value);
+            ATT_ReadResponse(connectHandle, requestBearer_, value);
             BufferFree(value);
         } else {
             errorData.errorCode = ATT_INVALID_HANDLE;
@@ -719,7 +811,7 @@ void GattServerProfile::impl::ReadValueResponse(uint16_t connectHandle, uint16_t
         errorData.errorCode = ATT_INVALID_HANDLE;
     }
     if (errorData.errorCode) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
 }
 /**
@@ -737,8 +829,9 @@ void GattServerProfile::impl::ReadUsingCharacteristicByUuidResponsePostTask(uint
     if (CheckUuidType(connectHandle, &uuid, data)) {
         return;
     }
-    dispatcher_->PostTask(std::bind(
-        &impl::ReadUsingCharacteristicByUuidResponseStep1, this, connectHandle, startHandle, endHandle, uuid));
+    PostRequestTask(connectHandle,
+        std::bind(
+            &impl::ReadUsingCharacteristicByUuidResponseStep1, this, connectHandle, startHandle, endHandle, uuid));
 }
 
 void GattServerProfile::impl::ReadUsingCharacteristicByUuidResponseStep1(
@@ -754,10 +847,11 @@ void GattServerProfile::impl::ReadUsingCharacteristicByUuidResponseStep1(
     if (CheckAttHandleParameter(connectHandle, startHandle, endHandle, READ_BY_TYPE_REQUEST)) {
         return;
     }
-    for (; startHandle <= endHandle; startHandle++) {
+    auto range = db_.GetAttributeIndexes(startHandle, endHandle);
+    for (auto index = range.first; index != range.second; index++) {
         uint8_t offset = 0;
-        RetVal ret =
-            ReadUsingCharacteristicByUuidResponseStep2(connectHandle, startHandle, valueNum, valueList, uuid, &offset);
+        RetVal ret = ReadUsingCharacteristicByUuidResponseStep2(
+            connectHandle, index->handle_, valueNum, valueList, uuid, &offset);
         if (ret == RET_RETURN) {
             return;
         } else if (ret == RET_BREAK) {
@@ -791,28 +885,31 @@ RetVal GattServerProfile::impl::ReadUsingCharacteristicByUuidResponseStep2(uint1
     } else if (FindCharacteristicDescriptorByUuid(startHandle, uuid)) {
         if (DescriptorPropertyIsReadable(startHandle)) {
             if (AssembleAttReadByTypeRspDescPackage(list, connectHandle, startHandle, num, offset)) {
+                AddTransaction(connectHandle, startHandle, READ_BY_TYPE_REQUEST);
                 pServerCallBack_->OnReadUsingCharacteristicUuidEvent(connectHandle, startHandle);
                 ret = RET_RETURN;
             }
         } else {
-            ATT_ErrorResponse(connectHandle, &errorData);
+            ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
             ret = RET_RETURN;
         }
     } else if (FindCharacteristicValueByUuid(startHandle, uuid)) {
-        if (CharacteristicPropertyIsReadable(startHandle)) {
+        if (IsClientFeaturesCharacteristic(startHandle)) {
+            uint8_t features = GetClientFeatures(connectHandle);
+            AddTransaction(connectHandle, startHandle, READ_BY_TYPE_REQUEST);
+            profile_->SendReadUsingCharacteristicValueResp(connectHandle, startHandle,
+                GattServiceBase::BuildGattValue(&features, sizeof(features)), sizeof(features), GATT_SUCCESS);
+        } else if (CharacteristicPropertyIsReadable(startHandle)) {
+            AddTransaction(connectHandle, startHandle, READ_BY_TYPE_REQUEST);
             pServerCallBack_->OnReadUsingCharacteristicUuidEvent(connectHandle, startHandle);
         } else {
-            ATT_ErrorResponse(connectHandle, &errorData);
+            ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
         }
         ret = RET_RETURN;
     } else if (FindCharacteristicDeclarationByHandle(startHandle, uuid)) {
         AssembleAttReadByTypeRspCharacteristicPackage(list, startHandle + MIN_ATTRIBUTE_HANDLE, num, offset);
     } else {
-        if (FindServiceEndingHandle(startHandle)) {
-            ret = RET_BREAK;
-        } else {
-            ret = RET_CONTINUE;
-        }
+        ret = RET_CONTINUE;
     }
 
     return ret;
@@ -828,7 +925,7 @@ void GattServerProfile::impl::ReadBlobValueResponsePostTask(uint16_t connectHand
 {
     uint16_t attHandle = data->attReadBlobRequest.readBlob.attHandle;
     uint16_t offset = data->attReadBlobRequest.readBlob.offset;
-    dispatcher_->PostTask(std::bind(&impl::ReadBlobValueResponse, this, connectHandle, attHandle, offset));
+    PostRequestTask(connectHandle, std::bind(&impl::ReadBlobValueResponse, this, connectHandle, attHandle, offset));
 }
 
 void GattServerProfile::impl::ReadBlobValueResponse(uint16_t connectHandle, uint16_t attHandle, uint16_t offset)
@@ -873,11 +970,12 @@ void GattServerProfile::impl::ReadBlobValueResponse(uint16_t connectHandle, uint
         }
     }
     if (errorData.errorCode) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     } else if (buffer != nullptr) {
-        ATT_ReadBlobResponse(connectHandle, buffer);
+        ATT_ReadBlobResponse(connectHandle, requestBearer_, buffer);
         BufferFree(buffer);
     } else {
+        AddTransaction(connectHandle, attHandle, READ_BLOB_REQUEST);
         pServerCallBack_->ReadBlobValueEvent(connectHandle, attHandle);
     }
 }
@@ -891,7 +989,8 @@ void GattServerProfile::impl::ReadMultipleCharacteristicValueResponsePostTask(
     uint16_t connectHandle, AttEventData *data, Buffer *value)
 {
     Buffer *attData = BufferRefMalloc(value);
-    dispatcher_->PostTask(std::bind(&impl::ReadMultipleCharacteristicValueResponse, this, connectHandle, attData));
+    PostRequestTask(
+        connectHandle, std::bind(&impl::ReadMultipleCharacteristicValueResponse, this, connectHandle, attData));
 }
 
 void GattServerProfile::impl::ReadMultipleCharacteristicValueResponse(uint16_t connectHandle, Buffer *value)
@@ -912,7 +1011,7 @@ void GattServerProfile::impl::WriteValueResponsePostTask(uint16_t connectHandle,
     Buffer *attData = BufferRefMalloc(value);
     uint16_t attHandle = data->attWriteRequest.writeRequest.attHandle;
 
-    dispatcher_->PostTask(std::bind(&impl::WriteValueResponse, this, connectHandle, attHandle, attData));
+    PostRequestTask(connectHandle, std::bind(&impl::WriteValueResponse, this, connectHandle, attHandle, attData));
 }
 
 void GattServerProfile::impl::WriteValueResponse(uint16_t connectHandle, uint16_t attHandle, Buffer *value)
@@ -928,9 +1027,12 @@ void GattServerProfile::impl::WriteValueResponse(uint16_t connectHandle, uint16_
         } else {
             errorData.errorCode = ATT_WRITE_NOT_PERMITTED;
         }
+    } else if (IsClientFeaturesCharacteristic(attHandle)) {
+        errorData = WriteClientFeaturesProcess(connectHandle, attHandle, value);
     } else if (db_.GetCharacteristic(attHandle) != nullptr) {
         if (CharacteristicPropertyIsWritable(attHandle)) {
             auto cccPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(value), BufferGetSize(value));
+            AddTransaction(connectHandle, attHandle, WRITE_REQUEST);
             pServerCallBack_->OnWriteCharacteristicValueEvent(connectHandle, attHandle, cccPtr, BufferGetSize(value));
         } else {
             errorData.errorCode = ATT_WRITE_NOT_PERMITTED;
@@ -942,7 +1044,7 @@ void GattServerProfile::impl::WriteValueResponse(uint16_t connectHandle, uint16_
     }
 
     if (errorData.errorCode) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
     BufferFree(value);
 }
@@ -993,7 +1095,7 @@ void GattServerProfile::impl::WriteLongCharacteristicValueResponsePostTask(
     uint16_t attHandle = data->attPrepareWriteResponse.prepareWrite.handleValue.attHandle;
     uint16_t offset = data->attPrepareWriteResponse.prepareWrite.offset;
 
-    dispatcher_->PostTask(
+    PostRequestTask(connectHandle,
         std::bind(&impl::WriteLongCharacteristicValueResponse, this, connectHandle, attHandle, offset, attData));
 }
 
@@ -1009,6 +1111,7 @@ void GattServerProfile::impl::WriteLongCharacteristicValueResponse(
     } else if (db_.GetDescriptor(attHandle) != nullptr) {
         if (DescriptorPropertyIsWritable(attHandle)) {
             auto sharedPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(value), len);
+            AddTransaction(connectHandle, attHandle, PREPARE_WRITE_REQUEST);
             pServerCallBack_->OnPrepareWriteValueEvent(connectHandle, attHandle, offset, sharedPtr, len);
         } else {
             errorData.errorCode = ATT_WRITE_NOT_PERMITTED;
@@ -1016,6 +1119,7 @@ void GattServerProfile::impl::WriteLongCharacteristicValueResponse(
     } else if (db_.GetCharacteristic(attHandle) != nullptr) {
         if (CharacteristicPropertyIsWritable(attHandle)) {
             auto sharedPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(value), len);
+            AddTransaction(connectHandle, attHandle, PREPARE_WRITE_REQUEST);
             pServerCallBack_->OnPrepareWriteValueEvent(connectHandle, attHandle, offset, sharedPtr, len);
         } else {
             errorData.errorCode = ATT_WRITE_NOT_PERMITTED;
@@ -1027,7 +1131,7 @@ void GattServerProfile::impl::WriteLongCharacteristicValueResponse(
     }
 
     if (errorData.errorCode) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
 }
 /**
@@ -1040,12 +1144,13 @@ void GattServerProfile::impl::WriteLongCharacteristicValueResponse(
 void GattServerProfile::impl::ExecuteWriteResponsePostTask(uint16_t connectHandle, AttEventData *data)
 {
     bool flag = data->attExecuteWriteRequest.excuteWrite.flag;
-    dispatcher_->PostTask(std::bind(&impl::ExecuteWriteResponse, this, connectHandle, flag));
+    PostRequestTask(connectHandle, std::bind(&impl::ExecuteWriteResponse, this, connectHandle, flag));
 }
 
 void GattServerProfile::impl::ExecuteWriteResponse(uint16_t connectHandle, bool flag)
 {
     LOG_INFO("%{public}s", __FUNCTION__);
+    AddTransaction(connectHandle, INVALID_ATTRIBUTE_HANDLE, EXECUTE_WRITE_REQUEST);
     pServerCallBack_->OnExecuteWriteValueEvent(connectHandle, flag);
 }
 /**
@@ -1086,10 +1191,10 @@ void GattServerProfile::impl::SendAttReadByTypeResponse(
     AttError errorData = {READ_BY_TYPE_REQUEST, handle, ATT_ATTRIBUTE_NOT_FOUND};
 
     if (num) {
-        ATT_ReadByTypeResponse(connectHandle, len, value, num);
+        ATT_ReadByTypeResponse(connectHandle, requestBearer_, len, value, num);
         FreeDataPackage(value, num);
     } else {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
     }
 }
 /**
@@ -1109,7 +1214,7 @@ bool GattServerProfile::impl::CheckAttHandleParameter(
     AttError errorData = {requestId, startHandle, ATT_INVALID_HANDLE};
 
     if (startHandle == INVALID_ATTRIBUTE_HANDLE || startHandle > endHandle) {
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, requestBearer_, &errorData);
         result = true;
     }
 
@@ -1137,25 +1242,7 @@ bool GattServerProfile::impl::CheckUuidType(uint16_t connectHandle, Uuid *uuid,
         errorData.reqOpcode = READ_BY_TYPE_REQUEST;
         errorData.errorCode = ATT_ATTRIBUTE_NOT_FOUND;
         errorData.attHandleInError = data->attReadByTypeRequest.readHandleRangeUuid.handleRange.startHandle;
-        ATT_ErrorResponse(connectHandle, &errorData);
-        result = true;
-    }
-
-    return result;
-}
-/**
- * @brief Check if the handle is an end handle.
- *
- * @param attHandle Indicates attribute start handle.
- * @return Returns true if the attHandle is ending handle.
- * @since 6.0
- */
-bool GattServerProfile::impl::FindServiceEndingHandle(uint16_t attHandle)
-{
-    bool result = false;
-
-    if (db_.GetServices().begin() == db_.GetServices().end() ||
-        attHandle > db_.GetServices().rbegin()->second.endHandle_ || attHandle == MAX_ATTRIBUTE_HANDLE) {
+        ATT_ErrorResponse(connectHandle, ATT_GetRequestBearer(connectHandle), &errorData);
         result = true;
     }
 
@@ -1641,10 +1728,11 @@ AttError GattServerProfile::impl::WriteDescriptorProcess(uint16_t connectHandle,
                 return errorData;
             }
             AddCccdValue(connectHandle, attHandle, cccVal);
-            ATT_WriteResponse(connectHandle);
+            ATT_WriteResponse(connectHandle, requestBearer_);
         }
     } else {
         auto descPtr = GattServiceBase::BuildGattValue((uint8_t *)BufferPtr(value), BufferGetSize(value));
+        AddTransaction(connectHandle, attHandle, WRITE_REQUEST);
         pServerCallBack_->OnDescriptorWriteEvent(connectHandle, attHandle, descPtr, BufferGetSize(value));
     }
 
@@ -1711,6 +1799,18 @@ void GattServerProfile::impl::DeleteList(uint16_t connectHandle)
             respList++;
         }
     }
+
+    transactions_.remove_if(
+        [connectHandle](const ServerTransaction &transaction) { return transaction.connectHandle_ == connectHandle; });
+
+    auto pending = pendingNotifications_.begin();
+    while (pending != pendingNotifications_.end()) {
+        if (pending->first.second == connectHandle) {
+            pending = pendingNotifications_.erase(pending);
+        } else {
+            pending++;
+        }
+    }
 }
 /**
  * @brief Add new device to list.
@@ -1776,6 +1876,7 @@ void GattServerProfile::impl::DeleteCccdValue(uint16_t connectHandle)
                 iter->second.cccd_[num].valHandle_ = INVALID_ATTRIBUTE_HANDLE;
                 iter->second.cccd_[num].value_ = 0x00;
             }
+            iter->second.clientFeatures_ = 0;
         }
     }
 }
@@ -1803,6 +1904,184 @@ uint16_t GattServerProfile::impl::GetCccdValue(uint16_t connectHandle, uint16_t
         __FUNCTION__, connectHandle, attHandle, ret);
     return ret;
 }
+/**
+ * @brief Check if the handle is the client supported features value of generic attribute service.
+ *
+ * @param attHandle Indicates characteristic value handle.
+ * @return Returns true if the handle is the client supported features value.
+ * @since 6.0
+ */
+bool GattServerProfile::impl::IsClientFeaturesCharacteristic(uint16_t attHandle)
+{
+    auto index = db_.GetAttributeIndex(attHandle);
+    if (index == nullptr || index->type_ != GattDatabase::CHARACTERISTIC_VALUE) {
+        return false;
+    }
+
+    auto service = db_.GetService(index->serviceHandle_);
+    auto characteristic = db_.GetCharacteristic(attHandle);
+    return service != nullptr && characteristic != nullptr &&
+           service->uuid_ == Uuid::ConvertFrom16Bits(UUID_GENERIC_ATTRIBUTE_SERVICE) &&
+           characteristic->uuid_ == Uuid::ConvertFrom16Bits(UUID_CLIENT_SUPPORTED_FEATURES);
+}
+/**
+ * @brief Get client supported features written by the peer.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @return Returns client supported features.
+ * @since 6.0
+ */
+uint8_t GattServerProfile::impl::GetClientFeatures(uint16_t connectHandle)
+{
+    for (auto &dev : devList_) {
+        if (connectHandle == dev.first) {
+            return dev.second.clientFeatures_;
+        }
+    }
+    return 0;
+}
+/**
+ * @brief This sub-procedure is used to respond that write client supported features.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param attHandle Indicates characteristic value handle.
+ * @param value Indicates value of the schedule settings.
+ * @since 6.0
+ */
+AttError GattServerProfile::impl::WriteClientFeaturesProcess(uint16_t connectHandle, uint16_t attHandle, Buffer *value)
+{
+    AttError errorData = {WRITE_REQUEST, attHandle, 0};
+
+    if (BufferGetSize(value) == 0) {
+        errorData.errorCode = ATT_INVALID_ATTRIBUTE_VALUE_LENGTH;
+        return errorData;
+    }
+
+    for (auto &dev : devList_) {
+        if (connectHandle == dev.first) {
+            // a client shall not clear a feature bit it has set
+            dev.second.clientFeatures_ |= ((uint8_t *)BufferPtr(value))[0];
+            break;
+        }
+    }
+    ATT_WriteResponse(connectHandle, requestBearer_);
+
+    return errorData;
+}
+/**
+ * @brief Send one notification value to several connections sharing a single buffer.
+ *
+ * @param connectHandles Indicates identify the subscribed connections.
+ * @param handle Indicates value handle.
+ * @param value Indicates value of the schedule settings.
+ * @param len Indicates size of value.
+ * @since 6.0
+ */
+void GattServerProfile::impl::NotifyConnections(
+    const std::vector<uint16_t> &connectHandles, uint16_t handle, const GattValue &value, size_t len)
+{
+    if (connectHandles.empty()) {
+        return;
+    }
+
+    Buffer *buffer = GattServiceBase::BuildBuffer(value->get(), len);
+    if (buffer != nullptr) {
+        ATT_HandleValueNotificationList(connectHandles.data(), (uint16_t)connectHandles.size(), handle, buffer);
+        BufferFree(buffer);
+    }
+}
+/**
+ * @brief Pack pending values of one connection into multiple handle value notifications.
+ *
+ * @param connectHandle Indicates identify a connection.
+ * @param handles Indicates value handles pending for the connection.
+ * @param singles Indicates (value handle, value) <-> connections, for values too long to be packed.
+ * @since 6.0
+ */
+void GattServerProfile::impl::SendMultipleNotification(uint16_t connectHandle, const std::vector<uint16_t> &handles,
+    std::map<std::pair<uint16_t, GattValue>, std::vector<uint16_t>> &singles)
+{
+    static const size_t tupleHeaderSize = sizeof(uint16_t) + sizeof(uint16_t);
+    static const uint8_t byteBits = 8;
+    size_t maxLen = GetMtuInformation(connectHandle) - sizeof(uint8_t);
+    std::vector<uint8_t> tuples;
+    tuples.reserve(maxLen);
+
+    auto send = [connectHandle, &tuples]() {
+        if (tuples.empty()) {
+            return;
+        }
+        Buffer *buffer = GattServiceBase::BuildBuffer(tuples.data(), tuples.size());
+        if (buffer != nullptr) {
+            ATT_MultipleHandleValueNotification(connectHandle, buffer);
+            BufferFree(buffer);
+        }
+        tuples.clear();
+    };
+
+    for (auto handle : handles) {
+        auto &notification = pendingNotifications_[std::make_pair(handle, connectHandle)];
+        if (tupleHeaderSize + notification.len_ > maxLen) {
+            // a tuple cannot span pdus, send it on its own where it is truncated to the mtu
+            singles[std::make_pair(handle, notification.value_)].push_back(connectHandle);
+            continue;
+        }
+        if (tuples.size() + tupleHeaderSize + notification.len_ > maxLen) {
+            send();
+        }
+        tuples.push_back((uint8_t)handle);
+        tuples.push_back((uint8_t)(handle >> byteBits));
+        tuples.push_back((uint8_t)notification.len_);
+        tuples.push_back((uint8_t)(notification.len_ >> byteBits));
+        tuples.insert(tuples.end(), notification.value_->get(), notification.value_->get() + notification.len_);
+    }
+    send();
+}
+/**
+ * @brief Send the values coalesced during the window to their subscribers.
+ *
+ * @since 6.0
+ */
+void GattServerProfile::impl::FlushNotifications()
+{
+    LOG_INFO("%{public}s: pending notification num is %{public}zu.", __FUNCTION__, pendingNotifications_.size());
+    notifyTimerRunning_ = false;
+    // (value handle, value) <-> connections notified with a single handle pdu, sharing one buffer
+    std::map<std::pair<uint16_t, GattValue>, std::vector<uint16_t>> singles;
+    // value <-> length, the same value is always sent with the same length
+    std::map<GattValue, size_t> lengths;
+    // connection handle <-> value handles packed into multiple handle value notifications
+    std::map<uint16_t, std::vector<uint16_t>> batches;
+
+    for (auto &notification : pendingNotifications_) {
+        uint16_t handle = notification.first.first;
+        uint16_t connectHandle = notification.first.second;
+        if (GetCccdValue(connectHandle, handle + MIN_ATTRIBUTE_HANDLE) != GATT_NOTIFICATION_VALUE) {
+            continue;
+        }
+        lengths[notification.second.value_] = notification.second.len_;
+        if (GetClientFeatures(connectHandle) & GATT_CLIENT_FEATURE_MULTIPLE_HANDLE_VALUE_NOTIFICATION) {
+            batches[connectHandle].push_back(handle);
+        } else {
+            singles[std::make_pair(handle, notification.second.value_)].push_back(connectHandle);
+        }
+    }
+
+    for (auto &batch : batches) {
+        if (batch.second.size() == 1) {
+            uint16_t handle = batch.second.front();
+            auto &notification = pendingNotifications_[std::make_pair(handle, batch.first)];
+            singles[std::make_pair(handle, notification.value_)].push_back(batch.first);
+        } else {
+            SendMultipleNotification(batch.first, batch.second, singles);
+        }
+    }
+
+    for (auto &single : singles) {
+        NotifyConnections(single.second, single.first.first, single.first.second, lengths[single.first.second]);
+    }
+    pendingNotifications_.clear();
+}
 /**
  * @brief Indicates connect or disconnect.
  *
@@ -2002,6 +2281,10 @@ void GattServerProfile::SendNotification(
     uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len) const
 {
     LOG_INFO("%{public}s: connectHandle is %hu, handle is is %hu.", __FUNCTION__, connectHandle, handle);
+    if (pimpl->notifyCoalesceWindow_ > 0) {
+        SendNotifications(std::vector<uint16_t>{connectHandle}, handle, value, len);
+        return;
+    }
     if (pimpl->GetCccdValue(connectHandle, handle + MIN_ATTRIBUTE_HANDLE) == GATT_NOTIFICATION_VALUE) {
         Buffer *buffer = GattServiceBase::BuildBuffer(value->get(), len);
         if (buffer != nullptr) {
@@ -2010,6 +2293,43 @@ void GattServerProfile::SendNotification(
         }
     }
 }
+/**
+ * @brief This sub-procedure is used to send one notification to several connections.
+ *
+ * @param connectHandles Indicates identify the connections.
+ * @param handle Indicates value handle.
+ * @param value Indicates value of the schedule settings.
+ * @param len Indicates size of value.
+ * @since 6.0
+ */
+void GattServerProfile::SendNotifications(
+    const std::vector<uint16_t> &connectHandles, uint16_t handle, const GattValue &value, size_t len) const
+{
+    LOG_INFO("%{public}s: connection num is %{public}zu, handle is %hu.", __FUNCTION__, connectHandles.size(), handle);
+    if (pimpl->notifyCoalesceWindow_ <= 0) {
+        std::vector<uint16_t> subscribers;
+        for (auto connectHandle : connectHandles) {
+            if (pimpl->GetCccdValue(connectHandle, handle + MIN_ATTRIBUTE_HANDLE) == GATT_NOTIFICATION_VALUE) {
+                subscribers.push_back(connectHandle);
+            }
+        }
+        pimpl->NotifyConnections(subscribers, handle, value, len);
+        return;
+    }
+
+    // latest value per connection wins, connections given the same value still share one buffer when flushed
+    for (auto connectHandle : connectHandles) {
+        auto &pending = pimpl->pendingNotifications_[std::make_pair(handle, connectHandle)];
+        pending.value_ = value;
+        pending.len_ = len;
+    }
+    if (!pimpl->notifyTimerRunning_) {
+        pimpl->notifyTimerRunning_ = pimpl->notifyTimer_->Start(pimpl->notifyCoalesceWindow_);
+        if (!pimpl->notifyTimerRunning_) {
+            pimpl->FlushNotifications();
+        }
+    }
+}
 /**
  * @brief This sub-procedure is used to send indication.
  *
@@ -2065,18 +2385,19 @@ void GattServerProfile::SendReadUsingCharacteristicValueResp(
     LOG_INFO("%{public}s: connectHandle is %hu, result is %{public}d.", __FUNCTION__, connectHandle, result);
     AttReadByTypeRspDataList valueList[GATT_VALUE_LEN_MAX] = {{{0}, nullptr}};
     AttError errorData = {READ_REQUEST, handle, 0};
+    uint8_t bearer = pimpl->TakeTransaction(connectHandle, handle, READ_BY_TYPE_REQUEST);
 
     if (result == GATT_SUCCESS) {
         Buffer *buffer = GattServiceBase::BuildBuffer(value->get(), len);
         if (buffer != nullptr) {
             valueList->attHandle.attHandle = handle;
             valueList->attributeValue = (uint8_t *)BufferPtr(buffer);
-            ATT_ReadByTypeResponse(connectHandle, len + sizeof(handle), valueList, sizeof(uint8_t));
+            ATT_ReadByTypeResponse(connectHandle, bearer, len + sizeof(handle), valueList, sizeof(uint8_t));
             BufferFree(buffer);
         }
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, bearer, &errorData);
     }
 }
 /**
@@ -2094,16 +2415,17 @@ void GattServerProfile::SendReadBlobValueResp(
 {
     LOG_INFO("%{public}s: connectHandle is %hu, result is %{public}d.", __FUNCTION__, connectHandle, result);
     AttError errorData = {READ_BLOB_REQUEST, handle, 0};
+    uint8_t bearer = pimpl->TakeTransaction(connectHandle, handle, READ_BLOB_REQUEST);
 
     if (result == GATT_SUCCESS) {
         Buffer *buffer = GattServiceBase::BuildBuffer(value->get(), len);
         if (buffer != nullptr) {
-            ATT_ReadBlobResponse(connectHandle, buffer);
+            ATT_ReadBlobResponse(connectHandle, bearer, buffer);
             BufferFree(buffer);
         }
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, bearer, &errorData);
     }
 }
 /**
@@ -2119,11 +2441,12 @@ void GattServerProfile::SendWriteCharacteristicValueResp(
 {
     LOG_INFO("%{public}s: connectHandle is %hu, result is %{public}d.", __FUNCTION__, connectHandle, result);
     AttError errorData = {WRITE_REQUEST, handle, 0};
+    uint8_t bearer = pimpl->TakeTransaction(connectHandle, handle, WRITE_REQUEST);
     if (result == GATT_SUCCESS) {
-        ATT_WriteResponse(connectHandle);
+        ATT_WriteResponse(connectHandle, bearer);
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, bearer, &errorData);
     }
 }
 /**
@@ -2142,6 +2465,7 @@ void GattServerProfile::SendReadDescriptorResp(
     Buffer *buffer = nullptr;
     AttError errorData = {READ_REQUEST, handle, 0};
     uint16_t bufSize = pimpl->GetMtuInformation(connectHandle) - sizeof(uint8_t);
+    uint8_t bearer = pimpl->TakeTransaction(connectHandle, handle, READ_REQUEST);
 
     if (result == GATT_SUCCESS) {
         if (len > bufSize) {
@@ -2151,12 +2475,12 @@ void GattServerProfile::SendReadDescriptorResp(
         }
         buffer = GattServiceBase::BuildBuffer(value->get(), len);
         if (buffer != nullptr) {
-            ATT_ReadResponse(connectHandle, buffer);
+            ATT_ReadResponse(connectHandle, bearer, buffer);
             BufferFree(buffer);
         }
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, bearer, &errorData);
     }
 }
 /**
@@ -2170,11 +2494,12 @@ void GattServerProfile::SendReadDescriptorResp(
 void GattServerProfile::SendWriteDescriptorResp(uint16_t connectHandle, uint16_t handle, int result) const
 {
     AttError errorData = {WRITE_REQUEST, handle, 0};
+    uint8_t bearer = pimpl->TakeTransaction(connectHandle, handle, WRITE_REQUEST);
     if (result == GATT_SUCCESS) {
-        ATT_WriteResponse(connectHandle);
+        ATT_WriteResponse(connectHandle, bearer);
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(connectHandle, &errorData);
+        ATT_ErrorResponse(connectHandle, bearer, &errorData);
     }
 }
 /**
@@ -2197,16 +2522,17 @@ void GattServerProfile::SendPrepareWriteValueResp(
         result);
     AttError errorData = {READ_BLOB_REQUEST, param.handle_, 0};
     AttReadBlobReqPrepareWriteValue attReadBlobObj = {param.handle_, param.offset_};
+    uint8_t bearer = pimpl->TakeTransaction(param.connectHandle_, param.handle_, PREPARE_WRITE_REQUEST);
 
     if (result == GATT_SUCCESS) {
         Buffer *buffer = GattServiceBase::BuildBuffer(value->get(), len);
         if (buffer != nullptr) {
-            ATT_PrepareWriteResponse(param.connectHandle_, attReadBlobObj, buffer);
+            ATT_PrepareWriteResponse(param.connectHandle_, bearer, attReadBlobObj, buffer);
             BufferFree(buffer);
         }
     } else {
         errorData.errorCode = ConvertResponseErrorCode(result);
-        ATT_ErrorResponse(param.connectHandle_, &errorData);
+        ATT_ErrorResponse(param.connectHandle_, bearer, &errorData);
     }
 }
 /**
@@ -2215,10 +2541,11 @@ void GattServerProfile::SendPrepareWriteValueResp(
  * @param connectHandle Indicates identify a connection.
  * @since 6.0
  */
-void GattServerProfile::SendExecuteWriteValueResp(uint16_t connectHandle)
+void GattServerProfile::SendExecuteWriteValueResp(uint16_t connectHandle) const
 {
     LOG_INFO("%{public}s: connectHandle is %hu", __FUNCTION__, connectHandle);
-    ATT_ExecuteWriteResponse(connectHandle);
+    ATT_ExecuteWriteResponse(
+        connectHandle, pimpl->TakeTransaction(connectHandle, INVALID_ATTRIBUTE_HANDLE, EXECUTE_WRITE_REQUEST));
 }
 /**
  * @brief Convert the att error code to the service layer error code.
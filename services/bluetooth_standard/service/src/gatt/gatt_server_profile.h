@@ -45,8 +45,8 @@
 namespace bluetooth {
 class GattServerProfile {
 public:
-    explicit GattServerProfile(
-        GattServerProfileCallback *pServerCallbackFunc, utility::Dispatcher *dispatcher, uint16_t maxMtu);
+    explicit GattServerProfile(GattServerProfileCallback *pServerCallbackFunc, utility::Dispatcher *dispatcher,
+        uint16_t maxMtu, int notifyCoalesceWindow);
     ~GattServerProfile();
     void Enable() const;
     void Disable() const;
@@ -63,6 +63,8 @@ public:
     const std::optional<std::reference_wrapper<GattDatabase::AttributeEntity>> GetAttributeEntity(
         uint16_t handle) const;
     void SendNotification(uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len) const;
+    void SendNotifications(
+        const std::vector<uint16_t> &connectHandles, uint16_t handle, const GattValue &value, size_t len) const;
     void SendIndication(uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len) const;
     void SendReadCharacteristicValueResp(
         uint16_t connectHandle, uint16_t handle, const GattValue &value, size_t len, int result) const;
@@ -76,7 +78,7 @@ public:
     void SendWriteDescriptorResp(uint16_t connectHandle, uint16_t handle, int result) const;
     void SendPrepareWriteValueResp(
         PrepareWriteParam param, const GattValue &value, size_t len, int result) const;
-    static void SendExecuteWriteValueResp(uint16_t connectHandle);
+    void SendExecuteWriteValueResp(uint16_t connectHandle) const;
     static int ConvertResponseErrorCode(int errorCode);
     DISALLOW_COPY_AND_ASSIGN(GattServerProfile);
 
@@ -100,6 +100,7 @@ struct GattServerService::impl : public GattServiceBase {
     void AddAttHandleMap(int appId, const Service &service);
     static bool IsValidAttHandle(uint16_t handle);
     static uint16_t GetBleServerExchangeMtu();
+    static int GetNotifyCoalesceWindow();
     std::optional<AppIterator> GetValidApplicationService(int appId, uint16_t handle);
     void NotifyServiceChanged(int appId, const Service &service);
 
@@ -612,7 +613,7 @@ GattServerService::impl::impl(GattServerService &service)
     : self_(service),
       profileCallback_(std::make_unique<GattServerProfileCallbackImplement>(service)),
       profile_(std::make_unique<GattServerProfile>(
-          profileCallback_.get(), service.GetDispatcher(), GetBleServerExchangeMtu())),
+          profileCallback_.get(), service.GetDispatcher(), GetBleServerExchangeMtu(), GetNotifyCoalesceWindow())),
       connectionObserver_(std::make_unique<GattConnectionObserverImplement>(service)),
       basedServicesManager_(std::make_unique<GattBasedServicesManager>(service, *service.GetDispatcher()))
 {
@@ -1199,6 +1200,16 @@ uint16_t GattServerService::impl::GetBleServerExchangeMtu()
     return result;
 }
 
+int GattServerService::impl::GetNotifyCoalesceWindow()
+{
+    int result = DEFAULT_GATT_SERVER_NOTIFY_COALESCE_WINDOW;
+    if (AdapterConfig::GetInstance()->GetValue(
+        SECTION_GATT_SERVICE, PROPERTY_GATT_SERVER_NOTIFY_COALESCE_WINDOW, result)) {
+        return result;
+    }
+    return result;
+}
+
 std::optional<AppIterator> GattServerService::impl::GetValidApplication(int appId)
 {
     auto it = servers_.find(appId);
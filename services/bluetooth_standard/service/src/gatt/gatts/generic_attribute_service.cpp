@@ -26,8 +26,10 @@
 namespace bluetooth {
 const size_t GenericAttributeService::CLIENT_CHARACTERISTIC_CONFIGURATION_VALUE_LENGTH = 0x02;
 const size_t GenericAttributeService::SERVICE_CHANGED_VALUE_LENGTH = 0x04;
+const size_t GenericAttributeService::CLIENT_SUPPORTED_FEATURES_VALUE_LENGTH = 0x01;
 const uint8_t GenericAttributeService::CLIENT_CHARACTERISTIC_CONFIGURATION_DEFAULT_VALUE[2] = {0};
 const uint8_t GenericAttributeService::SERVICE_CHANGED_DEFAULT_VALUE[4] = {0};
+const uint8_t GenericAttributeService::CLIENT_SUPPORTED_FEATURES_DEFAULT_VALUE[1] = {0};
 
 GenericAttributeService::GenericAttributeService(GattServerService &service, utility::Dispatcher &dispatcher)
     : serverService_(service), dispatcher_(dispatcher),
@@ -205,6 +207,14 @@ std::unique_ptr<Service> GenericAttributeService::BuildService()
 
     svc->characteristics_.push_back(characteristic);
 
+    // the value is kept per connection by the server profile
+    svc->characteristics_.push_back(Characteristic(Uuid::ConvertFrom16Bits(UUID_CLIENT_SUPPORTED_FEATURES),
+        0,
+        CHARACTERISTIC_PROPERTIE_READ | CHARACTERISTIC_PROPERTIE_WRITE,
+        (int)GattPermission::READABLE | (int)GattPermission::WRITABLE,
+        CLIENT_SUPPORTED_FEATURES_DEFAULT_VALUE,
+        CLIENT_SUPPORTED_FEATURES_VALUE_LENGTH));
+
     return svc;
 }
 
@@ -44,8 +44,10 @@ public:
 private:
     static const size_t CLIENT_CHARACTERISTIC_CONFIGURATION_VALUE_LENGTH;
     static const size_t SERVICE_CHANGED_VALUE_LENGTH;
+    static const size_t CLIENT_SUPPORTED_FEATURES_VALUE_LENGTH;
     static const uint8_t CLIENT_CHARACTERISTIC_CONFIGURATION_DEFAULT_VALUE[2];
     static const uint8_t SERVICE_CHANGED_DEFAULT_VALUE[4];
+    static const uint8_t CLIENT_SUPPORTED_FEATURES_DEFAULT_VALUE[1];
 
     class GattServerCallbackImpl;
     struct NotifyInformation {
@@ -358,6 +358,7 @@ uint8_t A2dpAvdtp::ParseAvdtpConfigureInd(
     peer->SetCurrentCmd(EVT_SETCONFIG_IND);
     peer->SetStreamHandle(handle);
     peer->UpdatePeerMtu(data.configInd.hdr.mtu);
+    peer->SetDelayReport((data.configInd.cfg.pscMask & AVDT_PSC_MSK_DELAY_RPT) != 0);
     if (role == A2DP_ROLE_SOURCE) {
         peer->SetInitSide(false);
         peer->SetIntSeid(handle);
@@ -21,6 +21,7 @@
 #include <list>
 
 #include "a2dp_codec_config.h"
+#include "a2dp_pcm_ring.h"
 #include "base_def.h"
 #include "packet.h"
 
@@ -52,12 +53,18 @@ public:
     virtual void UpdateEncoderParam() = 0;
     virtual bool SetPcmData(const uint8_t *data, uint16_t dataSize) = 0;
     virtual void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) = 0;
+    // While a ring is set SendFrames pulls pcm from it instead of the data given to SetPcmData.
+    virtual void SetPcmRing(A2dpPcmRing *ring)
+    {
+        pcmRing_ = ring;
+    }
 
 protected:
     DISALLOW_COPY_AND_ASSIGN(A2dpEncoder);
     A2dpCodecConfig *config_;
     A2dpEncoderObserver *observer_;
     size_t transmitQueueLength_;
+    A2dpPcmRing *pcmRing_ = nullptr;
 };
 
 // A2dpDecoderObserver is responsible of receiving decoded audio data from a2dp
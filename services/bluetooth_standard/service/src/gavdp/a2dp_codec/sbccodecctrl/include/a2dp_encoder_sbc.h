@@ -129,6 +129,7 @@ private:
     CODECSbcLib *codecSbcEncoderLib_ = nullptr;
     void updateParam(void);
     bool A2dpSbcReadFeeding(uint32_t *bytesRead);
+    bool A2dpSbcReadRing(uint32_t *bytesRead);
     void A2dpSbcCalculateEncBitPool(uint16_t samplingFreq, uint16_t minBitPool, uint16_t maxBitPool);
     void A2dpSbcEncodeFrames(void);
     void CalculateSbcPCMRemain(uint16_t codecSize, uint32_t bytesNum, uint8_t *numOfFrame);
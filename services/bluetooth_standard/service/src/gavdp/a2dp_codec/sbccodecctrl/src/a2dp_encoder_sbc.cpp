@@ -343,6 +343,9 @@ void A2dpSbcEncoder::UpdateEncoderParam(void)
 
 bool A2dpSbcEncoder::A2dpSbcReadFeeding(uint32_t *bytesRead)
 {
+    if (pcmRing_ != nullptr) {
+        return A2dpSbcReadRing(bytesRead);
+    }
     uint16_t actualReadPcmData = dataSize_;
     if (actualReadPcmData) {
         LOG_INFO("[Feeding][offsetPCM:%u][readBytes:%u]", a2dpSbcEncoderCb_.offsetPCM, actualReadPcmData);
@@ -361,6 +364,23 @@ bool A2dpSbcEncoder::A2dpSbcReadFeeding(uint32_t *bytesRead)
     }
 }
 
+bool A2dpSbcEncoder::A2dpSbcReadRing(uint32_t *bytesRead)
+{
+    // One tick worth of pcm goes straight from the shared ring behind the remainder of the last tick.
+    uint32_t space = sizeof(a2dpSbcEncoderCb_.pcmBuffer) - a2dpSbcEncoderCb_.offsetPCM;
+    uint32_t wanted = a2dpSbcEncoderCb_.feedingState.bytesPerTick;
+    if (wanted > space) {
+        wanted = space;
+    }
+    uint32_t actualReadPcmData = pcmRing_->Read(&a2dpSbcEncoderCb_.pcmBuffer[a2dpSbcEncoderCb_.offsetPCM], wanted);
+    if (actualReadPcmData == 0) {
+        LOG_INFO("[Feeding][ring empty][underrun:%u]", pcmRing_->GetUnderrunCount());
+        return false;
+    }
+    *bytesRead = actualReadPcmData;
+    return true;
+}
+
 void A2dpSbcEncoder::ConvertFreqParamToSBCParam(void)
 {
     SBCEncoderParams *encParams = &a2dpSbcEncoderCb_.sbcEncoderParams;
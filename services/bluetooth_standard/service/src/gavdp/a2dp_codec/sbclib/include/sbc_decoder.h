@@ -22,6 +22,7 @@
 #include "sbc_codec.h"
 #include "sbc_constant.h"
 #include "sbc_frame.h"
+#include "sbc_simd.h"
 
 namespace sbc {
 class Decoder: public IDecoderBase {
@@ -35,11 +36,13 @@ private:
     int Synthesize(const Frame& frame);
     void Synthesize4(const Frame &frame, int ch, int blk);
     void Synthesize8(const Frame &frame, int ch, int blk);
+    void SynthesizeSimd(const Frame &frame, int ch, int blk);
 
     int32_t v_[2][170] {};
     int offset_[2][16] {};
     int16_t pcmSamples_[2][16 * 8] {};
     bool initialized_ {};
+    const SbcSimdFunctions *simd_ {};
     Frame frame_ {};
 };
 } // namespace sbc
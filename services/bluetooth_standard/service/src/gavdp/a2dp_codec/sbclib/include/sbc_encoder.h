@@ -22,6 +22,7 @@
 #include "sbc_codec.h"
 #include "sbc_constant.h"
 #include "sbc_frame.h"
+#include "sbc_simd.h"
 
 namespace sbc {
 class Encoder : public IEncoderBase {
@@ -42,11 +43,11 @@ private:
     static void AnalyzeFourForPolyphaseFilter(int32_t *temp, const int16_t *inData, const int16_t *consts);
     static void AnalyzeFourForScaling(int32_t *temp1, int16_t *temp2);
     static void AnalyzeFourForCosTransform(int32_t *temp1, int16_t *temp2, const int16_t *consts);
-    void AnalyzeFourFunction(const int16_t *inData, int32_t *outData, const int16_t *consts) const;
+    static void AnalyzeFourFunction(const int16_t *inData, int32_t *outData, const int16_t *consts);
     static void AnalyzeEightForPolyphaseFilter(int32_t *temp, const int16_t *inData, const int16_t *consts);
     static void AnalyzeEightForScaling(int32_t *temp1, int16_t *temp2);
     static void AnalyzeEightForCosTransform(int32_t *temp1, int16_t *temp2, const int16_t *consts);
-    void AnalyzeEightFunction(const int16_t *inData, int32_t *outData, const int16_t *consts) const;
+    static void AnalyzeEightFunction(const int16_t *inData, int32_t *outData, const int16_t *consts);
     int Analyze4Subbands(int position, int16_t x[2][BUFFER_SIZE], Frame& frame, int increment);
     int Analyze8Subbands(int position, int16_t x[2][BUFFER_SIZE], Frame& frame, int increment);
     void Get8SubbandSamplingPointInternal(const uint8_t* pcm, int16_t(*x)[BUFFER_SIZE],
@@ -71,6 +72,8 @@ private:
     int position_ {};
     uint8_t increment_ {};
     int16_t x_[2][BUFFER_SIZE] {};
+    SbcAnalyzeFunc analyze4_ {};
+    SbcAnalyzeFunc analyze8_ {};
 };
 } // namespace sbc
 #endif // SBC_ENCODER_H
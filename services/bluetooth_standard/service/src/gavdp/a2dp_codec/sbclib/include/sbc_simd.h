@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SBC_SIMD_H
+#define SBC_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sbc {
+// One analysis block: 4/8 subband samples from the windowed input, consts is an ANALYSIS_CONSTS_* table.
+typedef void (*SbcAnalyzeFunc)(const int16_t *inData, int32_t *outData, const int16_t *consts);
+// Synthesis matrixing: out[i] = Scale*Staged1(SYNMATRIX[i] . samples) for all 2 * subbands rows.
+typedef void (*SbcSynthesisMatrixFunc)(const int32_t *samples, int32_t *out);
+// Synthesis windowing of one block into subbands clipped PCM samples.
+typedef void (*SbcSynthesisWindowFunc)(const int32_t *v, const int *offset, int16_t *pcm);
+
+// Vector filterbank kernels for the running CPU. An entry is nullptr when the CPU has no
+// vector version of it, the scalar code is used then. Every kernel is bit-exact with the scalar code.
+struct SbcSimdFunctions {
+    SbcAnalyzeFunc analyze4;
+    SbcAnalyzeFunc analyze8;
+    SbcSynthesisMatrixFunc synthesisMatrix4;
+    SbcSynthesisMatrixFunc synthesisMatrix8;
+    SbcSynthesisWindowFunc synthesisWindow4;
+    SbcSynthesisWindowFunc synthesisWindow8;
+};
+
+const SbcSimdFunctions& GetSbcSimdFunctions();
+} // namespace sbc
+#endif // SBC_SIMD_H
@@ -16,6 +16,7 @@
 #include <cstdio>
 #include <memory>
 #include "../include/sbc_constant.h"
+#include "../include/sbc_simd.h"
 #include "../include/sbc_tables.h"
 #include "memory.h"
 #include "securec.h"
@@ -52,6 +53,7 @@ const int VALUE_5 = 5;
 Decoder::Decoder()
 {
     initialized_ = false;
+    simd_ = &GetSbcSimdFunctions();
 }
 
 extern "C" Decoder* CreateDecode()
@@ -150,8 +152,44 @@ inline int16_t Clip16(int32_t val)
     }
 }
 
+void Decoder::SynthesizeSimd(const Frame &frame, int ch, int blk)
+{
+    bool fourSubbands = (frame.subbands_ == SUBBANDS_NUM4);
+    int last = fourSubbands ? VALUE_79 : VALUE_159;
+    int32_t *v = v_[ch];
+    int *offset = offset_[ch];
+    int32_t matrix[SUBBANDS_NUM8 * BIT16_BYTE2];
+
+    // The rows written in one block never land in v[0..8], so the ring copy can follow the matrixing.
+    if (fourSubbands) {
+        simd_->synthesisMatrix4(frame.samples_[blk][ch], matrix);
+    } else {
+        simd_->synthesisMatrix8(frame.samples_[blk][ch], matrix);
+    }
+    for (int i = 0; i < frame.subbands_ * BIT16_BYTE2; i++) {
+        offset[i]--;
+        if (offset[i] < 0) {
+            offset[i] = last;
+            (void)memcpy_s(v + last + 1, VALUE_9 * sizeof(*v), v, VALUE_9 * sizeof(*v));
+        }
+        v[offset[i]] = matrix[i];
+    }
+
+    int16_t *pcm = &pcmSamples_[ch][blk * frame.subbands_];
+    if (fourSubbands) {
+        simd_->synthesisWindow4(v, offset, pcm);
+    } else {
+        simd_->synthesisWindow8(v, offset, pcm);
+    }
+}
+
 void Decoder::Synthesize4(const Frame &frame, int ch, int blk)
 {
+    if (simd_->synthesisMatrix4 != nullptr) {
+        SynthesizeSimd(frame, ch, blk);
+        return;
+    }
+
     int32_t *v = v_[ch];
     int *offset = offset_[ch];
 
@@ -195,6 +233,11 @@ void Decoder::Synthesize4(const Frame &frame, int ch, int blk)
 
 void Decoder::Synthesize8(const Frame &frame, int ch, int blk)
 {
+    if (simd_->synthesisMatrix8 != nullptr) {
+        SynthesizeSimd(frame, ch, blk);
+        return;
+    }
+
     int i = 0;
     int idx = 0;
     int *offset = offset_[ch];
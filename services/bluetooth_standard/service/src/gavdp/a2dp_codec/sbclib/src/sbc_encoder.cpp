@@ -16,6 +16,7 @@
 #include <memory>
 #include "../include/sbc_constant.h"
 #include "../include/sbc_math.h"
+#include "../include/sbc_simd.h"
 #include "../include/sbc_tables.h"
 #include "memory.h"
 #include "securec.h"
@@ -67,6 +68,9 @@ const int COEFFICIENT_80 = 80;
 Encoder::Encoder()
 {
     initialized_ = false;
+    const SbcSimdFunctions &simd = GetSbcSimdFunctions();
+    analyze4_ = (simd.analyze4 != nullptr) ? simd.analyze4 : AnalyzeFourFunction;
+    analyze8_ = (simd.analyze8 != nullptr) ? simd.analyze8 : AnalyzeEightFunction;
 }
 
 Encoder::~Encoder()
@@ -232,7 +236,7 @@ void Encoder::AnalyzeFourForCosTransform(int32_t *temp1, int16_t *temp2, const i
 }
 
 
-void Encoder::AnalyzeFourFunction(const int16_t *inData, int32_t *outData, const int16_t *consts) const
+void Encoder::AnalyzeFourFunction(const int16_t *inData, int32_t *outData, const int16_t *consts)
 {
     int32_t t1[VALUE_4] = {};
     int16_t t2[VALUE_4] = {};
@@ -324,7 +328,7 @@ void Encoder::AnalyzeEightForCosTransform(int32_t *temp1, int16_t *temp2, const
     }
 }
 
-void Encoder::AnalyzeEightFunction(const int16_t *inData, int32_t *outData, const int16_t *consts) const
+void Encoder::AnalyzeEightFunction(const int16_t *inData, int32_t *outData, const int16_t *consts)
 {
     int32_t t1[VALUE_8] = {};
     int16_t t2[VALUE_8] = {};
@@ -342,25 +346,25 @@ void Encoder::AnalyzeEightFunction(const int16_t *inData, int32_t *outData, cons
 void Encoder::Analyze4SubbandsInternal(int16_t *x, int32_t *outData, int increseValue)
 {
     /* Analyze blocks */
-    AnalyzeFourFunction(x + VALUE_12, outData, ANALYSIS_CONSTS_BAND4_ODD_MODE);
+    analyze4_(x + VALUE_12, outData, ANALYSIS_CONSTS_BAND4_ODD_MODE);
     outData += increseValue;
-    AnalyzeFourFunction(x + VALUE_8, outData, ANALYSIS_CONSTS_BAND4_EVEN_MODE);
+    analyze4_(x + VALUE_8, outData, ANALYSIS_CONSTS_BAND4_EVEN_MODE);
     outData += increseValue;
-    AnalyzeFourFunction(x + VALUE_4, outData, ANALYSIS_CONSTS_BAND4_ODD_MODE);
+    analyze4_(x + VALUE_4, outData, ANALYSIS_CONSTS_BAND4_ODD_MODE);
     outData += increseValue;
-    AnalyzeFourFunction(x + VALUE_0, outData, ANALYSIS_CONSTS_BAND4_EVEN_MODE);
+    analyze4_(x + VALUE_0, outData, ANALYSIS_CONSTS_BAND4_EVEN_MODE);
 }
 
 void Encoder::Analyze8SubbandsInternal(int16_t *x, int32_t *outData, int increseValue)
 {
     /* Analyze blocks */
-    AnalyzeEightFunction(x + VALUE_24, outData, ANALYSIS_CONSTS_BAND8_ODD_MODE);
+    analyze8_(x + VALUE_24, outData, ANALYSIS_CONSTS_BAND8_ODD_MODE);
     outData += increseValue;
-    AnalyzeEightFunction(x + VALUE_16, outData, ANALYSIS_CONSTS_BAND8_EVEN_MODE);
+    analyze8_(x + VALUE_16, outData, ANALYSIS_CONSTS_BAND8_EVEN_MODE);
     outData += increseValue;
-    AnalyzeEightFunction(x + VALUE_8, outData, ANALYSIS_CONSTS_BAND8_ODD_MODE);
+    analyze8_(x + VALUE_8, outData, ANALYSIS_CONSTS_BAND8_ODD_MODE);
     outData += increseValue;
-    AnalyzeEightFunction(x + VALUE_0, outData, ANALYSIS_CONSTS_BAND8_EVEN_MODE);
+    analyze8_(x + VALUE_0, outData, ANALYSIS_CONSTS_BAND8_EVEN_MODE);
 }
 
 int Encoder::Analyze4Subbands(int position, int16_t x[CHANNEL_NUM][BUFFER_SIZE],
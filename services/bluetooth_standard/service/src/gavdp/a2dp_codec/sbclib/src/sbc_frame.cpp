@@ -34,7 +34,6 @@ const int BLOCK_FOUR = 4;
 const int BLOCK_EIGHT = 8;
 const int BLOCK_TWELVE = 12;
 const int BLOCK_SIXTEEN = 16;
-const int MOVE_RIGHT_BIT7 = 7;
 const int VALUE_OF_SIXTEEN = 16;
 const int VALUE_OF_TWO = 2;
 const int VALUE_OF_FOUR = 4;
@@ -93,11 +92,11 @@ uint8_t Frame::SbcCrc8(const uint8_t* data, size_t len)
         crc = SBC_CRC_TABLE [crc ^ data[index]];
     }
 
-    uint8_t octet = static_cast<int>(len % VALUE8) ? data[index] : 0;
-    for (int i = 0; i < static_cast<int>(len % VALUE8); i++) {
-        char bit = ((octet ^ crc) & 0x80) >> MOVE_RIGHT_BIT7;
-        crc = ((crc & 0x7f) << 1) ^ (bit ? 0x1d : 0);
-        octet = octet << 1;
+    // The remaining bits sit at the top of the last octet. Index m < 2^bits only shifts for the first
+    // 8 - bits table steps, so SBC_CRC_TABLE[m] is also the CRC of those bits and no bit loop is needed.
+    int bits = static_cast<int>(len % VALUE8);
+    if (bits != 0) {
+        crc = static_cast<uint8_t>(crc << bits) ^ SBC_CRC_TABLE[(crc ^ data[index]) >> (VALUE8 - bits)];
     }
     return crc;
 }
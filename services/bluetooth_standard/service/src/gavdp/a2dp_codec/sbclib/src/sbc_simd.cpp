@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../include/sbc_simd.h"
+#include "../include/sbc_math.h"
+#include "../include/sbc_tables.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SBC_SIMD_X86
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SBC_SIMD_NEON
+#endif
+
+namespace sbc {
+#if defined(SBC_SIMD_X86) || defined(SBC_SIMD_NEON)
+const int SCALE_OUT_BITS = 15;
+const int PROTO4_SCALE = PROTO_BAND4_SCALE;
+const int PROTO8_SCALE = PROTO_BAND8_SCALE;
+const int ANALYSIS4_OUT_SHIFT = COS_TABLE_BAND4_SCALE - SCALE_OUT_BITS;
+const int ANALYSIS8_OUT_SHIFT = COS_TABLE_BAND8_SCALE - SCALE_OUT_BITS;
+const int POLYPHASE4_TAPS = 40;
+const int POLYPHASE8_TAPS = 80;
+const int POLYPHASE4_HOP = 8;
+const int POLYPHASE8_HOP = 16;
+const int SUBBANDS4 = 4;
+const int SUBBANDS8 = 8;
+const int SYNTHESIS_ROWS4 = 8;
+const int SYNTHESIS_ROWS8 = 16;
+const int WINDOW_TAPS = 10;
+const int WINDOW_VECTOR_TAPS = 8;
+
+// SYNMATRIX transposed so a column multiplies one sample into every row at once, and the synthesis
+// window coefficients of each output interleaved in v order: PROTO_M0 on even taps, PROTO_M1 on odd taps.
+struct SbcSynthesisTables {
+    int32_t matrix4[SUBBANDS4][SYNTHESIS_ROWS4];
+    int32_t matrix8[SUBBANDS8][SYNTHESIS_ROWS8];
+    int32_t window4[SUBBANDS4][WINDOW_TAPS];
+    int32_t window8[SUBBANDS8][WINDOW_TAPS];
+};
+
+static SbcSynthesisTables g_tables;
+
+static void BuildSynthesisWindow(const int32_t *m0, const int32_t *m1, int subbands, int32_t (*window)[WINDOW_TAPS])
+{
+    for (int i = 0; i < subbands; i++) {
+        for (int tap = 0; tap < WINDOW_TAPS; tap += 2) {
+            window[i][tap] = m0[i * (WINDOW_TAPS / 2) + tap / 2];
+            window[i][tap + 1] = m1[i * (WINDOW_TAPS / 2) + tap / 2];
+        }
+    }
+}
+
+static void BuildSynthesisTables()
+{
+    for (int row = 0; row < SYNTHESIS_ROWS4; row++) {
+        for (int col = 0; col < SUBBANDS4; col++) {
+            g_tables.matrix4[col][row] = SYNMATRIX4[row][col];
+        }
+    }
+    for (int row = 0; row < SYNTHESIS_ROWS8; row++) {
+        for (int col = 0; col < SUBBANDS8; col++) {
+            g_tables.matrix8[col][row] = SYNMATRIX8[row][col];
+        }
+    }
+    BuildSynthesisWindow(PROTO_4_40M0, PROTO_4_40M1, SUBBANDS4, g_tables.window4);
+    BuildSynthesisWindow(PROTO_8_80M0, PROTO_8_80M1, SUBBANDS8, g_tables.window8);
+}
+
+// The last two taps do not fill a vector, they are added the way the scalar code does.
+static inline int32_t SynthesisWindowTail(const int32_t *vi, const int32_t *vk, const int32_t *window, int32_t sum)
+{
+    return MULA(vi[WINDOW_VECTOR_TAPS], window[WINDOW_VECTOR_TAPS],
+        MULA(vk[WINDOW_VECTOR_TAPS + 1], window[WINDOW_VECTOR_TAPS + 1], sum));
+}
+#endif
+
+#if defined(SBC_SIMD_X86)
+// Scalar code keeps the scaled polyphase sums in int16_t, so wrap like it instead of saturating.
+__attribute__((target("sse2"))) static inline __m128i TruncateToInt16Sse2(__m128i x)
+{
+    return _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+}
+
+__attribute__((target("sse2"))) static void Analyze4Sse2(const int16_t *inData, int32_t *outData,
+    const int16_t *consts)
+{
+    __m128i t1 = _mm_set1_epi32(1 << (PROTO4_SCALE - 1));
+    for (int hop = 0; hop < POLYPHASE4_TAPS; hop += POLYPHASE4_HOP) {
+        t1 = _mm_add_epi32(t1, _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(inData + hop)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(consts + hop))));
+    }
+    t1 = TruncateToInt16Sse2(_mm_srai_epi32(t1, PROTO4_SCALE));
+
+    // Every int32 lane of t2 holds one (t2[2i], t2[2i + 1]) pair of the cos transform.
+    __m128i t2 = _mm_packs_epi32(t1, t1);
+    const __m128i *cos = reinterpret_cast<const __m128i *>(consts + POLYPHASE4_TAPS);
+    __m128i out = _mm_madd_epi16(_mm_shuffle_epi32(t2, 0x00), _mm_loadu_si128(cos));
+    out = _mm_add_epi32(out, _mm_madd_epi16(_mm_shuffle_epi32(t2, 0x55), _mm_loadu_si128(cos + 1)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(outData), _mm_srai_epi32(out, ANALYSIS4_OUT_SHIFT));
+}
+
+__attribute__((target("sse2"))) static void Analyze8Sse2(const int16_t *inData, int32_t *outData,
+    const int16_t *consts)
+{
+    __m128i lo = _mm_set1_epi32(1 << (PROTO8_SCALE - 1));
+    __m128i hi = lo;
+    for (int hop = 0; hop < POLYPHASE8_TAPS; hop += POLYPHASE8_HOP) {
+        const __m128i *in = reinterpret_cast<const __m128i *>(inData + hop);
+        const __m128i *c = reinterpret_cast<const __m128i *>(consts + hop);
+        lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_loadu_si128(in), _mm_loadu_si128(c)));
+        hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_loadu_si128(in + 1), _mm_loadu_si128(c + 1)));
+    }
+    lo = TruncateToInt16Sse2(_mm_srai_epi32(lo, PROTO8_SCALE));
+    hi = TruncateToInt16Sse2(_mm_srai_epi32(hi, PROTO8_SCALE));
+
+    __m128i t2 = _mm_packs_epi32(lo, hi);
+    const __m128i *cos = reinterpret_cast<const __m128i *>(consts + POLYPHASE8_TAPS);
+    __m128i pair = _mm_shuffle_epi32(t2, 0x00);
+    lo = _mm_madd_epi16(pair, _mm_loadu_si128(cos));
+    hi = _mm_madd_epi16(pair, _mm_loadu_si128(cos + 1));
+    pair = _mm_shuffle_epi32(t2, 0x55);
+    lo = _mm_add_epi32(lo, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 2)));
+    hi = _mm_add_epi32(hi, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 3)));
+    pair = _mm_shuffle_epi32(t2, 0xAA);
+    lo = _mm_add_epi32(lo, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 4)));
+    hi = _mm_add_epi32(hi, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 5)));
+    pair = _mm_shuffle_epi32(t2, 0xFF);
+    lo = _mm_add_epi32(lo, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 6)));
+    hi = _mm_add_epi32(hi, _mm_madd_epi16(pair, _mm_loadu_si128(cos + 7)));
+
+    __m128i *out = reinterpret_cast<__m128i *>(outData);
+    _mm_storeu_si128(out, _mm_srai_epi32(lo, ANALYSIS8_OUT_SHIFT));
+    _mm_storeu_si128(out + 1, _mm_srai_epi32(hi, ANALYSIS8_OUT_SHIFT));
+}
+
+__attribute__((target("avx2"))) static void Analyze8Avx2(const int16_t *inData, int32_t *outData,
+    const int16_t *consts)
+{
+    __m256i t1 = _mm256_set1_epi32(1 << (PROTO8_SCALE - 1));
+    for (int hop = 0; hop < POLYPHASE8_TAPS; hop += POLYPHASE8_HOP) {
+        t1 = _mm256_add_epi32(t1,
+            _mm256_madd_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(inData + hop)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(consts + hop))));
+    }
+    t1 = _mm256_srai_epi32(_mm256_slli_epi32(_mm256_srai_epi32(t1, PROTO8_SCALE), 16), 16);
+
+    // packs works per 128-bit lane: pairs 0, 1 land in int32 elements 0, 1 and pairs 2, 3 in 4, 5.
+    __m256i t2 = _mm256_packs_epi32(t1, t1);
+    const __m256i *cos = reinterpret_cast<const __m256i *>(consts + POLYPHASE8_TAPS);
+    __m256i out = _mm256_madd_epi16(_mm256_permutevar8x32_epi32(t2, _mm256_set1_epi32(0)),
+        _mm256_loadu_si256(cos));
+    out = _mm256_add_epi32(out, _mm256_madd_epi16(_mm256_permutevar8x32_epi32(t2, _mm256_set1_epi32(1)),
+        _mm256_loadu_si256(cos + 1)));
+    out = _mm256_add_epi32(out, _mm256_madd_epi16(_mm256_permutevar8x32_epi32(t2, _mm256_set1_epi32(4)),
+        _mm256_loadu_si256(cos + 2)));
+    out = _mm256_add_epi32(out, _mm256_madd_epi16(_mm256_permutevar8x32_epi32(t2, _mm256_set1_epi32(5)),
+        _mm256_loadu_si256(cos + 3)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(outData), _mm256_srai_epi32(out, ANALYSIS8_OUT_SHIFT));
+}
+
+__attribute__((target("avx2"))) static void SynthesisMatrix4Avx2(const int32_t *samples, int32_t *out)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for (int col = 0; col < SUBBANDS4; col++) {
+        __m256i matrix = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(g_tables.matrix4[col]));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(matrix, _mm256_set1_epi32(samples[col])));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), _mm256_srai_epi32(acc, SCALE4_STAGED1_BITS));
+}
+
+__attribute__((target("avx2"))) static void SynthesisMatrix8Avx2(const int32_t *samples, int32_t *out)
+{
+    __m256i lo = _mm256_setzero_si256();
+    __m256i hi = _mm256_setzero_si256();
+    for (int col = 0; col < SUBBANDS8; col++) {
+        const __m256i *matrix = reinterpret_cast<const __m256i *>(g_tables.matrix8[col]);
+        __m256i sample = _mm256_set1_epi32(samples[col]);
+        lo = _mm256_add_epi32(lo, _mm256_mullo_epi32(_mm256_loadu_si256(matrix), sample));
+        hi = _mm256_add_epi32(hi, _mm256_mullo_epi32(_mm256_loadu_si256(matrix + 1), sample));
+    }
+    __m256i *dst = reinterpret_cast<__m256i *>(out);
+    _mm256_storeu_si256(dst, _mm256_srai_epi32(lo, SCALE8_STAGED1_BITS));
+    _mm256_storeu_si256(dst + 1, _mm256_srai_epi32(hi, SCALE8_STAGED1_BITS));
+}
+
+// Even taps come from v[offset[i]], odd taps from v[offset[i + subbands]].
+__attribute__((target("avx2"))) static int32_t SynthesisWindowSumAvx2(const int32_t *vi, const int32_t *vk,
+    const int32_t *window)
+{
+    __m256i x = _mm256_blend_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(vi)),
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vk)), 0xAA);
+    __m256i p = _mm256_mullo_epi32(x, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(window)));
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(p), _mm256_extracti128_si256(p, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return SynthesisWindowTail(vi, vk, window, _mm_cvtsi128_si32(sum));
+}
+
+__attribute__((target("avx2"))) static void SynthesisWindow4Avx2(const int32_t *v, const int *offset, int16_t *pcm)
+{
+    alignas(16) int32_t sums[SUBBANDS4];
+    for (int i = 0; i < SUBBANDS4; i++) {
+        sums[i] = SynthesisWindowSumAvx2(v + offset[i], v + offset[i + SUBBANDS4], g_tables.window4[i]);
+    }
+    // Saturating pack is Clip16.
+    __m128i x = _mm_srai_epi32(_mm_load_si128(reinterpret_cast<const __m128i *>(sums)), SCALE4_STAGED1_BITS);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(pcm), _mm_packs_epi32(x, x));
+}
+
+__attribute__((target("avx2"))) static void SynthesisWindow8Avx2(const int32_t *v, const int *offset, int16_t *pcm)
+{
+    alignas(16) int32_t sums[SUBBANDS8];
+    for (int i = 0; i < SUBBANDS8; i++) {
+        sums[i] = SynthesisWindowSumAvx2(v + offset[i], v + offset[i + SUBBANDS8], g_tables.window8[i]);
+    }
+    const __m128i *src = reinterpret_cast<const __m128i *>(sums);
+    __m128i lo = _mm_srai_epi32(_mm_load_si128(src), SCALE8_STAGED1_BITS);
+    __m128i hi = _mm_srai_epi32(_mm_load_si128(src + 1), SCALE8_STAGED1_BITS);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(pcm), _mm_packs_epi32(lo, hi));
+}
+#endif
+
+#if defined(SBC_SIMD_NEON)
+// Same as x86 pmaddwd: products of adjacent int16 pairs summed into int32 lanes.
+static inline int32x4_t MaddNeon(int16x8_t a, int16x8_t b)
+{
+    int32x4_t lo = vmull_s16(vget_low_s16(a), vget_low_s16(b));
+    int32x4_t hi = vmull_s16(vget_high_s16(a), vget_high_s16(b));
+    return vcombine_s32(vpadd_s32(vget_low_s32(lo), vget_high_s32(lo)),
+        vpadd_s32(vget_low_s32(hi), vget_high_s32(hi)));
+}
+
+static inline int16x8_t BroadcastPairNeon(int32x2_t pairs, int lane)
+{
+    return vreinterpretq_s16_s32((lane == 0) ? vdupq_lane_s32(pairs, 0) : vdupq_lane_s32(pairs, 1));
+}
+
+static void Analyze4Neon(const int16_t *inData, int32_t *outData, const int16_t *consts)
+{
+    int32x4_t t1 = vdupq_n_s32(1 << (PROTO4_SCALE - 1));
+    for (int hop = 0; hop < POLYPHASE4_TAPS; hop += POLYPHASE4_HOP) {
+        t1 = vaddq_s32(t1, MaddNeon(vld1q_s16(inData + hop), vld1q_s16(consts + hop)));
+    }
+    // vmovn truncates to int16 the same way the scalar code does.
+    int32x2_t pairs = vreinterpret_s32_s16(vmovn_s32(vshrq_n_s32(t1, PROTO4_SCALE)));
+    const int16_t *cos = consts + POLYPHASE4_TAPS;
+    int32x4_t out = MaddNeon(BroadcastPairNeon(pairs, 0), vld1q_s16(cos));
+    out = vaddq_s32(out, MaddNeon(BroadcastPairNeon(pairs, 1), vld1q_s16(cos + SUBBANDS8)));
+    vst1q_s32(outData, vshlq_s32(out, vdupq_n_s32(-ANALYSIS4_OUT_SHIFT)));
+}
+
+static void Analyze8Neon(const int16_t *inData, int32_t *outData, const int16_t *consts)
+{
+    int32x4_t lo = vdupq_n_s32(1 << (PROTO8_SCALE - 1));
+    int32x4_t hi = lo;
+    for (int hop = 0; hop < POLYPHASE8_TAPS; hop += POLYPHASE8_HOP) {
+        lo = vaddq_s32(lo, MaddNeon(vld1q_s16(inData + hop), vld1q_s16(consts + hop)));
+        hi = vaddq_s32(hi, MaddNeon(vld1q_s16(inData + hop + SUBBANDS8), vld1q_s16(consts + hop + SUBBANDS8)));
+    }
+    int32x2_t pairsLo = vreinterpret_s32_s16(vmovn_s32(vshrq_n_s32(lo, PROTO8_SCALE)));
+    int32x2_t pairsHi = vreinterpret_s32_s16(vmovn_s32(vshrq_n_s32(hi, PROTO8_SCALE)));
+
+    const int16_t *cos = consts + POLYPHASE8_TAPS;
+    lo = vdupq_n_s32(0);
+    hi = vdupq_n_s32(0);
+    for (int i = 0; i < SUBBANDS4; i++) {
+        int16x8_t pair = BroadcastPairNeon((i < 2) ? pairsLo : pairsHi, i & 1);
+        lo = vaddq_s32(lo, MaddNeon(pair, vld1q_s16(cos + i * SYNTHESIS_ROWS8)));
+        hi = vaddq_s32(hi, MaddNeon(pair, vld1q_s16(cos + i * SYNTHESIS_ROWS8 + SUBBANDS8)));
+    }
+    int32x4_t shift = vdupq_n_s32(-ANALYSIS8_OUT_SHIFT);
+    vst1q_s32(outData, vshlq_s32(lo, shift));
+    vst1q_s32(outData + SUBBANDS4, vshlq_s32(hi, shift));
+}
+
+static void SynthesisMatrix4Neon(const int32_t *samples, int32_t *out)
+{
+    int32x4_t lo = vdupq_n_s32(0);
+    int32x4_t hi = vdupq_n_s32(0);
+    for (int col = 0; col < SUBBANDS4; col++) {
+        lo = vmlaq_n_s32(lo, vld1q_s32(g_tables.matrix4[col]), samples[col]);
+        hi = vmlaq_n_s32(hi, vld1q_s32(g_tables.matrix4[col] + SUBBANDS4), samples[col]);
+    }
+    vst1q_s32(out, vshrq_n_s32(lo, SCALE4_STAGED1_BITS));
+    vst1q_s32(out + SUBBANDS4, vshrq_n_s32(hi, SCALE4_STAGED1_BITS));
+}
+
+static void SynthesisMatrix8Neon(const int32_t *samples, int32_t *out)
+{
+    for (int row = 0; row < SYNTHESIS_ROWS8; row += SUBBANDS4) {
+        int32x4_t acc = vdupq_n_s32(0);
+        for (int col = 0; col < SUBBANDS8; col++) {
+            acc = vmlaq_n_s32(acc, vld1q_s32(g_tables.matrix8[col] + row), samples[col]);
+        }
+        vst1q_s32(out + row, vshrq_n_s32(acc, SCALE8_STAGED1_BITS));
+    }
+}
+
+// Even taps come from v[offset[i]], odd taps from v[offset[i + subbands]].
+static int32_t SynthesisWindowSumNeon(const int32_t *vi, const int32_t *vk, const int32_t *window)
+{
+    const uint32_t oddMask[SUBBANDS4] = {0, UINT32_MAX, 0, UINT32_MAX};
+    uint32x4_t odd = vld1q_u32(oddMask);
+    int32x4_t lo = vbslq_s32(odd, vld1q_s32(vk), vld1q_s32(vi));
+    int32x4_t hi = vbslq_s32(odd, vld1q_s32(vk + SUBBANDS4), vld1q_s32(vi + SUBBANDS4));
+    int32x4_t p = vmlaq_s32(vmulq_s32(lo, vld1q_s32(window)), hi, vld1q_s32(window + SUBBANDS4));
+    int32x2_t sum = vadd_s32(vget_low_s32(p), vget_high_s32(p));
+    sum = vpadd_s32(sum, sum);
+    return SynthesisWindowTail(vi, vk, window, vget_lane_s32(sum, 0));
+}
+
+static void SynthesisWindow4Neon(const int32_t *v, const int *offset, int16_t *pcm)
+{
+    int32_t sums[SUBBANDS4];
+    for (int i = 0; i < SUBBANDS4; i++) {
+        sums[i] = SynthesisWindowSumNeon(v + offset[i], v + offset[i + SUBBANDS4], g_tables.window4[i]);
+    }
+    // Saturating narrow is Clip16.
+    vst1_s16(pcm, vqmovn_s32(vshrq_n_s32(vld1q_s32(sums), SCALE4_STAGED1_BITS)));
+}
+
+static void SynthesisWindow8Neon(const int32_t *v, const int *offset, int16_t *pcm)
+{
+    int32_t sums[SUBBANDS8];
+    for (int i = 0; i < SUBBANDS8; i++) {
+        sums[i] = SynthesisWindowSumNeon(v + offset[i], v + offset[i + SUBBANDS8], g_tables.window8[i]);
+    }
+    vst1_s16(pcm, vqmovn_s32(vshrq_n_s32(vld1q_s32(sums), SCALE8_STAGED1_BITS)));
+    vst1_s16(pcm + SUBBANDS4, vqmovn_s32(vshrq_n_s32(vld1q_s32(sums + SUBBANDS4), SCALE8_STAGED1_BITS)));
+}
+#endif
+
+static SbcSimdFunctions SelectSimdFunctions()
+{
+    SbcSimdFunctions functions {};
+#if defined(SBC_SIMD_X86)
+    BuildSynthesisTables();
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        functions.analyze4 = Analyze4Sse2;
+        functions.analyze8 = Analyze8Sse2;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        functions.analyze8 = Analyze8Avx2;
+        functions.synthesisMatrix4 = SynthesisMatrix4Avx2;
+        functions.synthesisMatrix8 = SynthesisMatrix8Avx2;
+        functions.synthesisWindow4 = SynthesisWindow4Avx2;
+        functions.synthesisWindow8 = SynthesisWindow8Avx2;
+    }
+#elif defined(SBC_SIMD_NEON)
+    BuildSynthesisTables();
+    functions.analyze4 = Analyze4Neon;
+    functions.analyze8 = Analyze8Neon;
+    functions.synthesisMatrix4 = SynthesisMatrix4Neon;
+    functions.synthesisMatrix8 = SynthesisMatrix8Neon;
+    functions.synthesisWindow4 = SynthesisWindow4Neon;
+    functions.synthesisWindow8 = SynthesisWindow8Neon;
+#endif
+    return functions;
+}
+
+const SbcSimdFunctions& GetSbcSimdFunctions()
+{
+    static const SbcSimdFunctions functions = SelectSimdFunctions();
+    return functions;
+}
+} // namespace sbc
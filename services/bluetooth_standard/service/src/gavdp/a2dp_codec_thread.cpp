@@ -19,11 +19,16 @@
 #include "a2dp_encoder_aac.h"
 #include "a2dp_decoder_sbc.h"
 #include "a2dp_encoder_sbc.h"
+#include "a2dp_profile.h"
+#include "bt_def.h"
 #include "log.h"
 
 namespace bluetooth {
 A2dpCodecThread *A2dpCodecThread::g_instance = nullptr;
 std::recursive_mutex g_codecMutex {};
+// Opened by one client for the stream, released with the codec thread when the stream goes idle.
+std::unique_ptr<A2dpPcmRing> g_pcmRing = nullptr;
+int g_pcmRingOwner = 0;
 A2dpCodecThread::A2dpCodecThread(const std::string &name) : name_(name)
 {
     LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
@@ -32,8 +37,12 @@ A2dpCodecThread::A2dpCodecThread(const std::string &name) : name_(name)
 
 A2dpCodecThread::~A2dpCodecThread()
 {
+    pcmRingTimer_ = nullptr;
+    playoutTimer_ = nullptr;
     encoder_ = nullptr;
     decoder_ = nullptr;
+    playoutObserver_ = nullptr;
+    playout_ = nullptr;
     dispatcher_ = nullptr;
     g_instance = nullptr;
     isSbc_ = false;
@@ -61,15 +70,21 @@ A2dpCodecThread *A2dpCodecThread::GetInstance()
 void A2dpCodecThread::StartA2dpCodecThread()
 {
     dispatcher_->Initialize();
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
     threadInit = true;
+    UpdatePcmRingTimer();
 }
 
 void A2dpCodecThread::StopA2dpCodecThread()
 {
     LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
 
+    {
+        std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+        threadInit = false;
+        ReleasePcmRing();
+    }
     dispatcher_->Uninitialize();
-    threadInit = false;
 }
 
 void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInitPeerParams &peerParams,
@@ -91,12 +106,10 @@ void A2dpCodecThread::ProcessMessage(utility::Message msg, const A2dpEncoderInit
             }
             break;
         case A2DP_FRAME_READY:
-            if (msg.arg2_ != nullptr && decoder_ != nullptr) {
-                decoder_->DecodePacket((uint8_t *)msg.arg2_, msg.arg1_);
-            }
-            if (msg.arg2_ != nullptr) {
-                free((uint8_t *)msg.arg2_);
-            }
+            PlayoutFrame(std::unique_ptr<A2dpSinkFrame>(static_cast<A2dpSinkFrame *>(msg.arg2_)));
+            break;
+        case A2DP_PLAYOUT_TICK:
+            PlayoutTick();
             break;
         case A2DP_PCM_ENCODED:
             if (config == nullptr) {
@@ -131,6 +144,11 @@ bool A2dpCodecThread::GetInitStatus() const
 bool A2dpCodecThread::WriteFrame(const uint8_t *data, uint16_t size) const
 {
     LOG_INFO("[A2dpCodecThread]%{public}s size:%{public}hu\n", __func__, size);
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    if (g_pcmRing != nullptr) {
+        LOG_WARN("[A2dpCodecThread]%{public}s pcm is taken from the shared ring\n", __func__);
+        return false;
+    }
     if (encoder_ != nullptr) {
         if(!encoder_->SetPcmData(data, size)) {
             return false;
@@ -151,6 +169,123 @@ void A2dpCodecThread::GetRenderPosition(uint16_t &delayValue, uint16_t &sendData
     }
 }
 
+int A2dpCodecThread::OpenPcmRing(int owner, uint32_t size)
+{
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    if (g_pcmRing != nullptr && g_pcmRingOwner != owner) {
+        LOG_WARN("[A2dpCodecThread]%{public}s ring is owned by %{public}d\n", __func__, g_pcmRingOwner);
+        return RET_BAD_STATUS;
+    }
+    std::unique_ptr<A2dpPcmRing> ring = A2dpPcmRing::Create(size);
+    if (ring == nullptr) {
+        LOG_ERROR("[A2dpCodecThread]%{public}s create ring failed\n", __func__);
+        return RET_BAD_STATUS;
+    }
+    LOG_INFO("[A2dpCodecThread]%{public}s capacity:%{public}u\n", __func__, ring->GetCapacity());
+
+    if (g_instance != nullptr && g_instance->encoder_ != nullptr) {
+        g_instance->encoder_->SetPcmRing(ring.get());
+    }
+    if (g_pcmRing != nullptr) {
+        g_pcmRing->Close();
+    }
+    g_pcmRing = std::move(ring);
+    g_pcmRingOwner = owner;
+    if (g_instance != nullptr) {
+        g_instance->UpdatePcmRingTimer();
+    }
+    return g_pcmRing->GetFd();
+}
+
+void A2dpCodecThread::ClosePcmRing(int owner)
+{
+    LOG_INFO("[A2dpCodecThread]%{public}s\n", __func__);
+    std::lock_guard<std::recursive_mutex> lock(g_codecMutex);
+    if (g_pcmRing == nullptr || g_pcmRingOwner != owner) {
+        LOG_WARN("[A2dpCodecThread]%{public}s ring is not owned by %{public}d\n", __func__, owner);
+        return;
+    }
+    ReleasePcmRing();
+}
+
+void A2dpCodecThread::ReleasePcmRing()
+{
+    if (g_instance != nullptr && g_instance->encoder_ != nullptr) {
+        g_instance->encoder_->SetPcmRing(nullptr);
+    }
+    if (g_pcmRing != nullptr) {
+        // the owner sees the ring closed and goes back to WriteFrame
+        g_pcmRing->Close();
+    }
+    g_pcmRing = nullptr;
+    g_pcmRingOwner = 0;
+    if (g_instance != nullptr) {
+        g_instance->UpdatePcmRingTimer();
+    }
+}
+
+void A2dpCodecThread::UpdatePcmRingTimer()
+{
+    if (g_pcmRing != nullptr && threadInit) {
+        if (pcmRingTimer_ != nullptr) {
+            return;
+        }
+        pcmRingTimer_ = std::make_unique<utility::Timer>([this]() {
+            utility::Message msg(A2DP_PCM_PUSH, 0, nullptr);
+            A2dpEncoderInitPeerParams peerParams = {};
+            PostMessage(msg, peerParams, nullptr, nullptr, nullptr);
+        });
+        if (!pcmRingTimer_->Start(A2DP_PCM_RING_TICK_MS, true)) {
+            LOG_ERROR("[A2dpCodecThread]%{public}s start timer failed\n", __func__);
+            pcmRingTimer_ = nullptr;
+        }
+    } else if (pcmRingTimer_ != nullptr) {
+        pcmRingTimer_->Stop();
+        pcmRingTimer_ = nullptr;
+    }
+}
+
+void A2dpCodecThread::PlayoutFrame(std::unique_ptr<A2dpSinkFrame> frame)
+{
+    if (frame == nullptr || playout_ == nullptr) {
+        return;
+    }
+    if (frame->handle != sinkHandle_) {
+        sinkHandle_ = frame->handle;
+        AVDT_SetMediaClockRate(sinkHandle_, sinkClockRate_);
+    }
+    playout_->Push(std::move(frame));
+    PlayoutTick();
+}
+
+void A2dpCodecThread::PlayoutTick()
+{
+    if (playout_ == nullptr || decoder_ == nullptr) {
+        return;
+    }
+
+    uint64_t nowUs = A2dpSinkPlayout::NowUs();
+    std::unique_ptr<A2dpSinkFrame> frame = nullptr;
+    std::vector<uint8_t> pcm {};
+    A2dpSinkPlayout::Action action;
+    while ((action = playout_->Pull(nowUs, frame)) != A2dpSinkPlayout::PLAYOUT_NONE) {
+        if (action == A2dpSinkPlayout::PLAYOUT_PLAY) {
+            decoder_->DecodePacket(frame->data.data(), frame->data.size());
+        } else if (playout_->ConcealPcm(pcm)) {
+            decoderObserver_->DataAvailable(pcm.data(), pcm.size());
+        }
+    }
+
+    uint16_t delayValue = 0;
+    if (sinkHandle_ != 0 && playout_->TakeDelayReport(nowUs, delayValue)) {
+        A2dpSinkPlayout::Stats stats = playout_->GetStats();
+        LOG_INFO("[A2dpCodecThread]%{public}s delay:%{public}hu played:%{public}u concealed:%{public}u "
+            "underruns:%{public}u late:%{public}u drift:%{public}d\n", __func__, delayValue, stats.played,
+            stats.concealed, stats.underruns, stats.late, stats.driftPpm);
+        A2dpProfile::ReportSinkDelay(sinkHandle_, delayValue);
+    }
+}
+
 void A2dpCodecThread::SourceEncode(
     const A2dpEncoderInitPeerParams &peerParams, const A2dpCodecConfig &config, const A2dpEncoderObserver &observer)
 {
@@ -162,6 +297,7 @@ void A2dpCodecThread::SourceEncode(
             encoder_ = std::make_unique<A2dpSbcEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
                 &const_cast<A2dpCodecConfig &>(config),
                 &const_cast<A2dpEncoderObserver &>(observer));
+            encoder_->SetPcmRing(g_pcmRing.get());
             break;
         case A2DP_SOURCE_CODEC_INDEX_AAC:
         case A2DP_SINK_CODEC_INDEX_AAC:
@@ -169,6 +305,7 @@ void A2dpCodecThread::SourceEncode(
             encoder_ = std::make_unique<A2dpAacEncoder>(&const_cast<A2dpEncoderInitPeerParams &>(peerParams),
                 &const_cast<A2dpCodecConfig &>(config),
                 &const_cast<A2dpEncoderObserver &>(observer));
+            encoder_->SetPcmRing(g_pcmRing.get());
             break;
         default:
             break;
@@ -179,22 +316,41 @@ void A2dpCodecThread::SinkDecode(const A2dpCodecConfig &config, A2dpDecoderObser
 {
     LOG_INFO("[A2dpCodecThread]%{public}s index:%u\n", __func__, config.GetCodecIndex());
 
+    // the decoder hands its pcm to the playout first, which keeps it for concealment
+    sinkClockRate_ = A2dpSinkPlayout::GetClockRate(config.GetCodecConfig());
+    sinkHandle_ = 0;
+    playout_ = std::make_unique<A2dpSinkPlayout>(sinkClockRate_);
+    playoutObserver_ = std::make_unique<A2dpSinkPlayoutObserver>(*playout_, observer);
+    decoderObserver_ = &observer;
+
     switch (config.GetCodecIndex()) {
         case A2DP_SINK_CODEC_INDEX_SBC:
         case A2DP_SOURCE_CODEC_INDEX_SBC:
             if (decoder_ == nullptr) {
-                decoder_ = std::make_unique<A2dpSbcDecoder>(&observer);
+                decoder_ = std::make_unique<A2dpSbcDecoder>(playoutObserver_.get());
             }
             break;
         case A2DP_SOURCE_CODEC_INDEX_AAC:
         case A2DP_SINK_CODEC_INDEX_AAC:
             if (decoder_ == nullptr) {
-                decoder_ = std::make_unique<A2dpAacDecoder>(&observer);
+                decoder_ = std::make_unique<A2dpAacDecoder>(playoutObserver_.get());
             }
 
             break;
         default:
             break;
     }
+
+    if (decoder_ != nullptr && playoutTimer_ == nullptr) {
+        playoutTimer_ = std::make_unique<utility::Timer>([this]() {
+            utility::Message msg(A2DP_PLAYOUT_TICK, 0, nullptr);
+            A2dpEncoderInitPeerParams peerParams = {};
+            PostMessage(msg, peerParams, nullptr, nullptr, nullptr);
+        });
+        if (!playoutTimer_->Start(A2DP_PLAYOUT_TICK_MS, true)) {
+            LOG_ERROR("[A2dpCodecThread]%{public}s start timer failed\n", __func__);
+            playoutTimer_ = nullptr;
+        }
+    }
 }
 }  // namespace bluetooth
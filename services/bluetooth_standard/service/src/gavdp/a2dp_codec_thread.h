@@ -24,10 +24,13 @@
 #include "a2dp_codec/include/a2dp_codec_wrapper.h"
 #include "a2dp_codec/include/a2dp_codec_config.h"
 #include "a2dp_codec/include/a2dp_codec_constant.h"
+#include "a2dp_pcm_ring.h"
 #include "a2dp_profile_peer.h"
+#include "a2dp_sink_playout.h"
 #include "base_def.h"
 #include "dispatcher.h"
 #include "message.h"
+#include "timer.h"
 
 namespace bluetooth {
 using utility::Dispatcher;
@@ -40,6 +43,11 @@ constexpr int A2DP_PCM_ENCODED = 4;
 constexpr int A2DP_FRAME_DECODED = 5;
 constexpr int A2DP_FRAME_READY = 6;
 constexpr int A2DP_PCM_PUSH = 7;
+constexpr int A2DP_PLAYOUT_TICK = 8;
+/* Codec tick that pulls pcm from the shared ring while one is open. */
+constexpr int A2DP_PCM_RING_TICK_MS = 20;
+/* Sink tick that plays out the due packets, the granularity of the playout schedule. */
+constexpr int A2DP_PLAYOUT_TICK_MS = 5;
 
 class A2dpCodecThread {
 public:
@@ -125,6 +133,23 @@ public:
 
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) const;
 
+    /**
+     * @brief Open the shared pcm ring the application writes into. While it is open the codec thread
+     *        pulls pcm from it every A2DP_PCM_RING_TICK_MS instead of taking WriteFrame data.
+     * @param owner The client opening the ring, only it may reopen or close the ring.
+     * @param size Ring capacity in bytes.
+     * @return Returns the ring fd to hand to the application, or RET_BAD_STATUS if another client owns the ring.
+     * @since 6.0
+     */
+    static int OpenPcmRing(int owner, uint32_t size);
+
+    /**
+     * @brief Close the shared pcm ring and go back to WriteFrame data.
+     * @param owner The client closing the ring, ignored unless it owns the ring.
+     * @since 6.0
+     */
+    static void ClosePcmRing(int owner);
+
 private:
     /**
      * @brief Source side  encode
@@ -141,10 +166,46 @@ private:
      */
     void SinkDecode(const A2dpCodecConfig &config, A2dpDecoderObserver &observer);
 
+    /**
+     * @brief Start or stop pulling pcm from the shared ring, as the ring and the thread state require.
+     *
+     * @since 6.0
+     */
+    void UpdatePcmRingTimer();
+
+    /**
+     * @brief Mark the shared pcm ring closed for its owner and drop it, call with g_codecMutex held.
+     *
+     * @since 6.0
+     */
+    static void ReleasePcmRing();
+
+    /**
+     * @brief Put a received packet into the playout of the sink, and play out what is due.
+     *
+     * @param frame The packet, stamped with its arrival time.
+     * @since 6.0
+     */
+    void PlayoutFrame(std::unique_ptr<A2dpSinkFrame> frame);
+
+    /**
+     * @brief Decode the due packets of the sink, conceal the missing ones and report a changed delay.
+     *
+     * @since 6.0
+     */
+    void PlayoutTick();
+
     std::string name_ {};
     std::unique_ptr<Dispatcher> dispatcher_ {};
     std::unique_ptr<A2dpEncoder> encoder_ = nullptr;
     std::unique_ptr<A2dpDecoder> decoder_ = nullptr;
+    std::unique_ptr<utility::Timer> pcmRingTimer_ = nullptr;
+    std::unique_ptr<A2dpSinkPlayout> playout_ = nullptr;
+    std::unique_ptr<A2dpSinkPlayoutObserver> playoutObserver_ = nullptr;
+    std::unique_ptr<utility::Timer> playoutTimer_ = nullptr;
+    A2dpDecoderObserver *decoderObserver_ = nullptr;
+    uint16_t sinkHandle_ = 0;
+    uint32_t sinkClockRate_ = 0;
     static A2dpCodecThread *g_instance;
     bool threadInit = false;
     bool isSbc_ = false;
@@ -364,6 +364,20 @@ void A2dpProfile::GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize
     codecThread->GetRenderPosition(delayValue, sendDataSize, timeStamp);
 }
 
+int A2dpProfile::OpenPcmRing(int owner, uint32_t size)
+{
+    LOG_INFO("[A2dpProfile] %{public}s owner(%{public}d) size(%u)\n", __func__, owner, size);
+
+    return A2dpCodecThread::OpenPcmRing(owner, size);
+}
+
+void A2dpProfile::ClosePcmRing(int owner)
+{
+    LOG_INFO("[A2dpProfile] %{public}s owner(%{public}d)\n", __func__, owner);
+
+    A2dpCodecThread::ClosePcmRing(owner);
+}
+
 void A2dpProfile::CreateSEPConfigureInfo(uint8_t role)
 {
     AvdtStreamConfig cfg[AVDT_NUM_SEPS] = {};
@@ -970,13 +984,44 @@ void ProcessSinkStream(uint16_t handle, Packet *pkt, uint32_t timeStamp, uint8_t
     if (packetSize == 0) {
         return;
     }
-    auto frameData = (uint8_t *)malloc(packetSize);
-    if (frameData != nullptr) {
-        (void)memset_s(frameData, packetSize, 0, packetSize);
-        PacketRead(pkt, frameData, 0, packetSize);
-        A2dpEncoderInitPeerParams peerParams = {};
-        utility::Message msg(A2DP_FRAME_READY, packetSize, frameData);
-        codecThread->PostMessage(msg, peerParams, nullptr, nullptr, nullptr);
+    // stamped here, the playout measures the jitter from the arrival on the stack thread
+    auto frame = std::make_unique<A2dpSinkFrame>();
+    frame->handle = handle;
+    frame->timestamp = timeStamp;
+    frame->arrivalUs = A2dpSinkPlayout::NowUs();
+    frame->data.resize(packetSize);
+    PacketRead(pkt, frame->data.data(), 0, packetSize);
+    A2dpEncoderInitPeerParams peerParams = {};
+    utility::Message msg(A2DP_FRAME_READY, packetSize, frame.release());
+    codecThread->PostMessage(msg, peerParams, nullptr, nullptr, nullptr);
+}
+
+void A2dpProfile::ReportSinkDelay(const uint16_t handle, const uint16_t delayValue)
+{
+    A2dpService *service = GetServiceInstance(A2DP_ROLE_SINK);
+    if (service == nullptr) {
+        LOG_ERROR("[A2dpProfile]%{public}s Can't find the instance of service \n", __func__);
+        return;
+    }
+
+    service->GetDispatcher()->PostTask([handle, delayValue]() {
+        A2dpProfile *profile = GetProfileInstance(A2DP_ROLE_SINK);
+        A2dpProfilePeer *peer = (profile != nullptr) ? profile->FindPeerByHandle(handle) : nullptr;
+        if (peer == nullptr || !peer->GetDelayReport()) {
+            return;
+        }
+        LOG_INFO("[A2dpProfile]%{public}s handle(%u) delay(%u)\n", __func__, handle, delayValue);
+        SendDelay(handle, delayValue);
+    });
+}
+
+void A2dpProfile::SendInitialDelay(const BtAddr &addr, const uint16_t handle) const
+{
+    A2dpProfilePeer *peer = FindPeerByAddress(addr);
+    if (GetRole() != A2DP_ROLE_SINK || peer == nullptr || !peer->GetDelayReport()) {
+        return;
     }
+    LOG_INFO("[A2dpProfile]%{public}s handle(%u)\n", __func__, handle);
+    SendDelay(handle, A2dpSinkPlayout::GetInitialDelayValue());
 }
 }  // namespace bluetooth
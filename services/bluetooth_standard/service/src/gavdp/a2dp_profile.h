@@ -195,6 +195,26 @@ public:
      */
     static int SendDelay(const uint16_t handle, const uint16_t delayValue);
 
+    /**
+     * @brief A function used to report a changed delay of the sink playout to source. It is sent from the
+     *        service thread, as AVDT_DelayReq waits for the stack thread, which the codec thread must not block.
+     *
+     * @param[in] handle The local handle of stream
+     * @param[in] delayValue The delay in 1/10 milliseconds
+     * @since 6.0
+     */
+    static void ReportSinkDelay(const uint16_t handle, const uint16_t delayValue);
+
+    /**
+     * @brief A function used to report the delay of sink before the stream is opened, if the stream is
+     *        configured with delay reporting.
+     *
+     * @param[in] addr The address of peer device
+     * @param[in] handle The local handle of stream
+     * @since 6.0
+     */
+    void SendInitialDelay(const BtAddr &addr, const uint16_t handle) const;
+
     /**
      * @brief A function used to reconfigrue the stream
      *
@@ -464,6 +484,10 @@ public:
 
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp);
 
+    int OpenPcmRing(int owner, uint32_t size);
+
+    void ClosePcmRing(int owner);
+
 private:
     /**
      * @brief Get the instance of SDP.
@@ -341,6 +341,17 @@ void A2dpProfilePeer::SetStreamHandle(uint16_t handle)
     streamHandle_ = handle;
 }
 
+void A2dpProfilePeer::SetDelayReport(bool delayReport)
+{
+    LOG_INFO("[A2dpProfilePeer] %{public}s delayReport(%{public}d)\n", __func__, delayReport);
+    delayReport_ = delayReport;
+}
+
+bool A2dpProfilePeer::GetDelayReport() const
+{
+    return delayReport_;
+}
+
 void A2dpProfilePeer::SetAcpSeid(uint8_t seid)
 {
     LOG_INFO("[A2dpProfilePeer] %{public}s seid(%u)\n", __func__, seid);
@@ -997,6 +1008,7 @@ void A2dpProfilePeer::SetConfigure()
     configureStream_.cfg.mediaType = streamCtrl_[selectbleStreamIndex_].GetPeerSEPInformation().mediaType;
     configureStream_.cfg.numCodec = streamCtrl_[selectbleStreamIndex_].GetPeerSEPInformation().numCodec;
     configureStream_.cfg.pscMask = streamCtrl_[selectbleStreamIndex_].GetPeerSEPInformation().pscMask;
+    SetDelayReport((configureStream_.cfg.pscMask & AVDT_PSC_MSK_DELAY_RPT) != 0);
     configureStream_.intSeid = intId_;
     configureStream_.acpSeid = acpId_;
     configureStream_.addr = peerAddress_;
@@ -226,6 +226,22 @@ public:
      */
     void SetStreamHandle(uint16_t handle);
 
+    /**
+     * @brief A function used to save whether the stream is configured with delay reporting.
+     *
+     * @param[in] delayReport Whether the configuration includes delay reporting
+     * @since 6.0
+     */
+    void SetDelayReport(bool delayReport);
+
+    /**
+     * @brief A function used to get whether the stream is configured with delay reporting.
+     *
+     * @return true if the sink reports its delay to source
+     * @since 6.0
+     */
+    bool GetDelayReport() const;
+
     /**
      * @brief A function used to save the seid of peer stream endpoint
      *
@@ -702,6 +718,7 @@ private:
     uint8_t sourceStreamNum_ = (A2DP_SOURCE_CODEC_INDEX_MAX - A2DP_SOURCE_CODEC_INDEX_SBC);
     uint8_t sinkStreamNum_ = (A2DP_SINK_CODEC_INDEX_MAX - A2DP_SINK_CODEC_INDEX_MIN);
     uint16_t streamHandle_ = 0;
+    bool delayReport_ = false;
     BtAddr peerAddress_ {};
     A2dpStream streamCtrl_[A2DP_CODEC_INDEX_MAX - A2DP_SOURCE_CODEC_INDEX_SBC];
     A2dpCodecFactory *codecConfig_ = nullptr;
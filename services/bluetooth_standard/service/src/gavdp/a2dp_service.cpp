@@ -892,6 +892,31 @@ void A2dpService::GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize
     }
 }
 
+int A2dpService::OpenPcmRing(int owner, uint32_t size)
+{
+    LOG_INFO("[A2dpService] %{public}s\n", __func__);
+
+    if (role_ != A2DP_ROLE_SOURCE) {
+        return RET_NO_SUPPORT;
+    }
+    A2dpProfile *profile = GetProfileInstance(role_);
+    if (profile == nullptr) {
+        LOG_ERROR("[A2dpService] %{public}s Failed to get profile instance. role_(%u)\n", __func__, role_);
+        return RET_BAD_STATUS;
+    }
+    return profile->OpenPcmRing(owner, size);
+}
+
+void A2dpService::ClosePcmRing(int owner)
+{
+    LOG_INFO("[A2dpService] %{public}s\n", __func__);
+
+    A2dpProfile *profile = GetProfileInstance(role_);
+    if (role_ == A2DP_ROLE_SOURCE && profile != nullptr) {
+        profile->ClosePcmRing(owner);
+    }
+}
+
 int A2dpService::GetMaxConnectNum()
 {
     LOG_INFO("[A2dpService] %{public}s\n", __func__);
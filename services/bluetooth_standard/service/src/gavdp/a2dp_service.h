@@ -389,6 +389,10 @@ public:
     int WriteFrame(const uint8_t *data, uint32_t size) override;
 
     void GetRenderPosition(uint16_t &delayValue, uint16_t &sendDataSize, uint32_t &timeStamp) override;
+
+    int OpenPcmRing(int owner, uint32_t size) override;
+
+    void ClosePcmRing(int owner) override;
     /**
      * @brief Get boject pointer of A2dpConnectManager.
      *
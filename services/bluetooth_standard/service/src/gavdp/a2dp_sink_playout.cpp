@@ -0,0 +1,437 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "a2dp_sink_playout.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iterator>
+#include <ctime>
+#include "log.h"
+#include "securec.h"
+
+namespace bluetooth {
+namespace {
+constexpr int64_t US_PER_SECOND = 1000000;
+constexpr int64_t INITIAL_TARGET_DELAY_US = 80000;
+constexpr int64_t MIN_TARGET_DELAY_US = 40000;
+constexpr int64_t MAX_TARGET_DELAY_US = 300000;
+/* Headroom over the 95th percentile of the lateness. */
+constexpr int64_t TARGET_MARGIN_US = 10000;
+/* Most the target delay shrinks by per window. */
+constexpr int64_t TARGET_DECREASE_US = 10000;
+constexpr size_t LATENESS_PERCENTILE = 95;
+constexpr size_t PERCENT = 100;
+/* Packets between two target updates inside a window. */
+constexpr size_t TUNE_INTERVAL = 16;
+/* Media time of a window of the drift estimation. */
+constexpr int64_t DRIFT_WINDOW_US = 2000000;
+constexpr double DRIFT_SMOOTHING = 8.0;
+constexpr double MAX_DRIFT = 0.0003;
+constexpr double PPM = 1000000.0;
+/* A timestamp or arrival gap this long is a new stream, not jitter. */
+constexpr int64_t RESYNC_GAP_US = 1000000;
+/* Media time the jitter buffer holds before the oldest packets are dropped. */
+constexpr int64_t MAX_QUEUE_US = 2 * MAX_TARGET_DELAY_US;
+/* Concealment stops after this long without packets, the source paused and playout waits to rebuffer. */
+constexpr int64_t MAX_CONCEAL_US = 200000;
+/* Concealed packets in a row that fade the last pcm by half each, silence after. */
+constexpr uint32_t CONCEAL_FADE_RUN = 3;
+/* The playout delay follows the target delay by at most one packet per interval. */
+constexpr uint64_t GROW_INTERVAL_US = 50000;
+constexpr uint64_t SHRINK_INTERVAL_US = 1000000;
+/* Allowance for the pcm buffered past the sink, in the audio service and the renderer. */
+constexpr int64_t RENDER_DELAY_US = 20000;
+constexpr int64_t DELAY_REPORT_STEP_US = 10000;
+constexpr uint64_t DELAY_REPORT_INTERVAL_US = 1000000;
+/* Delay reports are in 1/10 milliseconds. */
+constexpr int64_t DELAY_REPORT_UNIT_US = 100;
+constexpr uint32_t DEFAULT_CLOCK_RATE = 44100;
+}  // namespace
+
+A2dpSinkPlayout::A2dpSinkPlayout(uint32_t clockRate)
+    : clockRate_((clockRate != 0) ? clockRate : DEFAULT_CLOCK_RATE),
+      targetDelayUs_(INITIAL_TARGET_DELAY_US),
+      playoutDelayUs_(INITIAL_TARGET_DELAY_US)
+{}
+
+bool A2dpSinkPlayout::Push(std::unique_ptr<A2dpSinkFrame> frame)
+{
+    if (frame == nullptr) {
+        return false;
+    }
+    stats_.received++;
+
+    if (hasTimestamp_) {
+        int64_t step = static_cast<int32_t>(frame->timestamp - lastTimestamp_);
+        bool paused = queue_.empty() && (frame->arrivalUs > lastArrivalUs_ + RESYNC_GAP_US);
+        if (std::llabs(MediaUs(step)) > RESYNC_GAP_US || paused) {
+            LOG_INFO("[A2dpSinkPlayout]%{public}s resync step:%{public}lld", __func__, static_cast<long long>(step));
+            Reset();
+            stats_.resyncs++;
+        }
+    }
+    lastArrivalUs_ = frame->arrivalUs;
+
+    bool hadTimestamp = hasTimestamp_;
+    int64_t prevExtTimestamp = lastExtTimestamp_;
+    int64_t extTimestamp = ExtendTimestamp(frame->timestamp);
+    if (started_ && extTimestamp < nextTimestamp_) {
+        stats_.late++;
+        return false;
+    }
+    if (queue_.find(extTimestamp) != queue_.end()) {
+        stats_.duplicated++;
+        return false;
+    }
+    if (hadTimestamp && extTimestamp > prevExtTimestamp) {
+        UpdateStride(extTimestamp - prevExtTimestamp);
+    }
+    UpdateTransit(MediaUs(extTimestamp), frame->arrivalUs);
+    queue_.emplace(extTimestamp, std::move(frame));
+
+    while (queue_.size() > 1 && MediaUs(queue_.rbegin()->first - queue_.begin()->first) > MAX_QUEUE_US) {
+        queue_.erase(queue_.begin());
+        stats_.overflows++;
+        if (started_) {
+            nextTimestamp_ = std::max(nextTimestamp_, queue_.begin()->first);
+        }
+    }
+    return true;
+}
+
+A2dpSinkPlayout::Action A2dpSinkPlayout::Pull(uint64_t nowUs, std::unique_ptr<A2dpSinkFrame> &frame)
+{
+    frame = nullptr;
+    if (!started_) {
+        playoutDelayUs_ = targetDelayUs_;
+        if (queue_.empty() || PlayoutUs(queue_.begin()->first) > nowUs) {
+            return PLAYOUT_NONE;
+        }
+        started_ = true;
+        nextTimestamp_ = queue_.begin()->first;
+        concealRun_ = 0;
+        adjustTimeUs_ = nowUs;
+    }
+
+    int64_t strideUs = MediaUs(stride_);
+    auto it = queue_.begin();
+    while (it != queue_.end() && (stride_ == 0 || it->first < nextTimestamp_ + stride_)) {
+        if (PlayoutUs(it->first) > nowUs) {
+            return PLAYOUT_NONE;
+        }
+        if (stride_ != 0 && playoutDelayUs_ + strideUs <= targetDelayUs_ &&
+            nowUs >= adjustTimeUs_ + GROW_INTERVAL_US) {
+            // grow by concealing in front of the packet, which then plays one packet later
+            playoutDelayUs_ += strideUs;
+            adjustTimeUs_ = nowUs;
+            concealRun_++;
+            stats_.concealed++;
+            return PLAYOUT_CONCEAL;
+        }
+        auto next = std::next(it);
+        if (next != queue_.end() && playoutDelayUs_ >= targetDelayUs_ + strideUs &&
+            nowUs >= adjustTimeUs_ + SHRINK_INTERVAL_US) {
+            // shrink by dropping the packet, the next one is already here to take its place
+            playoutDelayUs_ -= strideUs;
+            adjustTimeUs_ = nowUs;
+            nextTimestamp_ = it->first + stride_;
+            queue_.erase(it);
+            it = next;
+            stats_.dropped++;
+            continue;
+        }
+        frame = std::move(it->second);
+        nextTimestamp_ = it->first + stride_;
+        queue_.erase(it);
+        concealRun_ = 0;
+        stats_.played++;
+        return PLAYOUT_PLAY;
+    }
+
+    // the packet due next is missing
+    if (stride_ == 0 || PlayoutUs(nextTimestamp_) > nowUs) {
+        return PLAYOUT_NONE;
+    }
+    if (queue_.empty()) {
+        if (strideUs * concealRun_ >= MAX_CONCEAL_US) {
+            started_ = false;
+            return PLAYOUT_NONE;
+        }
+        if (concealRun_ == 0) {
+            stats_.underruns++;
+            LOG_WARN("[A2dpSinkPlayout]%{public}s underrun delay:%{public}lld",
+                __func__, static_cast<long long>(playoutDelayUs_));
+        }
+    }
+
+    if (queue_.empty() && playoutDelayUs_ + strideUs <= MAX_TARGET_DELAY_US) {
+        // nothing to skip to, delay the playout by the concealed packet so the late ones still play
+        playoutDelayUs_ += strideUs;
+        targetDelayUs_ = std::max(targetDelayUs_, playoutDelayUs_);
+        adjustTimeUs_ = nowUs;
+    } else {
+        nextTimestamp_ += stride_;
+    }
+    concealRun_++;
+    stats_.concealed++;
+    return PLAYOUT_CONCEAL;
+}
+
+void A2dpSinkPlayout::SavePcm(const uint8_t *buf, uint32_t size)
+{
+    if (buf == nullptr || size == 0) {
+        return;
+    }
+    lastPcm_.assign(buf, buf + size);
+}
+
+bool A2dpSinkPlayout::ConcealPcm(std::vector<uint8_t> &pcm)
+{
+    if (lastPcm_.empty()) {
+        return false;
+    }
+
+    pcm.assign(lastPcm_.size(), 0);
+    if (concealRun_ > CONCEAL_FADE_RUN) {
+        return true;
+    }
+    for (size_t i = 0; i + sizeof(int16_t) <= lastPcm_.size(); i += sizeof(int16_t)) {
+        int16_t sample = 0;
+        (void)memcpy_s(&sample, sizeof(sample), &lastPcm_[i], sizeof(int16_t));
+        sample = static_cast<int16_t>(sample >> concealRun_);
+        (void)memcpy_s(&pcm[i], sizeof(int16_t), &sample, sizeof(sample));
+    }
+    return true;
+}
+
+bool A2dpSinkPlayout::TakeDelayReport(uint64_t nowUs, uint16_t &delayValue)
+{
+    int64_t delayUs = playoutDelayUs_ + RENDER_DELAY_US;
+    if (reported_ && (std::llabs(delayUs - reportedDelayUs_) < DELAY_REPORT_STEP_US ||
+        nowUs < reportTimeUs_ + DELAY_REPORT_INTERVAL_US)) {
+        return false;
+    }
+
+    reported_ = true;
+    reportedDelayUs_ = delayUs;
+    reportTimeUs_ = nowUs;
+    delayValue = static_cast<uint16_t>(std::min<int64_t>(delayUs / DELAY_REPORT_UNIT_US, UINT16_MAX));
+    return true;
+}
+
+void A2dpSinkPlayout::Reset()
+{
+    // the target delay, the lateness history and the drift are kept, the link and the source clock are the same
+    queue_.clear();
+    hasTimestamp_ = false;
+    lastTimestamp_ = 0;
+    lastExtTimestamp_ = 0;
+    stride_ = 0;
+    strides_.fill(0);
+    strideIndex_ = 0;
+    hasAnchor_ = false;
+    hasPrevWindow_ = false;
+    started_ = false;
+    nextTimestamp_ = 0;
+    concealRun_ = 0;
+}
+
+A2dpSinkPlayout::Stats A2dpSinkPlayout::GetStats() const
+{
+    Stats stats = stats_;
+    stats.targetDelayUs = static_cast<uint32_t>(targetDelayUs_);
+    stats.playoutDelayUs = static_cast<uint32_t>(playoutDelayUs_);
+    stats.driftPpm = static_cast<int32_t>(drift_ * PPM);
+    return stats;
+}
+
+uint64_t A2dpSinkPlayout::NowUs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * US_PER_SECOND + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+uint32_t A2dpSinkPlayout::GetClockRate(const A2dpCodecCapability &config)
+{
+    switch (config.codecIndex_) {
+        case A2DP_SOURCE_CODEC_INDEX_SBC:
+        case A2DP_SINK_CODEC_INDEX_SBC:
+            if (config.sampleRate_ & A2DP_SBC_SAMPLE_RATE_48000) {
+                return 48000;
+            } else if (config.sampleRate_ & A2DP_SBC_SAMPLE_RATE_32000) {
+                return 32000;
+            } else if (config.sampleRate_ & A2DP_SBC_SAMPLE_RATE_16000) {
+                return 16000;
+            }
+            break;
+        case A2DP_SOURCE_CODEC_INDEX_AAC:
+        case A2DP_SINK_CODEC_INDEX_AAC:
+            if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET2_48000) {
+                return 48000;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET2_96000) {
+                return 96000;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET2_88200) {
+                return 88200;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET2_64000) {
+                return 64000;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET1_32000) {
+                return 32000;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET1_24000) {
+                return 24000;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET1_22050) {
+                return 22050;
+            } else if (config.sampleRate_ & A2DP_AAC_SAMPLE_RATE_OCTET1_16000) {
+                return 16000;
+            }
+            break;
+        default:
+            break;
+    }
+    return DEFAULT_CLOCK_RATE;
+}
+
+uint16_t A2dpSinkPlayout::GetInitialDelayValue()
+{
+    return static_cast<uint16_t>((INITIAL_TARGET_DELAY_US + RENDER_DELAY_US) / DELAY_REPORT_UNIT_US);
+}
+
+int64_t A2dpSinkPlayout::ExtendTimestamp(uint32_t timestamp)
+{
+    if (!hasTimestamp_) {
+        hasTimestamp_ = true;
+        lastTimestamp_ = timestamp;
+        lastExtTimestamp_ = 0;
+        return 0;
+    }
+
+    int64_t extTimestamp = lastExtTimestamp_ + static_cast<int32_t>(timestamp - lastTimestamp_);
+    if (extTimestamp > lastExtTimestamp_) {
+        lastTimestamp_ = timestamp;
+        lastExtTimestamp_ = extTimestamp;
+    }
+    return extTimestamp;
+}
+
+int64_t A2dpSinkPlayout::MediaUs(int64_t extTimestamp) const
+{
+    return extTimestamp * US_PER_SECOND / clockRate_;
+}
+
+int64_t A2dpSinkPlayout::FloorTransit(int64_t mediaUs) const
+{
+    return anchorTransit_ + static_cast<int64_t>(drift_ * (mediaUs - anchorMediaUs_));
+}
+
+uint64_t A2dpSinkPlayout::PlayoutUs(int64_t extTimestamp) const
+{
+    int64_t mediaUs = MediaUs(extTimestamp);
+    return static_cast<uint64_t>(mediaUs + FloorTransit(mediaUs) + playoutDelayUs_);
+}
+
+void A2dpSinkPlayout::UpdateStride(int64_t step)
+{
+    strides_[strideIndex_] = step;
+    strideIndex_ = (strideIndex_ + 1) % STRIDE_HISTORY;
+
+    int64_t stride = INT64_MAX;
+    for (int64_t value : strides_) {
+        if (value > 0) {
+            stride = std::min(stride, value);
+        }
+    }
+    stride_ = stride;
+}
+
+void A2dpSinkPlayout::UpdateTransit(int64_t mediaUs, uint64_t arrivalUs)
+{
+    int64_t transit = static_cast<int64_t>(arrivalUs) - mediaUs;
+    if (!hasAnchor_) {
+        hasAnchor_ = true;
+        anchorTransit_ = transit;
+        anchorMediaUs_ = mediaUs;
+        windowStartUs_ = mediaUs;
+        windowMin_ = transit;
+        windowMinMediaUs_ = mediaUs;
+    }
+
+    // a packet faster than the floor moves the floor down at once
+    int64_t floor = FloorTransit(mediaUs);
+    if (transit < floor) {
+        anchorTransit_ = transit;
+        anchorMediaUs_ = mediaUs;
+        floor = transit;
+    }
+    if (transit < windowMin_) {
+        windowMin_ = transit;
+        windowMinMediaUs_ = mediaUs;
+    }
+
+    lateness_[latenessIndex_] = transit - floor;
+    latenessIndex_ = (latenessIndex_ + 1) % LATENESS_HISTORY;
+    latenessCount_ = std::min(latenessCount_ + 1, LATENESS_HISTORY);
+
+    if (mediaUs - windowStartUs_ >= DRIFT_WINDOW_US) {
+        CloseWindow(mediaUs);
+    } else if (latenessIndex_ % TUNE_INTERVAL == 0) {
+        TuneTarget(false);
+    }
+}
+
+void A2dpSinkPlayout::CloseWindow(int64_t mediaUs)
+{
+    if (hasPrevWindow_ && windowMinMediaUs_ > prevWindowMinMediaUs_) {
+        double slope = static_cast<double>(windowMin_ - prevWindowMin_) / (windowMinMediaUs_ - prevWindowMinMediaUs_);
+        drift_ += (slope - drift_) / DRIFT_SMOOTHING;
+        drift_ = std::max(-MAX_DRIFT, std::min(drift_, MAX_DRIFT));
+    }
+    hasPrevWindow_ = true;
+    prevWindowMin_ = windowMin_;
+    prevWindowMinMediaUs_ = windowMinMediaUs_;
+
+    // re-anchor on the drift line, a source clock slower than ours never lowers the floor by itself
+    anchorTransit_ = FloorTransit(mediaUs);
+    anchorMediaUs_ = mediaUs;
+    windowStartUs_ = mediaUs;
+    windowMin_ = INT64_MAX;
+    windowMinMediaUs_ = mediaUs;
+    TuneTarget(true);
+}
+
+void A2dpSinkPlayout::TuneTarget(bool window)
+{
+    if (latenessCount_ == 0) {
+        return;
+    }
+
+    std::array<int64_t, LATENESS_HISTORY> sorted = lateness_;
+    size_t rank = latenessCount_ * LATENESS_PERCENTILE / PERCENT;
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + latenessCount_);
+    int64_t desired = std::max(MIN_TARGET_DELAY_US, std::min(sorted[rank] + TARGET_MARGIN_US, MAX_TARGET_DELAY_US));
+
+    if (desired > targetDelayUs_) {
+        targetDelayUs_ = desired;
+    } else if (window) {
+        targetDelayUs_ = std::max(desired, targetDelayUs_ - TARGET_DECREASE_US);
+    }
+}
+
+void A2dpSinkPlayoutObserver::DataAvailable(uint8_t *buf, uint32_t size)
+{
+    playout_.SavePcm(buf, size);
+    observer_.DataAvailable(buf, size);
+}
+}  // namespace bluetooth
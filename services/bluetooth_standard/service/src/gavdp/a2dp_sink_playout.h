@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef A2DP_SINK_PLAYOUT_H
+#define A2DP_SINK_PLAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "a2dp_codec/include/a2dp_codec_config.h"
+#include "a2dp_codec/include/a2dp_codec_wrapper.h"
+#include "base_def.h"
+
+namespace bluetooth {
+/**
+ * @brief A media packet received by the sink, waiting for its playout time.
+ *
+ * @since 6.0
+ */
+struct A2dpSinkFrame {
+    uint16_t handle = 0;
+    uint32_t timestamp = 0;
+    uint64_t arrivalUs = 0;
+    std::vector<uint8_t> data {};
+};
+
+/**
+ * @brief Playout scheduler of the sink, between AVDTP and the decoder.
+ *
+ * Packets are held in a jitter buffer ordered by RTP timestamp. A packet is due when the local monotonic clock reaches
+ * the arrival time it would have had on the fastest path seen so far, plus the playout delay. The fastest path (the
+ * transit floor) follows the drift of the source clock, which is estimated from the slope of the transit minima of
+ * successive windows. The target delay is the 95th percentile of the lateness of recent packets over that floor plus
+ * a margin. It grows at once and shrinks slowly.
+ *
+ * As the pcm goes to a renderer that plays it at a fixed rate, the playout delay only follows the target by one packet
+ * at a time: a concealment is inserted to grow it, a packet is dropped to shrink it. A lost packet is skipped and
+ * concealed by repeating the last pcm with fading. On an underrun the concealment is inserted instead, so the late
+ * packets still play. The playout delay is what the sink reports to the source for lip sync.
+ *
+ * All methods are called on the codec thread.
+ *
+ * @since 6.0
+ */
+class A2dpSinkPlayout {
+public:
+    enum Action : uint8_t {
+        PLAYOUT_NONE = 0,
+        PLAYOUT_PLAY,
+        PLAYOUT_CONCEAL,
+    };
+
+    struct Stats {
+        uint32_t received = 0;
+        uint32_t played = 0;
+        uint32_t concealed = 0;
+        uint32_t underruns = 0;
+        uint32_t late = 0;
+        uint32_t duplicated = 0;
+        uint32_t dropped = 0;
+        uint32_t overflows = 0;
+        uint32_t resyncs = 0;
+        uint32_t targetDelayUs = 0;
+        uint32_t playoutDelayUs = 0;
+        int32_t driftPpm = 0;
+    };
+
+    /**
+     * @brief A constructor used to create an <b>A2dpSinkPlayout</b> instance.
+     *
+     * @param clockRate The RTP clock rate of the stream, which is the sample rate.
+     * @since 6.0
+     */
+    explicit A2dpSinkPlayout(uint32_t clockRate);
+
+    ~A2dpSinkPlayout() = default;
+
+    /**
+     * @brief Put a received packet into the jitter buffer.
+     *
+     * @param frame The packet, stamped with its arrival time.
+     * @return Returns false if the packet is dropped as late or duplicated.
+     * @since 6.0
+     */
+    bool Push(std::unique_ptr<A2dpSinkFrame> frame);
+
+    /**
+     * @brief Take the next playout action at the local time.
+     *
+     * @param nowUs The local monotonic time.
+     * @param frame The packet to decode when PLAYOUT_PLAY is returned.
+     * @return Returns PLAYOUT_NONE when nothing is due, so the caller pulls until then.
+     * @since 6.0
+     */
+    Action Pull(uint64_t nowUs, std::unique_ptr<A2dpSinkFrame> &frame);
+
+    /**
+     * @brief Keep the pcm of the last decoded packet for concealment.
+     *
+     * @param buf The pcm of 16 bits samples.
+     * @param size The size of pcm in bytes.
+     * @since 6.0
+     */
+    void SavePcm(const uint8_t *buf, uint32_t size);
+
+    /**
+     * @brief Get the pcm that conceals one missing packet.
+     *
+     * @param pcm The last pcm faded, or silence after a few missing packets in a row.
+     * @return Returns false if no pcm is decoded yet.
+     * @since 6.0
+     */
+    bool ConcealPcm(std::vector<uint8_t> &pcm);
+
+    /**
+     * @brief Check whether the delay to report to the source changed enough to send a new report.
+     *
+     * @param nowUs The local monotonic time.
+     * @param delayValue The delay in 1/10 milliseconds.
+     * @return Returns true if the delay is to be reported now.
+     * @since 6.0
+     */
+    bool TakeDelayReport(uint64_t nowUs, uint16_t &delayValue);
+
+    /**
+     * @brief Drop the buffered packets and start over, as after a stream restart.
+     *
+     * @since 6.0
+     */
+    void Reset();
+
+    /**
+     * @brief Get the statistics of the playout.
+     *
+     * @since 6.0
+     */
+    Stats GetStats() const;
+
+    /**
+     * @brief Get the local monotonic time.
+     *
+     * @return The time in microseconds.
+     * @since 6.0
+     */
+    static uint64_t NowUs();
+
+    /**
+     * @brief Get the RTP clock rate of a codec configuration.
+     *
+     * @param config The configuration of the codec.
+     * @return The sample rate in Hz.
+     * @since 6.0
+     */
+    static uint32_t GetClockRate(const A2dpCodecCapability &config);
+
+    /**
+     * @brief Get the delay reported before the stream starts.
+     *
+     * @return The delay in 1/10 milliseconds.
+     * @since 6.0
+     */
+    static uint16_t GetInitialDelayValue();
+
+private:
+    static constexpr size_t LATENESS_HISTORY = 256;
+    static constexpr size_t STRIDE_HISTORY = 8;
+
+    int64_t ExtendTimestamp(uint32_t timestamp);
+    int64_t MediaUs(int64_t extTimestamp) const;
+    int64_t FloorTransit(int64_t mediaUs) const;
+    uint64_t PlayoutUs(int64_t extTimestamp) const;
+    void UpdateStride(int64_t step);
+    void UpdateTransit(int64_t mediaUs, uint64_t arrivalUs);
+    void CloseWindow(int64_t mediaUs);
+    void TuneTarget(bool window);
+
+    uint32_t clockRate_ = 0;
+    // RTP timestamps unwrapped, relative to the first packet
+    bool hasTimestamp_ = false;
+    uint32_t lastTimestamp_ = 0;
+    int64_t lastExtTimestamp_ = 0;
+    uint64_t lastArrivalUs_ = 0;
+    // smallest timestamp step of recent packets, the duration of one packet
+    int64_t stride_ = 0;
+    std::array<int64_t, STRIDE_HISTORY> strides_ {};
+    size_t strideIndex_ = 0;
+    // transit floor: anchorTransit_ at anchorMediaUs_, then drifting by drift_ us per us of media
+    bool hasAnchor_ = false;
+    int64_t anchorTransit_ = 0;
+    int64_t anchorMediaUs_ = 0;
+    double drift_ = 0.0;
+    // transit minimum of the current and the previous window
+    int64_t windowStartUs_ = 0;
+    int64_t windowMin_ = 0;
+    int64_t windowMinMediaUs_ = 0;
+    bool hasPrevWindow_ = false;
+    int64_t prevWindowMin_ = 0;
+    int64_t prevWindowMinMediaUs_ = 0;
+    // lateness over the transit floor of recent packets
+    std::array<int64_t, LATENESS_HISTORY> lateness_ {};
+    size_t latenessCount_ = 0;
+    size_t latenessIndex_ = 0;
+    int64_t targetDelayUs_ = 0;
+    // delay the packets actually play out with, following the target one packet at a time
+    int64_t playoutDelayUs_ = 0;
+    uint64_t adjustTimeUs_ = 0;
+    // extended timestamp <-> packet
+    std::map<int64_t, std::unique_ptr<A2dpSinkFrame>> queue_ {};
+    bool started_ = false;
+    int64_t nextTimestamp_ = 0;
+    uint32_t concealRun_ = 0;
+    std::vector<uint8_t> lastPcm_ {};
+    bool reported_ = false;
+    int64_t reportedDelayUs_ = 0;
+    uint64_t reportTimeUs_ = 0;
+    Stats stats_ {};
+
+    DISALLOW_COPY_AND_ASSIGN(A2dpSinkPlayout);
+};
+
+/**
+ * @brief Decoder observer that keeps the pcm for concealment before it goes to the service.
+ *
+ * @since 6.0
+ */
+class A2dpSinkPlayoutObserver : public A2dpDecoderObserver {
+public:
+    A2dpSinkPlayoutObserver(A2dpSinkPlayout &playout, A2dpDecoderObserver &observer)
+        : playout_(playout), observer_(observer)
+    {}
+    ~A2dpSinkPlayoutObserver() = default;
+    void DataAvailable(uint8_t *buf, uint32_t size) override;
+
+private:
+    A2dpSinkPlayout &playout_;
+    A2dpDecoderObserver &observer_;
+};
+}  // namespace bluetooth
+
+#endif  // A2DP_SINK_PLAYOUT_H
@@ -188,6 +188,9 @@ void A2dpStateIdle::ProcessSetConfigInd(A2dpAvdtMsgData msgData, uint8_t role)
     uint8_t *pCodecInfo = msgData.configRsp.codecInfo;
     SetStateName(A2DP_PROFILE_CONFIG);
     avdtp.SetConfigureRsp(msgData.configRsp.handle, msgData.configRsp.label, msgData.configRsp.category);
+    if (msgData.configRsp.category.errCode == AVDT_SUCCESS) {
+        profile->SendInitialDelay(msgData.configRsp.addr, msgData.configRsp.handle);
+    }
     profile->ConnectStateChangedNotify(msgData.configRsp.addr, STREAM_CONNECTING, (void *)&param);
     if (role == A2DP_ROLE_SOURCE) {
         uint8_t label = 0;
@@ -312,6 +315,10 @@ void A2dpStateConfigure::ProcessOpenReq(BtAddr addr, uint16_t handle, uint8_t ro
 
     A2dpAvdtp avdtp(role);
     uint8_t label = 0;
+    A2dpProfile *profile = GetProfileInstance(role);
+    if (profile != nullptr) {
+        profile->SendInitialDelay(addr, handle);
+    }
 
     SetStateName(A2DP_PROFILE_OPENING);
     avdtp.OpenReq(handle, label);
@@ -417,6 +424,9 @@ void A2dpStateConfigure::ProcessSetConfigInd(A2dpAvdtMsgData msgData, uint8_t ro
     }
 
     avdtp.SetConfigureRsp(msgData.configRsp.handle, msgData.configRsp.label, msgData.configRsp.category);
+    if (msgData.configRsp.category.errCode == AVDT_SUCCESS) {
+        profile->SendInitialDelay(msgData.configRsp.addr, msgData.configRsp.handle);
+    }
 }
 
 bool A2dpStateOpening::Dispatch(const utility::Message &msg)
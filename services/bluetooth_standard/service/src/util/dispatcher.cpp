@@ -52,6 +52,13 @@ void Dispatcher::Uninitialize()
 }
 
 void Dispatcher::PostTask(const std::function<void()> &task)
+{
+    if (start_) {
+        taskQueue_.Push(task);
+    }
+}
+
+void Dispatcher::PostTask(std::function<void()> &&task)
 {
     if (start_) {
         taskQueue_.Push(std::move(task));
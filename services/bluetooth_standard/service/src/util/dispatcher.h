@@ -64,6 +64,14 @@ public:
      */
     void PostTask(const std::function<void()> &task);
 
+    /**
+     * @brief PostTask to dispatcher, moving it into the queue.
+     *
+     * @param task
+     * @since 6
+     */
+    void PostTask(std::function<void()> &&task);
+
     /**
      * @brief Get Dispatcher name.
      *
@@ -35,6 +35,9 @@ extern "C" {
 #define BT_TRANSPORT_BR_EDR 1
 #define BT_TRANSPORT_LE 2
 
+// bearer of the unenhanced att channel, requests on enhanced bearers are answered on their own bearer
+#define ATT_UNENHANCED_BEARER 0
+
 // client callback event id
 #define ATT_ERROR_RESPONSE_ID 0x0101
 #define ATT_EXCHANGE_MTU_RESPONSE_ID 0x0103
@@ -51,6 +54,7 @@ extern "C" {
 #define ATT_HANDLE_VALUE_NOTIFICATION_ID 0x020B
 #define ATT_HANDLE_VALUE_INDICATION_ID 0x020C
 #define ATT_TRANSACTION_TIME_OUT_ID 0x020E
+#define ATT_READ_MULTIPLE_VARIABLE_RESPONSE_ID 0x0210
 
 // server callback event id
 #define ATT_EXCHANGE_MTU_REQUEST_ID 0x0102
@@ -87,6 +91,7 @@ extern "C" {
 #define ATT_INSUFFICIENT_ENCRYPTION 0x0F
 #define ATT_UNSUPPORTED_GROUP_TYPE 0x10
 #define ATT_INSUFFICIENT_RESOURECES 0x11
+#define ATT_DATABASE_OUT_OF_SYNC 0x12
 #define ATT_WRITE_REQUEST_REJECTED 0xFC
 #define ATT_CLIENT_CHARACTERISTIC_CONFIGURATION_DESCRIPTOR_IMPROPERLY_CONFIGURED 0xFD
 #define ATT_PROCEDURE_ALREADY_IN_PROGRESS 0xFE
@@ -121,6 +126,7 @@ extern "C" {
 #define HANDLE_VALUE_NOTIFICATION 0x1B
 #define HANDLE_VALUE_INDICATION 0x1D
 #define HANDLE_VALUE_CONFIRMATION 0x1E
+#define READ_MULTIPLE_VARIABLE_REQUEST 0x20
 #define READ_MULTIPLE_VARIABLE_RESPONSE 0x21
 #define MULTIPLE_HANDLE_VALUE_NOTIFICATION 0x23
 
@@ -498,9 +504,10 @@ void BTSTACK_API ATT_DisconnectReq(uint16_t connectHandle);
  * @brief Send an error response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 ATTErrorPtr Indicates the pointer to const error response parameter.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 ATTErrorPtr Indicates the pointer to const error response parameter.
  */
-void BTSTACK_API ATT_ErrorResponse(uint16_t connectHandle, const AttError *ATTErrorPtr);
+void BTSTACK_API ATT_ErrorResponse(uint16_t connectHandle, uint8_t bearer, const AttError *ATTErrorPtr);
 
 /**
  * @brief Send an exchange MTU request .
@@ -531,12 +538,13 @@ void BTSTACK_API ATT_FindInformationRequest(uint16_t connectHandle, uint16_t sta
  * @brief Send a find Information response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 format Indicates the format of the information data.
- * @param3 handleUUIDPairs Indicates the pointer to const information data.
- * @param4 pairNum Indicates the paris number of the Information Data.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 format Indicates the format of the information data.
+ * @param4 handleUUIDPairs Indicates the pointer to const information data.
+ * @param5 pairNum Indicates the paris number of the Information Data.
  */
 void BTSTACK_API ATT_FindInformationResponse(
-    uint16_t connectHandle, uint8_t format, AttHandleUuid *handleUUIDPairs, uint16_t pairNum);
+    uint16_t connectHandle, uint8_t bearer, uint8_t format, AttHandleUuid *handleUUIDPairs, uint16_t pairNum);
 
 /**
  * @brief Send a find by type value request.
@@ -552,11 +560,12 @@ void BTSTACK_API ATT_FindByTypeValueRequest(
  * @brief Send a find by type value response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 handleInfoList Indicates the pointer to const a list of 1 or more Handle Informations.
- * @param3 listNum Indicates the number of handles information list.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 handleInfoList Indicates the pointer to const a list of 1 or more Handle Informations.
+ * @param4 listNum Indicates the number of handles information list.
  */
 void BTSTACK_API ATT_FindByTypeValueResponse(
-    uint16_t connectHandle, const AttHandleInfo *handleInfoList, uint16_t listNum);
+    uint16_t connectHandle, uint8_t bearer, const AttHandleInfo *handleInfoList, uint16_t listNum);
 
 /**
  * @brief Send a read by type request.
@@ -573,12 +582,13 @@ void BTSTACK_API ATT_ReadByTypeRequest(
  * @brief Send a read by type response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 length Indicates the size of each attribute handlevalue pair.
- * @param3 valueList Indicates the pointer to const a list of attribute data.
- * @param4 attrValueNum Indicates the value of attribute value number.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 length Indicates the size of each attribute handlevalue pair.
+ * @param4 valueList Indicates the pointer to const a list of attribute data.
+ * @param5 attrValueNum Indicates the value of attribute value number.
  */
-void BTSTACK_API ATT_ReadByTypeResponse(
-    uint16_t connectHandle, uint8_t length, const AttReadByTypeRspDataList *valueList, uint16_t attrValueNum);
+void BTSTACK_API ATT_ReadByTypeResponse(uint16_t connectHandle, uint8_t bearer, uint8_t length,
+    const AttReadByTypeRspDataList *valueList, uint16_t attrValueNum);
 
 /**
  * @brief Send a read request.
@@ -592,9 +602,10 @@ void BTSTACK_API ATT_ReadRequest(uint16_t connectHandle, uint16_t attHandle);
  * @brief Send a read response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attValue Indicates the pointer to the value of the attribute with the handle given.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attValue Indicates the pointer to the value of the attribute with the handle given.
  */
-void BTSTACK_API ATT_ReadResponse(uint16_t connectHandle, const Buffer *attValue);
+void BTSTACK_API ATT_ReadResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *attValue);
 
 /**
  * @brief Send a read blob request.
@@ -609,9 +620,10 @@ void BTSTACK_API ATT_ReadBlobRequest(uint16_t connectHandle, uint16_t attHandle,
  * @brief Send a read blob response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attReadBlobResObj Indicates the pointer to part of the value of the attribute with the handle given.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attReadBlobResObj Indicates the pointer to part of the value of the attribute with the handle given.
  */
-void BTSTACK_API ATT_ReadBlobResponse(uint16_t connectHandle, const Buffer *attReadBlobResObj);
+void BTSTACK_API ATT_ReadBlobResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *attReadBlobResObj);
 
 /**
  * @brief Send a read multiple request.
@@ -625,9 +637,18 @@ void BTSTACK_API ATT_ReadMultipleRequest(uint16_t connectHandle, const Buffer *h
  * @brief Send a read multiple response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 valueList Indicates the pointer to a set of two or more values.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 valueList Indicates the pointer to a set of two or more values.
  */
-void BTSTACK_API ATT_ReadMultipleResponse(uint16_t connectHandle, const Buffer *valueList);
+void BTSTACK_API ATT_ReadMultipleResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *valueList);
+
+/**
+ * @brief Send a read multiple variable length request.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 handleList Indicates the pointer to a set of two or more attribute handles.
+ */
+void BTSTACK_API ATT_ReadMultipleVariableRequest(uint16_t connectHandle, const Buffer *handleList);
 
 /**
  * @brief Send a read by group type request.
@@ -644,12 +665,13 @@ void BTSTACK_API ATT_ReadByGroupTypeRequest(
  * @brief Send a read by group type response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 length Indicates the size of each attribute data.
- * @param3 serviceList Indicates the pointer to const a list of attribute data.
- * @param4 serviceNum Indicates the number of attribute data.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 length Indicates the size of each attribute data.
+ * @param4 serviceList Indicates the pointer to const a list of attribute data.
+ * @param5 serviceNum Indicates the number of attribute data.
  */
-void BTSTACK_API ATT_ReadByGroupTypeResponse(
-    uint16_t connectHandle, uint8_t length, const AttReadGoupAttributeData *serviceList, uint16_t serviceNum);
+void BTSTACK_API ATT_ReadByGroupTypeResponse(uint16_t connectHandle, uint8_t bearer, uint8_t length,
+    const AttReadGoupAttributeData *serviceList, uint16_t serviceNum);
 
 /**
  * @brief Send a write request.
@@ -663,9 +685,10 @@ void BTSTACK_API ATT_WriteRequest(uint16_t connectHandle, uint16_t attHandle, co
 /**
  * @brief Send a write response.
  *
- * @param connectHandle Indicates the connect handle.
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
  */
-void BTSTACK_API ATT_WriteResponse(uint16_t connectHandle);
+void BTSTACK_API ATT_WriteResponse(uint16_t connectHandle, uint8_t bearer);
 
 /**
  * @brief Send a write command.
@@ -699,11 +722,12 @@ void BTSTACK_API ATT_PrepareWriteRequest(
  * @brief Send a prepare write response.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attReadBlobObj Indicates the value of the struct AttReadBlobReqPrepareWriteValue.
- * @param3 attValue Indicates the pointer to the value of the attribute to be written.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attReadBlobObj Indicates the value of the struct AttReadBlobReqPrepareWriteValue.
+ * @param4 attValue Indicates the pointer to the value of the attribute to be written.
  */
 void BTSTACK_API ATT_PrepareWriteResponse(
-    uint16_t connectHandle, AttReadBlobReqPrepareWriteValue attReadBlobObj, const Buffer *attValue);
+    uint16_t connectHandle, uint8_t bearer, AttReadBlobReqPrepareWriteValue attReadBlobObj, const Buffer *attValue);
 
 /**
  * @brief Send a execute write request.
@@ -716,9 +740,10 @@ void BTSTACK_API ATT_ExecuteWriteRequest(uint16_t connectHandle, uint8_t flag);
 /**
  * @brief Send a execute write response.
  *
- * @param connectHandle Indicates the connect handle.
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
  */
-void BTSTACK_API ATT_ExecuteWriteResponse(uint16_t connectHandle);
+void BTSTACK_API ATT_ExecuteWriteResponse(uint16_t connectHandle, uint8_t bearer);
 
 /**
  * @brief Send a handle value notification.
@@ -729,6 +754,25 @@ void BTSTACK_API ATT_ExecuteWriteResponse(uint16_t connectHandle);
  */
 void BTSTACK_API ATT_HandleValueNotification(uint16_t connectHandle, uint16_t attHandle, const Buffer *attValue);
 
+/**
+ * @brief Send the same handle value notification on several connections.
+ *
+ * @param1 connectHandle Indicates the pointer to the connect handles.
+ * @param2 num Indicates the number of connect handles.
+ * @param3 attHandle Indicates the handle of the attribute.
+ * @param4 attValue Indicates the pointer to the current value of the attribute, shared by all the pdus.
+ */
+void BTSTACK_API ATT_HandleValueNotificationList(
+    const uint16_t *connectHandle, uint16_t num, uint16_t attHandle, const Buffer *attValue);
+
+/**
+ * @brief Send a multiple handle value notification.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 handleLengthValueList Indicates the pointer to the handle, length and value tuples.
+ */
+void BTSTACK_API ATT_MultipleHandleValueNotification(uint16_t connectHandle, const Buffer *handleLengthValueList);
+
 /**
  * @brief Send a handle value indication.
  *
@@ -752,6 +796,26 @@ void BTSTACK_API ATT_HandleValueConfirmation(uint16_t connectHandle);
  */
 int BTSTACK_API ATT_LeConnectCancel(const BtAddr *addr);
 
+/**
+ * @brief Open enhanced att bearers on an le connection.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearerNum Indicates the number of enhanced bearers to open.
+ * @return Returns BT_NO_ERROR if the operation is successful, otherwise the operation fails.
+ */
+int BTSTACK_API ATT_LeEattConnectRequest(uint16_t connectHandle, uint8_t bearerNum);
+
+/**
+ * @brief Get the bearer of the request being delivered to the server data callback.
+ *
+ * Only valid while the server data callback runs; the server keeps it with the request and passes it back to the
+ * response functions, so a request arriving on an enhanced bearer is answered on that bearer.
+ *
+ * @param connectHandle Indicates the connect handle.
+ * @return Returns the bearer of the request, ATT_UNENHANCED_BEARER outside of the server data callback.
+ */
+uint8_t BTSTACK_API ATT_GetRequestBearer(uint16_t connectHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -199,6 +199,20 @@ typedef struct {
     uint8_t errParam;  // error param
 } AvdtRejErrInfo;
 
+/**
+ * Receive statistics of a stream's media channel.
+ */
+typedef struct {
+    uint32_t packets;        // Media packets received
+    uint32_t lost;           // Packets missing from gaps in the sequence numbers
+    uint32_t outOfOrder;     // Late or duplicated packets
+    uint32_t malformed;      // Packets shorter than their RTP header, dropped
+    uint32_t jitter;         // Interarrival jitter in RTP timestamp units, 0 until the clock rate is set
+    uint32_t ssrc;           // SSRC of the last packet
+    uint32_t lastTimestamp;  // RTP timestamp of the last packet
+    uint16_t lastSeq;        // Highest sequence number received
+} AvdtMediaStats;
+
 /*
  * AVDTP SEP Configuration.
  */
@@ -799,6 +813,29 @@ BTSTACK_API uint16_t AVDT_DisconnectRsp(const BtAddr *bdAddr, uint8_t errCode);
  */
 BTSTACK_API uint16_t AVDT_GetL2capChannel(uint16_t handle);
 
+/**
+ *
+ * @brief       Function AVDT_GetMediaStats
+ * @details     Get the receive statistics of the media channel of a stream. It can be called from any thread.
+ * @param[in]   handle       Handle of stream
+ * @param[out]  stats        Receive statistics
+ * @return      AVDT_SUCCESS if successful, otherwise error.
+ *
+ */
+BTSTACK_API uint16_t AVDT_GetMediaStats(uint16_t handle, AvdtMediaStats *stats);
+
+/**
+ *
+ * @brief       Function AVDT_SetMediaClockRate
+ * @details     Set the RTP clock rate of a stream, which is the sample rate for audio codecs. The interarrival jitter
+ *              is only estimated after it is set. It can be called from any thread.
+ * @param[in]   handle       Handle of stream
+ * @param[in]   clockRate    RTP clock rate in Hz, 0 stops the jitter estimation
+ * @return      AVDT_SUCCESS if successful, otherwise error.
+ *
+ */
+BTSTACK_API uint16_t AVDT_SetMediaClockRate(uint16_t handle, uint32_t clockRate);
+
 /**
  *
  * @brief       Function AVDT_Rej(Retain)
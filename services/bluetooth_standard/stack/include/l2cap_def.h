@@ -150,6 +150,37 @@ typedef struct {
     uint16_t handle;
 } L2capConnectionInfo;
 
+// Statistics of a channel in Enhanced Retransmission mode, since the channel is configured
+typedef struct {
+    uint32_t iFramesSent;
+    uint32_t iFramesResent;
+    uint32_t srejSent;
+    uint32_t srejReceived;
+    uint32_t rejSent;
+    uint32_t rejReceived;
+
+    // I-frames received out of sequence, and received again or beyond the window
+    uint32_t rxOutOfSequence;
+    uint32_t rxDuplicated;
+
+    // Times the transmission window was full while data was waiting, and how long it was in total
+    uint32_t windowStalls;
+    uint32_t windowStallMs;
+
+    // Payload bytes acknowledged by the remote, and delivered to the upper layer
+    uint64_t txBytes;
+    uint64_t rxBytes;
+
+    // Throughput in bytes per second over durationMs
+    uint32_t durationMs;
+    uint32_t txThroughput;
+    uint32_t rxThroughput;
+
+    uint16_t txWindowSize;
+    uint16_t rxWindowSize;
+    uint8_t extendedControl;
+} L2capErfcStatistics;
+
 typedef struct {
     // Connection Request packets received
     void (*recvConnectionReq)(uint16_t lcid, uint8_t id, const L2capConnectionInfo *info, uint16_t lpsm, void *ctx);
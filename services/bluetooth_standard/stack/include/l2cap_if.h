@@ -92,6 +92,19 @@ void BTSTACK_API L2CIF_ConnectRsp(
  */
 int BTSTACK_API L2CIF_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, void (*cb)(uint16_t lcid, int result));
 
+/**
+ * @brief Send Configuration Request packet with a receive window larger than the RFC option can carry
+ *
+ * @param lcid local channel id
+ * @param cfg config parameter
+ * @param rxWindowSize receive window in Enhanced Retransmission mode, 1 to 16383. A window larger than 63 is
+ *        negotiated with the Extended Window Size option and limited to 63 if the remote does not support it.
+ *        0 uses cfg->rfc.rxWindowSize, as L2CIF_ConfigReq does.
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful, otherwise the operation fails.
+ */
+int BTSTACK_API L2CIF_ExtendedConfigReq(
+    uint16_t lcid, const L2capConfigInfo *cfg, uint16_t rxWindowSize, void (*cb)(uint16_t lcid, int result));
+
 /**
  * @brief Send Configuration Response packet
  *
@@ -136,6 +149,16 @@ void BTSTACK_API L2CIF_LocalBusy(uint16_t lcid, uint8_t isBusy, void (*cb)(uint1
  */
 int BTSTACK_API L2CIF_SendData(uint16_t lcid, const Packet *pkt, void (*cb)(uint16_t lcid, int result));
 
+/**
+ * @brief In Enhanced Retransmission mode, get the statistics of the channel
+ *
+ * @param lcid local channel id
+ * @param cb callback with the statistics of the channel, stats is only valid during the callback
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful, otherwise the operation fails.
+ */
+int BTSTACK_API L2CIF_GetErfcStatistics(
+    uint16_t lcid, void (*cb)(uint16_t lcid, const L2capErfcStatistics *stats, int result));
+
 /**
  * @brief Register Echo callback
  *
@@ -182,6 +182,19 @@ BTSTACK_API uint32_t PacketSize(const Packet *pkt);
  */
 BTSTACK_API uint32_t PacketRead(const Packet *pkt, uint8_t *dst, uint32_t offset, uint32_t size);
 
+/**
+ * @brief Get the data segments of whole Packet (head, payload and tail) in order, without copying.
+ *        Empty buffers are skipped. Used for scatter-gather transmission.
+ *
+ * @param pkt Packet pointer.
+ * @param data Segment data pointers destination.
+ * @param size Segment sizes destination.
+ * @param maxCount Capacity of data and size.
+ * @return Number of segments in Packet, only the first maxCount are filled if it is larger.
+ * @version 1.0
+ */
+BTSTACK_API uint32_t PacketGetSegments(const Packet *pkt, const uint8_t **data, uint32_t *size, uint32_t maxCount);
+
 /**
  * @brief Extract Packet head from payload.
  *        Used in data upstream.
@@ -194,6 +207,16 @@ BTSTACK_API uint32_t PacketRead(const Packet *pkt, uint8_t *dst, uint32_t offset
  */
 BTSTACK_API void PacketExtractHead(Packet *pkt, uint8_t *data, uint32_t size);
 
+/**
+ * @brief Discard Packet head from payload without copying it.
+ *        Used in data upstream.
+ *
+ * @param pkt Packet pointer.
+ * @param size Discard size.
+ * @version 1.0
+ */
+BTSTACK_API void PacketDiscardHead(Packet *pkt, uint32_t size);
+
 /**
  * @brief Extract Packet tail from payload.
  *        Used in data upstream.
@@ -254,6 +277,16 @@ BTSTACK_API uint16_t PacketCalCrc16(const Packet *pkt, CalCrc16 calCrc16);
  */
 BTSTACK_API int32_t PacketVerCrc16(const Packet *pkt, CalCrc16 calCrc16, uint16_t crcVal);
 
+/**
+ * @brief Packet calculate L2CAP FCS (crc16) over head and payload, tail excluded.
+ *        Each buffer is fed to the table-driven checksum engine in place, the packet is not flattened.
+ *
+ * @param pkt Packet pointer.
+ * @return Computing result.
+ * @version 1.0
+ */
+BTSTACK_API uint16_t PacketCrc16(const Packet *pkt);
+
 #ifdef __cplusplus
 }
 #endif
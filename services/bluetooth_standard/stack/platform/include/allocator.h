@@ -31,6 +31,41 @@ typedef struct {
 extern const Allocator MEM_MALLOC;
 extern const Allocator MEM_CALLOC;
 
+// Size classes of the slab pool behind MEM_MALLOC/MEM_CALLOC: 32, 64, ... 2048 bytes.
+#define MEM_POOL_CLASS_NUM 7
+
+typedef struct {
+    uint32_t blockSize;
+    uint64_t hits;
+    uint64_t misses;
+    uint32_t inUse;
+    uint32_t highWater;
+} AllocatorPoolClassStats;
+
+typedef struct {
+    AllocatorPoolClassStats classes[MEM_POOL_CLASS_NUM];
+    uint64_t oversize;
+    size_t slabBytes;
+    size_t ceiling;
+} AllocatorPoolStats;
+
+/**
+ * @brief Set the maximum number of bytes the slab pool may reserve from the system.
+ *        Allocations beyond the ceiling fall back to the system allocator.
+ *
+ * @param ceiling Maximum slab bytes.
+ * @since 6
+ */
+void AllocatorSetPoolCeiling(size_t ceiling);
+
+/**
+ * @brief Get hit, miss and high-water statistics of the slab pool.
+ *
+ * @param stats Output statistics.
+ * @since 6
+ */
+void AllocatorGetPoolStats(AllocatorPoolStats *stats);
+
 #ifdef __cplusplus
 }
 #endif
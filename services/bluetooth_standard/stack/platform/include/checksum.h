@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Continue a CRC-16 (polynomial x^16 + x^15 + x^2 + 1, LSB first) over data.
+ *        This is the L2CAP enhanced retransmission FCS, start with crc 0.
+ *
+ * @param crc CRC of the preceding data.
+ * @param data Data pointer.
+ * @param size Data size.
+ * @return Updated CRC.
+ * @since 6
+ */
+uint16_t ChecksumCrc16(uint16_t crc, const uint8_t *data, uint32_t size);
+
+/**
+ * @brief Continue a CRC-8 (polynomial x^8 + x^2 + x + 1, LSB first) over data.
+ *        This is the GSM 07.10 (RFCOMM) FCS, start with crc 0xFF and send 0xFF - crc.
+ *
+ * @param crc CRC of the preceding data.
+ * @param data Data pointer.
+ * @param size Data size.
+ * @return Updated CRC.
+ * @since 6
+ */
+uint8_t ChecksumCrc8(uint8_t crc, const uint8_t *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // CHECKSUM_H
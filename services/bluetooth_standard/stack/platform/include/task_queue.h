@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TASK_QUEUE_H
+#define TASK_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct TaskQueue TaskQueue;
+typedef void (*TaskFunc)(void *context);
+
+// Maximum number of tasks TaskQueueOnReadReady runs before yielding back to the reactor.
+#define TASK_QUEUE_RUN_BATCH 32
+
+/**
+ * @brief Perform instantiation of a bounded multi-producer/single-consumer TaskQueue.
+ *        Tasks are stored inline in a lock-free ring, the consumer is woken through an eventfd
+ *        only when the queue goes from empty to non-empty.
+ *
+ * @param capacity TaskQueue's capacity, rounded up to a power of two.
+ * @return Succeed return TaskQueue instantiation, failed return NULL.
+ * @since 6
+ */
+TaskQueue *TaskQueueCreate(uint32_t capacity);
+
+/**
+ * @brief Delete instantiation of the TaskQueue. Pending tasks are discarded.
+ *
+ * @param queue TaskQueue's pointer.
+ * @since 6
+ */
+void TaskQueueDelete(TaskQueue *queue);
+
+/**
+ * @brief Post a task into TaskQueue, may be called from any thread.
+ *        Blocks while the queue is full.
+ *
+ * @param queue TaskQueue's pointer.
+ * @param func Task function.
+ * @param context Task context.
+ * @since 6
+ */
+void TaskQueuePost(TaskQueue *queue, TaskFunc func, void *context);
+
+/**
+ * @brief Post a task into TaskQueue without blocking, may be called from any thread.
+ *
+ * @param queue TaskQueue's pointer.
+ * @param func Task function.
+ * @param context Task context.
+ * @return Returns false if the queue is full and the task is not posted.
+ * @since 6
+ */
+bool TaskQueueTryPost(TaskQueue *queue, TaskFunc func, void *context);
+
+/**
+ * @brief Run pending tasks on the consumer thread.
+ *
+ * @param queue TaskQueue's pointer.
+ * @param maxTasks Maximum number of tasks to run.
+ * @return Number of tasks run.
+ * @since 6
+ */
+uint32_t TaskQueueRun(TaskQueue *queue, uint32_t maxTasks);
+
+/**
+ * @brief Reactor read callback of the TaskQueue fd, runs up to TASK_QUEUE_RUN_BATCH tasks
+ *        and re-signals itself if more are pending.
+ *
+ * @param queue TaskQueue's pointer.
+ * @since 6
+ */
+void TaskQueueOnReadReady(void *queue);
+
+/**
+ * @brief Get TaskQueue wakeup fd, readable when tasks are pending.
+ *
+ * @param queue TaskQueue pointer.
+ * @return Succeed return TaskQueue fd, failed return -1.
+ * @since 6
+ */
+int32_t TaskQueueGetFd(const TaskQueue *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TASK_QUEUE_H
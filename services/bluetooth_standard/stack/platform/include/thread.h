@@ -17,6 +17,7 @@
 #define THREAD_H
 
 #include "reactor.h"
+#include "task_queue.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -29,7 +30,6 @@ extern "C" {
 #define MIN_STATIC_PRIORITY -20
 
 typedef struct Thread Thread;
-typedef void (*TaskFunc)(void *context);
 
 /**
  * @brief Perform instantiation of the Thread.
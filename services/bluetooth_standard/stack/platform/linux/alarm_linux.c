@@ -15,8 +15,10 @@
 
 #include "platform/include/alarm.h"
 #include <stdlib.h>
+#include <time.h>
 #include <unistd.h>
 #include <sys/timerfd.h>
+#include "platform/include/dl_list.h"
 #include "platform/include/thread.h"
 #include "platform/include/reactor.h"
 #include "platform/include/mutex.h"
@@ -25,6 +27,20 @@
 
 #define BT_CLOCK_MONOTONIC CLOCK_MONOTONIC
 
+// All alarms share one timerfd and are kept in a hierarchical timer wheel with a tick of 1ms.
+// Level n has WHEEL_LEVEL_SIZE slots of 8^n ticks, alarms are never cascaded between levels and
+// expire at the end of their slot, so deadlines further away are coalesced with at most 12.5% delay.
+#define WHEEL_LEVEL_NUM 6
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_LEVEL_SIZE (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_LEVEL_MASK (WHEEL_LEVEL_SIZE - 1)
+#define WHEEL_CLK_SHIFT 3
+#define WHEEL_LEVEL_SHIFT(lvl) ((lvl) * WHEEL_CLK_SHIFT)
+#define WHEEL_LEVEL_GRAN(lvl) (1ULL << WHEEL_LEVEL_SHIFT(lvl))
+#define WHEEL_LEVEL_START(lvl) ((uint64_t)(WHEEL_LEVEL_SIZE - 1) << (((lvl) - 1) * WHEEL_CLK_SHIFT))
+#define WHEEL_MAX_DELTA (WHEEL_LEVEL_START(WHEEL_LEVEL_NUM) - WHEEL_LEVEL_GRAN(WHEEL_LEVEL_NUM - 1))
+#define WHEEL_NOT_ARMED UINT64_MAX
+
 static const char *g_defaultName = "bt-alarm";
 
 static Thread *g_alarmThread = NULL;
@@ -35,114 +51,277 @@ typedef struct {
 } AlarmContext;
 
 typedef struct Alarm {
-    int timerFd;
-    Mutex *mutex;
+    DL_LIST node;
     bool isPeriodic;
+    uint64_t periodMs;
+    uint64_t deadline;
+    uint64_t bucketExpiry;
+    uint8_t level;
+    uint8_t slot;
     AlarmContext context;
-    ReactorItem *reactorItem;
     char name[ALARM_NAME_SIZE + 1];
 } AlarmInternal;
 
-int32_t AlarmModuleInit()
+typedef struct {
+    int timerFd;
+    Mutex *mutex;
+    ReactorItem *reactorItem;
+    uint64_t armedExpiry;
+    uint64_t pending[WHEEL_LEVEL_NUM];
+    uint64_t slotExpiry[WHEEL_LEVEL_NUM][WHEEL_LEVEL_SIZE];
+    DL_LIST slots[WHEEL_LEVEL_NUM][WHEEL_LEVEL_SIZE];
+    DL_LIST expired;
+} AlarmWheel;
+
+static AlarmWheel g_wheel = {
+    .timerFd = -1,
+};
+
+static uint64_t AlarmGetTick(void)
 {
-    g_alarmThread = ThreadCreate("Stack-Alarm");
-    if (g_alarmThread == NULL) {
-        LOG_ERROR("Alarm thread create failed.");
-        return -1;
-    }
-    return 0;
+    struct timespec ts = {0};
+    clock_gettime(BT_CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * MS_PER_SECOND + (uint64_t)ts.tv_nsec / NS_PER_MS;
 }
 
-void AlarmModuleCleanup()
+static void AlarmWheelArmTimer(uint64_t expiry)
 {
-    if (g_alarmThread == NULL) {
+    struct itimerspec its = {0};
+    if (expiry != WHEEL_NOT_ARMED) {
+        its.it_value.tv_sec = expiry / MS_PER_SECOND;
+        its.it_value.tv_nsec = (expiry % MS_PER_SECOND) * NS_PER_MS;
+        if ((its.it_value.tv_sec == 0) && (its.it_value.tv_nsec == 0)) {
+            its.it_value.tv_nsec = 1;
+        }
+    }
+
+    if (timerfd_settime(g_wheel.timerFd, TFD_TIMER_ABSTIME, &its, NULL) == -1) {
+        LOG_ERROR("Alarm settime failed, error no: %{public}d.", errno);
         return;
     }
+    g_wheel.armedExpiry = expiry;
+}
 
-    ThreadDelete(g_alarmThread);
-    g_alarmThread = NULL;
+static void AlarmWheelInsert(Alarm *alarm, uint64_t now)
+{
+    uint64_t deadline = alarm->deadline;
+    uint64_t delta = (deadline > now) ? (deadline - now) : 0;
+    if (delta > WHEEL_MAX_DELTA) {
+        delta = WHEEL_MAX_DELTA;
+        deadline = now + delta;
+    }
+
+    uint8_t level = 0;
+    while ((level < WHEEL_LEVEL_NUM - 1) && (delta >= WHEEL_LEVEL_START(level + 1))) {
+        level++;
+    }
+
+    uint64_t expires = (deadline + WHEEL_LEVEL_GRAN(level) - 1) >> WHEEL_LEVEL_SHIFT(level);
+    uint8_t slot = (uint8_t)(expires & WHEEL_LEVEL_MASK);
+    alarm->bucketExpiry = expires << WHEEL_LEVEL_SHIFT(level);
+    alarm->level = level;
+    alarm->slot = slot;
+
+    if ((g_wheel.pending[level] & (1ULL << slot)) == 0) {
+        g_wheel.pending[level] |= (1ULL << slot);
+        g_wheel.slotExpiry[level][slot] = alarm->bucketExpiry;
+    } else if (alarm->bucketExpiry < g_wheel.slotExpiry[level][slot]) {
+        g_wheel.slotExpiry[level][slot] = alarm->bucketExpiry;
+    }
+    DL_ListTailInsert(&g_wheel.slots[level][slot], &alarm->node);
 }
 
-static void AlarmNotify(void *parameter)
+static void AlarmWheelRemove(Alarm *alarm)
 {
-    Alarm *alarm = (Alarm *)parameter;
+    if (alarm->node.pstNext == NULL) {
+        return;
+    }
 
-    MutexLock(alarm->mutex);
+    DL_ListDelete(&alarm->node);
+    DL_LIST *slotList = &g_wheel.slots[alarm->level][alarm->slot];
+    if (DL_ListEmpty(slotList)) {
+        g_wheel.pending[alarm->level] &= ~(1ULL << alarm->slot);
+    }
+}
 
-    AlarmCallback run = alarm->context.run;
-    void *param = alarm->context.parameter;
+static uint64_t AlarmWheelNextExpiry(void)
+{
+    uint64_t next = WHEEL_NOT_ARMED;
+    for (int level = 0; level < WHEEL_LEVEL_NUM; level++) {
+        uint64_t pending = g_wheel.pending[level];
+        while (pending != 0) {
+            int slot = __builtin_ctzll(pending);
+            pending &= pending - 1;
+            if (g_wheel.slotExpiry[level][slot] < next) {
+                next = g_wheel.slotExpiry[level][slot];
+            }
+        }
+    }
+    return next;
+}
 
-    uint64_t value = 0;
-    int ret = read(alarm->timerFd, &value, sizeof(uint64_t));
-    if (ret == sizeof(uint64_t)) {
-        if (value > 1) {
-            LOG_WARN("Alarm has expired more than one times.");
+static void AlarmWheelCollectSlot(int level, int slot, uint64_t now)
+{
+    DL_LIST *slotList = &g_wheel.slots[level][slot];
+    DL_LIST *item = slotList->pstNext;
+    uint64_t slotExpiry = WHEEL_NOT_ARMED;
+
+    while (item != slotList) {
+        Alarm *alarm = DL_LIST_ENTRY(item, Alarm, node);
+        item = item->pstNext;
+        if (alarm->bucketExpiry > now) {
+            slotExpiry = (alarm->bucketExpiry < slotExpiry) ? alarm->bucketExpiry : slotExpiry;
+            continue;
         }
-    } else {
-        if (errno == EAGAIN) {
-            LOG_INFO("Alarm is stopped or reset before callback called.");
+        DL_ListDelete(&alarm->node);
+        if (alarm->deadline > now) {
+            // Deadline was beyond the wheel range when armed.
+            AlarmWheelInsert(alarm, now);
         } else {
+            DL_ListTailInsert(&g_wheel.expired, &alarm->node);
+        }
+    }
+
+    if (DL_ListEmpty(slotList)) {
+        g_wheel.pending[level] &= ~(1ULL << slot);
+    } else if (slotExpiry != WHEEL_NOT_ARMED) {
+        g_wheel.slotExpiry[level][slot] = slotExpiry;
+    }
+}
+
+static void AlarmWheelCollect(uint64_t now)
+{
+    for (int level = 0; level < WHEEL_LEVEL_NUM; level++) {
+        uint64_t pending = g_wheel.pending[level];
+        while (pending != 0) {
+            int slot = __builtin_ctzll(pending);
+            pending &= pending - 1;
+            if (g_wheel.slotExpiry[level][slot] <= now) {
+                AlarmWheelCollectSlot(level, slot, now);
+            }
+        }
+    }
+}
+
+static void AlarmNotify(void *parameter)
+{
+    uint64_t value = 0;
+    if (read(g_wheel.timerFd, &value, sizeof(uint64_t)) != sizeof(uint64_t)) {
+        if (errno != EAGAIN) {
             LOG_ERROR("Alarm read value failed, error no: %{public}d.", errno);
         }
-        run = NULL;
     }
-    MutexUnlock(alarm->mutex);
 
-    if (run) {
-        run(param);
+    MutexLock(g_wheel.mutex);
+    uint64_t now = AlarmGetTick();
+    g_wheel.armedExpiry = WHEEL_NOT_ARMED;
+    AlarmWheelCollect(now);
+
+    while (!DL_ListEmpty(&g_wheel.expired)) {
+        Alarm *alarm = DL_LIST_ENTRY(g_wheel.expired.pstNext, Alarm, node);
+        DL_ListDelete(&alarm->node);
+
+        AlarmCallback run = alarm->context.run;
+        void *param = alarm->context.parameter;
+        if (alarm->isPeriodic) {
+            alarm->deadline += alarm->periodMs;
+            if (alarm->deadline <= now) {
+                LOG_WARN("Alarm has expired more than one times.");
+                alarm->deadline = now + alarm->periodMs;
+            }
+            AlarmWheelInsert(alarm, now);
+        }
+
+        // Alarms may be set, cancelled or deleted by the callback, so the expired list is re-read afterwards.
+        MutexUnlock(g_wheel.mutex);
+        if (run) {
+            run(param);
+        }
+        MutexLock(g_wheel.mutex);
     }
+
+    AlarmWheelArmTimer(AlarmWheelNextExpiry());
+    MutexUnlock(g_wheel.mutex);
 }
 
-Alarm *AlarmCreate(const char *name, const bool isPeriodic)
+int32_t AlarmModuleInit()
 {
-    Alarm *alarm = (Alarm *)calloc(1, (sizeof(Alarm)));
-    if (alarm == NULL) {
-        LOG_ERROR("Failed to call calloc in func AlarmCreate");
-        return NULL;
+    g_alarmThread = ThreadCreate("Stack-Alarm");
+    if (g_alarmThread == NULL) {
+        LOG_ERROR("Alarm thread create failed.");
+        return -1;
     }
 
-    if (name != NULL) {
-        (void)strncpy_s(alarm->name, ALARM_NAME_SIZE + 1, name, ALARM_NAME_SIZE);
-    } else {
-        (void)strncpy_s(alarm->name, ALARM_NAME_SIZE + 1, g_defaultName, ALARM_NAME_SIZE);
+    for (int level = 0; level < WHEEL_LEVEL_NUM; level++) {
+        for (int slot = 0; slot < WHEEL_LEVEL_SIZE; slot++) {
+            DL_ListInit(&g_wheel.slots[level][slot]);
+        }
+        g_wheel.pending[level] = 0;
     }
+    DL_ListInit(&g_wheel.expired);
+    g_wheel.armedExpiry = WHEEL_NOT_ARMED;
 
-    int timerFd = timerfd_create(BT_CLOCK_MONOTONIC, TFD_NONBLOCK);
-    if (timerFd == -1) {
+    g_wheel.timerFd = timerfd_create(BT_CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (g_wheel.timerFd == -1) {
         LOG_ERROR("Alarm create timer-fd failed, error no: %{public}d.", errno);
         goto ERROR;
     }
 
-    Mutex *mutex = MutexCreate();
-    if (mutex == NULL) {
-        close(timerFd);
+    g_wheel.mutex = MutexCreate();
+    if (g_wheel.mutex == NULL) {
         LOG_ERROR("Alarm create mutex failed.");
         goto ERROR;
     }
 
-    alarm->timerFd = timerFd;
-    alarm->isPeriodic = isPeriodic;
-    alarm->mutex = mutex;
-
-    ReactorItem *item =
-        ReactorRegister(ThreadGetReactor(g_alarmThread), alarm->timerFd, (void *)alarm, AlarmNotify, NULL);
-    if (item == NULL) {
-        close(timerFd);
+    g_wheel.reactorItem = ReactorRegister(ThreadGetReactor(g_alarmThread), g_wheel.timerFd, NULL, AlarmNotify, NULL);
+    if (g_wheel.reactorItem == NULL) {
         LOG_ERROR("Alarm register reactor failed.");
         goto ERROR;
     }
+    return 0;
 
-    alarm->reactorItem = item;
+ERROR:
+    AlarmModuleCleanup();
+    return -1;
+}
 
-    return alarm;
+void AlarmModuleCleanup()
+{
+    if (g_alarmThread == NULL) {
+        return;
+    }
 
-ERROR:
+    if (g_wheel.reactorItem != NULL) {
+        ReactorUnregister(g_wheel.reactorItem);
+        g_wheel.reactorItem = NULL;
+    }
+    ThreadDelete(g_alarmThread);
+    g_alarmThread = NULL;
 
-    if (alarm != NULL) {
-        MutexDelete(alarm->mutex);
-        free(alarm);
+    if (g_wheel.timerFd != -1) {
+        close(g_wheel.timerFd);
+        g_wheel.timerFd = -1;
     }
-    return NULL;
+    MutexDelete(g_wheel.mutex);
+    g_wheel.mutex = NULL;
+}
+
+Alarm *AlarmCreate(const char *name, const bool isPeriodic)
+{
+    Alarm *alarm = (Alarm *)calloc(1, (sizeof(Alarm)));
+    if (alarm == NULL) {
+        LOG_ERROR("Failed to call calloc in func AlarmCreate");
+        return NULL;
+    }
+
+    if (name != NULL) {
+        (void)strncpy_s(alarm->name, ALARM_NAME_SIZE + 1, name, ALARM_NAME_SIZE);
+    } else {
+        (void)strncpy_s(alarm->name, ALARM_NAME_SIZE + 1, g_defaultName, ALARM_NAME_SIZE);
+    }
+    alarm->isPeriodic = isPeriodic;
+
+    return alarm;
 }
 
 void AlarmDelete(Alarm *alarm)
@@ -151,9 +330,9 @@ void AlarmDelete(Alarm *alarm)
         return;
     }
 
-    ReactorUnregister(alarm->reactorItem);
-    close(alarm->timerFd);
-    MutexDelete(alarm->mutex);
+    MutexLock(g_wheel.mutex);
+    AlarmWheelRemove(alarm);
+    MutexUnlock(g_wheel.mutex);
     free(alarm);
 }
 
@@ -161,25 +340,29 @@ int32_t AlarmSet(Alarm *alarm, uint64_t timeMs, AlarmCallback callback, void *pa
 {
     ASSERT(alarm);
 
-    MutexLock(alarm->mutex);
+    MutexLock(g_wheel.mutex);
 
+    AlarmWheelRemove(alarm);
     alarm->context.parameter = parameter;
     alarm->context.run = callback;
 
-    struct itimerspec its = {0};
-    its.it_value.tv_sec = timeMs / MS_PER_SECOND;
-    its.it_value.tv_nsec = (timeMs % MS_PER_SECOND) * NS_PER_MS;
-    if (alarm->isPeriodic) {
-        its.it_interval = its.it_value;
+    if (timeMs == 0) {
+        // Same as a zero itimerspec: the alarm is disarmed.
+        MutexUnlock(g_wheel.mutex);
+        return 0;
     }
 
-    if (timerfd_settime(alarm->timerFd, 0, &its, NULL) == -1) {
-        LOG_ERROR("Alarm settime failed, error no: %{public}d.", errno);
-        MutexUnlock(alarm->mutex);
-        return -1;
+    uint64_t now = AlarmGetTick();
+    alarm->periodMs = timeMs;
+    alarm->deadline = now + timeMs;
+    AlarmWheelInsert(alarm, now);
+
+    // Only an earlier deadline needs the shared timer to be re-armed.
+    if (alarm->bucketExpiry < g_wheel.armedExpiry) {
+        AlarmWheelArmTimer(alarm->bucketExpiry);
     }
 
-    MutexUnlock(alarm->mutex);
+    MutexUnlock(g_wheel.mutex);
     return 0;
 }
 
@@ -187,10 +370,7 @@ void AlarmCancel(Alarm *alarm)
 {
     ASSERT(alarm);
 
-    MutexLock(alarm->mutex);
-    struct itimerspec its = {0};
-    if (timerfd_settime(alarm->timerFd, 0, &its, NULL) == -1) {
-        LOG_ERROR("Alarm cancel: settime 0 failed, error no: %{public}d.", errno);
-    }
-    MutexUnlock(alarm->mutex);
-}
\ No newline at end of file
+    MutexLock(g_wheel.mutex);
+    AlarmWheelRemove(alarm);
+    MutexUnlock(g_wheel.mutex);
+}
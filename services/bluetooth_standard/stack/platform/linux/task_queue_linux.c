@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/include/task_queue.h"
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "platform/include/platform_def.h"
+
+// Bounded ring in which every slot carries a sequence number (Vyukov). Producers claim a position
+// with a CAS, the single consumer reads without atomics on its own position.
+typedef struct {
+    atomic_uint_least32_t sequence;
+    TaskFunc func;
+    void *context;
+} TaskSlot;
+
+typedef struct TaskQueue {
+    int fd;
+    uint32_t mask;
+    TaskSlot *slots;
+    atomic_uint_least32_t enqueuePos;
+    uint32_t dequeuePos;
+    // Tasks published minus tasks run, may be transiently negative.
+    atomic_int_least64_t pending;
+} TaskQueueInternal;
+
+static inline uint32_t TaskQueueRoundUp(uint32_t capacity)
+{
+    uint32_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    return size;
+}
+
+TaskQueue *TaskQueueCreate(uint32_t capacity)
+{
+    if (capacity == 0) {
+        LOG_WARN("[TaskQueueCreate]queue capacity cant be 0");
+        return NULL;
+    }
+
+    TaskQueue *queue = (TaskQueue *)calloc(1, sizeof(TaskQueue));
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    uint32_t size = TaskQueueRoundUp(capacity);
+    queue->slots = (TaskSlot *)calloc(size, sizeof(TaskSlot));
+    if (queue->slots == NULL) {
+        free(queue);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        atomic_init(&queue->slots[i].sequence, i);
+    }
+    queue->mask = size - 1;
+
+    queue->fd = eventfd(0, EFD_NONBLOCK);
+    if (queue->fd == -1) {
+        LOG_ERROR("TaskQueueCreate: create eventfd failed, error no: %{public}d.", errno);
+        free(queue->slots);
+        free(queue);
+        return NULL;
+    }
+    return queue;
+}
+
+void TaskQueueDelete(TaskQueue *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+
+    close(queue->fd);
+    free(queue->slots);
+    free(queue);
+}
+
+static void TaskQueueSignal(const TaskQueue *queue)
+{
+    uint64_t value = 1;
+    int ret;
+    CHECK_EXCEPT_INTR(ret = write(queue->fd, &value, sizeof(value)));
+    if (ret != sizeof(value)) {
+        LOG_ERROR("TaskQueueSignal: write failed, error no: %{public}d.", errno);
+    }
+}
+
+static bool TaskQueuePush(TaskQueue *queue, TaskFunc func, void *context, bool wait)
+{
+    ASSERT(queue);
+    ASSERT(func);
+
+    TaskSlot *slot = NULL;
+    uint32_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+    for (;;) {
+        slot = &queue->slots[pos & queue->mask];
+        uint32_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        int32_t diff = (int32_t)(sequence - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                &queue->enqueuePos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            if (!wait) {
+                return false;
+            }
+            // Full, wait for the consumer to free a slot.
+            sched_yield();
+            pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+        } else {
+            pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed);
+        }
+    }
+
+    slot->func = func;
+    slot->context = context;
+    atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+
+    if (atomic_fetch_add_explicit(&queue->pending, 1, memory_order_acq_rel) == 0) {
+        TaskQueueSignal(queue);
+    }
+    return true;
+}
+
+void TaskQueuePost(TaskQueue *queue, TaskFunc func, void *context)
+{
+    (void)TaskQueuePush(queue, func, context, true);
+}
+
+bool TaskQueueTryPost(TaskQueue *queue, TaskFunc func, void *context)
+{
+    return TaskQueuePush(queue, func, context, false);
+}
+
+static bool TaskQueueTryRunOne(TaskQueue *queue)
+{
+    uint32_t pos = queue->dequeuePos;
+    TaskSlot *slot = &queue->slots[pos & queue->mask];
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != pos + 1) {
+        return false;
+    }
+
+    TaskFunc func = slot->func;
+    void *context = slot->context;
+    queue->dequeuePos = pos + 1;
+    atomic_store_explicit(&slot->sequence, pos + queue->mask + 1, memory_order_release);
+
+    func(context);
+    return true;
+}
+
+uint32_t TaskQueueRun(TaskQueue *queue, uint32_t maxTasks)
+{
+    ASSERT(queue);
+    uint32_t count = 0;
+    while (count < maxTasks && TaskQueueTryRunOne(queue)) {
+        count++;
+    }
+    if (count > 0) {
+        atomic_fetch_sub_explicit(&queue->pending, count, memory_order_acq_rel);
+    }
+    return count;
+}
+
+void TaskQueueOnReadReady(void *queue)
+{
+    ASSERT(queue);
+    TaskQueue *taskQueue = (TaskQueue *)queue;
+
+    uint64_t value = 0;
+    if (read(taskQueue->fd, &value, sizeof(value)) != sizeof(value) && errno != EAGAIN) {
+        LOG_ERROR("TaskQueueOnReadReady: read failed, error no: %{public}d.", errno);
+    }
+
+    uint32_t count = 0;
+    while (count < TASK_QUEUE_RUN_BATCH && TaskQueueTryRunOne(taskQueue)) {
+        count++;
+    }
+    // Producers only signal on an empty to non-empty transition, so keep the fd readable while tasks remain.
+    if (atomic_fetch_sub_explicit(&taskQueue->pending, count, memory_order_acq_rel) > (int64_t)count) {
+        TaskQueueSignal(taskQueue);
+    }
+}
+
+int32_t TaskQueueGetFd(const TaskQueue *queue)
+{
+    ASSERT(queue);
+    return queue->fd;
+}
@@ -23,9 +23,9 @@
 #include <sys/syscall.h>
 #include "platform/include/mutex.h"
 #include "platform/include/platform_def.h"
-#include "platform/include/queue.h"
 #include "platform/include/reactor.h"
 #include "platform/include/semaphore.h"
+#include "platform/include/task_queue.h"
 #include "securec.h"
 
 #define THREAD_QUEUE_SIZE 128
@@ -36,7 +36,7 @@ typedef struct Thread {
     bool isStopped;
     pthread_t pthread;
     Reactor *reactor;
-    Queue *taskQueue;
+    TaskQueue *taskQueue;
     Mutex *apiMutex;
 } ThreadInternal;
 
@@ -46,23 +46,6 @@ typedef struct {
     char name[THREAD_NAME_SIZE + 1];
 } StartPromise;
 
-typedef struct {
-    void (*func)(void *context);
-    void *context;
-} TaskItem;
-
-static void ReadyToRead(void *queue)
-{
-    ASSERT(queue);
-    TaskItem *item = (TaskItem *)QueueDequeue((Queue *)queue);
-    if (item == NULL) {
-        LOG_ERROR("Thread: Queue Dequeue failed.");
-        return;
-    }
-    item->func(item->context);
-    free(item);
-}
-
 static void *ThreadStartFunc(void *promise)
 {
     StartPromise *startPromise = (StartPromise *)promise;
@@ -74,8 +57,9 @@ static void *ThreadStartFunc(void *promise)
 
     SemaphorePost(startPromise->sync);
 
-    int fd = QueueGetDequeueFd(thread->taskQueue);
-    ReactorItem *reactorItem = ReactorRegister(thread->reactor, fd, (void *)thread->taskQueue, ReadyToRead, NULL);
+    int fd = TaskQueueGetFd(thread->taskQueue);
+    ReactorItem *reactorItem =
+        ReactorRegister(thread->reactor, fd, (void *)thread->taskQueue, TaskQueueOnReadReady, NULL);
 
     // Start Running reactor.
     if (ReactorStart(thread->reactor) != 0) {
@@ -83,15 +67,8 @@ static void *ThreadStartFunc(void *promise)
     }
     ReactorUnregister(reactorItem);
 
-    int num = 0;
     // Execute all remain tasks in queue after stop Reactor.
-    TaskItem *task = (TaskItem *)QueueTryDequeue(thread->taskQueue);
-    while (num <= THREAD_QUEUE_SIZE && task) {
-        task->func(task->context);
-        free(task);
-        task = (TaskItem *)QueueTryDequeue(thread->taskQueue);
-        num++;
-    }
+    (void)TaskQueueRun(thread->taskQueue, THREAD_QUEUE_SIZE + 1);
 
     return NULL;
 }
@@ -132,7 +109,7 @@ Thread *ThreadCreate(const char *name)
         goto ERROR;
     }
 
-    thread->taskQueue = QueueCreate(THREAD_QUEUE_SIZE);
+    thread->taskQueue = TaskQueueCreate(THREAD_QUEUE_SIZE);
     if (thread->taskQueue == NULL) {
         goto ERROR;
     }
@@ -166,7 +143,7 @@ Thread *ThreadCreate(const char *name)
 ERROR:
     if (thread != NULL) {
         ReactorDelete(thread->reactor);
-        QueueDelete(thread->taskQueue, free);
+        TaskQueueDelete(thread->taskQueue);
         MutexDelete(thread->apiMutex);
         free(thread);
     }
@@ -181,7 +158,7 @@ void ThreadDelete(Thread *thread)
 
     ThreadStop(thread);
     MutexDelete(thread->apiMutex);
-    QueueDelete(thread->taskQueue, free);
+    TaskQueueDelete(thread->taskQueue);
     ReactorDelete(thread->reactor);
 
     free(thread);
@@ -192,13 +169,7 @@ void ThreadPostTask(Thread *thread, TaskFunc func, void *context)
     ASSERT(thread);
     ASSERT(func);
 
-    TaskItem *task = (TaskItem *)malloc(sizeof(TaskItem));
-    if (task == NULL) {
-        return;
-    }
-    task->func = func;
-    task->context = context;
-    QueueEnqueue(thread->taskQueue, task);
+    TaskQueuePost(thread->taskQueue, func, context);
 }
 
 Reactor *ThreadGetReactor(const Thread *thread)
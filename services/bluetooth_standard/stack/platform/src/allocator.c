@@ -14,14 +14,71 @@
  */
 
 #include "platform/include/allocator.h"
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #define MEM_ALIGN 16
 
-static inline void *AllocatorMalloc(size_t size);
-static inline void *AllocatorCalloc(size_t size);
-static inline void AllocatorFree(void *ptr);
+// Every slab is SLAB_SIZE bytes and aligned to SLAB_SIZE, so the owning slab of a block is found by masking.
+#define SLAB_SIZE (64 * 1024)
+#define SLAB_HEADER_SIZE 64
+#define SLAB_MAX_NUM 1024
+#define SLAB_TABLE_SIZE (SLAB_MAX_NUM * 2)
+#define SLAB_DEFAULT_CEILING (4 * 1024 * 1024)
+
+#define POOL_MIN_BLOCK_SHIFT 5
+#define POOL_CACHE_MAX 64
+#define POOL_CACHE_BATCH (POOL_CACHE_MAX / 2)
+
+typedef struct PoolBlock {
+    struct PoolBlock *next;
+} PoolBlock;
+
+typedef struct {
+    uint8_t classIndex;
+} PoolSlab;
+
+typedef struct {
+    pthread_mutex_t mutex;
+    PoolBlock *freeList;
+    uint8_t *carveSlab;
+    uint32_t carveOffset;
+    atomic_uint_least64_t hits;
+    atomic_uint_least64_t misses;
+    atomic_uint_least32_t inUse;
+    atomic_uint_least32_t highWater;
+} PoolClass;
+
+typedef struct {
+    PoolBlock *head[MEM_POOL_CLASS_NUM];
+    uint32_t count[MEM_POOL_CLASS_NUM];
+    bool registered;
+    bool tornDown;
+} PoolThreadCache;
+
+typedef struct {
+    PoolClass classes[MEM_POOL_CLASS_NUM];
+    pthread_mutex_t slabMutex;
+    atomic_uintptr_t slabTable[SLAB_TABLE_SIZE];
+    atomic_size_t slabBytes;
+    atomic_size_t ceiling;
+    atomic_uint_least64_t oversize;
+    pthread_key_t cacheKey;
+} Pool;
+
+static Pool g_pool = {
+    .slabMutex = PTHREAD_MUTEX_INITIALIZER,
+    .ceiling = SLAB_DEFAULT_CEILING,
+};
+static pthread_once_t g_poolOnce = PTHREAD_ONCE_INIT;
+static _Thread_local PoolThreadCache g_threadCache;
+
+static void *AllocatorMalloc(size_t size);
+static void *AllocatorCalloc(size_t size);
+static void AllocatorFree(void *ptr);
 
 const Allocator MEM_MALLOC = {
     .alloc = AllocatorMalloc,
@@ -49,19 +106,284 @@ void SysFree(void *ptr)
     }
 }
 
+static inline uint32_t PoolBlockSize(int classIndex)
+{
+    return (uint32_t)1 << (POOL_MIN_BLOCK_SHIFT + classIndex);
+}
+
+static inline int PoolClassIndex(size_t size)
+{
+    int classIndex = 0;
+    while (classIndex < MEM_POOL_CLASS_NUM) {
+        if (size <= PoolBlockSize(classIndex)) {
+            return classIndex;
+        }
+        classIndex++;
+    }
+    return -1;
+}
+
+static inline size_t PoolSlabHash(uintptr_t slab)
+{
+    return (size_t)((slab / SLAB_SIZE) * 2654435761u) % SLAB_TABLE_SIZE;
+}
+
+static PoolSlab *PoolFindSlab(const void *ptr)
+{
+    uintptr_t slab = (uintptr_t)ptr & ~((uintptr_t)SLAB_SIZE - 1);
+    size_t index = PoolSlabHash(slab);
+    for (size_t probe = 0; probe < SLAB_TABLE_SIZE; probe++) {
+        uintptr_t entry = atomic_load_explicit(&g_pool.slabTable[index], memory_order_acquire);
+        if (entry == slab) {
+            return (PoolSlab *)slab;
+        }
+        if (entry == 0) {
+            break;
+        }
+        index = (index + 1) % SLAB_TABLE_SIZE;
+    }
+    return NULL;
+}
+
+static void PoolThreadCacheFlush(void *arg)
+{
+    PoolThreadCache *cache = (PoolThreadCache *)arg;
+    for (int classIndex = 0; classIndex < MEM_POOL_CLASS_NUM; classIndex++) {
+        PoolBlock *block = cache->head[classIndex];
+        if (block == NULL) {
+            continue;
+        }
+        PoolBlock *last = block;
+        while (last->next != NULL) {
+            last = last->next;
+        }
+        PoolClass *poolClass = &g_pool.classes[classIndex];
+        pthread_mutex_lock(&poolClass->mutex);
+        last->next = poolClass->freeList;
+        poolClass->freeList = block;
+        pthread_mutex_unlock(&poolClass->mutex);
+        cache->head[classIndex] = NULL;
+        cache->count[classIndex] = 0;
+    }
+    cache->tornDown = true;
+}
+
+static void PoolInitialize(void)
+{
+    for (int classIndex = 0; classIndex < MEM_POOL_CLASS_NUM; classIndex++) {
+        pthread_mutex_init(&g_pool.classes[classIndex].mutex, NULL);
+    }
+    (void)pthread_key_create(&g_pool.cacheKey, PoolThreadCacheFlush);
+}
+
+// Returns NULL once the thread's cache has been flushed by the key destructor, since nothing would drain it again.
+static PoolThreadCache *PoolGetThreadCache(void)
+{
+    PoolThreadCache *cache = &g_threadCache;
+    if (cache->tornDown) {
+        return NULL;
+    }
+    if (!cache->registered) {
+        (void)pthread_once(&g_poolOnce, PoolInitialize);
+        (void)pthread_setspecific(g_pool.cacheKey, cache);
+        cache->registered = true;
+    }
+    return cache;
+}
+
+// Called with the class mutex held.
+static uint8_t *PoolNewSlab(int classIndex)
+{
+    uint8_t *slab = NULL;
+    pthread_mutex_lock(&g_pool.slabMutex);
+    size_t slabBytes = atomic_load_explicit(&g_pool.slabBytes, memory_order_relaxed);
+    if (slabBytes + SLAB_SIZE > atomic_load_explicit(&g_pool.ceiling, memory_order_relaxed) ||
+        slabBytes / SLAB_SIZE >= SLAB_MAX_NUM) {
+        pthread_mutex_unlock(&g_pool.slabMutex);
+        return NULL;
+    }
+    if (posix_memalign((void **)&slab, SLAB_SIZE, SLAB_SIZE) != 0) {
+        pthread_mutex_unlock(&g_pool.slabMutex);
+        return NULL;
+    }
+
+    ((PoolSlab *)slab)->classIndex = (uint8_t)classIndex;
+    size_t index = PoolSlabHash((uintptr_t)slab);
+    while (atomic_load_explicit(&g_pool.slabTable[index], memory_order_relaxed) != 0) {
+        index = (index + 1) % SLAB_TABLE_SIZE;
+    }
+    atomic_store_explicit(&g_pool.slabTable[index], (uintptr_t)slab, memory_order_release);
+    atomic_store_explicit(&g_pool.slabBytes, slabBytes + SLAB_SIZE, memory_order_relaxed);
+    pthread_mutex_unlock(&g_pool.slabMutex);
+    return slab;
+}
+
+static uint32_t PoolRefill(PoolThreadCache *cache, int classIndex, bool *carved)
+{
+    PoolClass *poolClass = &g_pool.classes[classIndex];
+    uint32_t blockSize = PoolBlockSize(classIndex);
+    uint32_t count = 0;
+
+    pthread_mutex_lock(&poolClass->mutex);
+    while (count < POOL_CACHE_BATCH && poolClass->freeList != NULL) {
+        PoolBlock *block = poolClass->freeList;
+        poolClass->freeList = block->next;
+        block->next = cache->head[classIndex];
+        cache->head[classIndex] = block;
+        count++;
+    }
+    *carved = (count == 0);
+    if (count == 0) {
+        if ((poolClass->carveSlab == NULL) || (poolClass->carveOffset + blockSize > SLAB_SIZE)) {
+            poolClass->carveSlab = PoolNewSlab(classIndex);
+            poolClass->carveOffset = SLAB_HEADER_SIZE;
+        }
+        while (poolClass->carveSlab != NULL && count < POOL_CACHE_BATCH &&
+               poolClass->carveOffset + blockSize <= SLAB_SIZE) {
+            PoolBlock *block = (PoolBlock *)(poolClass->carveSlab + poolClass->carveOffset);
+            poolClass->carveOffset += blockSize;
+            block->next = cache->head[classIndex];
+            cache->head[classIndex] = block;
+            count++;
+        }
+    }
+    pthread_mutex_unlock(&poolClass->mutex);
+
+    cache->count[classIndex] += count;
+    return count;
+}
+
+static void PoolUpdateInUse(PoolClass *poolClass)
+{
+    uint32_t inUse = atomic_fetch_add_explicit(&poolClass->inUse, 1, memory_order_relaxed) + 1;
+    uint32_t highWater = atomic_load_explicit(&poolClass->highWater, memory_order_relaxed);
+    while (inUse > highWater) {
+        if (atomic_compare_exchange_weak_explicit(
+            &poolClass->highWater, &highWater, inUse, memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+}
+
+static void *PoolAlloc(size_t size)
+{
+    int classIndex = PoolClassIndex(size);
+    if (classIndex < 0) {
+        atomic_fetch_add_explicit(&g_pool.oversize, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    PoolClass *poolClass = &g_pool.classes[classIndex];
+    PoolThreadCache *cache = PoolGetThreadCache();
+    if (cache == NULL) {
+        return NULL;
+    }
+    if (cache->head[classIndex] != NULL) {
+        atomic_fetch_add_explicit(&poolClass->hits, 1, memory_order_relaxed);
+    } else {
+        bool carved = false;
+        if (PoolRefill(cache, classIndex, &carved) == 0) {
+            atomic_fetch_add_explicit(&poolClass->misses, 1, memory_order_relaxed);
+            return NULL;
+        }
+        atomic_fetch_add_explicit(carved ? &poolClass->misses : &poolClass->hits, 1, memory_order_relaxed);
+    }
+
+    PoolBlock *block = cache->head[classIndex];
+    cache->head[classIndex] = block->next;
+    cache->count[classIndex]--;
+    PoolUpdateInUse(poolClass);
+    return block;
+}
+
+static bool PoolFree(void *ptr)
+{
+    PoolSlab *slab = PoolFindSlab(ptr);
+    if (slab == NULL) {
+        return false;
+    }
+
+    int classIndex = slab->classIndex;
+    PoolThreadCache *cache = PoolGetThreadCache();
+    PoolBlock *block = (PoolBlock *)ptr;
+    atomic_fetch_sub_explicit(&g_pool.classes[classIndex].inUse, 1, memory_order_relaxed);
+    if (cache == NULL) {
+        PoolClass *poolClass = &g_pool.classes[classIndex];
+        pthread_mutex_lock(&poolClass->mutex);
+        block->next = poolClass->freeList;
+        poolClass->freeList = block;
+        pthread_mutex_unlock(&poolClass->mutex);
+        return true;
+    }
+
+    block->next = cache->head[classIndex];
+    cache->head[classIndex] = block;
+    cache->count[classIndex]++;
+
+    if (cache->count[classIndex] > POOL_CACHE_MAX) {
+        PoolBlock *first = cache->head[classIndex];
+        PoolBlock *last = first;
+        for (int i = 1; i < POOL_CACHE_BATCH; i++) {
+            last = last->next;
+        }
+        cache->head[classIndex] = last->next;
+        cache->count[classIndex] -= POOL_CACHE_BATCH;
+
+        PoolClass *poolClass = &g_pool.classes[classIndex];
+        pthread_mutex_lock(&poolClass->mutex);
+        last->next = poolClass->freeList;
+        poolClass->freeList = first;
+        pthread_mutex_unlock(&poolClass->mutex);
+    }
+    return true;
+}
+
 static void *AllocatorMalloc(size_t size)
 {
-    return malloc(size);
+    void *ptr = PoolAlloc(size);
+    if (ptr == NULL) {
+        ptr = malloc(size);
+    }
+    return ptr;
 }
 
 static void *AllocatorCalloc(size_t size)
 {
-    return calloc(1, size);
+    void *ptr = PoolAlloc(size);
+    if (ptr == NULL) {
+        return calloc(1, size);
+    }
+    (void)memset(ptr, 0, size);
+    return ptr;
 }
 
 static void AllocatorFree(void *ptr)
 {
-    if (ptr != NULL) {
+    if (ptr != NULL && !PoolFree(ptr)) {
         free(ptr);
     }
-}
\ No newline at end of file
+}
+
+void AllocatorSetPoolCeiling(size_t ceiling)
+{
+    atomic_store_explicit(&g_pool.ceiling, ceiling, memory_order_relaxed);
+}
+
+void AllocatorGetPoolStats(AllocatorPoolStats *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    for (int classIndex = 0; classIndex < MEM_POOL_CLASS_NUM; classIndex++) {
+        PoolClass *poolClass = &g_pool.classes[classIndex];
+        stats->classes[classIndex].blockSize = PoolBlockSize(classIndex);
+        stats->classes[classIndex].hits = atomic_load_explicit(&poolClass->hits, memory_order_relaxed);
+        stats->classes[classIndex].misses = atomic_load_explicit(&poolClass->misses, memory_order_relaxed);
+        stats->classes[classIndex].inUse = atomic_load_explicit(&poolClass->inUse, memory_order_relaxed);
+        stats->classes[classIndex].highWater = atomic_load_explicit(&poolClass->highWater, memory_order_relaxed);
+    }
+    stats->oversize = atomic_load_explicit(&g_pool.oversize, memory_order_relaxed);
+    stats->slabBytes = atomic_load_explicit(&g_pool.slabBytes, memory_order_relaxed);
+    stats->ceiling = atomic_load_explicit(&g_pool.ceiling, memory_order_relaxed);
+}
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <memory.h>
 #include <stdatomic.h>
+#include "platform/include/allocator.h"
 #include "platform/include/platform_def.h"
 
 typedef struct Buffer {
@@ -32,7 +33,7 @@ Buffer *BufferMalloc(uint32_t size)
         return NULL;
     }
 
-    Buffer *buf = (Buffer *)calloc(1, (sizeof(Buffer) + size));
+    Buffer *buf = (Buffer *)MEM_CALLOC.alloc(sizeof(Buffer) + size);
     if (buf == NULL) {
         return NULL;
     }
@@ -50,7 +51,7 @@ Buffer *BufferRefMalloc(const Buffer *buf)
         return NULL;
     }
 
-    Buffer *ref = (Buffer *)calloc(1, sizeof(Buffer));
+    Buffer *ref = (Buffer *)MEM_CALLOC.alloc(sizeof(Buffer));
     if (ref == NULL) {
         return NULL;
     }
@@ -116,11 +117,11 @@ void BufferFree(Buffer *buf)
 
     if (buf->rootbuf != buf) {
         if (atomic_fetch_add_explicit(&buf->rootbuf->refcount, -1, memory_order_seq_cst) == 1) {
-            free(buf->rootbuf);
+            MEM_CALLOC.free(buf->rootbuf);
         }
-        free(buf);
+        MEM_CALLOC.free(buf);
     } else if (atomic_fetch_add_explicit(&buf->refcount, -1, memory_order_seq_cst) == 1) {
-        free(buf->rootbuf);
+        MEM_CALLOC.free(buf->rootbuf);
     }
 }
 
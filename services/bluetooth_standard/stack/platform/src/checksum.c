@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "platform/include/checksum.h"
+#include <pthread.h>
+
+#define CHECKSUM_SLICES 8
+#define CHECKSUM_TABLE_SIZE 256
+#define CRC16_POLY_REVERSED 0xA001
+#define CRC8_POLY_REVERSED 0xE0
+
+// Slicing-by-8: table[k][b] is the CRC of byte b followed by k zero bytes, so eight bytes fold in one step.
+static uint16_t g_crc16Table[CHECKSUM_SLICES][CHECKSUM_TABLE_SIZE];
+static uint8_t g_crc8Table[CHECKSUM_SLICES][CHECKSUM_TABLE_SIZE];
+static pthread_once_t g_tableOnce = PTHREAD_ONCE_INIT;
+
+static void ChecksumBuildTables()
+{
+    for (uint32_t i = 0; i < CHECKSUM_TABLE_SIZE; i++) {
+        uint16_t crc16 = (uint16_t)i;
+        uint8_t crc8 = (uint8_t)i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc16 = (crc16 & 1) ? ((crc16 >> 1) ^ CRC16_POLY_REVERSED) : (crc16 >> 1);
+            crc8 = (crc8 & 1) ? ((crc8 >> 1) ^ CRC8_POLY_REVERSED) : (crc8 >> 1);
+        }
+        g_crc16Table[0][i] = crc16;
+        g_crc8Table[0][i] = crc8;
+    }
+
+    for (uint32_t i = 0; i < CHECKSUM_TABLE_SIZE; i++) {
+        for (int k = 1; k < CHECKSUM_SLICES; k++) {
+            uint16_t crc16 = g_crc16Table[k - 1][i];
+            g_crc16Table[k][i] = (crc16 >> 8) ^ g_crc16Table[0][crc16 & 0xFF];
+            g_crc8Table[k][i] = g_crc8Table[0][g_crc8Table[k - 1][i]];
+        }
+    }
+}
+
+uint16_t ChecksumCrc16(uint16_t crc, const uint8_t *data, uint32_t size)
+{
+    pthread_once(&g_tableOnce, ChecksumBuildTables);
+
+    const uint8_t *p = data;
+    while (size >= CHECKSUM_SLICES) {
+        crc = g_crc16Table[7][p[0] ^ (crc & 0xFF)] ^ g_crc16Table[6][p[1] ^ (crc >> 8)] ^
+              g_crc16Table[5][p[2]] ^ g_crc16Table[4][p[3]] ^ g_crc16Table[3][p[4]] ^
+              g_crc16Table[2][p[5]] ^ g_crc16Table[1][p[6]] ^ g_crc16Table[0][p[7]];
+        p += CHECKSUM_SLICES;
+        size -= CHECKSUM_SLICES;
+    }
+    while (size--) {
+        crc = (crc >> 8) ^ g_crc16Table[0][(crc ^ *p++) & 0xFF];
+    }
+    return crc;
+}
+
+uint8_t ChecksumCrc8(uint8_t crc, const uint8_t *data, uint32_t size)
+{
+    pthread_once(&g_tableOnce, ChecksumBuildTables);
+
+    const uint8_t *p = data;
+    while (size >= CHECKSUM_SLICES) {
+        crc = g_crc8Table[7][p[0] ^ crc] ^ g_crc8Table[6][p[1]] ^ g_crc8Table[5][p[2]] ^ g_crc8Table[4][p[3]] ^
+              g_crc8Table[3][p[4]] ^ g_crc8Table[2][p[5]] ^ g_crc8Table[1][p[6]] ^ g_crc8Table[0][p[7]];
+        p += CHECKSUM_SLICES;
+        size -= CHECKSUM_SLICES;
+    }
+    while (size--) {
+        crc = g_crc8Table[0][crc ^ *p++];
+    }
+    return crc;
+}
@@ -20,6 +20,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "platform/include/allocator.h"
+#include "platform/include/checksum.h"
 #include "platform/include/platform_def.h"
 #include "securec.h"
 #include "log.h"
@@ -38,7 +40,7 @@ typedef struct Packet {
 
 static inline Payload *PayloadNew(uint32_t size)
 {
-    Payload *payload = (Payload *)calloc(1, sizeof(Payload));
+    Payload *payload = (Payload *)MEM_CALLOC.alloc(sizeof(Payload));
     if (payload == NULL) {
         return NULL;
     }
@@ -48,7 +50,7 @@ static inline Payload *PayloadNew(uint32_t size)
 
 static inline Payload *PayloadNewRef(const Buffer *buf)
 {
-    Payload *payload = (Payload *)calloc(1, sizeof(Payload));
+    Payload *payload = (Payload *)MEM_CALLOC.alloc(sizeof(Payload));
     if (payload == NULL) {
         return NULL;
     }
@@ -62,12 +64,12 @@ static inline void PayloadFree(Payload *payload)
         return;
     }
     BufferFree(payload->buf);
-    free(payload);
+    MEM_CALLOC.free(payload);
 }
 
 Packet *PacketMalloc(uint16_t headSize, uint16_t tailSize, uint32_t payloadSize)
 {
-    Packet *packet = (Packet *)calloc(1, sizeof(Packet));
+    Packet *packet = (Packet *)MEM_CALLOC.alloc(sizeof(Packet));
     if (packet == NULL) {
         return NULL;
     }
@@ -87,7 +89,7 @@ Packet *PacketMalloc(uint16_t headSize, uint16_t tailSize, uint32_t payloadSize)
 
 Packet *PacketRefMalloc(const Packet *pkt)
 {
-    Packet *refPacket = (Packet *)calloc(1, sizeof(Packet));
+    Packet *refPacket = (Packet *)MEM_CALLOC.alloc(sizeof(Packet));
     if (refPacket == NULL) {
         return NULL;
     }
@@ -172,7 +174,7 @@ void PacketFree(Packet *pkt)
         node = node->next;
         PayloadFree(tempNode);
     }
-    free(pkt);
+    MEM_CALLOC.free(pkt);
 }
 
 Buffer *PacketHead(const Packet *pkt)
@@ -393,6 +395,25 @@ uint32_t PacketRead(const Packet *pkt, uint8_t *dst, uint32_t offset, uint32_t s
     return PacketCopyToBuffer(start, end, dst, offset, size);
 }
 
+uint32_t PacketGetSegments(const Packet *pkt, const uint8_t **data, uint32_t *size, uint32_t maxCount)
+{
+    ASSERT(pkt);
+    uint32_t count = 0;
+    Payload *node = pkt->head;
+    while (node != NULL) {
+        uint32_t bufSize = BufferGetSize(node->buf);
+        if (bufSize > 0) {
+            if (count < maxCount) {
+                data[count] = BufferPtr(node->buf);
+                size[count] = bufSize;
+            }
+            count++;
+        }
+        node = node->next;
+    }
+    return count;
+}
+
 void PacketExtractHead(Packet *pkt, uint8_t *data, uint32_t size)
 {
     ASSERT(pkt);
@@ -418,6 +439,26 @@ void PacketExtractHead(Packet *pkt, uint8_t *data, uint32_t size)
     pkt->payload->prev = pkt->head;
 }
 
+void PacketDiscardHead(Packet *pkt, uint32_t size)
+{
+    ASSERT(pkt);
+    if (size > PacketPayloadSize(pkt)) {
+        return;
+    }
+
+    Payload *first = pkt->payload;
+    while (BufferGetSize(first->buf) < size) {
+        size -= BufferGetSize(first->buf);
+        Payload *tempFirst = first;
+        first = first->next;
+        PayloadFree(tempFirst);
+    }
+    first->buf = BufferResize(first->buf, size, BufferGetSize(first->buf) - size);
+    pkt->payload = first;
+    pkt->head->next = pkt->payload;
+    pkt->payload->prev = pkt->head;
+}
+
 void PacketExtractTail(const Packet *pkt, uint8_t *data, uint32_t size)
 {
     ASSERT(pkt);
@@ -467,7 +508,7 @@ uint32_t PacketFragment(Packet *uplayer, const Packet *downlayer, uint32_t fragL
                 PayloadFree(temp);
             }
         } else {
-            dFirst->next = (Payload *)calloc(1, sizeof(Payload));
+            dFirst->next = (Payload *)MEM_CALLOC.alloc(sizeof(Payload));
             if (dFirst->next != NULL) {
                 dFirst->next->prev = dFirst;
                 dFirst->next->buf = BufferSliceMalloc(first->buf, 0, fragLength);
@@ -523,7 +564,7 @@ void PacketAssemble(const Packet *uplayer, const Packet *downlayer)
         uplayer->tail->prev = refLast;
     }
 
-    free(refPacket);
+    MEM_CALLOC.free(refPacket);
 }
 
 uint16_t PacketCalCrc16(const Packet *pkt, CalCrc16 calCrc16)
@@ -570,4 +611,16 @@ int32_t PacketVerCrc16(const Packet *pkt, CalCrc16 calCrc16, uint16_t crcVal)
     }
 
     return 0;
+}
+
+uint16_t PacketCrc16(const Packet *pkt)
+{
+    ASSERT(pkt);
+    uint16_t crc = 0;
+    Payload *iter = pkt->head;
+    while (iter != pkt->tail) {
+        crc = ChecksumCrc16(crc, BufferPtr(iter->buf), BufferGetSize(iter->buf));
+        iter = iter->next;
+    }
+    return crc;
 }
\ No newline at end of file
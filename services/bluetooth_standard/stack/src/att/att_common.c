@@ -34,6 +34,20 @@
 
 static AttConnectInfo g_connectInfo[MAXCONNECT] = {0};
 static AttConnectingInfo g_connecting[MAXCONNECT] = {0};
+
+// open addressing tables kept at most half full, keyed by aclHandle, bredr cid and enhanced bearer lcid
+#define ATT_CONNECT_INDEX_SIZE (MAXCONNECT * 2)
+#define ATT_EATT_INDEX_SIZE (MAXCONNECT * ATT_EATT_MAX_BEARERS * 2)
+
+typedef struct AttIndexEntry {
+    uint16_t key;
+    uint16_t value;
+    bool used;
+} AttIndexEntry;
+
+static AttIndexEntry g_aclHandleIndex[ATT_CONNECT_INDEX_SIZE];
+static AttIndexEntry g_bredrCidIndex[ATT_CONNECT_INDEX_SIZE];
+static AttIndexEntry g_eattCidIndex[ATT_EATT_INDEX_SIZE];
 static AttClientDataCallback g_attClientCallback;
 static AttServerDataCallback g_attServerCallback;
 static AttClientSendDataCallback g_attClientSendDataCB;
@@ -74,6 +88,10 @@ typedef struct AttConnectRegisterContext {
 
 static void AttTransactionTimeOut(const void *parameter);
 
+static void AttIndexAdd(AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t value);
+static bool AttIndexFind(const AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t *value);
+static void AttIndexRemove(AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t value);
+
 static void AttClientDataRegisterAsync(const void *context);
 static void AttClientDataRegisterAsyncDestroy(const void *context);
 static void AttClientDataDeregisterAsync(const void *context);
@@ -94,6 +112,7 @@ static void AttTransactionTimeOutAsync(const void *context);
 static void AttTransactionTimeOutAsyncDestroy(const void *context);
 
 static recvDataFunction GetFunction(uint8_t opcode);
+static void AttRecvDispatch(AttConnectInfo *connect, uint8_t bearer, Packet *packet);
 
 static void AttRecvDataAsync(const void *context);
 static void AttRecvDataAsyncDestroy(const void *context);
@@ -113,13 +132,16 @@ static void AttLeSendRespCallbackAsync(const void *context);
 static void AttLeSendRespCallbackAsyncDestroy(const void *context);
 static void AttLeSendRespCallback(uint16_t aclHandle, int result);
 
+static void AttEattSendRespCallbackAsync(const void *context);
+static void AttEattSendRespCallbackAsyncDestroy(const void *context);
+static void AttEattSendRespCallback(uint16_t lcid, int result);
+
 static void AttTransactionTimeOutAsync(const void *context)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
     TransactionTimeOutContext *transTimeOutPtr = (TransactionTimeOutContext *)context;
     AttConnectInfo *connect = NULL;
-    int listSize;
     AttClientDataCallback *attClientDataCallback = NULL;
     AttServerDataCallback *attServerDataCallback = NULL;
     uint16_t index = 0;
@@ -151,10 +173,7 @@ static void AttTransactionTimeOutAsync(const void *context)
     }
 
     InitiativeDisconnect(transTimeOutPtr->connectHandle);
-    listSize = ListGetSize(connect->instruct);
-    for (; listSize > 0; --listSize) {
-        ListRemoveLast(connect->instruct);
-    }
+    AttClearBearers(connect);
 
 ATTTRANSACTIONTIMEOUT_END:
     MEM_MALLOC.free(transTimeOutPtr);
@@ -206,6 +225,158 @@ AttConnectInfo *AttGetConnectStart()
     return g_connectInfo;
 }
 
+/**
+ * @brief add a key to an index.
+ *
+ * @param1 index Indicates the pointer to AttIndexEntry.
+ * @param2 size Indicates the size of the index.
+ * @param3 key Indicates the key.
+ * @param4 value Indicates the value.
+ */
+static void AttIndexAdd(AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t value)
+{
+    uint16_t position = key % size;
+    uint16_t probe = 0;
+
+    for (; probe < size; ++probe, position = (position + 1) % size) {
+        if (!index[position].used || (index[position].key == key)) {
+            index[position].key = key;
+            index[position].value = value;
+            index[position].used = true;
+            return;
+        }
+    }
+
+    LOG_ERROR("%{public}s index is full, key = %hu", __FUNCTION__, key);
+    return;
+}
+
+/**
+ * @brief find a key in an index.
+ *
+ * @param1 index Indicates the pointer to const AttIndexEntry.
+ * @param2 size Indicates the size of the index.
+ * @param3 key Indicates the key.
+ * @param4 value Indicates the pointer to the value be outputted.
+ * @return Returns <b>true</b> if the key is found.
+ */
+static bool AttIndexFind(const AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t *value)
+{
+    uint16_t position = key % size;
+    uint16_t probe = 0;
+
+    for (; (probe < size) && index[position].used; ++probe, position = (position + 1) % size) {
+        if (index[position].key == key) {
+            *value = index[position].value;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief remove a key from an index if it still maps to the value.
+ *
+ * Entries behind the removed one are shifted back so that probing never stops at a hole.
+ *
+ * @param1 index Indicates the pointer to AttIndexEntry.
+ * @param2 size Indicates the size of the index.
+ * @param3 key Indicates the key.
+ * @param4 value Indicates the value.
+ */
+static void AttIndexRemove(AttIndexEntry *index, uint16_t size, uint16_t key, uint16_t value)
+{
+    uint16_t hole = key % size;
+    uint16_t next;
+    uint16_t home;
+    uint16_t probe = 0;
+
+    for (; probe < size; ++probe, hole = (hole + 1) % size) {
+        if (!index[hole].used) {
+            return;
+        }
+        if (index[hole].key == key) {
+            break;
+        }
+    }
+    if ((probe == size) || (index[hole].value != value)) {
+        return;
+    }
+
+    for (next = (hole + 1) % size; index[next].used; next = (next + 1) % size) {
+        home = index[next].key % size;
+        // an entry may fill the hole unless its home lies cyclically in (hole, next]
+        if ((hole <= next) ? ((home <= hole) || (home > next)) : ((home <= hole) && (home > next))) {
+            index[hole] = index[next];
+            hole = next;
+        }
+    }
+    index[hole].used = false;
+
+    return;
+}
+
+/**
+ * @brief add the aclHandle and cid of a connection to the lookup indexes.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoAddIndex(const AttConnectInfo *connect)
+{
+    uint16_t index = (uint16_t)(connect - g_connectInfo);
+
+    AttIndexAdd(g_aclHandleIndex, ATT_CONNECT_INDEX_SIZE, connect->aclHandle, index);
+    if (connect->transportType == BT_TRANSPORT_BR_EDR) {
+        AttIndexAdd(g_bredrCidIndex, ATT_CONNECT_INDEX_SIZE, connect->AttConnectID.bredrcid, index);
+    }
+
+    return;
+}
+
+/**
+ * @brief remove the aclHandle and cid of a connection from the lookup indexes.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoRemoveIndex(const AttConnectInfo *connect)
+{
+    uint16_t index = (uint16_t)(connect - g_connectInfo);
+
+    if (connect->transportType == 0) {
+        return;
+    }
+
+    AttIndexRemove(g_aclHandleIndex, ATT_CONNECT_INDEX_SIZE, connect->aclHandle, index);
+    if (connect->transportType == BT_TRANSPORT_BR_EDR) {
+        AttIndexRemove(g_bredrCidIndex, ATT_CONNECT_INDEX_SIZE, connect->AttConnectID.bredrcid, index);
+    }
+
+    return;
+}
+
+/**
+ * @brief set the lcid of an enhanced bearer and update the lookup index.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer.
+ * @param3 lcid Indicates the lcid, 0 releases the bearer slot.
+ */
+void AttSetEattBearerCid(AttConnectInfo *connect, uint8_t bearer, uint16_t lcid)
+{
+    uint16_t value = (uint16_t)((connect - g_connectInfo) * ATT_MAX_BEARERS + bearer);
+
+    if (connect->bearer[bearer].lcid != 0) {
+        AttIndexRemove(g_eattCidIndex, ATT_EATT_INDEX_SIZE, connect->bearer[bearer].lcid, value);
+    }
+    if (lcid != 0) {
+        AttIndexAdd(g_eattCidIndex, ATT_EATT_INDEX_SIZE, lcid, value);
+    }
+    connect->bearer[bearer].lcid = lcid;
+
+    return;
+}
+
 /**
  * @brief lookup AttConnectInfo info by aclHandle.
  *
@@ -216,15 +387,9 @@ void AttGetConnectInfoIndexByAclHandle(uint16_t aclHandle, AttConnectInfo **conn
 {
     LOG_INFO("%{public}s enter, aclHandle = %hu", __FUNCTION__, aclHandle);
 
-    uint16_t index = 0;
+    uint16_t index = MAXCONNECT;
 
-    for (; index < MAXCONNECT; ++index) {
-        if (g_connectInfo[index].aclHandle == aclHandle) {
-            break;
-        }
-    }
-
-    if (index != MAXCONNECT) {
+    if (AttIndexFind(g_aclHandleIndex, ATT_CONNECT_INDEX_SIZE, aclHandle, &index)) {
         *connect = &g_connectInfo[index];
     } else {
         *connect = NULL;
@@ -237,6 +402,8 @@ void AttGetConnectInfoIndexByAclHandle(uint16_t aclHandle, AttConnectInfo **conn
 /**
  * @brief lookup AttConnectInfo info by cid.
  *
+ * The cid of an le connection is its aclHandle.
+ *
  * @param1 cid Indicates the cid.
  * @param2 connect Indicates the second rank pointer to AttConnectInfo.
  */
@@ -244,25 +411,17 @@ void AttGetConnectInfoIndexByCid(uint16_t cid, AttConnectInfo **connect)
 {
     LOG_INFO("%{public}s enter, cid = %hu", __FUNCTION__, cid);
 
-    uint16_t index = 0;
+    uint16_t index = MAXCONNECT;
 
-    for (; index < MAXCONNECT; ++index) {
-        if (g_connectInfo[index].transportType == BT_TRANSPORT_BR_EDR) {
-            if (g_connectInfo[index].AttConnectID.bredrcid == cid) {
-                break;
-            }
-        }
-        if (g_connectInfo[index].transportType == BT_TRANSPORT_LE) {
-            if (g_connectInfo[index].aclHandle == cid) {
-                break;
-            }
-        }
-    }
+    *connect = NULL;
 
-    if (index != MAXCONNECT) {
+    if (AttIndexFind(g_bredrCidIndex, ATT_CONNECT_INDEX_SIZE, cid, &index)) {
+        *connect = &g_connectInfo[index];
+    } else if (AttIndexFind(g_aclHandleIndex, ATT_CONNECT_INDEX_SIZE, cid, &index) &&
+               (g_connectInfo[index].transportType == BT_TRANSPORT_LE)) {
         *connect = &g_connectInfo[index];
     } else {
-        *connect = NULL;
+        index = MAXCONNECT;
     }
 
     LOG_INFO("%{public}s return: index = %hu", __FUNCTION__, index);
@@ -282,9 +441,15 @@ void AttGetConnectInfoIndexByCidOutIndex(uint16_t cid, uint16_t *index, AttConne
 
     uint16_t indexNumber = 0;
 
-    for (; indexNumber < MAXCONNECT; ++indexNumber) {
-        if (g_connectInfo[indexNumber].AttConnectID.bredrcid == cid) {
-            break;
+    if (cid != 0) {
+        if (!AttIndexFind(g_bredrCidIndex, ATT_CONNECT_INDEX_SIZE, cid, &indexNumber)) {
+            indexNumber = MAXCONNECT;
+        }
+    } else {
+        for (; indexNumber < MAXCONNECT; ++indexNumber) {
+            if (g_connectInfo[indexNumber].AttConnectID.bredrcid == cid) {
+                break;
+            }
         }
     }
 
@@ -303,6 +468,8 @@ void AttGetConnectInfoIndexByCidOutIndex(uint16_t cid, uint16_t *index, AttConne
 /**
  * @brief lookup AttConnectInfo info by connectHandle and output parameter index.
  *
+ * The connectHandle of a connection is its index plus one, connectHandle 0 looks up a free AttConnectInfo.
+ *
  * @param1 connectHandle Indicates the connectHandle.
  * @param2 index Indicates the pointer to index.
  * @param3 connect Indicates the Secondary pointer to AttConnectInfo.
@@ -313,9 +480,16 @@ void AttGetConnectInfoIndexByConnectHandle(uint16_t connectHandle, uint16_t *ind
 
     uint16_t inindex = 0;
 
-    for (; inindex < MAXCONNECT; ++inindex) {
-        if (g_connectInfo[inindex].retGattConnectHandle == connectHandle) {
-            break;
+    if (connectHandle != 0) {
+        inindex = connectHandle - 1;
+        if ((inindex >= MAXCONNECT) || (g_connectInfo[inindex].retGattConnectHandle != connectHandle)) {
+            inindex = MAXCONNECT;
+        }
+    } else {
+        for (; inindex < MAXCONNECT; ++inindex) {
+            if (g_connectInfo[inindex].retGattConnectHandle == 0) {
+                break;
+            }
         }
     }
 
@@ -323,19 +497,105 @@ void AttGetConnectInfoIndexByConnectHandle(uint16_t connectHandle, uint16_t *ind
 
     if (inindex != MAXCONNECT) {
         *connect = &g_connectInfo[inindex];
-
-        goto ATTGETCONNECTINFOINDEXBYCONNECTHANDLE_END;
     } else {
         *connect = NULL;
-        *index = MAXCONNECT;
-        goto ATTGETCONNECTINFOINDEXBYCONNECTHANDLE_END;
     }
 
-ATTGETCONNECTINFOINDEXBYCONNECTHANDLE_END:
     LOG_INFO("%{public}s return: *index = %hu", __FUNCTION__, *index);
     return;
 }
 
+/**
+ * @brief lookup AttConnectInfo info by the lcid of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 bearer Indicates the pointer to the bearer index be outputted.
+ * @param3 connect Indicates second rank pointer to AttConnectInfo.
+ */
+void AttGetConnectInfoIndexByEattCid(uint16_t lcid, uint8_t *bearer, AttConnectInfo **connect)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu", __FUNCTION__, lcid);
+
+    uint16_t value = 0;
+
+    *connect = NULL;
+    *bearer = ATT_UNENHANCED_BEARER;
+
+    if ((lcid != 0) && AttIndexFind(g_eattCidIndex, ATT_EATT_INDEX_SIZE, lcid, &value)) {
+        *connect = &g_connectInfo[value / ATT_MAX_BEARERS];
+        *bearer = (uint8_t)(value % ATT_MAX_BEARERS);
+    }
+
+    return;
+}
+
+/**
+ * @brief get the bearer the pdu being dispatched arrived on.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns the pointer to AttBearer.
+ */
+AttBearer *AttGetRecvBearer(AttConnectInfo *connect)
+{
+    return &connect->bearer[connect->recvBearer];
+}
+
+/**
+ * @brief get an unused enhanced bearer slot of the connection.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns the pointer to AttBearer, NULL if all slots are in use.
+ */
+AttBearer *AttGetFreeEattBearer(AttConnectInfo *connect)
+{
+    uint8_t index = ATT_UNENHANCED_BEARER + 1;
+
+    for (; index < ATT_MAX_BEARERS; ++index) {
+        if (connect->bearer[index].lcid == 0) {
+            return &connect->bearer[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief drop the transactions and enhanced bearers of the connection.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttClearBearers(AttConnectInfo *connect)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    uint8_t index = 0;
+    AttBearer *bearer = NULL;
+
+    for (; index < ATT_MAX_BEARERS; ++index) {
+        bearer = &connect->bearer[index];
+        if (bearer->alarm != NULL) {
+            AlarmCancel(bearer->alarm);
+        }
+        if (bearer->response != NULL) {
+            PacketFree(bearer->response);
+            bearer->response = NULL;
+        }
+        bearer->transaction = NULL;
+        if (bearer->lcid != 0) {
+            AttSetEattBearerCid(connect, index, 0);
+        }
+        bearer->mtu = 0;
+    }
+
+    if (connect->instruct != NULL) {
+        ListClear(connect->instruct);
+    }
+    connect->recvBearer = ATT_UNENHANCED_BEARER;
+    connect->indicationBearer.num = 0;
+
+    return;
+}
+
 /**
  * @brief gatt register client data to att in self thread..
  *
@@ -556,83 +816,186 @@ AttServerDataCallback *AttGetATTServerCallback()
     return &g_attServerCallback;
 }
 
+/**
+ * @brief check whether the packet is outstanding on one of the bearers.
+ *
+ * @param1 connect Indicates the pointer to const AttConnectInfo.
+ * @param2 packet Indicates the pointer to const Packet.
+ * @return Returns <b>true</b> if the packet is outstanding; returns <b>false</b> if it is waiting for a bearer.
+ */
+static bool AttIsTransactionOutstanding(const AttConnectInfo *connect, const Packet *packet)
+{
+    uint8_t index = 0;
+
+    for (; index < ATT_MAX_BEARERS; ++index) {
+        if (connect->bearer[index].transaction == packet) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief get an idle bearer able to carry the packet.
+ *
+ * Enhanced bearers are only used when their mtu covers the att mtu the pdus of the connection are sized for.
+ * The exchange mtu request is only allowed on the unenhanced bearer, and prepare and execute write requests are
+ * kept on it too, the server holds one prepare queue per bearer.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 packet Indicates the pointer to const Packet.
+ * @return Returns the index of the bearer, ATT_MAX_BEARERS if no bearer is idle.
+ */
+static uint8_t AttGetIdleBearer(AttConnectInfo *connect, const Packet *packet)
+{
+    uint8_t index = 0;
+    uint8_t opcode = 0;
+    const AttBearer *bearer = NULL;
+
+    PacketRead(packet, &opcode, 0, sizeof(uint8_t));
+
+    for (; index < ATT_MAX_BEARERS; ++index) {
+        bearer = &connect->bearer[index];
+        if (bearer->transaction != NULL) {
+            continue;
+        }
+        if (index == ATT_UNENHANCED_BEARER) {
+            return index;
+        }
+        if ((opcode == EXCHANGE_MTU_REQUEST) || (opcode == PREPARE_WRITE_REQUEST) ||
+            (opcode == EXECUTE_WRITE_REQUEST)) {
+            break;
+        }
+        if ((bearer->lcid != 0) && (bearer->mtu >= connect->mtu) && (bearer->mtu >= PacketSize(packet))) {
+            return index;
+        }
+    }
+
+    return ATT_MAX_BEARERS;
+}
+
+/**
+ * @brief send a request on a bearer.
+ *
+ * @param1 connect Indicates the pointer to const AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer.
+ * @param3 packet Indicates the pointer to Packet.
+ * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
+ */
+static int AttBearerSendRequest(const AttConnectInfo *connect, uint8_t bearer, Packet *packet)
+{
+    int ret = BT_OPERATION_FAILED;
+
+    if (bearer != ATT_UNENHANCED_BEARER) {
+        ret = L2CIF_LeSendData(connect->bearer[bearer].lcid, packet, EattRecvSendDataCallback);
+    } else if (connect->transportType == BT_TRANSPORT_LE) {
+        ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, packet, LeRecvSendDataCallback);
+    } else if (connect->transportType == BT_TRANSPORT_BR_EDR) {
+        ret = L2CIF_SendData(connect->AttConnectID.bredrcid, packet, BREDRRecvSendDataCallback);
+    }
+
+    return ret;
+}
+
 /**
  * @brief initiative execut instructions by Scheduling.
  *
+ * Instructions are sent in order, each on the first idle bearer, until the oldest waiting instruction finds no
+ * idle bearer able to carry it.
+ *
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect)
+int AttSendSequenceScheduling(AttConnectInfo *connect)
 {
     LOG_INFO("%{public}s enter, listsize = %u", __FUNCTION__, ListGetSize(connect->instruct));
 
     int ret = BT_NO_ERROR;
-
-    if (ListGetSize(connect->instruct) == 1) {
-        ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
-        if (listNodePtr == NULL) {
-            LOG_INFO("%{public}s listNodePtr == NULL", __FUNCTION__);
-            ret = BT_OPERATION_FAILED;
-            goto ATTSENDSEQUENCESCHEDULING_END;
+    uint8_t bearer;
+    Packet *packet = NULL;
+    ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
+
+    while (listNodePtr != NULL) {
+        packet = ListGetNodeData(listNodePtr);
+        listNodePtr = ListGetNextNode(listNodePtr);
+        if (AttIsTransactionOutstanding(connect, packet)) {
+            continue;
         }
-        Packet *packet = ListGetNodeData(listNodePtr);
-        if (connect->transportType == BT_TRANSPORT_LE) {
-            ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, packet, LeRecvSendDataCallback);
-        }
-        if (connect->transportType == BT_TRANSPORT_BR_EDR) {
-            ret = L2CIF_SendData(connect->AttConnectID.bredrcid, packet, BREDRRecvSendDataCallback);
+
+        bearer = AttGetIdleBearer(connect, packet);
+        if (bearer == ATT_MAX_BEARERS) {
+            break;
         }
+
+        ret = AttBearerSendRequest(connect, bearer, packet);
         if (ret != BT_NO_ERROR) {
             LOG_INFO("%{public}s call l2cap interface return not success", __FUNCTION__);
-        } else {
-            AlarmSet(
-                connect->alarm, (uint64_t)INSTRUCTIONTIMEOUT, (void (*)(void *))AttTransactionTimeOut, (void *)connect);
+            break;
         }
+        connect->bearer[bearer].transaction = packet;
+        AlarmSet(connect->bearer[bearer].alarm,
+            (uint64_t)INSTRUCTIONTIMEOUT,
+            (void (*)(void *))AttTransactionTimeOut,
+            (void *)connect);
     }
 
-ATTSENDSEQUENCESCHEDULING_END:
     return ret;
 }
 
+/**
+ * @brief deliver the response held for the oldest outstanding instruction.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+static void AttDeliverHeldResponse(AttConnectInfo *connect)
+{
+    uint8_t index = 0;
+    Packet *response = NULL;
+    ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
+
+    if (listNodePtr == NULL) {
+        return;
+    }
+
+    for (; index < ATT_MAX_BEARERS; ++index) {
+        if ((connect->bearer[index].transaction == ListGetNodeData(listNodePtr)) &&
+            (connect->bearer[index].response != NULL)) {
+            response = connect->bearer[index].response;
+            connect->bearer[index].response = NULL;
+            AttRecvDispatch(connect, index, response);
+            PacketFree(response);
+            break;
+        }
+    }
+
+    return;
+}
+
 /**
  * @brief execut instructions by Scheduling after receiving response.
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect)
+void AttReceiveSequenceScheduling(AttConnectInfo *connect)
 {
-    LOG_INFO("%{public}s enter, listsize = %u, transportType = %hhu",
+    LOG_INFO("%{public}s enter, listsize = %u, transportType = %hhu, bearer = %hhu",
         __FUNCTION__,
         ListGetSize(connect->instruct),
-        connect->transportType);
+        connect->transportType,
+        connect->recvBearer);
 
-    int ret = BT_OPERATION_FAILED;
-
-    if (ListGetSize(connect->instruct) > 0) {
-        ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
-        if (listNodePtr == NULL) {
-            LOG_INFO("%{public}s listNodePtr == NULL", __FUNCTION__);
-            goto ATTRECEIVESEQUENCESCHEDULING_END;
-        }
-        Packet *PacketPtr = ListGetNodeData(listNodePtr);
-        if (connect->transportType == BT_TRANSPORT_LE) {
-            ret = L2CIF_LeSendFixChannelData(connect->aclHandle, (uint16_t)LE_CID, PacketPtr, LeRecvSendDataCallback);
-        }
-        if (connect->transportType == BT_TRANSPORT_BR_EDR) {
-            ret = L2CIF_SendData(connect->AttConnectID.bredrcid, PacketPtr, BREDRRecvSendDataCallback);
-        }
+    AttBearer *bearer = AttGetRecvBearer(connect);
 
-        if (ret != BT_NO_ERROR) {
-            LOG_INFO("%{public}s call l2cap interface return not success", __FUNCTION__);
-        } else {
-            AlarmSet(connect->alarm,
-                (uint64_t)INSTRUCTIONTIMEOUT,
-                (void (*)(void *))AttTransactionTimeOut,
-                (AttConnectInfo *)connect);
-        }
+    if (bearer->transaction != NULL) {
+        AlarmCancel(bearer->alarm);
+        ListRemoveNode(connect->instruct, bearer->transaction);
+        bearer->transaction = NULL;
     }
 
-ATTRECEIVESEQUENCESCHEDULING_END:
+    AttDeliverHeldResponse(connect);
+    AttSendSequenceScheduling(connect);
+
     return;
 }
 
@@ -910,6 +1273,30 @@ void AttServerCallBackCopyToCommon(attSendDataCallback attSendDataCB, const void
     return;
 }
 
+/**
+ * @brief restart or stop the transaction timer of a bearer once l2cap reported the result of sending.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer.
+ * @param3 result Indicates the result.
+ */
+static void AttBearerSendResult(AttConnectInfo *connect, uint8_t bearer, int result)
+{
+    if (result == BT_NO_ERROR) {
+        if (connect->bearer[bearer].transaction != NULL) {
+            AlarmSet(connect->bearer[bearer].alarm,
+                (uint64_t)INSTRUCTIONTIMEOUT,
+                (void (*)(void *))AttTransactionTimeOut,
+                connect);
+        }
+    } else {
+        LOG_WARN("L2CAP error code = %{public}d", result);
+        AlarmCancel(connect->bearer[bearer].alarm);
+    }
+
+    return;
+}
+
 /**
  * @brief le receive senddata callback async.
  *
@@ -922,7 +1309,7 @@ static void LeRecvSendDataCallbackAsync(const void *context)
     LeRecvSendDataCallbackAsyncContext *leRecvSendDataCallPtr = (LeRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
 
-    AttGetConnectInfoIndexByCid(leRecvSendDataCallPtr->aclHandle, &connect);
+    AttGetConnectInfoIndexByAclHandle(leRecvSendDataCallPtr->aclHandle, &connect);
 
     if (connect == NULL) {
         goto RECVSENDDATACALLBACK_END;
@@ -932,12 +1319,7 @@ static void LeRecvSendDataCallbackAsync(const void *context)
         g_attClientSendDataCB.attSendDataCB(
             connect->retGattConnectHandle, leRecvSendDataCallPtr->result, g_attClientSendDataCB.context);
     }
-    if (leRecvSendDataCallPtr->result == BT_NO_ERROR) {
-        AlarmSet(connect->alarm, (uint64_t)INSTRUCTIONTIMEOUT, (void (*)(void *))AttTransactionTimeOut, connect);
-    } else {
-        LOG_WARN("L2CAP error code = %{public}d", leRecvSendDataCallPtr->result);
-        AlarmCancel(connect->alarm);
-    }
+    AttBearerSendResult(connect, ATT_UNENHANCED_BEARER, leRecvSendDataCallPtr->result);
 
 RECVSENDDATACALLBACK_END:
     MEM_MALLOC.free(leRecvSendDataCallPtr);
@@ -1007,12 +1389,7 @@ static void BREDRRecvSendDataCallbackAsync(const void *context)
         g_attClientSendDataCB.attSendDataCB(
             connect->retGattConnectHandle, bredrRecvSendDataCallPtr->result, g_attClientSendDataCB.context);
     }
-    if (bredrRecvSendDataCallPtr->result == BT_NO_ERROR) {
-        AlarmSet(connect->alarm, (uint64_t)INSTRUCTIONTIMEOUT, (void (*)(void *))AttTransactionTimeOut, connect);
-    } else {
-        LOG_WARN("L2CAP error code = %{public}d", bredrRecvSendDataCallPtr->result);
-        AlarmCancel(connect->alarm);
-    }
+    AttBearerSendResult(connect, ATT_UNENHANCED_BEARER, bredrRecvSendDataCallPtr->result);
 
 BREDRRECVSENDDATACALLBACK_END:
     MEM_MALLOC.free(bredrRecvSendDataCallPtr);
@@ -1061,6 +1438,77 @@ void BREDRRecvSendDataCallback(uint16_t lcid, int result)
     return;
 }
 
+/**
+ * @brief enhanced bearer receive senddata callback async.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void EattRecvSendDataCallbackAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *eattRecvSendDataCallPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
+    AttConnectInfo *connect = NULL;
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+
+    AttGetConnectInfoIndexByEattCid(eattRecvSendDataCallPtr->lcid, &bearer, &connect);
+
+    if (connect == NULL) {
+        goto EATTRECVSENDDATACALLBACK_END;
+    }
+
+    if (g_attClientSendDataCB.attSendDataCB != NULL) {
+        g_attClientSendDataCB.attSendDataCB(
+            connect->retGattConnectHandle, eattRecvSendDataCallPtr->result, g_attClientSendDataCB.context);
+    }
+    AttBearerSendResult(connect, bearer, eattRecvSendDataCallPtr->result);
+
+EATTRECVSENDDATACALLBACK_END:
+    MEM_MALLOC.free(eattRecvSendDataCallPtr);
+    return;
+}
+
+/**
+ * @brief enhanced bearer receive senddata callback async destroy.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void EattRecvSendDataCallbackAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *eattRecvSendDataCallPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
+
+    MEM_MALLOC.free(eattRecvSendDataCallPtr);
+
+    return;
+}
+
+/**
+ * @brief enhanced bearer receive senddata callback.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 result Indicates the result.
+ */
+void EattRecvSendDataCallback(uint16_t lcid, int result)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *eattSendDataCallPtr =
+        MEM_MALLOC.alloc(sizeof(BREDRRecvSendDataCallbackAsyncContext));
+    if (eattSendDataCallPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    eattSendDataCallPtr->lcid = lcid;
+    eattSendDataCallPtr->result = result;
+
+    AttAsyncProcess(EattRecvSendDataCallbackAsync, EattRecvSendDataCallbackAsyncDestroy, eattSendDataCallPtr);
+
+    return;
+}
+
 /**
  * @brief receive delect callback.
  *
@@ -1108,6 +1556,7 @@ void AttShutDownClearConnectInfo(AttConnectInfo *connectInfo)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
+    AttConnectInfoRemoveIndex(connectInfo);
     connectInfo->aclHandle = 0;
     (void)memset_s(&connectInfo->AttConnectID, sizeof(connectInfo->AttConnectID), 0, sizeof(connectInfo->AttConnectID));
     connectInfo->retGattConnectHandle = 0;
@@ -1205,6 +1654,122 @@ void ServerCallbackReturnValue(int ret, const AttConnectInfo *connect)
     return;
 }
 
+/**
+ * @brief check whether the opcode is a response to a request of the client.
+ *
+ * @param opcode Indicates the opcode.
+ * @return Returns <b>true</b> if the opcode is a response.
+ */
+static bool AttIsResponseOpcode(uint8_t opcode)
+{
+    switch (opcode) {
+        case ERROR_RESPONSE:
+        case EXCHANGE_MTU_RESPONSE:
+        case FIND_INFORMATION_RESPONSE:
+        case FIND_BY_TYPE_VALUE_RESPONSE:
+        case READ_BY_TYPE_RESPONSE:
+        case READ_RESPONSE:
+        case READ_BLOB_RESPONSE:
+        case READ_MULTIPLE_RESPONSE:
+        case READ_BY_GROUP_TYPE_RESPONSE:
+        case WRITE_RESPONSE:
+        case PREPARE_WRITE_RESPONSE:
+        case EXECUTE_WRITE_RESPONSE:
+        case READ_MULTIPLE_VARIABLE_RESPONSE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief remember the bearer a pdu arrived on, oldest first.
+ *
+ * @param1 queue Indicates the pointer to AttBearerQueue.
+ * @param2 bearer Indicates the index of the bearer.
+ */
+static void AttBearerQueuePush(AttBearerQueue *queue, uint8_t bearer)
+{
+    // every bearer carries one transaction at a time, a full queue means the oldest entry was never answered
+    if (queue->num == ATT_MAX_BEARERS) {
+        (void)memmove_s(queue->bearer, sizeof(queue->bearer), queue->bearer + 1, ATT_MAX_BEARERS - 1);
+        queue->num--;
+    }
+    queue->bearer[queue->num++] = bearer;
+
+    return;
+}
+
+/**
+ * @brief take the oldest bearer out of the queue.
+ *
+ * @param queue Indicates the pointer to AttBearerQueue.
+ * @return Returns the index of the bearer, the unenhanced bearer if the queue is empty.
+ */
+static uint8_t AttBearerQueuePop(AttBearerQueue *queue)
+{
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+
+    if (queue->num > 0) {
+        bearer = queue->bearer[0];
+        queue->num--;
+        (void)memmove_s(queue->bearer, sizeof(queue->bearer), queue->bearer + 1, queue->num);
+    }
+
+    return bearer;
+}
+
+/**
+ * @brief dispatch a received pdu to its opcode function.
+ *
+ * GATT matches responses to its requests in order, so a response arriving on an enhanced bearer ahead of an older
+ * outstanding transaction is held on the bearer until the older ones completed.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer the pdu arrived on.
+ * @param3 packet Indicates the pointer to Packet.
+ */
+static void AttRecvDispatch(AttConnectInfo *connect, uint8_t bearer, Packet *packet)
+{
+    uint8_t opcode = 0;
+    uint8_t recvBearer = connect->recvBearer;
+    AttBearer *bearerPtr = &connect->bearer[bearer];
+    ListNode *listNodePtr = ListGetFirstNode(connect->instruct);
+
+    PacketRead(packet, &opcode, 0, sizeof(uint8_t));
+
+    if (AttIsResponseOpcode(opcode) && (bearerPtr->transaction != NULL) && (listNodePtr != NULL) &&
+        (ListGetNodeData(listNodePtr) != bearerPtr->transaction)) {
+        LOG_INFO("%{public}s hold opcode = %hhu on bearer = %hhu", __FUNCTION__, opcode, bearer);
+        AlarmCancel(bearerPtr->alarm);
+        if (bearerPtr->response != NULL) {
+            PacketFree(bearerPtr->response);
+        }
+        bearerPtr->response = PacketRefMalloc(packet);
+        return;
+    }
+
+    if (opcode == HANDLE_VALUE_INDICATION) {
+        AttBearerQueuePush(&connect->indicationBearer, bearer);
+    }
+
+    PacketExtractHead(packet, &opcode, sizeof(uint8_t));
+    Buffer *buffer = PacketContinuousPayload(packet);
+    recvDataFunction functionPtr = GetFunction(opcode);
+    connect->recvBearer = bearer;
+    if (functionPtr != NULL) {
+        functionPtr(connect, buffer);
+    } else {
+        LOG_WARN("%{public}s UnKnow OpCode : %hhu", __FUNCTION__, opcode);
+        if ((opcode & 0b01000000) == 0) {
+            AttErrorCode(connect, opcode);
+        }
+    }
+    connect->recvBearer = recvBearer;
+
+    return;
+}
+
 /**
  * @brief receive  bredr connect instructions data in self thread.
  *
@@ -1214,22 +1779,11 @@ static void AttRecvDataAsync(const void *context)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
-    uint8_t opcode = 0;
     AttConnectInfo *connect = NULL;
     AttRecvDataAsyncContext *attRecvDataAsyncPtr = (AttRecvDataAsyncContext *)context;
     AttGetConnectInfoIndexByCid(attRecvDataAsyncPtr->lcid, &connect);
     if (connect != NULL) {
-        PacketExtractHead(attRecvDataAsyncPtr->packet, &opcode, sizeof(uint8_t));
-        Buffer *buffer = PacketContinuousPayload(attRecvDataAsyncPtr->packet);
-        recvDataFunction functionPtr = GetFunction(opcode);
-        if (functionPtr != NULL) {
-            functionPtr(connect, buffer);
-        } else {
-            LOG_WARN("%{public}s UnKnow OpCode : %hhu", __FUNCTION__, opcode);
-            if ((opcode & 0b01000000) == 0) {
-                AttErrorCode(connect, opcode);
-            }
-        }
+        AttRecvDispatch(connect, ATT_UNENHANCED_BEARER, attRecvDataAsyncPtr->packet);
     }
 
     PacketFree(attRecvDataAsyncPtr->packet);
@@ -1290,22 +1844,11 @@ static void AttRecvLeDataAsync(const void *context)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
-    uint8_t opcode = 0;
     AttConnectInfo *connect = NULL;
     AttRecvLeDataAsyncContext *attRecvLeDataAsyncPtr = (AttRecvLeDataAsyncContext *)context;
     AttGetConnectInfoIndexByAclHandle(attRecvLeDataAsyncPtr->aclHandle, &connect);
     if (connect != NULL) {
-        PacketExtractHead(attRecvLeDataAsyncPtr->packet, &opcode, sizeof(uint8_t));
-        Buffer *buffer = PacketContinuousPayload(attRecvLeDataAsyncPtr->packet);
-        recvDataFunction functionPtr = GetFunction(opcode);
-        if (functionPtr != NULL) {
-            functionPtr(connect, buffer);
-        } else {
-            LOG_WARN("UnKnow OpCode : %hhu", opcode);
-            if ((opcode & 0b01000000) == 0) {
-                AttErrorCode(connect, opcode);
-            }
-        }
+        AttRecvDispatch(connect, ATT_UNENHANCED_BEARER, attRecvLeDataAsyncPtr->packet);
     }
 
     PacketFree(attRecvLeDataAsyncPtr->packet);
@@ -1355,6 +1898,54 @@ void AttRecvLeData(uint16_t aclHandle, const Packet *packet)
     return;
 }
 
+/**
+ * @brief receive enhanced bearer instructions data in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttRecvEattDataAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttConnectInfo *connect = NULL;
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+    AttRecvDataAsyncContext *attRecvEattDataAsyncPtr = (AttRecvDataAsyncContext *)context;
+    AttGetConnectInfoIndexByEattCid(attRecvEattDataAsyncPtr->lcid, &bearer, &connect);
+    if ((connect != NULL) && (connect->bearer[bearer].mtu != 0)) {
+        AttRecvDispatch(connect, bearer, attRecvEattDataAsyncPtr->packet);
+    }
+
+    PacketFree(attRecvEattDataAsyncPtr->packet);
+    MEM_MALLOC.free(attRecvEattDataAsyncPtr);
+
+    return;
+}
+
+/**
+ * @brief receive enhanced bearer instructions data.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 packet Indicates the pointer to Packet.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttRecvEattData(uint16_t lcid, const Packet *packet, const void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu", __FUNCTION__, lcid);
+
+    AttRecvDataAsyncContext *attRecvEattDataAsyncPtr = MEM_MALLOC.alloc(sizeof(AttRecvDataAsyncContext));
+    if (attRecvEattDataAsyncPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+    attRecvEattDataAsyncPtr->lcid = lcid;
+    attRecvEattDataAsyncPtr->packet = PacketRefMalloc((Packet *)packet);
+    attRecvEattDataAsyncPtr->ctx = (void *)ctx;
+
+    AttAsyncProcess(AttRecvEattDataAsync, AttRecvDataAsyncDestroy, attRecvEattDataAsyncPtr);
+
+    return;
+}
+
 /**
  * @brief get function.
  *
@@ -1546,7 +2137,7 @@ static void AttLeSendRespCallbackAsync(const void *context)
     LeRecvSendDataCallbackAsyncContext *attLeSendRspPtr = (LeRecvSendDataCallbackAsyncContext *)context;
     AttConnectInfo *connect = NULL;
 
-    AttGetConnectInfoIndexByCid(attLeSendRspPtr->aclHandle, &connect);
+    AttGetConnectInfoIndexByAclHandle(attLeSendRspPtr->aclHandle, &connect);
 
     if (connect == NULL) {
         LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
@@ -1596,25 +2187,107 @@ static void AttLeSendRespCallback(uint16_t aclHandle, int result)
     return;
 }
 
+static void AttEattSendRespCallbackAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *attEattSendRspPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
+    AttConnectInfo *connect = NULL;
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+
+    AttGetConnectInfoIndexByEattCid(attEattSendRspPtr->lcid, &bearer, &connect);
+
+    if (connect == NULL) {
+        LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
+        goto ATTEATTSENDRESPCALLBACK_END;
+    }
+
+    if (attEattSendRspPtr->result != BT_NO_ERROR) {
+        LOG_WARN("L2CAP Send Resp error ,error code = %{public}d", attEattSendRspPtr->result);
+    }
+
+    if (g_attServerSendDataCB.attSendDataCB != NULL) {
+        g_attServerSendDataCB.attSendDataCB(
+            connect->retGattConnectHandle, attEattSendRspPtr->result, g_attServerSendDataCB.context);
+    }
+
+ATTEATTSENDRESPCALLBACK_END:
+    MEM_MALLOC.free(attEattSendRspPtr);
+    return;
+}
+
+static void AttEattSendRespCallbackAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *attEattSendRspPtr = (BREDRRecvSendDataCallbackAsyncContext *)context;
+
+    MEM_MALLOC.free(attEattSendRspPtr);
+
+    return;
+}
+
+/**
+ * @brief callback of send response on an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 result Indicates the result.
+ */
+static void AttEattSendRespCallback(uint16_t lcid, int result)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    BREDRRecvSendDataCallbackAsyncContext *attEattSendRspPtr =
+        MEM_MALLOC.alloc(sizeof(BREDRRecvSendDataCallbackAsyncContext));
+    if (attEattSendRspPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    attEattSendRspPtr->lcid = lcid;
+    attEattSendRspPtr->result = result;
+
+    AttAsyncProcess(AttEattSendRespCallbackAsync, AttEattSendRespCallbackAsyncDestroy, attEattSendRspPtr);
+
+    return;
+}
+
 /**
  * @brief call l2cap interface to send data.
  *
  * @param1 connect Indicates the pointer to const AttConnectInfo.
- * @param2 packet Indicates the pointer to Packet.
+ * @param2 bearer Indicates the bearer the answered request arrived on, ATT_UNENHANCED_BEARER for other pdus.
+ * @param3 packet Indicates the pointer to Packet.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttResponseSendData(const AttConnectInfo *connect, const Packet *packet)
+int AttResponseSendData(AttConnectInfo *connect, uint8_t bearer, const Packet *packet)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
     int ret = BT_OPERATION_FAILED;
+    uint8_t opcode = 0;
 
-    if (connect == NULL) {
-        LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
+    if ((connect == NULL) || (bearer >= ATT_MAX_BEARERS)) {
+        LOG_INFO("%{public}s connect == NULL or bearer = %hhu is invalid", __FUNCTION__, bearer);
         ret = BT_BAD_PARAM;
         return ret;
     }
 
+    // confirmations go back on the bearer the indication arrived on, the server names the bearer of its responses
+    PacketRead(packet, &opcode, 0, sizeof(uint8_t));
+    if (opcode == HANDLE_VALUE_CONFIRMATION) {
+        bearer = AttBearerQueuePop(&connect->indicationBearer);
+    }
+
+    if (bearer != ATT_UNENHANCED_BEARER) {
+        if (connect->bearer[bearer].mtu == 0) {
+            LOG_WARN("%{public}s bearer = %hhu has been released", __FUNCTION__, bearer);
+            return ret;
+        }
+        ret = L2CIF_LeSendData(connect->bearer[bearer].lcid, (Packet *)packet, AttEattSendRespCallback);
+        return ret;
+    }
+
     if (connect->transportType == BT_TRANSPORT_BR_EDR) {
         ret = L2CIF_SendData(connect->AttConnectID.bredrcid, (Packet *)packet, AttBREDRSendRespCallback);
     }
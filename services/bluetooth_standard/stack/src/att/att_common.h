@@ -46,10 +46,15 @@ extern "C" {
 #endif
 
 #define BT_PSM_ATT 0x001F
+#define BT_PSM_EATT 0x0027
 
 #define LE_CID 0x04
 
-#define MAXCONNECT 22
+// number of att connections, set by the bt_att_max_connect build argument
+#ifndef ATT_MAX_CONNECT
+#define ATT_MAX_CONNECT 64
+#endif
+#define MAXCONNECT ATT_MAX_CONNECT
 
 #define GAPSIGNATURESIZE 12
 
@@ -90,10 +95,31 @@ extern "C" {
 #define FINDINFORRESINFOR16BITLEN 4
 #define FINDINFORRESINFOR128BITLEN 18
 
+// enhanced att bearers, bearer 0 is always the unenhanced bearer of the connection (ATT_UNENHANCED_BEARER)
+#define ATT_EATT_MAX_BEARERS 5
+#define ATT_MAX_BEARERS (ATT_EATT_MAX_BEARERS + 1)
+#define ATT_EATT_MIN_MTU 64
+#define ATT_EATT_MTU 512
+#define ATT_EATT_MPS 247
+#define ATT_EATT_CREDIT 10
+
 // execute write request
 #define IMMEDIATELY_WRITE_ALL_PENDING_PREPARED_VALUES 1
 #define CANCEL_ALL_PREPARED_WRITES 0
 
+typedef struct AttBearer {
+    uint16_t lcid;        // l2cap channel of an enhanced bearer, 0 for the unenhanced bearer or a free slot
+    uint16_t mtu;         // 0 while the channel of an enhanced bearer is being set up
+    Packet *transaction;  // request of instruct outstanding on this bearer, NULL while the bearer is idle
+    Packet *response;     // response received ahead of older transactions, delivered in request order
+    Alarm *alarm;
+} AttBearer;
+
+typedef struct AttBearerQueue {
+    uint8_t bearer[ATT_MAX_BEARERS];
+    uint8_t num;
+} AttBearerQueue;
+
 typedef struct AttConnectInfo {
     uint16_t aclHandle;
     union {
@@ -109,8 +135,10 @@ typedef struct AttConnectInfo {
     bool mtuFlag;
     uint8_t initPassConnFlag;
     List *instruct;
-    Alarm *alarm;
     bool serverSendFlag;
+    AttBearer bearer[ATT_MAX_BEARERS];
+    uint8_t recvBearer;              // bearer of the pdu being dispatched
+    AttBearerQueue indicationBearer; // bearers of received indications waiting for the confirmation
 } AttConnectInfo;
 
 typedef struct AttConnectingInfo {
@@ -149,6 +177,7 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttError *ATTErrorPtr;
 } ErrorResponseAsync;
 
@@ -164,6 +193,7 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttFindInformationRsp attFindInformationResContext;
 } FindInformationResponseAsync;
 
@@ -175,6 +205,7 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttFindByTypeValueRsp attFindByTypeResContext;
 } FindByTypeValueResponseAsync;
 
@@ -185,6 +216,7 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttReadByTypeRsp attReadByTypeRspContext;
 } ReadByTypeResponseAsync;
 
@@ -195,8 +227,10 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     Buffer *attValue;
-} ReadResponseAsync;  // readresponse / readblobresponse / readmultipleresponse / readmultiplerequest
+} ReadResponseAsync;  // readresponse / readblobresponse / readmultipleresponse / readmultiplerequest /
+                      // multiplehandlevaluenotification
 
 typedef struct {
     uint16_t connectHandle;
@@ -210,6 +244,7 @@ typedef struct {
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttReadGroupRes attReadGroupResContext;
 } ReadByGroupTypeResponseAsync;
 
@@ -219,12 +254,21 @@ typedef struct {
     Buffer *attValue;
 } WriteAsync;  // writerequest / writecommand / signedwritecommand / handlenotification / handleindication
 
+typedef struct {
+    uint16_t attHandle;
+    Buffer *attValue;
+    uint16_t num;
+    uint16_t connectHandle[];
+} NotificationListAsync;  // handlenotification to several connections sharing one value
+
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
 } WriteResponseAsync;  // writeresponse / executewriterresponse / handleconfirmation
 
 typedef struct {
     uint16_t connectHandle;
+    uint8_t bearer;
     AttReadBlobReqPrepareWriteValue attReadBlobObj;
     Buffer *attValue;
 } PrepareWriteAsync;  // preparewriterequest / preparewriteresponse
@@ -289,6 +333,61 @@ void AttGetConnectInfoIndexByCidOutIndex(uint16_t cid, uint16_t *index, AttConne
  */
 void AttGetConnectInfoIndexByConnectHandle(uint16_t connectHandle, uint16_t *index, AttConnectInfo **connect);
 
+/**
+ * @brief lookup AttConnectInfo info by the lcid of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 bearer Indicates the pointer to the bearer index be outputted.
+ * @param3 connect Indicates second rank pointer to AttConnectInfo.
+ */
+void AttGetConnectInfoIndexByEattCid(uint16_t lcid, uint8_t *bearer, AttConnectInfo **connect);
+
+/**
+ * @brief get the bearer the pdu being dispatched arrived on.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns the pointer to AttBearer.
+ */
+AttBearer *AttGetRecvBearer(AttConnectInfo *connect);
+
+/**
+ * @brief get an unused enhanced bearer slot of the connection.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ * @return Returns the pointer to AttBearer, NULL if all slots are in use.
+ */
+AttBearer *AttGetFreeEattBearer(AttConnectInfo *connect);
+
+/**
+ * @brief drop the transactions and enhanced bearers of the connection.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttClearBearers(AttConnectInfo *connect);
+
+/**
+ * @brief add the aclHandle and cid of a connection to the lookup indexes.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoAddIndex(const AttConnectInfo *connect);
+
+/**
+ * @brief remove the aclHandle and cid of a connection from the lookup indexes.
+ *
+ * @param connect Indicates the pointer to AttConnectInfo.
+ */
+void AttConnectInfoRemoveIndex(const AttConnectInfo *connect);
+
+/**
+ * @brief set the lcid of an enhanced bearer and update the lookup index.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer.
+ * @param3 lcid Indicates the lcid, 0 releases the bearer slot.
+ */
+void AttSetEattBearerCid(AttConnectInfo *connect, uint8_t bearer, uint16_t lcid);
+
 /**
  * @brief get AttConnectingInfo information.
  *
@@ -379,14 +478,14 @@ AttServerDataCallback *AttGetATTServerCallback();
  * @param connect Indicates the pointer to AttConnectInfo.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-int AttSendSequenceScheduling(const AttConnectInfo *connect);
+int AttSendSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief execut instructions by Scheduling after receiving response.
  *
  * @param connect Indicates the pointer to AttConnectInfo.
  */
-void AttReceiveSequenceScheduling(const AttConnectInfo *connect);
+void AttReceiveSequenceScheduling(AttConnectInfo *connect);
 
 /**
  * @brief client call back copy.
@@ -420,6 +519,14 @@ void LeRecvSendDataCallback(uint16_t aclHandle, int result);
  */
 void BREDRRecvSendDataCallback(uint16_t lcid, int result);
 
+/**
+ * @brief enhanced bearer receive senddata callback.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 result Indicates the result.
+ */
+void EattRecvSendDataCallback(uint16_t lcid, int result);
+
 /**
  * @brief receive delect callback.
  *
@@ -490,9 +597,18 @@ void AttRecvData(uint16_t lcid, const Packet *packet, const void *ctx);
  */
 void AttRecvLeData(uint16_t aclHandle, const Packet *packet);
 
+/**
+ * @brief received enhanced bearer instructions data information.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 packet Indicates the pointer to Packet.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttRecvEattData(uint16_t lcid, const Packet *packet, const void *ctx);
+
 AttConnectedCallback *AttGetATTConnectCallback();
 
-int AttResponseSendData(const AttConnectInfo *connect, const Packet *packet);
+int AttResponseSendData(AttConnectInfo *connect, uint8_t bearer, const Packet *packet);
 
 /**
  * @brief received error opcode.
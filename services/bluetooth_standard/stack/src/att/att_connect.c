@@ -264,7 +264,7 @@ static void DisconnectRespCallbackAsync(const void *context)
         goto DISCONNECTRESPCALLBACK_END;
     }
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(connect->bearer[ATT_UNENHANCED_BEARER].alarm);
 
     attConnectCallback = AttGetATTConnectCallback();
     if ((attConnectCallback == NULL) || (attConnectCallback->attConnect.attBREDRDisconnectCompleted == NULL)) {
@@ -390,6 +390,7 @@ static void AttClearConnectInfo(AttConnectInfo *connect)
 {
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
+    AttConnectInfoRemoveIndex(connect);
     connect->aclHandle = 0;
     connect->AttConnectID.bredrcid = 0;
     connect->AttConnectID.lecid = 0;
@@ -403,9 +404,7 @@ static void AttClearConnectInfo(AttConnectInfo *connect)
     connect->serverSendFlag = false;
     (void)memset_s(&connect->addr, sizeof(connect->addr), 0, sizeof(BtAddr));
 
-    if (connect->alarm != NULL) {
-        AlarmCancel(connect->alarm);
-    }
+    AttClearBearers(connect);
 
     return;
 }
@@ -787,7 +786,7 @@ static void AttCopyToConnectInfo(const AttConnectingInfo *connecting, AttConnect
 
     uint16_t index = 0;
 
-    AttGetConnectInfoIndexByCidOutIndex(0, &index, connect);
+    AttGetConnectInfoIndexByConnectHandle(0, &index, connect);
 
     if (*connect == NULL) {
         LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
@@ -802,6 +801,7 @@ static void AttCopyToConnectInfo(const AttConnectingInfo *connecting, AttConnect
     (*connect)->addr.type = connecting->addr.type;
     (void)memcpy_s((*connect)->addr.addr, ADDRESSLEN, connecting->addr.addr, ADDRESSLEN);
     (*connect)->mtu = connecting->mtu;
+    AttConnectInfoAddIndex(*connect);
 
 ATTCOPYTOCONNECTINFO_END:
     return;
@@ -835,6 +835,7 @@ static void AttConnectInfoAddLe(
     (*connect)->mtu = DEFAULTLEATTMTU;
     (*connect)->initPassConnFlag = initPassConnFlag;
     (void)memcpy_s((*connect)->addr.addr, ADDRESSLEN, addr->addr, ADDRESSLEN);
+    AttConnectInfoAddIndex(*connect);
 
 ATTCONNECTINFOADDLE_END:
     return;
@@ -1529,7 +1530,7 @@ void LeDisconnectReqCallBackAsync(const void *context)
     AttLeDisconnectCallback leData;
     AttConnectedCallback *attConnectCallback = NULL;
 
-    AttGetConnectInfoIndexByCid(disLeConnectReqPtr->aclHandle, &connect);
+    AttGetConnectInfoIndexByAclHandle(disLeConnectReqPtr->aclHandle, &connect);
 
     if (connect == NULL) {
         goto LEDISCONNECTREQCALLBACK_END;
@@ -2321,7 +2322,7 @@ static void AttDisconnectAbnormalAsync(const void *context)
         goto ATTDISCONNECTABNORMAL_END;
     }
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(connect->bearer[ATT_UNENHANCED_BEARER].alarm);
 
     attConnectCallback = AttGetATTConnectCallback();
     if ((attConnectCallback == NULL) || (attConnectCallback->attConnect.attBREDRDisconnectCompleted == NULL)) {
@@ -2408,7 +2409,7 @@ static void AttRecvDisconnectionRspAsync(const void *context)
 
     attConnectCallback = AttGetATTConnectCallback();
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(connect->bearer[ATT_UNENHANCED_BEARER].alarm);
 
     if ((attConnectCallback == NULL) || (attConnectCallback->attConnect.attBREDRDisconnectCompleted == NULL)) {
         LOG_WARN("%{public}s attConnectCallback or attBREDRDisconnectCompleted is NULL", __FUNCTION__);
@@ -0,0 +1,709 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_eatt.c
+ *
+ * @brief implement enhanced att bearer function to be called.
+ *
+ * Enhanced bearers are LE credit based channels on BT_PSM_EATT opened next to the unenhanced bearer of an LE
+ * connection. Instructions of the connection are scheduled on whichever bearer is idle, see
+ * AttSendSequenceScheduling.
+ *
+ */
+
+#include "att_eatt.h"
+
+#include "alarm.h"
+#include "log.h"
+
+#include "platform/include/allocator.h"
+
+typedef struct AttEattConnectReqAsync {
+    uint16_t connectHandle;
+    uint8_t bearerNum;
+} AttEattConnectReqAsync;
+
+typedef struct AttEattConnectReqCallbackContext {
+    BtAddr addr;
+    uint16_t lcid;
+    int result;
+} AttEattConnectReqCallbackContext;
+
+typedef struct AttEattConnectionReqContext {
+    uint16_t lcid;
+    uint8_t id;
+    uint16_t aclHandle;
+    L2capLeConfigInfo cfg;
+} AttEattConnectionReqContext;
+
+typedef struct AttEattConnectionRspContext {
+    uint16_t lcid;
+    L2capLeConfigInfo cfg;
+    uint16_t result;
+} AttEattConnectionRspContext;
+
+typedef struct AttEattDisconnectContext {
+    uint16_t lcid;
+    uint8_t id;
+} AttEattDisconnectContext;
+
+static void AttEattRegisterServiceCallback(uint16_t lpsm, int result);
+static void AttEattAssignLocalConfig(L2capLeConfigInfo *cfg);
+static void AttEattGetConnectInfoByAddr(const BtAddr *addr, AttConnectInfo **connect);
+static void AttEattRemoveQueuedBearer(AttBearerQueue *queue, uint8_t bearer);
+static void AttEattReleaseBearer(AttConnectInfo *connect, uint8_t bearer);
+
+static void AttEattConnectRequestAsync(const void *context);
+static void AttEattConnectRequestAsyncDestroy(const void *context);
+static void AttEattConnectReqCallback(const BtAddr *addr, uint16_t lcid, int result);
+static void AttEattConnectReqCallbackAsync(const void *context);
+static void AttEattConnectReqCallbackAsyncDestroy(const void *context);
+
+static void AttEattReceiveConnectionReqAsync(const void *context);
+static void AttEattReceiveConnectionReqAsyncDestroy(const void *context);
+static void AttEattReceiveConnectionRspAsync(const void *context);
+static void AttEattReceiveConnectionRspAsyncDestroy(const void *context);
+static void AttEattReceiveDisconnectionReqAsync(const void *context);
+static void AttEattReleaseBearerAsync(const void *context);
+static void AttEattDisconnectAsyncDestroy(const void *context);
+
+/**
+ * @brief register the enhanced att psm to l2cap.
+ *
+ */
+void AttEattRegisterService()
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    L2capLeService eattl2capLeServiceObj;
+    eattl2capLeServiceObj.recvLeCreditBasedConnectionReq = AttEattReceiveConnectionReq;
+    eattl2capLeServiceObj.recvLeCreditBasedConnectionRsp = AttEattReceiveConnectionRsp;
+    eattl2capLeServiceObj.recvLeDisconnectionReq = AttEattReceiveDisconnectionReq;
+    eattl2capLeServiceObj.recvLeDisconnectionRsp = AttEattReceiveDisconnectionRsp;
+    eattl2capLeServiceObj.leDisconnectAbnormal = AttEattDisconnectAbnormal;
+    eattl2capLeServiceObj.recvLeData = (void (*)(uint16_t, Packet *, void *))AttRecvEattData;
+    eattl2capLeServiceObj.leRemoteBusy = AttEattRemoteBusy;
+
+    L2CIF_LeRegisterService(BT_PSM_EATT, &eattl2capLeServiceObj, NULL, AttEattRegisterServiceCallback);
+
+    return;
+}
+
+/**
+ * @brief callback of att register the enhanced att psm.
+ *
+ * @param1 lpsm Indicates the lpsm.
+ * @param2 result Indicates the result of callback.
+ */
+static void AttEattRegisterServiceCallback(uint16_t lpsm, int result)
+{
+    LOG_INFO("%{public}s enter, lpsm = %hu, result = %{public}d", __FUNCTION__, lpsm, result);
+
+    return;
+}
+
+/**
+ * @brief assign the l2cap configuration of the local side of an enhanced bearer.
+ *
+ * @param cfg Indicates the pointer to L2capLeConfigInfo.
+ */
+static void AttEattAssignLocalConfig(L2capLeConfigInfo *cfg)
+{
+    cfg->mtu = ATT_EATT_MTU;
+    cfg->mps = ATT_EATT_MPS;
+    cfg->credit = ATT_EATT_CREDIT;
+
+    return;
+}
+
+/**
+ * @brief lookup the AttConnectInfo of an le connection by address.
+ *
+ * @param1 addr Indicates the pointer to const BtAddr.
+ * @param2 connect Indicates the second rank pointer to AttConnectInfo.
+ */
+static void AttEattGetConnectInfoByAddr(const BtAddr *addr, AttConnectInfo **connect)
+{
+    uint16_t index = 0;
+    AttConnectInfo *connectInfo = AttGetConnectStart();
+
+    *connect = NULL;
+
+    for (; index < MAXCONNECT; ++index) {
+        if ((connectInfo[index].transportType == BT_TRANSPORT_LE) &&
+            (memcmp(connectInfo[index].addr.addr, addr->addr, ADDRESSLEN) == 0)) {
+            *connect = &connectInfo[index];
+            break;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief remove a bearer from a queue of bearers waiting for an answer.
+ *
+ * @param1 queue Indicates the pointer to AttBearerQueue.
+ * @param2 bearer Indicates the index of the bearer.
+ */
+static void AttEattRemoveQueuedBearer(AttBearerQueue *queue, uint8_t bearer)
+{
+    uint8_t index = 0;
+    uint8_t num = 0;
+
+    for (; index < queue->num; ++index) {
+        if (queue->bearer[index] != bearer) {
+            queue->bearer[num++] = queue->bearer[index];
+        }
+    }
+    queue->num = num;
+
+    return;
+}
+
+/**
+ * @brief release an enhanced bearer whose channel is gone.
+ *
+ * The instruction outstanding on the bearer stays on instruct and is sent again on another bearer.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 bearer Indicates the index of the bearer.
+ */
+static void AttEattReleaseBearer(AttConnectInfo *connect, uint8_t bearer)
+{
+    LOG_INFO("%{public}s enter, bearer = %hhu, lcid = %hu", __FUNCTION__, bearer, connect->bearer[bearer].lcid);
+
+    AttBearer *bearerPtr = &connect->bearer[bearer];
+
+    AlarmCancel(bearerPtr->alarm);
+    if (bearerPtr->response != NULL) {
+        PacketFree(bearerPtr->response);
+        bearerPtr->response = NULL;
+    }
+    bearerPtr->transaction = NULL;
+    AttSetEattBearerCid(connect, bearer, 0);
+    bearerPtr->mtu = 0;
+
+    AttEattRemoveQueuedBearer(&connect->indicationBearer, bearer);
+
+    AttSendSequenceScheduling(connect);
+
+    return;
+}
+
+/**
+ * @brief open enhanced bearers in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattConnectRequestAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectReqAsync *attEattConnectReqPtr = (AttEattConnectReqAsync *)context;
+    AttConnectInfo *connect = NULL;
+    L2capLeConfigInfo cfg;
+    uint16_t index = 0;
+    uint8_t bearer = ATT_UNENHANCED_BEARER + 1;
+    uint8_t bearerNum = 0;
+
+    AttGetConnectInfoIndexByConnectHandle(attEattConnectReqPtr->connectHandle, &index, &connect);
+
+    if ((connect == NULL) || (connect->transportType != BT_TRANSPORT_LE)) {
+        LOG_INFO("%{public}s connect is not an le connection", __FUNCTION__);
+        goto ATTEATTCONNECTREQUEST_END;
+    }
+
+    for (; bearer < ATT_MAX_BEARERS; ++bearer) {
+        if (connect->bearer[bearer].lcid == 0) {
+            bearerNum++;
+        }
+    }
+    bearerNum = (uint8_t)Min(bearerNum, attEattConnectReqPtr->bearerNum);
+
+    AttEattAssignLocalConfig(&cfg);
+    for (; bearerNum > 0; --bearerNum) {
+        if (L2CIF_LeCreditBasedConnectionReq(&connect->addr, BT_PSM_EATT, BT_PSM_EATT, &cfg,
+            AttEattConnectReqCallback) != BT_NO_ERROR) {
+            LOG_WARN("%{public}s call l2cap interface return not success", __FUNCTION__);
+            break;
+        }
+    }
+
+ATTEATTCONNECTREQUEST_END:
+    MEM_MALLOC.free(attEattConnectReqPtr);
+    return;
+}
+
+/**
+ * @brief destroy open enhanced bearers in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattConnectRequestAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectReqAsync *attEattConnectReqPtr = (AttEattConnectReqAsync *)context;
+
+    MEM_MALLOC.free(attEattConnectReqPtr);
+
+    return;
+}
+
+/**
+ * @brief Open enhanced att bearers on an le connection.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearerNum Indicates the number of enhanced bearers to open.
+ * @return Returns BT_NO_ERROR if the operation is successful, otherwise the operation fails.
+ */
+int ATT_LeEattConnectRequest(uint16_t connectHandle, uint8_t bearerNum)
+{
+    LOG_INFO("%{public}s enter, connectHandle = %hu, bearerNum = %hhu", __FUNCTION__, connectHandle, bearerNum);
+
+    if ((bearerNum == 0) || (bearerNum > ATT_EATT_MAX_BEARERS)) {
+        return BT_BAD_PARAM;
+    }
+
+    AttEattConnectReqAsync *attEattConnectReqPtr = MEM_MALLOC.alloc(sizeof(AttEattConnectReqAsync));
+    if (attEattConnectReqPtr == NULL) {
+        return BT_NO_MEMORY;
+    }
+
+    attEattConnectReqPtr->connectHandle = connectHandle;
+    attEattConnectReqPtr->bearerNum = bearerNum;
+    AttAsyncProcess(AttEattConnectRequestAsync, AttEattConnectRequestAsyncDestroy, attEattConnectReqPtr);
+
+    return BT_NO_ERROR;
+}
+
+/**
+ * @brief Get the bearer of the request being delivered to the server data callback.
+ *
+ * @param connectHandle Indicates the connect handle.
+ * @return Returns the bearer of the request, ATT_UNENHANCED_BEARER outside of the server data callback.
+ */
+uint8_t ATT_GetRequestBearer(uint16_t connectHandle)
+{
+    uint16_t index = 0;
+    AttConnectInfo *connect = NULL;
+
+    AttGetConnectInfoIndexByConnectHandle(connectHandle, &index, &connect);
+    if (connect == NULL) {
+        return ATT_UNENHANCED_BEARER;
+    }
+
+    return connect->recvBearer;
+}
+
+/**
+ * @brief callback of sending a le credit based connect request in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattConnectReqCallbackAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectReqCallbackContext *attEattConnectReqCallbackPtr = (AttEattConnectReqCallbackContext *)context;
+    AttConnectInfo *connect = NULL;
+    AttBearer *bearer = NULL;
+
+    if (attEattConnectReqCallbackPtr->result != BT_NO_ERROR) {
+        LOG_WARN("%{public}s L2CAP error code = %{public}d", __FUNCTION__, attEattConnectReqCallbackPtr->result);
+        goto ATTEATTCONNECTREQCALLBACK_END;
+    }
+
+    AttEattGetConnectInfoByAddr(&attEattConnectReqCallbackPtr->addr, &connect);
+    if (connect != NULL) {
+        bearer = AttGetFreeEattBearer(connect);
+    }
+
+    if (bearer == NULL) {
+        LOG_WARN("%{public}s no bearer for lcid = %hu", __FUNCTION__, attEattConnectReqCallbackPtr->lcid);
+        L2CIF_LeDisconnectionReq(attEattConnectReqCallbackPtr->lcid, NULL);
+        goto ATTEATTCONNECTREQCALLBACK_END;
+    }
+
+    // the bearer is reserved here and becomes usable once the connect response sets its mtu
+    AttSetEattBearerCid(connect, (uint8_t)(bearer - connect->bearer), attEattConnectReqCallbackPtr->lcid);
+    bearer->mtu = 0;
+
+ATTEATTCONNECTREQCALLBACK_END:
+    MEM_MALLOC.free(attEattConnectReqCallbackPtr);
+    return;
+}
+
+/**
+ * @brief destroy callback of sending a le credit based connect request in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattConnectReqCallbackAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectReqCallbackContext *attEattConnectReqCallbackPtr = (AttEattConnectReqCallbackContext *)context;
+
+    MEM_MALLOC.free(attEattConnectReqCallbackPtr);
+
+    return;
+}
+
+/**
+ * @brief callback of sending a le credit based connect request.
+ *
+ * @param1 addr Indicates the pointer to const BtAddr.
+ * @param2 lcid Indicates the lcid.
+ * @param3 result Indicates the result.
+ */
+static void AttEattConnectReqCallback(const BtAddr *addr, uint16_t lcid, int result)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, result = %{public}d", __FUNCTION__, lcid, result);
+
+    AttEattConnectReqCallbackContext *attEattConnectReqCallbackPtr =
+        MEM_MALLOC.alloc(sizeof(AttEattConnectReqCallbackContext));
+    if (attEattConnectReqCallbackPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    (void)memcpy_s(&attEattConnectReqCallbackPtr->addr, sizeof(BtAddr), addr, sizeof(BtAddr));
+    attEattConnectReqCallbackPtr->lcid = lcid;
+    attEattConnectReqCallbackPtr->result = result;
+
+    AttAsyncProcess(
+        AttEattConnectReqCallbackAsync, AttEattConnectReqCallbackAsyncDestroy, attEattConnectReqCallbackPtr);
+
+    return;
+}
+
+/**
+ * @brief received le credit based connect request of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReceiveConnectionReqAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectionReqContext *attEattConnectionReqPtr = (AttEattConnectionReqContext *)context;
+    AttConnectInfo *connect = NULL;
+    AttBearer *bearer = NULL;
+    L2capLeConfigInfo cfg;
+    uint16_t result = L2CAP_LE_CONNECTION_SUCCESSFUL;
+
+    AttGetConnectInfoIndexByAclHandle(attEattConnectionReqPtr->aclHandle, &connect);
+
+    if ((connect == NULL) || (connect->transportType != BT_TRANSPORT_LE)) {
+        result = L2CAP_LE_NO_RESOURCES_AVAILABLE;
+    } else if (attEattConnectionReqPtr->cfg.mtu < ATT_EATT_MIN_MTU) {
+        result = L2CAP_LE_UNACCEPTABLE_PARAMETERS;
+    } else {
+        bearer = AttGetFreeEattBearer(connect);
+        if (bearer == NULL) {
+            result = L2CAP_LE_NO_RESOURCES_AVAILABLE;
+        }
+    }
+
+    AttEattAssignLocalConfig(&cfg);
+    L2CIF_LeCreditBasedConnectionRsp(attEattConnectionReqPtr->lcid, attEattConnectionReqPtr->id, &cfg, result, NULL);
+
+    if (result == L2CAP_LE_CONNECTION_SUCCESSFUL) {
+        AttSetEattBearerCid(connect, (uint8_t)(bearer - connect->bearer), attEattConnectionReqPtr->lcid);
+        bearer->mtu = Min(ATT_EATT_MTU, attEattConnectionReqPtr->cfg.mtu);
+        AttSendSequenceScheduling(connect);
+    } else {
+        LOG_INFO("%{public}s reject lcid = %hu, result = %hu", __FUNCTION__, attEattConnectionReqPtr->lcid, result);
+    }
+
+    MEM_MALLOC.free(attEattConnectionReqPtr);
+    return;
+}
+
+/**
+ * @brief destroy received le credit based connect request of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReceiveConnectionReqAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectionReqContext *attEattConnectionReqPtr = (AttEattConnectionReqContext *)context;
+
+    MEM_MALLOC.free(attEattConnectionReqPtr);
+
+    return;
+}
+
+/**
+ * @brief received le credit based connect request of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 id Indicates the id.
+ * @param3 info Indicates the pointer to L2capConnectionInfo.
+ * @param4 cfg Indicates the pointer to L2capLeConfigInfo.
+ * @param5 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveConnectionReq(
+    uint16_t lcid, uint8_t id, const L2capConnectionInfo *info, const L2capLeConfigInfo *cfg, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, id = %hhu, mtu = %hu", __FUNCTION__, lcid, id, cfg->mtu);
+
+    AttEattConnectionReqContext *attEattConnectionReqPtr = MEM_MALLOC.alloc(sizeof(AttEattConnectionReqContext));
+    if (attEattConnectionReqPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    attEattConnectionReqPtr->lcid = lcid;
+    attEattConnectionReqPtr->id = id;
+    attEattConnectionReqPtr->aclHandle = info->handle;
+    (void)memcpy_s(&attEattConnectionReqPtr->cfg, sizeof(L2capLeConfigInfo), cfg, sizeof(L2capLeConfigInfo));
+
+    AttAsyncProcess(
+        AttEattReceiveConnectionReqAsync, AttEattReceiveConnectionReqAsyncDestroy, attEattConnectionReqPtr);
+
+    return;
+}
+
+/**
+ * @brief received le credit based connect response of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReceiveConnectionRspAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectionRspContext *attEattConnectionRspPtr = (AttEattConnectionRspContext *)context;
+    AttConnectInfo *connect = NULL;
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+
+    AttGetConnectInfoIndexByEattCid(attEattConnectionRspPtr->lcid, &bearer, &connect);
+
+    if (connect == NULL) {
+        LOG_INFO("%{public}s connect == NULL", __FUNCTION__);
+        goto ATTEATTRECEIVECONNECTIONRSP_END;
+    }
+
+    if (attEattConnectionRspPtr->result != L2CAP_LE_CONNECTION_SUCCESSFUL) {
+        LOG_INFO("%{public}s result = %hu", __FUNCTION__, attEattConnectionRspPtr->result);
+        AttEattReleaseBearer(connect, bearer);
+        goto ATTEATTRECEIVECONNECTIONRSP_END;
+    }
+
+    if (attEattConnectionRspPtr->cfg.mtu < ATT_EATT_MIN_MTU) {
+        LOG_WARN("%{public}s mtu = %hu is below the minimum", __FUNCTION__, attEattConnectionRspPtr->cfg.mtu);
+        L2CIF_LeDisconnectionReq(attEattConnectionRspPtr->lcid, NULL);
+        AttEattReleaseBearer(connect, bearer);
+        goto ATTEATTRECEIVECONNECTIONRSP_END;
+    }
+
+    connect->bearer[bearer].mtu = Min(ATT_EATT_MTU, attEattConnectionRspPtr->cfg.mtu);
+    AttSendSequenceScheduling(connect);
+
+ATTEATTRECEIVECONNECTIONRSP_END:
+    MEM_MALLOC.free(attEattConnectionRspPtr);
+    return;
+}
+
+/**
+ * @brief destroy received le credit based connect response of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReceiveConnectionRspAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattConnectionRspContext *attEattConnectionRspPtr = (AttEattConnectionRspContext *)context;
+
+    MEM_MALLOC.free(attEattConnectionRspPtr);
+
+    return;
+}
+
+/**
+ * @brief received le credit based connect response of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 info Indicates the pointer to L2capConnectionInfo.
+ * @param3 cfg Indicates the pointer to L2capLeConfigInfo.
+ * @param4 result Indicates the result.
+ * @param5 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveConnectionRsp(
+    uint16_t lcid, const L2capConnectionInfo *info, const L2capLeConfigInfo *cfg, uint16_t result, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, result = %hu", __FUNCTION__, lcid, result);
+
+    AttEattConnectionRspContext *attEattConnectionRspPtr = MEM_MALLOC.alloc(sizeof(AttEattConnectionRspContext));
+    if (attEattConnectionRspPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    attEattConnectionRspPtr->lcid = lcid;
+    attEattConnectionRspPtr->result = result;
+    (void)memcpy_s(&attEattConnectionRspPtr->cfg, sizeof(L2capLeConfigInfo), cfg, sizeof(L2capLeConfigInfo));
+
+    AttAsyncProcess(
+        AttEattReceiveConnectionRspAsync, AttEattReceiveConnectionRspAsyncDestroy, attEattConnectionRspPtr);
+
+    return;
+}
+
+/**
+ * @brief received disconnect request of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReceiveDisconnectionReqAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattDisconnectContext *attEattDisconnectPtr = (AttEattDisconnectContext *)context;
+
+    L2CIF_LeDisconnectionRsp(attEattDisconnectPtr->lcid, attEattDisconnectPtr->id, NULL);
+    AttEattReleaseBearerAsync(attEattDisconnectPtr);
+
+    return;
+}
+
+/**
+ * @brief release the enhanced bearer of a disconnected channel in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattReleaseBearerAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattDisconnectContext *attEattDisconnectPtr = (AttEattDisconnectContext *)context;
+    AttConnectInfo *connect = NULL;
+    uint8_t bearer = ATT_UNENHANCED_BEARER;
+
+    AttGetConnectInfoIndexByEattCid(attEattDisconnectPtr->lcid, &bearer, &connect);
+    if (connect != NULL) {
+        AttEattReleaseBearer(connect, bearer);
+    }
+
+    MEM_MALLOC.free(attEattDisconnectPtr);
+    return;
+}
+
+/**
+ * @brief destroy disconnect of an enhanced bearer in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttEattDisconnectAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttEattDisconnectContext *attEattDisconnectPtr = (AttEattDisconnectContext *)context;
+
+    MEM_MALLOC.free(attEattDisconnectPtr);
+
+    return;
+}
+
+/**
+ * @brief post a disconnect event of an enhanced bearer to self thread.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 id Indicates the id.
+ * @param3 callback Indicates the pointer to function pointer.
+ */
+static void AttEattDisconnectProcess(uint16_t lcid, uint8_t id, void (*callback)(const void *context))
+{
+    AttEattDisconnectContext *attEattDisconnectPtr = MEM_MALLOC.alloc(sizeof(AttEattDisconnectContext));
+    if (attEattDisconnectPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+
+    attEattDisconnectPtr->lcid = lcid;
+    attEattDisconnectPtr->id = id;
+
+    AttAsyncProcess(callback, AttEattDisconnectAsyncDestroy, attEattDisconnectPtr);
+
+    return;
+}
+
+/**
+ * @brief received disconnect request of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 id Indicates the id.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveDisconnectionReq(uint16_t lcid, uint8_t id, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, id = %hhu", __FUNCTION__, lcid, id);
+
+    AttEattDisconnectProcess(lcid, id, AttEattReceiveDisconnectionReqAsync);
+
+    return;
+}
+
+/**
+ * @brief received disconnect response of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveDisconnectionRsp(uint16_t lcid, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu", __FUNCTION__, lcid);
+
+    AttEattDisconnectProcess(lcid, 0, AttEattReleaseBearerAsync);
+
+    return;
+}
+
+/**
+ * @brief received disconnect abnormal of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 reason Indicates the reason.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattDisconnectAbnormal(uint16_t lcid, uint8_t reason, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, reason = %hhu", __FUNCTION__, lcid, reason);
+
+    AttEattDisconnectProcess(lcid, 0, AttEattReleaseBearerAsync);
+
+    return;
+}
+
+/**
+ * @brief received remote busy state of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 busy Indicates the busy state.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattRemoteBusy(uint16_t lcid, uint8_t busy, void *ctx)
+{
+    LOG_INFO("%{public}s enter, lcid = %hu, busy = %hhu", __FUNCTION__, lcid, busy);
+
+    return;
+}
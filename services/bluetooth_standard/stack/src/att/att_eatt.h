@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file att_eatt.h
+ *
+ * @brief declare enhanced att bearer function to be called.
+ *
+ */
+
+#ifndef ATT_EATT_H
+#define ATT_EATT_H
+
+#include <stdint.h>
+
+#include "btstack.h"
+#include "packet.h"
+
+#include "att_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief register the enhanced att psm to l2cap.
+ *
+ */
+void AttEattRegisterService();
+
+/**
+ * @brief received le credit based connect request of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 id Indicates the id.
+ * @param3 info Indicates the pointer to L2capConnectionInfo.
+ * @param4 cfg Indicates the pointer to L2capLeConfigInfo.
+ * @param5 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveConnectionReq(
+    uint16_t lcid, uint8_t id, const L2capConnectionInfo *info, const L2capLeConfigInfo *cfg, void *ctx);
+
+/**
+ * @brief received le credit based connect response of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 info Indicates the pointer to L2capConnectionInfo.
+ * @param3 cfg Indicates the pointer to L2capLeConfigInfo.
+ * @param4 result Indicates the result.
+ * @param5 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveConnectionRsp(
+    uint16_t lcid, const L2capConnectionInfo *info, const L2capLeConfigInfo *cfg, uint16_t result, void *ctx);
+
+/**
+ * @brief received disconnect request of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 id Indicates the id.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveDisconnectionReq(uint16_t lcid, uint8_t id, void *ctx);
+
+/**
+ * @brief received disconnect response of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 ctx Indicates the pointer to context.
+ */
+void AttEattReceiveDisconnectionRsp(uint16_t lcid, void *ctx);
+
+/**
+ * @brief received disconnect abnormal of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 reason Indicates the reason.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattDisconnectAbnormal(uint16_t lcid, uint8_t reason, void *ctx);
+
+/**
+ * @brief received remote busy state of an enhanced bearer.
+ *
+ * @param1 lcid Indicates the lcid.
+ * @param2 busy Indicates the busy state.
+ * @param3 ctx Indicates the pointer to context.
+ */
+void AttEattRemoteBusy(uint16_t lcid, uint8_t busy, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ATT_EATT_H
@@ -24,6 +24,7 @@
 
 #include "att_connect.h"
 #include "att_common.h"
+#include "att_eatt.h"
 #include "att_receive.h"
 
 #include "alarm.h"
@@ -100,6 +101,7 @@ static void AttAlarmListInit()
 
     uint16_t index = 0;
     uint16_t increaseIndex;
+    uint8_t bearer;
     AttConnectInfo *connectInfo = NULL;
     AttConnectingInfo *connectingInfo = NULL;
 
@@ -107,7 +109,9 @@ static void AttAlarmListInit()
     connectingInfo = AttGetConnectingStart();
 
     for (; index < MAXCONNECT; ++index) {
-        connectInfo[index].alarm = AlarmCreate((char *)&index, 0);
+        for (bearer = 0; bearer < ATT_MAX_BEARERS; ++bearer) {
+            connectInfo[index].bearer[bearer].alarm = AlarmCreate((char *)&index, 0);
+        }
     }
 
     for (increaseIndex = MAXCONNECT, index = 0; (increaseIndex < STEP_TWO * MAXCONNECT) && (index < MAXCONNECT);
@@ -205,10 +209,7 @@ static void ATT_ShutDownAsync(const void *context)
 
     for (; index < MAXCONNECT; ++index) {
         AttShutDownClearConnectInfo(&connectInfo[index]);
-        ListClear(connectInfo[index].instruct);
-        if (connectInfo[index].alarm) {
-            AlarmCancel(connectInfo[index].alarm);
-        }
+        AttClearBearers(&connectInfo[index]);
         if (connectingInfo[index].bredrAlarm) {
             AlarmCancel(connectingInfo[index].bredrAlarm);
         }
@@ -273,6 +274,7 @@ static void L2cifLeRisterFixChannelCallback(uint16_t cid, int result)
     bredrl2capServiceTObj.recvData = (void (*)(uint16_t, Packet *, void *))AttRecvData;
 
     L2CIF_RegisterService(BT_PSM_ATT, &bredrl2capServiceTObj, NULL, L2cifRegisterServiceCallback);
+    AttEattRegisterService();
 
     return;
 }
@@ -301,13 +303,16 @@ static void AttDelete(AttConnectInfo *connectInfo, AttConnectingInfo *connecting
     LOG_INFO("%{public}s enter", __FUNCTION__);
 
     uint16_t index = 0;
+    uint8_t bearer;
 
     for (; index < MAXCONNECT; ++index) {
         ListDelete(connectInfo[index].instruct);
         connectInfo[index].instruct = NULL;
-        if (connectInfo[index].alarm) {
-            AlarmDelete(connectInfo[index].alarm);
-            connectInfo[index].alarm = NULL;
+        for (bearer = 0; bearer < ATT_MAX_BEARERS; ++bearer) {
+            if (connectInfo[index].bearer[bearer].alarm) {
+                AlarmDelete(connectInfo[index].bearer[bearer].alarm);
+                connectInfo[index].bearer[bearer].alarm = NULL;
+            }
         }
         if (connectingInfo[index].bredrAlarm) {
             AlarmDelete(connectingInfo[index].bredrAlarm);
@@ -320,7 +320,7 @@ void AttErrorResponse(AttConnectInfo *connect, const Buffer *buffer)
     uint8_t *data = NULL;
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
@@ -350,7 +350,6 @@ void AttErrorResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTERRORRESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
 
@@ -414,7 +413,7 @@ void AttExchangeMTUResponse(AttConnectInfo *connect, const Buffer *buffer)
     uint16_t *data = NULL;
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
@@ -444,7 +443,6 @@ void AttExchangeMTUResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTEXCHANGEMTURESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -534,7 +532,7 @@ void AttFindInformationResponse(AttConnectInfo *connect, const Buffer *buffer)
     AttError attErrorObj;
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL and goto ATTFINDINFORMATIONRESPONSE_END", __FUNCTION__);
@@ -572,7 +570,6 @@ void AttFindInformationResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTFINDINFORMATIONRESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -670,7 +667,7 @@ void AttFindByTypeValueResponse(AttConnectInfo *connect, const Buffer *buffer)
     AttClientDataCallback *attClientDataCallback = NULL;
     AttError attErrorObj;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL) || (buffer == NULL)) {
@@ -706,7 +703,6 @@ void AttFindByTypeValueResponse(AttConnectInfo *connect, const Buffer *buffer)
     MEM_MALLOC.free(attFindObj.findByTypeValueResponse.handleInfoList);
 
 ATTFINDBYTYPEVALUERESPONSE_END:
-    ListRemoveFirst(connect->instruct);
     AttReceiveSequenceScheduling(connect);
     return;
 }
@@ -788,7 +784,7 @@ void AttReadByTypeResponse(AttConnectInfo *connect, const Buffer *buffer)
     AttClientDataCallback *attClientDataCallback = NULL;
     AttError attErrorObj;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL || (buffer == NULL))) {
         goto ATTREADBYTYPERESPONSE_END;
@@ -826,7 +822,6 @@ void AttReadByTypeResponse(AttConnectInfo *connect, const Buffer *buffer)
 
 ATTREADBYTYPERESPONSE_END:
     if (connect != NULL) {
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -893,7 +888,7 @@ void AttReadResponse(AttConnectInfo *connect, const Buffer *buffer)
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
     }
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL)) {
@@ -907,7 +902,6 @@ void AttReadResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTREADRESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -975,7 +969,7 @@ void AttReadBlobResponse(AttConnectInfo *connect, const Buffer *buffer)
 
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL)) {
@@ -992,7 +986,6 @@ void AttReadBlobResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTREADBLOBRESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1048,7 +1041,7 @@ void AttReadMultipleResponse(AttConnectInfo *connect, const Buffer *buffer)
 
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
@@ -1069,7 +1062,44 @@ void AttReadMultipleResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTREADMULTIPLERESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
+        AttReceiveSequenceScheduling(connect);
+    }
+    return;
+}
+
+/**
+ * @brief received read multiple variable response.
+ *
+ * @param1 connect Indicates the pointer to const AttConnectInfo.
+ * @param2 buffer Indicates the pointer to Buffer.
+ */
+void AttReadMultipleVariableResponse(AttConnectInfo *connect, const Buffer *buffer)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    AttClientDataCallback *attClientDataCallback = NULL;
+
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
+
+    if (buffer == NULL) {
+        LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
+    }
+
+    attClientDataCallback = AttGetATTClientCallback();
+    if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL)) {
+        LOG_WARN("%{public}s attClientDataCallback or attClientDataCallback->attClientCallback is NULL", __FUNCTION__);
+        goto ATTREADMULTIPLEVARIABLERESPONSE_END;
+    }
+
+    attClientDataCallback->attClientCallback(connect->retGattConnectHandle,
+        ATT_READ_MULTIPLE_VARIABLE_RESPONSE_ID,
+        NULL,
+        (Buffer *)buffer,
+        attClientDataCallback->context);
+
+ATTREADMULTIPLEVARIABLERESPONSE_END:
+    if (connect != NULL) {
+        LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1165,7 +1195,7 @@ void AttReadByGroupTypeResponse(AttConnectInfo *connect, const Buffer *buffer)
     AttClientDataCallback *attClientDataCallback = NULL;
     AttError attErrorObj;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL) || (buffer == NULL)) {
@@ -1198,7 +1228,6 @@ void AttReadByGroupTypeResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTREADBYGROUPTYPERESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL", __FUNCTION__);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1261,7 +1290,7 @@ void AttWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
 
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     attClientDataCallback = AttGetATTClientCallback();
     if ((attClientDataCallback == NULL) || (attClientDataCallback->attClientCallback == NULL)) {
@@ -1275,7 +1304,6 @@ void AttWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTWRITERESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1474,7 +1502,7 @@ void AttPrepareWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
     Buffer *bufferNew = NULL;
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
     if (buffer == NULL) {
         goto ATTPREPAREWRITERESPONSE_END;
     }
@@ -1509,7 +1537,6 @@ void AttPrepareWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTPREPAREWRITERESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1575,7 +1602,7 @@ void AttExecuteWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
 
     AttClientDataCallback *attClientDataCallback = NULL;
 
-    AlarmCancel(connect->alarm);
+    AlarmCancel(AttGetRecvBearer(connect)->alarm);
 
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
@@ -1594,7 +1621,6 @@ void AttExecuteWriteResponse(AttConnectInfo *connect, const Buffer *buffer)
 ATTEXECUTEWRITERESPONSE_END:
     if (connect != NULL) {
         LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
         AttReceiveSequenceScheduling(connect);
     }
     return;
@@ -1712,8 +1738,6 @@ void AttHandleValueConfirmation(AttConnectInfo *connect, const Buffer *buffer)
     AttWrite attWrite;
     attWrite.confirmation.attHandle = 0x0000;
 
-    AlarmCancel(connect->alarm);
-
     if (buffer == NULL) {
         LOG_WARN("%{public}s:buffer == NULL", __FUNCTION__);
         goto ATTHANDLEVALUECONFIRMATION_END;
@@ -1736,11 +1760,7 @@ void AttHandleValueConfirmation(AttConnectInfo *connect, const Buffer *buffer)
         attServerDataCallback->context);
 
 ATTHANDLEVALUECONFIRMATION_END:
-    if (connect != NULL) {
-        LOG_INFO("%{public}s return connect != NULL, connectHandle = %hu", __FUNCTION__, connect->retGattConnectHandle);
-        ListRemoveFirst(connect->instruct);
-        AttReceiveSequenceScheduling(connect);
-    }
+    // indications are not queued on instruct, the confirmation completes no client transaction
     return;
 }
 
@@ -1847,6 +1867,7 @@ void FunctionListInit()
     functionList[READ_BLOB_RESPONSE] = AttReadBlobResponse;
     functionList[READ_MULTIPLE_REQUEST] = AttReadMultipleRequest;
     functionList[READ_MULTIPLE_RESPONSE] = AttReadMultipleResponse;
+    functionList[READ_MULTIPLE_VARIABLE_RESPONSE] = AttReadMultipleVariableResponse;
     functionList[READ_BY_GROUP_TYPE_REQUEST] = AttReadByGroupTypeRequest;
     functionList[READ_BY_GROUP_TYPE_RESPONSE] = AttReadByGroupTypeResponse;
     functionList[WRITE_REQUEST] = AttWriteRequest;
@@ -151,6 +151,14 @@ void AttReadMultipleRequest(AttConnectInfo *connect, const Buffer *buffer);
  */
 void AttReadMultipleResponse(AttConnectInfo *connect, const Buffer *buffer);
 
+/**
+ * @brief received read multiple variable response.
+ *
+ * @param1 connect Indicates the AttConnectInfo.
+ * @param2 buffer Indicates the pointer to Buffer.
+ */
+void AttReadMultipleVariableResponse(AttConnectInfo *connect, const Buffer *buffer);
+
 /**
  * @brief received readbygrouptype request.
  *
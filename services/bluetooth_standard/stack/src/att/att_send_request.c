@@ -61,6 +61,7 @@ static void AttReadBlobRequestAsync(const void *context);
 static void AttReadBlobRequestAsyncDestroy(const void *context);
 static void AttReadMultipleRequestAsync(const void *context);
 static void AttReadMultipleRequestAsyncDestroy(const void *context);
+static void AttReadMultipleVariableRequestAsync(const void *context);
 static void AttReadByGroupTypeRequestAsync(const void *context);
 static void AttReadByGroupTypeRequestAsyncDestroy(const void *context);
 static void AttWriteRequestAsync(const void *context);
@@ -110,7 +111,8 @@ void AttGapSignatureGenerationResultAsync(const void *context)
         attGapSignaturePtr->signatureLen,
         attGapSignaturePtr->signaturePtr,
         attGapSignaturePtr->signatureLen);
-    AttResponseSendData(sigedWriteCommandGenerContextPtr->connect, sigedWriteCommandGenerContextPtr->packet);
+    AttResponseSendData(
+        sigedWriteCommandGenerContextPtr->connect, ATT_UNENHANCED_BEARER, sigedWriteCommandGenerContextPtr->packet);
 
     PacketFree(sigedWriteCommandGenerContextPtr->packet);
     BufferFree(bufferSig);
@@ -754,13 +756,14 @@ void ATT_ReadBlobRequest(uint16_t connectHandle, uint16_t attHandle, uint16_t of
 }
 
 /**
- * @brief read multiple request in self thread..
+ * @brief send a read multiple or read multiple variable request in self thread.
  *
- * @param context Indicates the pointer to context.
+ * @param1 context Indicates the pointer to context.
+ * @param2 opcode Indicates the opcode of the request.
  */
-static void AttReadMultipleRequestAsync(const void *context)
+static void AttReadMultipleRequestSend(const void *context, uint8_t opcode)
 {
-    LOG_INFO("%{public}s enter", __FUNCTION__);
+    LOG_INFO("%{public}s enter, opcode = %hhu", __FUNCTION__, opcode);
 
     uint16_t index = 0;
     int ret;
@@ -788,7 +791,7 @@ static void AttReadMultipleRequestAsync(const void *context)
         return;
     }
     data = BufferPtr(PacketContinuousPayload(packet));
-    data[0] = READ_MULTIPLE_REQUEST;
+    data[0] = opcode;
 
     PacketPayloadAddLast(packet, readMultipleReqAsyncPtr->attValue);
     ListAddLast(connect->instruct, packet);
@@ -801,6 +804,26 @@ ATTREADMULTIPLEREQUEST_END:
     return;
 }
 
+/**
+ * @brief read multiple request in self thread..
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttReadMultipleRequestAsync(const void *context)
+{
+    AttReadMultipleRequestSend(context, READ_MULTIPLE_REQUEST);
+}
+
+/**
+ * @brief read multiple variable request in self thread.
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttReadMultipleVariableRequestAsync(const void *context)
+{
+    AttReadMultipleRequestSend(context, READ_MULTIPLE_VARIABLE_REQUEST);
+}
+
 /**
  * @brief destroy read multiple request in self thread..
  *
@@ -846,6 +869,35 @@ void ATT_ReadMultipleRequest(uint16_t connectHandle, const Buffer *handleList)
     return;
 }
 
+/**
+ * @brief gatt send read multiple variable request to att.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 handleList Indicates the pointer to a set of two or more attribute handles.
+ */
+void ATT_ReadMultipleVariableRequest(uint16_t connectHandle, const Buffer *handleList)
+{
+    LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
+
+    Buffer *bufferPtr = NULL;
+    ReadResponseAsync *readMultipleReqAsyncPtr = NULL;
+
+    bufferPtr = BufferRefMalloc(handleList);
+    readMultipleReqAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    if (readMultipleReqAsyncPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        BufferFree(bufferPtr);
+        return;
+    }
+    readMultipleReqAsyncPtr->connectHandle = connectHandle;
+    readMultipleReqAsyncPtr->attValue = bufferPtr;
+
+    AttAsyncProcess(
+        AttReadMultipleVariableRequestAsync, AttReadMultipleRequestAsyncDestroy, readMultipleReqAsyncPtr);
+
+    return;
+}
+
 /**
  * @brief read by group type request async data assign..
  *
@@ -1143,7 +1195,7 @@ static void AttWriteCommandAsync(const void *context)
     ((uint16_t *)(data + 1))[0] = writeCommandAsyncPtr->attHandle;
 
     PacketPayloadAddLast(packet, writeCommandAsyncPtr->attValue);
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
     ClientCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1575,7 +1627,7 @@ static void AttHandleValueConfirmationAsync(const void *context)
     data = BufferPtr(PacketContinuousPayload(packet));
     data[0] = HANDLE_VALUE_CONFIRMATION;
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
     ClientCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -66,8 +66,14 @@ static void AttPrepareWriteResponseAsync(const void *context);
 static void AttPrepareWriteResponseAsyncDestroy(const void *context);
 static void AttExecuteWriteResponseAsync(const void *context);
 static void AttExecuteWriteResponseAsyncDestroy(const void *context);
+static Packet *AttHandleValueNotificationPacket(
+    const AttConnectInfo *connect, uint16_t attHandle, const Buffer *attValue);
 static void AttHandleValueNotificationAsync(const void *context);
 static void AttHandleValueNotificationAsyncDestroy(const void *context);
+static void AttHandleValueNotificationListAsync(const void *context);
+static void AttHandleValueNotificationListAsyncDestroy(const void *context);
+static void AttMultipleHandleValueNotificationAsync(const void *context);
+static void AttMultipleHandleValueNotificationAsyncDestroy(const void *context);
 static void AttHandleValueIndicationAsync(const void *context);
 static void AttHandleValueIndicationAsyncDestroy(const void *context);
 
@@ -148,7 +154,7 @@ static void AttErrorResponseAsync(const void *context)
     ((uint16_t *)(data + STEP_TWO))[0] = errorResAsyncPtr->ATTErrorPtr->attHandleInError;
     data[STEP_FOUR] = errorResAsyncPtr->ATTErrorPtr->errorCode;
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, errorResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -179,10 +185,11 @@ static void AttErrorResponseAsyncDestroy(const void *context)
  * @brief gatt send error response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attErrorPtr Indicates the pointer to const error response parameter.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attErrorPtr Indicates the pointer to const error response parameter.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ErrorResponse(uint16_t connectHandle, const AttError *attErrorPtr)
+void ATT_ErrorResponse(uint16_t connectHandle, uint8_t bearer, const AttError *attErrorPtr)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, reqOpcode = %{public}d, attHandleInError = %{public}d, errorCode = %{public}d",
         __FUNCTION__,
@@ -209,6 +216,7 @@ void ATT_ErrorResponse(uint16_t connectHandle, const AttError *attErrorPtr)
         return;
     }
     errorResAsyncPtr->connectHandle = connectHandle;
+    errorResAsyncPtr->bearer = bearer;
     errorResAsyncPtr->ATTErrorPtr = attErrorAsyncPtr;
 
     AttAsyncProcess(AttErrorResponseAsync, AttErrorResponseAsyncDestroy, errorResAsyncPtr);
@@ -249,7 +257,7 @@ static void AttExchangeMTUResponseAsync(const void *context)
     ((uint16_t *)(data + 1))[0] = exchangeMtuResPtr->mtu;
     connect->mtu = Min(connect->receiveMtu, exchangeMtuResPtr->mtu);
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
     ServerCallbackReturnValue(ret, connect);
 
     PacketFree(packet);
@@ -395,7 +403,7 @@ static void AttFindInformationResponseAsync(const void *context)
     data = BufferPtr(PacketContinuousPayload(packet));
     AttFindInformationResponsePacketDataAssign(data, findInforPtr, dataLen);
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, findInforPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -426,14 +434,15 @@ static void AttFindInformationResponseAsyncDestroy(const void *context)
  * @brief gatt send findInformation response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 format Indicates the format of the information data.
- * @param3 handleUUIDPairs Indicates the pointer to const information data whose format is determined by the Format
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 format Indicates the format of the information data.
+ * @param4 handleUUIDPairs Indicates the pointer to const information data whose format is determined by the Format
  * field.
- * @param4 pairNum Indicates the paris number of the Information Data.
+ * @param5 pairNum Indicates the paris number of the Information Data.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
 void ATT_FindInformationResponse(
-    uint16_t connectHandle, uint8_t format, AttHandleUuid *handleUUIDPairs, uint16_t pairNum)
+    uint16_t connectHandle, uint8_t bearer, uint8_t format, AttHandleUuid *handleUUIDPairs, uint16_t pairNum)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, format=%hhu, pairNum=%hu", __FUNCTION__, connectHandle, format, pairNum);
 
@@ -462,6 +471,7 @@ void ATT_FindInformationResponse(
         return;
     }
     findInfor->connectHandle = connectHandle;
+    findInfor->bearer = bearer;
     findInfor->attFindInformationResContext.format = format;
     findInfor->attFindInformationResContext.pairNum = pairNum;
     findInfor->attFindInformationResContext.handleUuidPairs = attHandleUuidPtr;
@@ -512,7 +522,7 @@ static void AttFindByTypeValueResponseAsync(const void *context)
     (void)memcpy_s(
         data + 1, handleInfoListLen, findByTypeResAsyncPtr->attFindByTypeResContext.handleInfoList, handleInfoListLen);
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, findByTypeResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -543,11 +553,13 @@ static void AttFindByTypeValueResponseAsyncDestroy(const void *context)
  * @brief gatt send findbytypevalue response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 handleInfoList Indicates the pointer to const a list of 1 or more Handle Informations.
- * @param3 listNum Indicates the number of handles information list.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 handleInfoList Indicates the pointer to const a list of 1 or more Handle Informations.
+ * @param4 listNum Indicates the number of handles information list.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_FindByTypeValueResponse(uint16_t connectHandle, const AttHandleInfo *handleInfoList, uint16_t listNum)
+void ATT_FindByTypeValueResponse(
+    uint16_t connectHandle, uint8_t bearer, const AttHandleInfo *handleInfoList, uint16_t listNum)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu,listNum=%hu", __FUNCTION__, connectHandle, listNum);
 
@@ -563,6 +575,7 @@ void ATT_FindByTypeValueResponse(uint16_t connectHandle, const AttHandleInfo *ha
         return;
     }
     findByTypeResAsyncPtr->connectHandle = connectHandle;
+    findByTypeResAsyncPtr->bearer = bearer;
     findByTypeResAsyncPtr->attFindByTypeResContext.listNum = listNum;
     findByTypeResAsyncPtr->attFindByTypeResContext.handleInfoList = attHandleInfoPtr;
 
@@ -643,7 +656,7 @@ static void AttReadByTypeResponseAsync(const void *context)
         BufferFree(bufferPtr);
     }
 
-    int ret = AttResponseSendData(connect, packet);
+    int ret = AttResponseSendData(connect, readByTypeResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -672,13 +685,14 @@ static void AttReadByTypeResponseAsyncDestroy(const void *context)
  * @brief gatt send readbytype response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 length Indicates the size of each attribute handlevalue pair.
- * @param3 valueList Indicates the pointer to const a list of attribute data.
- * @param4 attrValueNum Indicates the value of attribute value number.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 length Indicates the size of each attribute handlevalue pair.
+ * @param4 valueList Indicates the pointer to const a list of attribute data.
+ * @param5 attrValueNum Indicates the value of attribute value number.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ReadByTypeResponse(
-    uint16_t connectHandle, uint8_t length, const AttReadByTypeRspDataList *valueList, uint16_t attrValueNum)
+void ATT_ReadByTypeResponse(uint16_t connectHandle, uint8_t bearer, uint8_t length,
+    const AttReadByTypeRspDataList *valueList, uint16_t attrValueNum)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, length=%hhu, attrValueNum = %hu",
         __FUNCTION__,
@@ -709,6 +723,7 @@ void ATT_ReadByTypeResponse(
 
     ReadByTypeResponseAsync *readByTypeResAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadByTypeResponseAsync));
     readByTypeResAsyncPtr->connectHandle = connectHandle;
+    readByTypeResAsyncPtr->bearer = bearer;
     readByTypeResAsyncPtr->attReadByTypeRspContext.len = length;
     readByTypeResAsyncPtr->attReadByTypeRspContext.valueNum = attrValueNum;
     readByTypeResAsyncPtr->attReadByTypeRspContext.valueList = attReadByTypeDataPtr;
@@ -763,7 +778,7 @@ static void AttReadResponseAsync(const void *context)
         PacketPayloadAddLast(packet, readResAsyncPtr->attValue);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, readResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -794,10 +809,11 @@ static void AttReadResponseAsyncDestroy(const void *context)
  * @brief gatt send read response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attValue Indicates the pointer to the value of the attribute with the handle given.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attValue Indicates the pointer to the value of the attribute with the handle given.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ReadResponse(uint16_t connectHandle, const Buffer *attValue)
+void ATT_ReadResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *attValue)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
 
@@ -811,6 +827,7 @@ void ATT_ReadResponse(uint16_t connectHandle, const Buffer *attValue)
         return;
     }
     readResAsyncPtr->connectHandle = connectHandle;
+    readResAsyncPtr->bearer = bearer;
     readResAsyncPtr->attValue = bufferPtr;
 
     AttAsyncProcess(AttReadResponseAsync, AttReadResponseAsyncDestroy, readResAsyncPtr);
@@ -864,7 +881,7 @@ static void AttReadBlobResponseAsync(const void *context)
         PacketPayloadAddLast(packet, readBlobResAsyncPtr->attValue);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, readBlobResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -895,10 +912,11 @@ static void AttReadBlobResponseAsyncDestroy(const void *context)
  * @brief gatt send readblob response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attReadBlobResObj Indicates the pointer to part of the value of the attribute with the handle given.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attReadBlobResObj Indicates the pointer to part of the value of the attribute with the handle given.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ReadBlobResponse(uint16_t connectHandle, const Buffer *attReadBlobResObj)
+void ATT_ReadBlobResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *attReadBlobResObj)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
 
@@ -912,6 +930,7 @@ void ATT_ReadBlobResponse(uint16_t connectHandle, const Buffer *attReadBlobResOb
         return;
     }
     readBlobResAsyncPtr->connectHandle = connectHandle;
+    readBlobResAsyncPtr->bearer = bearer;
     readBlobResAsyncPtr->attValue = bufferPtr;
 
     AttAsyncProcess(AttReadBlobResponseAsync, AttReadBlobResponseAsyncDestroy, readBlobResAsyncPtr);
@@ -966,7 +985,7 @@ static void AttReadMultipleResponseAsync(const void *context)
         PacketPayloadAddLast(packet, readMultipleResponseAsyncPtr->attValue);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, readMultipleResponseAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -997,10 +1016,11 @@ static void AttReadMultipleResponseAsyncDestroy(const void *context)
  * @brief gatt send readmultiple response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 valueList Indicates the pointer to a set of two or more values.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 valueList Indicates the pointer to a set of two or more values.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ReadMultipleResponse(uint16_t connectHandle, const Buffer *valueList)
+void ATT_ReadMultipleResponse(uint16_t connectHandle, uint8_t bearer, const Buffer *valueList)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
 
@@ -1014,6 +1034,7 @@ void ATT_ReadMultipleResponse(uint16_t connectHandle, const Buffer *valueList)
         return;
     }
     readMultipleResAsyncPtr->connectHandle = connectHandle;
+    readMultipleResAsyncPtr->bearer = bearer;
     readMultipleResAsyncPtr->attValue = bufferPtr;
 
     AttAsyncProcess(AttReadMultipleResponseAsync, AttReadMultipleResponseAsyncDestroy, readMultipleResAsyncPtr);
@@ -1092,7 +1113,7 @@ static void AttReadByGroupTypeResponseAsync(const void *context)
         BufferFree(bufferNew);
     }
 
-    int ret = AttResponseSendData(connect, packet);
+    int ret = AttResponseSendData(connect, attReadByGroupResponseAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1126,13 +1147,14 @@ static void AttReadByGroupTypeResponseAsyncDestroy(const void *context)
  * @brief gatt send readbygrouptype response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 length Indicates the size of each attribute data.
- * @param3 serviceList Indicates the pointer to const a list of attribute data.
- * @param4 serviceNum Indicates the number of attribute data.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 length Indicates the size of each attribute data.
+ * @param4 serviceList Indicates the pointer to const a list of attribute data.
+ * @param5 serviceNum Indicates the number of attribute data.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ReadByGroupTypeResponse(
-    uint16_t connectHandle, uint8_t length, const AttReadGoupAttributeData *serviceList, uint16_t serviceNum)
+void ATT_ReadByGroupTypeResponse(uint16_t connectHandle, uint8_t bearer, uint8_t length,
+    const AttReadGoupAttributeData *serviceList, uint16_t serviceNum)
 {
     LOG_INFO(
         "%{public}s enter, connectHandle = %hu,length = %{public}d,serviceNum = %{public}d", __FUNCTION__, connectHandle, length, serviceNum);
@@ -1158,6 +1180,7 @@ void ATT_ReadByGroupTypeResponse(
 
     attReadByGroupResAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadByGroupTypeResponseAsync));
     attReadByGroupResAsyncPtr->connectHandle = connectHandle;
+    attReadByGroupResAsyncPtr->bearer = bearer;
     attReadByGroupResAsyncPtr->attReadGroupResContext.length = length;
     attReadByGroupResAsyncPtr->attReadGroupResContext.num = serviceNum;
     attReadByGroupResAsyncPtr->attReadGroupResContext.attributeData = attReadGroupAttrDataPtr;
@@ -1203,7 +1226,7 @@ static void AttWriteResponseAsync(const void *context)
     data = BufferPtr(PacketContinuousPayload(packet));
     data[0] = WRITE_RESPONSE;
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, writeResponseAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1231,10 +1254,11 @@ static void AttWriteResponseAsyncDestroy(const void *context)
 /**
  * @brief gatt send write response to att.
  *
- * @param connectHandle Indicates the connect handle.
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_WriteResponse(uint16_t connectHandle)
+void ATT_WriteResponse(uint16_t connectHandle, uint8_t bearer)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu", __FUNCTION__, connectHandle);
 
@@ -1244,6 +1268,7 @@ void ATT_WriteResponse(uint16_t connectHandle)
         return;
     }
     writeResAsyncPtr->connectHandle = connectHandle;
+    writeResAsyncPtr->bearer = bearer;
 
     AttAsyncProcess(AttWriteResponseAsync, AttWriteResponseAsyncDestroy, writeResAsyncPtr);
 
@@ -1300,7 +1325,7 @@ static void AttPrepareWriteResponseAsync(const void *context)
         PacketPayloadAddLast(packet, prepareWriteResAsyncPtr->attValue);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, prepareWriteResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1331,12 +1356,13 @@ static void AttPrepareWriteResponseAsyncDestroy(const void *context)
  * @brief gatt send preparewrite response to att.
  *
  * @param1 connectHandle Indicates the connect handle.
- * @param2 attReadBlobObj Indicates the value of the struct AttReadBlobReqPrepareWriteValue.
- * @param3 attValue Indicates the pointer to the value of the attribute to be written.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
+ * @param3 attReadBlobObj Indicates the value of the struct AttReadBlobReqPrepareWriteValue.
+ * @param4 attValue Indicates the pointer to the value of the attribute to be written.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
 void ATT_PrepareWriteResponse(
-    uint16_t connectHandle, AttReadBlobReqPrepareWriteValue attReadBlobObj, const Buffer *attValue)
+    uint16_t connectHandle, uint8_t bearer, AttReadBlobReqPrepareWriteValue attReadBlobObj, const Buffer *attValue)
 {
     LOG_INFO("%{public}s enter, connectHandle = %hu, attHandle = %{public}d, offset = %{public}d",
         __FUNCTION__,
@@ -1354,6 +1380,7 @@ void ATT_PrepareWriteResponse(
         return;
     }
     prepareWriteResAsyncPtr->connectHandle = connectHandle;
+    prepareWriteResAsyncPtr->bearer = bearer;
     prepareWriteResAsyncPtr->attReadBlobObj.attHandle = attReadBlobObj.attHandle;
     prepareWriteResAsyncPtr->attReadBlobObj.offset = attReadBlobObj.offset;
     prepareWriteResAsyncPtr->attValue = bufferPtr;
@@ -1397,7 +1424,7 @@ static void AttExecuteWriteResponseAsync(const void *context)
     data = BufferPtr(PacketContinuousPayload(packet));
     data[0] = EXECUTE_WRITE_RESPONSE;
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, executeWriteResAsyncPtr->bearer, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1425,10 +1452,11 @@ static void AttExecuteWriteResponseAsyncDestroy(const void *context)
 /**
  * @brief gatt send executewrite response to att.
  *
- * @param connectHandle Indicates the connect handle.
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 bearer Indicates the bearer the request arrived on, see ATT_GetRequestBearer.
  * @return Returns <b>0</b> if the operation is successful; returns <b>!0</b> if the operation fails.
  */
-void ATT_ExecuteWriteResponse(uint16_t connectHandle)
+void ATT_ExecuteWriteResponse(uint16_t connectHandle, uint8_t bearer)
 {
     LOG_INFO("%{public}s enter,connectHandle = %hu", __FUNCTION__, connectHandle);
 
@@ -1438,12 +1466,51 @@ void ATT_ExecuteWriteResponse(uint16_t connectHandle)
         return;
     }
     executeWriteResAsyncPtr->connectHandle = connectHandle;
+    executeWriteResAsyncPtr->bearer = bearer;
 
     AttAsyncProcess(AttExecuteWriteResponseAsync, AttExecuteWriteResponseAsyncDestroy, executeWriteResAsyncPtr);
 
     return;
 }
 
+/**
+ * @brief build a handle value notification packet referencing the value.
+ *
+ * @param1 connect Indicates the pointer to AttConnectInfo.
+ * @param2 attHandle Indicates the handle of the attribute.
+ * @param3 attValue Indicates the pointer to the value, truncated to the mtu of the connection.
+ * @return Returns the pointer to the packet, or NULL if the allocation fails.
+ */
+static Packet *AttHandleValueNotificationPacket(
+    const AttConnectInfo *connect, uint16_t attHandle, const Buffer *attValue)
+{
+    Packet *packet = NULL;
+    Buffer *bufferNew = NULL;
+    uint16_t bufferSizenoti;
+    uint8_t *data = NULL;
+
+    bufferSizenoti = BufferGetSize(attValue);
+    packet = PacketMalloc(0, 0, sizeof(uint8_t) + sizeof(uint16_t));
+    if (packet == NULL) {
+        LOG_ERROR("point to NULL");
+        return NULL;
+    }
+    data = BufferPtr(PacketContinuousPayload(packet));
+    data[0] = HANDLE_VALUE_NOTIFICATION;
+    ((uint16_t *)(data + 1))[0] = attHandle;
+
+    if ((bufferSizenoti > 0) && (bufferSizenoti <= (connect->mtu - STEP_THREE))) {
+        PacketPayloadAddLast(packet, attValue);
+    } else if (bufferSizenoti > (connect->mtu - STEP_THREE)) {
+        uint16_t len = connect->mtu - STEP_THREE;
+        bufferNew = BufferSliceMalloc(attValue, 0, len);
+        PacketPayloadAddLast(packet, bufferNew);
+        BufferFree(bufferNew);
+    }
+
+    return packet;
+}
+
 /**
  * @brief handle value notification in self thread..
  *
@@ -1456,11 +1523,8 @@ static void AttHandleValueNotificationAsync(const void *context)
     uint16_t index = 0;
     int ret;
     Packet *packet = NULL;
-    Buffer *bufferNew = NULL;
     AttConnectInfo *connect = NULL;
     WriteAsync *handleNotificationAsyncPtr = NULL;
-    uint16_t bufferSizenoti;
-    uint8_t *data = NULL;
 
     handleNotificationAsyncPtr = (WriteAsync *)context;
 
@@ -1471,26 +1535,13 @@ static void AttHandleValueNotificationAsync(const void *context)
         goto ATT_HANDLEVALUENOTIFICATION_END;
     }
 
-    bufferSizenoti = BufferGetSize(handleNotificationAsyncPtr->attValue);
-    packet = PacketMalloc(0, 0, sizeof(uint8_t) + sizeof(uint16_t));
+    packet = AttHandleValueNotificationPacket(
+        connect, handleNotificationAsyncPtr->attHandle, handleNotificationAsyncPtr->attValue);
     if (packet == NULL) {
-        LOG_ERROR("point to NULL");
-        return;
-    }
-    data = BufferPtr(PacketContinuousPayload(packet));
-    data[0] = HANDLE_VALUE_NOTIFICATION;
-    ((uint16_t *)(data + 1))[0] = handleNotificationAsyncPtr->attHandle;
-
-    if ((bufferSizenoti > 0) && (bufferSizenoti <= (connect->mtu - STEP_THREE))) {
-        PacketPayloadAddLast(packet, handleNotificationAsyncPtr->attValue);
-    } else if (bufferSizenoti > (connect->mtu - STEP_THREE)) {
-        uint16_t len = connect->mtu - STEP_THREE;
-        bufferNew = BufferSliceMalloc(handleNotificationAsyncPtr->attValue, 0, len);
-        PacketPayloadAddLast(packet, bufferNew);
-        BufferFree(bufferNew);
+        goto ATT_HANDLEVALUENOTIFICATION_END;
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
@@ -1548,6 +1599,190 @@ void ATT_HandleValueNotification(uint16_t connectHandle, uint16_t attHandle, con
     return;
 }
 
+/**
+ * @brief handle value notification to several connections in self thread..
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttHandleValueNotificationListAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    uint16_t index = 0;
+    int ret;
+    Packet *packet = NULL;
+    AttConnectInfo *connect = NULL;
+    NotificationListAsync *notificationListAsyncPtr = (NotificationListAsync *)context;
+
+    for (uint16_t i = 0; i < notificationListAsyncPtr->num; i++) {
+        connect = NULL;
+        AttGetConnectInfoIndexByConnectHandle(notificationListAsyncPtr->connectHandle[i], &index, &connect);
+        if (connect == NULL) {
+            LOG_INFO("%{public}s connectHandle = %hu connect == NULL",
+                __FUNCTION__, notificationListAsyncPtr->connectHandle[i]);
+            continue;
+        }
+
+        // every packet references the same value buffer, only the 3 byte header is per connection
+        packet = AttHandleValueNotificationPacket(
+            connect, notificationListAsyncPtr->attHandle, notificationListAsyncPtr->attValue);
+        if (packet == NULL) {
+            break;
+        }
+
+        ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
+        ServerCallbackReturnValue(ret, connect);
+        PacketFree(packet);
+    }
+
+    BufferFree(notificationListAsyncPtr->attValue);
+    MEM_MALLOC.free(notificationListAsyncPtr);
+    return;
+}
+
+/**
+ * @brief destroy handle value notification to several connections in self thread..
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttHandleValueNotificationListAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    NotificationListAsync *notificationListAsyncPtr = (NotificationListAsync *)context;
+
+    BufferFree(notificationListAsyncPtr->attValue);
+    MEM_MALLOC.free(notificationListAsyncPtr);
+
+    return;
+}
+
+/**
+ * @brief gatt send the same handlevalue notification to att for several connections.
+ *
+ * @param1 connectHandle Indicates the pointer to the connect handles.
+ * @param2 num Indicates the number of connect handles.
+ * @param3 attHandle Indicates the handle of the attribute.
+ * @param4 attValue Indicates the pointer to the current value of the attribute.
+ */
+void ATT_HandleValueNotificationList(
+    const uint16_t *connectHandle, uint16_t num, uint16_t attHandle, const Buffer *attValue)
+{
+    LOG_INFO("%{public}s enter, num = %hu, attHandle=%{public}d", __FUNCTION__, num, attHandle);
+
+    NotificationListAsync *notificationListAsyncPtr = NULL;
+
+    if (connectHandle == NULL || num == 0) {
+        return;
+    }
+
+    notificationListAsyncPtr = MEM_MALLOC.alloc(sizeof(NotificationListAsync) + num * sizeof(uint16_t));
+    if (notificationListAsyncPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+    notificationListAsyncPtr->attHandle = attHandle;
+    notificationListAsyncPtr->attValue = BufferRefMalloc(attValue);
+    notificationListAsyncPtr->num = num;
+    (void)memcpy_s(
+        notificationListAsyncPtr->connectHandle, num * sizeof(uint16_t), connectHandle, num * sizeof(uint16_t));
+
+    AttAsyncProcess(
+        AttHandleValueNotificationListAsync, AttHandleValueNotificationListAsyncDestroy, notificationListAsyncPtr);
+
+    return;
+}
+
+/**
+ * @brief multiple handle value notification in self thread..
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttMultipleHandleValueNotificationAsync(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    uint16_t index = 0;
+    int ret;
+    uint8_t *data = NULL;
+    Packet *packet = NULL;
+    AttConnectInfo *connect = NULL;
+    ReadResponseAsync *multipleNotificationAsyncPtr = (ReadResponseAsync *)context;
+
+    AttGetConnectInfoIndexByConnectHandle(multipleNotificationAsyncPtr->connectHandle, &index, &connect);
+
+    if (connect == NULL) {
+        LOG_INFO("%{public}s connect == NULL and goto ATT_MULTIPLEHANDLEVALUENOTIFICATION_END", __FUNCTION__);
+        goto ATT_MULTIPLEHANDLEVALUENOTIFICATION_END;
+    }
+
+    // tuples cannot be truncated, the caller packs them to fit the mtu
+    if (BufferGetSize(multipleNotificationAsyncPtr->attValue) > (size_t)(connect->mtu - sizeof(uint8_t))) {
+        LOG_WARN("%{public}s tuples exceed mtu = %hu", __FUNCTION__, connect->mtu);
+        goto ATT_MULTIPLEHANDLEVALUENOTIFICATION_END;
+    }
+
+    packet = PacketMalloc(0, 0, sizeof(uint8_t));
+    if (packet == NULL) {
+        LOG_ERROR("point to NULL");
+        goto ATT_MULTIPLEHANDLEVALUENOTIFICATION_END;
+    }
+    data = BufferPtr(PacketContinuousPayload(packet));
+    data[0] = MULTIPLE_HANDLE_VALUE_NOTIFICATION;
+    PacketPayloadAddLast(packet, multipleNotificationAsyncPtr->attValue);
+
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
+    ServerCallbackReturnValue(ret, connect);
+    PacketFree(packet);
+
+ATT_MULTIPLEHANDLEVALUENOTIFICATION_END:
+    BufferFree(multipleNotificationAsyncPtr->attValue);
+    MEM_MALLOC.free(multipleNotificationAsyncPtr);
+    return;
+}
+
+/**
+ * @brief destroy multiple handle value notification in self thread..
+ *
+ * @param context Indicates the pointer to context.
+ */
+static void AttMultipleHandleValueNotificationAsyncDestroy(const void *context)
+{
+    LOG_INFO("%{public}s enter", __FUNCTION__);
+
+    ReadResponseAsync *multipleNotificationAsyncPtr = (ReadResponseAsync *)context;
+
+    BufferFree(multipleNotificationAsyncPtr->attValue);
+    MEM_MALLOC.free(multipleNotificationAsyncPtr);
+
+    return;
+}
+
+/**
+ * @brief gatt send multiple handle value notification to att.
+ *
+ * @param1 connectHandle Indicates the connect handle.
+ * @param2 handleLengthValueList Indicates the pointer to the handle, length and value tuples.
+ */
+void ATT_MultipleHandleValueNotification(uint16_t connectHandle, const Buffer *handleLengthValueList)
+{
+    LOG_INFO("%{public}s enter, connectHandle = %hu", __FUNCTION__, connectHandle);
+
+    ReadResponseAsync *multipleNotificationAsyncPtr = MEM_MALLOC.alloc(sizeof(ReadResponseAsync));
+    if (multipleNotificationAsyncPtr == NULL) {
+        LOG_ERROR("point to NULL");
+        return;
+    }
+    multipleNotificationAsyncPtr->connectHandle = connectHandle;
+    multipleNotificationAsyncPtr->attValue = BufferRefMalloc(handleLengthValueList);
+
+    AttAsyncProcess(AttMultipleHandleValueNotificationAsync,
+        AttMultipleHandleValueNotificationAsyncDestroy,
+        multipleNotificationAsyncPtr);
+
+    return;
+}
+
 /**
  * @brief handle value indication in self thread..
  *
@@ -1595,7 +1830,7 @@ static void AttHandleValueIndicationAsync(const void *context)
         BufferFree(bufferNew);
     }
 
-    ret = AttResponseSendData(connect, packet);
+    ret = AttResponseSendData(connect, ATT_UNENHANCED_BEARER, packet);
     ServerCallbackReturnValue(ret, connect);
     PacketFree(packet);
 
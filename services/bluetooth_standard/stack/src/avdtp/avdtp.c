@@ -27,12 +27,14 @@ void AvdtShutdown(void *context);
 static void AVDT_Init()
 {
     LOG_DEBUG("[AVDT]%{public}s:", __func__);
+    AvdtMediaInit();
     return;
 }
 
 static void AVDT_Cleanup()
 {
     LOG_DEBUG("[AVDT]%{public}s:", __func__);
+    AvdtMediaCleanup();
     return;
 }
 
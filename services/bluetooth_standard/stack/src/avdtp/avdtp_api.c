@@ -2044,6 +2044,35 @@ uint16_t AVDT_GetL2capChannelByHandle(uint16_t handle)
     return Ret;
 }
 
+/**
+ *
+ * @brief         AVDT_GetMediaStats
+ *
+ * @details       Get the receive statistics of the media channel of a stream.
+ *
+ * @return        AVDT_SUCCESS if successful, otherwise error.
+ *
+ */
+uint16_t AVDT_GetMediaStats(uint16_t handle, AvdtMediaStats *stats)
+{
+    return AvdtGetMediaStats(handle, stats);
+}
+
+/**
+ *
+ * @brief         AVDT_SetMediaClockRate
+ *
+ * @details       Set the RTP clock rate of a stream for the jitter estimation.
+ *
+ * @return        AVDT_SUCCESS if successful, otherwise error.
+ *
+ */
+uint16_t AVDT_SetMediaClockRate(uint16_t handle, uint32_t clockRate)
+{
+    LOG_INFO("[AVDT]%{public}s:handle(%hu),clockRate(%u)", __func__, handle, clockRate);
+    return AvdtSetMediaClockRate(handle, clockRate);
+}
+
 /**
  *
  * @brief         AVDT_Rej
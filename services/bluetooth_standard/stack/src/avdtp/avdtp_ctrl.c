@@ -14,13 +14,17 @@
  */
 
 #include "avdtp_ctrl.h"
+#include <time.h>
 #include "avdtp_impl.h"
 #include "avdtp_message.h"
 #include "btm.h"
 #include "btm/btm_thread.h"
 #include "log.h"
+#include "platform/include/mutex.h"
 #include "securec.h"
 
+#define AVDT_NS_PER_SECOND 1000000000
+
 /**
  * Action function list
  */
@@ -99,6 +103,8 @@ const AvdtSigAction AVDT_SIG_ACTION[] = {
 };
 
 AvdtCB g_avdtCb;
+/* Guards g_avdtCb.mediaRecv, which is read from any thread */
+static Mutex *g_avdtMediaLock = NULL;
 /**
  * State table information
  */
@@ -1174,6 +1180,7 @@ void AvdtStreamCtrlDeallocByHandle(AvdtSigCtrl *sigCtrl, uint16_t handle)
     LOG_DEBUG("[AVDT]%{public}s: handle(%hu)", __func__, handle);
     for (int i = 0; i < AVDT_NUM_SEPS; i++) {
         if (sigCtrl->streamCtrl[i].isUsed && sigCtrl->streamCtrl[i].handle == handle) {
+            AvdtMediaSlotUnbind(&sigCtrl->streamCtrl[i]);
             if (sigCtrl->streamCtrl[i].pkt != NULL) {
                 PacketFree(sigCtrl->streamCtrl[i].pkt);
                 sigCtrl->streamCtrl[i].pkt = NULL;
@@ -1198,6 +1205,7 @@ void AvdtStreamCtrlDeallocAll(AvdtSigCtrl *sigCtrl)
     LOG_DEBUG("[AVDT]%{public}s:", __func__);
     for (int i = 0; i < AVDT_NUM_SEPS; i++) {
         if (sigCtrl->streamCtrl[i].isAllocated) {
+            AvdtMediaSlotUnbind(&sigCtrl->streamCtrl[i]);
             if (sigCtrl->streamCtrl[i].pkt != NULL) {
                 PacketFree(sigCtrl->streamCtrl[i].pkt);
                 sigCtrl->streamCtrl[i].pkt = NULL;
@@ -1335,6 +1343,10 @@ AvdtTransChannel *AvdtGetTransChTabByHandle(uint8_t type, uint16_t handle)
 void AvdtTransChDealloc(uint16_t lcid)
 {
     LOG_DEBUG("[AVDT]%{public}s: lcid(0x%x)", __func__, lcid);
+    AvdtMediaSlot *slot = AvdtGetMediaSlotByLcid(lcid);
+    if (slot != NULL) {
+        (void)memset_s(slot, sizeof(AvdtMediaSlot), 0, sizeof(AvdtMediaSlot));
+    }
     for (int i = 0; i < AVDT_CH_TABLE_SIZE; i++) {
         if ((g_avdtCb.transTable[i] != NULL) && lcid == g_avdtCb.transTable[i]->lcid) {
             free(g_avdtCb.transTable[i]);
@@ -1357,6 +1369,7 @@ void AvdtTransChDealloc(uint16_t lcid)
 void AvdtTransChDeallocAll(void)
 {
     LOG_DEBUG("[AVDT]%{public}s", __func__);
+    (void)memset_s(g_avdtCb.mediaSlots, sizeof(g_avdtCb.mediaSlots), 0, sizeof(g_avdtCb.mediaSlots));
     for (int i = 0; i < AVDT_CH_TABLE_SIZE; i++) {
         if (g_avdtCb.transTable[i] != NULL) {
             free(g_avdtCb.transTable[i]);
@@ -1477,6 +1490,9 @@ void AvdtFreeSigCtrlByHandle(uint16_t handle)
                 PacketFree(g_avdtCb.sigCtrl[i]->rxMsg);
                 g_avdtCb.sigCtrl[i]->rxMsg = NULL;
             }
+            for (int j = 0; j < AVDT_NUM_SEPS; j++) {
+                AvdtMediaSlotUnbind(&g_avdtCb.sigCtrl[i]->streamCtrl[j]);
+            }
             if (g_avdtCb.sigCtrl[i] != NULL) {
                 free(g_avdtCb.sigCtrl[i]);
                 g_avdtCb.sigCtrl[i] = NULL;
@@ -1802,4 +1818,204 @@ void AvdtIsEdr3MbMode(const BtAddr *bdAddr)
 {
     LOG_INFO("[AVDT]%{public}s: addr(%02x:%02x:%02x:%02x:%02x:%02x)", __func__, BT_ADDR_FMT_DSC(bdAddr->addr));
     BTM_IsRemoteDeviceSupportEdrAcl3MbMode(bdAddr, AvdtRecvRemoteDeviceSupport3MbCallback);
-}
\ No newline at end of file
+}
+
+void AvdtMediaInit(void)
+{
+    g_avdtMediaLock = MutexCreate();
+}
+
+void AvdtMediaCleanup(void)
+{
+    if (g_avdtMediaLock != NULL) {
+        MutexDelete(g_avdtMediaLock);
+        g_avdtMediaLock = NULL;
+    }
+}
+
+/**
+ *
+ * @brief        AvdtMediaSlotBind
+ *
+ * @details      Register the direct dispatch slot of an open media channel and reset the receive state of its stream.
+ *               The slot is looked up from the lcid of every received packet, the slot at lcid modulo the table size
+ *               is taken if it is free.
+ *
+ * @return       void
+ *
+ */
+void AvdtMediaSlotBind(uint16_t lcid, AvdtStreamCtrl *streamCtrl)
+{
+    LOG_DEBUG("[AVDT]%{public}s: lcid(0x%x), handle(%hu)", __func__, lcid, streamCtrl->handle);
+    AvdtMediaSlot *slot = AvdtGetMediaSlotByLcid(lcid);
+    for (int i = 0; (slot == NULL) && (i < AVDT_CH_TABLE_SIZE); i++) {
+        AvdtMediaSlot *candidate = &g_avdtCb.mediaSlots[(lcid + i) % AVDT_CH_TABLE_SIZE];
+        if (candidate->streamCtrl == NULL) {
+            slot = candidate;
+        }
+    }
+    if (slot == NULL) {
+        LOG_WARN("[AVDT]%{public}s: No free slot, lcid(0x%x) is dispatched by lookup", __func__, lcid);
+        return;
+    }
+    AvdtStreamConfig *streamConfig = AvdtGetSepConfigByCodecIndex(streamCtrl->codecIndex);
+    slot->streamCtrl = streamCtrl;
+    slot->sinkDataCback = (streamConfig != NULL) ? streamConfig->sinkDataCback : NULL;
+    slot->lcid = lcid;
+
+    if ((streamCtrl->handle == 0) || (streamCtrl->handle > AVDT_MAX_NUM_SEP) || (g_avdtMediaLock == NULL)) {
+        return;
+    }
+    MutexLock(g_avdtMediaLock);
+    AvdtMediaRecv *recv = &g_avdtCb.mediaRecv[streamCtrl->handle - 1];
+    uint32_t clockRate = recv->clockRate;
+    (void)memset_s(recv, sizeof(AvdtMediaRecv), 0, sizeof(AvdtMediaRecv));
+    recv->clockRate = clockRate;
+    MutexUnlock(g_avdtMediaLock);
+}
+
+/**
+ *
+ * @brief        AvdtMediaSlotUnbind
+ *
+ * @details      Free the direct dispatch slot of the stream, if any.
+ *
+ * @return       void
+ *
+ */
+void AvdtMediaSlotUnbind(const AvdtStreamCtrl *streamCtrl)
+{
+    for (int i = 0; i < AVDT_CH_TABLE_SIZE; i++) {
+        if (g_avdtCb.mediaSlots[i].streamCtrl == streamCtrl) {
+            (void)memset_s(&g_avdtCb.mediaSlots[i], sizeof(AvdtMediaSlot), 0, sizeof(AvdtMediaSlot));
+        }
+    }
+}
+
+/**
+ *
+ * @brief        AvdtGetMediaSlotByLcid
+ *
+ * @details      Get the direct dispatch slot of a media channel.
+ *
+ * @return       NULL if lcid is not an open media channel; otherwise the pointer of the slot.
+ *
+ */
+AvdtMediaSlot *AvdtGetMediaSlotByLcid(uint16_t lcid)
+{
+    AvdtMediaSlot *slot = &g_avdtCb.mediaSlots[lcid % AVDT_CH_TABLE_SIZE];
+    if ((slot->streamCtrl != NULL) && (slot->lcid == lcid)) {
+        return slot;
+    }
+    /* The home slot was taken by another channel when this one was bound */
+    for (int i = 0; i < AVDT_CH_TABLE_SIZE; i++) {
+        slot = &g_avdtCb.mediaSlots[i];
+        if ((slot->streamCtrl != NULL) && (slot->lcid == lcid)) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+static uint32_t AvdtGetArrivalTime(uint32_t clockRate)
+{
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * clockRate + (uint64_t)ts.tv_nsec * clockRate / AVDT_NS_PER_SECOND);
+}
+
+/**
+ *
+ * @brief        AvdtMediaRecvUpdate
+ *
+ * @details      Account a media packet in the receive state of the stream. Sequence numbers are tracked as in
+ *               RFC 3550 A.1 and the interarrival jitter is estimated as in RFC 3550 A.8.
+ *
+ * @return       void
+ *
+ */
+void AvdtMediaRecvUpdate(uint16_t handle, const AvdtRtpHeader *header)
+{
+    if ((handle == 0) || (handle > AVDT_MAX_NUM_SEP) || (g_avdtMediaLock == NULL)) {
+        return;
+    }
+    MutexLock(g_avdtMediaLock);
+    AvdtMediaRecv *recv = &g_avdtCb.mediaRecv[handle - 1];
+    AvdtMediaStats *stats = &recv->stats;
+    uint16_t delta = header->seq - stats->lastSeq;
+    bool isRestart = !recv->isSynced || (header->ssrc != stats->ssrc) ||
+                     ((delta > AVDT_RTP_MAX_DROPOUT) && (delta < AVDT_MEDIA_SEQ_MAX - AVDT_RTP_MAX_MISORDER));
+    stats->packets++;
+    if (!isRestart && ((delta == 0) || (delta >= AVDT_MEDIA_SEQ_MAX - AVDT_RTP_MAX_MISORDER))) {
+        stats->outOfOrder++;
+        MutexUnlock(g_avdtMediaLock);
+        return;
+    }
+    if (!isRestart) {
+        stats->lost += delta - 1;
+    }
+    stats->lastSeq = header->seq;
+    stats->lastTimestamp = header->timestamp;
+    stats->ssrc = header->ssrc;
+
+    if (recv->clockRate != 0) {
+        uint32_t transit = AvdtGetArrivalTime(recv->clockRate) - header->timestamp;
+        if (recv->hasTransit && !isRestart) {
+            int32_t diff = (int32_t)(transit - recv->lastTransit);
+            uint32_t absDiff = (diff < 0) ? (uint32_t)(-(int64_t)diff) : (uint32_t)diff;
+            recv->jitter += absDiff - ((recv->jitter + (1 << (AVDT_RTP_JITTER_SHIFT - 1))) >> AVDT_RTP_JITTER_SHIFT);
+            stats->jitter = recv->jitter >> AVDT_RTP_JITTER_SHIFT;
+        }
+        recv->lastTransit = transit;
+        recv->hasTransit = true;
+    }
+    recv->isSynced = true;
+    MutexUnlock(g_avdtMediaLock);
+}
+
+void AvdtMediaRecvMalformed(uint16_t handle)
+{
+    if ((handle == 0) || (handle > AVDT_MAX_NUM_SEP) || (g_avdtMediaLock == NULL)) {
+        return;
+    }
+    MutexLock(g_avdtMediaLock);
+    g_avdtCb.mediaRecv[handle - 1].stats.malformed++;
+    MutexUnlock(g_avdtMediaLock);
+}
+
+uint16_t AvdtGetMediaStats(uint16_t handle, AvdtMediaStats *stats)
+{
+    if ((handle == 0) || (handle > AVDT_MAX_NUM_SEP) || (stats == NULL)) {
+        return AVDT_BAD_PARAMS;
+    }
+    if (g_avdtMediaLock == NULL) {
+        LOG_WARN("[AVDT]%{public}s: AVDTP is not initialized", __func__);
+        return AVDT_FAILED;
+    }
+    MutexLock(g_avdtMediaLock);
+    *stats = g_avdtCb.mediaRecv[handle - 1].stats;
+    MutexUnlock(g_avdtMediaLock);
+    return AVDT_SUCCESS;
+}
+
+uint16_t AvdtSetMediaClockRate(uint16_t handle, uint32_t clockRate)
+{
+    if ((handle == 0) || (handle > AVDT_MAX_NUM_SEP)) {
+        return AVDT_BAD_PARAMS;
+    }
+    if (g_avdtMediaLock == NULL) {
+        LOG_WARN("[AVDT]%{public}s: AVDTP is not initialized", __func__);
+        return AVDT_FAILED;
+    }
+    MutexLock(g_avdtMediaLock);
+    AvdtMediaRecv *recv = &g_avdtCb.mediaRecv[handle - 1];
+    if (recv->clockRate != clockRate) {
+        recv->clockRate = clockRate;
+        recv->jitter = 0;
+        recv->stats.jitter = 0;
+        /* The transit time of the next packet is the new baseline */
+        recv->hasTransit = false;
+    }
+    MutexUnlock(g_avdtMediaLock);
+    return AVDT_SUCCESS;
+}
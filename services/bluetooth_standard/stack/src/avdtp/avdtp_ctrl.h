@@ -56,4 +56,13 @@ extern void AvdtRegister(const AvdtRegisterParam *reg);
 extern uint16_t AvdtRegisterLocalSEP(AvdtStreamConfig *avdtStreamConfig, uint8_t number);
 extern void AvdtIsEdr2MbMode(const BtAddr *bdAddr);
 extern void AvdtIsEdr3MbMode(const BtAddr *bdAddr);
+extern void AvdtMediaInit(void);
+extern void AvdtMediaCleanup(void);
+extern void AvdtMediaSlotBind(uint16_t lcid, AvdtStreamCtrl *streamCtrl);
+extern void AvdtMediaSlotUnbind(const AvdtStreamCtrl *streamCtrl);
+extern AvdtMediaSlot *AvdtGetMediaSlotByLcid(uint16_t lcid);
+extern void AvdtMediaRecvUpdate(uint16_t handle, const AvdtRtpHeader *header);
+extern void AvdtMediaRecvMalformed(uint16_t handle);
+extern uint16_t AvdtGetMediaStats(uint16_t handle, AvdtMediaStats *stats);
+extern uint16_t AvdtSetMediaClockRate(uint16_t handle, uint32_t clockRate);
 #endif /* AVDTP_CTRL_H */
\ No newline at end of file
@@ -41,6 +41,28 @@
 #define AVDT_MEDIA_OCTET1 0x80      /* First octect */
 #define AVDT_BUFFER_MEDIA_HEADER 12 /* Header size */
 
+/**
+ * Media packet header fields, RFC 3550 5.1
+ */
+#define AVDT_RTP_VERSION 2
+#define AVDT_RTP_VERSION_OFFSET 6
+#define AVDT_RTP_PADDING_MASK 0x20
+#define AVDT_RTP_EXTENSION_MASK 0x10
+#define AVDT_RTP_CSRC_COUNT_MASK 0x0F
+#define AVDT_RTP_PAYLOAD_TYPE_OFFSET 1
+#define AVDT_RTP_PAYLOAD_TYPE_MASK 0x7F
+#define AVDT_RTP_SEQ_OFFSET 2
+#define AVDT_RTP_TIMESTAMP_OFFSET 4
+#define AVDT_RTP_SSRC_OFFSET 8
+#define AVDT_RTP_CSRC_SIZE 4
+#define AVDT_RTP_MAX_CSRC 15
+#define AVDT_RTP_EXTENSION_HEADER 4
+#define AVDT_RTP_MAX_HEADER \
+    (AVDT_BUFFER_MEDIA_HEADER + AVDT_RTP_MAX_CSRC * AVDT_RTP_CSRC_SIZE + AVDT_RTP_EXTENSION_HEADER)
+#define AVDT_RTP_MAX_DROPOUT 3000 /* Larger sequence jumps restart the sequence instead of counting losses */
+#define AVDT_RTP_MAX_MISORDER 100 /* Packets this far behind are late, further ones restart the sequence */
+#define AVDT_RTP_JITTER_SHIFT 4   /* Jitter is smoothed with a gain of 1/16 */
+
 /**
  * Transport table max size
  */
@@ -385,6 +407,37 @@ typedef struct {
     bool isUsed;           /* True if used by peer */
 } AvdtStreamCtrl;
 
+/**
+ * Fixed fields of a media packet header.
+ */
+typedef struct {
+    uint32_t timestamp;
+    uint32_t ssrc;
+    uint16_t seq;
+    uint8_t payloadType;
+} AvdtRtpHeader;
+
+/**
+ * Direct dispatch slot of an open media channel, keyed by lcid.
+ */
+typedef struct {
+    AvdtStreamCtrl *streamCtrl;          /* Stream carried by the channel, NULL if the slot is free */
+    AVDT_SinkDataCallback sinkDataCback; /* Sink data callback of the local SEP */
+    uint16_t lcid;
+} AvdtMediaSlot;
+
+/**
+ * Receive state of the media channel of a stream.
+ */
+typedef struct {
+    AvdtMediaStats stats;
+    uint32_t clockRate;   /* RTP clock rate, 0 if unknown */
+    uint32_t lastTransit; /* Relative transit time of the last packet in RTP clock units */
+    uint32_t jitter;      /* Interarrival jitter scaled by 1 << AVDT_RTP_JITTER_SHIFT */
+    bool isSynced;        /* True once the first packet of the stream is received */
+    bool hasTransit;      /* True if lastTransit is a baseline for the jitter */
+} AvdtMediaRecv;
+
 /**
  * AVDTP Channel Control Block.
  */
@@ -455,6 +508,8 @@ typedef struct {
     AvdtChannelHandle streamHandles[AVDT_MAX_NUM_SEP]; /* SEP handles */
     AvdtChannelHandle sigHandles[AVDT_NUM_LINKS];      /* Channel ctrl handles */
     AvdtStreamEndpoint localSEP[AVDT_NUM_SEPS];        /* Local stream endpoint */
+    AvdtMediaSlot mediaSlots[AVDT_CH_TABLE_SIZE];      /* Open media channels, probed from lcid */
+    AvdtMediaRecv mediaRecv[AVDT_MAX_NUM_SEP];         /* Media receive state, indexed by stream handle - 1 */
     bool avdtRegisted;
     bool sepRegisted;
 } AvdtCB;
@@ -461,6 +461,7 @@ void AvdtConfigComplete(AvdtTransChannel *transTable)
             }
             AvdtStreamCtrl *streamCtrl = AvdtGetStreamCtrlByHandle(transTable->streamHandle);
             if (streamCtrl != NULL) {
+                AvdtMediaSlotBind(transTable->lcid, streamCtrl);
                 AvdtStreamProcEvent(streamCtrl, AVDT_STREAM_OPEN_CMD_CFM_EVENT, NULL);
             }
             break;
@@ -699,6 +700,9 @@ void AvdtL2capDisconnectCfmCallback(uint16_t lcid, void *ctx)
  * @brief        AVDT_L2capReadDataIndCallback
  *
  * @details      Receive the l2cap indication to read data .
+ *               Packets of an open media channel are dispatched in place through its slot. The L2CAP and AVDTP
+ *               processing queues both run on the stack thread, so there is no thread to hop to, and the packet
+ *               is not referenced past this call.
  *
  * @param[in]    lcid:      L2CAP channel id
  *               packet:    data of signalling or media
@@ -708,7 +712,12 @@ void AvdtL2capDisconnectCfmCallback(uint16_t lcid, void *ctx)
  */
 void AVDT_L2capReadDataIndCallback(uint16_t lcid, Packet *packet, void *ctx)
 {
-    LOG_INFO("[AVDT]%{public}s:lcid(0x%x) ,PacketSize(%u)", __func__, lcid, PacketSize(packet));
+    AvdtMediaSlot *slot = AvdtGetMediaSlotByLcid(lcid);
+    if (slot != NULL) {
+        AvdtMediaDataProc(slot->streamCtrl, slot->sinkDataCback, packet);
+        return;
+    }
+    LOG_DEBUG("[AVDT]%{public}s:lcid(0x%x) ,PacketSize(%u)", __func__, lcid, PacketSize(packet));
     AvdtL2capReadDataIndCallbackTskParam *param = malloc(sizeof(AvdtL2capReadDataIndCallbackTskParam));
     if (param == NULL) {
         LOG_ERROR("[AVDT] %{public}s: memory malloc failed", __func__);
@@ -737,7 +746,7 @@ void AvdtL2capReadDataIndCallbackTsk(void *context)
 
 void AvdtL2capReadDataIndCallback(uint16_t lcid, Packet *packet, void *ctx)
 {
-    LOG_INFO("[AVDT]%{public}s:lcid(0x%x) ,PacketSize(%u)", __func__, lcid, PacketSize(packet));
+    LOG_DEBUG("[AVDT]%{public}s:lcid(0x%x) ,PacketSize(%u)", __func__, lcid, PacketSize(packet));
     AvdtTransChannel *transTable = AvdtGetTransChTabByLcid(lcid);
     if (transTable == NULL) {
         LOG_ERROR("[AVDT]%{public}s:AvdtGetTransChTabByLcid(0x%x) Failed!!", __func__, lcid);
@@ -791,26 +800,100 @@ void AvdtL2capReadDataIndCallback(uint16_t lcid, Packet *packet, void *ctx)
  */
 void AvdtStreamDataProc(AvdtStreamCtrl *streamCtrl, Packet *packet)
 {
-    uint8_t data = 0;
-    uint8_t ssrc[4] = {0};
-    PacketExtractHead(packet, &data, 1);
-    PacketExtractHead(packet, &data, 1);
-    uint8_t pktType = (data & 0xF7);
-    PacketExtractHead(packet, &data, 1);
-    PacketExtractHead(packet, &data, 1);
-    PacketExtractHead(packet, &data, 1);
-    uint32_t timeStamp = (data << AVDT_OFFSET_24BIT);
-    PacketExtractHead(packet, &data, 1);
-    timeStamp = (timeStamp | (data << AVDT_OFFSET_16BIT));
-    PacketExtractHead(packet, &data, 1);
-    timeStamp = (timeStamp | (data << AVDT_OFFSET_8BIT));
-    PacketExtractHead(packet, &data, 1);
-    timeStamp = (timeStamp | data);
-    /* extract ssrc data */
-    PacketExtractHead(packet, &ssrc[0], AVDT_4BYTE);
     AvdtStreamConfig *streamConfig = AvdtGetSepConfigByCodecIndex(streamCtrl->codecIndex);
-    if ((streamConfig != NULL) && (streamConfig->sinkDataCback != NULL)) {
-        streamConfig->sinkDataCback(streamCtrl->handle, packet, timeStamp, pktType, streamCtrl->codecIndex);
+    AvdtMediaDataProc(streamCtrl, (streamConfig != NULL) ? streamConfig->sinkDataCback : NULL, packet);
+}
+
+static uint16_t AvdtReadBe16(const uint8_t *data)
+{
+    return (uint16_t)((data[0] << AVDT_OFFSET_8BIT) | data[1]);
+}
+
+static uint32_t AvdtReadBe32(const uint8_t *data)
+{
+    return ((uint32_t)data[0] << AVDT_OFFSET_24BIT) | ((uint32_t)data[1] << AVDT_OFFSET_16BIT) |
+           ((uint32_t)data[AVDT_2BYTE] << AVDT_OFFSET_8BIT) | data[AVDT_2BYTE + 1];
+}
+
+/**
+ *
+ * @brief        AvdtParseRtpHeader
+ *
+ * @details      Decode the media packet header, CSRC list and header extension included.
+ *
+ * @param[in]    data:      leading bytes of the packet
+ *               length:    number of bytes in data
+ *               size:      size of the packet
+ * @param[out]   header:    fixed header fields
+ *
+ * @return       Size of the header; 0 if the packet is malformed.
+ *
+ */
+static uint32_t AvdtParseRtpHeader(const uint8_t *data, uint32_t length, uint32_t size, AvdtRtpHeader *header)
+{
+    if ((length < AVDT_BUFFER_MEDIA_HEADER) || ((data[0] >> AVDT_RTP_VERSION_OFFSET) != AVDT_RTP_VERSION)) {
+        return 0;
+    }
+    uint32_t offset = AVDT_BUFFER_MEDIA_HEADER + (data[0] & AVDT_RTP_CSRC_COUNT_MASK) * AVDT_RTP_CSRC_SIZE;
+    if (data[0] & AVDT_RTP_EXTENSION_MASK) {
+        if (length < offset + AVDT_RTP_EXTENSION_HEADER) {
+            return 0;
+        }
+        /* The extension header is a profile defined word followed by the extension length in 32-bit words */
+        offset += AVDT_RTP_EXTENSION_HEADER + AvdtReadBe16(data + offset + AVDT_2BYTE) * AVDT_4BYTE;
+    }
+    if (offset > size) {
+        return 0;
+    }
+    header->payloadType = data[AVDT_RTP_PAYLOAD_TYPE_OFFSET] & AVDT_RTP_PAYLOAD_TYPE_MASK;
+    header->seq = AvdtReadBe16(data + AVDT_RTP_SEQ_OFFSET);
+    header->timestamp = AvdtReadBe32(data + AVDT_RTP_TIMESTAMP_OFFSET);
+    header->ssrc = AvdtReadBe32(data + AVDT_RTP_SSRC_OFFSET);
+    return offset;
+}
+
+/**
+ *
+ * @brief        AvdtMediaDataProc
+ *
+ * @details      Strip the media packet header in one pass, account the packet in the receive statistics of the
+ *               stream and hand the payload to the sink. Nothing is allocated per packet.
+ *
+ * @param[in]    streamCtrl:       Stream Media channel control
+ *               sinkDataCback:    Sink data callback of the local SEP
+ *               packet:           data of media
+ *
+ * @return       void
+ *
+ */
+void AvdtMediaDataProc(const AvdtStreamCtrl *streamCtrl, AVDT_SinkDataCallback sinkDataCback, Packet *packet)
+{
+    uint8_t data[AVDT_RTP_MAX_HEADER];
+    uint32_t size = PacketPayloadSize(packet);
+    uint32_t length = PacketPayloadRead(packet, data, 0, (size < sizeof(data)) ? size : sizeof(data));
+    AvdtRtpHeader header = {0};
+    uint32_t offset = AvdtParseRtpHeader(data, length, size, &header);
+    uint8_t padding = 0;
+    if ((offset != 0) && (data[0] & AVDT_RTP_PADDING_MASK)) {
+        (void)PacketPayloadRead(packet, &padding, size - 1, AVDT_1BYTE);
+        if ((padding == 0) || (padding > size - offset)) {
+            offset = 0;
+        }
+    }
+    if (offset == 0) {
+        LOG_WARN("[AVDT]%{public}s: Malformed media packet, handle(%hu) size(%u)", __func__, streamCtrl->handle, size);
+        AvdtMediaRecvMalformed(streamCtrl->handle);
+        return;
+    }
+    AvdtMediaRecvUpdate(streamCtrl->handle, &header);
+
+    PacketDiscardHead(packet, offset);
+    if (padding != 0) {
+        uint8_t tail[UINT8_MAX];
+        PacketExtractTail(packet, tail, padding);
+    }
+    if (sinkDataCback != NULL) {
+        sinkDataCback(streamCtrl->handle, packet, header.timestamp, header.payloadType, streamCtrl->codecIndex);
     }
 }
 
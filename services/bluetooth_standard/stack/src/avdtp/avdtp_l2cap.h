@@ -121,6 +121,7 @@ void AvdtConnectConfirmError(const AvdtTransChannel *transTable);
 void AvdtConnectSignalingIndication(uint16_t lcid, uint8_t id, const L2capConnectionInfo *info);
 void AvdtConnectStreamIndication(uint16_t lcid, uint8_t id, const L2capConnectionInfo *info, AvdtSigCtrl *sigCtrl);
 void AvdtStreamDataProc(AvdtStreamCtrl *streamCtrl, Packet *packet);
+void AvdtMediaDataProc(const AvdtStreamCtrl *streamCtrl, AVDT_SinkDataCallback sinkDataCback, Packet *packet);
 void AvdtConfigComplete(AvdtTransChannel *transTable);
 void AvdtL2capDisconnectAbnormalSignle(const AvdtTransChannel *transTable, uint8_t reason);
 void AvdtL2capDisconnectAbnormalStream(const AvdtTransChannel *transTable, uint8_t reason);
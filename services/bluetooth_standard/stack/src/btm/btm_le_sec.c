@@ -15,6 +15,8 @@
 
 #include "btm_le_sec.h"
 
+#include <time.h>
+
 #include "hci/hci.h"
 #include "platform/include/allocator.h"
 #include "platform/include/list.h"
@@ -30,12 +32,34 @@
 
 #define IS_INITIALIZED() (g_status == STATUS_INITIALIZED)
 
+// Recently seen rpas, resolved or not. An rpa is rotated every 15 minutes by default, so an entry
+// is trusted for that long; every change of the paired devices flushes the cache.
+#define RPA_CACHE_SIZE 64
+#define RPA_CACHE_TIMEOUT_MS (15 * 60 * 1000)
+#define MS_PER_SECOND 1000
+#define NS_PER_MS 1000000
+
 typedef struct {
     BtmLePairedDevice pairedInfo;
     BtAddr currentAddr;
     bool inResolvingList;
 } BtmLePairedDeviceBlock;
 
+typedef struct {
+    BtAddr rpa;
+    BtmLePairedDeviceBlock *block;
+    uint64_t expireTime;
+    uint64_t lastUsed;
+} BtmRpaCacheEntry;
+
+typedef struct {
+    bool valid;
+    SMP_IrkIndex *irkIndex;
+    BtmLePairedDeviceBlock **blocks;
+    BtmRpaCacheEntry cache[RPA_CACHE_SIZE];
+    uint64_t useCounter;
+} BtmRpaResolver;
+
 static BtmKey g_localIdentityResolvingKey;
 static List *g_lePairedDevices = NULL;
 static Mutex *g_lePairedDevicesLock = NULL;
@@ -46,6 +70,8 @@ static uint8_t g_ownAddressType = OWN_ADDRESS_TYPE_PUBLIC;
 static BtAddr g_randomAddress;
 static Mutex *g_randomAddressLock = NULL;
 
+static BtmRpaResolver g_rpaResolver;
+
 static uint8_t g_status = STATUS_NONE;
 
 static BtmLePairedDeviceBlock *BtmAllocLePairedDeviceBlock(const BtmLePairedDevice *device)
@@ -197,6 +223,105 @@ static BtmLePairedDeviceBlock *BtmFindLePairedDeviceBlockByRemoteIdentityAddress
     return block;
 }
 
+static uint64_t BtmGetMonotonicTimeMs()
+{
+    struct timespec ts = {0};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * MS_PER_SECOND + (uint64_t)ts.tv_nsec / NS_PER_MS;
+}
+
+// Called with g_lePairedDevicesLock held whenever the paired devices change.
+static void BtmInvalidateRpaResolver()
+{
+    SMP_DestroyIrkIndex(g_rpaResolver.irkIndex);
+    g_rpaResolver.irkIndex = NULL;
+    MEM_MALLOC.free(g_rpaResolver.blocks);
+    g_rpaResolver.blocks = NULL;
+    (void)memset_s(g_rpaResolver.cache, sizeof(g_rpaResolver.cache), 0x00, sizeof(g_rpaResolver.cache));
+    g_rpaResolver.valid = false;
+}
+
+static void BtmBuildRpaResolver()
+{
+    uint16_t size = ListGetSize(g_lePairedDevices);
+    if (size == 0) {
+        g_rpaResolver.valid = true;
+        return;
+    }
+
+    uint16_t count = 0;
+    uint8_t *irks = MEM_MALLOC.alloc(size * KEY_SIZE);
+    BtmLePairedDeviceBlock **blocks = MEM_MALLOC.alloc(size * sizeof(BtmLePairedDeviceBlock *));
+    if (irks == NULL || blocks == NULL) {
+        MEM_MALLOC.free(irks);
+        MEM_MALLOC.free(blocks);
+        return;
+    }
+
+    const uint8_t zeroKey[KEY_SIZE] = {0};
+    ListNode *node = ListGetFirstNode(g_lePairedDevices);
+    while (node != NULL) {
+        BtmLePairedDeviceBlock *block = ListGetNodeData(node);
+        if (memcmp(block->pairedInfo.remoteIdentityResolvingKey.key, zeroKey, KEY_SIZE) != 0) {
+            (void)memcpy_s(
+                irks + count * KEY_SIZE, KEY_SIZE, block->pairedInfo.remoteIdentityResolvingKey.key, KEY_SIZE);
+            blocks[count] = block;
+            count++;
+        }
+        node = ListGetNextNode(node);
+    }
+
+    g_rpaResolver.irkIndex = SMP_CreateIrkIndex(irks, count);
+    (void)memset_s(irks, count * KEY_SIZE, 0x00, count * KEY_SIZE);
+    MEM_MALLOC.free(irks);
+    if (g_rpaResolver.irkIndex == NULL) {
+        MEM_MALLOC.free(blocks);
+        return;
+    }
+    g_rpaResolver.blocks = blocks;
+    g_rpaResolver.valid = true;
+}
+
+// Called with g_lePairedDevicesLock held. Returns the paired device resolving rpa, or NULL.
+static BtmLePairedDeviceBlock *BtmResolveRpa(const BtAddr *rpa)
+{
+    if (!g_rpaResolver.valid) {
+        BtmBuildRpaResolver();
+        if (!g_rpaResolver.valid) {
+            return NULL;
+        }
+    }
+
+    uint64_t now = BtmGetMonotonicTimeMs();
+    BtmRpaCacheEntry *victim = &g_rpaResolver.cache[0];
+    for (uint16_t i = 0; i < RPA_CACHE_SIZE; i++) {
+        BtmRpaCacheEntry *entry = &g_rpaResolver.cache[i];
+        if (entry->expireTime > now && IsSameBtAddr(&entry->rpa, rpa)) {
+            entry->lastUsed = ++g_rpaResolver.useCounter;
+            return entry->block;
+        }
+        if (entry->expireTime <= now) {
+            if (victim->expireTime > now) {
+                victim = entry;
+            }
+        } else if (victim->expireTime > now && entry->lastUsed < victim->lastUsed) {
+            victim = entry;
+        }
+    }
+
+    int position = SMP_ResolveRPAByIrkIndex(g_rpaResolver.irkIndex, rpa->addr);
+    victim->rpa = *rpa;
+    victim->block = (position >= 0) ? g_rpaResolver.blocks[position] : NULL;
+    victim->expireTime = now + RPA_CACHE_TIMEOUT_MS;
+    victim->lastUsed = ++g_rpaResolver.useCounter;
+    return victim->block;
+}
+
+static bool IsResolvablePrivateAddress(const BtAddr *addr)
+{
+    return (addr->type == BT_RANDOM_DEVICE_ADDRESS) && ((addr->addr[BT_ADDRESS_SIZE - 1] & 0xC0) == 0x40);
+}
+
 void BtmInitLeSecurity()
 {
     g_lePairedDevices = ListCreate(BtmFreeLePairedDeviceBlock);
@@ -215,6 +340,7 @@ void BtmCloseLeSecurity()
     g_status = STATUS_NONE;
 
     if (g_lePairedDevices != NULL) {
+        BtmInvalidateRpaResolver();
         ListDelete(g_lePairedDevices);
         g_lePairedDevices = NULL;
     }
@@ -255,6 +381,7 @@ void BtmStartLeSecurity()
 void BtmStopLeSecurity()
 {
     MutexLock(g_lePairedDevicesLock);
+    BtmInvalidateRpaResolver();
     ListClear(g_lePairedDevices);
     MutexUnlock(g_lePairedDevicesLock);
 }
@@ -269,6 +396,7 @@ void BTM_SetLePairedDevices(const BtmLePairedDevice *pairedDevices, uint16_t cou
 
     BtmStopAutoConnection();
 
+    BtmInvalidateRpaResolver();
     ListClear(g_lePairedDevices);
 
     if (BTM_IsControllerSupportLlPrivacy()) {
@@ -328,6 +456,7 @@ void BTM_AddLePairedDevice(const BtmLePairedDevice *device)
         return;
     }
     ListAddLast(g_lePairedDevices, block);
+    BtmInvalidateRpaResolver();
 
     bool addToResolvingList = false;
     if (IsZeroAddress(block->pairedInfo.remoteIdentityAddress.addr)) {
@@ -381,6 +510,7 @@ void BTM_RemoveLePairedDevice(const BtAddr *addr)
             BtmRemoveFromResolvingList(&block->pairedInfo);
             g_deviceCountInResolvingList--;
         }
+        BtmInvalidateRpaResolver();
         ListRemoveNode(g_lePairedDevices, block);
     }
 
@@ -690,14 +820,43 @@ int BTM_ConvertToPairedAddress(const BtAddr *addr, BtAddr *pairedAddress)
             *pairedAddress = block->pairedInfo.addr;
             result = BT_NO_ERROR;
             break;
-        } else if (SMP_ResolveRPA(addr->addr, block->pairedInfo.remoteIdentityResolvingKey.key) ==
-                   SMP_RESOLVE_RPA_RESULT_YES) {
+        }
+
+        node = ListGetNextNode(node);
+    }
+
+    if (result != BT_NO_ERROR && IsResolvablePrivateAddress(addr)) {
+        block = BtmResolveRpa(addr);
+        if (block != NULL) {
             *pairedAddress = block->pairedInfo.addr;
             result = BT_NO_ERROR;
-            break;
         }
+    }
 
-        node = ListGetNextNode(node);
+    MutexUnlock(g_lePairedDevicesLock);
+
+    return result;
+}
+
+int BTM_ResolveRemoteRpa(const BtAddr *rpa, BtAddr *pairedAddress)
+{
+    if (rpa == NULL || pairedAddress == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    if (!IS_INITIALIZED()) {
+        return BT_BAD_STATUS;
+    }
+
+    int result = BT_BAD_STATUS;
+
+    MutexLock(g_lePairedDevicesLock);
+
+    BtmLePairedDeviceBlock *block = BtmResolveRpa(rpa);
+    if (block != NULL) {
+        block->currentAddr = *rpa;
+        *pairedAddress = block->pairedInfo.addr;
+        result = BT_NO_ERROR;
     }
 
     MutexUnlock(g_lePairedDevicesLock);
@@ -45,6 +45,10 @@ bool BTM_IsDeviceInResolvingList(const BtAddr *addr);
 
 int BTM_ConvertToPairedAddress(const BtAddr *addr, BtAddr *pairedAddress);
 
+// Resolves rpa on the host against every paired irk in one pass and makes it the current address of
+// the resolved device. Results are cached per rpa for one rpa rotation period.
+int BTM_ResolveRemoteRpa(const BtAddr *rpa, BtAddr *pairedAddress);
+
 void BtmInitLeSecurity();
 void BtmCloseLeSecurity();
 void BtmStartLeSecurity();
@@ -21,18 +21,13 @@
 #include "platform/include/allocator.h"
 #include "platform/include/list.h"
 #include "platform/include/mutex.h"
-#include "platform/include/queue.h"
 #include "platform/include/semaphore.h"
+#include "platform/include/task_queue.h"
 #include "platform/include/thread.h"
 
-typedef struct {
-    void (*task)(void *context);
-    void *context;
-} BtmTask;
-
 typedef struct {
     uint8_t id;
-    Queue *queue;
+    TaskQueue *queue;
     ReactorItem *reactorItem;
 } BtmProcessingQueue;
 
@@ -40,47 +35,23 @@ static Thread *g_processingThread = NULL;
 static List *g_processingQueueList = NULL;
 static Mutex *g_processingQueueLock = NULL;
 
-static BtmTask *AllocTask(void (*task)(void *context), void *context)
-{
-    BtmTask *block = MEM_MALLOC.alloc(sizeof(BtmTask));
-    if (block != NULL) {
-        block->task = task;
-        block->context = context;
-    }
-    return block;
-}
-
-static void FreeTask(void *task)
-{
-    MEM_MALLOC.free(task);
-}
-
-static void RunTask(void *context)
-{
-    BtmTask *task = QueueTryDequeue((Queue *)context);
-    if (task != NULL) {
-        task->task(task->context);
-
-        FreeTask(task);
-    }
-}
-
 static BtmProcessingQueue *AllocProcessingQueue(uint8_t id, uint32_t size)
 {
     BtmProcessingQueue *block = MEM_MALLOC.alloc(sizeof(BtmProcessingQueue));
     if (block != NULL) {
         block->id = id;
-        block->queue = QueueCreate(size);
+        block->queue = TaskQueueCreate(size);
         if (block->queue != NULL) {
             Reactor *reactor = ThreadGetReactor(g_processingThread);
-            block->reactorItem = ReactorRegister(reactor, QueueGetDequeueFd(block->queue), block->queue, RunTask, NULL);
+            block->reactorItem =
+                ReactorRegister(reactor, TaskQueueGetFd(block->queue), block->queue, TaskQueueOnReadReady, NULL);
         }
     }
     return block;
 }
 
 typedef struct {
-    Queue *queue;
+    TaskQueue *queue;
     Semaphore *semaphore;
 } RunAllTaskContext;
 
@@ -88,21 +59,17 @@ static void RunAllTaskInQueueTask(void *param)
 {
     RunAllTaskContext *context = (RunAllTaskContext *)param;
 
-    BtmTask *task = QueueTryDequeue(context->queue);
-    while (task != NULL) {
-        task->task(task->context);
-
-        FreeTask(task);
-
-        task = QueueTryDequeue(context->queue);
-    }
+    uint32_t count;
+    do {
+        count = TaskQueueRun(context->queue, TASK_QUEUE_RUN_BATCH);
+    } while (count > 0);
 
     if (context->semaphore != NULL) {
         SemaphorePost(context->semaphore);
     }
 }
 
-static void RunAllTaskInQueue(Queue *queue)
+static void RunAllTaskInQueue(TaskQueue *queue)
 {
     RunAllTaskContext context = {
         .queue = queue,
@@ -127,7 +94,7 @@ static void FreeProcessingQueue(void *queue)
         block->reactorItem = NULL;
     }
     if (block->queue != NULL) {
-        QueueDelete(block->queue, FreeTask);
+        TaskQueueDelete(block->queue);
         block->queue = NULL;
     }
     MEM_MALLOC.free(queue);
@@ -203,7 +170,7 @@ int BTM_DeleteProcessingQueue(uint8_t queueId)
 {
     int result = BT_NO_ERROR;
 
-    Queue *taskQueue = NULL;
+    TaskQueue *taskQueue = NULL;
 
     MutexLock(g_processingQueueLock);
     BtmProcessingQueue *queue = FindProcessingQueueById(queueId);
@@ -218,7 +185,7 @@ int BTM_DeleteProcessingQueue(uint8_t queueId)
 
     if (taskQueue != NULL) {
         RunAllTaskInQueue(taskQueue);
-        QueueDelete(taskQueue, FreeTask);
+        TaskQueueDelete(taskQueue);
         taskQueue = NULL;
     }
 
@@ -231,12 +198,7 @@ int BTM_RunTaskInProcessingQueue(uint8_t queueId, void (*task)(void *context), v
     MutexLock(g_processingQueueLock);
     BtmProcessingQueue *queue = FindProcessingQueueById(queueId);
     if (queue != NULL) {
-        BtmTask *block = AllocTask(task, context);
-        if (task != NULL) {
-            QueueEnqueue(queue->queue, block);
-        } else {
-            result = BT_NO_MEMORY;
-        }
+        TaskQueuePost(queue->queue, task, context);
     } else {
         result = BT_BAD_STATUS;
     }
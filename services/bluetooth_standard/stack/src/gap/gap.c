@@ -75,7 +75,6 @@ static void GapInitializeTask(void *ctx)
 #ifdef GAP_LE_SUPPORT
     g_gapMng.le.connectionInfoBlock.deviceList = ListCreate(GapFreeLeDeviceInfo);
     g_gapMng.le.signatureBlock.RequestList = ListCreate(GapFreeLeSignatureRequest);
-    g_gapMng.le.randomAddressBlock.reportRPAResolveList = ListCreate(GapFreeReportRPAResolveInfo);
     g_gapMng.le.exAdvBlock.exAdvInfoList = ListCreate(GapFreeListNode);
 #endif
 }
@@ -195,7 +194,6 @@ static void GapDisableTask(void *ctx)
         GapDeregisterSmCallbacks();
         ListClear(g_gapMng.le.connectionInfoBlock.deviceList);
         ListClear(g_gapMng.le.signatureBlock.RequestList);
-        ListClear(g_gapMng.le.randomAddressBlock.reportRPAResolveList);
         ListClear(g_gapMng.le.exAdvBlock.exAdvInfoList);
         g_gapMng.le.bondBlock.isPairing = false;
         g_gapMng.le.randomAddressBlock.generationInfo.processing = false;
@@ -225,7 +223,6 @@ static void GapFinalizeTask(void *ctx)
 #ifdef GAP_LE_SUPPORT
     ListDelete(g_gapMng.le.connectionInfoBlock.deviceList);
     ListDelete(g_gapMng.le.signatureBlock.RequestList);
-    ListDelete(g_gapMng.le.randomAddressBlock.reportRPAResolveList);
     ListDelete(g_gapMng.le.exAdvBlock.exAdvInfoList);
 #endif
 
@@ -324,8 +324,6 @@ typedef struct {
         GenResPriAddrResult callback;
         void *context;
     } generationInfo;
-
-    List *reportRPAResolveList;
 } LeRandomAddressBlock;
 
 typedef struct {
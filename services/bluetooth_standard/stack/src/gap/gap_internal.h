@@ -133,7 +133,6 @@ bool GapIsLeEnable(void);
 bool GapLeRolesCheck(uint8_t role);
 void GapFreeLeDeviceInfo(void *data);
 void GapFreeLeSignatureRequest(void *data);
-void GapFreeReportRPAResolveInfo(void *data);
 LeBondBlock *GapGetLeBondBlock(void);
 LeConnectionInfoBlock *GapGetLeConnectionInfoBlock(void);
 LeSignatureBlock *GapGetLeSignatureBlock(void);
@@ -175,7 +174,6 @@ void GapOnLeScanTimeoutEvent(const void *eventParam);
 void GapLeSetExtendedScanParametersComplete(const HciLeSetExtendedScanParametersReturnParam *param);
 void GapLeSetExtendedScanEnableComplete(const HciLeSetExtendedScanEnableReturnParam *param);
 void GapGenerateRPAResult(uint8_t status, const uint8_t *addr);
-void GapResolveRPAResult(uint8_t status, bool result, const uint8_t *addr, const uint8_t *irk);
 
 int GapLeRequestSecurityProcess(LeDeviceInfo *deviceInfo);
 void GapLeDoPair(const void *addr);
@@ -28,23 +28,6 @@
 #include "hci/hci_error.h"
 #include "smp/smp.h"
 
-typedef enum {
-    ADV_REPORT,
-    EXTENDED_ADV_REPORT,
-    DIRECTED_ADV_REPORT,
-} AdvReportType;
-
-typedef struct {
-    AdvReportType reportType;
-    void *report;
-    bool processing;
-    BtmIdentityResolvingKey *IRKList;
-    uint16_t listCount;
-    uint16_t resolveIndex;
-    BtAddr addr;
-    bool doCallback;
-} AdvReportRPAResolveInfo;
-
 typedef struct {
     GapScanCallback callback;
     void *context;
@@ -58,29 +41,6 @@ typedef struct {
 static LeScanCallback g_leScanCallback;
 static LeExScanCallback g_leExScanCallback;
 
-void GapFreeReportRPAResolveInfo(void *data)
-{
-    AdvReportRPAResolveInfo *info = data;
-    switch (info->reportType) {
-        case ADV_REPORT: {
-            HciLeAdvertisingReport *report = info->report;
-            MEM_MALLOC.free(report->data);
-            break;
-        }
-        case EXTENDED_ADV_REPORT: {
-            HciLeExtendedAdvertisingReport *report = info->report;
-            MEM_MALLOC.free(report->data);
-            break;
-        }
-        case DIRECTED_ADV_REPORT:
-        default:
-            break;
-    }
-    MEM_MALLOC.free(info->report);
-    MEM_MALLOC.free(info->IRKList);
-    MEM_MALLOC.free(info);
-}
-
 int GAP_RegisterScanCallback(const GapScanCallback *callback, void *context)
 {
     LOG_INFO("%{public}s:%{public}s", __FUNCTION__, callback ? "register" : "NULL");
@@ -148,231 +108,6 @@ static void GapLeSetExAdvReportParam(GapExAdvReportParam *advParam, const HciLeE
     }
 }
 
-static void GapCallbackRPAAdvertisingReport(const AdvReportRPAResolveInfo *info, const BtAddr *currentAddr)
-{
-    if (info == NULL) {
-        LOG_WARN("%{public}s: miss info", __FUNCTION__);
-        return;
-    }
-
-    HciLeAdvertisingReport *report = info->report;
-    if (report == NULL || (report->lengthData != 0 && report->data == NULL)) {
-        LOG_WARN("%{public}s: miss report or data", __FUNCTION__);
-        return;
-    }
-    LOG_INFO("%{public}s:" BT_ADDR_FMT " -> " BT_ADDR_FMT,
-        __FUNCTION__,
-        BT_ADDR_FMT_OUTPUT(report->address.raw),
-        BT_ADDR_FMT_OUTPUT(info->addr.addr));
-    if (g_leScanCallback.callback.advertisingReport) {
-        GapAdvReportParam reportParam = {
-            .dataLen = report->lengthData,
-            .data = report->data,
-            .rssi = report->rssi,
-        };
-        g_leScanCallback.callback.advertisingReport(
-            report->eventType, &info->addr, reportParam, currentAddr, g_leScanCallback.context);
-    }
-}
-
-static void GapCallbackRPAExtendedAdvertisingReport(const AdvReportRPAResolveInfo *info, const BtAddr *currentAddr)
-{
-    if (info == NULL) {
-        LOG_WARN("%{public}s: miss info.", __FUNCTION__);
-        return;
-    }
-
-    HciLeExtendedAdvertisingReport *report = info->report;
-    GapExAdvReportParam advParam;
-    BtAddr directAddr;
-
-    if (report == NULL || ((report->dataLength != 0) && (report->data == NULL))) {
-        LOG_WARN("%{public}s: miss report or data", __FUNCTION__);
-        return;
-    }
-
-    GapLeSetExAdvReportParam(&advParam, report);
-    advParam.directAddr = &directAddr;
-    GapChangeHCIAddr(&directAddr, &report->directAddress, report->directAddressType);
-
-    LOG_INFO("%{public}s:" BT_ADDR_FMT " -> " BT_ADDR_FMT,
-        __FUNCTION__,
-        BT_ADDR_FMT_OUTPUT(report->address.raw),
-        BT_ADDR_FMT_OUTPUT(info->addr.addr));
-    if (g_leExScanCallback.callback.exAdvertisingReport) {
-        g_leExScanCallback.callback.exAdvertisingReport(
-            report->eventType, &info->addr, advParam, currentAddr, g_leExScanCallback.context);
-    }
-}
-
-static void GapCallbackRPADirectedAdvertisingReport(const AdvReportRPAResolveInfo *info, const BtAddr *currentAddr)
-{
-    if (info == NULL || info->report == NULL) {
-        LOG_WARN("%{public}s: miss info or report", __FUNCTION__);
-        return;
-    }
-
-    HciLeDirectedAdvertisingReport *report = info->report;
-    BtAddr directAddr;
-    GapChangeHCIAddr(&directAddr, &report->directAddress, report->directAddressType);
-    LOG_INFO("%{public}s:" BT_ADDR_FMT " -> " BT_ADDR_FMT,
-        __FUNCTION__,
-        BT_ADDR_FMT_OUTPUT(report->address.raw),
-        BT_ADDR_FMT_OUTPUT(info->addr.addr));
-    if (g_leExScanCallback.callback.directedAdvertisingReport) {
-        GapDirectedAdvReportParam reportParam = {
-            .directAddr = &directAddr,
-            .rssi = report->rssi,
-        };
-        g_leExScanCallback.callback.directedAdvertisingReport(
-            report->eventType, &info->addr, reportParam, currentAddr, g_leExScanCallback.context);
-    }
-}
-
-void GapDoCallbackRPAAdvertisingReport(void *data, const BtAddr *currentAddr)
-{
-    AdvReportRPAResolveInfo *info = data;
-    switch (info->reportType) {
-        case ADV_REPORT: {
-            GapCallbackRPAAdvertisingReport(info, currentAddr);
-            break;
-        }
-        case EXTENDED_ADV_REPORT: {
-            GapCallbackRPAExtendedAdvertisingReport(info, currentAddr);
-            break;
-        }
-        case DIRECTED_ADV_REPORT: {
-            GapCallbackRPADirectedAdvertisingReport(info, currentAddr);
-            break;
-        }
-        default:
-            break;
-    }
-    ListRemoveNode(GapGetLeRandomAddressBlock()->reportRPAResolveList, data);
-}
-
-void GapRPAResolveProcess(void)
-{
-    int ret;
-
-    ListNode *node = ListGetFirstNode(GapGetLeRandomAddressBlock()->reportRPAResolveList);
-    while (node != 0) {
-        AdvReportRPAResolveInfo *info = ListGetNodeData(node);
-
-        if (info->processing) {
-            break;
-        }
-
-        if (!info->doCallback) {
-            LOG_DEBUG("%{public}s: " BT_ADDR_FMT " start resolve RPA", __FUNCTION__, BT_ADDR_FMT_OUTPUT(info->addr.addr));
-
-            uint8_t addr[BT_ADDRESS_SIZE];
-            (void)memcpy_s(addr, BT_ADDRESS_SIZE, info->addr.addr, BT_ADDRESS_SIZE);
-            const uint8_t *addrPtr = addr;
-            const uint8_t *keyPtr = info->IRKList[info->resolveIndex].irk.key;
-            ret = SMP_AsyncResolveRPA(addrPtr, keyPtr);
-            if (ret != BT_NO_ERROR) {
-                info->doCallback = true;
-                GapDoCallbackRPAAdvertisingReport(info, NULL);
-            } else {
-                info->processing = true;
-            }
-            break;
-        }
-        node = ListGetNextNode(node);
-    }
-}
-
-void GapResolveRPAResult(uint8_t status, bool result, const uint8_t *addr, const uint8_t *irk)
-{
-    LOG_INFO("%{public}s: status:%02x, result:%02x", __FUNCTION__, status, result);
-    ListNode *node = ListGetFirstNode(GapGetLeRandomAddressBlock()->reportRPAResolveList);
-    while (node != 0) {
-        AdvReportRPAResolveInfo *info = ListGetNodeData(node);
-        BtAddr currentAddr = info->addr;
-        node = ListGetNextNode(node);
-        if (!info->processing) {
-            continue;
-        }
-
-        info->processing = false;
-        if (status == SMP_PAIR_STATUS_SUCCESS && result == true) {
-            if (memcmp(info->IRKList[info->resolveIndex].irk.key, irk, GAP_IRK_SIZE)) {
-                LOG_ERROR("%{public}s: IRK mismatch", __FUNCTION__);
-            } else {
-                BTM_UpdateCurrentRemoteAddress(&info->IRKList[info->resolveIndex].addr, &info->addr);
-                (void)memcpy_s(&info->addr, sizeof(BtAddr), &info->IRKList[info->resolveIndex].addr, sizeof(BtAddr));
-            }
-            info->doCallback = true;
-        } else {
-            info->resolveIndex++;
-            if (info->resolveIndex == info->listCount) {
-                info->doCallback = true;
-            }
-        }
-        if (info->doCallback) {
-            GapDoCallbackRPAAdvertisingReport(info, result ? &currentAddr : NULL);
-        }
-        break;
-    }
-
-    GapRPAResolveProcess();
-}
-
-static AdvReportRPAResolveInfo *GapLeAllocAdvReportRPAResolveInfo(
-    BtAddr addr, AdvReportType type, const void *advReport)
-{
-    AdvReportRPAResolveInfo *info = MEM_MALLOC.alloc(sizeof(AdvReportRPAResolveInfo));
-    void *report = NULL;
-    uint8_t *advData = NULL;
-
-    if (type == ADV_REPORT) {
-        advData = MEM_MALLOC.alloc(((const HciLeAdvertisingReport *)advReport)->lengthData);
-        if (advData != NULL) {
-            (void)memcpy_s(advData,
-                ((const HciLeAdvertisingReport *)advReport)->lengthData,
-                ((const HciLeAdvertisingReport *)advReport)->data,
-                ((const HciLeAdvertisingReport *)advReport)->lengthData);
-        }
-        report = MEM_MALLOC.alloc(sizeof(HciLeAdvertisingReport));
-        if (report != NULL) {
-            (void)memcpy_s(report, sizeof(HciLeAdvertisingReport), advReport, sizeof(HciLeAdvertisingReport));
-            ((HciLeAdvertisingReport *)report)->data = advData;
-        }
-    } else if (type == EXTENDED_ADV_REPORT) {
-        advData = MEM_MALLOC.alloc(((const HciLeExtendedAdvertisingReport *)advReport)->dataLength);
-        if (advData != NULL) {
-            (void)memcpy_s(advData,
-                ((const HciLeExtendedAdvertisingReport *)advReport)->dataLength,
-                ((const HciLeExtendedAdvertisingReport *)advReport)->data,
-                ((const HciLeExtendedAdvertisingReport *)advReport)->dataLength);
-        }
-        report = MEM_MALLOC.alloc(sizeof(HciLeExtendedAdvertisingReport));
-        if (report != NULL) {
-            (void)memcpy_s(
-                report, sizeof(HciLeExtendedAdvertisingReport), advReport, sizeof(HciLeExtendedAdvertisingReport));
-            ((HciLeExtendedAdvertisingReport *)report)->data = advData;
-        }
-    } else if (type == DIRECTED_ADV_REPORT) {
-        report = MEM_MALLOC.alloc(sizeof(HciLeDirectedAdvertisingReport));
-        if (report != NULL) {
-            (void)memcpy_s(
-                report, sizeof(HciLeDirectedAdvertisingReport), advReport, sizeof(HciLeDirectedAdvertisingReport));
-        }
-    }
-
-    if (info != NULL) {
-        info->report = report;
-        info->reportType = type;
-        info->resolveIndex = 0;
-        info->processing = false;
-        info->doCallback = false;
-        (void)memcpy_s(&info->addr, sizeof(BtAddr), &addr, sizeof(BtAddr));
-    }
-
-    return info;
-}
-
 static bool GapTryChangeAddressForIdentityAddress(BtAddr *addr)
 {
     BtAddr pairedAddr = {0};
@@ -398,22 +133,12 @@ static void GapOnLeAdvertisingReportEventProcessOnce(const HciLeAdvertisingRepor
     uint8_t dataLen = report->lengthData;
     uint8_t *data = report->data;
 
+    const BtAddr *resolvedAddr = NULL;
     if (GapAddrIsResolvablePrivateAddress(&addr)) {
-        BtmIdentityResolvingKey *deviceIRKList = NULL;
-        uint16_t listCount = 0;
-        int ret = BTM_GetAllRemoteIdentityResolvingKey(&deviceIRKList, &listCount);
-        if (ret == BT_NO_ERROR && listCount != 0) {
-            AdvReportRPAResolveInfo *info = GapLeAllocAdvReportRPAResolveInfo(addr, ADV_REPORT, report);
-            if (info != NULL) {
-                info->IRKList = deviceIRKList;
-                info->listCount = listCount;
-                ListAddLast(GapGetLeRandomAddressBlock()->reportRPAResolveList, info);
-                GapRPAResolveProcess();
-                return;
-            }
-        }
-        if (deviceIRKList != NULL) {
-            MEM_MALLOC.free(deviceIRKList);
+        BtAddr pairedAddr;
+        if (BTM_ResolveRemoteRpa(&addr, &pairedAddr) == BT_NO_ERROR) {
+            addr = pairedAddr;
+            resolvedAddr = &currentAddr;
         }
     } else if (GapAddrIsIdentityAddress(&addr)) {
         GapTryChangeAddressForIdentityAddress(&addr);
@@ -430,7 +155,8 @@ static void GapOnLeAdvertisingReportEventProcessOnce(const HciLeAdvertisingRepor
             .data = data,
             .rssi = rssi,
         };
-        g_leScanCallback.callback.advertisingReport(advType, &addr, reportParam, NULL, g_leScanCallback.context);
+        g_leScanCallback.callback.advertisingReport(
+            advType, &addr, reportParam, resolvedAddr, g_leScanCallback.context);
     }
 }
 
@@ -505,22 +231,12 @@ static void GapOnLeExtendedAdvertisingReportEventProcessOnce(const HciLeExtended
     GapChangeHCIAddr(&directAddr, &report->directAddress, report->directAddressType);
     advParam.directAddr = &directAddr;
 
+    const BtAddr *resolvedAddr = NULL;
     if (GapAddrIsResolvablePrivateAddress(&addr)) {
-        BtmIdentityResolvingKey *deviceIRKList = NULL;
-        uint16_t listCount = 0;
-        int ret = BTM_GetAllRemoteIdentityResolvingKey(&deviceIRKList, &listCount);
-        if (ret == BT_NO_ERROR && listCount != 0) {
-            AdvReportRPAResolveInfo *info = GapLeAllocAdvReportRPAResolveInfo(addr, EXTENDED_ADV_REPORT, report);
-            if (info != NULL) {
-                info->IRKList = deviceIRKList;
-                info->listCount = listCount;
-                ListAddLast(GapGetLeRandomAddressBlock()->reportRPAResolveList, info);
-                GapRPAResolveProcess();
-                return;
-            }
-        }
-        if (deviceIRKList != NULL) {
-            MEM_MALLOC.free(deviceIRKList);
+        BtAddr pairedAddr;
+        if (BTM_ResolveRemoteRpa(&addr, &pairedAddr) == BT_NO_ERROR) {
+            addr = pairedAddr;
+            resolvedAddr = &currentAddr;
         }
     } else if (GapAddrIsIdentityAddress(&addr)) {
         GapTryChangeAddressForIdentityAddress(&addr);
@@ -532,7 +248,8 @@ static void GapOnLeExtendedAdvertisingReportEventProcessOnce(const HciLeExtended
 
     LOG_INFO("%{public}s:" BT_ADDR_FMT " type=%hhu", __FUNCTION__, BT_ADDR_FMT_OUTPUT(addr.addr), addr.type);
     if (g_leExScanCallback.callback.exAdvertisingReport) {
-        g_leExScanCallback.callback.exAdvertisingReport(advType, &addr, advParam, NULL, g_leExScanCallback.context);
+        g_leExScanCallback.callback.exAdvertisingReport(
+            advType, &addr, advParam, resolvedAddr, g_leExScanCallback.context);
     }
 }
 
@@ -553,22 +270,12 @@ static void GapOnLeDirectedAdvertisingReportProcessOnce(const HciLeDirectedAdver
     GapChangeHCIAddr(&directAddr, &report->directAddress, report->directAddressType);
     int8_t rssi = report->rssi;
 
+    const BtAddr *resolvedAddr = NULL;
     if (GapAddrIsResolvablePrivateAddress(&addr)) {
-        BtmIdentityResolvingKey *deviceIRKList = NULL;
-        uint16_t listCount = 0;
-        int ret = BTM_GetAllRemoteIdentityResolvingKey(&deviceIRKList, &listCount);
-        if (ret == BT_NO_ERROR && listCount != 0) {
-            AdvReportRPAResolveInfo *info = GapLeAllocAdvReportRPAResolveInfo(addr, DIRECTED_ADV_REPORT, report);
-            if (info != NULL) {
-                info->IRKList = deviceIRKList;
-                info->listCount = listCount;
-                ListAddLast(GapGetLeRandomAddressBlock()->reportRPAResolveList, info);
-                GapRPAResolveProcess();
-                return;
-            }
-        }
-        if (deviceIRKList != NULL) {
-            MEM_MALLOC.free(deviceIRKList);
+        BtAddr pairedAddr;
+        if (BTM_ResolveRemoteRpa(&addr, &pairedAddr) == BT_NO_ERROR) {
+            addr = pairedAddr;
+            resolvedAddr = &currentAddr;
         }
     } else if (GapAddrIsIdentityAddress(&addr)) {
         GapTryChangeAddressForIdentityAddress(&addr);
@@ -585,7 +292,7 @@ static void GapOnLeDirectedAdvertisingReportProcessOnce(const HciLeDirectedAdver
             .rssi = rssi,
         };
         g_leExScanCallback.callback.directedAdvertisingReport(
-            advType, &addr, reportParam, NULL, g_leExScanCallback.context);
+            advType, &addr, reportParam, resolvedAddr, g_leExScanCallback.context);
     }
 }
 
@@ -66,13 +66,6 @@ typedef struct {
     uint8_t *addr;
 } GapGenerateRPAResultParam;
 
-typedef struct {
-    uint8_t status;
-    bool result;
-    uint8_t addr[BT_ADDRESS_SIZE];
-    uint8_t irk[GAP_IRK_SIZE];
-} GapResolveRPAResultParam;
-
 static void GapLeAuthenticationRequestTask(void *ctx)
 {
     GapLeAuthenticationRequestParam *param = ctx;
@@ -374,32 +367,6 @@ static void GapRecvGenerateRPAResult(uint8_t status, const uint8_t *addr)
     }
 }
 
-static void GapResolveRPAResultTask(void *ctx)
-{
-    GapResolveRPAResultParam *param = ctx;
-    GapResolveRPAResult(param->status, param->result, param->addr, param->irk);
-}
-
-static void GapRecvResolveRPAResult(uint8_t status, bool result, const uint8_t *addr, const uint8_t *irk)
-{
-    LOG_INFO("%{public}s: status:%hhu result:%{public}d", __FUNCTION__, status, result);
-    GapResolveRPAResultParam *smParam = MEM_MALLOC.alloc(sizeof(GapResolveRPAResultParam));
-    if (smParam == NULL) {
-        LOG_ERROR("%{public}s: Alloc error.", __FUNCTION__);
-        return;
-    }
-
-    smParam->status = status;
-    smParam->result = result;
-    (void)memcpy_s(smParam->addr, BT_ADDRESS_SIZE, addr, BT_ADDRESS_SIZE);
-    (void)memcpy_s(smParam->irk, GAP_IRK_SIZE, irk, GAP_IRK_SIZE);
-
-    int ret = GapRunTaskUnBlockProcess(GapResolveRPAResultTask, smParam, NULL);
-    if (ret != BT_NO_ERROR) {
-        LOG_ERROR("%{public}s: Task error:%{public}d.", __FUNCTION__, ret);
-    }
-}
-
 static SMP_Callback_t g_smCallback = {
     .SMP_CallbackAuthenticationRequest = GapRecvLeAuthenticationRequest,
     .SMP_CallbackPairResult = GapRecvLePairResult,
@@ -409,7 +376,6 @@ static SMP_Callback_t g_smCallback = {
     .SMP_CallbackLongTermKeyRequest = GapRecvLeLongTermKeyRequest,
     .SMP_CallbackGenerateSignatureResult = GapRecvLeGenerateSignatureResult,
     .SMP_CallbackGenerateRPAResult = GapRecvGenerateRPAResult,
-    .SMP_CallbackResolveRPAResult = GapRecvResolveRPAResult,
 };
 
 void GapRegisterSmCallbacks(void)
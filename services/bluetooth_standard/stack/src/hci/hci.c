@@ -15,6 +15,9 @@
 
 #include "hci.h"
 
+#include <securec.h>
+#include <stdatomic.h>
+
 #include "btm/btm_thread.h"
 #include "btstack.h"
 #include "log.h"
@@ -25,6 +28,7 @@
 #include "platform/include/queue.h"
 #include "platform/include/reactor.h"
 #include "platform/include/semaphore.h"
+#include "platform/include/task_queue.h"
 #include "platform/include/thread.h"
 
 #include "acl/hci_acl.h"
@@ -36,12 +40,22 @@
 #include "hci_internal.h"
 
 #define HCI_TX_QUEUE_SIZE INT32_MAX
-#define HCI_RX_QUEUE_SIZE INT32_MAX
+#define HCI_RX_QUEUE_SIZE 4096
+// Slots of the receive queue only events may take, data beyond HCI_RX_DATA_LIMIT pending packets is dropped.
+#define HCI_RX_EVENT_RESERVE 1024
+#define HCI_RX_DATA_LIMIT (HCI_RX_QUEUE_SIZE - HCI_RX_EVENT_RESERVE)
+#define HCI_TX_MAX_SEGMENTS 16
 
 static BtHciCallbacks g_hdiCallacks;
 
 static Queue *g_hciTxQueue = NULL;
-static Queue *g_hciRxQueue = NULL;
+// Received packets are posted as tasks: no list node or semaphore syscalls per packet.
+static TaskQueue *g_hciRxQueue = NULL;
+static bool g_hciRxDiscard = false;
+// Packets posted to g_hciRxQueue and not yet run.
+static atomic_uint g_hciRxPending = 0;
+// Data packets dropped because the processing thread fell HCI_RX_DATA_LIMIT packets behind.
+static uint32_t g_hciRxDropped = 0;
 
 static ReactorItem *g_hciTxReactorItem = NULL;
 static ReactorItem *g_hciRxReactorItem = NULL;
@@ -58,7 +72,7 @@ static Thread *g_hciTxThread = NULL;
 
 // Function Declare
 static void HciSendPacketCallback(void *param);
-static void HciRecvPacketCallback(void *param);
+static void HciRecvPacketTask(void *param);
 
 static void HciFreePacket(void *packet)
 {
@@ -83,11 +97,13 @@ static int HciInitQueue()
             result = BT_OPERATION_FAILED;
             break;
         }
-        g_hciRxQueue = QueueCreate(HCI_RX_QUEUE_SIZE);
+        g_hciRxQueue = TaskQueueCreate(HCI_RX_QUEUE_SIZE);
         if (g_hciRxQueue != NULL) {
+            g_hciRxDiscard = false;
+            atomic_store(&g_hciRxPending, 0);
             Reactor *reactor = ThreadGetReactor(BTM_GetProcessingThread());
             g_hciRxReactorItem =
-                ReactorRegister(reactor, QueueGetDequeueFd(g_hciRxQueue), NULL, HciRecvPacketCallback, NULL);
+                ReactorRegister(reactor, TaskQueueGetFd(g_hciRxQueue), g_hciRxQueue, TaskQueueOnReadReady, NULL);
         } else {
             result = BT_OPERATION_FAILED;
             break;
@@ -119,6 +135,26 @@ static int HciInitHal()
     return result;
 }
 
+static void WaitRxTaskCompleteTask(void *context)
+{
+    Event *taskCompleteEvent = (Event *)context;
+    if (taskCompleteEvent != NULL) {
+        EventSet(taskCompleteEvent);
+    }
+}
+
+static void WaitRxTaskComplete()
+{
+    const int taskTimeout = 1000;
+
+    Event *taskCompleteEvent = EventCreate(true);
+    if (taskCompleteEvent != NULL) {
+        ThreadPostTask(BTM_GetProcessingThread(), WaitRxTaskCompleteTask, taskCompleteEvent);
+        EventWait(taskCompleteEvent, taskTimeout);
+        EventDelete(taskCompleteEvent);
+    }
+}
+
 static void HciCloseQueue()
 {
     if (g_hciTxReactorItem != NULL) {
@@ -126,18 +162,22 @@ static void HciCloseQueue()
         g_hciTxReactorItem = NULL;
     }
 
-    if (g_hciRxReactorItem != NULL) {
-        ReactorUnregister(g_hciRxReactorItem);
-        g_hciRxReactorItem = NULL;
-    }
-
     if (g_hciTxQueue != NULL) {
         QueueDelete(g_hciTxQueue, HciFreePacket);
         g_hciTxQueue = NULL;
     }
 
+    // The processing thread must stop draining g_hciRxQueue before it is drained here.
+    if (g_hciRxReactorItem != NULL) {
+        ReactorUnregister(g_hciRxReactorItem);
+        g_hciRxReactorItem = NULL;
+        WaitRxTaskComplete();
+    }
+
     if (g_hciRxQueue != NULL) {
-        QueueDelete(g_hciRxQueue, HciFreePacket);
+        g_hciRxDiscard = true;
+        (void)TaskQueueRun(g_hciRxQueue, HCI_RX_QUEUE_SIZE);
+        TaskQueueDelete(g_hciRxQueue);
         g_hciRxQueue = NULL;
     }
 }
@@ -206,34 +246,15 @@ static void CleanTxPacket()
     }
 }
 
+// Must only be called once the processing thread no longer drains g_hciRxQueue.
 static void CleanRxPacket()
 {
     if (g_hciRxQueue != NULL) {
-        HciPacket *packet = QueueTryDequeue(g_hciRxQueue);
-        while (packet != NULL) {
-            HciFreePacket(packet);
-            packet = QueueTryDequeue(g_hciTxQueue);
-        }
-    }
-}
-
-static void WaitRxTaskCompleteTask(void *context)
-{
-    Event *taskCompleteEvent = (Event *)context;
-    if (taskCompleteEvent != NULL) {
-        EventSet(taskCompleteEvent);
-    }
-}
-
-static void WaitRxTaskComplete()
-{
-    const int taskTimeout = 1000;
-
-    Event *taskCompleteEvent = EventCreate(true);
-    if (taskCompleteEvent != NULL) {
-        ThreadPostTask(BTM_GetProcessingThread(), WaitRxTaskCompleteTask, taskCompleteEvent);
-        EventWait(taskCompleteEvent, taskTimeout);
-        EventDelete(taskCompleteEvent);
+        g_hciRxDiscard = true;
+        uint32_t count;
+        do {
+            count = TaskQueueRun(g_hciRxQueue, HCI_RX_QUEUE_SIZE);
+        } while (count > 0);
     }
 }
 
@@ -257,8 +278,6 @@ void HCI_Close()
         g_hdiLib->hdiClose();
     }
 
-    CleanRxPacket();
-
     if (g_hciRxReactorItem != NULL) {
         ReactorUnregister(g_hciRxReactorItem);
         g_hciRxReactorItem = NULL;
@@ -266,13 +285,15 @@ void HCI_Close()
 
     WaitRxTaskComplete();
 
+    CleanRxPacket();
+
     if (g_hciTxQueue != NULL) {
         QueueDelete(g_hciTxQueue, HciFreePacket);
         g_hciTxQueue = NULL;
     }
 
     if (g_hciRxQueue != NULL) {
-        QueueDelete(g_hciRxQueue, HciFreePacket);
+        TaskQueueDelete(g_hciRxQueue);
         g_hciRxQueue = NULL;
     }
 
@@ -295,6 +316,12 @@ static void HciOnHDIInited(BtStatus status)
     SemaphorePost(g_waitHdiInit);
 }
 
+static void HciCountRxDropped(void)
+{
+    g_hciRxDropped++;
+    LOG_ERROR("%{public}s: Receive queue is full, %{public}u packets dropped", __FUNCTION__, g_hciRxDropped);
+}
+
 static void HciOnReceivedHciPacket(BtPacketType type, const BtPacket *btPacket)
 {
     if (g_transmissionCapture && g_transmissionCallback != NULL) {
@@ -302,6 +329,14 @@ static void HciOnReceivedHciPacket(BtPacketType type, const BtPacket *btPacket)
         g_transmissionCallback(transType, btPacket->data, btPacket->size);
     }
 
+    // Events are never dropped: a lost Command Complete/Status stalls the command credits and a lost
+    // Number Of Completed Packets leaks ACL credits for good. Only data gives way when the queue backs up.
+    bool isEvent = (type == PACKET_TYPE_EVENT);
+    if (!isEvent && atomic_load(&g_hciRxPending) >= HCI_RX_DATA_LIMIT) {
+        HciCountRxDropped();
+        return;
+    }
+
     HciPacket *hciPacket = MEM_MALLOC.alloc(sizeof(HciPacket));
     if (hciPacket != NULL) {
         switch (type) {
@@ -315,22 +350,69 @@ static void HciOnReceivedHciPacket(BtPacketType type, const BtPacket *btPacket)
                 break;
         }
 
+        // The HDI data is only valid during this callback. This is the only copy on the receive path,
+        // ACL reassembly and L2CAP recombination pass the buffer on by reference.
         hciPacket->packet = PacketMalloc(0, 0, btPacket->size);
-        PacketPayloadWrite(hciPacket->packet, btPacket->data, 0, btPacket->size);
+        Buffer *buffer = (hciPacket->packet != NULL) ? PacketContinuousPayload(hciPacket->packet) : NULL;
+        if (buffer == NULL) {
+            LOG_ERROR("%{public}s: No memory for packet of size %{public}u", __FUNCTION__, btPacket->size);
+            HciFreePacket(hciPacket);
+            return;
+        }
+        (void)memcpy_s(BufferPtr(buffer), btPacket->size, btPacket->data, btPacket->size);
+
+        // Data never takes the reserved slots, so an event only waits here if HCI_RX_EVENT_RESERVE events are
+        // already pending.
+        atomic_fetch_add(&g_hciRxPending, 1);
+        if (!TaskQueueTryPost(g_hciRxQueue, HciRecvPacketTask, hciPacket)) {
+            if (isEvent) {
+                TaskQueuePost(g_hciRxQueue, HciRecvPacketTask, hciPacket);
+            } else {
+                atomic_fetch_sub(&g_hciRxPending, 1);
+                HciCountRxDropped();
+                HciFreePacket(hciPacket);
+            }
+        }
+    }
+}
 
-        QueueEnqueue(g_hciRxQueue, hciPacket);
+static BtPacketType HciGetBtPacketType(uint8_t type)
+{
+    switch (type) {
+        case H2C_CMD:
+            return PACKET_TYPE_CMD;
+        case H2C_ACLDATA:
+            return PACKET_TYPE_ACL;
+        case H2C_SCODATA:
+            return PACKET_TYPE_SCO;
+        default:
+            return PACKET_TYPE_UNKNOWN;
     }
 }
 
+// Pass the head/payload/tail buffers straight to the HDI, false if the packet has too many segments.
+static bool HciSendPacketSegments(BtPacketType type, const Packet *packet, int *result)
+{
+    const uint8_t *data[HCI_TX_MAX_SEGMENTS];
+    uint32_t size[HCI_TX_MAX_SEGMENTS];
+    uint32_t count = PacketGetSegments(packet, data, size, HCI_TX_MAX_SEGMENTS);
+    if (count > HCI_TX_MAX_SEGMENTS) {
+        return false;
+    }
+
+    BtPacket segments[HCI_TX_MAX_SEGMENTS];
+    for (uint32_t i = 0; i < count; i++) {
+        segments[i].data = (uint8_t *)data[i];
+        segments[i].size = size[i];
+    }
+    *result = g_hdiLib->hdiSendHciPacketV(type, segments, count);
+    return true;
+}
+
 static void HciSendPacketCallback(void *param)
 {
     HciPacket *packet = QueueTryDequeue(g_hciTxQueue);
     if (packet != NULL) {
-        BtPacket btPacket;
-        btPacket.size = PacketSize(packet->packet);
-        btPacket.data = MEM_MALLOC.alloc(btPacket.size);
-        PacketRead(packet->packet, btPacket.data, 0, btPacket.size);
-
         int result;
 
         if (g_hdiLib == NULL) {
@@ -338,27 +420,35 @@ static void HciSendPacketCallback(void *param)
             return;
         }
 
-        switch (packet->type) {
-            case H2C_CMD:
-                result = g_hdiLib->hdiSendHciPacket(PACKET_TYPE_CMD, &btPacket);
-                break;
-            case H2C_ACLDATA:
-                result = g_hdiLib->hdiSendHciPacket(PACKET_TYPE_ACL, &btPacket);
-                break;
-            case H2C_SCODATA:
-                result = g_hdiLib->hdiSendHciPacket(PACKET_TYPE_SCO, &btPacket);
-                break;
-            default:
-                result = UNKNOWN;
-                break;
+        BtPacketType type = HciGetBtPacketType(packet->type);
+        // Capture needs one continuous buffer, so packets are still linearized while it is enabled.
+        bool capture = g_transmissionCapture && g_transmissionCallback != NULL;
+        if (type != PACKET_TYPE_UNKNOWN && !capture && g_hdiLib->hdiSendHciPacketV != NULL &&
+            HciSendPacketSegments(type, packet->packet, &result)) {
+            if (result != SUCCESS) {
+                LOG_ERROR("Send packet to HDI failed: %{public}d", result);
+            }
+            HciFreePacket(packet);
+            return;
+        }
+
+        BtPacket btPacket;
+        btPacket.size = PacketSize(packet->packet);
+        btPacket.data = MEM_MALLOC.alloc(btPacket.size);
+        PacketRead(packet->packet, btPacket.data, 0, btPacket.size);
+
+        if (type != PACKET_TYPE_UNKNOWN) {
+            result = g_hdiLib->hdiSendHciPacket(type, &btPacket);
+        } else {
+            result = UNKNOWN;
         }
 
         if (result != SUCCESS) {
             LOG_ERROR("Send packet to HDI failed: %{public}d", result);
         } else {
-            if (g_transmissionCapture && g_transmissionCallback != NULL) {
-                uint8_t type = (packet->type == H2C_CMD) ? TRANSMISSON_TYPE_H2C_CMD : TRANSMISSON_TYPE_H2C_DATA;
-                g_transmissionCallback(type, btPacket.data, btPacket.size);
+            if (capture) {
+                uint8_t captureType = (packet->type == H2C_CMD) ? TRANSMISSON_TYPE_H2C_CMD : TRANSMISSON_TYPE_H2C_DATA;
+                g_transmissionCallback(captureType, btPacket.data, btPacket.size);
             }
         }
 
@@ -367,10 +457,15 @@ static void HciSendPacketCallback(void *param)
     }
 }
 
-static void HciRecvPacketCallback(void *param)
+static void HciRecvPacketTask(void *param)
 {
-    HciPacket *packet = QueueTryDequeue(g_hciRxQueue);
-    if (packet != NULL) {
+    HciPacket *packet = param;
+    if (packet == NULL) {
+        return;
+    }
+    atomic_fetch_sub(&g_hciRxPending, 1);
+
+    if (!g_hciRxDiscard) {
         switch (packet->type) {
             case C2H_ACLDATA:
                 HciOnAclData(packet->packet);
@@ -384,8 +479,8 @@ static void HciRecvPacketCallback(void *param)
             default:
                 break;
         }
-        HciFreePacket(packet);
     }
+    HciFreePacket(packet);
 }
 
 void HciPushToTxQueue(HciPacket *packet)
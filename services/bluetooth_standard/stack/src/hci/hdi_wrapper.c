@@ -47,6 +47,11 @@ HDILib *LoadHdiLib()
                 LOG_ERROR("Load symbol HdiSendHciPacket failed");
             }
 
+            lib->hdiSendHciPacketV = dlsym(lib->lib, "HdiSendHciPacketV");
+            if (lib->hdiSendHciPacketV == NULL) {
+                LOG_INFO("Symbol HdiSendHciPacketV not found, packets are linearized before sending");
+            }
+
             lib->hdiClose = dlsym(lib->lib, "HdiClose");
             if (lib->hdiClose == NULL) {
                 LOG_ERROR("Load symbol HdiClose failed");
@@ -69,6 +74,7 @@ void UnloadHdiLib(HDILib *lib)
     if (lib != NULL) {
         lib->hdiInit = NULL;
         lib->hdiSendHciPacket = NULL;
+        lib->hdiSendHciPacketV = NULL;
         lib->hdiClose = NULL;
         if (lib->lib != NULL) {
             dlclose(lib->lib);
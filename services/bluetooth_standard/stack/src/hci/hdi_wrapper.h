@@ -25,6 +25,8 @@ extern "C" {
 typedef struct {
     HdiInitFunc hdiInit;
     HdiSendHciPacketFunc hdiSendHciPacket;
+    // Optional, NULL when the adapter has no vectored send.
+    HdiSendHciPacketVFunc hdiSendHciPacketV;
     HdiCloseFunc hdiClose;
 
     void *lib;
@@ -114,6 +114,11 @@ int L2CAP_ConnectRsp(uint16_t lcid, uint8_t id, uint16_t result, uint16_t status
 }
 
 int L2CAP_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg)
+{
+    return L2CAP_ExtendedConfigReq(lcid, cfg, 0);
+}
+
+int L2CAP_ExtendedConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, uint16_t rxWindowSize)
 {
     L2capConnection *conn = NULL;
     L2capChannel *chan = NULL;
@@ -147,8 +152,13 @@ int L2CAP_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg)
     chan->lcfg.rfc.mode = cfg->rfc.mode;
 
     if (chan->lcfg.rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) {
-        if (cfg->rfc.rxWindowSize != 0) {
-            chan->lcfg.rfc.rxWindowSize = cfg->rfc.rxWindowSize;
+        // the RFC option alone carries a window of at most 63
+        if ((rxWindowSize == 0) && (cfg->rfc.rxWindowSize != 0)) {
+            rxWindowSize = (cfg->rfc.rxWindowSize > L2CAP_MAX_TX_WINDOW) ? L2CAP_MAX_TX_WINDOW : cfg->rfc.rxWindowSize;
+        }
+
+        if (rxWindowSize != 0) {
+            chan->lwin.rxWindowSize = (rxWindowSize > L2CAP_MAX_EXT_TX_WINDOW) ? L2CAP_MAX_EXT_TX_WINDOW : rxWindowSize;
         }
 
         if (cfg->rfc.maxTransmit != 0) {
@@ -162,8 +172,8 @@ int L2CAP_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg)
         chan->lcfg.rfc.maxTransmit = 0;
         chan->lcfg.rfc.retransmissionTimeout = 0;
         chan->lcfg.rfc.monitorTimeout = 0;
-        chan->lcfg.rfc.txWindowSize = 0;
-        chan->lcfg.rfc.rxWindowSize = 0;
+        chan->lwin.txWindowSize = 0;
+        chan->lwin.rxWindowSize = 0;
 
         if (chan->lcfg.rfc.mps > cfg->mtu) {
             chan->lcfg.rfc.mps = cfg->mtu;
@@ -211,19 +221,21 @@ int L2CAP_ConfigRsp(uint16_t lcid, uint8_t id, const L2capConfigInfo *cfg, uint1
     }
 
     if (cfg->rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) {
-        chan->lcfg.rfc.txWindowSize = chan->rcfg.rfc.rxWindowSize;
+        chan->lwin.txWindowSize = chan->rwin.rxWindowSize;
         chan->lcfg.rfc.retransmissionTimeout = L2CAP_DEFAULT_RETRANSMISSION_TIMEOUT;
         chan->lcfg.rfc.monitorTimeout = L2CAP_DEFAULT_MONITOR_TIMEOUT;
 
-        if (chan->rcfg.rfc.mps > (L2capGetTxBufferSize() - L2CAP_SIZE_10)) {
-            chan->rcfg.rfc.mps = (L2capGetTxBufferSize() - L2CAP_SIZE_10);
+        // the extended control field takes 2 more octets of the buffer
+        uint16_t overhead = chan->erfc.extControl ? L2CAP_SIZE_12 : L2CAP_SIZE_10;
+        if (chan->rcfg.rfc.mps > (L2capGetTxBufferSize() - overhead)) {
+            chan->rcfg.rfc.mps = (L2capGetTxBufferSize() - overhead);
         }
     } else if (chan->lcfg.rfc.mode == L2CAP_STREAM_MODE) {
         chan->lcfg.rfc.maxTransmit = 0;
         chan->lcfg.rfc.retransmissionTimeout = 0;
         chan->lcfg.rfc.monitorTimeout = 0;
-        chan->lcfg.rfc.txWindowSize = 0;
-        chan->lcfg.rfc.rxWindowSize = 0;
+        chan->lwin.txWindowSize = 0;
+        chan->lwin.rxWindowSize = 0;
 
         if (chan->rcfg.rfc.mps > (L2capGetTxBufferSize() - L2CAP_SIZE_10)) {
             chan->rcfg.rfc.mps = (L2capGetTxBufferSize() - L2CAP_SIZE_10);
@@ -330,6 +342,32 @@ int L2CAP_LocalBusy(uint16_t lcid, uint8_t isBusy)
     return BT_NO_ERROR;
 }
 
+int L2CAP_GetErfcStatistics(uint16_t lcid, L2capErfcStatistics *stats)
+{
+    L2capConnection *conn = NULL;
+    L2capChannel *chan = NULL;
+
+    if (L2capInitialized() != BT_NO_ERROR) {
+        return BT_BAD_STATUS;
+    }
+
+    if (stats == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    L2capGetChannel2(lcid, &conn, &chan);
+    if (chan == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    if (chan->lcfg.rfc.mode != L2CAP_ENHANCED_RETRANSMISSION_MODE) {
+        return BT_BAD_PARAM;
+    }
+
+    L2capErfcGetStatistics(chan, stats);
+    return BT_NO_ERROR;
+}
+
 int L2CAP_SendData(uint16_t lcid, Packet *pkt)
 {
     L2capConnection *conn = NULL;
@@ -91,6 +91,16 @@ int L2CAP_ConnectRsp(uint16_t lcid, uint8_t id, uint16_t result, uint16_t status
  */
 int L2CAP_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg);
 
+/**
+ * @brief Send Configuration Request packet with a receive window of up to 16383
+ *
+ * @param lcid local channel id
+ * @param cfg config parameter
+ * @param rxWindowSize receive window in Enhanced Retransmission mode, 0 to use cfg->rfc.rxWindowSize
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful, otherwise the operation fails.
+ */
+int L2CAP_ExtendedConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, uint16_t rxWindowSize);
+
 /**
  * @brief Send Configuration Response packet
  *
@@ -137,6 +147,15 @@ int L2CAP_LocalBusy(uint16_t lcid, uint8_t isBusy);
  */
 int L2CAP_SendData(uint16_t lcid, Packet *pkt);
 
+/**
+ * @brief In Enhanced Retransmission mode, get the statistics of the channel
+ *
+ * @param lcid local channel id
+ * @param stats statistics of the channel
+ * @return Returns <b>BT_NO_ERROR</b> if the operation is successful, otherwise the operation fails.
+ */
+int L2CAP_GetErfcStatistics(uint16_t lcid, L2capErfcStatistics *stats);
+
 /**
  * @brief Register Echo callback
  *
@@ -29,17 +29,23 @@
 
 #include "../btm/btm_thread.h"
 
-typedef struct {
+#define L2CAP_FRAGMENTATION_TABLE_SIZE 8
+#define L2CAP_FRAGMENTATION_BUCKET(handle) ((handle) & (L2CAP_FRAGMENTATION_TABLE_SIZE - 1))
+
+typedef struct L2capFragmentationPacket {
     uint16_t handle;
     uint16_t length;
     uint16_t cid;
     Packet *pkt;
+
+    struct L2capFragmentationPacket *next;
 } L2capFragmentationPacket;
 
 static L2capBdrCallback g_l2capBdr;
 static L2capLeCallback g_l2capLe;
 
-static List *g_fragmentationList;
+// packets being recombined hashed by handle, at most one for each handle
+static L2capFragmentationPacket **g_fragmentationTable;
 
 static void L2capProcessPacket(uint16_t handle, uint16_t cid, Packet *pkt)
 {
@@ -75,28 +81,42 @@ static void L2capProcessPacket(uint16_t handle, uint16_t cid, Packet *pkt)
     return;
 }
 
+// Returns the link to the packet of the handle, or to the end of its bucket if there is none.
+static L2capFragmentationPacket **L2capFindFragmentation(uint16_t handle)
+{
+    L2capFragmentationPacket **prev = &(g_fragmentationTable[L2CAP_FRAGMENTATION_BUCKET(handle)]);
+
+    while (((*prev) != NULL) && ((*prev)->handle != handle)) {
+        prev = &((*prev)->next);
+    }
+
+    return prev;
+}
+
+static void L2capRemoveFragmentation(L2capFragmentationPacket **prev)
+{
+    L2capFragmentationPacket *frag = *prev;
+
+    *prev = frag->next;
+    PacketFree(frag->pkt);
+    L2capFree(frag);
+    return;
+}
+
 static void L2capRecombineStart(uint16_t handle, uint16_t length, uint16_t cid, const Packet *pkt)
 {
     L2capFragmentationPacket *frag = NULL;
-    ListNode *node = NULL;
+    L2capFragmentationPacket **prev = NULL;
     Packet *tpkt = NULL;
 
-    if (g_fragmentationList == NULL) {
+    if (g_fragmentationTable == NULL) {
         return;
     }
 
     // if there are already packet with the same handle, the old packet will be discard
-    node = ListGetFirstNode(g_fragmentationList);
-    while (node != NULL) {
-        frag = ListGetNodeData(node);
-        if (frag->handle == handle) {
-            ListRemoveNode(g_fragmentationList, frag);
-            PacketFree(frag->pkt);
-            L2capFree(frag);
-            break;
-        }
-
-        node = ListGetNextNode(node);
+    prev = L2capFindFragmentation(handle);
+    if ((*prev) != NULL) {
+        L2capRemoveFragmentation(prev);
     }
 
     tpkt = PacketRefMalloc(pkt);
@@ -111,44 +131,41 @@ static void L2capRecombineStart(uint16_t handle, uint16_t length, uint16_t cid,
     frag->cid = cid;
     frag->pkt = tpkt;
 
-    ListAddLast(g_fragmentationList, frag);
+    frag->next = g_fragmentationTable[L2CAP_FRAGMENTATION_BUCKET(handle)];
+    g_fragmentationTable[L2CAP_FRAGMENTATION_BUCKET(handle)] = frag;
     return;
 }
 
 static void L2capRecombineContinue(uint16_t handle, const Packet *pkt)
 {
     L2capFragmentationPacket *frag = NULL;
-    ListNode *node = NULL;
+    L2capFragmentationPacket **prev = NULL;
     uint16_t pktLength;
 
-    if (g_fragmentationList == NULL) {
+    if (g_fragmentationTable == NULL) {
         return;
     }
 
-    node = ListGetFirstNode(g_fragmentationList);
-    while (node != NULL) {
-        frag = ListGetNodeData(node);
-        if (frag->handle == handle) {
-            PacketAssemble(frag->pkt, pkt);
-            pktLength = PacketSize(frag->pkt);
-            if (frag->length == (pktLength - L2CAP_HEADER_LENGTH)) {
-                L2capProcessPacket(handle, frag->cid, frag->pkt);
-
-                ListRemoveNode(g_fragmentationList, frag);
-                PacketFree(frag->pkt);
-                L2capFree(frag);
-            } else if (frag->length < (pktLength - L2CAP_HEADER_LENGTH)) {  // invalid packet length
-                ListRemoveNode(g_fragmentationList, frag);
-                PacketFree(frag->pkt);
-                L2capFree(frag);
-            }
+    prev = L2capFindFragmentation(handle);
+    frag = *prev;
+    if (frag == NULL) {
+        return;
+    }
 
-            break;
-        }
+    PacketAssemble(frag->pkt, pkt);
+    pktLength = PacketSize(frag->pkt);
+    if (frag->length > (pktLength - L2CAP_HEADER_LENGTH)) {
+        return;
+    }
 
-        node = ListGetNextNode(node);
+    // complete or invalid packet length, unlinked before the upper layers see it
+    *prev = frag->next;
+    if (frag->length == (pktLength - L2CAP_HEADER_LENGTH)) {
+        L2capProcessPacket(handle, frag->cid, frag->pkt);
     }
 
+    PacketFree(frag->pkt);
+    L2capFree(frag);
     return;
 }
 
@@ -233,23 +250,12 @@ static void L2capAclDataReceivedCallback(uint16_t handle, uint8_t pb, uint8_t bc
 
 static void L2capAclDisconnected(uint8_t status, uint16_t handle, uint8_t reason, void *context)
 {
-    L2capFragmentationPacket *frag = NULL;
-    ListNode *node = NULL;
+    L2capFragmentationPacket **prev = NULL;
 
-    if (g_fragmentationList != NULL) {
-        node = ListGetFirstNode(g_fragmentationList);
-        while (node != NULL) {
-            frag = ListGetNodeData(node);
-            if (frag->handle == handle) {
-                ListRemoveNode(g_fragmentationList, frag);
-                PacketFree(frag->pkt);
-                L2capFree(frag);
-
-                node = ListGetFirstNode(g_fragmentationList);
-                continue;
-            }
-
-            node = ListGetNextNode(node);
+    if (g_fragmentationTable != NULL) {
+        prev = L2capFindFragmentation(handle);
+        if ((*prev) != NULL) {
+            L2capRemoveFragmentation(prev);
         }
     }
 
@@ -712,11 +718,11 @@ int L2capRegisterLe(const L2capLeCallback *cb)
 
 void L2capCommonStartup()
 {
-    if (g_fragmentationList != NULL) {
+    if (g_fragmentationTable != NULL) {
         return;
     }
 
-    g_fragmentationList = ListCreate(NULL);
+    g_fragmentationTable = L2capAlloc(sizeof(L2capFragmentationPacket *) * L2CAP_FRAGMENTATION_TABLE_SIZE);
 
     BTM_RegisterAclCallbacks(&g_btmAclCallback, NULL);
     HCI_RegisterAclCallbacks(&g_hciAclCallback);
@@ -729,24 +735,15 @@ void L2capCommonShutdown()
     BTM_DeregisterAclCallbacks(&g_btmAclCallback);
     HCI_DeregisterAclCallbacks(&g_hciAclCallback);
 
-    if (g_fragmentationList != NULL) {
-        L2capFragmentationPacket *frag = NULL;
-        ListNode *node = NULL;
-
-        while (true) {
-            node = ListGetFirstNode(g_fragmentationList);
-            if (node == NULL) {
-                break;
+    if (g_fragmentationTable != NULL) {
+        for (uint16_t i = 0; i < L2CAP_FRAGMENTATION_TABLE_SIZE; i++) {
+            while (g_fragmentationTable[i] != NULL) {
+                L2capRemoveFragmentation(&(g_fragmentationTable[i]));
             }
-
-            frag = ListGetNodeData(node);
-            ListRemoveNode(g_fragmentationList, frag);
-            PacketFree(frag->pkt);
-            L2capFree(frag);
         }
 
-        ListDelete(g_fragmentationList);
-        g_fragmentationList = NULL;
+        L2capFree(g_fragmentationTable);
+        g_fragmentationTable = NULL;
     }
 
     return;
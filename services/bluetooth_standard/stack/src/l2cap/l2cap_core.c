@@ -18,6 +18,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "btm.h"
 #include "log.h"
@@ -39,6 +40,14 @@ static uint8_t L2capGetNewIdentifier(L2capConnection *conn)
     return ident;
 }
 
+static uint64_t L2capGetTimeMs()
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * L2CAP_MS_PER_SECOND + (uint64_t)ts.tv_nsec / L2CAP_NS_PER_MS);
+}
+
 static void L2capDisconnectAbnormal(const L2capChannel *chan, uint8_t reason)
 {
     L2capPsm *psm = NULL;
@@ -178,11 +187,13 @@ int L2capSendConnectionRsp(L2capConnection *conn, L2capChannel *chan, uint8_t id
     return L2capSendPacket(conn->aclHandle, L2CAP_NONE_FLUSH_PACKET, pkt);
 }
 
-int L2capSendConfigurationReq(L2capConnection *conn, const L2capChannel *chan)
+int L2capSendConfigurationReq(L2capConnection *conn, L2capChannel *chan)
 {
     Packet *pkt = NULL;
     uint8_t buff[48] = {0};
     L2capSignalHeader signal = {0};
+    uint8_t txWindowSize = (uint8_t)chan->lwin.rxWindowSize;
+    uint8_t sendExtWindowSize = 0;
 
     L2capCpuToLe16(buff + 0, chan->rcid);
     L2capCpuToLe16(buff + L2CAP_OFFSET_2, 0);
@@ -200,11 +211,24 @@ int L2capSendConfigurationReq(L2capConnection *conn, const L2capChannel *chan)
         signal.length += L2CAP_SIZE_4;
     }
 
+    // a window larger than 63 is requested with the extended window size option, if the remote supports it
+    if ((chan->lcfg.rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) &&
+        (chan->lwin.rxWindowSize > L2CAP_MAX_TX_WINDOW)) {
+        if (conn->info.extendedFeature[1] & L2CAP_FEATURE_EXTENDED_WINDOW_SIZE) {
+            sendExtWindowSize = 1;
+            chan->erfc.extControl = 1;
+        } else {
+            chan->lwin.rxWindowSize = L2CAP_MAX_TX_WINDOW;
+        }
+
+        txWindowSize = L2CAP_MAX_TX_WINDOW;
+    }
+
     if (chan->lcfg.rfc.mode != L2CAP_BASIC_MODE) {
         buff[signal.length + 0] = L2CAP_OPTION_RETRANSMISSION_AND_FLOW_CONTROL;
         buff[signal.length + L2CAP_OFFSET_1] = L2CAP_SIZE_9;
         buff[signal.length + L2CAP_OFFSET_2] = chan->lcfg.rfc.mode;
-        buff[signal.length + L2CAP_OFFSET_3] = chan->lcfg.rfc.rxWindowSize;
+        buff[signal.length + L2CAP_OFFSET_3] = txWindowSize;
         buff[signal.length + L2CAP_OFFSET_4] = chan->lcfg.rfc.maxTransmit;
         L2capCpuToLe16(buff + signal.length + L2CAP_OFFSET_5, 0);
         L2capCpuToLe16(buff + signal.length + L2CAP_OFFSET_7, 0);
@@ -219,6 +243,13 @@ int L2capSendConfigurationReq(L2capConnection *conn, const L2capChannel *chan)
         signal.length += L2CAP_SIZE_3;
     }
 
+    if (sendExtWindowSize) {
+        buff[signal.length + 0] = L2CAP_OPTION_EXTENDED_WINDOW_SIZE;
+        buff[signal.length + L2CAP_OFFSET_1] = L2CAP_SIZE_2;
+        L2capCpuToLe16(buff + signal.length + L2CAP_OFFSET_2, chan->lwin.rxWindowSize);
+        signal.length += L2CAP_SIZE_4;
+    }
+
     signal.code = L2CAP_CONFIGURATION_REQUEST;
     signal.identifier = L2capGetNewIdentifier(conn);
 
@@ -235,11 +266,27 @@ static void L2capChannelConnected(L2capChannel *chan)
             chan->lcfg.fcs = 0x01;
             chan->rcfg.fcs = 0x01;
         }
+
+        if (chan->lcfg.rfc.mode == L2CAP_BASIC_MODE) {
+            chan->erfc.extControl = 0;
+        } else if (chan->erfc.connectedMs == 0) {
+            chan->erfc.connectedMs = L2capGetTimeMs();
+        }
     }
 
     return;
 }
 
+// the TxWindow field of the RFC option is 8 bits, a larger window is carried by the extended window size option
+static uint8_t L2capGetRfcTxWindowSize(uint16_t windowSize)
+{
+    if (windowSize > L2CAP_MAX_TX_WINDOW) {
+        return L2CAP_MAX_TX_WINDOW;
+    }
+
+    return (uint8_t)windowSize;
+}
+
 static void L2capSendConfigurationRspRfcProcess(
     L2capChannel *chan, L2capSignalHeader *signal, uint8_t *buff, uint16_t result, const L2capConfigInfo *cfg)
 {
@@ -251,7 +298,7 @@ static void L2capSendConfigurationRspRfcProcess(
         buff[signal->length + 0] = L2CAP_OPTION_RETRANSMISSION_AND_FLOW_CONTROL;
         buff[signal->length + L2CAP_OFFSET_1] = L2CAP_SIZE_9;
         buff[signal->length + L2CAP_OFFSET_2] = cfg->rfc.mode;
-        buff[signal->length + L2CAP_OFFSET_3] = cfg->rfc.txWindowSize;
+        buff[signal->length + L2CAP_OFFSET_3] = L2capGetRfcTxWindowSize(cfg->rfc.txWindowSize);
         buff[signal->length + L2CAP_OFFSET_4] = cfg->rfc.maxTransmit;
         L2capCpuToLe16(buff + signal->length + L2CAP_OFFSET_5, cfg->rfc.retransmissionTimeout);
         L2capCpuToLe16(buff + signal->length + L2CAP_OFFSET_7, cfg->rfc.monitorTimeout);
@@ -262,7 +309,7 @@ static void L2capSendConfigurationRspRfcProcess(
             buff[signal->length + 0] = L2CAP_OPTION_RETRANSMISSION_AND_FLOW_CONTROL;
             buff[signal->length + L2CAP_OFFSET_1] = L2CAP_SIZE_9;
             buff[signal->length + L2CAP_OFFSET_2] = cfg->rfc.mode;
-            buff[signal->length + L2CAP_OFFSET_3] = chan->lcfg.rfc.txWindowSize;
+            buff[signal->length + L2CAP_OFFSET_3] = L2capGetRfcTxWindowSize(chan->lwin.txWindowSize);
             buff[signal->length + L2CAP_OFFSET_4] = 0;
             L2capCpuToLe16(buff + signal->length + L2CAP_OFFSET_5, chan->lcfg.rfc.retransmissionTimeout);
             L2capCpuToLe16(buff + signal->length + L2CAP_OFFSET_7, chan->lcfg.rfc.monitorTimeout);
@@ -397,6 +444,7 @@ int L2capSendInformationRsp(const L2capConnection *conn, uint8_t ident, uint16_t
 
         buff[L2CAP_OFFSET_4] = L2CAP_FEATURE_ENHANCED_RETRANSMISSION_MODE | L2CAP_FEATURE_STREAMING_MODE |
                                L2CAP_FEATURE_FCS_OPTION | L2CAP_FEATURE_FIXED_CHANNELS;
+        buff[L2CAP_OFFSET_5] = L2CAP_FEATURE_EXTENDED_WINDOW_SIZE;
         signal.length = L2CAP_SIZE_8;
     } else if (infoType == L2CAP_INFORMATION_TYPE_FIXED_CHANNEL) {
         L2capCpuToLe16(buff + L2CAP_OFFSET_2, 0);  // Success
@@ -415,32 +463,141 @@ int L2capSendInformationRsp(const L2capConnection *conn, uint8_t ident, uint16_t
     return L2capSendPacket(conn->aclHandle, L2CAP_NONE_FLUSH_PACKET, pkt);
 }
 
-static uint16_t L2capGetNextSeq(uint16_t seq)
+static uint16_t L2capGetSeqMask(const L2capChannel *chan)
 {
-    return ((seq + 1) % L2CAP_MAX_TX_WINDOW);
+    if (chan->erfc.extControl) {
+        return L2CAP_EXT_SEQ_MASK;
+    }
+
+    return L2CAP_SEQ_MASK;
 }
 
-static uint16_t L2capGetSeqWindow(uint16_t endSeq, uint16_t startSeq)
+static uint16_t L2capGetControlLength(const L2capChannel *chan)
 {
-    uint16_t seqWindow;
+    if (chan->erfc.extControl) {
+        return L2CAP_SIZE_4;
+    }
 
-    if (startSeq > endSeq) {
-        seqWindow = endSeq + L2CAP_MAX_TX_WINDOW - startSeq;
-    } else {
-        seqWindow = endSeq - startSeq;
+    return L2CAP_SIZE_2;
+}
+
+static uint16_t L2capGetNextSeq(const L2capChannel *chan, uint16_t seq)
+{
+    return ((seq + 1) & L2capGetSeqMask(chan));
+}
+
+static uint16_t L2capGetSeqWindow(const L2capChannel *chan, uint16_t endSeq, uint16_t startSeq)
+{
+    return ((endSeq - startSeq) & L2capGetSeqMask(chan));
+}
+
+// I-frames sent and not acknowledged yet
+static uint16_t L2capGetTxWindow(const L2capChannel *chan)
+{
+    return L2capGetSeqWindow(chan, chan->erfc.txSeq, chan->erfc.expectedAckSeq);
+}
+
+// I-frames received and not acknowledged yet
+static uint16_t L2capGetRxWindow(const L2capChannel *chan)
+{
+    return L2capGetSeqWindow(chan, chan->erfc.expectedTxSeq, chan->erfc.bufferSeq);
+}
+
+static uint16_t L2capLimitWindowSize(const L2capChannel *chan, uint16_t windowSize)
+{
+    uint16_t maxWindowSize = L2CAP_MAX_TX_WINDOW;
+
+    if (chan->erfc.extControl) {
+        maxWindowSize = L2CAP_MAX_EXT_TX_WINDOW;
     }
 
-    return seqWindow;
+    if (windowSize > maxWindowSize) {
+        return maxWindowSize;
+    }
+
+    return windowSize;
+}
+
+static uint16_t L2capErfcGetTxWindowSize(const L2capChannel *chan)
+{
+    return L2capLimitWindowSize(chan, chan->lwin.txWindowSize);
 }
 
-static uint16_t L2capGetTxWindow(const L2capErfc *erfc)
+static uint16_t L2capErfcGetRxWindowSize(const L2capChannel *chan)
 {
-    return L2capGetSeqWindow(erfc->nextTxSeq, erfc->expectedAckSeq);
+    return L2capLimitWindowSize(chan, chan->lwin.rxWindowSize);
 }
 
-static uint16_t L2capGetRxWindow(const L2capErfc *erfc)
+/**
+ * @brief Encode the control field of an I-frame or S-frame.
+ *
+ * Enhanced control field, 16 bits:
+ *   I-frame: Type(0), TxSeq(1-6), F(7), ReqSeq(8-13), SAR(14-15)
+ *   S-frame: Type(0), S(2-3), P(4), F(7), ReqSeq(8-13)
+ * Extended control field, 32 bits:
+ *   I-frame: Type(0), F(1), ReqSeq(2-15), SAR(16-17), TxSeq(18-31)
+ *   S-frame: Type(0), F(1), ReqSeq(2-15), S(16-17), P(18)
+ */
+static void L2capEncodeControl(const L2capChannel *chan, const L2capErfcControl *ctrl, uint8_t *buff)
 {
-    return L2capGetSeqWindow(erfc->expectedTxSeq, erfc->bufferSeq);
+    uint16_t value;
+
+    if (chan->erfc.extControl) {
+        value = ctrl->type | (ctrl->fBit << L2CAP_EXT_CTRL_FBIT_SHIFT) | (ctrl->reqSeq << L2CAP_EXT_CTRL_REQSEQ_SHIFT);
+        L2capCpuToLe16(buff, value);
+
+        if (ctrl->type == L2CAP_IFRAME) {
+            value = ctrl->sar | (ctrl->txSeq << L2CAP_EXT_CTRL_TXSEQ_SHIFT);
+        } else {
+            value = ctrl->sBit | (ctrl->pBit << L2CAP_EXT_CTRL_PBIT_SHIFT);
+        }
+        L2capCpuToLe16(buff + L2CAP_OFFSET_2, value);
+    } else {
+        value = ctrl->type | (ctrl->fBit << L2CAP_CTRL_FBIT_SHIFT) | (ctrl->reqSeq << L2CAP_CTRL_REQSEQ_SHIFT);
+        if (ctrl->type == L2CAP_IFRAME) {
+            value |= (ctrl->txSeq << L2CAP_CTRL_TXSEQ_SHIFT) | (ctrl->sar << L2CAP_CTRL_SAR_SHIFT);
+        } else {
+            value |= (ctrl->sBit << L2CAP_CTRL_SBIT_SHIFT) | (ctrl->pBit << L2CAP_CTRL_PBIT_SHIFT);
+        }
+        L2capCpuToLe16(buff, value);
+    }
+
+    return;
+}
+
+static void L2capDecodeControl(const L2capChannel *chan, const uint8_t *buff, L2capErfcControl *ctrl)
+{
+    uint16_t value;
+
+    value = L2capLe16ToCpu(buff);
+    ctrl->type = value & 0x01;
+
+    if (chan->erfc.extControl) {
+        ctrl->fBit = (value >> L2CAP_EXT_CTRL_FBIT_SHIFT) & 0x01;
+        ctrl->reqSeq = value >> L2CAP_EXT_CTRL_REQSEQ_SHIFT;
+
+        value = L2capLe16ToCpu(buff + L2CAP_OFFSET_2);
+        if (ctrl->type == L2CAP_IFRAME) {
+            ctrl->sar = value & L2CAP_CTRL_SAR_MASK;
+            ctrl->txSeq = value >> L2CAP_EXT_CTRL_TXSEQ_SHIFT;
+        } else {
+            ctrl->sBit = value & L2CAP_CTRL_SBIT_MASK;
+            ctrl->pBit = (value >> L2CAP_EXT_CTRL_PBIT_SHIFT) & 0x01;
+        }
+    } else {
+        ctrl->fBit = (value >> L2CAP_CTRL_FBIT_SHIFT) & 0x01;
+        ctrl->reqSeq = (value >> L2CAP_CTRL_REQSEQ_SHIFT) & L2CAP_SEQ_MASK;
+
+        if (ctrl->type == L2CAP_IFRAME) {
+            ctrl->txSeq = (value >> L2CAP_CTRL_TXSEQ_SHIFT) & L2CAP_SEQ_MASK;
+            ctrl->sar = (value >> L2CAP_CTRL_SAR_SHIFT) & L2CAP_CTRL_SAR_MASK;
+        } else {
+            ctrl->sBit = (value >> L2CAP_CTRL_SBIT_SHIFT) & L2CAP_CTRL_SBIT_MASK;
+            ctrl->pBit = (value >> L2CAP_CTRL_PBIT_SHIFT) & 0x01;
+        }
+    }
+
+    return;
 }
 
 static void L2capAddCrc(Packet *pkt)
@@ -448,7 +605,7 @@ static void L2capAddCrc(Packet *pkt)
     uint16_t crc;
     uint8_t *tail = NULL;
 
-    crc = PacketCalCrc16(pkt, CalCrc16WithPrev);
+    crc = PacketCrc16(pkt);
     tail = BufferPtr(PacketTail(pkt));
     L2capCpuToLe16(tail, crc);
 
@@ -467,7 +624,7 @@ static int L2capCheckCrc(Packet *pkt)
     tailPtr = tail;
     fcs = L2capLe16ToCpu(tailPtr);
 
-    fcsCalc = PacketCalCrc16(pkt, CalCrc16WithPrev);
+    fcsCalc = PacketCrc16(pkt);
     if (fcs != fcsCalc) {
         LOG_ERROR("L2cap CRC Error, %{public}s:%{public}d", __FUNCTION__, __LINE__);
         return BT_BAD_PARAM;
@@ -476,26 +633,24 @@ static int L2capCheckCrc(Packet *pkt)
     return BT_NO_ERROR;
 }
 
-static Packet *L2capBuildSFrame(const L2capChannel *chan, const L2capErfcSControl *sCtrl)
+static Packet *L2capBuildSFrame(const L2capChannel *chan, const L2capErfcControl *sCtrl)
 {
     Packet *spkt = NULL;
     uint8_t *header = NULL;
     uint8_t tailLength = 0;
+    uint16_t ctrlLength;
 
     if (chan->lcfg.fcs == 0x01) {
         tailLength = L2CAP_SIZE_2;
     }
 
-    spkt = PacketMalloc(L2CAP_HEADER_LENGTH + L2CAP_SIZE_2, tailLength, 0);
+    ctrlLength = L2capGetControlLength(chan);
+    spkt = PacketMalloc(L2CAP_HEADER_LENGTH + ctrlLength, tailLength, 0);
     header = BufferPtr(PacketHead(spkt));
 
-    L2capCpuToLe16(header + 0, tailLength + L2CAP_SIZE_2);
+    L2capCpuToLe16(header + 0, tailLength + ctrlLength);
     L2capCpuToLe16(header + L2CAP_OFFSET_2, chan->rcid);
-    if (memcpy_s(header + L2CAP_HEADER_LENGTH, sizeof(L2capErfcSControl), sCtrl, sizeof(L2capErfcSControl)) != EOK) {
-        LOG_ERROR("[%{public}s][%{public}d] memcpy_s fail.", __FUNCTION__, __LINE__);
-        PacketFree(spkt);
-        return NULL;
-    }
+    L2capEncodeControl(chan, sCtrl, header + L2CAP_HEADER_LENGTH);
 
     if (chan->lcfg.fcs == 0x01) {
         L2capAddCrc(spkt);
@@ -507,7 +662,7 @@ static Packet *L2capBuildSFrame(const L2capChannel *chan, const L2capErfcSContro
 int L2capSendSFrame(const L2capConnection *conn, L2capChannel *chan, uint8_t pBit, uint8_t fBit, uint8_t sBit)
 {
     L2capErfc *erfc = NULL;
-    L2capErfcSControl sCtrl = {0};
+    L2capErfcControl sCtrl = {0};
     Packet *spkt = NULL;
 
     erfc = &(chan->erfc);
@@ -519,6 +674,10 @@ int L2capSendSFrame(const L2capConnection *conn, L2capChannel *chan, uint8_t pBi
     sCtrl.pBit = pBit;
     sCtrl.sBit = sBit;
 
+    if (sBit == L2CAP_ERFC_REJ) {
+        erfc->stats.rejSent += 1;
+    }
+
     erfc->bufferSeq = erfc->expectedTxSeq;
     spkt = L2capBuildSFrame(chan, &sCtrl);
 
@@ -526,102 +685,155 @@ int L2capSendSFrame(const L2capConnection *conn, L2capChannel *chan, uint8_t pBi
     return BT_NO_ERROR;
 }
 
-static void L2capProcessRxReqSeq(L2capChannel *chan, uint16_t reqSeq)
+// SREJ asks for one I-frame and acknowledges nothing
+static void L2capErfcSendSrej(const L2capConnection *conn, L2capChannel *chan, uint16_t reqSeq)
 {
-    L2capErfc *erfc = NULL;
-    ListNode *node = NULL;
-    L2capErfcTxPacket *tx = NULL;
-    uint16_t finishedPacketNum = 0;
+    L2capErfcControl sCtrl = {0};
+    Packet *spkt = NULL;
 
-    erfc = &(chan->erfc);
-    if (erfc->nextTxSeq == reqSeq) {
-        finishedPacketNum = L2capGetTxWindow(erfc);
-    } else {
-        uint8_t *header = NULL;
-        L2capErfcIControl *ctrl = NULL;
+    sCtrl.type = L2CAP_SFRAME;
+    sCtrl.sBit = L2CAP_ERFC_SREJ;
+    sCtrl.reqSeq = reqSeq;
 
-        node = ListGetFirstNode(erfc->txList);
-        while (node != NULL) {
-            tx = ListGetNodeData(node);
-            header = BufferPtr(PacketHead(tx->pkt));
+    chan->erfc.stats.srejSent += 1;
+    spkt = L2capBuildSFrame(chan, &sCtrl);
 
-            ctrl = (L2capErfcIControl *)(header + L2CAP_HEADER_LENGTH);
-            if (ctrl->txSeq == erfc->nextTxSeq) {
-                return;  // wrong ReqSeq, ignore
-            }
+    L2capSendPacket(conn->aclHandle, chan->lcfg.flushTimeout, spkt);
+    return;
+}
 
-            if (ctrl->txSeq == reqSeq) {
-                break;
-            }
+static L2capErfcTxPacket **L2capErfcGetTxSlot(const L2capChannel *chan, uint16_t txSeq)
+{
+    const L2capErfc *erfc = &(chan->erfc);
+    uint16_t offset;
 
-            finishedPacketNum += 1;
-            node = ListGetNextNode(node);
-        }
+    offset = L2capGetSeqWindow(chan, txSeq, erfc->expectedAckSeq);
+    return &(erfc->txRing[(erfc->txRingHead + offset) % erfc->txRingSize]);
+}
+
+static L2capErfcRxPacket *L2capErfcGetRxSlot(const L2capChannel *chan, uint16_t txSeq)
+{
+    const L2capErfc *erfc = &(chan->erfc);
+    uint16_t offset;
+
+    offset = L2capGetSeqWindow(chan, txSeq, erfc->expectedTxSeq);
+    return &(erfc->rxRing[(erfc->rxRingHead + offset) % erfc->rxRingSize]);
+}
+
+static void L2capErfcUpdateStall(L2capChannel *chan, uint8_t stalled)
+{
+    L2capErfc *erfc = &(chan->erfc);
+
+    if (erfc->stalled == stalled) {
+        return;
     }
 
-    erfc->expectedAckSeq = reqSeq;
+    erfc->stalled = stalled;
+    if (stalled) {
+        erfc->stats.windowStalls += 1;
+        erfc->stallStartMs = L2capGetTimeMs();
+    } else {
+        erfc->stats.windowStallMs += (uint32_t)(L2capGetTimeMs() - erfc->stallStartMs);
+    }
 
-    if (finishedPacketNum > 0) {
-        AlarmCancel(chan->erfc.retransmissionTimer);
+    return;
+}
 
-        if (L2capGetTxWindow(erfc) > 0) {
-            L2capErfcStartRetransmissionTimer(chan);
-        }
+static void L2capProcessRxReqSeq(L2capChannel *chan, uint16_t reqSeq)
+{
+    L2capErfc *erfc = NULL;
+    L2capErfcTxPacket *tx = NULL;
+    uint16_t finishedPacketNum;
+
+    erfc = &(chan->erfc);
+    finishedPacketNum = L2capGetSeqWindow(chan, reqSeq, erfc->expectedAckSeq);
+    if ((finishedPacketNum == 0) || (finishedPacketNum > L2capGetTxWindow(chan))) {
+        return;  // nothing acknowledged or wrong ReqSeq, ignore
+    }
+
+    if (L2capGetSeqWindow(chan, erfc->nextTxSeq, erfc->expectedAckSeq) < finishedPacketNum) {
+        erfc->nextTxSeq = reqSeq;
     }
 
     while (finishedPacketNum) {
-        node = ListGetFirstNode(erfc->txList);
-        tx = ListGetNodeData(node);
+        tx = erfc->txRing[erfc->txRingHead];
+        erfc->txRing[erfc->txRingHead] = NULL;
+        erfc->txRingHead = (erfc->txRingHead + 1) % erfc->txRingSize;
+        erfc->expectedAckSeq = L2capGetNextSeq(chan, erfc->expectedAckSeq);
 
-        ListRemoveNode(erfc->txList, tx);
+        erfc->stats.txBytes += PacketPayloadSize(tx->pkt);
         PacketFree(tx->pkt);
         L2capFree(tx);
 
         finishedPacketNum -= 1;
     }
 
+    AlarmCancel(chan->erfc.retransmissionTimer);
+    if (L2capGetTxWindow(chan) > 0) {
+        L2capErfcStartRetransmissionTimer(chan);
+    }
+
     return;
 }
 
-static void L2capErfcTxOneFrame(L2capConnection *conn, L2capChannel *chan, uint8_t txSeq)
+// send the I-frame of txSeq, which is in the tx ring
+static int L2capErfcSendTxFrame(L2capConnection *conn, L2capChannel *chan, uint16_t txSeq)
 {
-    ListNode *node = NULL;
+    L2capErfc *erfc = &(chan->erfc);
     L2capErfcTxPacket *tx = NULL;
-    uint8_t *pktHeader = NULL;
-    L2capErfcIControl *ctrl = NULL;
+    L2capErfcControl iCtrl = {0};
+    uint8_t *header = NULL;
 
-    L2capErfc *erfc = &(chan->erfc);
+    tx = *L2capErfcGetTxSlot(chan, txSeq);
+    if (tx->retryCount == chan->lcfg.rfc.maxTransmit) {
+        L2capSendDisconnectionReq(conn, chan);
+        return BT_OPERATION_FAILED;
+    }
 
-    if (erfc->txList == NULL) {
-        return;
+    iCtrl.type = L2CAP_IFRAME;
+    iCtrl.txSeq = txSeq;
+    iCtrl.reqSeq = erfc->expectedTxSeq;
+    iCtrl.fBit = L2CAP_ERFC_FBIT_OFF;
+    iCtrl.sar = tx->sar;
+
+    header = BufferPtr(PacketHead(tx->pkt));
+    L2capEncodeControl(chan, &iCtrl, header + L2CAP_HEADER_LENGTH);
+
+    if (chan->lcfg.fcs == 0x01) {
+        L2capAddCrc(tx->pkt);
     }
 
-    node = ListGetFirstNode(erfc->txList);
-    while (node != NULL) {
-        tx = ListGetNodeData(node);
-        pktHeader = BufferPtr(PacketHead(tx->pkt));
+    if (tx->retryCount == 0) {
+        erfc->stats.iFramesSent += 1;
+    } else {
+        erfc->stats.iFramesResent += 1;
+    }
 
-        ctrl = (L2capErfcIControl *)(pktHeader + L2CAP_HEADER_LENGTH);
-        if (ctrl->txSeq == erfc->nextTxSeq) {
-            break;
-        }
+    tx->retryCount += 1;
+    erfc->bufferSeq = erfc->expectedTxSeq;
+    L2capSendPacketNoFree(conn->aclHandle, chan->lcfg.flushTimeout, tx->pkt);
+    return BT_NO_ERROR;
+}
 
-        if (ctrl->txSeq == txSeq) {
-            if (tx->retryCount == chan->lcfg.rfc.maxTransmit) {
-                L2capSendDisconnectionReq(conn, chan);
-                return;
-            }
+static void L2capErfcTxOneFrame(L2capConnection *conn, L2capChannel *chan, uint16_t txSeq)
+{
+    L2capErfc *erfc = &(chan->erfc);
 
-            ctrl->reqSeq = erfc->expectedTxSeq;
-            if (chan->lcfg.fcs == 0x01) {
-                L2capAddCrc(tx->pkt);
-            }
+    if (L2capGetSeqWindow(chan, txSeq, erfc->expectedAckSeq) >= L2capGetTxWindow(chan)) {
+        return;  // not sent or already acknowledged
+    }
 
-            L2capSendPacketNoFree(conn->aclHandle, chan->lcfg.flushTimeout, tx->pkt);
-            break;
-        }
+    L2capErfcSendTxFrame(conn, chan, txSeq);
+    return;
+}
 
-        node = ListGetNextNode(node);
+// go back to reqSeq to send the I-frames again, if it is in the tx ring
+static void L2capErfcRewind(L2capChannel *chan, uint16_t reqSeq)
+{
+    L2capErfc *erfc = &(chan->erfc);
+
+    if (L2capGetSeqWindow(chan, reqSeq, erfc->expectedAckSeq) <= L2capGetTxWindow(chan)) {
+        erfc->nextTxSeq = reqSeq;
     }
 
     return;
@@ -759,60 +971,37 @@ void L2capErfcStartRetransmissionTimer(L2capChannel *chan)
     return;
 }
 
-static void L2capErfcDoTx(L2capConnection *conn, L2capChannel *chan, uint16_t txWindow, const ListNode *node)
-{
-    uint8_t *header = NULL;
-    L2capErfcTxPacket *tx = NULL;
-    L2capErfcIControl *ctrl = NULL;
 
+static int L2capErfcCreateTxRing(L2capChannel *chan)
+{
     L2capErfc *erfc = &(chan->erfc);
+    uint16_t windowSize;
 
-    while ((node != NULL) && txWindow) {
-        tx = ListGetNodeData(node);
-        if (tx->retryCount == chan->lcfg.rfc.maxTransmit) {
-            L2capSendDisconnectionReq(conn, chan);
-            return;
-        }
-
-        header = BufferPtr(PacketHead(tx->pkt));
-
-        ctrl = (L2capErfcIControl *)(header + L2CAP_HEADER_LENGTH);
-        ctrl->reqSeq = erfc->expectedTxSeq;
-
-        if (chan->lcfg.fcs == 0x01) {
-            L2capAddCrc(tx->pkt);
-        }
-
-        tx->retryCount += 1;
-        L2capSendPacketNoFree(conn->aclHandle, chan->lcfg.flushTimeout, tx->pkt);
-
-        if (txWindow == chan->lcfg.rfc.txWindowSize) {
-            L2capErfcStartRetransmissionTimer(chan);
-        }
-
-        erfc->bufferSeq = erfc->expectedTxSeq;
-        erfc->nextTxSeq = L2capGetNextSeq(erfc->nextTxSeq);
+    if (erfc->txRing != NULL) {
+        return BT_NO_ERROR;
+    }
 
-        txWindow -= 1;
-        node = ListGetNextNode(node);
+    windowSize = L2capErfcGetTxWindowSize(chan);
+    if (windowSize == 0) {
+        return BT_BAD_STATUS;
     }
 
-    if (txWindow == 0) {
-        L2capErfcRemoteBusyProcess(chan, 1);
-    } else {
-        L2capErfcRemoteBusyProcess(chan, 0);
+    erfc->txRing = L2capAlloc(windowSize * sizeof(L2capErfcTxPacket *));
+    if (erfc->txRing == NULL) {
+        return BT_NO_MEMORY;
     }
 
-    return;
+    erfc->txRingSize = windowSize;
+    erfc->txRingHead = 0;
+    return BT_NO_ERROR;
 }
 
 static void L2capErfcTx(L2capConnection *conn, L2capChannel *chan)
 {
-    uint16_t txWindow;
     ListNode *node = NULL;
     L2capErfcTxPacket *tx = NULL;
-    uint8_t *header = NULL;
-    L2capErfcIControl *ctrl = NULL;
+    uint16_t windowSize;
+    uint16_t sentNum;
 
     L2capErfc *erfc = &(chan->erfc);
 
@@ -824,25 +1013,59 @@ static void L2capErfcTx(L2capConnection *conn, L2capChannel *chan)
         return;
     }
 
-    txWindow = chan->lcfg.rfc.txWindowSize - L2capGetTxWindow(erfc);
-    if (txWindow == 0) {
+    if (L2capErfcCreateTxRing(chan) != BT_NO_ERROR) {
         return;
     }
 
-    node = ListGetFirstNode(erfc->txList);
-    while (node != NULL) {
-        tx = ListGetNodeData(node);
-        header = BufferPtr(PacketHead(tx->pkt));
+    // the retransmission timer is running if sent I-frames are waiting for the acknowledgement
+    sentNum = L2capGetSeqWindow(chan, erfc->nextTxSeq, erfc->expectedAckSeq);
+
+    // I-frames to send again, after REJ or the poll
+    while (erfc->nextTxSeq != erfc->txSeq) {
+        if (L2capErfcSendTxFrame(conn, chan, erfc->nextTxSeq) != BT_NO_ERROR) {
+            return;
+        }
+
+        erfc->nextTxSeq = L2capGetNextSeq(chan, erfc->nextTxSeq);
+    }
+
+    // fill the window with new I-frames
+    windowSize = erfc->txRingSize;
+    if (windowSize > L2capErfcGetTxWindowSize(chan)) {
+        windowSize = L2capErfcGetTxWindowSize(chan);
+    }
 
-        ctrl = (L2capErfcIControl *)(header + L2CAP_HEADER_LENGTH);
-        if (ctrl->txSeq == erfc->nextTxSeq) {
+    while (L2capGetTxWindow(chan) < windowSize) {
+        node = ListGetFirstNode(erfc->txList);
+        if (node == NULL) {
             break;
         }
 
-        node = ListGetNextNode(node);
+        tx = ListGetNodeData(node);
+        ListRemoveNode(erfc->txList, tx);
+
+        *L2capErfcGetTxSlot(chan, erfc->txSeq) = tx;
+        erfc->txSeq = L2capGetNextSeq(chan, erfc->txSeq);
+        if (L2capErfcSendTxFrame(conn, chan, erfc->nextTxSeq) != BT_NO_ERROR) {
+            return;
+        }
+
+        erfc->nextTxSeq = erfc->txSeq;
+    }
+
+    if ((sentNum == 0) && (L2capGetTxWindow(chan) > 0)) {
+        L2capErfcStartRetransmissionTimer(chan);
+    }
+
+    // the window is full while the upper layer has more to send
+    if (ListGetFirstNode(erfc->txList) != NULL) {
+        L2capErfcUpdateStall(chan, 1);
+        L2capErfcRemoteBusyProcess(chan, 1);
+    } else {
+        L2capErfcUpdateStall(chan, 0);
+        L2capErfcRemoteBusyProcess(chan, 0);
     }
 
-    L2capErfcDoTx(conn, chan, txWindow, node);
     return;
 }
 
@@ -876,19 +1099,20 @@ static void L2capStreamTx(const L2capConnection *conn, L2capChannel *chan)
     return;
 }
 
+// the control field is written here for Streaming mode, and when the I-frame is sent in Enhanced Retransmission mode
 static Packet *L2capBuildIFrame(L2capChannel *chan, const Packet *pkt, uint8_t sar, uint16_t sduLength)
 {
     L2capErfc *erfc = NULL;
-    L2capErfcIControl *iCtrl = NULL;
+    L2capErfcControl iCtrl = {0};
     Packet *ipkt = NULL;
     uint8_t *header = NULL;
     uint16_t headerLength;
     uint16_t tailLength = 0;
 
     erfc = &(chan->erfc);
-    headerLength = L2CAP_HEADER_LENGTH + L2CAP_SIZE_2;
+    headerLength = L2CAP_HEADER_LENGTH + L2capGetControlLength(chan);
     if (sar == L2CAP_ERFC_START_SDU) {
-        headerLength = L2CAP_HEADER_LENGTH + L2CAP_SIZE_4;
+        headerLength += L2CAP_SIZE_2;
     }
 
     if (chan->lcfg.fcs == 0x01) {
@@ -900,36 +1124,39 @@ static Packet *L2capBuildIFrame(L2capChannel *chan, const Packet *pkt, uint8_t s
 
     L2capCpuToLe16(header + 0, PacketSize(ipkt) - L2CAP_HEADER_LENGTH);
     L2capCpuToLe16(header + L2CAP_OFFSET_2, chan->rcid);
-    iCtrl = (L2capErfcIControl *)(header + L2CAP_HEADER_LENGTH);
 
-    iCtrl->type = L2CAP_IFRAME;
-    iCtrl->txSeq = erfc->txSeq;
-    iCtrl->reqSeq = 0;
-    iCtrl->fBit = L2CAP_ERFC_FBIT_OFF;
-    iCtrl->sar = sar;
+    iCtrl.type = L2CAP_IFRAME;
+    iCtrl.txSeq = erfc->txSeq;
+    iCtrl.reqSeq = 0;
+    iCtrl.fBit = L2CAP_ERFC_FBIT_OFF;
+    iCtrl.sar = sar;
+    L2capEncodeControl(chan, &iCtrl, header + L2CAP_HEADER_LENGTH);
 
     if (sar == L2CAP_ERFC_START_SDU) {
-        L2capCpuToLe16(header + L2CAP_OFFSET_6, sduLength);
+        L2capCpuToLe16(header + L2CAP_HEADER_LENGTH + L2capGetControlLength(chan), sduLength);
     }
 
     return ipkt;
 }
 
-static void L2capAddNewPacket(L2capChannel *chan, Packet *pkt)
+static void L2capAddNewPacket(L2capChannel *chan, Packet *pkt, uint8_t sar)
 {
     if (chan->lcfg.rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) {
         L2capErfcTxPacket *tx = NULL;
 
         tx = L2capAlloc(sizeof(L2capErfcTxPacket));
         if (tx == NULL) {
+            PacketFree(pkt);
             return;
         }
         tx->pkt = pkt;
         tx->retryCount = 0;
+        tx->sar = sar;
 
         ListAddLast(chan->erfc.txList, tx);
     } else if (chan->lcfg.rfc.mode == L2CAP_STREAM_MODE) {
         ListAddLast(chan->erfc.txList, pkt);
+        chan->erfc.txSeq = L2capGetNextSeq(chan, chan->erfc.txSeq);
     }
 
     return;
@@ -958,8 +1185,7 @@ int L2capSendIFrame(L2capConnection *conn, L2capChannel *chan, Packet *pkt)
             ipkt = L2capBuildIFrame(chan, frag, sar, length);
             PacketFree(frag);
 
-            L2capAddNewPacket(chan, ipkt);
-            erfc->txSeq = L2capGetNextSeq(erfc->txSeq);
+            L2capAddNewPacket(chan, ipkt, sar);
 
             if (remainLength == 0) {
                 break;
@@ -974,8 +1200,7 @@ int L2capSendIFrame(L2capConnection *conn, L2capChannel *chan, Packet *pkt)
         sar = L2CAP_ERFC_UNSEGMENTED_SDU;
         ipkt = L2capBuildIFrame(chan, pkt, sar, 0);
 
-        L2capAddNewPacket(chan, ipkt);
-        erfc->txSeq = L2capGetNextSeq(erfc->txSeq);
+        L2capAddNewPacket(chan, ipkt, sar);
     }
 
     if (chan->lcfg.rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) {
@@ -987,27 +1212,25 @@ int L2capSendIFrame(L2capConnection *conn, L2capChannel *chan, Packet *pkt)
     return BT_NO_ERROR;
 }
 
-static void L2capErfcProcessFBit(L2capChannel *chan, uint8_t fBit, uint8_t reqSeq)
+static void L2capErfcProcessFBit(L2capChannel *chan, uint8_t fBit, uint16_t reqSeq)
 {
     if (chan->erfc.busyState & L2CAP_BUSY_WAIT_F) {
         if (fBit == L2CAP_ERFC_FBIT_ON) {
             AlarmCancel(chan->erfc.monitorTimer);
             chan->erfc.busyState &= (~L2CAP_BUSY_WAIT_F);
             chan->erfc.retryCount = 0;
-            chan->erfc.nextTxSeq = reqSeq;
+            L2capErfcRewind(chan, reqSeq);
         }
     }
 
     return;
 }
 
-static void L2capErfcProcessSFrame(L2capConnection *conn, L2capChannel *chan, uint8_t ctrl[2])
+static void L2capErfcProcessSFrame(L2capConnection *conn, L2capChannel *chan, const L2capErfcControl *sCtrl)
 {
     L2capErfc *erfc = NULL;
-    L2capErfcSControl *sCtrl = NULL;
 
     erfc = &(chan->erfc);
-    sCtrl = (L2capErfcSControl *)ctrl;
 
     if ((sCtrl->sBit != L2CAP_ERFC_SREJ) || (sCtrl->pBit != L2CAP_ERFC_PBIT_OFF)) {
         L2capProcessRxReqSeq(chan, sCtrl->reqSeq);
@@ -1029,35 +1252,37 @@ static void L2capErfcProcessSFrame(L2capConnection *conn, L2capChannel *chan, ui
             L2capErfcTx(conn, chan);
         }
     } else if (sCtrl->sBit == L2CAP_ERFC_REJ) {
-        erfc->nextTxSeq = sCtrl->reqSeq;
+        erfc->stats.rejReceived += 1;
+        L2capErfcRewind(chan, sCtrl->reqSeq);
         L2capErfcTx(conn, chan);
     } else if (sCtrl->sBit == L2CAP_ERFC_RNR) {
         erfc->busyState |= L2CAP_BUSY_REMOTE_RNR;
         L2capErfcRemoteBusyProcess(chan, 1);
     } else if (sCtrl->sBit == L2CAP_ERFC_SREJ) {
+        erfc->stats.srejReceived += 1;
         L2capErfcTxOneFrame(conn, chan, sCtrl->reqSeq);
     }
 
     return;
 }
 
-static Packet *L2capReassembleIFrame(L2capErfc *erfc, const Packet *pkt, L2capErfcIControl *iCtrl)
+static Packet *L2capReassembleIFrame(L2capErfc *erfc, const Packet *pkt, uint8_t sar)
 {
     Packet *ipkt = NULL;
 
-    if (iCtrl->sar == L2CAP_ERFC_START_SDU) {
+    if (sar == L2CAP_ERFC_START_SDU) {
         if (erfc->rxSarPacket != NULL) {
             PacketFree(erfc->rxSarPacket);
         }
 
         erfc->rxSarPacket = PacketRefMalloc(pkt);
-    } else if (iCtrl->sar == L2CAP_ERFC_CONTINUATION_SDU) {
+    } else if (sar == L2CAP_ERFC_CONTINUATION_SDU) {
         if (erfc->rxSarPacket == NULL) {
             return NULL;
         }
 
         PacketAssemble(erfc->rxSarPacket, pkt);
-    } else if (iCtrl->sar == L2CAP_ERFC_END_SDU) {
+    } else if (sar == L2CAP_ERFC_END_SDU) {
         uint8_t header[2] = {0};
         uint8_t *headerPtr = NULL;
         uint16_t sduLength;
@@ -1080,55 +1305,241 @@ static Packet *L2capReassembleIFrame(L2capErfc *erfc, const Packet *pkt, L2capEr
 
         ipkt = erfc->rxSarPacket;
         erfc->rxSarPacket = NULL;
-    } else if (iCtrl->sar == L2CAP_ERFC_UNSEGMENTED_SDU) {
+    } else if (sar == L2CAP_ERFC_UNSEGMENTED_SDU) {
         ipkt = PacketRefMalloc(pkt);
     }
 
     return ipkt;
 }
 
-static Packet *L2capErfcProcessIFrame(L2capConnection *conn, L2capChannel *chan, const Packet *pkt, uint8_t ctrl[2])
+/**
+ * @brief Pass the I-frame of expectedTxSeq to reassembly, and a complete SDU to the upper layer.
+ *
+ * @return Returns 1 if a SDU is delivered.
+ */
+static uint8_t L2capErfcDeliver(L2capChannel *chan, const Packet *pkt, uint8_t sar)
 {
-    L2capErfc *erfc = NULL;
-    L2capErfcIControl *iCtrl = NULL;
+    L2capErfc *erfc = &(chan->erfc);
+    L2capPsm *psm = NULL;
     Packet *ipkt = NULL;
 
-    erfc = &(chan->erfc);
-    iCtrl = (L2capErfcIControl *)ctrl;
+    erfc->expectedTxSeq = L2capGetNextSeq(chan, erfc->expectedTxSeq);
+    if (erfc->rxRing != NULL) {
+        erfc->rxRing[erfc->rxRingHead].srejOrder = 0;
+        erfc->rxRingHead = (erfc->rxRingHead + 1) % erfc->rxRingSize;
+    }
 
-    L2capProcessRxReqSeq(chan, iCtrl->reqSeq);
+    ipkt = L2capReassembleIFrame(erfc, pkt, sar);
+    if (ipkt == NULL) {
+        return 0;
+    }
 
-    L2capErfcProcessFBit(chan, iCtrl->fBit, iCtrl->reqSeq);
+    erfc->stats.rxBytes += PacketSize(ipkt);
 
-    if (erfc->expectedTxSeq != iCtrl->txSeq) {
+    psm = L2capGetPsm(chan->lpsm);
+    if (psm != NULL) {
+        LOG_DEBUG("L2capCallback recvData: begin, cid = 0x%04X, pktLen = %u", chan->lcid, PacketSize(ipkt));
+        psm->service.recvData(chan->lcid, ipkt, psm->ctx);
+        LOG_DEBUG("L2capCallback recvData:%{public}d end", __LINE__);
+    }
+
+    PacketFree(ipkt);
+    return 1;
+}
+
+// the upper layer may release the channel in the recvData callback
+static int L2capChannelReleased(uint16_t lcid, const L2capChannel *chan)
+{
+    L2capConnection *conn = NULL;
+    L2capChannel *current = NULL;
+
+    L2capGetChannel2(lcid, &conn, &current);
+    return (current != chan);
+}
+
+// deliver the I-frames buffered after expectedTxSeq, up to the next missing one
+static uint8_t L2capErfcDeliverBuffered(L2capChannel *chan)
+{
+    L2capErfc *erfc = &(chan->erfc);
+    L2capErfcRxPacket *rx = NULL;
+    Packet *pkt = NULL;
+    uint16_t lcid = chan->lcid;
+    uint8_t delivered = 0;
+
+    while ((erfc->rxRing != NULL) && (erfc->expectedTxSeq != erfc->rxHighSeq)) {
+        rx = &(erfc->rxRing[erfc->rxRingHead]);
+        if (rx->pkt == NULL) {
+            break;
+        }
+
+        pkt = rx->pkt;
+        rx->pkt = NULL;
+        delivered |= L2capErfcDeliver(chan, pkt, rx->sar);
+        PacketFree(pkt);
+
+        if (L2capChannelReleased(lcid, chan)) {
+            break;
+        }
+    }
+
+    return delivered;
+}
+
+static int L2capErfcCreateRxRing(L2capChannel *chan)
+{
+    L2capErfc *erfc = &(chan->erfc);
+    uint16_t windowSize;
+
+    if (erfc->rxRing != NULL) {
+        return BT_NO_ERROR;
+    }
+
+    // a retransmission is told from a new I-frame only if the window is up to half the sequence numbers
+    windowSize = L2capErfcGetRxWindowSize(chan);
+    if ((windowSize == 0) || (windowSize > ((L2capGetSeqMask(chan) + 1) / L2CAP_SIZE_2))) {
+        return BT_BAD_STATUS;
+    }
+
+    erfc->rxRing = L2capAlloc(windowSize * sizeof(L2capErfcRxPacket));
+    if (erfc->rxRing == NULL) {
+        return BT_NO_MEMORY;
+    }
+
+    erfc->rxRingSize = windowSize;
+    erfc->rxRingHead = 0;
+    return BT_NO_ERROR;
+}
+
+static void L2capErfcSendSrejAgain(const L2capConnection *conn, L2capChannel *chan, uint32_t srejOrder)
+{
+    L2capErfc *erfc = &(chan->erfc);
+    L2capErfcRxPacket *rx = NULL;
+    uint16_t seq;
+
+    for (seq = erfc->expectedTxSeq; seq != erfc->rxHighSeq; seq = L2capGetNextSeq(chan, seq)) {
+        rx = L2capErfcGetRxSlot(chan, seq);
+        if ((rx->pkt == NULL) && (rx->srejOrder != 0) && (rx->srejOrder < srejOrder)) {
+            erfc->srejCount += 1;
+            rx->srejOrder = erfc->srejCount;
+            L2capErfcSendSrej(conn, chan, seq);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Buffer an I-frame received ahead of expectedTxSeq, and SREJ the missing ones before it.
+ *
+ * As the retransmissions are sent in the order of the SREJ, a retransmission received means the ones requested
+ * before it are lost again, and they are requested once more.
+ */
+static void L2capErfcProcessOutOfSequence(
+    L2capConnection *conn, L2capChannel *chan, const Packet *pkt, const L2capErfcControl *iCtrl, uint16_t offset)
+{
+    L2capErfc *erfc = &(chan->erfc);
+    L2capErfcRxPacket *rx = NULL;
+    uint32_t srejOrder;
+    uint16_t seq;
+
+    erfc->stats.rxOutOfSequence += 1;
+
+    // without the ring (window over half the sequence numbers, or no memory), or beyond it if the window grows by
+    // a reconfiguration, go back to expectedTxSeq with REJ
+    if ((L2capErfcCreateRxRing(chan) != BT_NO_ERROR) || (offset >= erfc->rxRingSize)) {
         if (erfc->rejState == 0) {
             L2capSendSFrame(conn, chan, L2CAP_ERFC_PBIT_OFF, L2CAP_ERFC_FBIT_OFF, L2CAP_ERFC_REJ);
             erfc->rejState = 1;
         }
 
-        return NULL;
+        return;
     }
 
-    erfc->rejState = 0;
-    erfc->expectedTxSeq = L2capGetNextSeq(erfc->expectedTxSeq);
+    rx = L2capErfcGetRxSlot(chan, iCtrl->txSeq);
+    if (offset < L2capGetSeqWindow(chan, erfc->rxHighSeq, erfc->expectedTxSeq)) {
+        if (rx->pkt != NULL) {
+            erfc->stats.rxDuplicated += 1;
+            return;
+        }
 
-    ipkt = L2capReassembleIFrame(erfc, pkt, iCtrl);
+        srejOrder = rx->srejOrder;
+        rx->pkt = PacketRefMalloc(pkt);
+        rx->sar = iCtrl->sar;
+        rx->srejOrder = 0;
 
-    if (L2capGetRxWindow(erfc) == (chan->rcfg.rfc.txWindowSize - 1)) {
-        L2capSendSFrame(conn, chan, L2CAP_ERFC_PBIT_OFF, L2CAP_ERFC_FBIT_OFF, L2CAP_ERFC_RR);
-    } else {
-        if (ipkt != NULL) {                        // full packet received
-            if (erfc->nextTxSeq == erfc->txSeq) {  // no pending packet in list
-                L2capSendSFrame(conn, chan, L2CAP_ERFC_PBIT_OFF, L2CAP_ERFC_FBIT_OFF, L2CAP_ERFC_RR);
+        L2capErfcSendSrejAgain(conn, chan, srejOrder);
+        return;
+    }
+
+    for (seq = erfc->rxHighSeq; seq != iCtrl->txSeq; seq = L2capGetNextSeq(chan, seq)) {
+        erfc->srejCount += 1;
+        L2capErfcGetRxSlot(chan, seq)->srejOrder = erfc->srejCount;
+        L2capErfcSendSrej(conn, chan, seq);
+    }
+
+    rx->pkt = PacketRefMalloc(pkt);
+    rx->sar = iCtrl->sar;
+    erfc->rxHighSeq = L2capGetNextSeq(chan, iCtrl->txSeq);
+    return;
+}
+
+static void L2capErfcProcessIFrame(
+    L2capConnection *conn, L2capChannel *chan, const Packet *pkt, const L2capErfcControl *iCtrl)
+{
+    L2capErfc *erfc = NULL;
+    uint16_t lcid = chan->lcid;
+    uint16_t unacked;
+    uint16_t offset;
+    uint16_t ackThreshold;
+    uint8_t delivered = 0;
+
+    erfc = &(chan->erfc);
+
+    L2capProcessRxReqSeq(chan, iCtrl->reqSeq);
+
+    L2capErfcProcessFBit(chan, iCtrl->fBit, iCtrl->reqSeq);
+
+    // the remote sends within the window starting at the last acknowledged one (bufferSeq), so the TxSeq is
+    // placed from there: the window is up to 63 of the 64 sequence numbers, and expectedTxSeq alone is ambiguous
+    unacked = L2capGetRxWindow(chan);
+    offset = L2capGetSeqWindow(chan, iCtrl->txSeq, erfc->bufferSeq);
+    if (offset < unacked) {
+        erfc->stats.rxDuplicated += 1;
+    } else if ((offset - unacked) == 0) {
+        uint8_t recovering = (erfc->rxHighSeq != erfc->expectedTxSeq);
+
+        erfc->rejState = 0;
+        delivered = L2capErfcDeliver(chan, pkt, iCtrl->sar);
+        if (L2capChannelReleased(lcid, chan)) {
+            return;
+        }
+
+        if (recovering) {
+            delivered |= L2capErfcDeliverBuffered(chan);
+            if (L2capChannelReleased(lcid, chan)) {
+                return;
             }
+        } else {
+            erfc->rxHighSeq = erfc->expectedTxSeq;
         }
+    } else if (offset < L2capErfcGetRxWindowSize(chan)) {
+        L2capErfcProcessOutOfSequence(conn, chan, pkt, iCtrl, offset - unacked);
+    } else {
+        erfc->stats.rxDuplicated += 1;
     }
 
+    // acknowledge with the I-frames to send if any, or with RR once a quarter of the window or a SDU is received
     L2capErfcTx(conn, chan);
-    return ipkt;
+
+    ackThreshold = (L2capErfcGetRxWindowSize(chan) + L2CAP_ERFC_ACK_FRACTION - 1) / L2CAP_ERFC_ACK_FRACTION;
+    if ((L2capGetRxWindow(chan) > 0) && ((L2capGetRxWindow(chan) >= ackThreshold) || delivered)) {
+        L2capSendSFrame(conn, chan, L2CAP_ERFC_PBIT_OFF, L2CAP_ERFC_FBIT_OFF, L2CAP_ERFC_RR);
+    }
+
+    return;
 }
 
-static Packet *L2capStreamProcessIFrame(L2capChannel *chan, const Packet *pkt, L2capErfcIControl *iCtrl)
+static Packet *L2capStreamProcessIFrame(L2capChannel *chan, const Packet *pkt, const L2capErfcControl *iCtrl)
 {
     L2capErfc *erfc = NULL;
     Packet *ipkt = NULL;
@@ -1141,12 +1552,40 @@ static Packet *L2capStreamProcessIFrame(L2capChannel *chan, const Packet *pkt, L
         }
     }
 
-    erfc->expectedTxSeq = L2capGetNextSeq(iCtrl->txSeq);
-    ipkt = L2capReassembleIFrame(erfc, pkt, iCtrl);
+    erfc->expectedTxSeq = L2capGetNextSeq(chan, iCtrl->txSeq);
+    ipkt = L2capReassembleIFrame(erfc, pkt, iCtrl->sar);
 
     return ipkt;
 }
 
+void L2capErfcGetStatistics(const L2capChannel *chan, L2capErfcStatistics *stats)
+{
+    const L2capErfc *erfc = &(chan->erfc);
+    uint64_t now = L2capGetTimeMs();
+
+    (void)memcpy_s(stats, sizeof(L2capErfcStatistics), &(erfc->stats), sizeof(L2capErfcStatistics));
+    if (erfc->stalled) {
+        stats->windowStallMs += (uint32_t)(now - erfc->stallStartMs);
+    }
+
+    stats->durationMs = 0;
+    stats->txThroughput = 0;
+    stats->rxThroughput = 0;
+    if (erfc->connectedMs != 0) {
+        stats->durationMs = (uint32_t)(now - erfc->connectedMs);
+    }
+
+    if (stats->durationMs > 0) {
+        stats->txThroughput = (uint32_t)(stats->txBytes * L2CAP_MS_PER_SECOND / stats->durationMs);
+        stats->rxThroughput = (uint32_t)(stats->rxBytes * L2CAP_MS_PER_SECOND / stats->durationMs);
+    }
+
+    stats->txWindowSize = L2capErfcGetTxWindowSize(chan);
+    stats->rxWindowSize = L2capErfcGetRxWindowSize(chan);
+    stats->extendedControl = erfc->extControl;
+    return;
+}
+
 static int L2capCheckConfigurationOptionLength(uint8_t optType, uint8_t optLength)
 {
     switch (optType) {
@@ -1179,6 +1618,12 @@ static int L2capCheckConfigurationOptionLength(uint8_t optType, uint8_t optLengt
                 return BT_BAD_PARAM;
             }
 
+            break;
+        case L2CAP_OPTION_EXTENDED_WINDOW_SIZE:
+            if (optLength != L2CAP_SIZE_2) {
+                return BT_BAD_PARAM;
+            }
+
             break;
         default:
             break;
@@ -1200,7 +1645,8 @@ static void L2capProcessErfcOption(const uint8_t *data, uint16_t offset, L2capCo
     return;
 }
 
-static int L2capParseConfiguration(const uint8_t *data, uint16_t length, L2capConfigInfo *cfg, L2capOptions *unknown)
+static int L2capParseConfiguration(
+    const uint8_t *data, uint16_t length, L2capConfigInfo *cfg, L2capOptions *unknown, uint16_t *extWindowSize)
 {
     uint16_t offset = 0;
 
@@ -1234,8 +1680,15 @@ static int L2capParseConfiguration(const uint8_t *data, uint16_t length, L2capCo
                     return BT_BAD_PARAM;
                 }
                 break;
-            case L2CAP_OPTION_EXTENDED_FLOW_SPECIFICATION:  // dummy
             case L2CAP_OPTION_EXTENDED_WINDOW_SIZE:
+                if (extWindowSize != NULL) {
+                    *extWindowSize = L2capLe16ToCpu(data + offset + L2CAP_OFFSET_2);
+                    if (*extWindowSize > L2CAP_MAX_EXT_TX_WINDOW) {
+                        return BT_BAD_PARAM;
+                    }
+                }
+                break;
+            case L2CAP_OPTION_EXTENDED_FLOW_SPECIFICATION:  // dummy
                 return BT_BAD_PARAM;
             default:
                 if ((optType & L2CAP_OPTION_HINT) || (unknown == NULL)) {
@@ -1397,8 +1850,9 @@ static void L2capProcessConfigurationReqParse(
     (void)memcpy_s(&cfg, sizeof(L2capConfigInfo), &(chan->rcfg), sizeof(L2capConfigInfo));
     if (optLength > 0) {
         L2capOptions unknown = {0};
+        uint16_t extWindowSize = 0;
 
-        if (L2capParseConfiguration(data, optLength, &cfg, &unknown) != BT_NO_ERROR) {
+        if (L2capParseConfiguration(data, optLength, &cfg, &unknown, &extWindowSize) != BT_NO_ERROR) {
             if (unknown.options != NULL) {
                 L2capFree(unknown.options);
             }
@@ -1415,12 +1869,18 @@ static void L2capProcessConfigurationReqParse(
             return;
         }
 
+        // the extended window size option overrides the TxWindow field of the RFC option
+        chan->rwin.rxWindowSize = cfg.rfc.txWindowSize;
+        if (extWindowSize != 0) {
+            chan->rwin.rxWindowSize = extWindowSize;
+            chan->erfc.extControl = 1;
+        }
+
         chan->rcfg.mtu = cfg.mtu;
         chan->rcfg.fcs = cfg.fcs;
         chan->rcfg.flushTimeout = cfg.flushTimeout;
         chan->rcfg.rfc.mode = cfg.rfc.mode;
         chan->rcfg.rfc.maxTransmit = cfg.rfc.maxTransmit;
-        chan->rcfg.rfc.rxWindowSize = cfg.rfc.txWindowSize;
         chan->rcfg.rfc.mps = cfg.rfc.mps;
     }
 
@@ -1531,12 +1991,12 @@ static void L2capProcessConfigurationRsp(uint16_t aclHandle, L2capSignalHeader *
 
     (void)memcpy_s(&cfg, sizeof(L2capConfigInfo), &(chan->lcfg), sizeof(L2capConfigInfo));
     if (signal->length > L2CAP_SIZE_6) {
-        L2capParseConfiguration(data + L2CAP_OFFSET_6, signal->length - L2CAP_SIZE_6, &cfg, NULL);
+        L2capParseConfiguration(data + L2CAP_OFFSET_6, signal->length - L2CAP_SIZE_6, &cfg, NULL, NULL);
 
         if (cfg.rfc.mode == L2CAP_ENHANCED_RETRANSMISSION_MODE) {
             chan->rcfg.rfc.retransmissionTimeout = cfg.rfc.retransmissionTimeout;
             chan->rcfg.rfc.monitorTimeout = cfg.rfc.monitorTimeout;
-            chan->rcfg.rfc.txWindowSize = cfg.rfc.txWindowSize;
+            chan->rwin.txWindowSize = cfg.rfc.txWindowSize;
         }
     }
 
@@ -2039,9 +2499,9 @@ static void L2capProcessSignal(uint16_t aclHandle, const Packet *pkt)
 
 static Packet *L2capProcessStreamData(L2capChannel *chan, Packet *pkt)
 {
-    uint8_t header[6] = {0};
+    uint8_t header[L2CAP_HEADER_LENGTH + L2CAP_SIZE_4] = {0};
     Packet *outPkt = NULL;
-    L2capErfcIControl *iCtrl = NULL;
+    L2capErfcControl iCtrl = {0};
 
     if (chan->lcfg.fcs == 0x01) {
         if (L2capCheckCrc(pkt) != BT_NO_ERROR) {
@@ -2049,35 +2509,37 @@ static Packet *L2capProcessStreamData(L2capChannel *chan, Packet *pkt)
         }
     }
 
-    PacketExtractHead(pkt, header, sizeof(header));
+    PacketExtractHead(pkt, header, L2CAP_HEADER_LENGTH + L2capGetControlLength(chan));
 
-    iCtrl = (L2capErfcIControl *)(header + L2CAP_HEADER_LENGTH);
-    if (iCtrl->type == L2CAP_IFRAME) {
-        outPkt = L2capStreamProcessIFrame(chan, pkt, iCtrl);
+    L2capDecodeControl(chan, header + L2CAP_HEADER_LENGTH, &iCtrl);
+    if (iCtrl.type == L2CAP_IFRAME) {
+        outPkt = L2capStreamProcessIFrame(chan, pkt, &iCtrl);
     }
 
     return outPkt;
 }
 
-static Packet *L2capProcessErfcData(L2capConnection *conn, L2capChannel *chan, Packet *pkt)
+static void L2capProcessErfcData(L2capConnection *conn, L2capChannel *chan, Packet *pkt)
 {
-    uint8_t header[6] = {0};
-    Packet *outPkt = NULL;
+    uint8_t header[L2CAP_HEADER_LENGTH + L2CAP_SIZE_4] = {0};
+    L2capErfcControl ctrl = {0};
 
     if (chan->lcfg.fcs == 0x01) {
         if (L2capCheckCrc(pkt) != BT_NO_ERROR) {
-            return NULL;
+            return;
         }
     }
 
-    PacketExtractHead(pkt, header, sizeof(header));
-    if (header[L2CAP_HEADER_LENGTH] & L2CAP_SFRAME) {
-        L2capErfcProcessSFrame(conn, chan, header + L2CAP_HEADER_LENGTH);
-    } else {  // I Frame
-        outPkt = L2capErfcProcessIFrame(conn, chan, pkt, header + L2CAP_HEADER_LENGTH);
+    PacketExtractHead(pkt, header, L2CAP_HEADER_LENGTH + L2capGetControlLength(chan));
+
+    L2capDecodeControl(chan, header + L2CAP_HEADER_LENGTH, &ctrl);
+    if (ctrl.type == L2CAP_SFRAME) {
+        L2capErfcProcessSFrame(conn, chan, &ctrl);
+    } else {  // I Frame, the complete SDUs are passed to the upper layer
+        L2capErfcProcessIFrame(conn, chan, pkt, &ctrl);
     }
 
-    return outPkt;
+    return;
 }
 
 static int L2capProcessBasicData(const L2capChannel *chan, Packet *pkt)
@@ -2124,14 +2586,7 @@ static void L2capProcessData(uint16_t aclHandle, uint16_t cid, Packet *pkt)
             }
             break;
         case L2CAP_ENHANCED_RETRANSMISSION_MODE:
-            outPkt = L2capProcessErfcData(conn, chan, pkt);
-            if (outPkt != NULL) {
-                LOG_DEBUG("L2capCallback recvData: begin, cid = 0x%04X, pktLen = %u", cid, PacketSize(outPkt));
-                psm->service.recvData(cid, outPkt, psm->ctx);
-                LOG_DEBUG("L2capCallback recvData:%{public}d end", __LINE__);
-
-                PacketFree(outPkt);
-            }
+            L2capProcessErfcData(conn, chan, pkt);
             break;
         case L2CAP_STREAM_MODE:
             outPkt = L2capProcessStreamData(chan, pkt);
@@ -2225,7 +2680,7 @@ int L2capConnectComplete(const BtAddr *addr, uint16_t handle, uint8_t status)
         conn = L2capNewConnection(addr, handle);
     }
 
-    conn->aclHandle = handle;
+    L2capSetConnectionHandle(conn, handle);
     conn->state = L2CAP_CONNECTION_CONNECTED;
 
     if (ListGetFirstNode(conn->chanList) != NULL) {
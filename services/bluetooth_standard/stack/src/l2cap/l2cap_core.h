@@ -57,7 +57,33 @@ extern "C" {
 #define L2CAP_IFRAME 0x00
 #define L2CAP_SFRAME 0x01
 
-#define L2CAP_MAX_TX_WINDOW 64
+// bit positions in the enhanced control field
+#define L2CAP_CTRL_TXSEQ_SHIFT 1
+#define L2CAP_CTRL_SBIT_SHIFT 2
+#define L2CAP_CTRL_PBIT_SHIFT 4
+#define L2CAP_CTRL_FBIT_SHIFT 7
+#define L2CAP_CTRL_REQSEQ_SHIFT 8
+#define L2CAP_CTRL_SAR_SHIFT 14
+#define L2CAP_CTRL_SAR_MASK 0x03
+#define L2CAP_CTRL_SBIT_MASK 0x03
+
+// bit positions in the two 16-bit halves of the extended control field
+#define L2CAP_EXT_CTRL_FBIT_SHIFT 1
+#define L2CAP_EXT_CTRL_REQSEQ_SHIFT 2
+#define L2CAP_EXT_CTRL_TXSEQ_SHIFT 2
+#define L2CAP_EXT_CTRL_PBIT_SHIFT 2
+
+// sequence numbers and windows of the enhanced and the extended control field
+#define L2CAP_SEQ_MASK 0x003F
+#define L2CAP_EXT_SEQ_MASK 0x3FFF
+#define L2CAP_MAX_TX_WINDOW 63
+#define L2CAP_MAX_EXT_TX_WINDOW 0x3FFF
+
+// RR is sent once this fraction of the receive window is not acknowledged
+#define L2CAP_ERFC_ACK_FRACTION 4
+
+#define L2CAP_MS_PER_SECOND 1000
+#define L2CAP_NS_PER_MS 1000000
 
 // for callback
 int L2capDisconnectComplete(uint16_t handle, uint8_t status, uint8_t reason);
@@ -68,7 +94,7 @@ int L2capSendEchoReq(L2capConnection *conn, const uint8_t *data, uint16_t dataLe
 int L2capSendEchoRsp(L2capConnection *conn, uint8_t ident, const uint8_t *data, uint16_t dataLen);
 int L2capSendConnectionReq(L2capConnection *conn, L2capChannel *chan);
 int L2capSendConnectionRsp(L2capConnection *conn, L2capChannel *chan, uint8_t ident, uint16_t result, uint16_t status);
-int L2capSendConfigurationReq(L2capConnection *conn, const L2capChannel *chan);
+int L2capSendConfigurationReq(L2capConnection *conn, L2capChannel *chan);
 int L2capSendConfigurationRsp(
     const L2capConnection *conn, L2capChannel *chan, uint8_t ident, uint16_t result, const L2capConfigInfo *cfg);
 int L2capSendDisconnectionReq(L2capConnection *conn, L2capChannel *chan);
@@ -81,6 +107,7 @@ int L2capSendIFrame(L2capConnection *conn, L2capChannel *chan, Packet *pkt);
 
 void L2capErfcStartRetransmissionTimer(L2capChannel *chan);
 void L2capErfcStartMonitorTimer(L2capChannel *chan);
+void L2capErfcGetStatistics(const L2capChannel *chan, L2capErfcStatistics *stats);
 
 #ifdef __cplusplus
 }
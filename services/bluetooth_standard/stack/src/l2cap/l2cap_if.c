@@ -207,6 +207,7 @@ void L2CIF_ConnectRsp(
 typedef struct {
     uint16_t lcid;
     L2capConfigInfo cfg;
+    uint16_t rxWindowSize;
     void (*cb)(uint16_t lcid, int result);
 } L2cifConfigReqContext;
 
@@ -217,7 +218,7 @@ static void L2cifConfigReq(const void *context)
 
     ctx = (L2cifConfigReqContext *)context;
 
-    result = L2CAP_ConfigReq(ctx->lcid, &(ctx->cfg));
+    result = L2CAP_ExtendedConfigReq(ctx->lcid, &(ctx->cfg), ctx->rxWindowSize);
     if (ctx->cb != NULL) {
         ctx->cb(ctx->lcid, result);
     }
@@ -227,6 +228,12 @@ static void L2cifConfigReq(const void *context)
 }
 
 int L2CIF_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, void (*cb)(uint16_t lcid, int result))
+{
+    return L2CIF_ExtendedConfigReq(lcid, cfg, 0, cb);
+}
+
+int L2CIF_ExtendedConfigReq(
+    uint16_t lcid, const L2capConfigInfo *cfg, uint16_t rxWindowSize, void (*cb)(uint16_t lcid, int result))
 {
     L2cifConfigReqContext *ctx = NULL;
 
@@ -241,6 +248,7 @@ int L2CIF_ConfigReq(uint16_t lcid, const L2capConfigInfo *cfg, void (*cb)(uint16
 
     ctx->lcid = lcid;
     (void)memcpy_s(&(ctx->cfg), sizeof(L2capConfigInfo), cfg, sizeof(L2capConfigInfo));
+    ctx->rxWindowSize = rxWindowSize;
     ctx->cb = cb;
 
     L2capAsynchronousProcess(L2cifConfigReq, L2capFree, ctx);
@@ -467,6 +475,46 @@ int L2CIF_SendData(uint16_t lcid, const Packet *pkt, void (*cb)(uint16_t lcid, i
     return BT_NO_ERROR;
 }
 
+typedef struct {
+    uint16_t lcid;
+    void (*cb)(uint16_t lcid, const L2capErfcStatistics *stats, int result);
+} L2cifGetErfcStatisticsContext;
+
+static void L2cifGetErfcStatistics(const void *context)
+{
+    L2cifGetErfcStatisticsContext *ctx = NULL;
+    L2capErfcStatistics stats = {0};
+    int result;
+
+    ctx = (L2cifGetErfcStatisticsContext *)context;
+
+    result = L2CAP_GetErfcStatistics(ctx->lcid, &stats);
+    ctx->cb(ctx->lcid, &stats, result);
+
+    L2capFree(ctx);
+    return;
+}
+
+int L2CIF_GetErfcStatistics(uint16_t lcid, void (*cb)(uint16_t lcid, const L2capErfcStatistics *stats, int result))
+{
+    L2cifGetErfcStatisticsContext *ctx = NULL;
+
+    if (cb == NULL) {
+        return BT_BAD_PARAM;
+    }
+
+    ctx = L2capAlloc(sizeof(L2cifGetErfcStatisticsContext));
+    if (ctx == NULL) {
+        return BT_NO_MEMORY;
+    }
+
+    ctx->lcid = lcid;
+    ctx->cb = cb;
+
+    L2capAsynchronousProcess(L2cifGetErfcStatistics, L2capFree, ctx);
+    return BT_NO_ERROR;
+}
+
 typedef struct {
     L2capEcho echoCallback;
     void *context;
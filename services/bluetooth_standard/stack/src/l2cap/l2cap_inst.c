@@ -20,9 +20,13 @@
 #include <string.h>
 
 #include "log.h"
+#include "platform_def.h"
 
 #include "l2cap_cmn.h"
 
+#define L2CAP_CHANNEL_BUCKET(lcid) ((lcid) & (L2CAP_CHANNEL_TABLE_SIZE - 1))
+#define L2CAP_CONNECTION_BUCKET(aclHandle) ((aclHandle) & (L2CAP_CONNECTION_TABLE_SIZE - 1))
+
 static L2capInstance g_l2capInst;
 
 L2capInstance *L2capGetInstance()
@@ -60,20 +64,164 @@ L2capPsm *L2capGetPsm(uint16_t lpsm)
     return NULL;
 }
 
-L2capConnection *L2capGetConnection(uint16_t aclHandle)
+static void L2capIndexConnection(L2capConnection *conn)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capConnection **bucket = &(inst->connTable[L2CAP_CONNECTION_BUCKET(conn->aclHandle)]);
+
+    conn->hashNext = *bucket;
+    *bucket = conn;
+    return;
+}
+
+static void L2capUnindexConnection(const L2capConnection *conn)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capConnection **prev = &(inst->connTable[L2CAP_CONNECTION_BUCKET(conn->aclHandle)]);
+
+    while ((*prev) != NULL) {
+        if ((*prev) == conn) {
+            *prev = conn->hashNext;
+            break;
+        }
+
+        prev = &((*prev)->hashNext);
+    }
+
+    return;
+}
+
+static void L2capIndexChannel(L2capChannel *chan)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capChannel **bucket = &(inst->chanTable[L2CAP_CHANNEL_BUCKET(chan->lcid)]);
+
+    chan->hashNext = *bucket;
+    *bucket = chan;
+    return;
+}
+
+static void L2capUnindexChannel(const L2capChannel *chan)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capChannel **prev = &(inst->chanTable[L2CAP_CHANNEL_BUCKET(chan->lcid)]);
+
+    while ((*prev) != NULL) {
+        if ((*prev) == chan) {
+            *prev = chan->hashNext;
+            break;
+        }
+
+        prev = &((*prev)->hashNext);
+    }
+
+    return;
+}
+
+// The channels may already be taken off the chanList of the connection, so they are found by the table.
+static void L2capUnindexChannels(const L2capConnection *conn)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capChannel **prev = NULL;
+
+    for (uint16_t i = 0; i < L2CAP_CHANNEL_TABLE_SIZE; i++) {
+        prev = &(inst->chanTable[i]);
+        while ((*prev) != NULL) {
+            if ((*prev)->conn == conn) {
+                *prev = (*prev)->hashNext;
+            } else {
+                prev = &((*prev)->hashNext);
+            }
+        }
+    }
+
+    return;
+}
+
+static L2capChannel *L2capLookupChannel(uint16_t lcid)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capChannel *chan = inst->chanTable[L2CAP_CHANNEL_BUCKET(lcid)];
+
+    while (chan != NULL) {
+        if (chan->lcid == lcid) {
+            return chan;
+        }
+
+        chan = chan->hashNext;
+    }
+
+    return NULL;
+}
+
+#ifdef DEBUG
+void L2capCheckIndex()
 {
     L2capInstance *inst = L2capGetInstance();
     L2capConnection *conn = NULL;
+    L2capChannel *chan = NULL;
     ListNode *node = NULL;
+    ListNode *nodeChan = NULL;
+    uint32_t connCount = 0;
+    uint32_t chanCount = 0;
 
+    // every connection and channel of the lists is found by the tables
     node = ListGetFirstNode(inst->connList);
     while (node != NULL) {
         conn = ListGetNodeData(node);
+        connCount++;
+
+        L2capConnection *hashConn = inst->connTable[L2CAP_CONNECTION_BUCKET(conn->aclHandle)];
+        while ((hashConn != NULL) && (hashConn != conn)) {
+            hashConn = hashConn->hashNext;
+        }
+        ASSERT(hashConn == conn);
+
+        nodeChan = ListGetFirstNode(conn->chanList);
+        while (nodeChan != NULL) {
+            chan = ListGetNodeData(nodeChan);
+            chanCount++;
+            ASSERT(chan->conn == conn);
+            ASSERT(L2capLookupChannel(chan->lcid) == chan);
+
+            nodeChan = ListGetNextNode(nodeChan);
+        }
+
+        node = ListGetNextNode(node);
+    }
+
+    // and the tables hold nothing else
+    for (uint16_t i = 0; i < L2CAP_CONNECTION_TABLE_SIZE; i++) {
+        for (conn = inst->connTable[i]; conn != NULL; conn = conn->hashNext) {
+            ASSERT(L2CAP_CONNECTION_BUCKET(conn->aclHandle) == i);
+            connCount--;
+        }
+    }
+
+    for (uint16_t i = 0; i < L2CAP_CHANNEL_TABLE_SIZE; i++) {
+        for (chan = inst->chanTable[i]; chan != NULL; chan = chan->hashNext) {
+            ASSERT(L2CAP_CHANNEL_BUCKET(chan->lcid) == i);
+            chanCount--;
+        }
+    }
+
+    ASSERT(connCount == 0);
+    ASSERT(chanCount == 0);
+    return;
+}
+#endif
+
+L2capConnection *L2capGetConnection(uint16_t aclHandle)
+{
+    L2capInstance *inst = L2capGetInstance();
+    L2capConnection *conn = inst->connTable[L2CAP_CONNECTION_BUCKET(aclHandle)];
+
+    while (conn != NULL) {
         if (conn->aclHandle == aclHandle) {
             return conn;
         }
 
-        node = ListGetNextNode(node);
+        conn = conn->hashNext;
     }
 
     return NULL;
@@ -126,17 +274,10 @@ L2capConnection *L2capGetConnection3(const L2capChannel *chan)
 
 L2capChannel *L2capGetChannel(const L2capConnection *conn, int16_t lcid)
 {
-    L2capChannel *chan = NULL;
-    ListNode *node = NULL;
+    L2capChannel *chan = L2capLookupChannel((uint16_t)lcid);
 
-    node = ListGetFirstNode(conn->chanList);
-    while (node != NULL) {
-        chan = ListGetNodeData(node);
-        if (chan->lcid == lcid) {
-            return chan;
-        }
-
-        node = ListGetNextNode(node);
+    if ((chan != NULL) && (chan->conn == conn)) {
+        return chan;
     }
 
     return NULL;
@@ -144,18 +285,9 @@ L2capChannel *L2capGetChannel(const L2capConnection *conn, int16_t lcid)
 
 void L2capGetChannel2(uint16_t lcid, L2capConnection **conn, L2capChannel **chan)
 {
-    L2capInstance *inst = L2capGetInstance();
-    ListNode *node = NULL;
-
-    node = ListGetFirstNode(inst->connList);
-    while (node != NULL) {
-        *conn = ListGetNodeData(node);
-        *chan = L2capGetChannel(*conn, lcid);
-        if ((*chan) != NULL) {
-            break;
-        }
-
-        node = ListGetNextNode(node);
+    *chan = L2capLookupChannel(lcid);
+    if ((*chan) != NULL) {
+        *conn = (*chan)->conn;
     }
 
     return;
@@ -178,15 +310,7 @@ static uint16_t L2capGetNewLcid()
     uint16_t lcid = L2CAP_MIN_CID;
 
     if (inst->nextLcid == 0) {
-        L2capConnection *conn = NULL;
-        L2capChannel *chan = NULL;
-
-        while (1) {
-            L2capGetChannel2(lcid, &conn, &chan);
-            if (chan == NULL) {
-                break;
-            }
-
+        while (L2capLookupChannel(lcid) != NULL) {
             lcid += 1;
         }
     } else {
@@ -250,8 +374,17 @@ L2capChannel *L2capNewChannel(L2capConnection *conn, uint16_t lpsm, uint16_t rps
 
     L2capSetDefaultConfigOptions(&(chan->lcfg));
     L2capSetDefaultConfigOptions(&(chan->rcfg));
+    chan->lwin.txWindowSize = L2CAP_DEFAULT_TX_WINDOW;
+    chan->lwin.rxWindowSize = L2CAP_DEFAULT_TX_WINDOW;
+    chan->rwin = chan->lwin;
 
+    chan->conn = conn;
     ListAddLast(conn->chanList, chan);
+    L2capIndexChannel(chan);
+
+#ifdef DEBUG
+    L2capCheckIndex();
+#endif
     return chan;
 }
 
@@ -292,8 +425,39 @@ static void L2capDestroyChannelTx(L2capChannel *chan)
     return;
 }
 
+static void L2capDestroyChannelRing(L2capChannel *chan)
+{
+    L2capErfc *erfc = &(chan->erfc);
+    uint16_t i;
+
+    if (erfc->txRing != NULL) {
+        for (i = 0; i < erfc->txRingSize; i++) {
+            if (erfc->txRing[i] != NULL) {
+                PacketFree(erfc->txRing[i]->pkt);
+                L2capFree(erfc->txRing[i]);
+            }
+        }
+
+        L2capFree(erfc->txRing);
+    }
+
+    if (erfc->rxRing != NULL) {
+        for (i = 0; i < erfc->rxRingSize; i++) {
+            if (erfc->rxRing[i].pkt != NULL) {
+                PacketFree(erfc->rxRing[i].pkt);
+            }
+        }
+
+        L2capFree(erfc->rxRing);
+    }
+
+    return;
+}
+
 void L2capDestroyChannel(L2capChannel *chan)
 {
+    L2capUnindexChannel(chan);
+
     if (chan->erfc.monitorTimer != NULL) {
         AlarmCancel(chan->erfc.monitorTimer);
         AlarmDelete(chan->erfc.monitorTimer);
@@ -312,6 +476,8 @@ void L2capDestroyChannel(L2capChannel *chan)
         L2capDestroyChannelTx(chan);
     }
 
+    L2capDestroyChannelRing(chan);
+
     if (chan->erfc.rxSarPacket != NULL) {
         PacketFree(chan->erfc.rxSarPacket);
     }
@@ -362,6 +528,10 @@ void L2capDeleteChannel(L2capConnection *conn, L2capChannel *chan, uint16_t remo
     ListRemoveNode(conn->chanList, chan);
     L2capDestroyChannel(chan);
 
+#ifdef DEBUG
+    L2capCheckIndex();
+#endif
+
     if (removeAcl) {
         if (ListGetFirstNode(conn->chanList) == NULL) {
             // Reason: REMOTE USER TERMINATED CONNECTION
@@ -403,6 +573,11 @@ L2capConnection *L2capNewConnection(const BtAddr *addr, uint16_t aclHandle)
     conn->discTimer = NULL;
 
     ListAddFirst(inst->connList, conn);
+    L2capIndexConnection(conn);
+
+#ifdef DEBUG
+    L2capCheckIndex();
+#endif
     return conn;
 }
 
@@ -411,6 +586,9 @@ void L2capDeleteConnection(L2capConnection *conn)
     L2capInstance *inst = L2capGetInstance();
     ListNode *node = NULL;
 
+    L2capUnindexChannels(conn);
+    L2capUnindexConnection(conn);
+
     if (conn->chanList != NULL) {
         L2capChannel *chan = NULL;
 
@@ -448,5 +626,24 @@ void L2capDeleteConnection(L2capConnection *conn)
         inst->nextLcid = L2CAP_MIN_CID;
     }
 
+#ifdef DEBUG
+    L2capCheckIndex();
+#endif
+    return;
+}
+
+void L2capSetConnectionHandle(L2capConnection *conn, uint16_t aclHandle)
+{
+    if (conn->aclHandle == aclHandle) {
+        return;
+    }
+
+    L2capUnindexConnection(conn);
+    conn->aclHandle = aclHandle;
+    L2capIndexConnection(conn);
+
+#ifdef DEBUG
+    L2capCheckIndex();
+#endif
     return;
 }
\ No newline at end of file
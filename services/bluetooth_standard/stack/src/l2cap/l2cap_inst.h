@@ -47,6 +47,10 @@ extern "C" {
 #define L2CAP_BUSY_WAIT_F 0x40
 #define L2CAP_BUSY_REMOTE_RNR 0x80
 
+// buckets of the lookup tables, power of 2
+#define L2CAP_CHANNEL_TABLE_SIZE 64
+#define L2CAP_CONNECTION_TABLE_SIZE 8
+
 typedef struct {
     uint8_t state;
     uint8_t extendedFeature[4];
@@ -68,8 +72,15 @@ typedef struct {
 typedef struct {
     Packet *pkt;
     uint8_t retryCount;
+    uint8_t sar;
 } L2capErfcTxPacket;
 
+typedef struct {
+    Packet *pkt;  // NULL if the frame is still missing
+    uint32_t srejOrder;  // order of the last SREJ sent for the frame, 0 if none
+    uint8_t sar;
+} L2capErfcRxPacket;
+
 typedef struct {
     // I-frames contain TxSeq, the send sequence number of the I-frame
     uint16_t txSeq;
@@ -90,40 +101,56 @@ typedef struct {
     uint8_t busyState;
     uint8_t rejState;
 
+    // the extended control field is used, as the extended window size option was sent in either direction
+    uint8_t extControl;
+
     Alarm *retransmissionTimer;
     Alarm *monitorTimer;
     uint8_t retryCount;
 
-    List *txList;
+    List *txList;  // new frames waiting for the transmit window
     Packet *rxSarPacket;
+
+    // frames sent and not acknowledged yet, the head holds expectedAckSeq
+    L2capErfcTxPacket **txRing;
+    uint16_t txRingSize;
+    uint16_t txRingHead;
+
+    // frames received ahead of expectedTxSeq while missing ones are selectively rejected, the head holds
+    // expectedTxSeq. Frames before rxHighSeq are received or rejected.
+    L2capErfcRxPacket *rxRing;
+    uint16_t rxRingSize;
+    uint16_t rxRingHead;
+    uint16_t rxHighSeq;
+    uint32_t srejCount;
+
+    uint8_t stalled;
+    uint64_t stallStartMs;
+    uint64_t connectedMs;
+    L2capErfcStatistics stats;
 } L2capErfc;
 
+// control field of I-frames and S-frames, decoded from the enhanced or the extended format
 typedef struct {
-    // first octet
-    uint8_t type : 1;
-    uint8_t txSeq : 6;
-    uint8_t fBit : 1;
-
-    // second octet
-    uint8_t reqSeq : 6;
-    uint8_t sar : 2;
-} L2capErfcIControl;
-
+    uint8_t type;
+    uint8_t sar;   // I-frame only
+    uint8_t sBit;  // S-frame only
+    uint8_t pBit;  // S-frame only
+    uint8_t fBit;
+    uint16_t txSeq;  // I-frame only
+    uint16_t reqSeq;
+} L2capErfcControl;
+
+// Transmission windows in Enhanced Retransmission mode, up to L2CAP_MAX_EXT_TX_WINDOW with Extended Window Size.
+// Kept next to lcfg/rcfg because the public L2capOptionRfc only has room for 8-bit windows.
 typedef struct {
-    // first octet
-    uint8_t type : 1;
-    uint8_t reserved1 : 1;
-    uint8_t sBit : 2;
-    uint8_t pBit : 1;
-    uint8_t reserved2 : 2;
-    uint8_t fBit : 1;
-
-    // second octet
-    uint8_t reqSeq : 6;
-    uint8_t reserved3 : 2;
-} L2capErfcSControl;
+    uint16_t txWindowSize;
+    uint16_t rxWindowSize;
+} L2capWindowSize;
 
-typedef struct {
+typedef struct L2capConnection L2capConnection;
+
+typedef struct L2capChannel {
     uint16_t lcid;
     uint16_t rcid;
 
@@ -138,11 +165,16 @@ typedef struct {
     uint8_t cfgState;
     L2capConfigInfo lcfg;
     L2capConfigInfo rcfg;
+    L2capWindowSize lwin;
+    L2capWindowSize rwin;
 
     L2capErfc erfc;
+
+    L2capConnection *conn;
+    struct L2capChannel *hashNext;  // next channel in the same bucket of L2capInstance.chanTable
 } L2capChannel;
 
-typedef struct {
+struct L2capConnection {
     uint16_t aclHandle;
     BtAddr addr;
 
@@ -157,7 +189,9 @@ typedef struct {
     List *chanList;  // Pack struct L2capChannel
 
     List *pendingList;  // Pack struct L2capPendingRequest
-} L2capConnection;
+
+    L2capConnection *hashNext;  // next connection in the same bucket of L2capInstance.connTable
+};
 
 typedef struct {
     L2capEcho cb;
@@ -170,6 +204,10 @@ typedef struct {
     List *psmList;   // Pack struct L2capPsm
     List *connList;  // Pack struct L2capConnection
 
+    // lookup tables of the received frames, channels hashed by lcid, connections by aclHandle
+    L2capChannel *chanTable[L2CAP_CHANNEL_TABLE_SIZE];
+    L2capConnection *connTable[L2CAP_CONNECTION_TABLE_SIZE];
+
     L2capEchoContext echo;
 } L2capInstance;
 
@@ -190,6 +228,11 @@ void L2capDestroyChannel(L2capChannel *chan);
 void L2capDeleteChannel(L2capConnection *conn, L2capChannel *chan, uint16_t removeAcl);
 L2capConnection *L2capNewConnection(const BtAddr *addr, uint16_t aclHandle);
 void L2capDeleteConnection(L2capConnection *conn);
+void L2capSetConnectionHandle(L2capConnection *conn, uint16_t aclHandle);
+
+#ifdef DEBUG
+void L2capCheckIndex();
+#endif
 
 #ifdef __cplusplus
 }
@@ -22,9 +22,15 @@
 #include "l2cap_cmn.h"
 #include "list.h"
 #include "log.h"
+#include "platform_def.h"
 
 #define L2CAP_LE_DEFAULT_CREDIT 0x08
 
+// the dynamic cids of LE are few enough to index directly, the connections are hashed by aclHandle
+#define L2CAP_LE_CHANNEL_TABLE_SIZE (L2CAP_LE_MAX_CID - L2CAP_LE_MIN_CID + 1)
+#define L2CAP_LE_CONNECTION_TABLE_SIZE 8
+#define L2CAP_LE_CONNECTION_BUCKET(aclHandle) ((aclHandle) & (L2CAP_LE_CONNECTION_TABLE_SIZE - 1))
+
 #define L2CAP_LE_CHANNEL_CREDIT_NOT_FULL 0x00
 #define L2CAP_LE_CHANNEL_CREDIT_FULL 0x01
 
@@ -35,6 +41,8 @@ typedef struct {
     void *ctx;
 } L2capLePsm;
 
+typedef struct L2capLeConnection L2capLeConnection;
+
 typedef struct {
     uint16_t lcid;
     uint16_t rcid;
@@ -52,9 +60,11 @@ typedef struct {
 
     List *txList;
     Packet *rxSarPacket;
+
+    L2capLeConnection *conn;
 } L2capLeChannel;
 
-typedef struct {
+struct L2capLeConnection {
     uint16_t aclHandle;
     BtAddr addr;
 
@@ -64,7 +74,9 @@ typedef struct {
     List *chanList;  // Pack struct L2capLeChannel
 
     List *pendingList;  // Pack struct L2capPendingRequest
-} L2capLeConnection;
+
+    L2capLeConnection *hashNext;  // next connection in the same bucket of L2capLeInstance.connTable
+};
 
 typedef struct {
     L2capLeConnectionParameterUpdate cb;
@@ -81,6 +93,10 @@ typedef struct {
 
     List *psmList;   // Pack struct L2capLePsm
     List *connList;  // Pack struct L2capLeConnection
+
+    // lookup tables of the received frames, channels indexed by lcid, connections hashed by aclHandle
+    L2capLeChannel *chanTable[L2CAP_LE_CHANNEL_TABLE_SIZE];
+    L2capLeConnection *connTable[L2CAP_LE_CONNECTION_TABLE_SIZE];
 } L2capLeInstance;
 
 L2capLeInstance g_l2capLeInst;
@@ -115,20 +131,112 @@ static L2capLePsm *L2capLeGetPsm(uint16_t lpsm)
     return NULL;
 }
 
-static L2capLeConnection *L2capLeGetConnection(uint16_t aclHandle)
+static void L2capLeIndexConnection(L2capLeConnection *conn)
 {
     L2capLeInstance *inst = &g_l2capLeInst;
-    L2capLeConnection *leconn = NULL;
+    L2capLeConnection **bucket = &(inst->connTable[L2CAP_LE_CONNECTION_BUCKET(conn->aclHandle)]);
+
+    conn->hashNext = *bucket;
+    *bucket = conn;
+    return;
+}
+
+static void L2capLeUnindexConnection(const L2capLeConnection *conn)
+{
+    L2capLeInstance *inst = &g_l2capLeInst;
+    L2capLeConnection **prev = &(inst->connTable[L2CAP_LE_CONNECTION_BUCKET(conn->aclHandle)]);
+
+    while ((*prev) != NULL) {
+        if ((*prev) == conn) {
+            *prev = conn->hashNext;
+            break;
+        }
+
+        prev = &((*prev)->hashNext);
+    }
+
+    return;
+}
+
+static L2capLeChannel *L2capLeLookupChannel(uint16_t lcid)
+{
+    L2capLeInstance *inst = &g_l2capLeInst;
+
+    if ((lcid < L2CAP_LE_MIN_CID) || (lcid > L2CAP_LE_MAX_CID)) {
+        return NULL;
+    }
+
+    return inst->chanTable[lcid - L2CAP_LE_MIN_CID];
+}
+
+#ifdef DEBUG
+static void L2capLeCheckIndex()
+{
+    L2capLeInstance *inst = &g_l2capLeInst;
+    L2capLeConnection *conn = NULL;
+    L2capLeChannel *chan = NULL;
     ListNode *node = NULL;
+    ListNode *nodeChan = NULL;
+    uint32_t connCount = 0;
+    uint32_t chanCount = 0;
 
+    // every connection and channel of the lists is found by the tables
     node = ListGetFirstNode(inst->connList);
     while (node != NULL) {
-        leconn = ListGetNodeData(node);
+        conn = ListGetNodeData(node);
+        connCount++;
+
+        L2capLeConnection *hashConn = inst->connTable[L2CAP_LE_CONNECTION_BUCKET(conn->aclHandle)];
+        while ((hashConn != NULL) && (hashConn != conn)) {
+            hashConn = hashConn->hashNext;
+        }
+        ASSERT(hashConn == conn);
+
+        nodeChan = ListGetFirstNode(conn->chanList);
+        while (nodeChan != NULL) {
+            chan = ListGetNodeData(nodeChan);
+            chanCount++;
+            ASSERT(chan->conn == conn);
+            ASSERT(L2capLeLookupChannel(chan->lcid) == chan);
+
+            nodeChan = ListGetNextNode(nodeChan);
+        }
+
+        node = ListGetNextNode(node);
+    }
+
+    // and the tables hold nothing else
+    for (uint16_t i = 0; i < L2CAP_LE_CONNECTION_TABLE_SIZE; i++) {
+        for (conn = inst->connTable[i]; conn != NULL; conn = conn->hashNext) {
+            ASSERT(L2CAP_LE_CONNECTION_BUCKET(conn->aclHandle) == i);
+            connCount--;
+        }
+    }
+
+    for (uint16_t i = 0; i < L2CAP_LE_CHANNEL_TABLE_SIZE; i++) {
+        if (inst->chanTable[i] != NULL) {
+            ASSERT(inst->chanTable[i]->lcid == (L2CAP_LE_MIN_CID + i));
+            chanCount--;
+        }
+    }
+
+    ASSERT(connCount == 0);
+    ASSERT(chanCount == 0);
+    return;
+}
+#endif
+
+static L2capLeConnection *L2capLeGetConnection(uint16_t aclHandle)
+{
+    L2capLeInstance *inst = &g_l2capLeInst;
+    L2capLeConnection *leconn = inst->connTable[L2CAP_LE_CONNECTION_BUCKET(aclHandle)];
+
+    while (leconn != NULL) {
         if (leconn->aclHandle == aclHandle) {
             return leconn;
         }
 
-        node = ListGetNextNode(node);
+        leconn = leconn->hashNext;
     }
 
     return NULL;
@@ -155,17 +263,10 @@ static L2capLeConnection *L2capLeGetConnection2(const BtAddr *addr)
 
 static L2capLeChannel *L2capLeGetChannel(L2capLeConnection *conn, int16_t lcid)
 {
-    L2capLeChannel *lechan = NULL;
-    ListNode *node = NULL;
-
-    node = ListGetFirstNode(conn->chanList);
-    while (node != NULL) {
-        lechan = ListGetNodeData(node);
-        if (lechan->lcid == lcid) {
-            return lechan;
-        }
+    L2capLeChannel *lechan = L2capLeLookupChannel((uint16_t)lcid);
 
-        node = ListGetNextNode(node);
+    if ((lechan != NULL) && (lechan->conn == conn)) {
+        return lechan;
     }
 
     return NULL;
@@ -173,18 +274,9 @@ static L2capLeChannel *L2capLeGetChannel(L2capLeConnection *conn, int16_t lcid)
 
 static void L2capLeGetChannel2(uint16_t lcid, L2capLeConnection **conn, L2capLeChannel **chan)
 {
-    L2capLeInstance *inst = &g_l2capLeInst;
-    ListNode *node = NULL;
-
-    node = ListGetFirstNode(inst->connList);
-    while (node != NULL) {
-        *conn = ListGetNodeData(node);
-        *chan = L2capLeGetChannel(*conn, lcid);
-        if ((*chan) != NULL) {
-            break;
-        }
-
-        node = ListGetNextNode(node);
+    *chan = L2capLeLookupChannel(lcid);
+    if ((*chan) != NULL) {
+        *conn = (*chan)->conn;
     }
 
     return;
@@ -225,13 +317,10 @@ static uint16_t L2capLeGetNewLcid()
     uint16_t lcid = L2CAP_LE_MIN_CID;
 
     if (inst->nextLcid == 0) {
-        L2capLeConnection *conn = NULL;
-        L2capLeChannel *chan = NULL;
-
-        while (1) {
-            L2capLeGetChannel2(lcid, &conn, &chan);
-            if (chan == NULL) {
-                break;
+        // 0 if all the cids are in use
+        while (inst->chanTable[lcid - L2CAP_LE_MIN_CID] != NULL) {
+            if (lcid == L2CAP_LE_MAX_CID) {
+                return 0;
             }
 
             lcid += 1;
@@ -251,14 +340,22 @@ static uint16_t L2capLeGetNewLcid()
 
 static L2capLeChannel *L2capLeNewChannel(L2capLeConnection *conn, uint16_t lpsm, uint16_t rpsm)
 {
+    L2capLeInstance *inst = &g_l2capLeInst;
     L2capLeChannel *chan = NULL;
+    uint16_t lcid;
+
+    lcid = L2capLeGetNewLcid();
+    if (lcid == 0) {
+        LOG_WARN("no LE cid available");
+        return NULL;
+    }
 
     chan = L2capAlloc(sizeof(L2capLeChannel));
     if (chan == NULL) {
         return NULL;
     }
 
-    chan->lcid = L2capLeGetNewLcid();
+    chan->lcid = lcid;
     chan->lpsm = lpsm;
     chan->rpsm = rpsm;
     chan->lcfg.mps = L2capGetRxBufferSize() - L2CAP_SIZE_6;
@@ -266,12 +363,24 @@ static L2capLeChannel *L2capLeNewChannel(L2capLeConnection *conn, uint16_t lpsm,
     chan->state = L2CAP_CHANNEL_IDLE;
     chan->rxSarPacket = NULL;
 
+    chan->conn = conn;
     ListAddLast(conn->chanList, chan);
+    inst->chanTable[lcid - L2CAP_LE_MIN_CID] = chan;
+
+#ifdef DEBUG
+    L2capLeCheckIndex();
+#endif
     return chan;
 }
 
 static void L2capLeDestroyChannel(L2capLeChannel *chan)
 {
+    L2capLeInstance *inst = &g_l2capLeInst;
+
+    if (L2capLeLookupChannel(chan->lcid) == chan) {
+        inst->chanTable[chan->lcid - L2CAP_LE_MIN_CID] = NULL;
+    }
+
     if (chan->txList != NULL) {
         ListNode *node = NULL;
         Packet *pkt = NULL;
@@ -304,6 +413,10 @@ static void L2capLeDeleteChannel(L2capLeConnection *conn, L2capLeChannel *chan,
     ListRemoveNode(conn->chanList, chan);
     L2capLeDestroyChannel(chan);
 
+#ifdef DEBUG
+    L2capLeCheckIndex();
+#endif
+
     if (removeAcl) {
         if (ListGetFirstNode(conn->chanList) == NULL) {
             // Reason: REMOTE USER TERMINATED CONNECTION
@@ -332,6 +445,11 @@ static L2capLeConnection *L2capLeNewConnection(const BtAddr *addr, uint16_t aclH
     conn->chanList = ListCreate(NULL);
     conn->pendingList = ListCreate(NULL);
     ListAddFirst(inst->connList, conn);
+    L2capLeIndexConnection(conn);
+
+#ifdef DEBUG
+    L2capLeCheckIndex();
+#endif
     return conn;
 }
 
@@ -340,6 +458,8 @@ static void L2capLeDeleteConnection(L2capLeConnection *conn)
     L2capLeInstance *inst = &g_l2capLeInst;
     ListNode *node = NULL;
 
+    L2capLeUnindexConnection(conn);
+
     if (conn->chanList != NULL) {
         L2capLeChannel *chan = NULL;
 
@@ -370,6 +490,25 @@ static void L2capLeDeleteConnection(L2capLeConnection *conn)
         inst->nextLcid = L2CAP_LE_MIN_CID;
     }
 
+#ifdef DEBUG
+    L2capLeCheckIndex();
+#endif
+    return;
+}
+
+static void L2capLeSetConnectionHandle(L2capLeConnection *conn, uint16_t aclHandle)
+{
+    if (conn->aclHandle == aclHandle) {
+        return;
+    }
+
+    L2capLeUnindexConnection(conn);
+    conn->aclHandle = aclHandle;
+    L2capLeIndexConnection(conn);
+
+#ifdef DEBUG
+    L2capLeCheckIndex();
+#endif
     return;
 }
 
@@ -725,6 +864,15 @@ static void L2capLeProcessCreditBasedConnectionReq(
     }
 
     chan = L2capLeNewChannel(conn, lpsm, lpsm);
+    if (chan == NULL) {
+        L2capLeChannel tchan = {0};
+
+        tchan.lcid = 0;
+        (void)memcpy_s(&(tchan.lcfg), sizeof(L2capLeConfigInfo), &cfg, sizeof(L2capLeConfigInfo));
+        L2capSendCreditBasedConnectionRsp(conn, &tchan, signal->identifier, L2CAP_LE_NO_RESOURCES_AVAILABLE);
+        return;
+    }
+
     chan->rcid = rcid;
     chan->connIdentifier = signal->identifier;
 
@@ -1220,7 +1368,7 @@ static int L2capLeConnectComplete(const BtAddr *addr, uint16_t handle, uint8_t r
         conn = L2capLeNewConnection(addr, handle, role);
     }
 
-    conn->aclHandle = handle;
+    L2capLeSetConnectionHandle(conn, handle);
     conn->role = role;
     L2capAddConnectionRef(handle);
     L2capLeAclConnectProcess(conn);
@@ -1257,6 +1405,7 @@ int L2CAP_LeCreditBasedConnectionReq(
     L2capLeConnection *conn = NULL;
     L2capLeChannel *chan = NULL;
     L2capLePsm *psm = NULL;
+    bool newConn = false;
 
     LOG_INFO("%{public}s:%{public}d enter, lpsm = 0x%04X, rpsm = 0x%04X", __FUNCTION__, __LINE__, lpsm, rpsm);
 
@@ -1280,9 +1429,21 @@ int L2CAP_LeCreditBasedConnectionReq(
     conn = L2capLeGetConnection2(addr);
     if (conn == NULL) {
         conn = L2capLeNewConnection(addr, 0, 0);
+        if (conn == NULL) {
+            return BT_NO_MEMORY;
+        }
+        newConn = true;
     }
 
     chan = L2capLeNewChannel(conn, lpsm, rpsm);
+    if (chan == NULL) {
+        // do not leave the connection just created for this channel behind in the index
+        if (newConn) {
+            L2capLeDeleteConnection(conn);
+        }
+        return BT_NO_MEMORY;
+    }
+
     chan->state = L2CAP_CHANNEL_CONNECT_OUT_REQ;
 
     chan->lcfg.mtu = cfg->mtu;
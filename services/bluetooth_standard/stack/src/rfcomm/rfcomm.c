@@ -61,9 +61,9 @@ void RfcommFinalize()
     // Deregister security from GAP.
     RfcommDeregisterSecurity();
 
-    // Free list.
-    RfcommDestroySessionList();
+    // Free list. The channels are indexed in their sessions, and are freed first.
     RfcommDestroyChannelList();
+    RfcommDestroySessionList();
     RfcommDestroyServerList();
 }
 
@@ -421,26 +421,22 @@ int RfcommRead(uint16_t handle, Packet **pkt)
 {
     LOG_INFO("%{public}s handle:%hu", __func__, handle);
 
-    ListNode *node = NULL;
     RfcommChannelInfo *channel = RfcommGetChannelByHandle(handle);
 
     if (channel == NULL) {
         return RFCOMM_ERR_PARAM;
     }
-    node = ListGetFirstNode(channel->recvQueue);
-    if (node == NULL) {
-        *pkt = NULL;
+
+    *pkt = RfcommDequeuePkt(&channel->recvQueue);
+    if (*pkt == NULL) {
         return RFCOMM_NO_DATA;
     }
 
-    *pkt = (Packet *)ListGetNodeData(node);
     // Add received data bytes value.
     channel->receivedBytes += PacketPayloadSize(*pkt);
-    // Remove first node.
-    ListRemoveFirst(channel->recvQueue);
 
-    // Local can receive more data, send flow control to peer.
-    RfcommSetFlcToPeer(channel, true);
+    // Local can receive more data, send flow control to peer in the RFCOMM thread.
+    RfcommNotifyRead(channel);
 
     return RFCOMM_SUCCESS;
 }
@@ -16,9 +16,15 @@
 #include "rfcomm_defs.h"
 
 static List *g_channelList;
-static bool g_channelHandle[MAX_DLC_COUNT] = {false};
+// The channel of each handle, the handle is the index + 1.
+static RfcommChannelInfo *g_channelTable[MAX_DLC_COUNT] = {NULL};
 static Mutex *g_readLock = NULL;
 
+typedef struct {
+    RfcommChannelInfo *channel;
+    uint16_t handle;
+} RfcommReadTskInfo;
+
 void RfcommReadLock()
 {
     LOG_INFO("%{public}s", __func__);
@@ -46,7 +52,7 @@ void RfcommCreateChannelList()
     LOG_INFO("%{public}s", __func__);
 
     for (uint8_t cnt = 0; cnt < MAX_DLC_COUNT; cnt++) {
-        g_channelHandle[cnt] = false;
+        g_channelTable[cnt] = NULL;
     }
 
     g_channelList = ListCreate(NULL);
@@ -64,10 +70,6 @@ void RfcommDestroyChannelList()
     RfcommChannelInfo *channel = NULL;
     ListNode *node = NULL;
 
-    for (uint8_t cnt = 0; cnt < MAX_DLC_COUNT; cnt++) {
-        g_channelHandle[cnt] = false;
-    }
-
     if (g_channelList == NULL) {
         LOG_DEBUG("%{public}s Channel list is NULL.", __func__);
         return;
@@ -85,6 +87,10 @@ void RfcommDestroyChannelList()
     ListDelete(g_channelList);
     g_channelList = NULL;
 
+    for (uint8_t cnt = 0; cnt < MAX_DLC_COUNT; cnt++) {
+        g_channelTable[cnt] = NULL;
+    }
+
     // Destroy read lock.
     if (g_readLock != NULL) {
         MutexDelete(g_readLock);
@@ -95,19 +101,20 @@ void RfcommDestroyChannelList()
 /**
  * @brief The function is used to assign handle to individual DLC.
  *
+ * @param channel The pointer of the channel.
  * @return Handle number.0(unavailable handle),1~36(available handle)
  */
-static uint16_t RfcommAssignHandle()
+static uint16_t RfcommAssignHandle(RfcommChannelInfo *channel)
 {
     LOG_INFO("%{public}s", __func__);
 
     uint16_t handle = 0;
 
     for (uint8_t index = 0; index < MAX_DLC_COUNT; index++) {
-        if (g_channelHandle[index]) {
+        if (g_channelTable[index] != NULL) {
             continue;
         }
-        g_channelHandle[index] = true;
+        g_channelTable[index] = channel;
         handle = index + 1;
         LOG_DEBUG("%{public}s DLC handle is %hu.", __func__, handle);
         break;
@@ -128,7 +135,52 @@ static void RfcommFreeHandle(uint16_t handle)
         return;
     }
 
-    g_channelHandle[handle - 1] = false;
+    g_channelTable[handle - 1] = NULL;
+}
+
+/**
+ * @brief Add the channel to the dlci table of its session, if it is the first channel of the dlci.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+static void RfcommIndexChannel(RfcommChannelInfo *channel)
+{
+    if (channel->dlci >= MAX_DLCI_COUNT) {
+        return;
+    }
+
+    if (channel->session->dlcTable[channel->dlci] == NULL) {
+        channel->session->dlcTable[channel->dlci] = channel;
+    }
+}
+
+/**
+ * @brief Remove the channel from the dlci table of its session,
+ *        the next channel of the same dlci in the channel list takes its place.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+static void RfcommUnindexChannel(const RfcommChannelInfo *channel)
+{
+    RfcommChannelInfo *channelInfo = NULL;
+    ListNode *node = NULL;
+
+    if ((channel->dlci >= MAX_DLCI_COUNT) || (channel->session->dlcTable[channel->dlci] != channel)) {
+        return;
+    }
+
+    channel->session->dlcTable[channel->dlci] = NULL;
+
+    node = ListGetFirstNode(g_channelList);
+    while (node != NULL) {
+        channelInfo = ListGetNodeData(node);
+        if ((channelInfo != channel) && (channelInfo->session == channel->session) &&
+            (channelInfo->dlci == channel->dlci)) {
+            channel->session->dlcTable[channel->dlci] = channelInfo;
+            break;
+        }
+        node = ListGetNextNode(node);
+    }
 }
 
 /**
@@ -148,10 +200,8 @@ static void RfcommInitChannelInfo(RfcommChannelInfo *channel)
     (void)memset_s(channel, sizeof(RfcommChannelInfo), 0x00, sizeof(RfcommChannelInfo));
     channel->channelState = ST_CHANNEL_CLOSED;
     channel->peerMtu = RFCOMM_PEER_DEFAULT_MTU;
-    channel->sendQueue = ListCreate(NULL);
-    channel->recvQueue = ListCreate(NULL);
     channel->timer = AlarmCreate(NULL, false);
-    channel->localCreditMax = MAX_CREDIT_COUNT;
+    RfcommResetCredit(channel);
     channel->peerChannelFc = false;
     // Set remote port default value.
     channel->portConfig = defaultCfg;
@@ -271,12 +321,12 @@ RfcommChannelInfo *RfcommCreateChannel(const RfcommCreateChannelInfo *createChan
     channel->callBack = createChannelInfo->callback;
     channel->eventMask = createChannelInfo->eventMask;
     channel->dlci = createChannelInfo->dlci;
-    // Set handle.
-    channel->handle = RfcommAssignHandle();
 
-    // Add the new channel into channel list.
+    // Set handle and add the new channel into channel list, readers look the channel up by handle under the lock.
     RfcommReadLock();
+    channel->handle = RfcommAssignHandle(channel);
     ListAddLast(g_channelList, channel);
+    RfcommIndexChannel(channel);
     RfcommReadUnlock();
 
     // return channel.
@@ -347,6 +397,7 @@ void RfcommRemoveChannel(RfcommChannelInfo *channel)
     RfcommFreeHandle(channel->handle);
 
     // Remove channel node.
+    RfcommUnindexChannel(channel);
     ListRemoveNode(g_channelList, channel);
 
     // Release channel resource.
@@ -356,42 +407,91 @@ void RfcommRemoveChannel(RfcommChannelInfo *channel)
 }
 
 /**
- * @brief Remove packet from send queue and free the queue resources.
+ * @brief Add the packet to the tail of the queue.
  *
- * @param channel The pointer of the channel in the channel list.
+ * @param queue The send or receive queue of a channel.
+ * @param pkt   The packet to be buffered, the queue owns it once added.
+ * @return True if the packet is added, false if the queue is full.
  */
-void RfcommReleaseCachePkt(RfcommChannelInfo *channel)
+bool RfcommEnqueuePkt(RfcommPacketQueue *queue, Packet *pkt)
 {
-    LOG_INFO("%{public}s", __func__);
+    if (queue->count >= MAX_QUEUE_COUNT) {
+        return false;
+    }
+
+    queue->pkts[(queue->head + queue->count) % MAX_QUEUE_COUNT] = pkt;
+    queue->count++;
+
+    return true;
+}
 
+/**
+ * @brief Remove the packet at the head of the queue.
+ *
+ * @param queue The send or receive queue of a channel.
+ * @return The packet removed, the caller owns it. NULL if the queue is empty.
+ */
+Packet *RfcommDequeuePkt(RfcommPacketQueue *queue)
+{
     Packet *pkt = NULL;
-    ListNode *node = NULL;
 
-    if (channel->sendQueue != NULL) {
-        // Release send queue's cache data.
-        node = ListGetFirstNode(channel->sendQueue);
-        while (node != NULL) {
-            pkt = ListGetNodeData(node);
-            PacketFree(pkt);
-            node = ListGetNextNode(node);
-        }
-        // Release send queue resource.
-        ListDelete(channel->sendQueue);
-        channel->sendQueue = NULL;
+    if (queue->count == 0) {
+        return NULL;
     }
 
-    if (channel->recvQueue != NULL) {
-        // Release receive queue's cache data.
-        node = ListGetFirstNode(channel->recvQueue);
-        while (node != NULL) {
-            pkt = ListGetNodeData(node);
-            PacketFree(pkt);
-            node = ListGetNextNode(node);
-        }
-        // Release receive queue resource.
-        ListDelete(channel->recvQueue);
-        channel->recvQueue = NULL;
+    pkt = queue->pkts[queue->head];
+    queue->pkts[queue->head] = NULL;
+    queue->head = (queue->head + 1) % MAX_QUEUE_COUNT;
+    queue->count--;
+
+    return pkt;
+}
+
+/**
+ * @brief Get the packet at the head of the queue without removing it.
+ *
+ * @param queue The send or receive queue of a channel.
+ * @return The packet at the head, NULL if the queue is empty.
+ */
+Packet *RfcommPeekPkt(const RfcommPacketQueue *queue)
+{
+    if (queue->count == 0) {
+        return NULL;
     }
+
+    return queue->pkts[queue->head];
+}
+
+/**
+ * @brief Free all the packets in the queue.
+ *
+ * @param queue The send or receive queue of a channel.
+ */
+void RfcommReleaseQueue(RfcommPacketQueue *queue)
+{
+    Packet *pkt = RfcommDequeuePkt(queue);
+
+    while (pkt != NULL) {
+        PacketFree(pkt);
+        pkt = RfcommDequeuePkt(queue);
+    }
+
+    queue->head = 0;
+}
+
+/**
+ * @brief Remove packet from send queue and free the queue resources.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+void RfcommReleaseCachePkt(RfcommChannelInfo *channel)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    // Release send queue's cache data.
+    RfcommReleaseQueue(&channel->sendQueue);
+    // Release receive queue's cache data.
+    RfcommReleaseQueue(&channel->recvQueue);
 }
 
 /**
@@ -412,11 +512,9 @@ void RfcommResetChannelInfo(RfcommChannelInfo *channel)
 
     RfcommStopChannelTimer(channel);
     RfcommReleaseCachePkt(channel);
-    channel->sendQueue = ListCreate(NULL);
-    channel->recvQueue = ListCreate(NULL);
     channel->peerMtu = RFCOMM_PEER_DEFAULT_MTU;
     channel->channelState = ST_CHANNEL_CLOSED;
-    channel->localCredit = 0;
+    RfcommResetCredit(channel);
     channel->peerCredit = 0;
     channel->transferReady = 0;
     channel->localFcToPeer = false;
@@ -474,24 +572,11 @@ RfcommChannelInfo *RfcommGetChannelByDlci(const RfcommSessionInfo *session, uint
 {
     LOG_INFO("%{public}s dlci:%hhu", __func__, dlci);
 
-    RfcommChannelInfo *channel = NULL;
-    ListNode *node = NULL;
-
-    if (g_channelList == NULL) {
-        LOG_ERROR("%{public}s Channel list is NULL.", __func__);
+    if (dlci >= MAX_DLCI_COUNT) {
         return NULL;
     }
 
-    node = ListGetFirstNode(g_channelList);
-    while (node != NULL) {
-        channel = ListGetNodeData(node);
-        if ((channel->session == session) && (channel->dlci == dlci)) {
-            return channel;
-        }
-        node = ListGetNextNode(node);
-    }
-
-    return NULL;
+    return session->dlcTable[dlci];
 }
 
 /**
@@ -534,24 +619,11 @@ RfcommChannelInfo *RfcommGetChannelByHandle(uint16_t handle)
 {
     LOG_INFO("%{public}s handle:%hu", __func__, handle);
 
-    RfcommChannelInfo *channel = NULL;
-    ListNode *node = NULL;
-
-    if (g_channelList == NULL) {
-        LOG_ERROR("%{public}s Channel list is NULL.", __func__);
+    if ((handle < 1) || (handle > MAX_DLC_COUNT)) {
         return NULL;
     }
 
-    node = ListGetFirstNode(g_channelList);
-    while (node != NULL) {
-        channel = ListGetNodeData(node);
-        if (channel->handle == handle) {
-            return channel;
-        }
-        node = ListGetNextNode(node);
-    }
-
-    return NULL;
+    return g_channelTable[handle - 1];
 }
 
 /**
@@ -590,23 +662,12 @@ bool RfcommIsChannelValid(const RfcommChannelInfo *channel)
 {
     LOG_INFO("%{public}s", __func__);
 
-    RfcommChannelInfo *channelInfo = NULL;
-    ListNode *node = NULL;
-
-    if (g_channelList == NULL) {
-        LOG_ERROR("%{public}s Channel list is NULL.", __func__);
-        return NULL;
-    }
-
-    // Check if there is a channel on the session.
-    node = ListGetFirstNode(g_channelList);
-    while (node != NULL) {
-        channelInfo = ListGetNodeData(node);
-        if (channelInfo == channel) {
+    // Every channel has a handle, the pointer is compared without reading the channel.
+    for (uint8_t index = 0; index < MAX_DLC_COUNT; index++) {
+        if (g_channelTable[index] == channel) {
             LOG_DEBUG("%{public}s The channel is valid.", __func__);
             return true;
         }
-        node = ListGetNextNode(node);
     }
 
     return false;
@@ -821,44 +882,35 @@ void RfcommSendCachePkt(RfcommChannelInfo *channel)
 
     RfcommSessionInfo *session = channel->session;
     Packet *pkt = NULL;
-    ListNode *node = NULL;
 
     if (channel->transferReady != TRANSFER_READY) {
         LOG_DEBUG("%{public}s:Not ready to send data.", __func__);
         return;
     }
 
-    node = ListGetFirstNode(channel->sendQueue);
-    if (node == NULL) {
+    if (channel->sendQueue.count == 0) {
         LOG_DEBUG("%{public}s:There is no cache data.", __func__);
         return;
     }
 
     if (session->fcType == FC_TYPE_CREDIT) {
-        while ((channel->peerCredit) && (node)) {
-            pkt = ListGetNodeData(node);
-            node = ListGetNextNode(node);
-            uint8_t newCredit = channel->localCreditMax - channel->localCredit;
-            newCredit = (newCredit < MAX_ONCE_NEWCREDIT) ? newCredit : MAX_ONCE_NEWCREDIT;
-            channel->localCredit += newCredit;
+        while ((channel->peerCredit) && (channel->sendQueue.count)) {
+            pkt = RfcommDequeuePkt(&channel->sendQueue);
             // Add transmite data bytes value.
             channel->transmittedBytes += PacketPayloadSize(pkt);
-            // Send data to peer.
-            RfcommSendUihData(session, channel->dlci, newCredit, pkt);
-            ListRemoveNode(channel->sendQueue, pkt);
+            // Send data to peer, with the credits to be returned.
+            RfcommSendUihData(session, channel->dlci, RfcommTakeCredits(channel), pkt);
             PacketFree(pkt);
             // Decrease credits.
             channel->peerCredit--;
         }
     } else if ((!channel->peerChannelFc) && (!session->peerSessionFc)) {
-        while (node != NULL) {
-            pkt = ListGetNodeData(node);
-            node = ListGetNextNode(node);
+        while (channel->sendQueue.count) {
+            pkt = RfcommDequeuePkt(&channel->sendQueue);
             // Add transmite data bytes value.
             channel->transmittedBytes += PacketPayloadSize(pkt);
             // Send data to peer.
             RfcommSendUihData(session, channel->dlci, 0, pkt);
-            ListRemoveNode(channel->sendQueue, pkt);
             PacketFree(pkt);
         }
     }
@@ -879,19 +931,6 @@ void RfcommSetFlcToUpper(RfcommChannelInfo *channel)
     }
 }
 
-/**
- * @brief Send further credits to peer.
- *
- * @param channel The pointer of the channel in the channel list.
- * @param credits The number of credits that can be received locally.
- */
-static void RfcommSendCredits(const RfcommChannelInfo *channel, uint8_t credits)
-{
-    LOG_INFO("%{public}s", __func__);
-
-    RfcommSendUihData(channel->session, channel->dlci, credits, NULL);
-}
-
 /**
  * @brief Notify the peer whether local can receive data.
  *
@@ -911,18 +950,15 @@ void RfcommSetFlcToPeer(RfcommChannelInfo *channel, bool enable)
             return;
         }
         // Send new credit.
-        uint8_t newCredits = channel->localCreditMax - channel->localCredit;
-        newCredits = (newCredits >= MAX_ONCE_NEWCREDIT) ? (MAX_ONCE_NEWCREDIT - 1) : newCredits;
-        channel->localCredit += newCredits;
-        RfcommSendCredits(channel, newCredits + 1);
+        RfcommSendCreditsIfNeeded(channel);
     } else {
         RfcommReadLock();
-        uint8_t count = ListGetSize(channel->recvQueue);
+        uint8_t count = channel->recvQueue.count;
         RfcommReadUnlock();
         if ((enable) && (channel->localFcToPeer)) {
             modemStatus.signals = MSC_RTC | MSC_RTR | MSC_DV;
             channel->localFcToPeer = false;
-        } else if ((!enable) && (count >= MAX_QUEUE_COUNT)) {
+        } else if ((!enable) && (count >= MAX_FC_QUEUE_COUNT)) {
             modemStatus.signals = MSC_FC | MSC_RTC | MSC_RTR | MSC_DV;
             channel->localFcToPeer = true;
         } else {
@@ -934,6 +970,67 @@ void RfcommSetFlcToPeer(RfcommChannelInfo *channel, bool enable)
     }
 }
 
+/**
+ * @brief Update the flow control to peer in the RFCOMM thread after the upper layer reads data.
+ *
+ * @param context The pointer of the channel.
+ */
+static void RfcommReadTsk(void *context)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    RfcommReadTskInfo *ctx = context;
+    RfcommChannelInfo *channel = ctx->channel;
+    uint16_t handle = ctx->handle;
+    free(ctx);
+
+    // The handle of a closed channel can be reused, so its slot must still hold the same channel.
+    if (RfcommGetChannelByHandle(handle) != channel) {
+        LOG_ERROR("%{public}s:Channel is closed.", __func__);
+        return;
+    }
+
+    RfcommReadLock();
+    channel->readNotified = false;
+    RfcommReadUnlock();
+
+    // Local can receive more data, send flow control to peer.
+    RfcommSetFlcToPeer(channel, true);
+}
+
+/**
+ * @brief Called with the read lock held after the upper layer reads data.
+ *        The reads done before the RFCOMM thread runs the update share one update.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+void RfcommNotifyRead(RfcommChannelInfo *channel)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    if ((channel->session->fcType != FC_TYPE_CREDIT) && (!channel->localFcToPeer)) {
+        return;
+    }
+
+    if (channel->readNotified) {
+        return;
+    }
+
+    RfcommReadTskInfo *ctx = malloc(sizeof(RfcommReadTskInfo));
+    if (ctx == NULL) {
+        return;
+    }
+    ctx->channel = channel;
+    ctx->handle = channel->handle;
+
+    int ret = BTM_RunTaskInProcessingQueue(PROCESSING_QUEUE_ID_RFCOMM, RfcommReadTsk, ctx);
+    if (ret == BT_NO_ERROR) {
+        channel->readNotified = true;
+    } else {
+        free(ctx);
+    }
+}
+
 /**
  * @brief Set the peer's modem status, and notify the upper layer if the status changes.
  *        And if the current flow control is not based on credit,
@@ -1019,13 +1116,15 @@ void RfcommCloseInvalidSession(RfcommSessionInfo *session)
  * @param session     The pointer of the session in the session list.
  * @param isInitiator Whether it is the initiator. true: initiator, false: non-initiator.
  */
-void RfcommUpdateChannelDirectionBit(const RfcommSessionInfo *session, bool isInitiator)
+void RfcommUpdateChannelDirectionBit(RfcommSessionInfo *session, bool isInitiator)
 {
     LOG_INFO("%{public}s", __func__);
 
     RfcommChannelInfo *channel = NULL;
     ListNode *node = NULL;
 
+    RfcommReadLock();
+
     node = ListGetFirstNode(g_channelList);
     while (node != NULL) {
         channel = ListGetNodeData(node);
@@ -1034,4 +1133,17 @@ void RfcommUpdateChannelDirectionBit(const RfcommSessionInfo *session, bool isIn
             channel->dlci = isInitiator ? (channel->scn << 1) : ((channel->scn << 1) + 1);
         }
     }
+
+    // Rebuild the dlci table of the session in the order of the channel list.
+    (void)memset_s(session->dlcTable, sizeof(session->dlcTable), 0x00, sizeof(session->dlcTable));
+    node = ListGetFirstNode(g_channelList);
+    while (node != NULL) {
+        channel = ListGetNodeData(node);
+        node = ListGetNextNode(node);
+        if (channel->session == session) {
+            RfcommIndexChannel(channel);
+        }
+    }
+
+    RfcommReadUnlock();
 }
\ No newline at end of file
@@ -938,10 +938,9 @@ int RfcommRecvRevData(RfcommChannelInfo *channel, const void *data)
 
     if (info.data.size > 0) {
         RfcommReadLock();
-        uint8_t count = (uint8_t)ListGetSize(channel->recvQueue);
-        if (count < MAX_QUEUE_COUNT) {
+        if (channel->recvQueue.count < MAX_QUEUE_COUNT) {
             pkt = PacketRefMalloc(info.data.payload);
-            ListAddLast(channel->recvQueue, pkt);
+            (void)RfcommEnqueuePkt(&channel->recvQueue, pkt);
             RfcommReadUnlock();
 
             RfcommNotifyEvtToUpper(channel, RFCOMM_CHANNEL_EV_REV_DATA, NULL);
@@ -949,10 +948,14 @@ int RfcommRecvRevData(RfcommChannelInfo *channel, const void *data)
         } else {
             RfcommReadUnlock();
         }
+        // The frame takes a credit of the peer.
+        RfcommRecvCreditedFrame(channel, info.data.size);
     }
 
     if (info.data.credits > 0) {
-        channel->peerCredit += info.data.credits;
+        if (channel->peerCredit <= (UINT16_MAX - info.data.credits)) {
+            channel->peerCredit += info.data.credits;
+        }
         RfcommSendCachePkt(channel);
         RfcommSetFlcToUpper(channel);
     }
@@ -983,11 +986,9 @@ int RfcommWriteData(RfcommChannelInfo *channel, const void *data)
     // save the data in the queue to be sent.
     if (((session->fcType == FC_TYPE_CREDIT) && (channel->peerCredit == 0)) ||
         (channel->transferReady != TRANSFER_READY) || channel->peerChannelFc || (session->peerSessionFc)) {
-        // Get send list's count
-        uint8_t count = (uint8_t)ListGetSize(channel->sendQueue);
-        if (count < MAX_QUEUE_COUNT) {
+        if (channel->sendQueue.count < MAX_QUEUE_COUNT) {
             refpkt = PacketRefMalloc((Packet *)data);
-            ListAddLast(channel->sendQueue, (void *)refpkt);
+            (void)RfcommEnqueuePkt(&channel->sendQueue, refpkt);
             return RFCOMM_SUCCESS;
         }
         channel->localFcToUpper = true;
@@ -996,8 +997,7 @@ int RfcommWriteData(RfcommChannelInfo *channel, const void *data)
     if (session->fcType == FC_TYPE_CREDIT) {
         // The value of the credit octet (0 - 255) signifies a number of frames,
         // for which the sender now has buffer space available to receive on the DLC.
-        newCredits = channel->localCreditMax - channel->localCredit;
-        channel->localCredit += newCredits;
+        newCredits = RfcommTakeCredits(channel);
     }
 
     // Add transmite data bytes value.
@@ -1009,6 +1009,9 @@ int RfcommWriteData(RfcommChannelInfo *channel, const void *data)
         if (channel->peerCredit > 0) {
             channel->peerCredit--;
         }
+    } else if (session->fcType == FC_TYPE_CREDIT) {
+        // The credits are not given to the peer.
+        channel->localCredit -= newCredits;
     }
     return ret;
 }
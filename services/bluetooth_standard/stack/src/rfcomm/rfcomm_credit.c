@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2021 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <time.h>
+
+#include "rfcomm_defs.h"
+
+#define RFCOMM_NS_PER_MS 1000000
+
+static uint64_t RfcommGetTimeMs()
+{
+    struct timespec ts = {0};
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * RFCOMM_PER_SEC) + ((uint64_t)ts.tv_nsec / RFCOMM_NS_PER_MS);
+}
+
+/**
+ * @brief Reset the credits given to the peer, and the window to the initial credits of PN.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+void RfcommResetCredit(RfcommChannelInfo *channel)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    channel->localCredit = 0;
+    channel->localCreditMax = DEFAULT_CREDITS_VALUE;
+    (void)memset_s(&channel->creditTuning, sizeof(RfcommCreditTuning), 0x00, sizeof(RfcommCreditTuning));
+}
+
+/**
+ * @brief Get the credits that can be given to the peer.
+ *        The window is shared by the credits the peer holds and the frames the upper layer has not read.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @return The number of credits.
+ */
+static uint8_t RfcommGetFreeCredits(const RfcommChannelInfo *channel)
+{
+    RfcommReadLock();
+    uint16_t used = channel->localCredit + channel->recvQueue.count;
+    RfcommReadUnlock();
+
+    if (used >= channel->localCreditMax) {
+        return 0;
+    }
+
+    return channel->localCreditMax - used;
+}
+
+/**
+ * @brief Take all the credits that can be given to the peer, to be sent with a data frame.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @return The number of credits taken.
+ */
+uint8_t RfcommTakeCredits(RfcommChannelInfo *channel)
+{
+    uint8_t credits = RfcommGetFreeCredits(channel);
+
+    channel->localCredit += credits;
+
+    return credits;
+}
+
+/**
+ * @brief Send the credits to peer in a frame without data, once a quarter of the window can be given.
+ *        The peer gets new credits before it uses up the ones it holds, and the credits are not sent one by one.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ */
+void RfcommSendCreditsIfNeeded(RfcommChannelInfo *channel)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    uint8_t threshold = channel->localCreditMax / CREDIT_RETURN_FRACTION;
+    uint8_t credits = RfcommGetFreeCredits(channel);
+
+    if ((credits == 0) || (credits < threshold)) {
+        return;
+    }
+
+    channel->localCredit += credits;
+    if (RfcommSendUihData(channel->session, channel->dlci, credits, NULL) != RFCOMM_SUCCESS) {
+        channel->localCredit -= credits;
+    }
+}
+
+/**
+ * @brief At the end of a measuring period, adjust the window by the throughput.
+ *        While the upper layer keeps up with reading, the window is doubled,
+ *        and the larger window is kept only if the throughput gains with it.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @param now     The current time(ms).
+ * @return True if the window is larger.
+ */
+static bool RfcommTuneCreditWindow(RfcommChannelInfo *channel, uint64_t now)
+{
+    RfcommCreditTuning *tuning = &channel->creditTuning;
+    uint32_t rate = (uint32_t)(((uint64_t)tuning->bytes * RFCOMM_PER_SEC) / (now - tuning->startTime));
+    bool isLarger = false;
+
+    if (tuning->lastCreditMax != 0) {
+        if (rate < (tuning->rate + (tuning->rate / CREDIT_TUNE_GAIN))) {
+            LOG_DEBUG("%{public}s:Window %hhu gains no throughput(%u).", __func__, channel->localCreditMax, rate);
+            channel->localCreditMax = tuning->lastCreditMax;
+            tuning->hold = CREDIT_TUNE_HOLD;
+        }
+        tuning->lastCreditMax = 0;
+    } else if (tuning->hold > 0) {
+        tuning->hold--;
+    } else if ((!tuning->backlog) && (channel->localCreditMax < MAX_CREDIT_COUNT)) {
+        tuning->lastCreditMax = channel->localCreditMax;
+        channel->localCreditMax = ((channel->localCreditMax * 2) < MAX_CREDIT_COUNT) ?
+            (channel->localCreditMax * 2) : MAX_CREDIT_COUNT;
+        isLarger = true;
+    }
+
+    tuning->rate = rate;
+    tuning->backlog = false;
+    tuning->bytes = 0;
+    tuning->frames = 0;
+    tuning->startTime = now;
+
+    return isLarger;
+}
+
+/**
+ * @brief A data frame is received, which takes a credit of the peer.
+ *        The throughput is measured over periods of at least two windows of frames.
+ *
+ * @param channel The pointer of the channel in the channel list.
+ * @param size    The size of the data.
+ */
+void RfcommRecvCreditedFrame(RfcommChannelInfo *channel, size_t size)
+{
+    LOG_INFO("%{public}s", __func__);
+
+    RfcommCreditTuning *tuning = &channel->creditTuning;
+
+    if (channel->session->fcType != FC_TYPE_CREDIT) {
+        return;
+    }
+
+    if (channel->localCredit > 0) {
+        channel->localCredit--;
+    }
+
+    uint64_t now = RfcommGetTimeMs();
+    if ((tuning->frames == 0) || ((now - tuning->lastTime) > CREDIT_TUNE_IDLE)) {
+        tuning->startTime = now;
+        tuning->bytes = 0;
+        tuning->frames = 0;
+        tuning->backlog = false;
+    }
+    tuning->lastTime = now;
+    tuning->bytes += size;
+    tuning->frames++;
+
+    // A larger window does not help if the frames received are not read in time.
+    RfcommReadLock();
+    if (channel->recvQueue.count >= (channel->localCreditMax / 2)) {
+        tuning->backlog = true;
+    }
+    RfcommReadUnlock();
+
+    if ((tuning->frames < (channel->localCreditMax * 2)) || ((now - tuning->startTime) < CREDIT_TUNE_PERIOD)) {
+        return;
+    }
+
+    if (RfcommTuneCreditWindow(channel, now)) {
+        RfcommSendCreditsIfNeeded(channel);
+    }
+}
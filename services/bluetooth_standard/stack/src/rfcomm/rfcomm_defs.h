@@ -45,8 +45,10 @@
 #define MAX_SESSION_COUNT BT_CONNECT_NUM_MAX
 #define MAX_SERVER_COUNT 30
 #define MAX_DLC_COUNT 36
-#define MAX_CREDIT_COUNT 10
+#define MAX_DLCI_COUNT 64        // DLCI is 6 bits
+#define MAX_CREDIT_COUNT 64      // The largest number of frames the peer may send before credits are returned
 #define MAX_QUEUE_COUNT MAX_CREDIT_COUNT
+#define MAX_FC_QUEUE_COUNT 10    // Received frames that stop the peer when credit based flow control is not used
 #define MAX_ONCE_NEWCREDIT 255
 
 #define FRAME_TYPE_SABM 0b00101111
@@ -149,6 +151,13 @@
 #define CL_RSP_UNSUPPORTED_CREDIT 0x00
 #define DEFAULT_CREDITS_VALUE 7
 
+// Credit window tuning
+#define CREDIT_RETURN_FRACTION 4     // Credits are returned once a quarter of the window is used
+#define CREDIT_TUNE_PERIOD 100       // The least time(ms) to measure the throughput with a window
+#define CREDIT_TUNE_IDLE 500         // No data in this time(ms) restarts the measurement
+#define CREDIT_TUNE_GAIN 8           // A larger window is kept if it gains 1/8 of the throughput
+#define CREDIT_TUNE_HOLD 8           // Periods to wait before trying a larger window again
+
 // Timer value(s)
 #define RFCOMM_PER_SEC 1000
 #define T1_SABM_DISC 20      // The timeout for SABM and DISC frames in RFCOMM).
@@ -334,6 +343,8 @@ typedef struct {
     void *context;
 } RfcommServerInfo;
 
+struct RfcommChannelInfo;
+
 typedef struct {
     uint16_t l2capId;
     uint8_t id; // Only use in recvConnectionReq callback
@@ -347,6 +358,8 @@ typedef struct {
     Alarm *timer;
     uint16_t l2capPeerMtu;
     uint16_t l2capLocalMtu;
+    // The first channel of each dlci in the channel list.
+    struct RfcommChannelInfo *dlcTable[MAX_DLCI_COUNT];
 } RfcommSessionInfo;
 
 typedef struct {
@@ -367,6 +380,23 @@ typedef struct {
 } RfcommSendPnInfo;
 
 typedef struct {
+    Packet *pkts[MAX_QUEUE_COUNT];
+    uint8_t head;
+    uint8_t count;
+} RfcommPacketQueue;
+
+typedef struct {
+    uint64_t startTime;     // Start of the measuring period(ms)
+    uint64_t lastTime;      // The last data frame received(ms)
+    uint32_t bytes;         // Data received in the period
+    uint32_t rate;          // Bytes per second of the last period
+    uint16_t frames;        // Data frames received in the period
+    uint8_t lastCreditMax;  // Window before the last period made it larger, 0 if it did not
+    uint8_t hold;           // Periods to wait before trying a larger window
+    bool backlog;           // The upper layer fell behind in reading in the period
+} RfcommCreditTuning;
+
+typedef struct RfcommChannelInfo {
     uint16_t handle;
     uint8_t dlci;
     uint8_t scn;
@@ -379,11 +409,13 @@ typedef struct {
     bool peerChannelFc;
     bool localFcToPeer;
     bool localFcToUpper;
-    uint8_t peerCredit;
+    uint16_t peerCredit;
     uint8_t localCredit;
     uint8_t localCreditMax;
-    List *sendQueue;
-    List *recvQueue;
+    RfcommCreditTuning creditTuning;
+    bool readNotified;  // RfcommRead posted the flow control update, protected by the read lock
+    RfcommPacketQueue sendQueue;
+    RfcommPacketQueue recvQueue;
     uint8_t lineStatus;
     RfcommRemotePortConfig portConfig;
     RfcommModemStatusInfo peerModemSt;
@@ -571,6 +603,11 @@ int RfcommOpenAllChannelOnSession(const RfcommSessionInfo *session);
 void RfcommResetAllChannelOnSession(const RfcommSessionInfo *session);
 void RfcommSetFlcToUpper(RfcommChannelInfo *channel);
 void RfcommSetFlcToPeer(RfcommChannelInfo *channel, bool enable);
+void RfcommNotifyRead(RfcommChannelInfo *channel);
+bool RfcommEnqueuePkt(RfcommPacketQueue *queue, Packet *pkt);
+Packet *RfcommDequeuePkt(RfcommPacketQueue *queue);
+Packet *RfcommPeekPkt(const RfcommPacketQueue *queue);
+void RfcommReleaseQueue(RfcommPacketQueue *queue);
 void RfcommNotifyEvtToUpper(const RfcommChannelInfo *channel, uint32_t eventId, const void *eventData);
 void RfcommNotifyAllChannelEvtOnSession(const RfcommSessionInfo *session, uint32_t eventId);
 void RfcommReleaseCachePkt(RfcommChannelInfo *channel);
@@ -589,11 +626,17 @@ void RfcommStopChannelTimer(RfcommChannelInfo *channel);
 void RfcommChannelTimeout(void *parameter);
 bool RfcommIsChannelValid(const RfcommChannelInfo *channel);
 void RfcommDeterminePeerMtu(RfcommChannelInfo *channel);
-void RfcommUpdateChannelDirectionBit(const RfcommSessionInfo *session, bool isInitiator);
+void RfcommUpdateChannelDirectionBit(RfcommSessionInfo *session, bool isInitiator);
 
 void RfcommReadLock();
 void RfcommReadUnlock();
 
+// Credit based flow control.
+void RfcommResetCredit(RfcommChannelInfo *channel);
+uint8_t RfcommTakeCredits(RfcommChannelInfo *channel);
+void RfcommSendCreditsIfNeeded(RfcommChannelInfo *channel);
+void RfcommRecvCreditedFrame(RfcommChannelInfo *channel, size_t size);
+
 // Channel state machine.
 int RfcommChannelEvtFsm(RfcommChannelInfo *channel, RfcommChannelEvent event, const void *data);
 
@@ -15,7 +15,8 @@
 
 #include "rfcomm_defs.h"
 
-static List *g_sessionList;
+// Sessions are looked up on every frame, and there are at most MAX_SESSION_COUNT of them.
+static RfcommSessionInfo *g_sessionTable[MAX_SESSION_COUNT] = {NULL};
 
 /**
  * @brief Create session list when RFCOMM initialize.
@@ -25,7 +26,9 @@ void RfcommCreateSessionList()
 {
     LOG_INFO("%{public}s", __func__);
 
-    g_sessionList = ListCreate(NULL);
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        g_sessionTable[index] = NULL;
+    }
 }
 
 /**
@@ -36,29 +39,21 @@ void RfcommDestroySessionList()
 {
     LOG_INFO("%{public}s", __func__);
 
-    ListNode *node = NULL;
     RfcommSessionInfo *session = NULL;
 
-    if (g_sessionList == NULL) {
-        LOG_DEBUG("%{public}s Session list is NULL.", __func__);
-        return;
-    }
-
     // Release server information.
-    node = ListGetFirstNode(g_sessionList);
-    while (node != NULL) {
-        session = ListGetNodeData(node);
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        session = g_sessionTable[index];
+        if (session == NULL) {
+            continue;
+        }
         if (session->timer != NULL) {
             AlarmDelete(session->timer);
             session->timer = NULL;
         }
         free(session);
-        node = ListGetNextNode(node);
+        g_sessionTable[index] = NULL;
     }
-
-    // Free server list.
-    ListDelete(g_sessionList);
-    g_sessionList = NULL;
 }
 
 /**
@@ -141,15 +136,13 @@ RfcommSessionInfo *RfcommCreateSession(const BtAddr *addr, uint16_t lcid, uint8_
 {
     LOG_INFO("%{public}s", __func__);
 
-    if (g_sessionList == NULL) {
-        LOG_ERROR("%{public}s Session list is NULL.", __func__);
-        return NULL;
+    uint8_t index = 0;
+    while ((index < MAX_SESSION_COUNT) && (g_sessionTable[index] != NULL)) {
+        index++;
     }
-
-    int32_t listCount = ListGetSize(g_sessionList);
     // If sessionlist's size exceeds 6, there is no resource to establish a new session connection,
     // and NULL is returned
-    if (listCount >= MAX_SESSION_COUNT) {
+    if (index >= MAX_SESSION_COUNT) {
         LOG_ERROR("%{public}s Session is over Max count.", __func__);
         return NULL;
     }
@@ -158,6 +151,7 @@ RfcommSessionInfo *RfcommCreateSession(const BtAddr *addr, uint16_t lcid, uint8_
     if (session == NULL) {
         return NULL;
     }
+    (void)memset_s(session->dlcTable, sizeof(session->dlcTable), 0x00, sizeof(session->dlcTable));
     session->isInitiator = isInitiator;
     (void)memcpy_s(&(session->btAddr), sizeof(BtAddr), addr, sizeof(BtAddr));
     session->l2capId = lcid;
@@ -171,7 +165,7 @@ RfcommSessionInfo *RfcommCreateSession(const BtAddr *addr, uint16_t lcid, uint8_
     session->timer = AlarmCreate(NULL, false);
     session->peerSessionFc = false;
     // Add the new session info to the session list.
-    ListAddLast(g_sessionList, session);
+    g_sessionTable[index] = session;
 
     // Return a session pointer.
     return session;
@@ -242,7 +236,12 @@ void RfcommRemoveSession(RfcommSessionInfo *session)
 {
     LOG_INFO("%{public}s", __func__);
 
-    ListRemoveNode(g_sessionList, session);
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        if (g_sessionTable[index] == session) {
+            g_sessionTable[index] = NULL;
+            break;
+        }
+    }
 
     if (session->timer != NULL) {
         AlarmDelete(session->timer);
@@ -263,20 +262,12 @@ RfcommSessionInfo *RfcommGetSessionByLcid(uint16_t lcid)
     LOG_INFO("%{public}s lcid:%hu", __func__, lcid);
 
     RfcommSessionInfo *session = NULL;
-    ListNode *node = NULL;
 
-    if (g_sessionList == NULL) {
-        LOG_ERROR("%{public}s Session list is NULL.", __func__);
-        return NULL;
-    }
-
-    node = ListGetFirstNode(g_sessionList);
-    while (node != NULL) {
-        session = ListGetNodeData(node);
-        if (session->l2capId == lcid) {
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        session = g_sessionTable[index];
+        if ((session != NULL) && (session->l2capId == lcid)) {
             return session;
         }
-        node = ListGetNextNode(node);
     }
 
     return NULL;
@@ -293,20 +284,12 @@ RfcommSessionInfo *RfcommGetSessionByAddr(const BtAddr *addr)
     LOG_INFO("%{public}s", __func__);
 
     RfcommSessionInfo *session = NULL;
-    ListNode *node = NULL;
-
-    if (g_sessionList == NULL) {
-        LOG_ERROR("%{public}s Session list is NULL.", __func__);
-        return NULL;
-    }
 
-    node = ListGetFirstNode(g_sessionList);
-    while (node != NULL) {
-        session = ListGetNodeData(node);
-        if (!memcmp(&session->btAddr, addr, sizeof(BtAddr))) {
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        session = g_sessionTable[index];
+        if ((session != NULL) && (!memcmp(&session->btAddr, addr, sizeof(BtAddr)))) {
             return session;
         }
-        node = ListGetNextNode(node);
     }
 
     return NULL;
@@ -322,23 +305,11 @@ bool RfcommIsSessionValid(RfcommSessionInfo *session)
 {
     LOG_INFO("%{public}s", __func__);
 
-    RfcommSessionInfo *sessionInfo = NULL;
-    ListNode *node = NULL;
-
-    if (g_sessionList == NULL) {
-        LOG_ERROR("%{public}s Session list is NULL.", __func__);
-        return NULL;
-    }
-
-    // Check if there is a channel on the session.
-    node = ListGetFirstNode(g_sessionList);
-    while (node != NULL) {
-        sessionInfo = ListGetNodeData(node);
-        if (sessionInfo == session) {
+    for (uint8_t index = 0; index < MAX_SESSION_COUNT; index++) {
+        if (g_sessionTable[index] == session) {
             LOG_DEBUG("%{public}s The session is valid.", __func__);
             return true;
         }
-        node = ListGetNextNode(node);
     }
 
     return false;
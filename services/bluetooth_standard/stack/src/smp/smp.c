@@ -829,6 +829,53 @@ int SMP_ResolveRPA(const uint8_t *addr, const uint8_t *irk)
     return ret;
 }
 
+struct SMP_IrkIndex {
+    uint16_t count;
+    SMP_Aes128Key keys[];
+};
+
+SMP_IrkIndex *SMP_CreateIrkIndex(const uint8_t *irks, uint16_t count)
+{
+    SMP_IrkIndex *index = MEM_MALLOC.alloc(sizeof(SMP_IrkIndex) + sizeof(SMP_Aes128Key) * count);
+    if (index == NULL) {
+        LOG_ERROR("%{public}s: Alloc error.", __FUNCTION__);
+        return NULL;
+    }
+    index->count = count;
+    for (uint16_t i = 0; i < count; i++) {
+        SMP_Aes128SetKey(irks + i * SMP_IRK_LEN, &index->keys[i]);
+    }
+    return index;
+}
+
+void SMP_DestroyIrkIndex(SMP_IrkIndex *index)
+{
+    if (index == NULL) {
+        return;
+    }
+    (void)memset_s(index->keys, sizeof(SMP_Aes128Key) * index->count, 0x00, sizeof(SMP_Aes128Key) * index->count);
+    MEM_MALLOC.free(index);
+}
+
+int SMP_ResolveRPAByIrkIndex(const SMP_IrkIndex *index, const uint8_t *addr)
+{
+    if (index == NULL || addr == NULL) {
+        return -1;
+    }
+
+    // ah(irk, prand): the plaintext is the same for every irk, only the expanded key changes.
+    uint8_t message[SMP_ENCRYPT_PLAINTEXTDATA_LEN] = {0x00};
+    uint8_t encryptedData[SMP_ENCRYPT_PLAINTEXTDATA_LEN] = {0x00};
+    (void)memcpy_s(message, sizeof(message), addr + SMP_RPA_HIGH_BIT_LEN, SMP_RPA_HIGH_BIT_LEN);
+    for (uint16_t i = 0; i < index->count; i++) {
+        SMP_Aes128Encrypt(&index->keys[i], message, encryptedData);
+        if (memcmp(encryptedData, addr, SMP_RPA_HIGH_BIT_LEN) == 0x00) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 int SMP_AsyncResolveRPA(const uint8_t *addr, const uint8_t *irk)
 {
     LOG_INFO("%{public}s", __FUNCTION__);
@@ -216,6 +216,33 @@ int SMP_ResolveRPA(const uint8_t *addr, const uint8_t *irk);
  */
 int SMP_AsyncResolveRPA(const uint8_t *addr, const uint8_t *irk);
 
+typedef struct SMP_IrkIndex SMP_IrkIndex;
+
+/**
+ * @brief Create an index over a set of irks, each irk is expanded once for all later resolutions.
+ *
+ * @param irks count irks of SMP_IRK_LEN bytes each.
+ * @param count Number of irks.
+ * @return Returns the index, or NULL if out of memory.
+ */
+SMP_IrkIndex *SMP_CreateIrkIndex(const uint8_t *irks, uint16_t count);
+
+/**
+ * @brief Destroy an irk index.
+ *
+ * @param index Irk index.
+ */
+void SMP_DestroyIrkIndex(SMP_IrkIndex *index);
+
+/**
+ * @brief Resolve resolvable private address against every irk of the index on the host.
+ *
+ * @param index Irk index.
+ * @param addr Resolvable private address.
+ * @return Returns the position of the resolving irk in the index; returns <b>-1</b> if none resolves addr.
+ */
+int SMP_ResolveRPAByIrkIndex(const SMP_IrkIndex *index, const uint8_t *addr);
+
 /**
  * @brief Generate resolvable private address.
  *
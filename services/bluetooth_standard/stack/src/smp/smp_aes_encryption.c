@@ -17,7 +17,6 @@
 #include <string.h>
 
 #include "log.h"
-#include "openssl/aes.h"
 
 #include "smp.h"
 
@@ -28,26 +27,36 @@ static void SMP_ReverseData(const uint8_t *intput, uint8_t *output, int size)
     }
 }
 
-static int SMP_Aes128Internal(
-    const uint8_t key[AES_BLOCK_SIZE], const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+void SMP_Aes128SetKey(const uint8_t key[AES_BLOCK_SIZE], SMP_Aes128Key *aesKey)
 {
-    if ((in == NULL) || (key == NULL) || (out == NULL)) {
-        return -1;
-    }
+    uint8_t keyReverse[AES_BLOCK_SIZE];
 
+    SMP_ReverseData(key, keyReverse, sizeof(keyReverse));
+    AES_set_encrypt_key(keyReverse, 0x80, &aesKey->aesKey);
+    (void)memset_s(keyReverse, sizeof(keyReverse), 0x00, sizeof(keyReverse));
+}
+
+void SMP_Aes128Encrypt(const SMP_Aes128Key *aesKey, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
     uint8_t inReverse[AES_BLOCK_SIZE];
-    uint8_t keyReverse[AES_BLOCK_SIZE];
     uint8_t outReverse[AES_BLOCK_SIZE];
-    AES_KEY aesKey;
 
-    SMP_ReverseData(key, keyReverse, sizeof(keyReverse));
     SMP_ReverseData(in, inReverse, sizeof(inReverse));
+    AES_encrypt(inReverse, outReverse, &aesKey->aesKey);
+    SMP_ReverseData(outReverse, out, sizeof(outReverse));
+}
 
-    AES_set_encrypt_key(keyReverse, 0x80, &aesKey);
-    AES_encrypt(inReverse, outReverse, &aesKey);
+static int SMP_Aes128Internal(
+    const uint8_t key[AES_BLOCK_SIZE], const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    if ((in == NULL) || (key == NULL) || (out == NULL)) {
+        return -1;
+    }
 
-    SMP_ReverseData(outReverse, out, sizeof(outReverse));
-    (void)memset_s(keyReverse, sizeof(keyReverse), 0x00, sizeof(keyReverse));
+    SMP_Aes128Key aesKey;
+    SMP_Aes128SetKey(key, &aesKey);
+    SMP_Aes128Encrypt(&aesKey, in, out);
+    (void)memset_s(&aesKey, sizeof(aesKey), 0x00, sizeof(aesKey));
 
     return 0;
 }
@@ -19,12 +19,21 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "openssl/aes.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define AES_BLOCK_SIZE 16
 
+/**
+ * @brief Expanded aes 128 key, for callers encrypting many blocks with the same key.
+ */
+typedef struct {
+    AES_KEY aesKey;
+} SMP_Aes128Key;
+
 /**
  * @brief aes 128 encrypt.
  *
@@ -39,6 +48,23 @@ extern "C" {
 int SMP_Aes128(
     const uint8_t *key, const uint8_t keyLen, const uint8_t *in, const uint8_t inLen, uint8_t out[AES_BLOCK_SIZE]);
 
+/**
+ * @brief Expand an aes 128 key once.
+ *
+ * @param key key data, 128bit in smp (little endian) byte order.
+ * @param aesKey Expanded key.
+ */
+void SMP_Aes128SetKey(const uint8_t key[AES_BLOCK_SIZE], SMP_Aes128Key *aesKey);
+
+/**
+ * @brief aes 128 encrypt one block with an expanded key.
+ *
+ * @param aesKey Expanded key.
+ * @param in Plaintext, 128bit in smp (little endian) byte order.
+ * @param out Encrypted data, 128bit in smp (little endian) byte order.
+ */
+void SMP_Aes128Encrypt(const SMP_Aes128Key *aesKey, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE]);
+
 #ifdef __cplusplus
 }
 #endif